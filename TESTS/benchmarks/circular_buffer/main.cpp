@@ -0,0 +1,81 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+#include "mbed.h"
+
+using namespace utest::v1;
+
+/* Throughput of moving byte streams through a CircularBuffer, the
+ * pattern used by serial and socket glue code. Reported through greentea
+ * key-value pairs, so CI can diff each target against its stored
+ * baseline.
+ */
+
+#define BENCH_BUFFER_SIZE 512
+#define BENCH_TOTAL_BYTES (256 * 1024)
+
+static CircularBuffer<uint8_t, BENCH_BUFFER_SIZE> bench_buffer;
+
+void test_bench_push_pop()
+{
+    Timer timer;
+    uint8_t data;
+    uint32_t moved = 0;
+
+    /* Stream BENCH_TOTAL_BYTES through the buffer half a buffer at a
+     * time, the way an IRQ producer and a thread consumer hand off */
+    timer.start();
+    while (moved < BENCH_TOTAL_BYTES) {
+        for (int i = 0; i < BENCH_BUFFER_SIZE / 2; i++) {
+            bench_buffer.push((uint8_t)i);
+        }
+        for (int i = 0; i < BENCH_BUFFER_SIZE / 2; i++) {
+            TEST_ASSERT_TRUE(bench_buffer.pop(data));
+        }
+        moved += BENCH_BUFFER_SIZE / 2;
+    }
+    timer.stop();
+    TEST_ASSERT_TRUE(bench_buffer.empty());
+
+    int elapsed_us = timer.read_us();
+    TEST_ASSERT(elapsed_us > 0);
+    uint32_t kb_per_s = (uint32_t)((uint64_t)BENCH_TOTAL_BYTES * 1000000 /
+                                   ((uint64_t)elapsed_us * 1024));
+    greentea_send_kv("circular_buffer_kb_s", kb_per_s);
+    printf("circular_buffer_kb_s: %lu KB/s (%d us for %d KB)\n", kb_per_s,
+           elapsed_us, BENCH_TOTAL_BYTES / 1024);
+}
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(60, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Benchmark CircularBuffer push/pop throughput", test_bench_push_pop)
+};
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
@@ -0,0 +1,111 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+#include "mbed.h"
+
+using namespace utest::v1;
+
+/* Per-operation cost of event queue post and dispatch. The cost is
+ * amortized over many operations for cycle-level resolution and reported
+ * through greentea key-value pairs, so CI can diff each target against
+ * its stored baseline.
+ */
+
+#define BENCH_BATCH  32
+#define BENCH_ROUNDS 256
+
+static EventQueue bench_queue(BENCH_BATCH * EVENTS_EVENT_SIZE);
+static volatile int bench_counter;
+
+static void bench_cb()
+{
+    bench_counter++;
+}
+
+static void bench_report(const char *label, int elapsed_us, uint32_t ops)
+{
+    uint32_t ns_per_op = (uint32_t)((uint64_t)elapsed_us * 1000 / ops);
+    greentea_send_kv(label, ns_per_op);
+    printf("%s: %lu ns/op (%d us for %lu ops)\n", label, ns_per_op,
+           elapsed_us, ops);
+}
+
+void test_bench_post_dispatch()
+{
+    Timer t_post, t_dispatch;
+
+    bench_counter = 0;
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        t_post.start();
+        for (int i = 0; i < BENCH_BATCH; i++) {
+            TEST_ASSERT_NOT_EQUAL(0, bench_queue.call(bench_cb));
+        }
+        t_post.stop();
+
+        t_dispatch.start();
+        bench_queue.dispatch(0);
+        t_dispatch.stop();
+    }
+    TEST_ASSERT_EQUAL(BENCH_BATCH * BENCH_ROUNDS, bench_counter);
+
+    bench_report("equeue_post", t_post.read_us(), BENCH_BATCH * BENCH_ROUNDS);
+    bench_report("equeue_dispatch", t_dispatch.read_us(),
+                 BENCH_BATCH * BENCH_ROUNDS);
+}
+
+void test_bench_post_delayed()
+{
+    Timer t_post;
+
+    /* Delayed posts exercise the sorted pending queue rather than the
+     * immediate tail append */
+    bench_counter = 0;
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        t_post.start();
+        for (int i = 0; i < BENCH_BATCH; i++) {
+            TEST_ASSERT_NOT_EQUAL(0, bench_queue.call_in(i, bench_cb));
+        }
+        t_post.stop();
+
+        bench_queue.dispatch(BENCH_BATCH + 1);
+    }
+    TEST_ASSERT_EQUAL(BENCH_BATCH * BENCH_ROUNDS, bench_counter);
+
+    bench_report("equeue_post_delayed", t_post.read_us(),
+                 BENCH_BATCH * BENCH_ROUNDS);
+}
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(60, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Benchmark event post and dispatch", test_bench_post_dispatch),
+    Case("Benchmark delayed event post", test_bench_post_delayed)
+};
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
@@ -0,0 +1,101 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(MBED_RTOS_SINGLE_THREAD) || !defined(MBED_CONF_RTOS_PRESENT)
+#error [NOT_SUPPORTED] RTOS primitive benchmarks require an RTOS
+#endif
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+#include "mbed.h"
+
+using namespace utest::v1;
+
+/* Per-operation cost of the hot RTOS primitives: uncontended Mutex
+ * lock/unlock and Queue put/get. The cost is amortized over many
+ * operations for cycle-level resolution and reported through greentea
+ * key-value pairs, so CI can diff each target against its stored
+ * baseline.
+ */
+
+#define BENCH_ITERATIONS 10000
+#define BENCH_QUEUE_SIZE 16
+
+static void bench_report(const char *label, int elapsed_us, uint32_t ops)
+{
+    uint32_t ns_per_op = (uint32_t)((uint64_t)elapsed_us * 1000 / ops);
+    greentea_send_kv(label, ns_per_op);
+    printf("%s: %lu ns/op (%d us for %lu ops)\n", label, ns_per_op,
+           elapsed_us, ops);
+}
+
+void test_bench_mutex()
+{
+    Mutex mutex;
+    Timer timer;
+
+    timer.start();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        mutex.lock();
+        mutex.unlock();
+    }
+    timer.stop();
+
+    bench_report("mutex_lock_unlock", timer.read_us(), 2 * BENCH_ITERATIONS);
+}
+
+void test_bench_queue()
+{
+    Queue<uint32_t, BENCH_QUEUE_SIZE> queue;
+    Timer t_put, t_get;
+    uint32_t token;
+
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        t_put.start();
+        osStatus status = queue.put(&token);
+        t_put.stop();
+        TEST_ASSERT_EQUAL(osOK, status);
+
+        t_get.start();
+        osEvent evt = queue.get(0);
+        t_get.stop();
+        TEST_ASSERT_EQUAL(osEventMessage, evt.status);
+        TEST_ASSERT_EQUAL(&token, evt.value.p);
+    }
+
+    bench_report("queue_put", t_put.read_us(), BENCH_ITERATIONS);
+    bench_report("queue_get", t_get.read_us(), BENCH_ITERATIONS);
+}
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(60, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Benchmark uncontended Mutex lock/unlock", test_bench_mutex),
+    Case("Benchmark Queue put/get", test_bench_queue)
+};
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
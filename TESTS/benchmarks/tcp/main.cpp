@@ -0,0 +1,122 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define WIFI 2
+#if !defined(MBED_CONF_TARGET_NETWORK_DEFAULT_INTERFACE_TYPE) || \
+    (MBED_CONF_TARGET_NETWORK_DEFAULT_INTERFACE_TYPE == WIFI && !defined(MBED_CONF_NSAPI_DEFAULT_WIFI_SSID))
+#error [NOT_SUPPORTED] No network configuration found for this target.
+#endif
+#ifndef MBED_CONF_APP_ECHO_SERVER_ADDR
+#error [NOT_SUPPORTED] Requires echo-server-addr and echo-server-port from mbed_app.json
+#endif
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+#include "mbed.h"
+#include "TCPSocket.h"
+
+using namespace utest::v1;
+
+/* Round-trip TCP throughput against the echo server, end to end through
+ * the IP stack and driver. Reported through greentea key-value pairs, so
+ * CI can diff each target against its stored baseline.
+ */
+
+#define BENCH_BURST_SIZE  1024
+#define BENCH_BURSTS      64
+#define BENCH_TIMEOUT_MS  10000
+
+static NetworkInterface *net;
+static uint8_t tx_buffer[BENCH_BURST_SIZE];
+static uint8_t rx_buffer[BENCH_BURST_SIZE];
+
+void test_bench_echo_throughput()
+{
+    TCPSocket sock;
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.open(net));
+    sock.set_timeout(BENCH_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK,
+                      sock.connect(MBED_CONF_APP_ECHO_SERVER_ADDR,
+                                   MBED_CONF_APP_ECHO_SERVER_PORT));
+
+    for (int i = 0; i < BENCH_BURST_SIZE; i++) {
+        tx_buffer[i] = (uint8_t)(i * 7 + 13);
+    }
+
+    Timer timer;
+    timer.start();
+    for (int burst = 0; burst < BENCH_BURSTS; burst++) {
+        int sent = 0;
+        while (sent < BENCH_BURST_SIZE) {
+            int ret = sock.send(tx_buffer + sent, BENCH_BURST_SIZE - sent);
+            TEST_ASSERT(ret > 0);
+            sent += ret;
+        }
+
+        int received = 0;
+        while (received < BENCH_BURST_SIZE) {
+            int ret = sock.recv(rx_buffer + received,
+                                BENCH_BURST_SIZE - received);
+            TEST_ASSERT(ret > 0);
+            received += ret;
+        }
+    }
+    timer.stop();
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(tx_buffer, rx_buffer, BENCH_BURST_SIZE);
+
+    int elapsed_us = timer.read_us();
+    TEST_ASSERT(elapsed_us > 0);
+    /* Bytes both sent and echoed back within the elapsed time */
+    uint32_t kb_per_s = (uint32_t)((uint64_t)BENCH_BURST_SIZE * BENCH_BURSTS *
+                                   2 * 1000000 / ((uint64_t)elapsed_us * 1024));
+    greentea_send_kv("tcp_echo_kb_s", kb_per_s);
+    printf("tcp_echo_kb_s: %lu KB/s (%d us for %d KB each way)\n", kb_per_s,
+           elapsed_us, (BENCH_BURST_SIZE * BENCH_BURSTS) / 1024);
+
+    sock.close();
+}
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(120, "default_auto");
+
+    net = NetworkInterface::get_default_instance();
+    TEST_ASSERT_NOT_NULL(net);
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, net->connect());
+    printf("MBED: IP address is '%s'\n", net->get_ip_address());
+
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+void greentea_test_teardown(const size_t passed, const size_t failed,
+                            const failure_t failure)
+{
+    net->disconnect();
+    greentea_test_teardown_handler(passed, failed, failure);
+}
+
+Case cases[] = {
+    Case("Benchmark TCP echo throughput", test_bench_echo_throughput)
+};
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown);
+
+int main()
+{
+    Harness::run(specification);
+}
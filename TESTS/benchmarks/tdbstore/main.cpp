@@ -0,0 +1,111 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+#include "mbed.h"
+#include "TDBStore.h"
+#include "HeapBlockDevice.h"
+#include "FlashSimBlockDevice.h"
+
+using namespace utest::v1;
+
+/* Per-record cost of TDBStore set and get over a simulated flash block
+ * device in RAM, isolating the store's own overhead (record headers,
+ * CRC, index) from the storage medium. Reported through greentea
+ * key-value pairs, so CI can diff each target against its stored
+ * baseline.
+ */
+
+#define BENCH_HEAP_SIZE   (32 * 1024)
+#define BENCH_ERASE_SIZE  4096
+#define BENCH_VALUE_SIZE  64
+#define BENCH_RECORDS     32
+#define BENCH_ROUNDS      4
+
+static HeapBlockDevice heap_bd(BENCH_HEAP_SIZE, 1, 1, BENCH_ERASE_SIZE);
+static FlashSimBlockDevice flash_bd(&heap_bd);
+
+static void bench_report(const char *label, int elapsed_us, uint32_t ops)
+{
+    uint32_t us_per_op = (uint32_t)((uint64_t)elapsed_us / ops);
+    greentea_send_kv(label, us_per_op);
+    printf("%s: %lu us/op (%d us for %lu ops)\n", label, us_per_op,
+           elapsed_us, ops);
+}
+
+void test_bench_set_get()
+{
+    TDBStore store(&flash_bd);
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, store.init());
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, store.reset());
+
+    uint8_t value[BENCH_VALUE_SIZE];
+    uint8_t readback[BENCH_VALUE_SIZE];
+    char key[16];
+    size_t actual;
+    Timer t_set, t_get;
+
+    for (int i = 0; i < BENCH_VALUE_SIZE; i++) {
+        value[i] = (uint8_t)(i * 7 + 13);
+    }
+
+    /* Rounds after the first overwrite existing keys, covering both the
+     * fresh-write and the update path */
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        for (int i = 0; i < BENCH_RECORDS; i++) {
+            sprintf(key, "bench_%d", i);
+            t_set.start();
+            int ret = store.set(key, value, sizeof(value), 0);
+            t_set.stop();
+            TEST_ASSERT_EQUAL(MBED_SUCCESS, ret);
+        }
+
+        for (int i = 0; i < BENCH_RECORDS; i++) {
+            sprintf(key, "bench_%d", i);
+            t_get.start();
+            int ret = store.get(key, readback, sizeof(readback), &actual);
+            t_get.stop();
+            TEST_ASSERT_EQUAL(MBED_SUCCESS, ret);
+            TEST_ASSERT_EQUAL(sizeof(value), actual);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(value, readback, sizeof(value));
+
+    bench_report("tdbstore_set", t_set.read_us(), BENCH_RECORDS * BENCH_ROUNDS);
+    bench_report("tdbstore_get", t_get.read_us(), BENCH_RECORDS * BENCH_ROUNDS);
+
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, store.deinit());
+}
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(120, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Benchmark TDBStore set/get", test_bench_set_get)
+};
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
@@ -322,6 +322,52 @@ void time_left_test()
     TEST_ASSERT_EQUAL(-1, queue.time_left(0));
 }
 
+class CountingTasklet : public Tasklet {
+public:
+    CountingTasklet(EventQueue *q): Tasklet(q), steps(0) {}
+    volatile int steps;
+
+protected:
+    virtual void step()
+    {
+        steps++;
+        if (steps < 3) {
+            yield();
+        }
+    }
+};
+
+void tasklet_test()
+{
+    EventQueue queue(TEST_EQUEUE_SIZE);
+    CountingTasklet tasklet(&queue);
+
+    // Not started - nothing to dispatch
+    queue.dispatch(0);
+    TEST_ASSERT_EQUAL(0, tasklet.steps);
+
+    // Each yield reposts the step, which runs to completion three times
+    tasklet.start();
+    TEST_ASSERT(tasklet.running());
+    queue.dispatch(0);
+    TEST_ASSERT_EQUAL(3, tasklet.steps);
+    TEST_ASSERT(!tasklet.running());
+
+    // Starting twice only schedules one step
+    tasklet.steps = 0;
+    tasklet.start();
+    tasklet.start();
+    queue.dispatch(0);
+    TEST_ASSERT_EQUAL(3, tasklet.steps);
+
+    // A stopped tasklet does not run
+    tasklet.steps = 0;
+    tasklet.start();
+    tasklet.stop();
+    queue.dispatch(0);
+    TEST_ASSERT_EQUAL(0, tasklet.steps);
+}
+
 // Test setup
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
@@ -348,6 +394,8 @@ const Case cases[] = {
     Case("Testing the event inference", event_inference_test),
 
     Case("Testing time_left", time_left_test),
+
+    Case("Testing tasklets", tasklet_test),
 };
 
 Specification specification(test_setup, cases);
@@ -0,0 +1,126 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed_events.h"
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+#if !defined(MBED_CONF_EVENTS_VIRTUAL_TIME) || !MBED_CONF_EVENTS_VIRTUAL_TIME
+#error [NOT_SUPPORTED] virtual time not enabled (events.virtual-time)
+#endif
+
+using namespace utest::v1;
+
+#define TEST_EQUEUE_SIZE (10 * EVENTS_EVENT_SIZE)
+
+static volatile int call_count = 0;
+
+static void counting_func()
+{
+    call_count++;
+}
+
+/** Test that events scheduled hours out dispatch in real seconds
+ *
+ *  Given an event queue on the virtual clock
+ *  When events are scheduled an hour and a day in the future
+ *  Then dispatch jumps the clock to each deadline and completes
+ *  within the harness timeout instead of a day of wall time
+ */
+void virtual_time_acceleration_test()
+{
+    EventQueue queue(TEST_EQUEUE_SIZE);
+
+    equeue_vtime_start(0);
+    call_count = 0;
+
+    Timer real;
+    real.start();
+
+    queue.call_in(60 * 60 * 1000, counting_func);
+    queue.call_in(24 * 60 * 60 * 1000, counting_func);
+    queue.dispatch(25 * 60 * 60 * 1000);
+
+    real.stop();
+    equeue_vtime_stop();
+
+    TEST_ASSERT_EQUAL(2, call_count);
+    TEST_ASSERT(real.read_ms() < 10000);
+}
+
+/** Test that periodic events keep their cadence in virtual time
+ *
+ *  Given an event periodic every 10 virtual minutes
+ *  When the queue dispatches a virtual hour
+ *  Then the event has run once per period
+ */
+void virtual_time_period_test()
+{
+    EventQueue queue(TEST_EQUEUE_SIZE);
+
+    equeue_vtime_start(0);
+    call_count = 0;
+
+    int id = queue.call_every(10 * 60 * 1000, counting_func);
+    queue.dispatch(60 * 60 * 1000);
+    queue.cancel(id);
+
+    equeue_vtime_stop();
+
+    TEST_ASSERT_INT_WITHIN(1, 6, call_count);
+}
+
+/** Test that scheduling works across a tick counter wrap
+ *
+ *  Given the virtual clock started 10 seconds before the 32-bit
+ *  millisecond tick wraps
+ *  When an event is scheduled 20 seconds out
+ *  Then it dispatches on the far side of the wrap
+ */
+void virtual_time_tick_wrap_test()
+{
+    EventQueue queue(TEST_EQUEUE_SIZE);
+
+    equeue_vtime_start((unsigned) - 10000);
+    call_count = 0;
+
+    queue.call_in(20000, counting_func);
+    queue.dispatch(30000);
+
+    equeue_vtime_stop();
+
+    TEST_ASSERT_EQUAL(1, call_count);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+const Case cases[] = {
+    Case("Testing acceleration of far deadlines", virtual_time_acceleration_test),
+    Case("Testing periodic cadence in virtual time", virtual_time_period_test),
+    Case("Testing scheduling across a tick wrap", virtual_time_tick_wrap_test),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -0,0 +1,106 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+#include "mbed.h"
+
+using namespace utest::v1;
+
+/* Throughput comparison of the MbedCRC computation modes. The numbers are
+ * reported through greentea so regressions in the table/bitwise paths (or
+ * the hardware/DMA path, when present) can be tracked per target.
+ */
+
+#define BENCH_BUFFER_SIZE 4096
+#define BENCH_ITERATIONS  16
+
+static uint8_t bench_buffer[BENCH_BUFFER_SIZE];
+
+/* Unnamed polynomial - always lands on the BITWISE fallback */
+#define POLY_32BIT_BENCH_OTHER 0x814141AB
+
+template <uint32_t polynomial, uint8_t width>
+static void run_bench(MbedCRC<polynomial, width> &ct, const char *label)
+{
+    Timer timer;
+    uint32_t crc = 0;
+
+    timer.start();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        TEST_ASSERT_EQUAL(0, ct.compute((void *)bench_buffer, BENCH_BUFFER_SIZE, &crc));
+    }
+    timer.stop();
+
+    int elapsed_us = timer.read_us();
+    TEST_ASSERT(elapsed_us > 0);
+    uint32_t kb_per_s = (uint32_t)((uint64_t)BENCH_BUFFER_SIZE * BENCH_ITERATIONS * 1000000 /
+                                   ((uint64_t)elapsed_us * 1024));
+    greentea_send_kv(label, kb_per_s);
+    printf("%s: %lu KB/s (%d us for %d KB)\n", label, kb_per_s,
+           elapsed_us, (BENCH_BUFFER_SIZE * BENCH_ITERATIONS) / 1024);
+}
+
+void test_bench_bitwise()
+{
+    MbedCRC<POLY_32BIT_BENCH_OTHER, 32> ct(0xFFFFFFFF, 0xFFFFFFFF, true, true);
+    run_bench(ct, "crc_bitwise");
+}
+
+void test_bench_table()
+{
+    /* TABLE mode - nibble or full table depending on drivers.crc-table-size,
+     * HARDWARE (optionally DMA-fed) on targets with CRC peripheral support */
+    MbedCRC<POLY_32BIT_ANSI, 32> ct;
+#if DEVICE_CRC
+    run_bench(ct, "crc_hardware_or_table");
+#elif MBED_CONF_DRIVERS_CRC_TABLE_SIZE == MBED_OPTIMIZED_CRC_TABLE_SIZE
+    run_bench(ct, "crc_nibble_table");
+#else
+    run_bench(ct, "crc_full_table");
+#endif
+}
+
+void test_bench_rev_table()
+{
+    /* Optimized 16-entry reflected table, always TABLE mode */
+    MbedCRC<POLY_32BIT_REV_ANSI, 32> ct;
+    run_bench(ct, "crc_rev_nibble_table");
+}
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    for (int i = 0; i < BENCH_BUFFER_SIZE; i++) {
+        bench_buffer[i] = (uint8_t)(i * 7 + 13);
+    }
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Benchmark bitwise CRC", test_bench_bitwise),
+    Case("Benchmark table/hardware CRC", test_bench_table),
+    Case("Benchmark reversed-ANSI table CRC", test_bench_rev_table)
+};
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
@@ -108,6 +108,63 @@ void test_equality_comparators()
     TEST_ASSERT_TRUE(s_ptr1_1 != s_ptr2); // Shared pointer / Shared pointer
 }
 
+/**
+ * Test that make_shared constructs the object in place and that the resulting
+ * shared pointer manages its lifetime like a pointer-adopting one
+ */
+void test_make_shared()
+{
+    // Sanity-check value of counter
+    TEST_ASSERT_EQUAL(0, TestStruct::s_count);
+
+    {
+        SharedPtr<TestStruct> s_ptr = make_shared<TestStruct>();
+        TEST_ASSERT_EQUAL(1, TestStruct::s_count);
+        TEST_ASSERT_EQUAL(42, s_ptr->value);
+        TEST_ASSERT_EQUAL(1, s_ptr.use_count());
+
+        SharedPtr<TestStruct> s_ptr2 = s_ptr;
+        TEST_ASSERT_EQUAL(2, s_ptr.use_count());
+        TEST_ASSERT_EQUAL(1, TestStruct::s_count);
+    }
+
+    // Destroy shared pointers
+    TEST_ASSERT_EQUAL(0, TestStruct::s_count);
+}
+
+/**
+ * Test that a weak pointer observes the object without keeping it alive,
+ * and that lock() only succeeds while a shared pointer still owns it
+ */
+void test_weakptr_lifetime()
+{
+    WeakPtr<TestStruct> w_ptr;
+
+    // An empty weak pointer is expired and cannot be locked
+    TEST_ASSERT_TRUE(w_ptr.expired());
+    TEST_ASSERT_TRUE(w_ptr.lock() == NULL);
+
+    {
+        SharedPtr<TestStruct> s_ptr = make_shared<TestStruct>();
+        w_ptr = s_ptr;
+
+        // Observing does not add a strong reference
+        TEST_ASSERT_EQUAL(1, w_ptr.use_count());
+        TEST_ASSERT_FALSE(w_ptr.expired());
+
+        // Locking promotes to a full shared pointer
+        SharedPtr<TestStruct> locked = w_ptr.lock();
+        TEST_ASSERT_TRUE(locked == s_ptr);
+        TEST_ASSERT_EQUAL(2, s_ptr.use_count());
+        TEST_ASSERT_EQUAL(42, locked->value);
+    }
+
+    // All shared pointers are gone; object destroyed despite the weak pointer
+    TEST_ASSERT_EQUAL(0, TestStruct::s_count);
+    TEST_ASSERT_TRUE(w_ptr.expired());
+    TEST_ASSERT_TRUE(w_ptr.lock() == NULL);
+}
+
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
     GREENTEA_SETUP(10, "default_auto");
@@ -117,7 +174,9 @@ utest::v1::status_t test_setup(const size_t number_of_cases)
 Case cases[] = {
     Case("Test single shared pointer instance", test_single_sharedptr_lifetime),
     Case("Test instance sharing across multiple shared pointers", test_instance_sharing),
-    Case("Test equality comparators", test_equality_comparators)
+    Case("Test equality comparators", test_equality_comparators),
+    Case("Test single-allocation make_shared", test_make_shared),
+    Case("Test weak pointer lifetime", test_weakptr_lifetime)
 };
 
 utest::v1::Specification specification(test_setup, cases);
@@ -490,6 +490,43 @@ void free_block_invalid_parameter()
     TEST_ASSERT_EQUAL(osErrorParameter, status);
 }
 
+/* Template for functional tests for alloc_many()/free_many() functions
+ * of MemoryPool object.
+ *
+ * Given MemoryPool object has been successfully created.
+ * When all blocks are allocated with one alloc_many call and freed with
+ * one free_many call.
+ * Then both batch operations succeed, a further allocation fails and the
+ * blocks can be re-allocated after the batch free.
+ *
+ * */
+template<typename T, const uint32_t numOfEntries>
+void test_mem_pool_alloc_free_many()
+{
+    MemoryPool<T, numOfEntries> mem_pool;
+    T *p_blocks[numOfEntries];
+    osStatus status;
+
+    /* Allocate all available blocks in one call. */
+    size_t count = mem_pool.alloc_many(p_blocks, numOfEntries);
+    TEST_ASSERT_EQUAL(numOfEntries, count);
+
+    /* Show that the pool is now exhausted. */
+    T *p_extra_block = mem_pool.alloc();
+    TEST_ASSERT_NULL(p_extra_block);
+
+    /* Free all memory blocks in one call. */
+    status = mem_pool.free_many(p_blocks, numOfEntries);
+    TEST_ASSERT_EQUAL(osOK, status);
+
+    /* Show that all blocks can be allocated again. */
+    count = mem_pool.alloc_many(p_blocks, numOfEntries);
+    TEST_ASSERT_EQUAL(numOfEntries, count);
+
+    status = mem_pool.free_many(p_blocks, numOfEntries);
+    TEST_ASSERT_EQUAL(osOK, status);
+}
+
 /* Use wrapper functions to reduce memory usage. */
 
 template<typename T, const uint32_t numOfEntries>
@@ -569,6 +606,9 @@ Case cases[] = {
 
     Case("Test: fail (out of free blocks).", test_mem_pool_alloc_fail_wrapper<int, 3>),
 
+    Case("Test: alloc_many()/free_many() - success, 4 bytes b_type, q_size equal to 3.", test_mem_pool_alloc_free_many<int, 3>),
+    Case("Test: alloc_many()/free_many() - success, complex b_type, q_size equal to 3.", test_mem_pool_alloc_free_many<COMPLEX_TYPE, 3>),
+
     Case("Test: free() - robust (free called with invalid param - NULL).", free_block_invalid_parameter_null),
     Case("Test: free() - robust (free called with invalid param).", free_block_invalid_parameter)
 };
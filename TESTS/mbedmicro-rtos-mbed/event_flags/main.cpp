@@ -349,6 +349,42 @@ void test_multi_thread_all_many_wait(void)
     }
 }
 
+static uint32_t handler_flags;
+
+void flag_handler(uint32_t flags)
+{
+    handler_flags |= flags;
+}
+
+/** Test asynchronous flag handler
+
+    Given an event flags object with a handler registered for FLAG01
+    when flags covered by the mask are set
+    then the handler is dispatched on the event queue with those flags and the flags are cleared
+    and flags outside the mask are left pending and do not trigger the handler
+ */
+void test_set_handler(void)
+{
+    EventFlags ef;
+    EventQueue queue;
+    handler_flags = NO_FLAGS;
+
+    ef.set_handler(FLAG01, callback(flag_handler), &queue);
+
+    ef.set(FLAG01);
+    queue.dispatch(0);
+    TEST_ASSERT_EQUAL(FLAG01, handler_flags);
+    TEST_ASSERT_EQUAL(NO_FLAGS, ef.get());
+
+    ef.set(FLAG02);
+    queue.dispatch(0);
+    TEST_ASSERT_EQUAL(FLAG01, handler_flags);
+    TEST_ASSERT_EQUAL(FLAG02, ef.get());
+
+    ef.set_handler(NO_FLAGS, NULL);
+    ef.clear();
+}
+
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
     GREENTEA_SETUP(10, "default_auto");
@@ -365,7 +401,8 @@ Case cases[] = {
     Case("Test multi-threaded wait_any", test_multi_thread_any),
     Case("Test multi-threaded wait_all many wait", test_multi_thread_all_many_wait),
     Case("Test multi-threaded wait_any timeout", test_multi_thread_any_timeout),
-    Case("Test multi-threaded wait_any no clear", test_multi_thread_any_no_clear)
+    Case("Test multi-threaded wait_any no clear", test_multi_thread_any_no_clear),
+    Case("Test asynchronous flag handler", test_set_handler)
 };
 
 utest::v1::Specification specification(test_setup, cases);
@@ -482,6 +482,63 @@ void test_mail_full()
     TEST_ASSERT_EQUAL(true, m.full());
 }
 
+/** Test shared mail zero-copy forwarding
+
+    Given two SharedMails of the same type
+    when a block is sent through the first and forwarded into the second
+    then the consumer receives the very same block
+    and freeing it returns it to the origin pool
+ */
+void test_shared_mail_forward()
+{
+    SharedMail<uint32_t, 1> stage1;
+    SharedMail<uint32_t, 1> stage2;
+
+    uint32_t *mail = stage1.alloc();
+    TEST_ASSERT_NOT_EQUAL(NULL, mail);
+    *mail = 0xDEADBEEF;
+
+    stage1.put(mail);
+
+    osEvent evt = stage1.get(0);
+    TEST_ASSERT_EQUAL(osEventMail, evt.status);
+    TEST_ASSERT_EQUAL_PTR(mail, evt.value.p);
+
+    // forward the same block into the next stage without copying
+    stage2.put((uint32_t *)evt.value.p);
+
+    evt = stage2.get(0);
+    TEST_ASSERT_EQUAL(osEventMail, evt.status);
+    TEST_ASSERT_EQUAL_PTR(mail, evt.value.p);
+    TEST_ASSERT_EQUAL(0xDEADBEEF, *(uint32_t *)evt.value.p);
+
+    // the block returns to stage1's pool, which becomes usable again
+    TEST_ASSERT_EQUAL(osOK, SharedMail<uint32_t, 1>::free((uint32_t *)evt.value.p));
+    TEST_ASSERT_NOT_EQUAL(NULL, stage1.alloc());
+}
+
+/** Test shared mail fan-out references
+
+    Given a SharedMail block shared to two consumers
+    when one reference is freed the block stays allocated
+    and only the last free returns it to the pool
+ */
+void test_shared_mail_share()
+{
+    SharedMail<uint32_t, 1> mail_box;
+
+    uint32_t *mail = mail_box.alloc();
+    TEST_ASSERT_NOT_EQUAL(NULL, mail);
+
+    SharedMail<uint32_t, 1>::share(mail);
+
+    TEST_ASSERT_EQUAL(osOK, SharedMail<uint32_t, 1>::free(mail));
+    TEST_ASSERT_EQUAL(NULL, mail_box.alloc());
+
+    TEST_ASSERT_EQUAL(osOK, SharedMail<uint32_t, 1>::free(mail));
+    TEST_ASSERT_NOT_EQUAL(NULL, mail_box.alloc());
+}
+
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
     GREENTEA_SETUP(10, "default_auto");
@@ -503,7 +560,9 @@ Case cases[] = {
     Case("Test message send/receive multi-thread and per thread order", test_multi_thread_order),
     Case("Test message send/receive multi-thread, multi-Mail and per thread order", test_multi_thread_multi_mail_order),
     Case("Test mail empty", test_mail_empty),
-    Case("Test mail full", test_mail_full)
+    Case("Test mail full", test_mail_full),
+    Case("Test shared mail zero-copy forwarding", test_shared_mail_forward),
+    Case("Test shared mail fan-out references", test_shared_mail_share)
 };
 
 Specification specification(test_setup, cases);
@@ -284,6 +284,26 @@ void test_single_thread_lock(void)
     mutex.unlock();
 }
 
+/** Test single thread lock with spinning enabled
+
+    Given a mutex with a spin limit set and a single running thread
+    When thread calls @a lock (also recursively) and @a unlock on the mutex
+    Then the operations are successfully performed.
+*/
+void test_single_thread_lock_spin(void)
+{
+    Mutex mutex;
+    mutex.set_spin_limit(8);
+
+    mutex.lock();
+
+    mutex.lock();
+
+    mutex.unlock();
+
+    mutex.unlock();
+}
+
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
     GREENTEA_SETUP(10, "default_auto");
@@ -292,6 +312,7 @@ utest::v1::status_t test_setup(const size_t number_of_cases)
 
 Case cases[] = {
     Case("Test single thread lock", test_single_thread_lock),
+    Case("Test single thread lock with spinning", test_single_thread_lock_spin),
     Case("Test single thread trylock", test_single_thread_trylock),
     Case("Test single thread lock recursive", test_single_thread_lock_recursive),
     Case("Test dual thread lock locked", test_dual_thread_lock<test_dual_thread_lock_lock_thread>),
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2019, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#if defined(MBED_RTOS_SINGLE_THREAD)
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+#if !DEVICE_USTICKER
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+#define PERIOD_MS    50
+#define CYCLE_COUNT  5
+#define TOLERANCE_MS 5
+
+/** Test drift-free periodic schedule
+
+    Given a periodic task with a 50 ms period
+    when the task waits through several cycles with work shorter than the period
+    then the total elapsed time matches cycles * period without accumulating drift
+    and all deadlines are met with no overruns recorded
+ */
+void test_periodic_no_drift(void)
+{
+    PeriodicTask task(PERIOD_MS);
+
+    uint64_t start = Kernel::get_ms_count();
+    for (uint32_t i = 0; i < CYCLE_COUNT; i++) {
+        bool met = task.wait();
+        TEST_ASSERT_EQUAL(true, met);
+        /* Simulate work shorter than the period - with sleep_for this
+           would add to every cycle, with an absolute schedule it must not. */
+        ThisThread::sleep_for(PERIOD_MS / 2);
+    }
+    uint64_t elapsed = Kernel::get_ms_count() - start;
+
+    TEST_ASSERT_UINT32_WITHIN(TOLERANCE_MS, CYCLE_COUNT * PERIOD_MS, (uint32_t)elapsed);
+    TEST_ASSERT_EQUAL(CYCLE_COUNT, task.cycles());
+    TEST_ASSERT_EQUAL(0, task.overruns());
+}
+
+/** Test overrun detection
+
+    Given a periodic task with a 50 ms period
+    when a cycle runs longer than the period
+    then the following wait reports the overrun and the schedule realigns
+    to a future deadline instead of running missed cycles back-to-back
+ */
+void test_periodic_overrun(void)
+{
+    PeriodicTask task(PERIOD_MS);
+
+    bool met = task.wait();
+    TEST_ASSERT_EQUAL(true, met);
+
+    /* Overrun the period by more than two cycles. */
+    ThisThread::sleep_for(PERIOD_MS * 5 / 2);
+
+    uint64_t before = Kernel::get_ms_count();
+    met = task.wait();
+    uint64_t after = Kernel::get_ms_count();
+
+    TEST_ASSERT_EQUAL(false, met);
+    TEST_ASSERT_TRUE(task.overruns() > 0);
+    /* The realigned deadline lies in the future, but less than one period away. */
+    TEST_ASSERT_TRUE(after - before <= PERIOD_MS + TOLERANCE_MS);
+
+    task.reset_stats();
+    TEST_ASSERT_EQUAL(0, task.cycles());
+    TEST_ASSERT_EQUAL(0, task.overruns());
+    TEST_ASSERT_EQUAL(0, task.max_lateness());
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test periodic schedule without drift", test_periodic_no_drift),
+    Case("Test overrun detection and realignment", test_periodic_overrun)
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
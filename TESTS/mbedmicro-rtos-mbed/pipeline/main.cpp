@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2019, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#if defined(MBED_RTOS_SINGLE_THREAD)
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+#if !DEVICE_USTICKER
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+#define RING_SIZE    4
+#define BATCH_SIZE   4
+#define ITEM_COUNT   16
+#define TIMEOUT_MS   1000
+
+static PipelineRing<uint32_t, RING_SIZE> input_ring;
+static PipelineRing<uint32_t, RING_SIZE * 4> output_ring;
+static uint32_t values[ITEM_COUNT];
+
+static void forward_batch(uint32_t *const *items, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        output_ring.push(items[i]);
+    }
+}
+
+/** Test items flow through a stage in order
+
+    Given a stage consuming from a bounded ring and forwarding to a second ring
+    when a producer pushes more items than the ring holds
+    then backpressure paces the producer, every item arrives downstream
+    exactly once and in order, and the stage statistics account for all items
+ */
+void test_pipeline_flow(void)
+{
+    PipelineStage<uint32_t, BATCH_SIZE> stage(input_ring, forward_batch);
+    TEST_ASSERT_EQUAL(osOK, stage.start());
+
+    for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+        values[i] = i;
+        TEST_ASSERT_EQUAL(osOK, input_ring.push(&values[i], TIMEOUT_MS));
+    }
+
+    uint32_t *items[BATCH_SIZE];
+    uint32_t received = 0;
+    while (received < ITEM_COUNT) {
+        uint32_t count = output_ring.pop_batch(items, BATCH_SIZE, TIMEOUT_MS);
+        TEST_ASSERT_TRUE(count > 0);
+        for (uint32_t i = 0; i < count; i++) {
+            TEST_ASSERT_EQUAL(received, *items[i]);
+            received++;
+        }
+    }
+
+    TEST_ASSERT_EQUAL(osOK, stage.stop());
+
+    pipeline_stage_stats_t stats;
+    stage.get_stats(stats);
+    TEST_ASSERT_EQUAL(ITEM_COUNT, stats.processed);
+    TEST_ASSERT_TRUE(stats.batches > 0);
+    TEST_ASSERT_TRUE(stats.max_batch <= BATCH_SIZE);
+    TEST_ASSERT_TRUE(stats.max_occupancy <= RING_SIZE);
+}
+
+/** Test backpressure on a full link
+
+    Given a link filled to capacity with no consumer
+    when the producer pushes with no wait and with a timeout
+    then the pushes fail with osErrorResource and osErrorTimeout respectively,
+    the stall counter records the blocked push, and draining restores credit
+ */
+void test_pipeline_backpressure(void)
+{
+    PipelineRing<uint32_t, RING_SIZE> ring;
+    uint32_t item = 42;
+
+    for (uint32_t i = 0; i < RING_SIZE; i++) {
+        TEST_ASSERT_EQUAL(osOK, ring.push(&item, 0));
+    }
+    TEST_ASSERT_EQUAL(RING_SIZE, ring.occupancy());
+    TEST_ASSERT_EQUAL(RING_SIZE, ring.max_occupancy());
+
+    /* Out of credit - a push without wait fails immediately and is not
+       counted as a stall, a push with a timeout blocks and is. */
+    TEST_ASSERT_EQUAL(osErrorResource, ring.push(&item, 0));
+    TEST_ASSERT_EQUAL(0, ring.stalls());
+    TEST_ASSERT_EQUAL(osErrorTimeout, ring.push(&item, 50));
+    TEST_ASSERT_EQUAL(1, ring.stalls());
+
+    uint32_t *items[RING_SIZE];
+    TEST_ASSERT_EQUAL(RING_SIZE, ring.pop_batch(items, RING_SIZE, 0));
+    TEST_ASSERT_EQUAL(0, ring.occupancy());
+    TEST_ASSERT_EQUAL(osOK, ring.push(&item, 0));
+
+    ring.reset_stats();
+    TEST_ASSERT_EQUAL(0, ring.stalls());
+    TEST_ASSERT_EQUAL(0, ring.max_occupancy());
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test items flow through a stage in order", test_pipeline_flow),
+    Case("Test backpressure on a full link", test_pipeline_backpressure)
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -320,6 +320,42 @@ void test_queue_full()
     TEST_ASSERT_EQUAL(true, q.full());
 }
 
+/** Test SPSC queue wait-free FIFO operation
+
+    Given an SPSC specialized queue of uint32_t data with size of 3
+    when the queue is filled to capacity with 0-timeout puts
+    then an additional put fails with osErrorResource
+    and the messages are received in FIFO order
+    and a get from the drained queue returns osOK
+ */
+void test_spsc_fifo()
+{
+    Queue<uint32_t, 3, true> q;
+
+    TEST_ASSERT_EQUAL(true, q.empty());
+
+    for (uint32_t i = 0; i < 3; i++) {
+        osStatus stat = q.put((uint32_t *)(TEST_UINT_MSG + i));
+        TEST_ASSERT_EQUAL(osOK, stat);
+    }
+
+    TEST_ASSERT_EQUAL(true, q.full());
+
+    osStatus stat = q.put((uint32_t *) TEST_UINT_MSG);
+    TEST_ASSERT_EQUAL(osErrorResource, stat);
+
+    for (uint32_t i = 0; i < 3; i++) {
+        osEvent evt = q.get(0);
+        TEST_ASSERT_EQUAL(osEventMessage, evt.status);
+        TEST_ASSERT_EQUAL(TEST_UINT_MSG + i, evt.value.v);
+    }
+
+    TEST_ASSERT_EQUAL(true, q.empty());
+
+    osEvent evt = q.get(0);
+    TEST_ASSERT_EQUAL(osOK, evt.status);
+}
+
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
     GREENTEA_SETUP(5, "default_auto");
@@ -339,7 +375,8 @@ Case cases[] = {
     Case("Test message ordering", test_msg_order),
     Case("Test message priority", test_msg_prio),
     Case("Test queue empty", test_queue_empty),
-    Case("Test queue full", test_queue_full)
+    Case("Test queue full", test_queue_full),
+    Case("Test SPSC queue FIFO", test_spsc_fifo)
 };
 
 Specification specification(test_setup, cases);
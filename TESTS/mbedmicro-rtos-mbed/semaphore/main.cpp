@@ -228,6 +228,49 @@ void test_multiple_tokens_release()
     TEST_ASSERT_EQUAL(osErrorResource, stat);
 }
 
+/** Test batch release
+
+    Given a semaphore initialized with zero tokens and max of 5
+    when thread calls @a release(3) on the semaphore
+    then three tokens can be acquired without blocking
+ */
+void test_batch_release()
+{
+    Semaphore sem(0, 5);
+
+    osStatus stat = sem.release(3);
+    TEST_ASSERT_EQUAL(osOK, stat);
+
+    for (int i = 3; i > 0; i--) {
+        int32_t cnt = sem.wait(0);
+        TEST_ASSERT_EQUAL(i, cnt);
+    }
+    TEST_ASSERT_EQUAL(0, sem.wait(0));
+}
+
+/** Test coalesced release
+
+    Given a semaphore with wakeup coalescing enabled
+    when a burst of releases is performed
+    then a single wait_batch collects the whole burst count
+    and no further wakeup is pending afterwards
+ */
+void test_coalesced_release()
+{
+    Semaphore sem(0, 5);
+    sem.enable_coalescing();
+
+    for (int i = 0; i < 4; i++) {
+        osStatus stat = sem.release();
+        TEST_ASSERT_EQUAL(osOK, stat);
+    }
+
+    int32_t batch = sem.wait_batch(0);
+    TEST_ASSERT_EQUAL(4, batch);
+
+    TEST_ASSERT_EQUAL(0, sem.wait_batch(0));
+}
+
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
     GREENTEA_SETUP(10, "default_auto");
@@ -241,6 +284,8 @@ Case cases[] = {
     Case("Test 0 tokens no timeout", test_no_timeout<0>),
     Case("Test multiple tokens wait", test_multiple_tokens_wait),
     Case("Test multiple tokens release", test_multiple_tokens_release),
+    Case("Test batch release", test_batch_release),
+    Case("Test coalesced release", test_coalesced_release),
     Case("Test multiple threads", test_multi)
 };
 
@@ -163,9 +163,12 @@ Case cases[] = {
     Case("TCPSOCKET_BIND_WRONG_TYPE", TCPSOCKET_BIND_WRONG_TYPE),
     Case("TCPSOCKET_BIND_UNOPENED", TCPSOCKET_BIND_UNOPENED),
     Case("TCPSOCKET_SETSOCKOPT_KEEPALIVE_VALID", TCPSOCKET_SETSOCKOPT_KEEPALIVE_VALID),
+    Case("TCPSOCKET_SETSOCKOPT_CORK", TCPSOCKET_SETSOCKOPT_CORK),
     Case("TCPSOCKET_RECV_100K", TCPSOCKET_RECV_100K),
     Case("TCPSOCKET_RECV_100K_NONBLOCK", TCPSOCKET_RECV_100K_NONBLOCK),
+    Case("TCPSOCKET_RECV_BUFFER", TCPSOCKET_RECV_BUFFER),
     Case("TCPSOCKET_RECV_TIMEOUT", TCPSOCKET_RECV_TIMEOUT),
+    Case("TCPSOCKET_SENDMSG", TCPSOCKET_SENDMSG),
     Case("TCPSOCKET_SEND_REPEAT", TCPSOCKET_SEND_REPEAT),
     Case("TCPSOCKET_SEND_TIMEOUT", TCPSOCKET_SEND_TIMEOUT),
     Case("TCPSOCKET_ENDPOINT_CLOSE", TCPSOCKET_ENDPOINT_CLOSE),
@@ -68,10 +68,13 @@ void TCPSOCKET_BIND_WRONG_TYPE();
 void TCPSOCKET_BIND_UNOPENED();
 void TCPSOCKET_RECV_100K();
 void TCPSOCKET_RECV_100K_NONBLOCK();
+void TCPSOCKET_RECV_BUFFER();
 void TCPSOCKET_RECV_TIMEOUT();
+void TCPSOCKET_SENDMSG();
 void TCPSOCKET_SEND_REPEAT();
 void TCPSOCKET_SEND_TIMEOUT();
 void TCPSOCKET_THREAD_PER_SOCKET_SAFETY();
 void TCPSOCKET_SETSOCKOPT_KEEPALIVE_VALID();
+void TCPSOCKET_SETSOCKOPT_CORK();
 
 #endif //TCP_TESTS_H
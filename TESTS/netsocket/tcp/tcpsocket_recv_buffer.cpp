@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2019, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed.h"
+#include "TCPSocket.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest.h"
+#include "tcp_tests.h"
+
+using namespace utest::v1;
+
+namespace {
+static const int BUFF_SIZE = 1200;
+}
+
+void TCPSOCKET_RECV_BUFFER()
+{
+    TCPSocket sock;
+    if (tcpsocket_connect_to_echo_srv(sock) != NSAPI_ERROR_OK) {
+        TEST_FAIL();
+        return;
+    }
+
+    fill_tx_buffer_ascii(tcp_global::tx_buffer, BUFF_SIZE);
+
+    int sent = sock.send(tcp_global::tx_buffer, BUFF_SIZE);
+    if (sent < 0) {
+        printf("network error %d\n", sent);
+        TEST_FAIL();
+        TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+        return;
+    }
+
+    // The echoed data comes back as a sequence of zero-copy fragments,
+    // each compared in place and released before acquiring the next one
+    int bytes2recv = sent;
+    while (bytes2recv) {
+        nsapi_buffer_t buffer;
+        nsapi_size_or_error_t recvd = sock.recv_buffer(&buffer);
+        if (recvd == NSAPI_ERROR_UNSUPPORTED) {
+            TEST_IGNORE_MESSAGE("zero-copy receive not supported by the stack");
+            TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+            return;
+        } else if (recvd < 0) {
+            printf("network error %d\n", recvd);
+            TEST_FAIL();
+            TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+            return;
+        }
+        TEST_ASSERT_EQUAL(recvd, buffer.len);
+        TEST_ASSERT(buffer.len <= (nsapi_size_t)bytes2recv);
+        TEST_ASSERT_EQUAL(0, memcmp(&tcp_global::tx_buffer[sent - bytes2recv],
+                                    buffer.data, buffer.len));
+        bytes2recv -= buffer.len;
+        TEST_ASSERT_EQUAL(0, sock.release_recv_buffer(&buffer));
+    }
+
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2019, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed.h"
+#include "TCPSocket.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest.h"
+#include "tcp_tests.h"
+
+using namespace utest::v1;
+
+namespace {
+static const int HEADER_LEN = 16;
+static const int PAYLOAD_LEN = 100;
+}
+
+void TCPSOCKET_SENDMSG()
+{
+    TCPSocket sock;
+    if (tcpsocket_connect_to_echo_srv(sock) != NSAPI_ERROR_OK) {
+        TEST_FAIL();
+        return;
+    }
+
+    // Header and payload live in separate buffers and are gathered by
+    // the stack instead of being assembled into a scratch buffer first
+    fill_tx_buffer_ascii(tcp_global::tx_buffer, HEADER_LEN + PAYLOAD_LEN);
+
+    nsapi_iovec_t iov[2];
+    iov[0].iov_base = tcp_global::tx_buffer;
+    iov[0].iov_len = HEADER_LEN;
+    iov[1].iov_base = &tcp_global::tx_buffer[HEADER_LEN];
+    iov[1].iov_len = PAYLOAD_LEN;
+
+    nsapi_size_or_error_t sent = sock.sendmsg(iov, 2);
+    if (sent == NSAPI_ERROR_UNSUPPORTED) {
+        TEST_IGNORE_MESSAGE("vectored send not supported by the stack");
+        TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+        return;
+    }
+    TEST_ASSERT_EQUAL(HEADER_LEN + PAYLOAD_LEN, sent);
+
+    int bytes2recv = sent;
+    while (bytes2recv) {
+        nsapi_size_or_error_t recvd = sock.recv(&(tcp_global::rx_buffer[sent - bytes2recv]), bytes2recv);
+        if (recvd < 0) {
+            printf("network error %d\n", recvd);
+            TEST_FAIL();
+            TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+            return;
+        }
+        bytes2recv -= recvd;
+    }
+    TEST_ASSERT_EQUAL(0, memcmp(tcp_global::tx_buffer, tcp_global::rx_buffer, sent));
+
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2019, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed.h"
+#include "TCPSocket.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest.h"
+#include "tcp_tests.h"
+
+using namespace utest::v1;
+
+namespace {
+static const int PIECE_LEN = 20;
+static const int PIECES = 5;
+}
+
+void TCPSOCKET_SETSOCKOPT_CORK()
+{
+    TCPSocket sock;
+    if (tcpsocket_connect_to_echo_srv(sock) != NSAPI_ERROR_OK) {
+        TEST_FAIL();
+        return;
+    }
+
+    int enabled = 1;
+    nsapi_error_t ret = sock.setsockopt(NSAPI_SOCKET, NSAPI_CORK, &enabled, sizeof(enabled));
+    if (ret == NSAPI_ERROR_UNSUPPORTED) {
+        TEST_IGNORE_MESSAGE("NSAPI_CORK not supported by the stack");
+        TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+        return;
+    }
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, ret);
+
+    // A corked burst of small writes is held back and coalesced; the
+    // data must still arrive intact and in order after uncorking
+    fill_tx_buffer_ascii(tcp_global::tx_buffer, PIECES * PIECE_LEN);
+    for (int i = 0; i < PIECES; i++) {
+        TEST_ASSERT_EQUAL(PIECE_LEN, sock.send(&tcp_global::tx_buffer[i * PIECE_LEN], PIECE_LEN));
+    }
+
+    int disabled = 0;
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.setsockopt(NSAPI_SOCKET, NSAPI_CORK, &disabled, sizeof(disabled)));
+
+    int bytes2recv = PIECES * PIECE_LEN;
+    while (bytes2recv) {
+        nsapi_size_or_error_t recvd = sock.recv(&(tcp_global::rx_buffer[PIECES * PIECE_LEN - bytes2recv]), bytes2recv);
+        if (recvd < 0) {
+            printf("network error %d\n", recvd);
+            TEST_FAIL();
+            TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+            return;
+        }
+        bytes2recv -= recvd;
+    }
+    TEST_ASSERT_EQUAL(0, memcmp(tcp_global::tx_buffer, tcp_global::rx_buffer, PIECES * PIECE_LEN));
+
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+}
@@ -122,6 +122,7 @@ Case cases[] = {
     Case("UDPSOCKET_ECHOTEST_BURST", UDPSOCKET_ECHOTEST_BURST),
     Case("UDPSOCKET_ECHOTEST_BURST_NONBLOCK", UDPSOCKET_ECHOTEST_BURST_NONBLOCK),
     Case("UDPSOCKET_SENDTO_REPEAT", UDPSOCKET_SENDTO_REPEAT),
+    Case("UDPSOCKET_RECVFROM_MULTIPLE", UDPSOCKET_RECVFROM_MULTIPLE),
 };
 
 Specification specification(greentea_setup, cases, greentea_teardown, greentea_continue_handlers);
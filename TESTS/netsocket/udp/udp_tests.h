@@ -46,6 +46,7 @@ void UDPSOCKET_BIND_ADDRESS_INVALID();
 void UDPSOCKET_BIND_ADDRESS();
 void UDPSOCKET_BIND_WRONG_TYPE();
 void UDPSOCKET_BIND_UNOPENED();
+void UDPSOCKET_RECVFROM_MULTIPLE();
 void UDPSOCKET_RECV_TIMEOUT();
 void UDPSOCKET_SENDTO_INVALID();
 void UDPSOCKET_SENDTO_REPEAT();
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2019, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed.h"
+#include "UDPSocket.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest.h"
+#include "udp_tests.h"
+
+using namespace utest::v1;
+
+namespace {
+static const int BURST_PKTS = 5;
+static const int PKT_LEN = 100;
+static const int PKT_ATTEMPTS = 10;
+
+char tx_buffer[PKT_LEN];
+char rx_buffers[BURST_PKTS][PKT_LEN];
+}
+
+void UDPSOCKET_RECVFROM_MULTIPLE()
+{
+    SocketAddress udp_addr;
+    get_interface()->gethostbyname(MBED_CONF_APP_ECHO_SERVER_ADDR, &udp_addr);
+    udp_addr.set_port(MBED_CONF_APP_ECHO_SERVER_PORT);
+
+    UDPSocket sock;
+    const int TIMEOUT = 5000; // [ms]
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.open(get_interface()));
+    sock.set_timeout(TIMEOUT);
+
+    fill_tx_buffer_ascii(tx_buffer, PKT_LEN);
+
+    UDPSocket::packet_view views[BURST_PKTS];
+    for (int i = 0; i < BURST_PKTS; i++) {
+        views[i].data = rx_buffers[i];
+        views[i].size = PKT_LEN;
+    }
+
+    // UDP packets may be lost, so retry the burst a few times
+    int recvd_total = 0;
+    for (int attempt = 0; attempt < PKT_ATTEMPTS && recvd_total < BURST_PKTS; attempt++) {
+        for (int x = 0; x < BURST_PKTS; x++) {
+            TEST_ASSERT_EQUAL(PKT_LEN, sock.sendto(udp_addr, tx_buffer, PKT_LEN));
+        }
+
+        recvd_total = 0;
+        while (recvd_total < BURST_PKTS) {
+            nsapi_size_or_error_t recvd = sock.recvfrom_multiple(&views[recvd_total], BURST_PKTS - recvd_total);
+            if (recvd == NSAPI_ERROR_WOULD_BLOCK) {
+                break;
+            } else if (recvd < 0) {
+                printf("network error %d\n", recvd);
+                TEST_FAIL();
+                TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+                return;
+            }
+            recvd_total += recvd;
+        }
+
+        if (recvd_total < BURST_PKTS) {
+            drop_bad_packets(sock, TIMEOUT);
+        }
+    }
+    TEST_ASSERT_EQUAL(BURST_PKTS, recvd_total);
+
+    for (int i = 0; i < BURST_PKTS; i++) {
+        TEST_ASSERT_EQUAL(PKT_LEN, views[i].length);
+        TEST_ASSERT(views[i].address == udp_addr);
+        TEST_ASSERT_EQUAL(0, memcmp(tx_buffer, rx_buffers[i], PKT_LEN));
+    }
+
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+}
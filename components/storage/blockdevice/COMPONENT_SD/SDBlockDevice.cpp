@@ -262,6 +262,11 @@ SDBlockDevice::SDBlockDevice(PinName mosi, PinName miso, PinName sclk, PinName c
     _cs = 1;
     _card_type = SDCARD_NONE;
 
+#if DEVICE_SPI_ASYNCH
+    _async_done = true;
+    _async_event = 0;
+#endif
+
     // Set default to 100kHz for initialisation and 1MHz for data transfer
     MBED_STATIC_ASSERT(((MBED_CONF_SD_INIT_FREQUENCY >= 100000) && (MBED_CONF_SD_INIT_FREQUENCY <= 400000)),
                        "Initialization frequency should be between 100KHz to 400KHz");
@@ -554,13 +559,22 @@ int SDBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
     }
 
     // receive the data : one block at a time
-    while (blockCnt) {
-        if (0 != _read(buffer, _block_size)) {
-            status = SD_BLOCK_DEVICE_ERROR_NO_RESPONSE;
-            break;
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SD_CRC_ENABLED
+    if (_crc_on && (blockCnt > 1)) {
+        // DMA-pipelined receive: checksum of each block is verified
+        // while the next block streams in
+        status = _read_pipelined(buffer, blockCnt);
+    } else
+#endif
+    {
+        while (blockCnt) {
+            if (0 != _read(buffer, _block_size)) {
+                status = SD_BLOCK_DEVICE_ERROR_NO_RESPONSE;
+                break;
+            }
+            buffer += _block_size;
+            --blockCnt;
         }
-        buffer += _block_size;
-        --blockCnt;
     }
     _deselect();
 
@@ -948,6 +962,94 @@ int SDBlockDevice::_read(uint8_t *buffer, uint32_t length)
     return 0;
 }
 
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SD_CRC_ENABLED
+int SDBlockDevice::_read_pipelined(uint8_t *buffer, uint32_t block_cnt)
+{
+    uint8_t *prev = NULL;
+    uint16_t prev_crc = 0;
+    uint32_t crc_result;
+
+    while (block_cnt) {
+        // read until start byte (0xFE)
+        if (false == _wait_token(SPI_START_BLOCK)) {
+            debug_if(SD_DBG, "Read timeout\n");
+            return SD_BLOCK_DEVICE_ERROR_NO_RESPONSE;
+        }
+
+        // Start the DMA receive of this block
+        bool dma = (0 == _transfer_dma(NULL, buffer, _block_size));
+        if (!dma) {
+            _spi.write(NULL, 0, (char *)buffer, _block_size);
+        }
+
+        // Verify the previous block's checksum while this one streams in
+        if (prev) {
+            _crc16.compute((void *)prev, _block_size, &crc_result);
+            if ((uint16_t)crc_result != prev_crc) {
+                debug_if(SD_DBG, "_read_pipelined: Invalid CRC received 0x%" PRIx16 " result of computation 0x%" PRIx16 "\n",
+                         prev_crc, (uint16_t)crc_result);
+                if (dma) {
+                    _transfer_wait();
+                }
+                return SD_BLOCK_DEVICE_ERROR_CRC;
+            }
+        }
+
+        if (dma && (0 != _transfer_wait())) {
+            debug_if(SD_DBG, "Read transfer failed\n");
+            return SD_BLOCK_DEVICE_ERROR_NO_RESPONSE;
+        }
+
+        // Read the CRC16 checksum for the data block
+        prev_crc = (_spi.write(SPI_FILL_CHAR) << 8);
+        prev_crc |= _spi.write(SPI_FILL_CHAR);
+        prev = buffer;
+
+        buffer += _block_size;
+        --block_cnt;
+    }
+
+    // Verify the last block, which has nothing left to overlap with
+    _crc16.compute((void *)prev, _block_size, &crc_result);
+    if ((uint16_t)crc_result != prev_crc) {
+        debug_if(SD_DBG, "_read_pipelined: Invalid CRC received 0x%" PRIx16 " result of computation 0x%" PRIx16 "\n",
+                 prev_crc, (uint16_t)crc_result);
+        return SD_BLOCK_DEVICE_ERROR_CRC;
+    }
+
+    return 0;
+}
+#endif /* DEVICE_SPI_ASYNCH && MBED_CONF_SD_CRC_ENABLED */
+
+#if DEVICE_SPI_ASYNCH
+int SDBlockDevice::_transfer_dma(const uint8_t *tx, uint8_t *rx, uint32_t length)
+{
+    _async_done = false;
+    _async_event = 0;
+    if (_spi.transfer(tx, tx ? (int)length : 0, rx, rx ? (int)length : 0,
+                      mbed::callback(this, &SDBlockDevice::_transfer_done), SPI_EVENT_ALL) != 0) {
+        _async_done = true;
+        return -1;
+    }
+    return 0;
+}
+
+int SDBlockDevice::_transfer_wait()
+{
+    while (!_async_done) {
+        // The data phase runs off the CPU; any CRC work was done before
+        // this wait, so there is nothing left to overlap
+    }
+    return (_async_event & SPI_EVENT_COMPLETE) ? 0 : -1;
+}
+
+void SDBlockDevice::_transfer_done(int event)
+{
+    _async_event = event;
+    _async_done = true;
+}
+#endif /* DEVICE_SPI_ASYNCH */
+
 uint8_t SDBlockDevice::_write(const uint8_t *buffer, uint8_t token, uint32_t length)
 {
 
@@ -957,15 +1059,24 @@ uint8_t SDBlockDevice::_write(const uint8_t *buffer, uint8_t token, uint32_t len
     // indicate start of block
     _spi.write(token);
 
-    // write the data
-    _spi.write((char *)buffer, length, NULL, 0);
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SD_CRC_ENABLED
+    if (_crc_on && (0 == _transfer_dma(buffer, NULL, length))) {
+        // Compute the CRC while DMA streams the block onto the bus
+        _crc16.compute((void *)buffer, length, &crc);
+        _transfer_wait();
+    } else
+#endif
+    {
+        // write the data
+        _spi.write((char *)buffer, length, NULL, 0);
 
 #if MBED_CONF_SD_CRC_ENABLED
-    if (_crc_on) {
-        // Compute CRC
-        _crc16.compute((void *)buffer, length, &crc);
-    }
+        if (_crc_on) {
+            // Compute CRC
+            _crc16.compute((void *)buffer, length, &crc);
+        }
 #endif
+    }
 
     // write the checksum CRC16
     _spi.write(crc >> 8);
@@ -232,6 +232,18 @@ private:
     uint8_t _write(const uint8_t *buffer, uint8_t token, uint32_t length);
     int _freq(void);
 
+#if DEVICE_SPI_ASYNCH
+    /* DMA data phase, so the CRC engine runs while the bus streams */
+    int _transfer_dma(const uint8_t *tx, uint8_t *rx, uint32_t length);
+    int _transfer_wait();
+    void _transfer_done(int event);
+#if MBED_CONF_SD_CRC_ENABLED
+    int _read_pipelined(uint8_t *buffer, uint32_t block_cnt);
+#endif
+    volatile bool _async_done;      /**< Asynchronous data phase has completed */
+    volatile int _async_event;      /**< Completion event of the data phase */
+#endif
+
     /* Chip Select and SPI mode select */
     mbed::DigitalOut _cs;
     void _select();
@@ -22,6 +22,8 @@
 #if DEVICE_ANALOGIN || defined(DOXYGEN_ONLY)
 
 #include "hal/analogin_api.h"
+#include "hal/analogin_burst_api.h"
+#include "platform/Callback.h"
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
 
@@ -65,6 +67,21 @@ public:
         unlock();
     }
 
+    /** Create an AnalogIn from an explicit pinmap
+     *
+     * Skips the pinmap table scan that the pin-based constructor performs.
+     * The pinmap can be built at compile time with get_analogin_pinmap() on
+     * targets that support it, see hal/static_pinmap.h.
+     *
+     * @param pinmap Explicit pinmap for the analogin pin
+     */
+    AnalogIn(const PinMap &pinmap)
+    {
+        lock();
+        analogin_init_direct(&_adc, &pinmap);
+        unlock();
+    }
+
     /** Read the input voltage, represented as a float in the range [0.0, 1.0]
      *
      * @returns A floating-point value representing the current input voltage, measured as a percentage
@@ -90,6 +107,57 @@ public:
         return ret;
     }
 
+#if DEVICE_ANALOGIN_BURST || defined(DOXYGEN_ONLY)
+    /** Capture a burst of samples with a hardware timer trigger and DMA
+     *
+     *  Starts a capture of length samples at rate_hz and returns
+     *  immediately. Conversions are triggered in hardware, so the sample
+     *  spacing is unaffected by RTOS preemption and no CPU time is spent
+     *  per sample. The done callback is invoked from interrupt context
+     *  once the buffer has been filled; it should not perform expensive
+     *  operations.
+     *
+     *  Samples are 16-bit normalized values, as returned by read_u16().
+     *  The buffer must stay valid until the capture completes or is
+     *  aborted. Only one capture may be active per object.
+     *
+     *  Only available on targets with DEVICE_ANALOGIN_BURST support.
+     *
+     *  @param buffer  Destination for the captured samples
+     *  @param length  Number of samples to capture
+     *  @param rate_hz Sample rate in hertz, rounded to the nearest rate the
+     *                 trigger timer can produce
+     *  @param done    Callback invoked on completion
+     *  @return        0 if the capture was started, -1 if one is already active
+     */
+    int capture(uint16_t *buffer, size_t length, float rate_hz, Callback<void()> done)
+    {
+        lock();
+        if (analogin_burst_active(&_adc)) {
+            unlock();
+            return -1;
+        }
+        _capture_cb = done;
+        analogin_burst_start(&_adc, buffer, length, (uint32_t)rate_hz,
+                             &AnalogIn::_burst_handler, (uint32_t)this);
+        unlock();
+        return 0;
+    }
+
+    /** Abort the on-going burst capture
+     *
+     *  Samples already stored remain valid; the completion callback is
+     *  not invoked.
+     */
+    void capture_abort()
+    {
+        lock();
+        analogin_burst_abort(&_adc);
+        _capture_cb = NULL;
+        unlock();
+    }
+#endif
+
     /** An operator shorthand for read()
      *
      * The float() operator can be used as a shorthand for read() to simplify common code sequences
@@ -126,6 +194,18 @@ protected:
         _mutex->unlock();
     }
 
+#if DEVICE_ANALOGIN_BURST
+    static void _burst_handler(uint32_t id)
+    {
+        AnalogIn *handler = (AnalogIn *) id;
+        if (handler->_capture_cb) {
+            handler->_capture_cb();
+        }
+    }
+
+    Callback<void()> _capture_cb;
+#endif
+
     analogin_t _adc;
     static SingletonPtr<PlatformMutex> _mutex;
 #endif //!defined(DOXYGEN_ONLY)
@@ -0,0 +1,192 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drivers/AudioIn.h"
+
+#if DEVICE_AUDIOIN
+
+#include "platform/mbed_critical.h"
+#include <string.h>
+
+namespace mbed {
+
+AudioIn::AudioIn(PinName data, PinName bclk, PinName wclk) :
+    _buffer(NULL), _frame_samples(0), _frame_count(0),
+    _read_idx(0), _ready(0), _overruns(0),
+    _sample_rate(0), _channels(1),
+    _scratch(NULL), _scratch_samples(0), _out_rate(0),
+    _phase(0), _last_sample(0)
+{
+    audioin_init(&_audio, data, bclk, wclk);
+}
+
+AudioIn::~AudioIn()
+{
+    stop();
+    audioin_free(&_audio);
+}
+
+uint32_t AudioIn::set_format(uint32_t sample_rate_hz, uint8_t channels)
+{
+    if (audioin_active(&_audio)) {
+        return 0;
+    }
+    _sample_rate = audioin_format(&_audio, sample_rate_hz, channels);
+    if (_sample_rate != 0) {
+        _channels = channels;
+    }
+    return _sample_rate;
+}
+
+int AudioIn::start(int16_t *buffer, size_t frame_samples, size_t frame_count)
+{
+    if (!buffer || frame_samples == 0 || frame_count < 2 ||
+            _sample_rate == 0 || audioin_active(&_audio)) {
+        return -1;
+    }
+    _buffer = buffer;
+    _frame_samples = frame_samples;
+    _frame_count = frame_count;
+    _read_idx = 0;
+    _ready = 0;
+    _overruns = 0;
+    _phase = 0;
+    _last_sample = 0;
+    audioin_start(&_audio, buffer, frame_samples, frame_count,
+                  &AudioIn::_irq_handler, (uint32_t)this);
+    return 0;
+}
+
+void AudioIn::stop()
+{
+    if (audioin_active(&_audio)) {
+        audioin_stop(&_audio);
+    }
+}
+
+size_t AudioIn::read(int16_t *frame)
+{
+    core_util_critical_section_enter();
+    if (_ready == 0) {
+        core_util_critical_section_exit();
+        return 0;
+    }
+    size_t idx = _read_idx;
+    _read_idx = (idx + 1) % _frame_count;
+    _ready--;
+    core_util_critical_section_exit();
+
+    memcpy(frame, &_buffer[idx * _frame_samples], _frame_samples * sizeof(int16_t));
+    return _frame_samples;
+}
+
+size_t AudioIn::available() const
+{
+    return _ready;
+}
+
+uint32_t AudioIn::overruns() const
+{
+    return _overruns;
+}
+
+int AudioIn::attach(Callback<void(const int16_t *, size_t)> func, uint32_t rate_hz,
+                    int16_t *scratch, size_t scratch_samples)
+{
+    if (rate_hz != 0) {
+        if (_channels != 1 || _sample_rate == 0 || !scratch) {
+            return -1;
+        }
+        /* worst case one extra output sample from the carried phase */
+        if (scratch_samples < (size_t)((uint64_t)_frame_samples * rate_hz / _sample_rate + 1)) {
+            return -1;
+        }
+    }
+    core_util_critical_section_enter();
+    _frame_cb = func;
+    _out_rate = rate_hz;
+    _scratch = scratch;
+    _scratch_samples = scratch_samples;
+    _phase = 0;
+    _last_sample = 0;
+    core_util_critical_section_exit();
+    return 0;
+}
+
+void AudioIn::_irq_handler(uint32_t id, uint32_t event)
+{
+    AudioIn *handler = (AudioIn *)id;
+    if (event & AUDIOIN_EVENT_FRAME_COMPLETE) {
+        handler->_frame_irq();
+    }
+}
+
+void AudioIn::_frame_irq()
+{
+    size_t idx = audioin_frame_index(&_audio);
+
+    if (_ready == _frame_count) {
+        /* consumer is behind - hardware is about to rewrite the oldest
+           unread frame, drop it rather than stall the capture */
+        _overruns++;
+        _read_idx = (_read_idx + 1) % _frame_count;
+    } else {
+        _ready++;
+    }
+
+    if (_frame_cb) {
+        const int16_t *frame = &_buffer[idx * _frame_samples];
+        if (_out_rate != 0 && _out_rate != _sample_rate) {
+            size_t out = _resample(frame, _frame_samples);
+            _frame_cb(_scratch, out);
+        } else {
+            _frame_cb(frame, _frame_samples);
+        }
+    }
+}
+
+size_t AudioIn::_resample(const int16_t *in, size_t in_samples)
+{
+    /* Linear interpolation with a Q16 phase accumulator carried across
+       frames; the previous frame's final sample anchors interpolation
+       over the frame boundary. */
+    uint32_t step = (uint32_t)(((uint64_t)_sample_rate << 16) / _out_rate);
+    uint32_t phase = _phase;
+    size_t out = 0;
+
+    while (out < _scratch_samples) {
+        uint32_t ipos = phase >> 16;
+        if (ipos >= in_samples) {
+            break;
+        }
+        uint32_t frac = phase & 0xFFFF;
+        int32_t s0 = (ipos == 0) ? _last_sample : in[ipos - 1];
+        int32_t s1 = in[ipos];
+        /* phase counts from one sample before the frame so s0 is the
+           earlier sample */
+        _scratch[out++] = (int16_t)(s0 + (((s1 - s0) * (int32_t)frac) >> 16));
+        phase += step;
+    }
+
+    _phase = phase - ((uint32_t)in_samples << 16);
+    _last_sample = in[in_samples - 1];
+    return out;
+}
+
+} // namespace mbed
+
+#endif
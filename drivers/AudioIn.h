@@ -0,0 +1,189 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_AUDIOIN_H
+#define MBED_AUDIOIN_H
+
+#include "platform/platform.h"
+
+#if DEVICE_AUDIOIN || defined(DOXYGEN_ONLY)
+
+#include "hal/audioin_api.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** An audio input, capturing PCM frames from an I2S, SAI or PDM
+ *  microphone with DMA
+ *
+ * The driver divides a caller-supplied buffer into fixed-size frames and
+ * lets the hardware fill them in a circle; no CPU time is spent per
+ * sample. Completed frames are consumed either by polling read() or
+ * through a per-frame callback attached with attach(), which can also
+ * deliver the frames converted to a different sample rate.
+ *
+ * The frame ring has single-producer single-consumer semantics: frames
+ * are produced from interrupt context and must be consumed from one
+ * context only. If the consumer falls behind, the hardware overwrites
+ * the oldest unread frame and the overrun counter is incremented -
+ * capture never stalls.
+ *
+ * @note Synchronization level: Interrupt safe
+ *
+ * Example:
+ * @code
+ * // Stream a PDM microphone at 16 kHz into 10 ms frames
+ *
+ * #include "mbed.h"
+ *
+ * AudioIn mic(MIC_DATA, MIC_CLK);
+ * int16_t ring[160 * 8];
+ * int16_t frame[160];
+ *
+ * int main() {
+ *     mic.set_format(16000);
+ *     mic.start(ring, 160, 8);
+ *     while (1) {
+ *         if (mic.read(frame)) {
+ *             process(frame, 160);
+ *         }
+ *     }
+ * }
+ * @endcode
+ * @ingroup drivers
+ */
+class AudioIn : private NonCopyable<AudioIn> {
+
+public:
+
+    /** Create an AudioIn, connected to the specified pins
+     *
+     * @param data The data (SD/PDM data) pin
+     * @param bclk The bit clock (SCK/PDM clock) pin
+     * @param wclk The word select pin, or NC for a PDM microphone
+     */
+    AudioIn(PinName data, PinName bclk, PinName wclk = NC);
+
+    /** Configure the capture format
+     *
+     *  Must be called before start(). The peripheral clock tree may not
+     *  be able to produce the requested rate exactly; the rate actually
+     *  configured is returned and should be used for any downstream
+     *  processing.
+     *
+     * @param sample_rate_hz Requested sample rate in hertz
+     * @param channels       Number of channels, interleaved in each frame (default: 1)
+     * @return The actual sample rate configured, or 0 if the format is unsupported
+     */
+    uint32_t set_format(uint32_t sample_rate_hz, uint8_t channels = 1);
+
+    /** Start capturing into the given buffer
+     *
+     *  The buffer holds frame_count frames of frame_samples samples each
+     *  and must stay valid until stop() is called. At least two frames
+     *  are required so hardware can fill one while the previous is
+     *  consumed; more frames buy the consumer more scheduling slack.
+     *
+     * @param buffer        Storage for the frame ring, filled by hardware
+     * @param frame_samples Number of samples in one frame
+     * @param frame_count   Number of frames in the buffer (at least 2)
+     * @return 0 if the capture was started, -1 on invalid arguments or if
+     *         one is already active
+     */
+    int start(int16_t *buffer, size_t frame_samples, size_t frame_count);
+
+    /** Stop the capture
+     *
+     *  Frames already captured remain readable until start() is called
+     *  again.
+     */
+    void stop();
+
+    /** Copy the oldest unread frame out of the ring
+     *
+     *  Non-blocking. The frame is copied because hardware keeps writing
+     *  the ring while the caller holds the data.
+     *
+     * @param frame Destination for one frame of samples
+     * @return Number of samples copied, 0 if no unread frame is available
+     */
+    size_t read(int16_t *frame);
+
+    /** Get the number of unread frames in the ring */
+    size_t available() const;
+
+    /** Get the number of frames lost because the consumer fell behind */
+    uint32_t overruns() const;
+
+    /** Attach a callback invoked on each completed frame
+     *
+     *  The callback runs in interrupt context and receives a pointer to
+     *  the frame inside the ring together with the sample count; it must
+     *  finish well within one frame period. Typical use is signalling a
+     *  processing thread, or feeding a pipeline ring.
+     *
+     *  When rate_hz is non-zero the frame is first converted to that
+     *  sample rate by linear interpolation into the caller-supplied
+     *  scratch buffer and the callback receives the converted samples
+     *  instead. The conversion phase is carried across frames so the
+     *  output stream is continuous. Rate conversion supports mono
+     *  capture only; scratch must hold at least
+     *  frame_samples * rate_hz / actual capture rate + 1 samples.
+     *
+     * @param func            Callback invoked per frame, NULL to detach
+     * @param rate_hz         Output sample rate, 0 to deliver raw frames (default: 0)
+     * @param scratch         Buffer for rate-converted output (default: NULL)
+     * @param scratch_samples Capacity of the scratch buffer (default: 0)
+     * @return 0 on success, -1 if rate conversion is requested without a
+     *         sufficient scratch buffer or with multi-channel capture
+     */
+    int attach(Callback<void(const int16_t *, size_t)> func, uint32_t rate_hz = 0,
+               int16_t *scratch = NULL, size_t scratch_samples = 0);
+
+    virtual ~AudioIn();
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    static void _irq_handler(uint32_t id, uint32_t event);
+    void _frame_irq();
+    size_t _resample(const int16_t *in, size_t in_samples);
+
+    audioin_t _audio;
+    Callback<void(const int16_t *, size_t)> _frame_cb;
+    int16_t *_buffer;
+    size_t _frame_samples;
+    size_t _frame_count;
+    volatile size_t _read_idx;
+    volatile size_t _ready;
+    volatile uint32_t _overruns;
+    uint32_t _sample_rate;
+    uint8_t _channels;
+    /* rate conversion state */
+    int16_t *_scratch;
+    size_t _scratch_samples;
+    uint32_t _out_rate;
+    uint32_t _phase;      /* Q16 position within the input stream */
+    int16_t _last_sample; /* final input sample of the previous frame */
+#endif //!defined(DOXYGEN_ONLY)
+};
+
+} // namespace mbed
+
+#endif
+
+#endif
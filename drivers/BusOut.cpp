@@ -19,6 +19,26 @@
 
 namespace mbed {
 
+#if DEVICE_PORTOUT
+/* Recover the port and bit position of a pin by checking candidate linear
+ * PinName encodings against the target's own port_pin mapping. Targets with
+ * an irregular encoding fail every check and BusOut keeps per-pin writes. */
+static bool find_port_pin(PinName pin, PortName *port, int *index)
+{
+    static const int pins_per_port[] = {32, 16, 8};
+    for (size_t i = 0; i < sizeof(pins_per_port) / sizeof(pins_per_port[0]); i++) {
+        PortName candidate = (PortName)((int)pin / pins_per_port[i]);
+        int bit = (int)pin % pins_per_port[i];
+        if (port_pin(candidate, bit) == pin) {
+            *port = candidate;
+            *index = bit;
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
 BusOut::BusOut(PinName p0, PinName p1, PinName p2, PinName p3, PinName p4, PinName p5, PinName p6, PinName p7, PinName p8, PinName p9, PinName p10, PinName p11, PinName p12, PinName p13, PinName p14, PinName p15)
 {
     PinName pins[16] = {p0, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15};
@@ -31,6 +51,9 @@ BusOut::BusOut(PinName p0, PinName p1, PinName p2, PinName p3, PinName p4, PinNa
             _nc_mask |= (1 << i);
         }
     }
+#if DEVICE_PORTOUT
+    _init_port_write(pins);
+#endif
 }
 
 BusOut::BusOut(PinName pins[16])
@@ -43,7 +66,64 @@ BusOut::BusOut(PinName pins[16])
             _nc_mask |= (1 << i);
         }
     }
+#if DEVICE_PORTOUT
+    _init_port_write(pins);
+#endif
+}
+
+#if DEVICE_PORTOUT
+void BusOut::_init_port_write(const PinName *pins)
+{
+    // No lock needed in the constructor
+    _use_port = false;
+    _linear_shift = -1;
+    _bus_bits = 0;
+
+    PortName port = (PortName)0;
+    int index[16];
+    uint32_t port_mask = 0;
+    for (int i = 0; i < 16; i++) {
+        _port_bit[i] = 0;
+        if (pins[i] == NC) {
+            continue;
+        }
+        PortName pin_port;
+        if (!find_port_pin(pins[i], &pin_port, &index[i])) {
+            return;
+        }
+        if (_bus_bits == 0) {
+            port = pin_port;
+        } else if (pin_port != port) {
+            // Pins span multiple ports - keep per-pin writes
+            return;
+        }
+        _port_bit[i] = 1UL << index[i];
+        port_mask |= _port_bit[i];
+        _bus_bits = i + 1;
+    }
+    if (_bus_bits == 0) {
+        return;
+    }
+
+    // The pins are already outputs, port_init only records the grouping
+    port_init(&_port, port, (int)port_mask, PIN_OUTPUT);
+    _use_port = true;
+
+    // A gap-free bus on consecutive port bits collapses to a plain shift
+    if (_nc_mask == (1 << _bus_bits) - 1) {
+        bool linear = true;
+        for (int i = 1; i < _bus_bits; i++) {
+            if (index[i] != index[0] + i) {
+                linear = false;
+                break;
+            }
+        }
+        if (linear) {
+            _linear_shift = index[0];
+        }
+    }
 }
+#endif
 
 BusOut::~BusOut()
 {
@@ -58,6 +138,25 @@ BusOut::~BusOut()
 void BusOut::write(int value)
 {
     lock();
+#if DEVICE_PORTOUT
+    if (_use_port) {
+        uint32_t out;
+        if (_linear_shift >= 0) {
+            // Bits outside the port mask are ignored by port_write
+            out = (uint32_t)value << _linear_shift;
+        } else {
+            out = 0;
+            for (int i = 0; i < _bus_bits; i++) {
+                if (value & (1 << i)) {
+                    out |= _port_bit[i];
+                }
+            }
+        }
+        port_write(&_port, (int)out);
+        unlock();
+        return;
+    }
+#endif
     for (int i = 0; i < 16; i++) {
         if (_pin[i] != 0) {
             _pin[i]->write((value >> i) & 1);
@@ -66,6 +165,41 @@ void BusOut::write(int value)
     unlock();
 }
 
+void BusOut::write_pattern(const uint8_t *values, size_t count)
+{
+    lock();
+#if DEVICE_PORTOUT
+    if (_use_port) {
+        if (_linear_shift >= 0) {
+            for (size_t n = 0; n < count; n++) {
+                port_write(&_port, (int)((uint32_t)values[n] << _linear_shift));
+            }
+        } else {
+            int bits = _bus_bits < 8 ? _bus_bits : 8;
+            for (size_t n = 0; n < count; n++) {
+                uint32_t out = 0;
+                for (int i = 0; i < bits; i++) {
+                    if (values[n] & (1 << i)) {
+                        out |= _port_bit[i];
+                    }
+                }
+                port_write(&_port, (int)out);
+            }
+        }
+        unlock();
+        return;
+    }
+#endif
+    for (size_t n = 0; n < count; n++) {
+        for (int i = 0; i < 8; i++) {
+            if (_pin[i] != 0) {
+                _pin[i]->write((values[n] >> i) & 1);
+            }
+        }
+    }
+    unlock();
+}
+
 int BusOut::read()
 {
     lock();
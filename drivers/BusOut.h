@@ -21,6 +21,10 @@
 #include "platform/PlatformMutex.h"
 #include "platform/NonCopyable.h"
 
+#if DEVICE_PORTOUT
+#include "hal/port_api.h"
+#endif
+
 namespace mbed {
 /** \addtogroup drivers */
 
@@ -70,11 +74,27 @@ public:
     virtual ~BusOut();
 
     /** Write the value to the output bus
+     *
+     *  When every connected pin sits on the same GPIO port the value is
+     *  shuffled through a precomputed mask table and written with a single
+     *  port access; otherwise each pin is written individually.
      *
      *  @param value An integer specifying a bit to write for every corresponding DigitalOut pin
      */
     void write(int value);
 
+    /** Stream a sequence of byte values to the low eight bus bits
+     *
+     *  Each byte is driven onto bus bits 0-7 back-to-back, as fast as the
+     *  bus allows. On buses that collapse to a single GPIO port this is one
+     *  port write per byte, suitable for feeding parallel peripherals such
+     *  as LCD data buses at multi-megabyte rates.
+     *
+     *  @param values Bytes to drive onto the bus, in order
+     *  @param count  Number of bytes to write
+     */
+    void write_pattern(const uint8_t *values, size_t count);
+
     /** Read the value currently output on the bus
      *
      *  @returns
@@ -121,6 +141,18 @@ protected:
      */
     int _nc_mask;
 
+#if DEVICE_PORTOUT
+    /* Set up the single-port fast path when all connected pins share a port */
+    void _init_port_write(const PinName *pins);
+
+    /* One-port fast path state */
+    port_t _port;
+    uint32_t _port_bit[16];   /* Port mask of each bus bit, 0 when NC */
+    int _bus_bits;            /* Highest connected bus bit plus one */
+    int _linear_shift;        /* Port bit of bus bit 0 when the mapping is a plain shift, -1 otherwise */
+    bool _use_port;           /* All connected pins share one GPIO port */
+#endif
+
     PlatformMutex _mutex;
 #endif
 };
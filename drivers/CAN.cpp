@@ -18,6 +18,7 @@
 
 #if DEVICE_CAN
 
+#include "platform/mbed_critical.h"
 #include "platform/mbed_power_mgmt.h"
 
 namespace mbed {
@@ -30,6 +31,11 @@ CAN::CAN(PinName rd, PinName td) : _can(), _irq()
         _irq[i] = NULL;
     }
 
+#if MBED_CONF_DRIVERS_CAN_RXBUF_SIZE
+    _rx_ring_head = _rx_ring_tail = _rx_ring_drops = 0;
+    _rx_ring_enabled = false;
+#endif
+
     can_init(&_can, rd, td);
     can_irq_init(&_can, (&CAN::_irq_handler), (uint32_t)this);
 }
@@ -42,6 +48,11 @@ CAN::CAN(PinName rd, PinName td, int hz) : _can(), _irq()
         _irq[i] = NULL;
     }
 
+#if MBED_CONF_DRIVERS_CAN_RXBUF_SIZE
+    _rx_ring_head = _rx_ring_tail = _rx_ring_drops = 0;
+    _rx_ring_enabled = false;
+#endif
+
     can_init_freq(&_can, rd, td, hz);
     can_irq_init(&_can, (&CAN::_irq_handler), (uint32_t)this);
 }
@@ -149,6 +160,122 @@ void CAN::attach(Callback<void()> func, IrqType type)
     unlock();
 }
 
+#if MBED_CONF_DRIVERS_CAN_RXBUF_SIZE
+
+void CAN::rx_ring_enable()
+{
+    lock();
+    if (!_rx_ring_enabled) {
+        _rx_ring_head = _rx_ring_tail = _rx_ring_drops = 0;
+        for (int i = 0; i < MBED_CONF_DRIVERS_CAN_FILTER_TABLE_SIZE; i++) {
+            _rx_filters[i].handler = NULL;
+        }
+        _rx_ring_enabled = true;
+        attach(callback(this, &CAN::rx_ring_irq), RxIrq);
+    }
+    unlock();
+}
+
+void CAN::rx_ring_disable()
+{
+    lock();
+    if (_rx_ring_enabled) {
+        attach(NULL, RxIrq);
+        _rx_ring_enabled = false;
+    }
+    unlock();
+}
+
+int CAN::filter_attach(unsigned int id_first, unsigned int id_last, Callback<void(const CANMessage &)> handler)
+{
+    int index = -1;
+    lock();
+    for (int i = 0; i < MBED_CONF_DRIVERS_CAN_FILTER_TABLE_SIZE; i++) {
+        if (!_rx_filters[i].handler) {
+            core_util_critical_section_enter();
+            _rx_filters[i].id_first = id_first;
+            _rx_filters[i].id_last = id_last;
+            _rx_filters[i].handler = handler;
+            core_util_critical_section_exit();
+            index = i;
+            break;
+        }
+    }
+    unlock();
+    return index;
+}
+
+void CAN::filter_detach(int index)
+{
+    if ((index < 0) || (index >= MBED_CONF_DRIVERS_CAN_FILTER_TABLE_SIZE)) {
+        return;
+    }
+    lock();
+    core_util_critical_section_enter();
+    _rx_filters[index].handler = NULL;
+    core_util_critical_section_exit();
+    unlock();
+}
+
+const CANMessage *CAN::peek() const
+{
+    if (_rx_ring_tail == _rx_ring_head) {
+        return NULL;
+    }
+    return &_rx_ring[_rx_ring_tail];
+}
+
+void CAN::free_message()
+{
+    core_util_critical_section_enter();
+    if (_rx_ring_tail != _rx_ring_head) {
+        _rx_ring_tail = (_rx_ring_tail + 1) % MBED_CONF_DRIVERS_CAN_RXBUF_SIZE;
+    }
+    core_util_critical_section_exit();
+}
+
+unsigned int CAN::rx_ring_overruns() const
+{
+    return _rx_ring_drops;
+}
+
+void CAN::rx_ring_irq()
+{
+    /* Drain every pending frame so a burst does not depend on one
+     * interrupt per frame being serviced in time. */
+    for (;;) {
+        unsigned int next = (_rx_ring_head + 1) % MBED_CONF_DRIVERS_CAN_RXBUF_SIZE;
+        bool ring_full = (next == _rx_ring_tail);
+        CANMessage scratch;
+        CANMessage &slot = ring_full ? scratch : _rx_ring[_rx_ring_head];
+
+        if (!can_read(&_can, &slot, 0)) {
+            break;
+        }
+
+        /* Dispatched frames are consumed in place and never occupy a slot */
+        bool dispatched = false;
+        for (int i = 0; i < MBED_CONF_DRIVERS_CAN_FILTER_TABLE_SIZE; i++) {
+            if (_rx_filters[i].handler &&
+                    (slot.id >= _rx_filters[i].id_first) && (slot.id <= _rx_filters[i].id_last)) {
+                _rx_filters[i].handler(slot);
+                dispatched = true;
+                break;
+            }
+        }
+
+        if (!dispatched) {
+            if (ring_full) {
+                _rx_ring_drops++;
+            } else {
+                _rx_ring_head = next;
+            }
+        }
+    }
+}
+
+#endif // MBED_CONF_DRIVERS_CAN_RXBUF_SIZE
+
 void CAN::_irq_handler(uint32_t id, CanIrqType type)
 {
     CAN *handler = (CAN *)id;
@@ -26,6 +26,18 @@
 #include "platform/PlatformMutex.h"
 #include "platform/NonCopyable.h"
 
+/* Number of frames in the driver-owned receive ring; 0 (the default)
+ * compiles the ring and the ID-range dispatch table out entirely.
+ * Configurable through drivers.can-rxbuf-size. */
+#ifndef MBED_CONF_DRIVERS_CAN_RXBUF_SIZE
+#define MBED_CONF_DRIVERS_CAN_RXBUF_SIZE 0
+#endif
+
+/* Number of entries in the ID-range filter dispatch table */
+#ifndef MBED_CONF_DRIVERS_CAN_FILTER_TABLE_SIZE
+#define MBED_CONF_DRIVERS_CAN_FILTER_TABLE_SIZE 4
+#endif
+
 namespace mbed {
 /** \addtogroup drivers */
 
@@ -291,12 +303,89 @@ public:
         attach(callback(obj, method), type);
     }
 
+#if MBED_CONF_DRIVERS_CAN_RXBUF_SIZE || defined(DOXYGEN_ONLY)
+    /** Enable the driver-owned receive ring.
+     *
+     *  Frames are copied out of the peripheral from the receive interrupt
+     *  into an internal pool, so bursts survive reader-thread preemption.
+     *  Frames whose ID matches an entry installed with filter_attach() are
+     *  handed to that entry's callback directly from the interrupt;
+     *  everything else is kept in the ring for peek()/free_message().
+     *
+     *  Takes over the RxIrq slot; do not combine with attach(..., RxIrq).
+     *  Only compiled in when drivers.can-rxbuf-size is non-zero.
+     */
+    void rx_ring_enable();
+
+    /** Disable the driver-owned receive ring and release the RxIrq slot. */
+    void rx_ring_disable();
+
+    /** Route an ID range to a callback, dispatched from the receive interrupt.
+     *
+     *  The callback is invoked in interrupt context with a reference to
+     *  the frame in the driver pool - a pointer handoff, no copy. The
+     *  frame is only valid for the duration of the call; a consumer
+     *  needing to defer work should push the reference contents to its
+     *  own queue.
+     *
+     *  @param id_first First CAN ID of the range (inclusive)
+     *  @param id_last  Last CAN ID of the range (inclusive)
+     *  @param handler  Callback receiving matching frames
+     *  @returns        Table index on success, -1 if the table is full
+     */
+    int filter_attach(unsigned int id_first, unsigned int id_last, Callback<void(const CANMessage &)> handler);
+
+    /** Remove an ID-range dispatch entry.
+     *
+     *  @param index Table index returned by filter_attach()
+     */
+    void filter_detach(int index);
+
+    /** Get a pointer to the oldest unclaimed frame in the receive ring.
+     *
+     *  The frame stays owned by the driver; call free_message() once it
+     *  has been consumed to release the slot. This replaces the
+     *  copy-under-lock of read() with a pointer handoff.
+     *
+     *  @returns Pointer to the oldest frame, or NULL if the ring is empty
+     */
+    const CANMessage *peek() const;
+
+    /** Release the frame returned by peek(). */
+    void free_message();
+
+    /** Number of frames dropped because the receive ring was full.
+     *
+     *  @returns Dropped-frame count since rx_ring_enable()
+     */
+    unsigned int rx_ring_overruns() const;
+#endif
+
     static void _irq_handler(uint32_t id, CanIrqType type);
 
 #if !defined(DOXYGEN_ONLY)
 protected:
     virtual void lock();
     virtual void unlock();
+
+#if MBED_CONF_DRIVERS_CAN_RXBUF_SIZE
+    /* Drain the peripheral into the pool and dispatch matching frames */
+    void rx_ring_irq();
+
+    struct rx_filter_entry {
+        unsigned int id_first;
+        unsigned int id_last;
+        Callback<void(const CANMessage &)> handler;
+    };
+
+    CANMessage _rx_ring[MBED_CONF_DRIVERS_CAN_RXBUF_SIZE];
+    rx_filter_entry _rx_filters[MBED_CONF_DRIVERS_CAN_FILTER_TABLE_SIZE];
+    unsigned int _rx_ring_head;  /* next slot the ISR fills */
+    unsigned int _rx_ring_tail;  /* oldest unclaimed frame */
+    unsigned int _rx_ring_drops;
+    bool _rx_ring_enabled;
+#endif
+
     can_t               _can;
     Callback<void()>    _irq[IrqCnt];
     PlatformMutex       _mutex;
@@ -0,0 +1,328 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drivers/DeltaUpdate.h"
+
+#if DEVICE_FLASH
+
+#include <string.h>
+#include <new>
+
+namespace mbed {
+
+/* Parser states, advanced by feed() as patch bytes arrive */
+enum {
+    STATE_MAGIC,
+    STATE_SIZE,
+    STATE_CRC,
+    STATE_OP,
+    STATE_COPY,
+    STATE_LITERAL_LEN,
+    STATE_LITERAL,
+    STATE_DONE,
+    STATE_ERROR
+};
+
+static const char delta_magic[4] = { 'M', 'D', 'T', '1' };
+
+static uint32_t read_le32(const uint8_t *buf)
+{
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) |
+           ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+DeltaUpdate::DeltaUpdate(FlashIAP *flash, uint32_t source_addr, uint32_t target_addr, uint32_t target_size) :
+    _flash(flash), _source_addr(source_addr), _target_addr(target_addr),
+    _target_size(target_size), _page_buf(NULL), _page_size(0), _page_fill(0),
+    _write_addr(0), _erased_to(0), _image_size(0), _image_crc(0), _written(0),
+    _crc_state(0), _state(STATE_ERROR), _field_fill(0), _op_offset(0),
+    _op_remaining(0)
+{
+}
+
+DeltaUpdate::~DeltaUpdate()
+{
+    delete[] _page_buf;
+}
+
+int DeltaUpdate::begin()
+{
+    _page_size = _flash->get_page_size();
+    uint32_t sector_size = _flash->get_sector_size(_target_addr);
+    if ((_page_size == 0) || (sector_size == MBED_FLASH_INVALID_SIZE) ||
+            (_target_addr % _page_size) || (_target_addr % sector_size)) {
+        return -1;
+    }
+
+    if (!_page_buf) {
+        _page_buf = new (std::nothrow) uint8_t[_page_size];
+        if (!_page_buf) {
+            return -1;
+        }
+    }
+
+    _page_fill = 0;
+    _write_addr = _target_addr;
+    _erased_to = _target_addr;
+    _image_size = 0;
+    _written = 0;
+    _field_fill = 0;
+    _op_remaining = 0;
+    _state = STATE_MAGIC;
+    _crc.compute_partial_start(&_crc_state);
+    return 0;
+}
+
+int DeltaUpdate::flush_page()
+{
+    if (_page_fill == 0) {
+        return 0;
+    }
+
+    // Erase lazily, just ahead of the write position, so only the
+    // sectors the image actually reaches pay the erase time
+    while (_erased_to < _write_addr + _page_fill) {
+        uint32_t sector_size = _flash->get_sector_size(_erased_to);
+        if (sector_size == MBED_FLASH_INVALID_SIZE) {
+            return -1;
+        }
+        if (_flash->erase(_erased_to, sector_size) != 0) {
+            return -1;
+        }
+        _erased_to += sector_size;
+    }
+
+    if (_flash->program(_page_buf, _write_addr, _page_fill) != 0) {
+        return -1;
+    }
+    _write_addr += _page_fill;
+    _page_fill = 0;
+    return 0;
+}
+
+int DeltaUpdate::write_target(const uint8_t *data, uint32_t size)
+{
+    if (_written + size > _image_size) {
+        return -1;
+    }
+    _crc.compute_partial((void *)data, size, &_crc_state);
+    _written += size;
+
+    while (size) {
+        uint32_t chunk = _page_size - _page_fill;
+        if (chunk > size) {
+            chunk = size;
+        }
+        memcpy(_page_buf + _page_fill, data, chunk);
+        _page_fill += chunk;
+        data += chunk;
+        size -= chunk;
+        if (_page_fill == _page_size) {
+            if (flush_page() != 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+int DeltaUpdate::copy_from_source(uint32_t offset, uint32_t length)
+{
+    // Stage source bytes through the free tail of the page buffer, so
+    // copies of any length need no memory beyond the one page
+    while (length) {
+        uint32_t chunk = _page_size - _page_fill;
+        if (chunk > length) {
+            chunk = length;
+        }
+        if (_written + chunk > _image_size) {
+            return -1;
+        }
+        if (_flash->read(_page_buf + _page_fill, _source_addr + offset, chunk) != 0) {
+            return -1;
+        }
+        _crc.compute_partial(_page_buf + _page_fill, chunk, &_crc_state);
+        _written += chunk;
+        _page_fill += chunk;
+        offset += chunk;
+        length -= chunk;
+        if (_page_fill == _page_size) {
+            if (flush_page() != 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+int DeltaUpdate::feed(const void *patch, size_t size)
+{
+    const uint8_t *in = static_cast<const uint8_t *>(patch);
+
+    while (size) {
+        if ((_state == STATE_ERROR) || (_state == STATE_DONE)) {
+            return -1;
+        }
+
+        if (_state == STATE_LITERAL) {
+            uint32_t chunk = (_op_remaining < size) ? _op_remaining : size;
+            if (write_target(in, chunk) != 0) {
+                _state = STATE_ERROR;
+                return -1;
+            }
+            in += chunk;
+            size -= chunk;
+            _op_remaining -= chunk;
+            if (_op_remaining == 0) {
+                _state = (_written == _image_size) ? STATE_DONE : STATE_OP;
+            }
+            continue;
+        }
+
+        if (_state == STATE_OP) {
+            uint8_t op = *in++;
+            size--;
+            _field_fill = 0;
+            if (op == 'C') {
+                _state = STATE_COPY;
+            } else if (op == 'L') {
+                _state = STATE_LITERAL_LEN;
+            } else {
+                _state = STATE_ERROR;
+                return -1;
+            }
+            continue;
+        }
+
+        // The remaining states collect a fixed-size field a byte at a time
+        uint32_t wanted = (_state == STATE_COPY) ? 8 : 4;
+        while (_field_fill < wanted && size) {
+            _field[_field_fill++] = *in++;
+            size--;
+        }
+        if (_field_fill < wanted) {
+            break;
+        }
+        _field_fill = 0;
+
+        switch (_state) {
+            case STATE_MAGIC:
+                if (memcmp(_field, delta_magic, sizeof(delta_magic)) != 0) {
+                    _state = STATE_ERROR;
+                    return -1;
+                }
+                _state = STATE_SIZE;
+                break;
+
+            case STATE_SIZE:
+                _image_size = read_le32(_field);
+                if ((_image_size == 0) || (_image_size > _target_size)) {
+                    _state = STATE_ERROR;
+                    return -1;
+                }
+                _state = STATE_CRC;
+                break;
+
+            case STATE_CRC:
+                _image_crc = read_le32(_field);
+                _state = STATE_OP;
+                break;
+
+            case STATE_COPY:
+                _op_offset = read_le32(_field);
+                _op_remaining = read_le32(&_field[4]);
+                if (copy_from_source(_op_offset, _op_remaining) != 0) {
+                    _state = STATE_ERROR;
+                    return -1;
+                }
+                _state = (_written == _image_size) ? STATE_DONE : STATE_OP;
+                break;
+
+            case STATE_LITERAL_LEN:
+                _op_remaining = read_le32(_field);
+                if (_op_remaining == 0) {
+                    _state = STATE_ERROR;
+                    return -1;
+                }
+                _state = STATE_LITERAL;
+                break;
+        }
+    }
+    return 0;
+}
+
+int DeltaUpdate::finish()
+{
+    if (_state != STATE_DONE) {
+        _state = STATE_ERROR;
+        return -1;
+    }
+    if (flush_page() != 0) {
+        _state = STATE_ERROR;
+        return -1;
+    }
+
+    uint32_t crc = _crc_state;
+    _crc.compute_partial_stop(&crc);
+    if (crc != _image_crc) {
+        _state = STATE_ERROR;
+        return -1;
+    }
+    return 0;
+}
+
+uint32_t DeltaUpdate::image_size() const
+{
+    return _image_size;
+}
+
+uint32_t DeltaUpdate::bytes_written() const
+{
+    return _written;
+}
+
+int DeltaUpdate::block_hashes(FlashIAP *flash, uint32_t addr, uint32_t block_size, uint32_t *hashes, size_t count)
+{
+    uint8_t buf[64];
+    MbedCRC<POLY_32BIT_ANSI, 32> crc;
+
+    if ((block_size == 0) || (!hashes)) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t state;
+        crc.compute_partial_start(&state);
+        uint32_t remaining = block_size;
+        while (remaining) {
+            uint32_t chunk = (remaining < sizeof(buf)) ? remaining : sizeof(buf);
+            if (flash->read(buf, addr, chunk) != 0) {
+                return -1;
+            }
+            crc.compute_partial(buf, chunk, &state);
+            addr += chunk;
+            remaining -= chunk;
+        }
+        crc.compute_partial_stop(&state);
+        hashes[i] = state;
+    }
+    return 0;
+}
+
+} /* namespace mbed */
+
+#endif /* DEVICE_FLASH */
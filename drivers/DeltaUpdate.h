@@ -0,0 +1,184 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_DELTAUPDATE_H
+#define MBED_DELTAUPDATE_H
+
+#include "drivers/FlashIAP.h"
+#include "drivers/MbedCRC.h"
+#include "platform/NonCopyable.h"
+
+#if DEVICE_FLASH || defined(DOXYGEN_ONLY)
+
+namespace mbed {
+
+/** \addtogroup drivers */
+
+/** Apply a streamed binary delta to internal flash
+ *
+ * Rebuilds a new firmware image in one flash region from the image
+ * already present in another, so only the differences travel over the
+ * network. The patch is fed in as it arrives (from a socket, for
+ * example) in chunks of any size; the applier holds one program page of
+ * RAM and never more, and sectors of the target region are erased
+ * lazily as the write position reaches them, so neither patch size nor
+ * image size affects memory use.
+ *
+ * Patch format, all fields little-endian:
+ *  - 12-byte header: magic "MDT1", uint32 image size, uint32 CRC-32
+ *    (ANSI polynomial) of the rebuilt image
+ *  - a sequence of operations producing exactly image size bytes:
+ *     - 'C' uint32 offset, uint32 length: copy length bytes from the
+ *       source image at offset
+ *     - 'L' uint32 length, raw bytes: emit the bytes that follow
+ *
+ * The per-block CRCs from block_hashes() let the patch generator learn
+ * what the device already holds without downloading the old image.
+ *
+ * @note Synchronization level: Not protected
+ *
+ * Example:
+ * @code
+ * FlashIAP flash;
+ * flash.init();
+ * DeltaUpdate delta(&flash, ACTIVE_BANK_ADDR, SPARE_BANK_ADDR, BANK_SIZE);
+ * delta.begin();
+ * while ((n = socket.recv(buf, sizeof(buf))) > 0) {
+ *     delta.feed(buf, n);
+ * }
+ * if (delta.finish() == 0) {
+ *     // SPARE_BANK_ADDR now holds the verified new image
+ * }
+ * @endcode
+ * @ingroup drivers
+ */
+class DeltaUpdate : private NonCopyable<DeltaUpdate> {
+public:
+
+    /** Create a delta applier between two regions of internal flash
+     *
+     *  @param flash       Initialized flash IAP device
+     *  @param source_addr Start of the image the patch was generated against
+     *  @param target_addr Start of the region the new image is built in,
+     *                     must be sector and page aligned
+     *  @param target_size Size of the target region in bytes
+     */
+    DeltaUpdate(FlashIAP *flash, uint32_t source_addr, uint32_t target_addr, uint32_t target_size);
+
+    ~DeltaUpdate();
+
+    /** Prepare for a new patch stream
+     *
+     *  Allocates the page buffer and resets the parser. No flash is
+     *  touched until the first output byte is produced.
+     *
+     *  @return 0 on success, negative error code on failure
+     */
+    int begin();
+
+    /** Feed the next chunk of the patch stream
+     *
+     *  Chunks can be any size and split the format at any byte; the
+     *  applier carries its parse state between calls.
+     *
+     *  @param patch Next bytes of the patch
+     *  @param size  Number of bytes
+     *  @return 0 on success, negative error code on failure
+     */
+    int feed(const void *patch, size_t size);
+
+    /** Complete the update
+     *
+     *  Flushes the final partial page and checks that the rebuilt image
+     *  is exactly the size the header promised and matches its CRC.
+     *
+     *  @return 0 if the target region holds the verified image,
+     *          negative error code on failure
+     */
+    int finish();
+
+    /** Get the size of the image being rebuilt
+     *
+     *  @return Image size from the patch header, 0 before the header
+     *          has been fed
+     */
+    uint32_t image_size() const;
+
+    /** Get the number of image bytes produced so far
+     *
+     *  Useful for download progress reporting.
+     *
+     *  @return Number of bytes of the new image written or buffered
+     */
+    uint32_t bytes_written() const;
+
+    /** Compute per-block CRCs of a flash region
+     *
+     *  The patch generator compares these against the blocks of the new
+     *  image to decide what can be copied and what must be sent as
+     *  literals.
+     *
+     *  @param flash      Initialized flash IAP device
+     *  @param addr       Start of the region
+     *  @param block_size Bytes per block
+     *  @param hashes     Filled with one CRC-32 per block
+     *  @param count      Number of blocks to hash
+     *  @return 0 on success, negative error code on failure
+     */
+    static int block_hashes(FlashIAP *flash, uint32_t addr, uint32_t block_size, uint32_t *hashes, size_t count);
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    /* Append produced image bytes to the page buffer, flushing full pages */
+    int write_target(const uint8_t *data, uint32_t size);
+
+    /* Produce a copy operation by staging source bytes through the page buffer */
+    int copy_from_source(uint32_t offset, uint32_t length);
+
+    /* Program the buffered page, erasing sectors the write has reached */
+    int flush_page();
+
+    FlashIAP *_flash;
+    uint32_t _source_addr;
+    uint32_t _target_addr;
+    uint32_t _target_size;
+
+    uint8_t *_page_buf;
+    uint32_t _page_size;
+    uint32_t _page_fill;
+    uint32_t _write_addr;
+    uint32_t _erased_to;
+
+    uint32_t _image_size;
+    uint32_t _image_crc;
+    uint32_t _written;
+    uint32_t _crc_state;
+    MbedCRC<POLY_32BIT_ANSI, 32> _crc;
+
+    /* Parser state carried between feed() calls */
+    uint8_t _state;
+    uint8_t _field[8];
+    uint32_t _field_fill;
+    uint32_t _op_offset;
+    uint32_t _op_remaining;
+#endif
+};
+
+} /* namespace mbed */
+
+#endif  /* DEVICE_FLASH */
+
+#endif  /* MBED_DELTAUPDATE_H */
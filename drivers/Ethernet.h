@@ -61,7 +61,12 @@ class Ethernet : private NonCopyable<Ethernet> {
 public:
 
     /** Initialize the ethernet interface.
+     *  @deprecated since mbed-os-5.11
      */
+    MBED_DEPRECATED_SINCE("mbed-os-5.11",
+                          "Ethernet polls and copies every packet and does not work with "
+                          "EMAC-based targets. Use RawEthernet for raw frame access, or "
+                          "EthernetInterface for IP networking.")
     Ethernet();
 
     /** Powers the hardware down.
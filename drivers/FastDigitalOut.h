@@ -0,0 +1,183 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_FASTDIGITALOUT_H
+#define MBED_FASTDIGITALOUT_H
+
+#include "platform/platform.h"
+#include "hal/gpio_api.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** A digital output with the pin fixed at compile time, for bit-banging
+ *
+ * Same API as DigitalOut, but the pin is a template parameter, so on
+ * targets that publish their GPIO register layout the set/clear register
+ * address and pin mask are resolved at compile time and write() compiles
+ * to a single store to the set/clear register - no call, no struct
+ * loads. Use it where DigitalOut's per-write overhead matters, such as
+ * software-defined protocols clocked in the MHz range.
+ *
+ * Targets opt in by defining MBED_FAST_GPIO_READY in gpio_object.h
+ * together with the following constant-expression macros, each taking a
+ * compile-time PinName:
+ *
+ * - MBED_FAST_GPIO_SET_ADDR(pin) / MBED_FAST_GPIO_SET_VALUE(pin):
+ *   address and value of the store that drives the pin high
+ * - MBED_FAST_GPIO_CLR_ADDR(pin) / MBED_FAST_GPIO_CLR_VALUE(pin):
+ *   address and value of the store that drives the pin low
+ * - MBED_FAST_GPIO_IN_ADDR(pin) / MBED_FAST_GPIO_IN_MASK(pin):
+ *   input register address and mask for reading the pin back
+ *
+ * On targets without MBED_FAST_GPIO_READY the template falls back to the
+ * regular gpio HAL, so code using FastDigitalOut stays portable and is
+ * never slower than DigitalOut.
+ *
+ * The pin is still claimed and configured through the gpio HAL at
+ * construction time; only the data-path accesses bypass it. Unlike
+ * DigitalOut, NC is not supported.
+ *
+ * @note Synchronization level: Interrupt safe
+ *
+ * Example:
+ * @code
+ * // Bit-bang a byte, MSB first
+ * #include "mbed.h"
+ *
+ * FastDigitalOut<D5> data;
+ * FastDigitalOut<D6> clk;
+ *
+ * void send(uint8_t byte) {
+ *     for (int i = 7; i >= 0; i--) {
+ *         data = (byte >> i) & 1;
+ *         clk = 1;
+ *         clk = 0;
+ *     }
+ * }
+ * @endcode
+ * @ingroup drivers
+ */
+template <PinName PIN>
+class FastDigitalOut {
+
+public:
+    /** Create a FastDigitalOut connected to the template pin
+     */
+    FastDigitalOut()
+    {
+        MBED_STATIC_ASSERT(PIN != NC, "FastDigitalOut does not support NC");
+        // No lock needed in the constructor
+        gpio_init_out(&_gpio, PIN);
+    }
+
+    /** Create a FastDigitalOut connected to the template pin
+     *
+     *  @param value the initial pin value
+     */
+    FastDigitalOut(int value)
+    {
+        MBED_STATIC_ASSERT(PIN != NC, "FastDigitalOut does not support NC");
+        // No lock needed in the constructor
+        gpio_init_out_ex(&_gpio, PIN, value);
+    }
+
+    /** Set the output, specified as 0 or 1 (int)
+     *
+     *  @param value An integer specifying the pin output value,
+     *      0 for logical 0, 1 (or any other non-zero value) for logical 1
+     */
+    void write(int value)
+    {
+#ifdef MBED_FAST_GPIO_READY
+        // Single store, address and value are compile-time constants
+        if (value) {
+            *reinterpret_cast<volatile uint32_t *>(MBED_FAST_GPIO_SET_ADDR(PIN)) = MBED_FAST_GPIO_SET_VALUE(PIN);
+        } else {
+            *reinterpret_cast<volatile uint32_t *>(MBED_FAST_GPIO_CLR_ADDR(PIN)) = MBED_FAST_GPIO_CLR_VALUE(PIN);
+        }
+#else
+        // Thread safe / atomic HAL call
+        gpio_write(&_gpio, value);
+#endif
+    }
+
+    /** Return the output setting, represented as 0 or 1 (int)
+     *
+     *  @returns
+     *    an integer representing the output setting of the pin,
+     *    0 for logical 0, 1 for logical 1
+     */
+    int read()
+    {
+#ifdef MBED_FAST_GPIO_READY
+        return (*reinterpret_cast<volatile uint32_t *>(MBED_FAST_GPIO_IN_ADDR(PIN)) & MBED_FAST_GPIO_IN_MASK(PIN)) ? 1 : 0;
+#else
+        // Thread safe / atomic HAL call
+        return gpio_read(&_gpio);
+#endif
+    }
+
+    /** Return 1, FastDigitalOut does not support NC
+     * \sa DigitalOut::is_connected()
+     */
+    int is_connected()
+    {
+        return 1;
+    }
+
+    /** A shorthand for write()
+     * \sa FastDigitalOut::write()
+     */
+    FastDigitalOut &operator= (int value)
+    {
+        // Underlying write is thread safe
+        write(value);
+        return *this;
+    }
+
+    /** A shorthand for write() using the assignment operator which copies the
+     * state from the FastDigitalOut argument.
+     * \sa FastDigitalOut::write()
+     */
+    FastDigitalOut &operator= (FastDigitalOut &rhs)
+    {
+        core_util_critical_section_enter();
+        write(rhs.read());
+        core_util_critical_section_exit();
+        return *this;
+    }
+
+    /** A shorthand for read()
+     * \sa FastDigitalOut::read()
+     */
+    operator int()
+    {
+        // Underlying call is thread safe
+        return read();
+    }
+
+protected:
+#if !defined(DOXYGEN_ONLY)
+    gpio_t _gpio;
+#endif //!defined(DOXYGEN_ONLY)
+};
+
+} // namespace mbed
+
+#endif
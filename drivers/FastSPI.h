@@ -0,0 +1,142 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_FASTSPI_H
+#define MBED_FASTSPI_H
+
+#include "platform/platform.h"
+
+#if DEVICE_SPI || defined(DOXYGEN_ONLY)
+
+#include "hal/spi_api.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** A synchronous-only SPI master with the shared-bus machinery stripped
+ *
+ * SPI carries state for asynchronous transfers, bus-owner tracking and
+ * a shared mutex in every instance, and its write path re-applies the
+ * format whenever another instance touched the peripheral. When a bus
+ * has one user and one thread none of that earns its keep: FastSPI
+ * holds nothing but the HAL object, has no virtual methods, and its
+ * header-only write() compiles down to the spi_master_write call, so
+ * tight register-polling loops pay no dispatch or reacquisition cost
+ * per word.
+ *
+ * In exchange, the peripheral must not be shared: no other SPI or
+ * FastSPI instance may use the same bus, and calls must come from one
+ * thread (or be serialized by the caller). Use SPI wherever that is not
+ * guaranteed.
+ *
+ * @note Synchronization level: Not protected
+ *
+ * Example:
+ * @code
+ * // Drain a sensor FIFO, one 16-bit frame per word
+ * #include "mbed.h"
+ *
+ * FastSPI spi(D11, D12, D13);
+ *
+ * int main() {
+ *     spi.format(16, 0);
+ *     spi.frequency(8000000);
+ *     while (1) {
+ *         process(spi.write(0));
+ *     }
+ * }
+ * @endcode
+ * @ingroup drivers
+ */
+class FastSPI : private NonCopyable<FastSPI> {
+
+public:
+
+    /** Create a FastSPI master connected to the specified pins
+     *
+     *  @param mosi SPI Master Out, Slave In pin
+     *  @param miso SPI Master In, Slave Out pin
+     *  @param sclk SPI Clock pin
+     *  @param ssel SPI Chip Select pin, driven by the peripheral (optional)
+     */
+    FastSPI(PinName mosi, PinName miso, PinName sclk, PinName ssel = NC)
+    {
+        spi_init(&_spi, mosi, miso, sclk, ssel);
+        spi_format(&_spi, 8, 0, 0);
+    }
+
+    /** Configure the data transmission format
+     *
+     *  The format is applied to the peripheral once; there is no other
+     *  bus user to reclaim it from.
+     *
+     *  @param bits Number of bits per SPI frame (4 - 16)
+     *  @param mode Clock polarity and phase mode (0 - 3)
+     */
+    void format(int bits, int mode = 0)
+    {
+        spi_format(&_spi, bits, mode, 0);
+    }
+
+    /** Set the SPI bus clock frequency
+     *
+     *  @param hz Clock frequency in Hz
+     */
+    void frequency(int hz = 1000000)
+    {
+        spi_frequency(&_spi, hz);
+    }
+
+    /** Write to the SPI Slave and return the response
+     *
+     *  @param value Data to be sent to the SPI slave
+     *  @return Response from the SPI slave
+     */
+    int write(int value)
+    {
+        return spi_master_write(&_spi, value);
+    }
+
+    /** Write to the SPI Slave and obtain the response
+     *
+     *  The total number of bytes sent and received will be the maximum of
+     *  tx_length and rx_length. The bytes written will be padded with the
+     *  value 0xff.
+     *
+     *  @param tx_buffer Pointer to the byte-array of data to write to the device
+     *  @param tx_length Number of bytes to write, may be zero
+     *  @param rx_buffer Pointer to the byte-array of data to read from the device
+     *  @param rx_length Number of bytes to read, may be zero
+     *  @return The number of bytes written and read from the device. This is
+     *      maximum of tx_length and rx_length.
+     */
+    int write(const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length)
+    {
+        return spi_master_block_write(&_spi, tx_buffer, tx_length, rx_buffer, rx_length, 0xff);
+    }
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    spi_t _spi;
+#endif
+};
+
+} // namespace mbed
+
+#endif
+
+#endif
@@ -0,0 +1,161 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_FASTSERIAL_H
+#define MBED_FASTSERIAL_H
+
+#include "platform/platform.h"
+
+#if DEVICE_SERIAL || defined(DOXYGEN_ONLY)
+
+#include "hal/serial_api.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** A polled serial port with the interrupt and asynchronous machinery stripped
+ *
+ * SerialBase keeps an interrupt-handler table, flow-control state and
+ * (with DEVICE_SERIAL_ASYNCH) asynchronous transfer state in every
+ * instance, paid for even by ports that only ever poll. FastSerial
+ * holds nothing but the HAL object and its header-only putc/getc
+ * compile down to the HAL calls, so a deployment with many
+ * simple ports saves the per-instance RAM and the per-byte dispatch.
+ *
+ * There is no buffering, no events and no locking: reads and writes
+ * block on the UART data register and calls must come from one thread.
+ * Leave tx or rx NC to claim only one direction - a receive-only
+ * monitor port carries no transmit pin or state at all. Use Serial,
+ * RawSerial or UARTSerial when interrupts, streams or buffering are
+ * needed.
+ *
+ * @note Synchronization level: Not protected
+ *
+ * Example:
+ * @code
+ * // Forward a GPS feed, receive-only
+ * #include "mbed.h"
+ *
+ * FastSerial gps(NC, D0, 9600);
+ *
+ * int main() {
+ *     while (1) {
+ *         parse(gps.getc());
+ *     }
+ * }
+ * @endcode
+ * @ingroup drivers
+ */
+class FastSerial : private NonCopyable<FastSerial> {
+
+public:
+
+    /** Create a FastSerial port connected to the specified pins
+     *
+     *  @param tx Transmit pin, NC for a receive-only port
+     *  @param rx Receive pin, NC for a transmit-only port
+     *  @param baud The baud rate of the serial port (default = MBED_CONF_PLATFORM_DEFAULT_SERIAL_BAUD_RATE)
+     */
+    FastSerial(PinName tx, PinName rx, int baud = MBED_CONF_PLATFORM_DEFAULT_SERIAL_BAUD_RATE)
+    {
+        serial_init(&_serial, tx, rx);
+        serial_baud(&_serial, baud);
+    }
+
+    /** Set the baud rate of the serial port
+     *
+     *  @param baudrate The baudrate of the serial port (default = 9600).
+     */
+    void baud(int baudrate)
+    {
+        serial_baud(&_serial, baudrate);
+    }
+
+    /** Set the transmission format used by the serial port
+     *
+     *  @param bits The number of bits in a word (5-8; default = 8)
+     *  @param parity The parity used (ParityNone, ParityOdd, ParityEven,
+     *                ParityForced1, ParityForced0; default = ParityNone)
+     *  @param stop_bits The number of stop bits (1 or 2; default = 1)
+     */
+    void format(int bits = 8, SerialParity parity = ParityNone, int stop_bits = 1)
+    {
+        serial_format(&_serial, bits, parity, stop_bits);
+    }
+
+    /** Determine if there is a character available to read
+     *
+     *  @returns
+     *    1 if there is a character available to read,
+     *    0 otherwise
+     */
+    int readable()
+    {
+        return serial_readable(&_serial);
+    }
+
+    /** Determine if there is space available to write a character
+     *
+     *  @returns
+     *    1 if there is space to write a character,
+     *    0 otherwise
+     */
+    int writeable()
+    {
+        return serial_writable(&_serial);
+    }
+
+    /** Read a character, blocking until one is available
+     *
+     *  @returns The character read
+     */
+    int getc()
+    {
+        return serial_getc(&_serial);
+    }
+
+    /** Write a character, blocking until it can be accepted
+     *
+     *  @param c The character to write
+     */
+    void putc(int c)
+    {
+        serial_putc(&_serial, c);
+    }
+
+    /** Write a zero-terminated string a character at a time
+     *
+     *  @param str The string to write
+     */
+    void puts(const char *str)
+    {
+        while (*str) {
+            serial_putc(&_serial, *str++);
+        }
+    }
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    serial_t _serial;
+#endif
+};
+
+} // namespace mbed
+
+#endif
+
+#endif
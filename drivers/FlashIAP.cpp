@@ -26,6 +26,7 @@
 #include "device.h"
 #include "FlashIAP.h"
 #include "platform/mbed_assert.h"
+#include "platform/mbed_progress_checkpoint.h"
 #include "platform/ScopedRamExecutionLock.h"
 #include "platform/ScopedRomWriteLock.h"
 
@@ -45,7 +46,7 @@ static inline bool is_aligned(uint32_t number, uint32_t alignment)
     }
 }
 
-FlashIAP::FlashIAP()
+FlashIAP::FlashIAP() : _erase_queue(NULL)
 {
 
 }
@@ -201,11 +202,95 @@ int FlashIAP::erase(uint32_t addr, uint32_t size)
         current_sector_size = flash_get_sector_size(&_flash, addr);
         size -= current_sector_size;
         addr += current_sector_size;
+        /* One sector is the unit of work - kick any watchdog and let
+         * same-priority threads run between sectors */
+        mbed_progress_checkpoint();
     }
     _mutex->unlock();
     return ret;
 }
 
+int FlashIAP::erase_async(uint32_t addr, uint32_t size, events::EventQueue *queue,
+                          Callback<void(int)> complete,
+                          Callback<void(size_t)> progress)
+{
+    uint32_t flash_size = flash_get_size(&_flash);
+    uint32_t flash_start_addr = flash_get_start_address(&_flash);
+    uint32_t flash_end_addr = flash_start_addr + flash_size;
+    uint32_t erase_end_addr = addr + size;
+
+    if (!queue || (erase_end_addr > flash_end_addr)) {
+        return -1;
+    } else if (erase_end_addr < flash_end_addr) {
+        uint32_t following_sector_size = flash_get_sector_size(&_flash, erase_end_addr);
+        if (!is_aligned(erase_end_addr, following_sector_size)) {
+            return -1;
+        }
+    }
+
+    _mutex->lock();
+    if (_erase_queue) {
+        // an asynchronous erase is already in flight
+        _mutex->unlock();
+        return -1;
+    }
+    _erase_queue = queue;
+    _erase_addr = addr;
+    _erase_remaining = size;
+    _erase_done = 0;
+    _erase_complete_cb = complete;
+    _erase_progress_cb = progress;
+    _mutex->unlock();
+
+    if (_erase_queue->call(callback(this, &FlashIAP::erase_async_sector)) == 0) {
+        _erase_queue = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+void FlashIAP::erase_async_sector()
+{
+    int32_t ret;
+
+    _mutex->lock();
+    uint32_t current_sector_size = flash_get_sector_size(&_flash, _erase_addr);
+    {
+        ScopedRamExecutionLock make_ram_executable;
+        ScopedRomWriteLock make_rom_writable;
+        ret = flash_erase_sector(&_flash, _erase_addr);
+    }
+    if (ret == 0) {
+        _erase_addr += current_sector_size;
+        _erase_remaining -= std::min(current_sector_size, _erase_remaining);
+        _erase_done += current_sector_size;
+    }
+    _mutex->unlock();
+
+    if (_erase_progress_cb && (ret == 0)) {
+        _erase_progress_cb(_erase_done);
+    }
+
+    if ((ret != 0) || (_erase_remaining == 0)) {
+        // finished or failed - release the state before notifying, so the
+        // completion callback may start another erase
+        Callback<void(int)> complete = _erase_complete_cb;
+        _erase_queue = NULL;
+        if (complete) {
+            complete((ret == 0) ? 0 : -1);
+        }
+        return;
+    }
+
+    if (_erase_queue->call(callback(this, &FlashIAP::erase_async_sector)) == 0) {
+        Callback<void(int)> complete = _erase_complete_cb;
+        _erase_queue = NULL;
+        if (complete) {
+            complete(-1);
+        }
+    }
+}
+
 uint32_t FlashIAP::get_page_size() const
 {
     return flash_get_page_size(&_flash);
@@ -28,6 +28,8 @@
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
 #include "platform/NonCopyable.h"
+#include "platform/Callback.h"
+#include "events/EventQueue.h"
 #include <algorithm>
 
 // Export ROM end address
@@ -107,6 +109,28 @@ public:
      */
     int erase(uint32_t addr, uint32_t size);
 
+    /** Erase sectors in the background, one sector per dispatched event
+     *
+     *  Validates the range and returns immediately; each sector erase is
+     *  then run as a separate event on the given queue, so the calling
+     *  thread (and other users of the queue) only ever block for a single
+     *  sector instead of the full multi-second region erase. The mutex is
+     *  released between sectors, letting read/program calls interleave.
+     *
+     *  The state of an erased sector is undefined until it has been programmed
+     *
+     *  @param addr     Address of a sector to begin erasing, must be a multiple of the sector size
+     *  @param size     Size to erase in bytes, must be a multiple of the sector size
+     *  @param queue    Queue on which the per-sector erase events are dispatched
+     *  @param complete Called with 0 on success or a negative error code on failure
+     *  @param progress Called after each sector with the number of bytes erased
+     *                  so far (optional)
+     *  @return         0 if the erase was started, negative error code on failure
+     */
+    int erase_async(uint32_t addr, uint32_t size, events::EventQueue *queue,
+                    Callback<void(int)> complete,
+                    Callback<void(size_t)> progress = NULL);
+
     /** Get the sector size at the defined address
      *
      *  Sector size might differ at address ranges.
@@ -154,9 +178,21 @@ private:
      */
     bool is_aligned_to_sector(uint32_t addr, uint32_t size);
 
+    /* Erase one sector of an asynchronous erase and re-post or complete */
+    void erase_async_sector();
+
     flash_t _flash;
     uint8_t *_page_buf;
     static SingletonPtr<PlatformMutex> _mutex;
+
+    /* State of the on-going asynchronous erase, valid while _erase_queue
+     * is not NULL */
+    events::EventQueue *_erase_queue;
+    uint32_t _erase_addr;
+    uint32_t _erase_remaining;
+    size_t _erase_done;
+    Callback<void(int)> _erase_complete_cb;
+    Callback<void(size_t)> _erase_progress_cb;
 #endif
 };
 
@@ -19,6 +19,8 @@
 #include "drivers/DigitalInOut.h"
 #include "platform/mbed_wait_api.h"
 
+#include <string.h>
+
 #if DEVICE_I2C
 
 #if DEVICE_I2C_ASYNCH
@@ -34,7 +36,7 @@ I2C::I2C(PinName sda, PinName scl) :
 #if DEVICE_I2C_ASYNCH
     _irq(this), _usage(DMA_USAGE_NEVER), _deep_sleep_locked(false),
 #endif
-    _i2c(), _hz(100000)
+    _i2c(), _hz(100000), _stats()
 {
     lock();
     // The init function also set the frequency to 100000
@@ -47,6 +49,23 @@ I2C::I2C(PinName sda, PinName scl) :
     unlock();
 }
 
+I2C::I2C(const i2c_pinmap_t &pinmap) :
+#if DEVICE_I2C_ASYNCH
+    _irq(this), _usage(DMA_USAGE_NEVER), _deep_sleep_locked(false),
+#endif
+    _i2c(), _hz(100000), _stats()
+{
+    lock();
+    // The init function also set the frequency to 100000
+    _sda = pinmap.sda_pin;
+    _scl = pinmap.scl_pin;
+    recover(_sda, _scl);
+    i2c_init_direct(&_i2c, &pinmap);
+    // Used to avoid unnecessary frequency updates
+    _owner = this;
+    unlock();
+}
+
 void I2C::frequency(int hz)
 {
     lock();
@@ -79,6 +98,10 @@ int I2C::write(int address, const char *data, int length, bool repeated)
     int stop = (repeated) ? 0 : 1;
     int written = i2c_write(&_i2c, address, data, length, stop);
 
+    _stats.transaction_count++;
+    if (length != written) {
+        _stats.nak_count++;
+    }
     unlock();
     return length != written;
 }
@@ -100,6 +123,10 @@ int I2C::read(int address, char *data, int length, bool repeated)
     int stop = (repeated) ? 0 : 1;
     int read = i2c_read(&_i2c, address, data, length, stop);
 
+    _stats.transaction_count++;
+    if (length != read) {
+        _stats.nak_count++;
+    }
     unlock();
     return length != read;
 }
@@ -141,6 +168,44 @@ void I2C::unlock()
     _mutex->unlock();
 }
 
+int I2C::recover(void)
+{
+    lock();
+    int ret = recover(_sda, _scl);
+    if (ret == 0) {
+        // The pulse sequence drove the pins as GPIO - hand them back to
+        // the peripheral and restore the configured frequency
+        i2c_init(&_i2c, _sda, _scl);
+        i2c_frequency(&_i2c, _hz);
+        _owner = this;
+        _stats.recovery_count++;
+    } else {
+        _stats.recovery_fail_count++;
+    }
+    unlock();
+    return ret;
+}
+
+void I2C::get_stats(i2c_bus_stats_t *stats)
+{
+    lock();
+    *stats = _stats;
+    i2c_hal_stats_t hal_stats;
+    if (i2c_get_stats(&_i2c, &hal_stats) == 0) {
+        stats->arbitration_lost_count = hal_stats.arbitration_lost_count;
+        stats->stretch_time_usec = hal_stats.stretch_time_usec;
+    }
+    unlock();
+}
+
+void I2C::clear_stats(void)
+{
+    lock();
+    memset(&_stats, 0, sizeof(_stats));
+    i2c_clear_stats(&_i2c);
+    unlock();
+}
+
 int I2C::recover(PinName sda, PinName scl)
 {
     DigitalInOut pin_sda(sda, PIN_INPUT, PullNone, 1);
@@ -189,13 +254,25 @@ int I2C::recover(PinName sda, PinName scl)
 
 #if DEVICE_I2C_ASYNCH
 
+#if TRANSACTION_QUEUE_SIZE_I2C
+CircularBuffer<Transaction<I2C>, TRANSACTION_QUEUE_SIZE_I2C> I2C::_transaction_buffer;
+#endif
+
 int I2C::transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event, bool repeated)
 {
     lock();
     if (i2c_active(&_i2c)) {
+        int ret = queue_transfer(address, tx_buffer, tx_length, rx_buffer, rx_length, callback, event, repeated);
         unlock();
-        return -1; // transaction ongoing
+        return ret;
     }
+    start_transfer(address, tx_buffer, tx_length, rx_buffer, rx_length, callback, event, repeated);
+    unlock();
+    return 0;
+}
+
+void I2C::start_transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event, bool repeated)
+{
     lock_deep_sleep();
     aquire();
 
@@ -203,8 +280,37 @@ int I2C::transfer(int address, const char *tx_buffer, int tx_length, char *rx_bu
     int stop = (repeated) ? 0 : 1;
     _irq.callback(&I2C::irq_handler_asynch);
     i2c_transfer_asynch(&_i2c, (void *)tx_buffer, tx_length, (void *)rx_buffer, rx_length, address, stop, _irq.entry(), event, _usage);
-    unlock();
-    return 0;
+}
+
+int I2C::queue_transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event, bool repeated)
+{
+#if TRANSACTION_QUEUE_SIZE_I2C
+    transaction_t t;
+
+    t.tx_buffer = const_cast<char *>(tx_buffer);
+    t.tx_length = tx_length;
+    t.rx_buffer = rx_buffer;
+    t.rx_length = rx_length;
+    t.event = event;
+    t.callback = callback;
+    t.width = 8;
+    t.address = address;
+    t.repeated = repeated;
+    Transaction<I2C> transaction(this, t);
+    if (_transaction_buffer.full()) {
+        return -1; // the buffer is full
+    } else {
+        core_util_critical_section_enter();
+        _transaction_buffer.push(transaction);
+        if (!i2c_active(&_i2c)) {
+            dequeue_transaction();
+        }
+        core_util_critical_section_exit();
+        return 0;
+    }
+#else
+    return -1;
+#endif
 }
 
 void I2C::abort_transfer(void)
@@ -212,9 +318,46 @@ void I2C::abort_transfer(void)
     lock();
     i2c_abort_asynch(&_i2c);
     unlock_deep_sleep();
+#if TRANSACTION_QUEUE_SIZE_I2C
+    dequeue_transaction();
+#endif
     unlock();
 }
 
+void I2C::clear_transfer_buffer()
+{
+#if TRANSACTION_QUEUE_SIZE_I2C
+    _transaction_buffer.reset();
+#endif
+}
+
+void I2C::abort_all_transfers()
+{
+    clear_transfer_buffer();
+    abort_transfer();
+}
+
+#if TRANSACTION_QUEUE_SIZE_I2C
+
+void I2C::start_transaction(transaction_t *data)
+{
+    start_transfer(data->address, (const char *)data->tx_buffer, data->tx_length,
+                   (char *)data->rx_buffer, data->rx_length, data->callback,
+                   data->event, data->repeated);
+}
+
+void I2C::dequeue_transaction()
+{
+    Transaction<I2C> t;
+    if (_transaction_buffer.pop(t)) {
+        I2C *obj = t.get_object();
+        transaction_t *data = t.get_transaction();
+        obj->start_transaction(data);
+    }
+}
+
+#endif
+
 void I2C::irq_handler_asynch(void)
 {
     int event = i2c_irq_handler_asynch(&_i2c);
@@ -224,6 +367,11 @@ void I2C::irq_handler_asynch(void)
 
     if (event) {
         unlock_deep_sleep();
+#if TRANSACTION_QUEUE_SIZE_I2C
+        // I2C peripheral is free (event happened), dequeue transaction
+        // and re-arm the next transfer without returning to thread context
+        dequeue_transaction();
+#endif
     }
 }
 
@@ -26,16 +26,30 @@
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
 #include "platform/NonCopyable.h"
+#include "platform/Span.h"
 
 #if DEVICE_I2C_ASYNCH
 #include "platform/CThunk.h"
 #include "hal/dma_api.h"
+#include "platform/CircularBuffer.h"
 #include "platform/FunctionPointer.h"
+#include "platform/Transaction.h"
 #endif
 
 namespace mbed {
 /** \addtogroup drivers */
 
+/** Per-bus health counters, see I2C::get_stats
+ */
+struct i2c_bus_stats_t {
+    uint32_t transaction_count;      /**< Blocking transactions started */
+    uint32_t nak_count;              /**< Transactions that ended in NAK */
+    uint32_t recovery_count;         /**< Successful bus recoveries */
+    uint32_t recovery_fail_count;    /**< Recoveries that left a line held low */
+    uint32_t arbitration_lost_count; /**< Transfers lost to another master (0 if the target HAL does not track it) */
+    uint64_t stretch_time_usec;      /**< Accumulated slave clock stretching in microseconds (0 if not tracked) */
+};
+
 /** An I2C Master, used for communicating with I2C slave devices
  *
  * @note Synchronization level: Thread safe
@@ -94,6 +108,16 @@ public:
      */
     I2C(PinName sda, PinName scl);
 
+    /** Create an I2C Master interface from an explicit pinmap
+     *
+     *  Skips the pinmap table scan that the pin-based constructor performs.
+     *  The pinmap can be built at compile time with get_i2c_pinmap() on
+     *  targets that support it, see hal/static_pinmap.h.
+     *
+     *  @param pinmap Explicit pinmap for the I2C pins
+     */
+    I2C(const i2c_pinmap_t &pinmap);
+
     /** Set the frequency of the I2C interface
      *
      *  @param hz The bus frequency in hertz
@@ -117,6 +141,28 @@ public:
      */
     int read(int address, char *data, int length, bool repeated = false);
 
+    /** Read from an I2C slave into a Span
+     *
+     * Equivalent to read(int, char *, int, bool) with the pointer and length
+     * taken from the Span. With a fixed-extent Span the length is a
+     * compile-time constant, so known-size transfers carry no per-call size
+     * bookkeeping.
+     *
+     *  @param address 8-bit I2C slave address [ addr | 1 ]
+     *  @param data Span to read data in to
+     *  @param repeated Repeated start, true - don't send stop at end
+     *         default value is false.
+     *
+     *  @returns
+     *       0 on success (ack),
+     *       nonzero on failure (nack)
+     */
+    template<ptrdiff_t Ext>
+    int read(int address, Span<uint8_t, Ext> data, bool repeated = false)
+    {
+        return read(address, reinterpret_cast<char *>(data.data()), static_cast<int>(data.size()), repeated);
+    }
+
     /** Read a single byte from the I2C bus
      *
      *  @param ack indicates if the byte is to be acknowledged (1 = acknowledge)
@@ -143,6 +189,36 @@ public:
      */
     int write(int address, const char *data, int length, bool repeated = false);
 
+    /** Write to an I2C slave from a Span
+     *
+     * Equivalent to write(int, const char *, int, bool) with the pointer and
+     * length taken from the Span. With a fixed-extent Span the length is a
+     * compile-time constant, so known-size transfers carry no per-call size
+     * bookkeeping.
+     *
+     *  @param address 8-bit I2C slave address [ addr | 0 ]
+     *  @param data Span of data to send
+     *  @param repeated Repeated start, true - do not send stop at end
+     *         default value is false.
+     *
+     *  @returns
+     *       0 on success (ack),
+     *       nonzero on failure (nack)
+     */
+    template<ptrdiff_t Ext>
+    int write(int address, Span<const uint8_t, Ext> data, bool repeated = false)
+    {
+        return write(address, reinterpret_cast<const char *>(data.data()), static_cast<int>(data.size()), repeated);
+    }
+
+    /** @copydoc write(int,Span<const uint8_t,Ext>,bool)
+     */
+    template<ptrdiff_t Ext>
+    int write(int address, Span<uint8_t, Ext> data, bool repeated = false)
+    {
+        return write(address, reinterpret_cast<const char *>(data.data()), static_cast<int>(data.size()), repeated);
+    }
+
     /** Write single byte out on the I2C bus
      *
      *  @param data data to write out on bus
@@ -162,6 +238,38 @@ public:
      */
     void stop(void);
 
+    /** Recover a stuck bus
+     *
+     * A slave left mid-transfer (by a master reset, for example) can hold
+     * SDA low indefinitely, failing every subsequent transaction. This
+     * drives the clock line as GPIO for up to 9 pulses so the slave
+     * clocks out the rest of its byte and releases the data line, sends a
+     * stop condition, then re-initializes the peripheral at the
+     * configured frequency. The same pulse sequence runs at construction;
+     * call this when transactions start failing at run time to heal the
+     * bus in milliseconds instead of waiting for a watchdog reset.
+     *
+     *  @returns
+     *       0 on success,
+     *       I2C_ERROR_BUS_BUSY if SCL or SDA is still held low
+     */
+    int recover(void);
+
+    /** Read the accumulated health counters for this bus
+     *
+     * NAK and recovery counts are kept by the driver. Arbitration losses
+     * and clock-stretch time come from the target HAL (see i2c_get_stats)
+     * and read 0 on targets that do not track them.
+     *
+     *  @param stats Filled with the counters accumulated since
+     *               construction or the last clear_stats()
+     */
+    void get_stats(i2c_bus_stats_t *stats);
+
+    /** Reset the counters read by get_stats()
+     */
+    void clear_stats(void);
+
     /** Acquire exclusive access to this I2C bus
      */
     virtual void lock(void);
@@ -191,14 +299,25 @@ public:
      * @param repeated Repeated start, true - do not send stop at end
      *        default value is false.
      *
-     * @returns Zero if the transfer has started, or -1 if I2C peripheral is busy
+     * @returns Zero if the transfer has started or, when the transaction
+     *          queue is enabled (TRANSACTION_QUEUE_SIZE_I2C), has been
+     *          queued behind the on-going one; -1 if the I2C peripheral
+     *          is busy and the transfer could not be queued
      */
     int transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event = I2C_EVENT_TRANSFER_COMPLETE, bool repeated = false);
 
-    /** Abort the ongoing I2C transfer
+    /** Abort the ongoing I2C transfer, and continue with transfers in the queue, if any.
      */
     void abort_transfer();
 
+    /** Clear the queue of transfers.
+     */
+    void clear_transfer_buffer();
+
+    /** Clear the queue of transfers and abort the on-going transfer.
+     */
+    void abort_all_transfers();
+
 #if !defined(DOXYGEN_ONLY)
 protected:
     /** Lock deep sleep only if it is not yet locked */
@@ -208,10 +327,57 @@ protected:
     void unlock_deep_sleep();
 
     void irq_handler_asynch(void);
+
+    /** Start the asynchronous transfer on the hardware.
+     *
+     *  @param address   8/10 bit I2C slave address
+     *  @param tx_buffer The TX buffer with data to be transferred
+     *  @param tx_length The length of TX buffer in bytes
+     *  @param rx_buffer The RX buffer, which is used for received data
+     *  @param rx_length The length of RX buffer in bytes
+     *  @param event     The logical OR of events to modify
+     *  @param callback  The event callback function
+     *  @param repeated  Repeated start, true - do not send stop at end
+     */
+    void start_transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event, bool repeated);
+
+    /** Put a transfer on the transfer queue. The queued transfer is
+     *  re-armed directly from the completion interrupt of its
+     *  predecessor, without returning to thread context.
+     *
+     * @param address   8/10 bit I2C slave address
+     * @param tx_buffer The TX buffer with data to be transferred
+     * @param tx_length The length of TX buffer in bytes
+     * @param rx_buffer The RX buffer, which is used for received data
+     * @param rx_length The length of RX buffer in bytes
+     * @param event     The logical OR of events to modify
+     * @param callback  The event callback function
+     * @param repeated  Repeated start, true - do not send stop at end
+     * @retval 0 A transfer was added to the queue.
+     * @retval -1 Transfer can't be added because queue is full.
+     */
+    int queue_transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event, bool repeated);
+
     event_callback_t _callback;
     CThunk<I2C> _irq;
     DMAUsage _usage;
     bool _deep_sleep_locked;
+
+#if TRANSACTION_QUEUE_SIZE_I2C
+    /** Start transfer if it was pending in the queue.
+     *
+     *  @param data Transaction data.
+     */
+    void start_transaction(transaction_t *data);
+
+    /** Dequeue a transaction and start the transfer if there was one pending.
+     */
+    void dequeue_transaction();
+
+    /* Queue of pending transfers, shared by all instances on the bus */
+    static CircularBuffer<Transaction<I2C>, TRANSACTION_QUEUE_SIZE_I2C> _transaction_buffer;
+#endif
+
 #endif
 #endif
 
@@ -225,6 +391,7 @@ protected:
     static SingletonPtr<PlatformMutex> _mutex;
     PinName _sda;
     PinName _scl;
+    i2c_bus_stats_t _stats;
 
 private:
     /** Recover I2C bus, when stuck with SDA low
@@ -27,7 +27,8 @@ namespace mbed {
 InterruptIn::InterruptIn(PinName pin) : gpio(),
     gpio_irq(),
     _rise(NULL),
-    _fall(NULL)
+    _fall(NULL),
+    _capture(NULL)
 {
     // No lock needed in the constructor
     irq_init(pin);
@@ -38,7 +39,8 @@ InterruptIn::InterruptIn(PinName pin, PinMode mode) :
     gpio(),
     gpio_irq(),
     _rise(NULL),
-    _fall(NULL)
+    _fall(NULL),
+    _capture(NULL)
 {
     // No lock needed in the constructor
     irq_init(pin);
@@ -54,6 +56,7 @@ InterruptIn::~InterruptIn()
 {
     // No lock needed in the destructor
     gpio_irq_free(&gpio_irq);
+    delete _capture;
 }
 
 int InterruptIn::read()
@@ -62,6 +65,16 @@ int InterruptIn::read()
     return gpio_read(&gpio);
 }
 
+int InterruptIn::read_latched()
+{
+    int level = gpio_irq_get_latched(&gpio_irq);
+    if (level < 0) {
+        // Target does not latch demux-time state
+        level = gpio_read(&gpio);
+    }
+    return level;
+}
+
 void InterruptIn::mode(PinMode pull)
 {
     core_util_critical_section_enter();
@@ -77,7 +90,9 @@ void InterruptIn::rise(Callback<void()> func)
         gpio_irq_set(&gpio_irq, IRQ_RISE, 1);
     } else {
         _rise = NULL;
-        gpio_irq_set(&gpio_irq, IRQ_RISE, 0);
+        if (!_capture) {
+            gpio_irq_set(&gpio_irq, IRQ_RISE, 0);
+        }
     }
     core_util_critical_section_exit();
 }
@@ -90,14 +105,64 @@ void InterruptIn::fall(Callback<void()> func)
         gpio_irq_set(&gpio_irq, IRQ_FALL, 1);
     } else {
         _fall = NULL;
-        gpio_irq_set(&gpio_irq, IRQ_FALL, 0);
+        if (!_capture) {
+            gpio_irq_set(&gpio_irq, IRQ_FALL, 0);
+        }
     }
     core_util_critical_section_exit();
 }
 
+void InterruptIn::enable_capture()
+{
+    // Allocate outside the critical section; drop the spare on a lost race
+    CircularBuffer<edge_event_t, MBED_CONF_DRIVERS_INTERRUPTIN_CAPTURE_EVENTS> *buf =
+        new CircularBuffer<edge_event_t, MBED_CONF_DRIVERS_INTERRUPTIN_CAPTURE_EVENTS>();
+
+    core_util_critical_section_enter();
+    if (NULL == _capture) {
+        _capture = buf;
+        buf = NULL;
+    }
+    gpio_irq_set(&gpio_irq, IRQ_RISE, 1);
+    gpio_irq_set(&gpio_irq, IRQ_FALL, 1);
+    core_util_critical_section_exit();
+
+    delete buf;
+}
+
+void InterruptIn::disable_capture()
+{
+    core_util_critical_section_enter();
+    CircularBuffer<edge_event_t, MBED_CONF_DRIVERS_INTERRUPTIN_CAPTURE_EVENTS> *buf = _capture;
+    _capture = NULL;
+    gpio_irq_set(&gpio_irq, IRQ_RISE, _rise ? 1 : 0);
+    gpio_irq_set(&gpio_irq, IRQ_FALL, _fall ? 1 : 0);
+    core_util_critical_section_exit();
+
+    delete buf;
+}
+
+bool InterruptIn::read_capture(edge_event_t &event)
+{
+    bool read = false;
+    core_util_critical_section_enter();
+    if (_capture) {
+        read = _capture->pop(event);
+    }
+    core_util_critical_section_exit();
+    return read;
+}
+
 void InterruptIn::_irq_handler(uint32_t id, gpio_irq_event event)
 {
     InterruptIn *handler = (InterruptIn *)id;
+    if (handler->_capture) {
+        // Timestamp first, before any callback work adds latency
+        edge_event_t capture;
+        capture.timestamp = gpio_irq_get_capture_us(&handler->gpio_irq);
+        capture.edge = event;
+        handler->_capture->push(capture);
+    }
     switch (event) {
         case IRQ_RISE:
             if (handler->_rise) {
@@ -24,6 +24,7 @@
 #include "hal/gpio_api.h"
 #include "hal/gpio_irq_api.h"
 #include "platform/Callback.h"
+#include "platform/CircularBuffer.h"
 #include "platform/mbed_critical.h"
 #include "platform/mbed_toolchain.h"
 #include "platform/NonCopyable.h"
@@ -90,6 +91,22 @@ public:
      */
     int read();
 
+    /** Read the input as latched when the interrupt was demultiplexed
+     *
+     *  On targets whose GPIO interrupt demux latches all pin states at
+     *  the start of each dispatch pass, callbacks on the same interrupt
+     *  vector all see the same snapshot through this call, no matter
+     *  how late in the pass they run - a live read() cannot guarantee
+     *  that for multi-pin state such as quadrature inputs. Falls back
+     *  to read() on targets without a latching demux. Meant to be
+     *  called from a rise/fall callback.
+     *
+     *  @returns
+     *    The latched state of the input pin,
+     *    0 for logical 0, 1 for logical 1
+     */
+    int read_latched();
+
     /** An operator shorthand for read()
      */
     operator int();
@@ -162,6 +179,41 @@ public:
      */
     void disable_irq();
 
+    /** Timestamped edge event, delivered by the capture mode */
+    struct edge_event_t {
+        uint32_t timestamp;     /**< Edge time in microseconds */
+        gpio_irq_event edge;    /**< IRQ_RISE or IRQ_FALL */
+    };
+
+    /** Enable timestamped edge capture
+     *
+     *  Both edges are captured with a timestamp taken at the start of the
+     *  interrupt handler into a ring of
+     *  drivers.interruptin-capture-events entries the application drains
+     *  with read_capture(); when the ring is full the oldest event is
+     *  overwritten. On targets whose gpio_irq_get_capture_us() is backed
+     *  by a timer capture channel the timestamp is latched by hardware at
+     *  the edge itself, removing interrupt latency jitter; elsewhere it is
+     *  a microsecond ticker read from the handler prologue.
+     *
+     *  Attached rise/fall callbacks keep working alongside the capture.
+     */
+    void enable_capture();
+
+    /** Disable timestamped edge capture and discard buffered events.
+     *
+     *  Edge interrupts remain enabled only for edges with an attached
+     *  callback.
+     */
+    void disable_capture();
+
+    /** Read the oldest captured edge event
+     *
+     *  @param event Filled with the timestamp and edge type
+     *  @return true if an event was read, false if the buffer was empty
+     */
+    bool read_capture(edge_event_t &event);
+
     static void _irq_handler(uint32_t id, gpio_irq_event event);
 #if !defined(DOXYGEN_ONLY)
 protected:
@@ -170,6 +222,7 @@ protected:
 
     Callback<void()> _rise;
     Callback<void()> _fall;
+    CircularBuffer<edge_event_t, MBED_CONF_DRIVERS_INTERRUPTIN_CAPTURE_EVENTS> *_capture;
 
     void irq_init(PinName pin);
 #endif
@@ -25,10 +25,12 @@
 
 #include "drivers/InterruptManager.h"
 #include "platform/mbed_critical.h"
+#if MBED_CONF_DRIVERS_INTERRUPT_MANAGER_STATS
+#include "hal/ticker_api.h"
+#include "hal/us_ticker_api.h"
+#endif
 #include <string.h>
 
-#define CHAIN_INITIAL_SIZE    4
-
 namespace mbed {
 
 typedef void (*pvoidf)(void);
@@ -60,7 +62,7 @@ InterruptManager *InterruptManager::get()
 InterruptManager::InterruptManager()
 {
     // No mutex needed in constructor
-    memset(_chains, 0, NVIC_NUM_VECTORS * sizeof(CallChain *));
+    memset(_chains, 0, NVIC_NUM_VECTORS * sizeof(irq_chain_t *));
 }
 
 void InterruptManager::destroy()
@@ -89,8 +91,12 @@ bool InterruptManager::must_replace_vector(IRQn_Type irq)
     int ret = false;
     int irq_pos = get_irq_index(irq);
     if (NULL == _chains[irq_pos]) {
-        _chains[irq_pos] = new CallChain(CHAIN_INITIAL_SIZE);
-        _chains[irq_pos]->add((pvoidf)NVIC_GetVector(irq));
+        irq_chain_t *chain = new irq_chain_t;
+        // The original vector stays first in the dispatch order
+        chain->slots[0] = Callback<void()>((pvoidf)NVIC_GetVector(irq));
+        chain->order[0] = 0;
+        chain->count = 1;
+        _chains[irq_pos] = chain;
         ret = true;
     }
     unlock();
@@ -98,12 +104,39 @@ bool InterruptManager::must_replace_vector(IRQn_Type irq)
 }
 
 pFunctionPointer_t InterruptManager::add_common(void (*function)(void), IRQn_Type irq, bool front)
+{
+    return add_callback_common(Callback<void()>(function), irq, front);
+}
+
+pFunctionPointer_t InterruptManager::add_callback_common(Callback<void()> func, IRQn_Type irq, bool front)
 {
     lock();
     int irq_pos = get_irq_index(irq);
     bool change = must_replace_vector(irq);
 
-    pFunctionPointer_t pf = front ? _chains[irq_pos]->add_front(function) : _chains[irq_pos]->add(function);
+    irq_chain_t *chain = _chains[irq_pos];
+    pFunctionPointer_t pf = NULL;
+    if (chain->count < MBED_CONF_DRIVERS_INTERRUPT_MANAGER_CHAIN_SIZE) {
+        // Find a free slot - handlers never move between slots, so the
+        // returned handle stays valid until it is removed
+        int slot = 0;
+        while (chain->slots[slot]) {
+            slot++;
+        }
+        chain->slots[slot] = func;
+
+        core_util_critical_section_enter();
+        if (front) {
+            memmove(&chain->order[1], &chain->order[0], chain->count);
+            chain->order[0] = slot;
+        } else {
+            chain->order[chain->count] = slot;
+        }
+        chain->count++;
+        core_util_critical_section_exit();
+
+        pf = &chain->slots[slot];
+    }
     if (change) {
         NVIC_SetVector(irq, (uint32_t)&InterruptManager::static_irq_helper);
     }
@@ -117,9 +150,19 @@ bool InterruptManager::remove_handler(pFunctionPointer_t handler, IRQn_Type irq)
     bool ret = false;
 
     lock();
-    if (_chains[irq_pos] != NULL) {
-        if (_chains[irq_pos]->remove(handler)) {
-            ret = true;
+    irq_chain_t *chain = _chains[irq_pos];
+    if (chain != NULL) {
+        for (int i = 0; i < chain->count; i++) {
+            int slot = chain->order[i];
+            if (&chain->slots[slot] == handler) {
+                core_util_critical_section_enter();
+                memmove(&chain->order[i], &chain->order[i + 1], chain->count - i - 1);
+                chain->count--;
+                core_util_critical_section_exit();
+                chain->slots[slot] = Callback<void()>();
+                ret = true;
+                break;
+            }
         }
     }
     unlock();
@@ -129,7 +172,40 @@ bool InterruptManager::remove_handler(pFunctionPointer_t handler, IRQn_Type irq)
 
 void InterruptManager::irq_helper()
 {
-    _chains[__get_IPSR()]->call();
+    irq_chain_t *chain = _chains[__get_IPSR()];
+#if MBED_CONF_DRIVERS_INTERRUPT_MANAGER_STATS
+    chain->invocations++;
+    const uint32_t start = ticker_read(get_us_ticker_data());
+#endif
+    for (int i = 0; i < chain->count; i++) {
+        chain->slots[chain->order[i]]();
+    }
+#if MBED_CONF_DRIVERS_INTERRUPT_MANAGER_STATS
+    const uint32_t duration = ticker_read(get_us_ticker_data()) - start;
+    if (duration > chain->max_duration_us) {
+        chain->max_duration_us = duration;
+    }
+#endif
+}
+
+uint32_t InterruptManager::irq_count(IRQn_Type irq)
+{
+#if MBED_CONF_DRIVERS_INTERRUPT_MANAGER_STATS
+    irq_chain_t *chain = _chains[get_irq_index(irq)];
+    return chain ? chain->invocations : 0;
+#else
+    return 0;
+#endif
+}
+
+uint32_t InterruptManager::irq_max_duration_us(IRQn_Type irq)
+{
+#if MBED_CONF_DRIVERS_INTERRUPT_MANAGER_STATS
+    irq_chain_t *chain = _chains[get_irq_index(irq)];
+    return chain ? chain->max_duration_us : 0;
+#else
+    return 0;
+#endif
 }
 
 int InterruptManager::get_irq_index(IRQn_Type irq)
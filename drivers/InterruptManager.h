@@ -19,10 +19,15 @@
 
 #include "cmsis.h"
 #include "platform/CallChain.h"
+#include "platform/Callback.h"
 #include "platform/PlatformMutex.h"
 #include "platform/NonCopyable.h"
 #include <string.h>
 
+#ifndef MBED_CONF_DRIVERS_INTERRUPT_MANAGER_CHAIN_SIZE
+#define MBED_CONF_DRIVERS_INTERRUPT_MANAGER_CHAIN_SIZE 8
+#endif
+
 namespace mbed {
 /** \addtogroup drivers */
 
@@ -167,6 +172,27 @@ public:
                           "public API of mbed-os and is being removed in the future.")
     bool remove_handler(pFunctionPointer_t handler, IRQn_Type irq);
 
+    /** Number of times the chained handlers for an interrupt have run
+     *
+     *  Only counted for interrupts with at least one chained handler, and
+     *  only when drivers.interrupt-manager-stats is enabled; 0 otherwise.
+     *
+     *  @param irq interrupt number
+     *  @return total invocation count for the interrupt
+     */
+    uint32_t irq_count(IRQn_Type irq);
+
+    /** Longest single run of the chained handlers for an interrupt
+     *
+     *  Measured over the whole chain, from entering the dispatch helper to
+     *  the last handler returning. Only tracked when
+     *  drivers.interrupt-manager-stats is enabled; 0 otherwise.
+     *
+     *  @param irq interrupt number
+     *  @return maximum chain duration in microseconds
+     */
+    uint32_t irq_max_duration_us(IRQn_Type irq);
+
 #if !defined(DOXYGEN_ONLY)
 private:
     InterruptManager();
@@ -175,29 +201,41 @@ private:
     void lock();
     void unlock();
 
+    /* Flat per-IRQ handler storage: handlers live inline in a fixed slot
+     * array (no heap nodes, no virtual calls) and order[] holds the slot
+     * indices in dispatch order, so removing a handler never moves another
+     * handler's slot and outstanding handles stay valid.
+     */
+    struct irq_chain_t {
+        Callback<void()> slots[MBED_CONF_DRIVERS_INTERRUPT_MANAGER_CHAIN_SIZE];
+        uint8_t order[MBED_CONF_DRIVERS_INTERRUPT_MANAGER_CHAIN_SIZE];
+        uint8_t count;
+#if MBED_CONF_DRIVERS_INTERRUPT_MANAGER_STATS
+        uint32_t invocations;
+        uint32_t max_duration_us;
+#endif
+        irq_chain_t() : count(0)
+#if MBED_CONF_DRIVERS_INTERRUPT_MANAGER_STATS
+            , invocations(0), max_duration_us(0)
+#endif
+        {
+        }
+    };
+
     template<typename T>
     pFunctionPointer_t add_common(T *tptr, void (T::*mptr)(void), IRQn_Type irq, bool front = false)
     {
-        _mutex.lock();
-        int irq_pos = get_irq_index(irq);
-        bool change = must_replace_vector(irq);
-
-        pFunctionPointer_t pf = front ? _chains[irq_pos]->add_front(tptr, mptr) : _chains[irq_pos]->add(tptr, mptr);
-        if (change) {
-            NVIC_SetVector(irq, (uint32_t)&InterruptManager::static_irq_helper);
-        }
-        _mutex.unlock();
-        return pf;
+        return add_callback_common(callback(tptr, mptr), irq, front);
     }
 
     pFunctionPointer_t add_common(void (*function)(void), IRQn_Type irq, bool front = false);
+    pFunctionPointer_t add_callback_common(Callback<void()> func, IRQn_Type irq, bool front);
     bool must_replace_vector(IRQn_Type irq);
     int get_irq_index(IRQn_Type irq);
     void irq_helper();
-    void add_helper(void (*function)(void), IRQn_Type irq, bool front = false);
     static void static_irq_helper();
 
-    CallChain *_chains[NVIC_NUM_VECTORS];
+    irq_chain_t *_chains[NVIC_NUM_VECTORS];
     static InterruptManager *_instance;
     PlatformMutex _mutex;
 #endif
@@ -23,6 +23,12 @@
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
 
+/* Minimum buffer size for which the DMA-fed hardware path is used, when
+ * available. Below this the DMA setup cost outweighs the per-byte saving. */
+#ifndef MBED_CONF_DRIVERS_CRC_DMA_THRESHOLD
+#define MBED_CONF_DRIVERS_CRC_DMA_THRESHOLD 256
+#endif
+
 /* This is invalid warning from the compiler for below section of code
 if ((width < 8) && (NULL == _crc_table)) {
     p_crc = (uint32_t)(p_crc << (8 - width));
@@ -200,7 +206,16 @@ public:
         switch (_mode) {
 #if DEVICE_CRC
             case HARDWARE:
-                hal_crc_compute_partial((uint8_t *)buffer, size);
+#if DEVICE_CRC_DMA
+                /* Let DMA feed the peripheral for large buffers so the CPU
+                 * is free during e.g. firmware-image checksumming */
+                if (size >= MBED_CONF_DRIVERS_CRC_DMA_THRESHOLD) {
+                    hal_crc_compute_partial_dma((uint8_t *)buffer, size);
+                } else
+#endif
+                {
+                    hal_crc_compute_partial((uint8_t *)buffer, size);
+                }
                 *crc = 0;
                 break;
 #endif
@@ -466,6 +481,38 @@ private:
         uint32_t p_crc = *crc;
         uint8_t data_byte = 0;
 
+#if MBED_CONF_DRIVERS_CRC_TABLE_SIZE == MBED_OPTIMIZED_CRC_TABLE_SIZE
+        /* Nibble-indexed tables: two 16-entry lookups per byte. CRCs of
+         * width < 8 are held left-aligned in 8 bits, as in the full tables. */
+        if (POLY_32BIT_REV_ANSI == polynomial) {
+            uint32_t *crc_table = (uint32_t *)_crc_table;
+            for (crc_data_size_t i = 0; i < size; i++) {
+                p_crc = (p_crc >> 4) ^ crc_table[(p_crc ^ (data[i] >> 0)) & 0xf];
+                p_crc = (p_crc >> 4) ^ crc_table[(p_crc ^ (data[i] >> 4)) & 0xf];
+            }
+        } else if (width <= 8) {
+            uint8_t *crc_table = (uint8_t *)_crc_table;
+            for (crc_data_size_t byte = 0; byte < size; byte++) {
+                data_byte = reflect_bytes(data[byte]);
+                p_crc = (uint8_t)(crc_table[((p_crc >> 4) ^ (data_byte >> 4)) & 0xf] ^ (p_crc << 4));
+                p_crc = (uint8_t)(crc_table[((p_crc >> 4) ^ data_byte) & 0xf] ^ (p_crc << 4));
+            }
+        } else if (width <= 16) {
+            uint16_t *crc_table = (uint16_t *)_crc_table;
+            for (crc_data_size_t byte = 0; byte < size; byte++) {
+                data_byte = reflect_bytes(data[byte]);
+                p_crc = (uint16_t)(crc_table[((p_crc >> 12) ^ (data_byte >> 4)) & 0xf] ^ (p_crc << 4));
+                p_crc = (uint16_t)(crc_table[((p_crc >> 12) ^ data_byte) & 0xf] ^ (p_crc << 4));
+            }
+        } else {
+            uint32_t *crc_table = (uint32_t *)_crc_table;
+            for (crc_data_size_t byte = 0; byte < size; byte++) {
+                data_byte = reflect_bytes(data[byte]);
+                p_crc = crc_table[((p_crc >> 28) ^ (data_byte >> 4)) & 0xf] ^ (p_crc << 4);
+                p_crc = crc_table[((p_crc >> 28) ^ data_byte) & 0xf] ^ (p_crc << 4);
+            }
+        }
+#else
         if (width <= 8) {
             uint8_t *crc_table = (uint8_t *)_crc_table;
             for (crc_data_size_t byte = 0; byte < size; byte++) {
@@ -492,6 +539,7 @@ private:
                 }
             }
         }
+#endif // MBED_CONF_DRIVERS_CRC_TABLE_SIZE
         *crc = p_crc & get_crc_mask();
         return 0;
     }
@@ -524,6 +572,26 @@ private:
 #endif
 
         switch (polynomial) {
+#if MBED_CONF_DRIVERS_CRC_TABLE_SIZE == MBED_OPTIMIZED_CRC_TABLE_SIZE
+            case POLY_32BIT_ANSI:
+                _crc_table = (uint32_t *)Table_CRC_Nibble_32bit_ANSI;
+                break;
+            case POLY_32BIT_REV_ANSI:
+                _crc_table = (uint32_t *)Table_CRC_32bit_Rev_ANSI;
+                break;
+            case POLY_8BIT_CCITT:
+                _crc_table = (uint32_t *)Table_CRC_Nibble_8bit_CCITT;
+                break;
+            case POLY_7BIT_SD:
+                _crc_table = (uint32_t *)Table_CRC_Nibble_7Bit_SD;
+                break;
+            case POLY_16BIT_CCITT:
+                _crc_table = (uint32_t *)Table_CRC_Nibble_16bit_CCITT;
+                break;
+            case POLY_16BIT_IBM:
+                _crc_table = (uint32_t *)Table_CRC_Nibble_16bit_IBM;
+                break;
+#else
             case POLY_32BIT_ANSI:
                 _crc_table = (uint32_t *)Table_CRC_32bit_ANSI;
                 break;
@@ -542,6 +610,7 @@ private:
             case POLY_16BIT_IBM:
                 _crc_table = (uint32_t *)Table_CRC_16bit_IBM;
                 break;
+#endif
             default:
                 _crc_table = NULL;
                 break;
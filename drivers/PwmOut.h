@@ -21,6 +21,8 @@
 
 #if DEVICE_PWMOUT || defined(DOXYGEN_ONLY)
 #include "hal/pwmout_api.h"
+#include "drivers/Ticker.h"
+#include "platform/Callback.h"
 #include "platform/mbed_critical.h"
 #include "platform/mbed_power_mgmt.h"
 
@@ -58,7 +60,9 @@ public:
      *
      *  @param pin PwmOut pin to connect to
      */
-    PwmOut(PinName pin) : _deep_sleep_locked(false)
+    PwmOut(PinName pin) : _deep_sleep_locked(false),
+        _table(NULL), _length(0), _index(0), _loop(false),
+        _hw_stream(false), _ticker(NULL)
     {
         core_util_critical_section_enter();
         pwmout_init(&_pwm, pin);
@@ -67,6 +71,8 @@ public:
 
     ~PwmOut()
     {
+        stop_waveform();
+        delete _ticker;
         core_util_critical_section_enter();
         unlock_deep_sleep();
         core_util_critical_section_exit();
@@ -198,6 +204,80 @@ public:
         return read();
     }
 
+    /** Stream a table of duty cycles through the output
+     *
+     *  The output steps to the next table entry every element_us
+     *  microseconds. On targets whose PWM peripheral can sequence
+     *  autonomously (timer DMA-burst, PWM sequencer) the table plays with
+     *  no CPU involvement; elsewhere it is stepped from the microsecond
+     *  ticker's interrupt. Either way the periodic software-timer callback
+     *  updating duty by hand - and its wakeups - disappear from the
+     *  application.
+     *
+     *  The table is not copied and must stay valid until the waveform
+     *  completes or stop_waveform() is called.
+     *
+     *  @param table      Table of duty cycles (0.0 to 1.0)
+     *  @param length     Number of entries in the table
+     *  @param element_us Microseconds each entry holds the output
+     *  @param loop       true to restart from the first entry after the
+     *                    last, false to play the table once
+     *  @param complete   Called when a non-looping waveform finishes
+     *                    (interrupt context; default none)
+     *  @return true if the waveform was started
+     */
+    bool write_waveform(const float *table, uint32_t length, uint32_t element_us, bool loop, Callback<void()> complete = Callback<void()>())
+    {
+        if ((table == NULL) || (length == 0) || (element_us == 0)) {
+            return false;
+        }
+        stop_waveform();
+
+        core_util_critical_section_enter();
+        lock_deep_sleep();
+        _table = table;
+        _length = length;
+        _index = 0;
+        _loop = loop;
+        _complete = complete;
+        _hw_stream = (pwmout_sequence_start(&_pwm, table, length, element_us,
+                                            loop ? 1 : 0, &PwmOut::_sequence_irq,
+                                            (uint32_t)this) == 0);
+        core_util_critical_section_exit();
+
+        if (!_hw_stream) {
+            // Software fallback - step the table from the ticker's
+            // interrupt, trading the hardware path's zero CPU for
+            // portability
+            if (_ticker == NULL) {
+                _ticker = new Ticker;
+            }
+            write(table[0]);
+            _index = 1;
+            _ticker->attach_us(callback(this, &PwmOut::_stream_step), element_us);
+        }
+        return true;
+    }
+
+    /** Stop a running waveform, leaving the last written duty active
+     *
+     *  The completion callback is not called.
+     */
+    void stop_waveform()
+    {
+        core_util_critical_section_enter();
+        if (_hw_stream) {
+            pwmout_sequence_stop(&_pwm);
+            _hw_stream = false;
+        }
+        if (_ticker != NULL) {
+            _ticker->detach();
+        }
+        _table = NULL;
+        _complete = NULL;
+        core_util_critical_section_exit();
+    }
+
 #if !(DOXYGEN_ONLY)
 protected:
     /** Lock deep sleep only if it is not yet locked */
@@ -218,8 +298,46 @@ protected:
         }
     }
 
+    /** Advance the software-stepped waveform by one element */
+    void _stream_step()
+    {
+        if (_index >= _length) {
+            if (_loop) {
+                _index = 0;
+            } else {
+                _ticker->detach();
+                _table = NULL;
+                if (_complete) {
+                    _complete.call();
+                }
+                return;
+            }
+        }
+        pwmout_write(&_pwm, _table[_index]);
+        _index++;
+    }
+
+    /** Completion handler for hardware-sequenced waveforms */
+    static void _sequence_irq(uint32_t id)
+    {
+        PwmOut *self = (PwmOut *)id;
+        self->_hw_stream = false;
+        self->_table = NULL;
+        if (self->_complete) {
+            self->_complete.call();
+        }
+    }
+
     pwmout_t _pwm;
     bool _deep_sleep_locked;
+
+    const float *_table;
+    uint32_t _length;
+    uint32_t _index;
+    bool _loop;
+    bool _hw_stream;
+    Callback<void()> _complete;
+    Ticker *_ticker;
 #endif
 };
 
@@ -44,6 +44,10 @@ QSPI::QSPI(PinName io0, PinName io1, PinName io2, PinName io3, PinName sclk, Pin
     _mode = mode;
     _hz = ONE_MHZ;
     _initialized = false;
+#if DEVICE_QSPI_MMAP
+    _mmap_base = NULL;
+    _mmap_size = 0;
+#endif
 
     //Go ahead init the device here with the default config
     bool success = _initialize();
@@ -96,6 +100,13 @@ qspi_status_t QSPI::read(int address, char *rx_buffer, size_t *rx_length)
 {
     qspi_status_t ret_status = QSPI_STATUS_ERROR;
 
+#if DEVICE_QSPI_MMAP
+    if (_mmap_base != NULL) {
+        // no command transactions while the memory-mapped window is active
+        return ret_status;
+    }
+#endif
+
     if (_initialized) {
         if ((rx_length != NULL) && (rx_buffer != NULL)) {
             if (*rx_length != 0) {
@@ -120,6 +131,13 @@ qspi_status_t QSPI::write(int address, const char *tx_buffer, size_t *tx_length)
 {
     qspi_status_t ret_status = QSPI_STATUS_ERROR;
 
+#if DEVICE_QSPI_MMAP
+    if (_mmap_base != NULL) {
+        // no command transactions while the memory-mapped window is active
+        return ret_status;
+    }
+#endif
+
     if (_initialized) {
         if ((tx_length != NULL) && (tx_buffer != NULL)) {
             if (*tx_length != 0) {
@@ -144,6 +162,13 @@ qspi_status_t QSPI::read(int instruction, int alt, int address, char *rx_buffer,
 {
     qspi_status_t ret_status = QSPI_STATUS_ERROR;
 
+#if DEVICE_QSPI_MMAP
+    if (_mmap_base != NULL) {
+        // no command transactions while the memory-mapped window is active
+        return ret_status;
+    }
+#endif
+
     if (_initialized) {
         if ((rx_length != NULL) && (rx_buffer != NULL)) {
             if (*rx_length != 0) {
@@ -168,6 +193,13 @@ qspi_status_t QSPI::write(int instruction, int alt, int address, const char *tx_
 {
     qspi_status_t ret_status = QSPI_STATUS_ERROR;
 
+#if DEVICE_QSPI_MMAP
+    if (_mmap_base != NULL) {
+        // no command transactions while the memory-mapped window is active
+        return ret_status;
+    }
+#endif
+
     if (_initialized) {
         if ((tx_length != NULL) && (tx_buffer != NULL)) {
             if (*tx_length != 0) {
@@ -192,6 +224,13 @@ qspi_status_t QSPI::command_transfer(int instruction, int address, const char *t
 {
     qspi_status_t ret_status = QSPI_STATUS_ERROR;
 
+#if DEVICE_QSPI_MMAP
+    if (_mmap_base != NULL) {
+        // no command transactions while the memory-mapped window is active
+        return ret_status;
+    }
+#endif
+
     if (_initialized) {
         lock();
         if (true == _acquire()) {
@@ -206,6 +245,49 @@ qspi_status_t QSPI::command_transfer(int instruction, int address, const char *t
     return ret_status;
 }
 
+#if DEVICE_QSPI_MMAP
+const uint8_t *QSPI::map(uint32_t address, size_t size)
+{
+    const uint8_t *mapped = NULL;
+
+    if (_initialized) {
+        lock();
+        if (_mmap_base == NULL) {
+            if (true == _acquire()) {
+                _build_qspi_command(-1, 0, -1);
+                const void *base = NULL;
+                size_t window = 0;
+                if (QSPI_STATUS_OK == qspi_mmap_enable(&_qspi, &_qspi_command, &base, &window)) {
+                    _mmap_base = static_cast<const uint8_t *>(base);
+                    _mmap_size = window;
+                }
+            }
+        }
+        if ((_mmap_base != NULL) && (address + size <= _mmap_size) && (address + size >= address)) {
+            mapped = _mmap_base + address;
+        }
+        unlock();
+    }
+
+    return mapped;
+}
+
+qspi_status_t QSPI::unmap()
+{
+    qspi_status_t ret_status = QSPI_STATUS_OK;
+
+    lock();
+    if (_mmap_base != NULL) {
+        ret_status = qspi_mmap_disable(&_qspi);
+        _mmap_base = NULL;
+        _mmap_size = 0;
+    }
+    unlock();
+
+    return ret_status;
+}
+#endif // DEVICE_QSPI_MMAP
+
 void QSPI::lock()
 {
     _mutex->lock();
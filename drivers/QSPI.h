@@ -183,6 +183,33 @@ public:
      */
     qspi_status_t command_transfer(int instruction, int address, const char *tx_buffer, size_t tx_length, const char *rx_buffer, size_t rx_length);
 
+#if DEVICE_QSPI_MMAP || defined(DOXYGEN_ONLY)
+    /** Map a flash region into the address space for direct reads
+     *
+     *  Places the controller in memory-mapped mode, using the preset read
+     *  instruction/format, and returns a pointer through which the region
+     *  can be read at full AHB speed with no per-chunk command setup.
+     *  The mapping stays active until unmap() is called; while mapped,
+     *  read/write/command_transfer on this object return QSPI_STATUS_ERROR.
+     *
+     *  Only available on targets with DEVICE_QSPI_MMAP support.
+     *
+     *  @param address Flash offset of the region to access
+     *  @param size    Length of the region in bytes
+     *  @return Pointer to the region, or NULL if the mapping failed or the
+     *          region does not fit in the hardware window
+     */
+    const uint8_t *map(uint32_t address, size_t size);
+
+    /** Tear down the memory-mapped window, re-enabling command transactions
+     *
+     *  Pointers obtained from map() become invalid.
+     *
+     *  @returns QSPI_STATUS_SUCCESS if the mapping was torn down
+     */
+    qspi_status_t unmap();
+#endif
+
 #if !defined(DOXYGEN_ONLY)
 protected:
     /** Acquire exclusive access to this SPI bus
@@ -210,6 +237,10 @@ protected:
     int _mode; //SPI mode
     bool _initialized;
     PinName _qspi_io0, _qspi_io1, _qspi_io2, _qspi_io3, _qspi_clk, _qspi_cs; //IO lines, clock and chip select
+#if DEVICE_QSPI_MMAP
+    const uint8_t *_mmap_base; //Start of the active memory-mapped window, NULL when not mapped
+    size_t _mmap_size; //Length of the active memory-mapped window
+#endif
 
 private:
     /* Private acquire function without locking/unlocking
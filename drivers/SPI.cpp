@@ -35,16 +35,38 @@ SPI::SPI(PinName mosi, PinName miso, PinName sclk, PinName ssel) :
     _irq(this),
     _usage(DMA_USAGE_NEVER),
     _deep_sleep_locked(false),
+    _ring_active(false),
+    _ring_stop(false),
 #endif
     _bits(8),
     _mode(0),
     _hz(1000000),
-    _write_fill(SPI_FILL_CHAR)
+    _write_fill(SPI_FILL_CHAR),
+    _dedicated(false)
 {
     // No lock needed in the constructor
     spi_init(&_spi, mosi, miso, sclk, ssel);
 }
 
+SPI::SPI(const spi_pinmap_t &pinmap) :
+    _spi(),
+#if DEVICE_SPI_ASYNCH
+    _irq(this),
+    _usage(DMA_USAGE_NEVER),
+    _deep_sleep_locked(false),
+    _ring_active(false),
+    _ring_stop(false),
+#endif
+    _bits(8),
+    _mode(0),
+    _hz(1000000),
+    _write_fill(SPI_FILL_CHAR),
+    _dedicated(false)
+{
+    // No lock needed in the constructor
+    spi_init_direct(&_spi, &pinmap);
+}
+
 SPI::~SPI()
 {
     if (_owner == this) {
@@ -62,6 +84,7 @@ void SPI::format(int bits, int mode)
     // updated which is done by acquire.
     if (_owner == this) {
         spi_format(&_spi, _bits, _mode, 0);
+        _bus_fingerprint = _config_fingerprint();
     } else {
         _acquire();
     }
@@ -77,6 +100,7 @@ void SPI::frequency(int hz)
     // updated which is done by acquire.
     if (_owner == this) {
         spi_frequency(&_spi, _hz);
+        _bus_fingerprint = _config_fingerprint();
     } else {
         _acquire();
     }
@@ -84,17 +108,23 @@ void SPI::frequency(int hz)
 }
 
 SPI *SPI::_owner = NULL;
+uint64_t SPI::_bus_fingerprint = 0;
 SingletonPtr<PlatformMutex> SPI::_mutex;
 
+// Disjoint bit fields, so distinct configurations never collide
+uint64_t SPI::_config_fingerprint() const
+{
+    return (uint64_t)(uint32_t)_hz |
+           ((uint64_t)(uint8_t)_bits << 32) |
+           ((uint64_t)(uint8_t)_mode << 40) |
+           ((uint64_t)1 << 48); // marker so a valid config is never 0
+}
+
 // ignore the fact there are multiple physical spis, and always update if it wasn't us last
 void SPI::aquire()
 {
     lock();
-    if (_owner != this) {
-        spi_format(&_spi, _bits, _mode, 0);
-        spi_frequency(&_spi, _hz);
-        _owner = this;
-    }
+    _acquire();
     unlock();
 }
 
@@ -102,14 +132,31 @@ void SPI::aquire()
 void SPI::_acquire()
 {
     if (_owner != this) {
-        spi_format(&_spi, _bits, _mode, 0);
-        spi_frequency(&_spi, _hz);
+        // Skip the register rewrite if the previous owner left the bus in
+        // exactly the configuration we want
+        uint64_t fingerprint = _config_fingerprint();
+        if (fingerprint != _bus_fingerprint) {
+            spi_format(&_spi, _bits, _mode, 0);
+            spi_frequency(&_spi, _hz);
+            _bus_fingerprint = fingerprint;
+        }
         _owner = this;
     }
 }
 
+void SPI::set_dedicated()
+{
+    lock();
+    _acquire();
+    _dedicated = true;
+    unlock();
+}
+
 int SPI::write(int value)
 {
+    if (_dedicated) {
+        return spi_master_write(&_spi, value);
+    }
     lock();
     _acquire();
     int ret = spi_master_write(&_spi, value);
@@ -119,6 +166,9 @@ int SPI::write(int value)
 
 int SPI::write(const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length)
 {
+    if (_dedicated) {
+        return spi_master_block_write(&_spi, tx_buffer, tx_length, rx_buffer, rx_length, _write_fill);
+    }
     lock();
     _acquire();
     int ret = spi_master_block_write(&_spi, tx_buffer, tx_length, rx_buffer, rx_length, _write_fill);
@@ -154,8 +204,42 @@ int SPI::transfer(const void *tx_buffer, int tx_length, void *rx_buffer, int rx_
     return 0;
 }
 
+int SPI::transfer_ring(const void *const *tx_buffers, void *const *rx_buffers, int buffer_count, int buffer_length, unsigned char bit_width, const event_callback_t &callback, int event)
+{
+    if (buffer_count < 1 || buffer_length < 1 || (!tx_buffers && !rx_buffers)) {
+        return -1;
+    }
+    core_util_critical_section_enter();
+    if (spi_active(&_spi) || _ring_active) {
+        core_util_critical_section_exit();
+        return -1;
+    }
+    _ring_tx = tx_buffers;
+    _ring_rx = rx_buffers;
+    _ring_count = buffer_count;
+    _ring_length = buffer_length;
+    _ring_index = 0;
+    _ring_event = event;
+    _ring_width = bit_width;
+    _ring_stop = false;
+    _ring_active = true;
+    start_transfer(tx_buffers ? tx_buffers[0] : NULL, tx_buffers ? buffer_length : 0,
+                   rx_buffers ? rx_buffers[0] : NULL, rx_buffers ? buffer_length : 0,
+                   bit_width, callback, event);
+    core_util_critical_section_exit();
+    return 0;
+}
+
+void SPI::stop_transfer_ring()
+{
+    core_util_critical_section_enter();
+    _ring_stop = true;
+    core_util_critical_section_exit();
+}
+
 void SPI::abort_transfer()
 {
+    _ring_active = false;
     spi_abort_asynch(&_spi);
     unlock_deep_sleep();
 #if TRANSACTION_QUEUE_SIZE_SPI
@@ -262,6 +346,24 @@ void SPI::dequeue_transaction()
 void SPI::irq_handler_asynch(void)
 {
     int event = spi_irq_handler_asynch(&_spi);
+    if (_ring_active && (event & SPI_EVENT_ALL)) {
+        if (!_ring_stop && !(event & SPI_EVENT_ERROR)) {
+            // Re-arm the next ring buffer before dispatching the
+            // callback, so the bus restarts immediately and the
+            // callback overlaps the transfer it just armed
+            _ring_index = (_ring_index + 1 == _ring_count) ? 0 : _ring_index + 1;
+            spi_master_transfer(&_spi,
+                                _ring_tx ? _ring_tx[_ring_index] : NULL, _ring_tx ? _ring_length : 0,
+                                _ring_rx ? _ring_rx[_ring_index] : NULL, _ring_rx ? _ring_length : 0,
+                                _ring_width, _irq.entry(), _ring_event, _usage);
+            if (_callback) {
+                _callback.call(event & SPI_EVENT_ALL);
+            }
+            return;
+        }
+        // Stop requested or transfer error - wind the ring down
+        _ring_active = false;
+    }
     if (_callback && (event & SPI_EVENT_ALL)) {
         unlock_deep_sleep();
         _callback.call(event & SPI_EVENT_ALL);
@@ -25,6 +25,7 @@
 #include "hal/spi_api.h"
 #include "platform/SingletonPtr.h"
 #include "platform/NonCopyable.h"
+#include "platform/Span.h"
 
 #if DEVICE_SPI_ASYNCH
 #include "platform/CThunk.h"
@@ -93,6 +94,16 @@ public:
      *  @param ssel SPI Chip Select pin.
      */
     SPI(PinName mosi, PinName miso, PinName sclk, PinName ssel = NC);
+
+    /** Create a SPI master from an explicit pinmap.
+     *
+     *  Skips the pinmap table scan that the pin-based constructor performs.
+     *  The pinmap can be built at compile time with get_spi_pinmap() on
+     *  targets that support it, see hal/static_pinmap.h.
+     *
+     *  @param pinmap Explicit pinmap for the SPI pins.
+     */
+    SPI(const spi_pinmap_t &pinmap);
     virtual ~SPI();
 
     /** Configure the data transmission format.
@@ -141,6 +152,35 @@ public:
      */
     virtual int write(const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length);
 
+    /** Write to the SPI Slave and obtain the response, using Spans.
+     *
+     *  Equivalent to write(const char *, int, char *, int) with the pointers
+     *  and lengths taken from the Spans. With fixed-extent Spans both
+     *  lengths are compile-time constants, so known-size transfers carry no
+     *  per-call size bookkeeping.
+     *
+     *  @param tx_buffer Span of data to write to the device, may be empty.
+     *  @param rx_buffer Span for data read from the device, may be empty.
+     *  @return
+     *      The number of bytes written and read from the device. This is
+     *      maximum of the two Span sizes.
+     */
+    template<ptrdiff_t TxExt, ptrdiff_t RxExt>
+    int write(Span<const uint8_t, TxExt> tx_buffer, Span<uint8_t, RxExt> rx_buffer)
+    {
+        return write(reinterpret_cast<const char *>(tx_buffer.data()), static_cast<int>(tx_buffer.size()),
+                     reinterpret_cast<char *>(rx_buffer.data()), static_cast<int>(rx_buffer.size()));
+    }
+
+    /** @copydoc write(Span<const uint8_t,TxExt>,Span<uint8_t,RxExt>)
+     */
+    template<ptrdiff_t TxExt, ptrdiff_t RxExt>
+    int write(Span<uint8_t, TxExt> tx_buffer, Span<uint8_t, RxExt> rx_buffer)
+    {
+        return write(reinterpret_cast<const char *>(tx_buffer.data()), static_cast<int>(tx_buffer.size()),
+                     reinterpret_cast<char *>(rx_buffer.data()), static_cast<int>(rx_buffer.size()));
+    }
+
     /** Acquire exclusive access to this SPI bus.
      */
     virtual void lock(void);
@@ -149,6 +189,20 @@ public:
      */
     virtual void unlock(void);
 
+    /** Mark this object as the sole user of the SPI bus.
+     *
+     *  On a bus with a single owner the shared mutex and the
+     *  owner-tracking in the acquire path are pure overhead. Calling
+     *  set_dedicated() applies this object's format and frequency once
+     *  and makes subsequent write() calls go straight to the hardware,
+     *  skipping both the mutex and the reconfiguration check.
+     *
+     *  Only call this when no other SPI object (and no other thread)
+     *  uses the same physical bus; there is no protection against
+     *  concurrent access afterwards.
+     */
+    void set_dedicated(void);
+
     /** Set default write data.
       * SPI requires the master to send some data during a read operation.
       * Different devices may require different default byte values.
@@ -187,6 +241,48 @@ public:
         return 0;
     }
 
+    /** Start a continuous transfer over a ring of buffers.
+     *
+     * The ring is submitted once; on every buffer completion the next
+     * buffer is re-armed from the interrupt handler, before the callback
+     * runs, so the bus never goes idle between buffers. The callback is
+     * then invoked once per completed buffer and overlaps the transfer of
+     * the next one, which makes a two-buffer ring a classic double buffer:
+     * refill buffer N in the callback while buffer N+1 is on the wire.
+     *
+     * The ring keeps running until stop_transfer_ring() or
+     * abort_transfer() is called, or a transfer error occurs. The buffer
+     * pointer arrays must stay valid for the lifetime of the ring.
+     *
+     * This function locks the deep sleep until the ring is stopped.
+     *
+     * @param tx_buffers Array of TX buffer pointers, transferred in order
+     *                   and wrapping back to the first. If NULL is passed,
+     *                   the default SPI value is sent.
+     * @param rx_buffers Array of RX buffer pointers, filled in the same
+     *                   order. If NULL is passed, received data are ignored.
+     * @param buffer_count   Number of buffers in each array.
+     * @param buffer_length  The length of every buffer in bytes.
+     * @param callback   The event callback function, called per buffer.
+     * @param event      The event mask of events to modify. @see spi_api.h for SPI events.
+     *
+     * @return Operation result.
+     * @retval 0 If the ring has started.
+     * @retval -1 If SPI peripheral is busy or the arguments are invalid.
+     */
+    template<typename Type>
+    int transfer_ring(const Type *const *tx_buffers, Type *const *rx_buffers, int buffer_count, int buffer_length, const event_callback_t &callback, int event = SPI_EVENT_COMPLETE)
+    {
+        return transfer_ring((const void *const *)tx_buffers, (void *const *)rx_buffers, buffer_count, buffer_length, sizeof(Type) * 8, callback, event);
+    }
+
+    /** Stop a running transfer ring at the next buffer boundary.
+     *
+     * The buffer currently on the wire completes normally and gets its
+     * callback; no further buffer is armed after it.
+     */
+    void stop_transfer_ring();
+
     /** Abort the on-going SPI transfer, and continue with transfers in the queue, if any.
      */
     void abort_transfer();
@@ -265,6 +361,24 @@ protected:
      */
     void start_transfer(const void *tx_buffer, int tx_length, void *rx_buffer, int rx_length, unsigned char bit_width, const event_callback_t &callback, int event);
 
+    /** Start a transfer ring.
+     *
+     * @param tx_buffers Array of TX buffer pointers, or NULL to send the
+     *                   default SPI value.
+     * @param rx_buffers Array of RX buffer pointers, or NULL to ignore
+     *                   received data.
+     * @param buffer_count   Number of buffers in each array.
+     * @param buffer_length  The length of every buffer in bytes.
+     * @param bit_width  The buffers element width in bits.
+     * @param callback   The event callback function, called per buffer.
+     * @param event      The event mask of events to modify.
+     *
+     * @return Operation result.
+     * @retval 0 The ring has started.
+     * @retval -1 SPI peripheral is busy or the arguments are invalid.
+     */
+    int transfer_ring(const void *const *tx_buffers, void *const *rx_buffers, int buffer_count, int buffer_length, unsigned char bit_width, const event_callback_t &callback, int event);
+
 private:
     /** Lock deep sleep only if it is not yet locked */
     void lock_deep_sleep();
@@ -307,6 +421,17 @@ protected:
     DMAUsage _usage;
     /* Current sate of the sleep manager */
     bool _deep_sleep_locked;
+
+    /* Transfer ring state, owned by the interrupt handler while active */
+    const void *const *_ring_tx;  /* TX buffer pointer array, NULL to send fill */
+    void *const *_ring_rx;        /* RX buffer pointer array, NULL to discard */
+    int _ring_count;              /* Buffers in the ring */
+    int _ring_length;             /* Length of every ring buffer in bytes */
+    int _ring_index;              /* Buffer currently on the wire */
+    int _ring_event;              /* Event mask the ring was started with */
+    unsigned char _ring_width;    /* Element width of the ring buffers in bits */
+    bool _ring_active;            /* A ring is running */
+    bool _ring_stop;              /* Stop the ring at the next buffer boundary */
 #endif
 
     /* Take over the physical SPI and apply our settings (thread safe) */
@@ -323,6 +448,12 @@ protected:
     int _hz;
     /* Default character used for NULL transfers */
     char _write_fill;
+    /* Bus is owned exclusively by this object, mutex and acquire elided */
+    bool _dedicated;
+    /* Fingerprint of the format/frequency currently programmed in the
+     * peripheral, so an owner change between identically configured
+     * objects does not rewrite the registers */
+    static uint64_t _bus_fingerprint;
 
 private:
     /** Private acquire function without locking/unlocking.
@@ -330,6 +461,9 @@ private:
      */
     void _acquire(void);
 
+    /** Pack this object's format and frequency into a comparable fingerprint */
+    uint64_t _config_fingerprint(void) const;
+
 #endif //!defined(DOXYGEN_ONLY)
 };
 
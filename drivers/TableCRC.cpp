@@ -22,6 +22,33 @@ namespace mbed {
 /** \addtogroup drivers */
 /** @{*/
 
+#if MBED_CONF_DRIVERS_CRC_TABLE_SIZE == MBED_OPTIMIZED_CRC_TABLE_SIZE
+
+extern const uint8_t Table_CRC_Nibble_7Bit_SD[MBED_OPTIMIZED_CRC_TABLE_SIZE] = {
+    0x00, 0x12, 0x24, 0x36, 0x48, 0x5a, 0x6c, 0x7e, 0x90, 0x82, 0xb4, 0xa6, 0xd8, 0xca, 0xfc, 0xee
+};
+
+extern const uint8_t Table_CRC_Nibble_8bit_CCITT[MBED_OPTIMIZED_CRC_TABLE_SIZE] = {
+    0x00, 0x07, 0x0e, 0x09, 0x1c, 0x1b, 0x12, 0x15, 0x38, 0x3f, 0x36, 0x31, 0x24, 0x23, 0x2a, 0x2d
+};
+
+extern const uint16_t Table_CRC_Nibble_16bit_CCITT[MBED_OPTIMIZED_CRC_TABLE_SIZE] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+    0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef
+};
+
+extern const uint16_t Table_CRC_Nibble_16bit_IBM[MBED_OPTIMIZED_CRC_TABLE_SIZE] = {
+    0x0000, 0x8005, 0x800f, 0x000a, 0x801b, 0x001e, 0x0014, 0x8011,
+    0x8033, 0x0036, 0x003c, 0x8039, 0x0028, 0x802d, 0x8027, 0x0022
+};
+
+extern const uint32_t Table_CRC_Nibble_32bit_ANSI[MBED_OPTIMIZED_CRC_TABLE_SIZE] = {
+    0x00000000, 0x04c11db7, 0x09823b6e, 0x0d4326d9, 0x130476dc, 0x17c56b6b, 0x1a864db2, 0x1e475005,
+    0x2608edb8, 0x22c9f00f, 0x2f8ad6d6, 0x2b4bcb61, 0x350c9b64, 0x31cd86d3, 0x3c8ea00a, 0x384fbdbd
+};
+
+#else
+
 extern const uint8_t Table_CRC_7Bit_SD[MBED_CRC_TABLE_SIZE] = {
     0x0,  0x12, 0x24, 0x36, 0x48, 0x5a, 0x6c, 0x7e, 0x90, 0x82, 0xb4, 0xa6, 0xd8, 0xca, 0xfc, 0xee,
     0x32, 0x20, 0x16, 0x4,  0x7a, 0x68, 0x5e, 0x4c, 0xa2, 0xb0, 0x86, 0x94, 0xea, 0xf8, 0xce, 0xdc,
@@ -144,6 +171,8 @@ extern const uint32_t Table_CRC_32bit_ANSI[MBED_CRC_TABLE_SIZE] = {
     0xafb010b1, 0xab710d06, 0xa6322bdf, 0xa2f33668, 0xbcb4666d, 0xb8757bda, 0xb5365d03, 0xb1f740b4
 };
 
+#endif // MBED_CONF_DRIVERS_CRC_TABLE_SIZE
+
 extern const uint32_t Table_CRC_32bit_Rev_ANSI[MBED_OPTIMIZED_CRC_TABLE_SIZE] = {
     0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
     0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
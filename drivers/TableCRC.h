@@ -27,11 +27,27 @@ namespace mbed {
 #define MBED_CRC_TABLE_SIZE             256
 #define MBED_OPTIMIZED_CRC_TABLE_SIZE   16
 
+/* Size of the byte-oriented software CRC tables, configurable through
+ * drivers.crc-table-size. 256-entry tables consume 1KB of flash per 32-bit
+ * polynomial; 16-entry nibble tables consume 64 bytes at roughly half the
+ * throughput (still ~4x faster than the bitwise fallback). */
+#ifndef MBED_CONF_DRIVERS_CRC_TABLE_SIZE
+#define MBED_CONF_DRIVERS_CRC_TABLE_SIZE MBED_CRC_TABLE_SIZE
+#endif
+
+#if MBED_CONF_DRIVERS_CRC_TABLE_SIZE == MBED_OPTIMIZED_CRC_TABLE_SIZE
+extern const uint8_t Table_CRC_Nibble_7Bit_SD[MBED_OPTIMIZED_CRC_TABLE_SIZE];
+extern const uint8_t Table_CRC_Nibble_8bit_CCITT[MBED_OPTIMIZED_CRC_TABLE_SIZE];
+extern const uint16_t Table_CRC_Nibble_16bit_CCITT[MBED_OPTIMIZED_CRC_TABLE_SIZE];
+extern const uint16_t Table_CRC_Nibble_16bit_IBM[MBED_OPTIMIZED_CRC_TABLE_SIZE];
+extern const uint32_t Table_CRC_Nibble_32bit_ANSI[MBED_OPTIMIZED_CRC_TABLE_SIZE];
+#else
 extern const uint8_t Table_CRC_7Bit_SD[MBED_CRC_TABLE_SIZE];
 extern const uint8_t Table_CRC_8bit_CCITT[MBED_CRC_TABLE_SIZE];
 extern const uint16_t Table_CRC_16bit_CCITT[MBED_CRC_TABLE_SIZE];
 extern const uint16_t Table_CRC_16bit_IBM[MBED_CRC_TABLE_SIZE];
 extern const uint32_t Table_CRC_32bit_ANSI[MBED_CRC_TABLE_SIZE];
+#endif
 extern const uint32_t Table_CRC_32bit_Rev_ANSI[MBED_OPTIMIZED_CRC_TABLE_SIZE];
 
 /** @}*/
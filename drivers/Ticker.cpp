@@ -41,13 +41,23 @@ void Ticker::setup(us_timestamp_t t)
     core_util_critical_section_enter();
     remove();
     _delay = t;
-    insert_absolute(_delay + ticker_read_us(_ticker_data));
+    if (_slack) {
+        insert_absolute_coalesced(_delay + ticker_read_us(_ticker_data), _slack);
+    } else {
+        insert_absolute(_delay + ticker_read_us(_ticker_data));
+    }
     core_util_critical_section_exit();
 }
 
 void Ticker::handler()
 {
-    insert_absolute(event.timestamp + _delay);
+    // event.timestamp holds the requested time, so a coalesced periodic
+    // ticker does not accumulate its slack
+    if (_slack) {
+        insert_absolute_coalesced(event.timestamp + _delay, _slack);
+    } else {
+        insert_absolute(event.timestamp + _delay);
+    }
     if (_function) {
         _function();
     }
@@ -67,12 +67,12 @@ namespace mbed {
 class Ticker : public TimerEvent, private NonCopyable<Ticker> {
 
 public:
-    Ticker() : TimerEvent(), _function(0), _lock_deepsleep(true)
+    Ticker() : TimerEvent(), _function(0), _lock_deepsleep(true), _slack(0)
     {
     }
 
     // When low power ticker is in use, then do not disable deep sleep.
-    Ticker(const ticker_data_t *data) : TimerEvent(data), _function(0), _lock_deepsleep(true)
+    Ticker(const ticker_data_t *data) : TimerEvent(data), _function(0), _lock_deepsleep(true), _slack(0)
     {
 #if DEVICE_LPTICKER
         _lock_deepsleep = (data != get_lp_ticker_data());
@@ -125,6 +125,33 @@ public:
             sleep_manager_lock_deep_sleep();
         }
         _function = func;
+        _slack = 0;
+        setup(t);
+        core_util_critical_section_exit();
+    }
+
+    /** Attach a function to be called by the Ticker, specifying the interval
+     *  in microseconds and an acceptable lateness
+     *
+     *  The callback is scheduled through the ticker's timing wheel instead of
+     *  its own ticker queue entry: arming and disarming are constant time,
+     *  and the callback may run up to @a slack microseconds after each
+     *  interval so that objects with overlapping slack windows share a single
+     *  deep-sleep-breaking wakeup.
+     *
+     *  @param func pointer to the function to be called
+     *  @param t the time between calls in micro-seconds
+     *  @param slack acceptable lateness of each call in micro-seconds
+     */
+    void attach_us(Callback<void()> func, us_timestamp_t t, us_timestamp_t slack)
+    {
+        core_util_critical_section_enter();
+        // lock only for the initial callback setup and this is not low power ticker
+        if (!_function && _lock_deepsleep) {
+            sleep_manager_lock_deep_sleep();
+        }
+        _function = func;
+        _slack = slack;
         setup(t);
         core_util_critical_section_exit();
     }
@@ -169,6 +196,7 @@ protected:
     us_timestamp_t         _delay;  /**< Time delay (in microseconds) for resetting the multishot callback. */
     Callback<void()>    _function;  /**< Callback. */
     bool          _lock_deepsleep;  /**< Flag which indicates if deep sleep should be disabled. */
+    us_timestamp_t         _slack;  /**< Acceptable lateness for wakeup coalescing, 0 for an exact event. */
 #endif
 };
 
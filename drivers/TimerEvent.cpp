@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 #include "drivers/TimerEvent.h"
+#include "drivers/TimerWheel.h"
 
 #include <stddef.h>
 #include "hal/ticker_api.h"
@@ -22,12 +23,12 @@
 
 namespace mbed {
 
-TimerEvent::TimerEvent() : event(), _ticker_data(get_us_ticker_data())
+TimerEvent::TimerEvent() : event(), wheel_node(), _ticker_data(get_us_ticker_data())
 {
     ticker_set_handler(_ticker_data, (&TimerEvent::irq));
 }
 
-TimerEvent::TimerEvent(const ticker_data_t *data) : event(), _ticker_data(data)
+TimerEvent::TimerEvent(const ticker_data_t *data) : event(), wheel_node(), _ticker_data(data)
 {
     ticker_set_handler(_ticker_data, (&TimerEvent::irq));
 }
@@ -54,8 +55,20 @@ void TimerEvent::insert_absolute(us_timestamp_t timestamp)
     ticker_insert_event_us(_ticker_data, &event, timestamp, (uint32_t)this);
 }
 
+void TimerEvent::insert_absolute_coalesced(us_timestamp_t timestamp, us_timestamp_t slack)
+{
+    // Record the requested timestamp so periodic users can derive the next
+    // interval without accumulating the coalescing slack
+    event.timestamp = timestamp;
+    event.id = (uint32_t)this;
+    TimerWheel::get(_ticker_data)->insert(&wheel_node, this, timestamp, slack);
+}
+
 void TimerEvent::remove()
 {
+    if (wheel_node.linked) {
+        TimerWheel::get(_ticker_data)->remove(&wheel_node);
+    }
     ticker_remove_event(_ticker_data, &event);
 }
 
@@ -24,6 +24,22 @@
 namespace mbed {
 /** \addtogroup drivers */
 
+class TimerEvent;
+
+/** Node linking a TimerEvent into a driver-level timing wheel
+ *
+ * Zero-initialized by the TimerEvent constructor; managed by TimerWheel.
+ */
+struct timer_wheel_node_t {
+    timer_wheel_node_t *next;   /**< Next node in the slot list */
+    timer_wheel_node_t *prev;   /**< Previous node in the slot list */
+    us_timestamp_t deadline;    /**< Effective expiry time after coalescing */
+    TimerEvent *owner;          /**< Event whose handler runs on expiry */
+    uint8_t level;              /**< Wheel level the node is linked on */
+    uint8_t slot;               /**< Slot index within the level */
+    bool linked;                /**< Whether the node is in a wheel */
+};
+
 /** Base abstraction for timer interrupts
  *
  * @note Synchronization level: Interrupt safe
@@ -46,6 +62,9 @@ public:
 
 #if !defined(DOXYGEN_ONLY)
 protected:
+    // The wheel dispatches handlers through the owner pointer of its nodes
+    friend class TimerWheel;
+
     // The handler called to service the timer event of the derived class
     virtual void handler() = 0;
 
@@ -72,12 +91,30 @@ protected:
      */
     void insert_absolute(us_timestamp_t timestamp);
 
+    /** Set absolute timestamp of the internal event, allowing coalescing.
+     *
+     * The event goes through the ticker's TimerWheel rather than its own
+     * ticker queue entry: insertion is constant time, and the handler may
+     * run up to @a slack microseconds late so that events with overlapping
+     * slack windows share a single wakeup.
+     *
+     * @param   timestamp   event's us timestamp
+     * @param   slack       acceptable lateness in us
+     *
+     * @warning
+     * Do not insert more than one timestamp.
+     * The same @a event object is used for every @a insert/insert_absolute call.
+     */
+    void insert_absolute_coalesced(us_timestamp_t timestamp, us_timestamp_t slack);
+
     /** Remove timestamp.
      */
     void remove();
 
     ticker_event_t event;
 
+    timer_wheel_node_t wheel_node;
+
     const ticker_data_t *_ticker_data;
 #endif
 };
@@ -0,0 +1,264 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "drivers/TimerWheel.h"
+
+#include <string.h>
+#include "platform/mbed_critical.h"
+#include "platform/mbed_assert.h"
+
+namespace mbed {
+
+// One wheel per ticker is enough for the us and lp tickers
+#define WHEEL_TABLE_SIZE 2
+
+static TimerWheel *wheel_table[WHEEL_TABLE_SIZE];
+static const ticker_data_t *wheel_owner[WHEEL_TABLE_SIZE];
+
+TimerWheel *TimerWheel::get(const ticker_data_t *data)
+{
+    for (int i = 0; i < WHEEL_TABLE_SIZE; i++) {
+        if (wheel_owner[i] == data) {
+            return wheel_table[i];
+        }
+    }
+
+    // Allocate outside the critical section; discard the spare if another
+    // context created the wheel in the meantime
+    TimerWheel *fresh = new TimerWheel(data);
+    TimerWheel *result = NULL;
+    core_util_critical_section_enter();
+    for (int i = 0; i < WHEEL_TABLE_SIZE; i++) {
+        if (wheel_owner[i] == data) {
+            result = wheel_table[i];
+            break;
+        }
+        if (wheel_owner[i] == NULL) {
+            wheel_owner[i] = data;
+            wheel_table[i] = fresh;
+            result = fresh;
+            fresh = NULL;
+            break;
+        }
+    }
+    core_util_critical_section_exit();
+    if (fresh != result && fresh != NULL) {
+        delete fresh;
+    }
+    MBED_ASSERT(result != NULL);
+    return result;
+}
+
+TimerWheel::TimerWheel(const ticker_data_t *data) :
+    TimerEvent(data), _slots(), _occupied(), _due(NULL)
+{
+    _granularity = MBED_CONF_DRIVERS_TIMER_WHEEL_GRANULARITY_US;
+    _last = ticker_read_us(_ticker_data);
+}
+
+us_timestamp_t TimerWheel::slot_width(int level) const
+{
+    return _granularity << (5 * level);
+}
+
+void TimerWheel::insert(timer_wheel_node_t *node, TimerEvent *owner, us_timestamp_t deadline, us_timestamp_t slack)
+{
+    core_util_critical_section_enter();
+
+    if (node->linked) {
+        unlink(node);
+    }
+    node->owner = owner;
+
+    // Quantize the deadline up to the coarsest wheel granule that fits the
+    // slack, so timeouts with overlapping slack windows land on the same
+    // boundary and are dispatched by a single wakeup
+    us_timestamp_t effective = deadline;
+    if (slack >= _granularity) {
+        us_timestamp_t granule = _granularity;
+        while (granule * WHEEL_SLOTS <= slack) {
+            granule *= WHEEL_SLOTS;
+        }
+        effective = ((deadline + granule - 1) / granule) * granule;
+    }
+    node->deadline = effective;
+
+    us_timestamp_t now = ticker_read_us(_ticker_data);
+    link(node, now);
+    rearm(now);
+
+    core_util_critical_section_exit();
+}
+
+void TimerWheel::remove(timer_wheel_node_t *node)
+{
+    core_util_critical_section_enter();
+    if (node->linked) {
+        unlink(node);
+        rearm(ticker_read_us(_ticker_data));
+    }
+    core_util_critical_section_exit();
+}
+
+void TimerWheel::link(timer_wheel_node_t *node, us_timestamp_t now)
+{
+    timer_wheel_node_t **head;
+
+    if (node->deadline <= now) {
+        // Already due - park on the due list, rearm() fires right away
+        node->level = DUE_LEVEL;
+        head = &_due;
+    } else {
+        us_timestamp_t delta = node->deadline - now;
+        int level = 0;
+        while (level < WHEEL_LEVELS - 1 && delta >= slot_width(level) * WHEEL_SLOTS) {
+            level++;
+        }
+        us_timestamp_t width = slot_width(level);
+        // Level 0 rounds the deadline up so the slot boundary is never
+        // early; coarse levels round down so the boundary falls before the
+        // deadline and the node cascades to a finer level in time
+        uint64_t index;
+        if (level == 0) {
+            index = (node->deadline + width - 1) / width;
+        } else {
+            index = node->deadline / width;
+        }
+        node->level = (uint8_t)level;
+        node->slot = (uint8_t)(index % WHEEL_SLOTS);
+        _occupied[level] |= 1UL << node->slot;
+        head = &_slots[level][node->slot];
+    }
+
+    node->prev = NULL;
+    node->next = *head;
+    if (*head) {
+        (*head)->prev = node;
+    }
+    *head = node;
+    node->linked = true;
+}
+
+void TimerWheel::unlink(timer_wheel_node_t *node)
+{
+    timer_wheel_node_t **head;
+    if (node->level == DUE_LEVEL) {
+        head = &_due;
+    } else {
+        head = &_slots[node->level][node->slot];
+    }
+
+    if (node->next) {
+        node->next->prev = node->prev;
+    }
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        *head = node->next;
+    }
+    if (node->level != DUE_LEVEL && _slots[node->level][node->slot] == NULL) {
+        _occupied[node->level] &= ~(1UL << node->slot);
+    }
+    node->linked = false;
+}
+
+void TimerWheel::collect(us_timestamp_t now)
+{
+    for (int level = 0; level < WHEEL_LEVELS; level++) {
+        if (_occupied[level] == 0) {
+            continue;
+        }
+        us_timestamp_t width = slot_width(level);
+        uint64_t last_index = _last / width;
+        uint64_t now_index = now / width;
+        uint64_t steps = now_index - last_index;
+        if (steps > WHEEL_SLOTS) {
+            steps = WHEEL_SLOTS;
+        }
+        for (uint64_t i = 1; i <= steps; i++) {
+            int slot = (int)((last_index + i) % WHEEL_SLOTS);
+            timer_wheel_node_t *node = _slots[level][slot];
+            while (node) {
+                timer_wheel_node_t *next = node->next;
+                unlink(node);
+                // Level-0 nodes are due by construction; coarse-level nodes
+                // cascade down towards their deadline
+                link(node, now);
+                node = next;
+            }
+        }
+    }
+    _last = now;
+}
+
+void TimerWheel::rearm(us_timestamp_t now)
+{
+    // The ticker queue must not hold the same event twice, so always drop
+    // the wheel's event before re-arming it
+    TimerEvent::remove();
+
+    if (_due) {
+        // A timestamp in the past makes the ticker fire immediately
+        insert_absolute(now);
+        return;
+    }
+
+    bool armed = false;
+    us_timestamp_t wake = 0;
+    for (int level = 0; level < WHEEL_LEVELS; level++) {
+        if (_occupied[level] == 0) {
+            continue;
+        }
+        us_timestamp_t width = slot_width(level);
+        uint64_t now_index = now / width;
+        int current = (int)(now_index % WHEEL_SLOTS);
+        for (int j = 1; j <= WHEEL_SLOTS; j++) {
+            int slot = (current + j) % WHEEL_SLOTS;
+            if (_occupied[level] & (1UL << slot)) {
+                us_timestamp_t boundary = (now_index + j) * width;
+                if (!armed || boundary < wake) {
+                    armed = true;
+                    wake = boundary;
+                }
+                break;
+            }
+        }
+    }
+
+    if (armed) {
+        insert_absolute(wake);
+    }
+}
+
+void TimerWheel::handler()
+{
+    core_util_critical_section_enter();
+    us_timestamp_t now = ticker_read_us(_ticker_data);
+    collect(now);
+    while (_due) {
+        timer_wheel_node_t *node = _due;
+        unlink(node);
+        // Dispatch outside the critical section - the handler may run user
+        // code and re-insert
+        core_util_critical_section_exit();
+        node->owner->handler();
+        core_util_critical_section_enter();
+    }
+    rearm(ticker_read_us(_ticker_data));
+    core_util_critical_section_exit();
+}
+
+} // namespace mbed
@@ -0,0 +1,106 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_TIMERWHEEL_H
+#define MBED_TIMERWHEEL_H
+
+#include "drivers/TimerEvent.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** Hierarchical timing wheel multiplexing coalesced timer events
+ *
+ * One wheel per ticker owns a single event in the ticker queue and
+ * dispatches every TimerEvent inserted through insert_absolute_coalesced().
+ * Inserting into and removing from the wheel are constant-time list
+ * operations, unlike the sorted-list walk of ticker_insert_event_us, and
+ * deadlines are quantized into the coarsest wheel granule that fits the
+ * caller's slack so that nearby timeouts share one wakeup.
+ *
+ * Instances are created lazily on first use; code that never inserts a
+ * coalesced event pays nothing.
+ *
+ * @note Synchronization level: Interrupt safe
+ * @ingroup drivers
+ */
+class TimerWheel : private TimerEvent, private NonCopyable<TimerWheel> {
+public:
+    /** Return the wheel serving a ticker, creating it on first use
+     *
+     * @param data The ticker to multiplex onto
+     * @return The wheel instance for that ticker
+     */
+    static TimerWheel *get(const ticker_data_t *data);
+
+    /** Insert an event into the wheel
+     *
+     * The owner's handler runs no earlier than @a deadline and no later
+     * than @a deadline plus the slack rounded up by one wheel granule.
+     * Re-inserting a node that is already linked moves it.
+     *
+     * @param node     The wheel node embedded in the owning TimerEvent
+     * @param owner    The TimerEvent whose handler to run on expiry
+     * @param deadline Absolute expiry time in microseconds
+     * @param slack    Acceptable lateness used for wakeup coalescing
+     */
+    void insert(timer_wheel_node_t *node, TimerEvent *owner, us_timestamp_t deadline, us_timestamp_t slack);
+
+    /** Remove an event from the wheel
+     *
+     * Safe to call on a node that is not linked.
+     *
+     * @param node The wheel node to remove
+     */
+    void remove(timer_wheel_node_t *node);
+
+#if !defined(DOXYGEN_ONLY)
+protected:
+    // Ticker event expired - collect due nodes, cascade the rest, rearm
+    virtual void handler();
+
+private:
+    TimerWheel(const ticker_data_t *data);
+
+    // Place a node by its remaining delta; constant time
+    void link(timer_wheel_node_t *node, us_timestamp_t now);
+    // Detach a node from its slot or the due list; constant time
+    void unlink(timer_wheel_node_t *node);
+    // Move nodes from slots passed since the last collection to the due
+    // list, relinking coarse-level nodes that are not due yet
+    void collect(us_timestamp_t now);
+    // Reprogram the single ticker event for the nearest slot boundary
+    void rearm(us_timestamp_t now);
+
+    us_timestamp_t slot_width(int level) const;
+
+    static const int WHEEL_LEVELS = 4;
+    static const int WHEEL_SLOTS = 32;
+    // Marker level for nodes parked on the due list
+    static const uint8_t DUE_LEVEL = 0xFF;
+
+    timer_wheel_node_t *_slots[WHEEL_LEVELS][WHEEL_SLOTS];
+    uint32_t _occupied[WHEEL_LEVELS];
+    timer_wheel_node_t *_due;
+    us_timestamp_t _last;
+    us_timestamp_t _granularity;
+#endif
+};
+
+} // namespace mbed
+
+#endif
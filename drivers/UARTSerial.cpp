@@ -35,12 +35,21 @@ UARTSerial::UARTSerial(PinName tx, PinName rx, int baud) :
     _rx_irq_enabled(true),
     _dcd_irq(NULL)
 {
+#if DEVICE_SERIAL_RX_DMA
+    _dma_rx_tail = 0;
+    _rx_dma_enabled = false;
+#endif
     /* Attatch IRQ routines to the serial device. */
     SerialBase::attach(callback(this, &UARTSerial::rx_irq), RxIrq);
 }
 
 UARTSerial::~UARTSerial()
 {
+#if DEVICE_SERIAL_RX_DMA
+    if (_rx_dma_enabled) {
+        dma_serial_rx_abort(&_serial);
+    }
+#endif
     delete _dcd_irq;
 }
 
@@ -203,6 +212,78 @@ ssize_t UARTSerial::write(const void *buffer, size_t length)
     return data_written != 0 ? (ssize_t) data_written : (ssize_t) - EAGAIN;
 }
 
+ssize_t UARTSerial::writev(const iovec_t *iov, int count)
+{
+    size_t total_length = 0;
+
+    for (int i = 0; i < count; i++) {
+        total_length += iov[i].length;
+    }
+
+    if (total_length == 0) {
+        return 0;
+    }
+
+    if (core_util_in_critical_section()) {
+        size_t data_written = 0;
+        for (int i = 0; i < count; i++) {
+            if (iov[i].length != 0) {
+                data_written += write_unbuffered(static_cast<const char *>(iov[i].buffer), iov[i].length);
+            }
+        }
+        return data_written;
+    }
+
+    api_lock();
+
+    size_t data_written = 0;
+    int index = 0;
+    const char *buf_ptr = static_cast<const char *>(iov[0].buffer);
+    size_t span_remaining = iov[0].length;
+
+    // Same policy as write() - write the whole thing if blocking, but all
+    // spans are pushed to the TX buffer in one pass so the frame is
+    // assembled without intermediate staging copies.
+    while (data_written < total_length) {
+
+        if (_txbuf.full()) {
+            if (!_blocking) {
+                break;
+            }
+            do {
+                api_unlock();
+                wait_ms(1); // XXX todo - proper wait, WFE for non-rtos ?
+                api_lock();
+            } while (_txbuf.full());
+        }
+
+        while (data_written < total_length && !_txbuf.full()) {
+            while (span_remaining == 0) {
+                index++;
+                buf_ptr = static_cast<const char *>(iov[index].buffer);
+                span_remaining = iov[index].length;
+            }
+            _txbuf.push(*buf_ptr++);
+            span_remaining--;
+            data_written++;
+        }
+
+        core_util_critical_section_enter();
+        if (!_tx_irq_enabled) {
+            UARTSerial::tx_irq();                // only write to hardware in one place
+            if (!_txbuf.empty()) {
+                SerialBase::attach(callback(this, &UARTSerial::tx_irq), TxIrq);
+                _tx_irq_enabled = true;
+            }
+        }
+        core_util_critical_section_exit();
+    }
+
+    api_unlock();
+
+    return data_written != 0 ? (ssize_t) data_written : (ssize_t) - EAGAIN;
+}
+
 ssize_t UARTSerial::read(void *buffer, size_t length)
 {
     size_t data_read = 0;
@@ -245,6 +326,62 @@ ssize_t UARTSerial::read(void *buffer, size_t length)
     return data_read;
 }
 
+#if DEVICE_SERIAL_RX_DMA
+void UARTSerial::set_rx_dma(bool enable)
+{
+    api_lock();
+    core_util_critical_section_enter();
+    if (enable && !_rx_dma_enabled) {
+        /* The idle-line/half/full interrupt replaces the per-byte RX IRQ. */
+        if (_rx_irq_enabled) {
+            SerialBase::attach(NULL, RxIrq);
+            _rx_irq_enabled = false;
+        }
+        _dma_rx_tail = 0;
+        dma_serial_rx_init(&_serial, _dma_rxbuf, sizeof(_dma_rxbuf),
+                           &UARTSerial::_dma_rx_handler, (uint32_t)this);
+        _rx_dma_enabled = true;
+    } else if (!enable && _rx_dma_enabled) {
+        dma_serial_rx_abort(&_serial);
+        /* Claim whatever the hardware wrote before the abort. */
+        dma_rx_irq(DMA_SERIAL_EVENT_RX_IDLE);
+        _rx_dma_enabled = false;
+        if (!_rxbuf.full()) {
+            SerialBase::attach(callback(this, &UARTSerial::rx_irq), RxIrq);
+            _rx_irq_enabled = true;
+        }
+    }
+    core_util_critical_section_exit();
+    api_unlock();
+}
+
+void UARTSerial::_dma_rx_handler(uint32_t id, uint32_t event)
+{
+    UARTSerial *handler = (UARTSerial *) id;
+    handler->dma_rx_irq(event);
+}
+
+void UARTSerial::dma_rx_irq(uint32_t event)
+{
+    bool was_empty = _rxbuf.empty();
+    size_t head = dma_serial_rx_get_index(&_serial);
+
+    /* Move everything the hardware wrote since the last event from the
+     * staging buffer into the receive buffer. On overflow of _rxbuf the
+     * remainder is dropped, as the per-byte path does when it detaches. */
+    while (_dma_rx_tail != head && !_rxbuf.full()) {
+        _rxbuf.push((char) _dma_rxbuf[_dma_rx_tail]);
+        _dma_rx_tail = (_dma_rx_tail + 1) % sizeof(_dma_rxbuf);
+    }
+    _dma_rx_tail = head;
+
+    /* Report the File handler that data is ready to be read from the buffer. */
+    if (was_empty && !_rxbuf.empty()) {
+        wake();
+    }
+}
+#endif
+
 bool UARTSerial::hup() const
 {
     return _dcd_irq && _dcd_irq->read() != 0;
@@ -252,6 +389,7 @@ bool UARTSerial::hup() const
 
 void UARTSerial::wake()
 {
+    wake_poll();
     if (_sigio_cb) {
         _sigio_cb();
     }
@@ -27,6 +27,7 @@
 #include "InterruptIn.h"
 #include "platform/PlatformMutex.h"
 #include "hal/serial_api.h"
+#include "hal/dma_serial_api.h"
 #include "platform/CircularBuffer.h"
 #include "platform/NonCopyable.h"
 
@@ -70,6 +71,11 @@ public:
     using FileHandle::readable;
     using FileHandle::writable;
 
+    /* Keep the Span-based read/write overloads from FileHandle visible
+     * alongside the pointer overrides below */
+    using FileHandle::read;
+    using FileHandle::write;
+
     /** Write the contents of a buffer to a file
      *
      *  Follows POSIX semantics:
@@ -98,6 +104,19 @@ public:
      */
     virtual ssize_t read(void *buffer, size_t length);
 
+    /** Write the contents of multiple buffers to a file (gather output)
+     *
+     *  All spans are pushed to the TX buffer under a single lock, so a
+     *  multi-part frame (header + payload + checksum) is assembled
+     *  without the per-call lock and IRQ-enable round trips that
+     *  separate write() calls would incur.
+     *
+     *  @param iov      An array of buffers to write from
+     *  @param count    The number of elements in iov
+     *  @return         The total number of bytes written, negative error on failure
+     */
+    virtual ssize_t writev(const iovec_t *iov, int count);
+
     /** Close a file
      *
      *  @return         0 on success, negative error code on failure
@@ -223,6 +242,22 @@ public:
     void set_flow_control(Flow type, PinName flow1 = NC, PinName flow2 = NC);
 #endif
 
+#if DEVICE_SERIAL_RX_DMA || defined(DOXYGEN_ONLY)
+    /** Enable or disable DMA-backed reception.
+     *
+     *  When enabled, the peripheral fills a staging buffer in hardware and
+     *  the driver is only interrupted on idle-line detection or when the
+     *  DMA transfer passes its half/full marks, instead of once per byte.
+     *  Read semantics are unchanged - data still arrives through the same
+     *  receive buffer used by the interrupt-per-byte path.
+     *
+     *  Only available on targets with DEVICE_SERIAL_RX_DMA support.
+     *
+     *  @param enable true to receive via DMA, false for interrupt-per-byte
+     */
+    void set_rx_dma(bool enable);
+#endif
+
 private:
 
     void wait_ms(uint32_t millisec);
@@ -257,6 +292,20 @@ private:
     bool _rx_irq_enabled;
     InterruptIn *_dcd_irq;
 
+#if DEVICE_SERIAL_RX_DMA
+    /** Staging buffer filled by the DMA controller; drained into _rxbuf
+     *  from the idle-line/half/full interrupt.
+     */
+    uint8_t _dma_rxbuf[MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE];
+    size_t _dma_rx_tail;
+    bool _rx_dma_enabled;
+
+    /** Drain the DMA staging buffer up to the current hardware index */
+    void dma_rx_irq(uint32_t event);
+
+    static void _dma_rx_handler(uint32_t id, uint32_t event);
+#endif
+
     /** Device Hanged up
      *  Determines if the device hanged up on us.
      *
@@ -19,6 +19,7 @@
 
 #include "events/EventQueue.h"
 #include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
 
 namespace events {
 /** \addtogroup events */
@@ -4066,6 +4067,305 @@ Event<void(A0, A1, A2, A3, A4)> EventQueue::event(mbed::Callback<R(B0, B1, B2, B
     return Event<void(A0, A1, A2, A3, A4)>(this, cb, c0, c1, c2, c3, c4);
 }
 #endif
+
+/** UserAllocatedEvent
+ *
+ *  Representation of an event with caller-owned storage. Unlike Event,
+ *  posting never allocates from the queue - the event structure is a member
+ *  of this object - so post() cannot fail, runs in bounded time, and is
+ *  suitable for hard-real-time interrupt handlers.
+ *
+ *  Posting while the event is already pending coalesces into the earlier
+ *  post. A one-shot event can be posted again as soon as its callback has
+ *  started executing, a periodic event stays pending until cancelled.
+ *
+ *  The UserAllocatedEvent must outlive both its queue and any pending post.
+ * @ingroup events
+ */
+template <typename F>
+class UserAllocatedEvent : private mbed::NonCopyable<UserAllocatedEvent<F> > {
+public:
+    /** Create an event with caller-owned storage
+     *
+     *  @param q        Event queue to dispatch on
+     *  @param f        Function to execute when the event is dispatched
+     */
+    UserAllocatedEvent(EventQueue *q, F f)
+        : _event(), _equeue(&q->_equeue), _delay(0), _period(-1), _callback(f)
+    {
+        _event.priority = EQUEUE_PRIORITY_BANDS / 2;
+    }
+
+    ~UserAllocatedEvent()
+    {
+        cancel();
+    }
+
+    /** Configure the delay of an event
+     *
+     *  @param delay    Millisecond delay before dispatching the event,
+     *                  takes effect on the next post
+     */
+    void delay(int delay)
+    {
+        _delay = delay;
+    }
+
+    /** Configure the period of an event
+     *
+     *  @param period   Millisecond period for repeatedly dispatching
+     *                  an event, takes effect on the next post
+     */
+    void period(int period)
+    {
+        _period = period;
+    }
+
+    /** Configure the priority band of an event
+     *  @see EventQueue::Priority
+     *
+     *  @param priority Priority band the event is dispatched in,
+     *                  takes effect on the next post
+     */
+    void priority(unsigned priority)
+    {
+        equeue_event_priority(&_event + 1, priority);
+    }
+
+    /** Configure the coalescing slack of an event
+     *
+     *  @param slack    Milliseconds each deadline may be deferred to share
+     *                  a wakeup with other scheduled events,
+     *                  takes effect on the next post
+     */
+    void slack(int slack)
+    {
+        equeue_event_slack(&_event + 1, slack);
+    }
+
+    /** Post the event onto its queue
+     *
+     *  The post is wait-free, cannot fail, and is IRQ safe. If the event
+     *  is already pending the post coalesces into the earlier one and has
+     *  no effect.
+     */
+    void post()
+    {
+        equeue_post_user_allocated(_equeue, &UserAllocatedEvent::event_call,
+                                   &_event, _delay, _period);
+    }
+
+    /** Post the event onto its queue
+     *  @see UserAllocatedEvent::post
+     */
+    void call()
+    {
+        post();
+    }
+
+    /** Post the event onto its queue
+     *  @see UserAllocatedEvent::post
+     */
+    void operator()()
+    {
+        post();
+    }
+
+    /** Cancel the event if pending
+     *
+     *  It is safe to call cancel after the event has been dispatched.
+     *
+     *  The cancel function is IRQ safe. If called while the event queue's
+     *  dispatch loop is active, the event may have already begun executing.
+     */
+    void cancel()
+    {
+        equeue_cancel_user_allocated(_equeue, &_event);
+    }
+
+private:
+    static void event_call(void *p)
+    {
+        // dispatch passes a pointer to the memory just past the event
+        // header, which sits at the start of this object
+        UserAllocatedEvent *self = reinterpret_cast<UserAllocatedEvent *>(
+                reinterpret_cast<char *>(p) - sizeof(struct equeue_event));
+        self->_callback();
+    }
+
+    // must stay first, event_call recovers the object from the header
+    struct equeue_event _event;
+    equeue_t *_equeue;
+    int _delay;
+    int _period;
+    F _callback;
+};
+
+/** UserAllocatedEventPool
+ *
+ *  A fixed pool of caller-owned events for deferring work with a payload
+ *  from interrupt handlers to a dispatch thread with guaranteed delivery.
+ *
+ *  A single UserAllocatedEvent coalesces posts while pending, so at most
+ *  one deferral can be outstanding. The pool holds N pre-reserved slots
+ *  for the same callback: each post() claims a free slot, copies the
+ *  payload into it and posts it, so up to N deferrals with distinct
+ *  payloads can be in flight. If all slots are pending, post() fails
+ *  visibly - it returns false and increments the overflow counter -
+ *  instead of silently dropping the event the way an exhausted queue
+ *  slab does. Sized to the worst-case number of outstanding deferrals,
+ *  post() therefore never drops work.
+ *
+ *  post() is IRQ safe and runs in bounded time: a scan of the N slots
+ *  under a critical section plus a wait-free post. Once posted, the
+ *  worst-case queue-to-dispatch latency of a slot is bounded by the
+ *  remaining execution time of the callback running at post time, plus
+ *  the execution time of every pending event in the same or a higher
+ *  priority band (lower bands cannot delay it, see EventQueue priority
+ *  bands). With stats enabled the per-band terms can be measured as the
+ *  max_execution_us of the callbacks posted to each band.
+ *
+ *  The pool must outlive its queue and any pending post.
+ * @ingroup events
+ */
+template <typename A, unsigned N>
+class UserAllocatedEventPool : private mbed::NonCopyable<UserAllocatedEventPool<A, N> > {
+public:
+    /** Create a pool of N pre-reserved events
+     *
+     *  @param q        Event queue to dispatch on
+     *  @param cb       Callback invoked with the posted payload
+     */
+    UserAllocatedEventPool(EventQueue *q, mbed::Callback<void(A)> cb)
+        : _slots(), _equeue(&q->_equeue), _callback(cb), _overflows(0)
+    {
+        for (unsigned i = 0; i < N; i++) {
+            _slots[i].pool = this;
+            _slots[i].event.priority = EQUEUE_PRIORITY_BANDS / 2;
+        }
+    }
+
+    ~UserAllocatedEventPool()
+    {
+        cancel_all();
+    }
+
+    /** Configure the priority band events are dispatched in
+     *  @see EventQueue::Priority
+     *
+     *  @param priority Priority band, takes effect on the next post
+     */
+    void priority(unsigned priority)
+    {
+        for (unsigned i = 0; i < N; i++) {
+            equeue_event_priority(&_slots[i].event + 1, priority);
+        }
+    }
+
+    /** Post the callback with a payload onto the queue
+     *
+     *  Claims a free slot, copies the payload into it and posts it. The
+     *  post is IRQ safe, runs in bounded time and never allocates. The
+     *  slot is released as soon as the callback starts executing, so a
+     *  pool sized to the worst-case number of outstanding deferrals
+     *  never overflows.
+     *
+     *  @param arg      Payload passed to the callback
+     *  @return         true if posted, false if all N slots were already
+     *                  pending - the overflow counter is incremented and
+     *                  the payload is not delivered
+     */
+    bool post(const A &arg)
+    {
+        core_util_critical_section_enter();
+        slot_t *slot = NULL;
+        for (unsigned i = 0; i < N; i++) {
+            if (!_slots[i].pending) {
+                slot = &_slots[i];
+                break;
+            }
+        }
+        if (!slot) {
+            _overflows++;
+            core_util_critical_section_exit();
+            return false;
+        }
+        slot->pending = true;
+        slot->arg = arg;
+        core_util_critical_section_exit();
+
+        equeue_post_user_allocated(_equeue, &UserAllocatedEventPool::event_call,
+                                   &slot->event, 0, -1);
+        return true;
+    }
+
+    /** Number of posts rejected because all slots were pending
+     *
+     *  A non-zero count means the pool is undersized for the worst-case
+     *  number of outstanding deferrals, or dispatch is falling behind.
+     *
+     *  @return         Overflow count since construction
+     */
+    unsigned overflows() const
+    {
+        return _overflows;
+    }
+
+    /** Number of slots currently pending dispatch
+     *
+     *  @return         Pending slot count, approximate if posts race
+     */
+    unsigned pending() const
+    {
+        unsigned count = 0;
+        for (unsigned i = 0; i < N; i++) {
+            if (_slots[i].pending) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    /** Cancel all pending posts and release their slots
+     *
+     *  Must not be called concurrently with post(). If called while the
+     *  dispatch loop is active, a cancelled callback may already have
+     *  begun executing.
+     */
+    void cancel_all()
+    {
+        for (unsigned i = 0; i < N; i++) {
+            equeue_cancel_user_allocated(_equeue, &_slots[i].event);
+            _slots[i].pending = false;
+        }
+    }
+
+private:
+    struct slot_t {
+        // must stay first, event_call recovers the slot from the header
+        struct equeue_event event;
+        UserAllocatedEventPool *pool;
+        A arg;
+        volatile bool pending;
+    };
+
+    static void event_call(void *p)
+    {
+        slot_t *slot = reinterpret_cast<slot_t *>(
+                           reinterpret_cast<char *>(p) - sizeof(struct equeue_event));
+        UserAllocatedEventPool *pool = slot->pool;
+        // copy the payload out before releasing the slot - once pending
+        // is cleared an interrupt may reclaim and overwrite it
+        A arg = slot->arg;
+        slot->pending = false;
+        pool->_callback(arg);
+    }
+
+    slot_t _slots[N];
+    equeue_t *_equeue;
+    mbed::Callback<void(A)> _callback;
+    volatile unsigned _overflows;
+};
 }
 
 #endif
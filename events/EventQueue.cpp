@@ -16,6 +16,7 @@
  */
 #include "events/EventQueue.h"
 #include "events/mbed_events.h"
+#include "platform/mbed_itm_trace.h"
 
 using mbed::Callback;
 
@@ -30,6 +31,11 @@ EventQueue::EventQueue(unsigned event_size, unsigned char *event_pointer)
     }
 }
 
+EventQueue::EventQueue(const equeue_pool *pools, unsigned npools)
+{
+    equeue_create_pools(&_equeue, pools, npools);
+}
+
 EventQueue::~EventQueue()
 {
     equeue_destroy(&_equeue);
@@ -37,7 +43,20 @@ EventQueue::~EventQueue()
 
 void EventQueue::dispatch(int ms)
 {
-    return equeue_dispatch(&_equeue, ms);
+    mbed_itm_trace_event(MBED_ITM_TRACE_PORT_EQUEUE,
+                         MBED_ITM_TRACE_EQUEUE_DISPATCH_ENTER, (uint32_t)(uintptr_t)&_equeue);
+    equeue_dispatch(&_equeue, ms);
+    mbed_itm_trace_event(MBED_ITM_TRACE_PORT_EQUEUE,
+                         MBED_ITM_TRACE_EQUEUE_DISPATCH_EXIT, (uint32_t)(uintptr_t)&_equeue);
+}
+
+void EventQueue::dispatch_worker(unsigned dispatcher, int ms)
+{
+    mbed_itm_trace_event(MBED_ITM_TRACE_PORT_EQUEUE,
+                         MBED_ITM_TRACE_EQUEUE_DISPATCH_ENTER, (uint32_t)(uintptr_t)&_equeue);
+    equeue_dispatch_id(&_equeue, ms, dispatcher);
+    mbed_itm_trace_event(MBED_ITM_TRACE_PORT_EQUEUE,
+                         MBED_ITM_TRACE_EQUEUE_DISPATCH_EXIT, (uint32_t)(uintptr_t)&_equeue);
 }
 
 void EventQueue::break_dispatch()
@@ -79,4 +98,16 @@ int EventQueue::chain(EventQueue *target)
         return equeue_chain(&_equeue, 0);
     }
 }
+
+#if EQUEUE_INSTRUMENTATION
+bool EventQueue::get_stats(unsigned i, equeue_stat &stat)
+{
+    return equeue_stats_read(&_equeue, i, &stat);
+}
+
+void EventQueue::reset_stats()
+{
+    equeue_stats_reset(&_equeue);
+}
+#endif
 }
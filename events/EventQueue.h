@@ -43,6 +43,12 @@ namespace events {
 template <typename F>
 class Event;
 
+template <typename F>
+class UserAllocatedEvent;
+
+template <typename A, unsigned N>
+class UserAllocatedEventPool;
+
 
 /** EventQueue
  *
@@ -51,6 +57,20 @@ class Event;
  */
 class EventQueue : private mbed::NonCopyable<EventQueue> {
 public:
+    /** Priority bands for dispatch ordering
+     *
+     *  Within a dispatch batch, events in higher priority bands always run
+     *  first; order is preserved within a band. Every due event still runs
+     *  in its batch, so lower bands are delayed by at most one batch and
+     *  never starved. Events posted without an explicit priority run in
+     *  PRIORITY_NORMAL.
+     */
+    enum Priority {
+        PRIORITY_HIGH = 0,
+        PRIORITY_NORMAL = EQUEUE_PRIORITY_BANDS / 2,
+        PRIORITY_LOW = EQUEUE_PRIORITY_BANDS - 1
+    };
+
     /** Create an EventQueue
      *
      *  Create an event queue. The event queue either allocates a buffer of
@@ -63,6 +83,25 @@ public:
      */
     EventQueue(unsigned size = EVENTS_QUEUE_SIZE, unsigned char *buffer = NULL);
 
+    /** Create an EventQueue with static size-class pools
+     *
+     *  Create an event queue whose buffer is carved up front into fixed
+     *  slots of the given size classes (for example 16 x 32-byte and
+     *  4 x 96-byte slots). Allocation becomes a constant-time pop from the
+     *  smallest class that fits and slots are never split or merged, so
+     *  fragmentation is structurally impossible and the worst-case
+     *  capacity of each class is provable for the lifetime of the queue.
+     *  Events larger than the largest class always fail to allocate.
+     *
+     *  Class sizes are usable event sizes - the per-event overhead is
+     *  accounted for internally. EVENTS_EVENT_SIZE fits a plain
+     *  Callback<void()>.
+     *
+     *  @param pools    Array of size classes
+     *  @param npools   Number of size classes
+     */
+    EventQueue(const equeue_pool *pools, unsigned npools);
+
     /** Destroy an EventQueue
      */
     ~EventQueue();
@@ -95,6 +134,26 @@ public:
         dispatch();
     }
 
+    /** Dispatch events as one of several cooperating dispatcher threads
+     *
+     *  Behaves as EventQueue::dispatch, but identifies the calling thread
+     *  as the dispatcher with the given id,
+     *  0 <= dispatcher < EQUEUE_MAX_DISPATCHERS. Multiple threads may
+     *  dispatch the same queue concurrently, each pulling ready events from
+     *  the shared queue, so a long-running handler on one thread does not
+     *  delay independent events.
+     *
+     *  Events run on whichever dispatcher gets to them first unless pinned
+     *  to a dispatcher with equeue_event_affinity, useful for handlers that
+     *  touch non-thread-safe drivers.
+     *
+     *  @param dispatcher Id of the calling dispatcher thread
+     *  @param ms         Time to wait for events in milliseconds, a negative
+     *                    value will dispatch events indefinitely
+     *                    (default to -1)
+     */
+    void dispatch_worker(unsigned dispatcher, int ms = -1);
+
     /** Break out of a running event loop
      *
      *  Forces the specified event queue's dispatch loop to terminate. Pending
@@ -187,7 +246,35 @@ public:
      */
     int chain(EventQueue *target);
 
+#if EQUEUE_INSTRUMENTATION || defined(DOXYGEN_ONLY)
+    /** Read back per-callback dispatch statistics
+     *
+     *  Only available when the events.instrumentation config option is
+     *  enabled. Statistics are aggregated per distinct callback function
+     *  and record the dispatch count, cumulative and worst-case execution
+     *  time (microseconds, from the us ticker) and the worst-case delay
+     *  between an event falling due and its dispatch starting
+     *  (milliseconds), making it possible to identify which handler is
+     *  starving a shared queue without attaching a trace probe.
+     *
+     *  Iterate by counting i up from 0 until get_stats returns false.
+     *  Unused slots have a null cb member.
+     *
+     *  This function is IRQ safe.
+     *
+     *  @param i        Index of the statistics slot to read
+     *  @param stat     Filled in with a copy of the statistics slot
+     *  @return         true if the slot exists, false once i is past the
+     *                  end of the statistics table
+     */
+    bool get_stats(unsigned i, equeue_stat &stat);
 
+    /** Clear all gathered dispatch statistics
+     *
+     *  This function is IRQ safe.
+     */
+    void reset_stats();
+#endif
 
 #if defined(DOXYGEN_ONLY)
     /** Calls an event on the queue
@@ -357,6 +444,60 @@ public:
     // *INDENT-OFF*
     template <typename T, typename R, typename ...Args>
     int call_in(int ms, T *obj, R (T::*method)(Args ...args), Args ...args);
+
+    /** Calls an event on the queue in a specific priority band
+     *
+     *  The specified callback is executed in the context of the event
+     *  queue's dispatch loop, ordered against other due events by the
+     *  given priority band.
+     *
+     *  The call_priority function is IRQ safe and can act as a mechanism
+     *  for moving events out of IRQ contexts.
+     *
+     *  @param prio     Priority band to dispatch the callback in
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @param args     Arguments to pass to the callback
+     *  @return         A unique ID that represents the posted event and can
+     *                  be passed to cancel, or an ID of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F, typename ...Args>
+    int call_priority(Priority prio, F f, Args ...args);
+
+    /** Calls an event on the queue in a specific priority band after a
+     *  specified delay
+     *
+     *  @param ms       Time to delay in milliseconds
+     *  @param prio     Priority band to dispatch the callback in
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @param args     Arguments to pass to the callback
+     *  @return         A unique ID that represents the posted event and can
+     *                  be passed to cancel, or an ID of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F, typename ...Args>
+    int call_in_priority(int ms, Priority prio, F f, Args ...args);
+
+    /** Calls an event on the queue periodically with a coalescing window
+     *
+     *  Behaves as EventQueue::call_every, but each deadline may be deferred
+     *  by up to slack milliseconds to share a wakeup with another event
+     *  already scheduled in the window. Many periodic events with compatible
+     *  slack align into a single wakeup and dispatch batch, reducing
+     *  scheduler round-trips and letting the MCU sleep longer between
+     *  batches.
+     *
+     *  @param ms       Period of the event in milliseconds
+     *  @param slack    Milliseconds each deadline may be deferred to
+     *                  coalesce with other events
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @param args     Arguments to pass to the callback
+     *  @return         A unique ID that represents the posted event and can
+     *                  be passed to cancel, or an ID of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F, typename ...Args>
+    int call_every_slack(int ms, int slack, F f, Args ...args);
     // *INDENT-ON*
 
     /** Calls an event on the queue periodically
@@ -934,6 +1075,146 @@ public:
         return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
     }
 
+    /** Calls an event on the queue in a specific priority band
+     *
+     *  Within a dispatch batch, higher bands always drain first and order
+     *  is preserved within a band; every due event still runs in its
+     *  batch, so lower bands are never starved.
+     *
+     *  The call_priority function is IRQ safe and can act as a mechanism
+     *  for moving events out of IRQ contexts.
+     *
+     *  @param prio     Priority band to dispatch the callback in
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F>
+    int call_priority(Priority prio, F f)
+    {
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
+
+        F *e = new (p) F(f);
+        equeue_event_priority(e, prio);
+        equeue_event_dtor(e, &EventQueue::function_dtor<F>);
+        return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
+    }
+
+    /** Calls an event on the queue in a specific priority band
+     *  @see                    EventQueue::call_priority
+     *  @param prio             Priority band to dispatch the callback in
+     *  @param f                Function to execute in the context of the dispatch loop
+     *  @param a0               Argument to pass to the callback
+     */
+    template <typename F, typename A0>
+    int call_priority(Priority prio, F f, A0 a0)
+    {
+        return call_priority(prio, context10<F, A0>(f, a0));
+    }
+
+    /** Calls an event on the queue in a specific priority band
+     *  @see                    EventQueue::call_priority
+     *  @param prio             Priority band to dispatch the callback in
+     *  @param f                Function to execute in the context of the dispatch loop
+     *  @param a0,a1            Arguments to pass to the callback
+     */
+    template <typename F, typename A0, typename A1>
+    int call_priority(Priority prio, F f, A0 a0, A1 a1)
+    {
+        return call_priority(prio, context20<F, A0, A1>(f, a0, a1));
+    }
+
+    /** Calls an event on the queue in a specific priority band
+     *  @see                    EventQueue::call_priority
+     *  @param prio             Priority band to dispatch the callback in
+     *  @param f                Function to execute in the context of the dispatch loop
+     *  @param a0,a1,a2         Arguments to pass to the callback
+     */
+    template <typename F, typename A0, typename A1, typename A2>
+    int call_priority(Priority prio, F f, A0 a0, A1 a1, A2 a2)
+    {
+        return call_priority(prio, context30<F, A0, A1, A2>(f, a0, a1, a2));
+    }
+
+    /** Calls an event on the queue in a specific priority band
+     *  @see EventQueue::call_priority
+     */
+    template <typename T, typename R>
+    int call_priority(Priority prio, T *obj, R(T::*method)())
+    {
+        return call_priority(prio, mbed::callback(obj, method));
+    }
+
+    /** Calls an event on the queue in a specific priority band after a
+     *  specified delay
+     *
+     *  The call_in_priority function is IRQ safe and can act as a
+     *  mechanism for moving events out of IRQ contexts.
+     *
+     *  @param ms       Time to delay in milliseconds
+     *  @param prio     Priority band to dispatch the callback in
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F>
+    int call_in_priority(int ms, Priority prio, F f)
+    {
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
+
+        F *e = new (p) F(f);
+        equeue_event_delay(e, ms);
+        equeue_event_priority(e, prio);
+        equeue_event_dtor(e, &EventQueue::function_dtor<F>);
+        return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
+    }
+
+    /** Calls an event on the queue in a specific priority band after a
+     *  specified delay
+     *  @see                    EventQueue::call_in_priority
+     *  @param ms               Time to delay in milliseconds
+     *  @param prio             Priority band to dispatch the callback in
+     *  @param f                Function to execute in the context of the dispatch loop
+     *  @param a0               Argument to pass to the callback
+     */
+    template <typename F, typename A0>
+    int call_in_priority(int ms, Priority prio, F f, A0 a0)
+    {
+        return call_in_priority(ms, prio, context10<F, A0>(f, a0));
+    }
+
+    /** Calls an event on the queue in a specific priority band after a
+     *  specified delay
+     *  @see                    EventQueue::call_in_priority
+     *  @param ms               Time to delay in milliseconds
+     *  @param prio             Priority band to dispatch the callback in
+     *  @param f                Function to execute in the context of the dispatch loop
+     *  @param a0,a1            Arguments to pass to the callback
+     */
+    template <typename F, typename A0, typename A1>
+    int call_in_priority(int ms, Priority prio, F f, A0 a0, A1 a1)
+    {
+        return call_in_priority(ms, prio, context20<F, A0, A1>(f, a0, a1));
+    }
+
+    /** Calls an event on the queue in a specific priority band after a
+     *  specified delay
+     *  @see EventQueue::call_in_priority
+     */
+    template <typename T, typename R>
+    int call_in_priority(int ms, Priority prio, T *obj, R(T::*method)())
+    {
+        return call_in_priority(ms, prio, mbed::callback(obj, method));
+    }
+
     /** Calls an event on the queue after a specified delay
      *  @see                        EventQueue::call_in
      *  @param ms                   Time to delay in milliseconds
@@ -1302,6 +1583,77 @@ public:
         return call_every(ms, context50<F, A0, A1, A2, A3, A4>(f, a0, a1, a2, a3, a4));
     }
 
+    /** Calls an event on the queue periodically with a coalescing window
+     *
+     *  Behaves as EventQueue::call_every, but each deadline may be deferred
+     *  by up to slack milliseconds to share a wakeup with another event
+     *  already scheduled in the window. Many periodic events with compatible
+     *  slack align into a single wakeup and dispatch batch, reducing
+     *  scheduler round-trips and letting the MCU sleep longer between
+     *  batches.
+     *
+     *  The call_every_slack function is IRQ safe and can act as a mechanism
+     *  for moving events out of IRQ contexts.
+     *
+     *  @param ms       Period of the event in milliseconds
+     *  @param slack    Milliseconds each deadline may be deferred to
+     *                  coalesce with other events
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F>
+    int call_every_slack(int ms, int slack, F f)
+    {
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
+
+        F *e = new (p) F(f);
+        equeue_event_delay(e, ms);
+        equeue_event_period(e, ms);
+        equeue_event_slack(e, slack);
+        equeue_event_dtor(e, &EventQueue::function_dtor<F>);
+        return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
+    }
+
+    /** Calls an event on the queue periodically with a coalescing window
+     *  @see                    EventQueue::call_every_slack
+     *  @param ms               Period of the event in milliseconds
+     *  @param slack            Milliseconds each deadline may be deferred
+     *  @param f                Function to execute in the context of the dispatch loop
+     *  @param a0               Argument to pass to the callback
+     */
+    template <typename F, typename A0>
+    int call_every_slack(int ms, int slack, F f, A0 a0)
+    {
+        return call_every_slack(ms, slack, context10<F, A0>(f, a0));
+    }
+
+    /** Calls an event on the queue periodically with a coalescing window
+     *  @see                    EventQueue::call_every_slack
+     *  @param ms               Period of the event in milliseconds
+     *  @param slack            Milliseconds each deadline may be deferred
+     *  @param f                Function to execute in the context of the dispatch loop
+     *  @param a0,a1            Arguments to pass to the callback
+     */
+    template <typename F, typename A0, typename A1>
+    int call_every_slack(int ms, int slack, F f, A0 a0, A1 a1)
+    {
+        return call_every_slack(ms, slack, context20<F, A0, A1>(f, a0, a1));
+    }
+
+    /** Calls an event on the queue periodically with a coalescing window
+     *  @see EventQueue::call_every_slack
+     */
+    template <typename T, typename R>
+    int call_every_slack(int ms, int slack, T *obj, R(T::*method)())
+    {
+        return call_every_slack(ms, slack, mbed::callback(obj, method));
+    }
+
     /** Calls an event on the queue periodically
      *  @see EventQueue::call_every
      */
@@ -2825,6 +3177,10 @@ protected:
 #if !defined(DOXYGEN_ONLY)
     template <typename F>
     friend class Event;
+    template <typename F>
+    friend class UserAllocatedEvent;
+    template <typename A, unsigned N>
+    friend class UserAllocatedEventPool;
     struct equeue _equeue;
     mbed::Callback<void(int)> _update;
 
@@ -0,0 +1,72 @@
+/* events
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "events/Tasklet.h"
+#include "events/mbed_shared_queues.h"
+
+namespace events {
+
+Tasklet::Tasklet(EventQueue *queue): _queue(queue), _pending(0)
+{
+    if (_queue == NULL) {
+        _queue = mbed::mbed_event_queue();
+    }
+}
+
+Tasklet::~Tasklet()
+{
+    stop();
+}
+
+void Tasklet::start()
+{
+    if (_pending == 0) {
+        _pending = _queue->call(&Tasklet::thunk, this);
+    }
+}
+
+void Tasklet::stop()
+{
+    if (_pending != 0) {
+        _queue->cancel(_pending);
+        _pending = 0;
+    }
+}
+
+bool Tasklet::running() const
+{
+    return _pending != 0;
+}
+
+void Tasklet::yield()
+{
+    _pending = _queue->call(&Tasklet::thunk, this);
+}
+
+void Tasklet::yield_for(int ms)
+{
+    _pending = _queue->call_in(ms, &Tasklet::thunk, this);
+}
+
+void Tasklet::thunk(Tasklet *self)
+{
+    // The step runs to completion on the dispatch thread - clear the
+    // pending id first so the step can schedule its successor
+    self->_pending = 0;
+    self->step();
+}
+
+}
@@ -0,0 +1,110 @@
+/* events
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TASKLET_H
+#define TASKLET_H
+
+#include "events/EventQueue.h"
+#include "platform/NonCopyable.h"
+
+namespace events {
+/** \addtogroup events */
+
+/** Tasklet
+ *
+ *  A stackless run-to-completion task dispatched on an EventQueue.
+ *
+ *  Every rtos::Thread costs a dedicated stack even while it sits idle, which
+ *  adds up quickly for a device full of mostly-idle state machines. A Tasklet
+ *  instead runs its step function to completion on an event queue's dispatch
+ *  thread - the shared event queue by default - so any number of cooperative
+ *  state machines share one stack.
+ *
+ *  A step must not block; instead it updates the tasklet's state and calls
+ *  yield (run again after other pending events) or yield_for (run again
+ *  after a delay). When step returns without yielding, the tasklet stops
+ *  until it is started again.
+ *
+ *  @code
+ *  class Blinker : public events::Tasklet {
+ *      virtual void step() {
+ *          led = !led;
+ *          yield_for(500);
+ *      }
+ *  };
+ *  @endcode
+ * @ingroup events
+ */
+class Tasklet : private mbed::NonCopyable<Tasklet> {
+public:
+    /** Create a tasklet
+     *
+     *  @param queue    Event queue to dispatch on, or NULL to use the
+     *                  shared event queue
+     */
+    Tasklet(EventQueue *queue = NULL);
+
+    /** Destroy the tasklet, cancelling any pending step
+     */
+    virtual ~Tasklet();
+
+    /** Schedule the first step
+     *
+     *  Does nothing if a step is already pending.
+     *
+     *  @note This function may be called from interrupt context, provided
+     *        the queue was created in threaded context beforehand.
+     */
+    void start();
+
+    /** Cancel the pending step, if any
+     *
+     *  A step that is currently executing runs to completion.
+     */
+    void stop();
+
+    /** Check whether a step is scheduled
+     *
+     *  @return true if a step is pending on the queue
+     */
+    bool running() const;
+
+protected:
+    /** One run-to-completion step of the state machine
+     *
+     *  Must not block - call yield or yield_for to continue later.
+     */
+    virtual void step() = 0;
+
+    /** Schedule the next step behind the events already queued
+     */
+    void yield();
+
+    /** Schedule the next step after a delay
+     *
+     *  @param ms       Delay before the next step in milliseconds
+     */
+    void yield_for(int ms);
+
+private:
+    static void thunk(Tasklet *self);
+
+    EventQueue *_queue;
+    int _pending;
+};
+
+}
+#endif
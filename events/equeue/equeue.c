@@ -16,7 +16,9 @@
  * limitations under the License.
  */
 #include "equeue/equeue.h"
+#ifdef TARGET_SIMULATOR
 #include "mbed_wait_api.h"
+#endif
 
 #include <stdlib.h>
 #include <string.h>
@@ -47,6 +49,18 @@ static inline void equeue_incid(equeue_t *q, struct equeue_event *e)
 }
 
 
+// chunk allocation functions, defined below
+static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size);
+static void equeue_mem_dealloc(equeue_t *q, struct equeue_event *e);
+
+// the in-memory footprint of a chunk serving allocations of the given size
+static inline size_t equeue_chunk_size(size_t size)
+{
+    size += sizeof(struct equeue_event);
+    return (size + sizeof(void *) -1) & ~(sizeof(void *) -1);
+}
+
+
 // equeue lifetime management
 int equeue_create(equeue_t *q, size_t size)
 {
@@ -75,9 +89,18 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer)
     q->chunks = 0;
     q->slab.size = size;
     q->slab.data = buffer;
+    q->alloc_failures = 0;
 
     q->queue = 0;
+    q->posted = 0;
+    q->pinned = 0;
+    q->pinned_tail = &q->pinned;
+    for (unsigned i = 0; i < EQUEUE_WHEEL_SLOTS; i++) {
+        q->wheel[i] = 0;
+    }
+    q->wheel_count = 0;
     q->tick = equeue_tick();
+    q->wheel_tick = q->tick;
     q->generation = 0;
     q->break_requested = false;
 
@@ -85,13 +108,21 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer)
     q->background.update = 0;
     q->background.timer = 0;
 
+#ifdef TARGET_SIMULATOR
     q->dispatch_called = false;
+#endif
+
+#if EQUEUE_INSTRUMENTATION
+    memset(q->stats, 0, sizeof(q->stats));
+#endif
 
     // initialize platform resources
     int err;
-    err = equeue_sema_create(&q->eventsema);
-    if (err < 0) {
-        return err;
+    for (unsigned i = 0; i < EQUEUE_MAX_DISPATCHERS; i++) {
+        err = equeue_sema_create(&q->eventsema[i]);
+        if (err < 0) {
+            return err;
+        }
     }
 
     err = equeue_mutex_create(&q->queuelock);
@@ -107,8 +138,84 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer)
     return 0;
 }
 
+int equeue_create_pools(equeue_t *q,
+                        const struct equeue_pool *pools, unsigned npools)
+{
+    // exactly enough buffer for every slot of every class
+    size_t size = 0;
+    for (unsigned i = 0; i < npools; i++) {
+        size += pools[i].count * equeue_chunk_size(pools[i].size);
+    }
+
+    void *buffer = malloc(size);
+    if (!buffer) {
+        return -1;
+    }
+
+    int err = equeue_create_pools_inplace(q, size, buffer, pools, npools);
+    q->allocated = buffer;
+    return err;
+}
+
+int equeue_create_pools_inplace(equeue_t *q, size_t size, void *buffer,
+                                const struct equeue_pool *pools, unsigned npools)
+{
+    int err = equeue_create_inplace(q, size, buffer);
+    if (err < 0) {
+        return err;
+    }
+
+    // carve the buffer into the requested size-class slots up front,
+    // collecting the slots before freeing them so later carves of the same
+    // class don't just recycle the slots carved so far
+    struct equeue_event *carved = 0;
+    for (unsigned i = 0; i < npools; i++) {
+        for (size_t j = 0; j < pools[i].count; j++) {
+            struct equeue_event *e = equeue_mem_alloc(q, pools[i].size);
+            if (!e) {
+                return -1;
+            }
+
+            e->next = carved;
+            carved = e;
+        }
+    }
+
+    while (carved) {
+        struct equeue_event *e = carved;
+        carved = e->next;
+        equeue_mem_dealloc(q, e);
+    }
+
+    // the slab serves no further allocations, every alloc is now a
+    // constant-time pop from its class's free list
+    q->slab.size = 0;
+
+    return 0;
+}
+
 void equeue_destroy(equeue_t *q)
 {
+    // call destructors on events still waiting on the irq post list
+    for (struct equeue_event *e = q->posted; e; e = e->next) {
+        if (e->dtor) {
+            e->dtor(e + 1);
+        }
+    }
+    // call destructors on events parked for another dispatcher
+    for (struct equeue_event *e = q->pinned; e; e = e->next) {
+        if (e->dtor) {
+            e->dtor(e + 1);
+        }
+    }
+    // call destructors on events still waiting in the timer wheel
+    for (unsigned i = 0; i < EQUEUE_WHEEL_SLOTS; i++) {
+        for (struct equeue_event *e = q->wheel[i]; e; e = e->next) {
+            if (e->dtor) {
+                e->dtor(e + 1);
+            }
+        }
+    }
     // call destructors on pending events
     for (struct equeue_event *es = q->queue; es; es = es->next) {
         for (struct equeue_event *e = es->sibling; e; e = e->sibling) {
@@ -128,7 +235,9 @@ void equeue_destroy(equeue_t *q)
     // clean up platform resources + memory
     equeue_mutex_destroy(&q->memlock);
     equeue_mutex_destroy(&q->queuelock);
-    equeue_sema_destroy(&q->eventsema);
+    for (unsigned i = 0; i < EQUEUE_MAX_DISPATCHERS; i++) {
+        equeue_sema_destroy(&q->eventsema[i]);
+    }
     free(q->allocated);
 }
 
@@ -145,8 +254,7 @@ static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size)
     }
 #endif
     // add event overhead
-    size += sizeof(struct equeue_event);
-    size = (size + sizeof(void *) -1) & ~(sizeof(void *) -1);
+    size = equeue_chunk_size(size);
 
     equeue_mutex_lock(&q->memlock);
 
@@ -178,10 +286,16 @@ static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size)
         return e;
     }
 
+    q->alloc_failures += 1;
     equeue_mutex_unlock(&q->memlock);
     return 0;
 }
 
+unsigned equeue_alloc_failures(equeue_t *q)
+{
+    return q->alloc_failures;
+}
+
 static void equeue_mem_dealloc(equeue_t *q, struct equeue_event *e)
 {
     equeue_mutex_lock(&q->memlock);
@@ -213,7 +327,10 @@ void *equeue_alloc(equeue_t *q, size_t size)
 
     e->target = 0;
     e->period = -1;
+    e->slack = 0;
     e->dtor = 0;
+    e->priority = EQUEUE_PRIORITY_BANDS / 2;
+    e->affinity = 0;
 
     return e + 1;
 }
@@ -231,15 +348,32 @@ void equeue_dealloc(equeue_t *q, void *p)
 
 
 // equeue scheduling functions
-static int equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick)
+#define EQUEUE_WHEEL_SLICE (1u << EQUEUE_WHEEL_SHIFT)
+
+// defer an event by up to its slack to share a wakeup with an event
+// already scheduled in the window, must be called with the queuelock held
+static void equeue_coalesce(equeue_t *q, struct equeue_event *e)
 {
-    // setup event and hash local id with buffer offset for unique id
-    int id = (e->id << q->npw2) | ((unsigned char *)e - q->buffer);
-    e->target = tick + equeue_clampdiff(e->target, tick);
-    e->generation = q->generation;
+    if (e->slack <= 0) {
+        return;
+    }
 
-    equeue_mutex_lock(&q->queuelock);
+    for (struct equeue_event *c = q->queue; c; c = c->next) {
+        int diff = equeue_tickdiff(c->target, e->target);
+        if (diff > e->slack) {
+            break;
+        }
+        if (diff >= 0) {
+            e->target = c->target;
+            break;
+        }
+    }
+}
 
+// insert an event into the sorted pending queue, must be called with
+// the queuelock held
+static void equeue_queue_insert(equeue_t *q, struct equeue_event *e)
+{
     // find the event slot
     struct equeue_event **p = &q->queue;
     while (*p && equeue_tickdiff((*p)->target, e->target) < 0) {
@@ -266,19 +400,163 @@ static int equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick)
 
     *p = e;
     e->ref = p;
+}
 
-    // notify background timer
-    if ((q->background.update && q->background.active) &&
-            (q->queue == e && !e->sibling)) {
-        q->background.update(q->background.timer,
-                             equeue_clampdiff(e->target, tick));
+// insert an event into its timer wheel slot, must be called with
+// the queuelock held
+static void equeue_wheel_insert(equeue_t *q, struct equeue_event *e)
+{
+    struct equeue_event **p =
+            &q->wheel[(e->target >> EQUEUE_WHEEL_SHIFT) & (EQUEUE_WHEEL_SLOTS - 1)];
+
+    e->next = *p;
+    if (e->next) {
+        e->next->ref = &e->next;
     }
+    e->sibling = 0;
+
+    *p = e;
+    e->ref = p;
+    e->wheel = true;
+    q->wheel_count += 1;
+}
 
+// delay until something needs the dispatch loop's attention, or -1 if
+// nothing is scheduled, must be called with the queuelock held
+static int equeue_scheduled_delay(equeue_t *q, unsigned tick)
+{
+    int delay = -1;
+    if (q->queue) {
+        delay = equeue_clampdiff(q->queue->target, tick);
+    }
+    if (q->wheel_count) {
+        // wake at the next wheel slice boundary to cascade far events
+        int boundary = (int)(EQUEUE_WHEEL_SLICE - (tick & (EQUEUE_WHEEL_SLICE - 1)));
+        if (delay < 0 || boundary < delay) {
+            delay = boundary;
+        }
+    }
+    return delay;
+}
+
+// move far events whose slice has come up out of the timer wheel and
+// into the sorted queue, must be called with the queuelock held
+static void equeue_wheel_cascade(equeue_t *q, unsigned tick)
+{
+    unsigned from = q->wheel_tick >> EQUEUE_WHEEL_SHIFT;
+    unsigned to = tick >> EQUEUE_WHEEL_SHIFT;
+    q->wheel_tick = tick;
+
+    if (!q->wheel_count || from == to) {
+        return;
+    }
+
+    // one full revolution visits every slot
+    if (to - from > EQUEUE_WHEEL_SLOTS) {
+        from = to - EQUEUE_WHEEL_SLOTS;
+    }
+
+    for (unsigned s = from + 1; equeue_tickdiff(to, s) >= 0; s++) {
+        struct equeue_event **p = &q->wheel[s & (EQUEUE_WHEEL_SLOTS - 1)];
+        while (*p) {
+            struct equeue_event *e = *p;
+
+            // events a revolution or more out stay for a later pass
+            if (equeue_tickdiff(e->target, tick) >= (int)(2 * EQUEUE_WHEEL_SLICE)) {
+                p = &e->next;
+                continue;
+            }
+
+            *p = e->next;
+            if (e->next) {
+                e->next->ref = p;
+            }
+            e->wheel = false;
+            q->wheel_count -= 1;
+
+            equeue_coalesce(q, e);
+            equeue_queue_insert(q, e);
+        }
+    }
+}
+
+// schedule an event into the timer wheel or sorted queue and notify the
+// background timer, must be called with the queuelock held
+static void equeue_schedule(equeue_t *q, struct equeue_event *e, unsigned tick)
+{
+    e->target = tick + equeue_clampdiff(e->target, tick);
+    e->generation = q->generation;
+    e->wheel = false;
+
+    if (equeue_tickdiff(e->target, tick) >= (int)(2 * EQUEUE_WHEEL_SLICE)) {
+        // far-out events take the constant-time timer wheel path and are
+        // only sorted into the queue once their slice comes up
+        equeue_wheel_insert(q, e);
+
+        // make sure a background timer is armed to cascade the wheel
+        if ((q->background.update && q->background.active) &&
+                q->wheel_count == 1) {
+            q->background.update(q->background.timer,
+                                 equeue_scheduled_delay(q, tick));
+        }
+    } else {
+        equeue_coalesce(q, e);
+        equeue_queue_insert(q, e);
+
+        // notify background timer
+        if ((q->background.update && q->background.active) &&
+                (q->queue == e && !e->sibling)) {
+            q->background.update(q->background.timer,
+                                 equeue_scheduled_delay(q, tick));
+        }
+    }
+}
+
+static int equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick)
+{
+    // hash local id with buffer offset for unique id
+    int id = (e->id << q->npw2) | ((unsigned char *)e - q->buffer);
+
+    equeue_mutex_lock(&q->queuelock);
+    equeue_schedule(q, e, tick);
     equeue_mutex_unlock(&q->queuelock);
 
     return id;
 }
 
+// unlink an event from the sorted queue or timer wheel, must be called
+// with the queuelock held
+static void equeue_queue_remove(equeue_t *q, struct equeue_event *e)
+{
+    if (e->sibling) {
+        e->sibling->next = e->next;
+        if (e->sibling->next) {
+            e->sibling->next->ref = &e->sibling->next;
+        }
+
+        *e->ref = e->sibling;
+        e->sibling->ref = e->ref;
+    } else {
+        *e->ref = e->next;
+        if (e->next) {
+            e->next->ref = e->ref;
+        }
+    }
+
+    if (e->wheel) {
+        e->wheel = false;
+        q->wheel_count -= 1;
+    }
+}
+
+// wake every dispatcher of the queue
+static void equeue_signal(equeue_t *q)
+{
+    for (unsigned i = 0; i < EQUEUE_MAX_DISPATCHERS; i++) {
+        equeue_sema_signal(&q->eventsema[i]);
+    }
+}
+
 static struct equeue_event *equeue_unqueue(equeue_t *q, int id)
 {
     // decode event from unique id and check that the local id matches
@@ -295,6 +573,14 @@ static struct equeue_event *equeue_unqueue(equeue_t *q, int id)
     e->cb = 0;
     e->period = -1;
 
+    // events on the irq post list are not linked into the queue yet, so
+    // they cannot be disentangled here - clearing the callback above is
+    // enough, the dispatch loop reclaims the memory when it drains the list
+    if (!e->ref) {
+        equeue_mutex_unlock(&q->queuelock);
+        return 0;
+    }
+
     int diff = equeue_tickdiff(e->target, q->tick);
     if (diff < 0 || (diff == 0 && e->generation != q->generation)) {
         equeue_mutex_unlock(&q->queuelock);
@@ -302,20 +588,7 @@ static struct equeue_event *equeue_unqueue(equeue_t *q, int id)
     }
 
     // disentangle from queue
-    if (e->sibling) {
-        e->sibling->next = e->next;
-        if (e->sibling->next) {
-            e->sibling->next->ref = &e->sibling->next;
-        }
-
-        *e->ref = e->sibling;
-        e->sibling->ref = e->ref;
-    } else {
-        *e->ref = e->next;
-        if (e->next) {
-            e->next->ref = e->ref;
-        }
-    }
+    equeue_queue_remove(q, e);
 
     equeue_incid(q, e);
     equeue_mutex_unlock(&q->queuelock);
@@ -323,10 +596,34 @@ static struct equeue_event *equeue_unqueue(equeue_t *q, int id)
     return e;
 }
 
-static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target)
+static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target,
+                                           unsigned affinity)
 {
     equeue_mutex_lock(&q->queuelock);
 
+    // first claim events another dispatcher parked for us, they fell due
+    // before the current batch so they dispatch ahead of it
+    struct equeue_event *claimed = 0;
+    struct equeue_event **ctail = &claimed;
+    for (struct equeue_event **p = &q->pinned; *p;) {
+        struct equeue_event *e = *p;
+        if (e->affinity == affinity) {
+            *p = e->next;
+            if (q->pinned_tail == &e->next) {
+                q->pinned_tail = p;
+            }
+
+            e->next = 0;
+            *ctail = e;
+            ctail = &e->next;
+        } else {
+            p = &e->next;
+        }
+    }
+
+    // bring due timer wheel events into the sorted queue first
+    equeue_wheel_cascade(q, target);
+
     // find all expired events and mark a new generation
     q->generation += 1;
     if (equeue_tickdiff(q->tick, target) <= 0) {
@@ -365,7 +662,99 @@ static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target)
         tail = &es->next;
     }
 
-    return head;
+    // drain higher priority bands first, keeping order within a band;
+    // every event in the batch still dispatches, so lower bands are
+    // delayed by at most one batch and never starved
+    struct equeue_event *bands[EQUEUE_PRIORITY_BANDS] = {0};
+    struct equeue_event **btails[EQUEUE_PRIORITY_BANDS];
+    for (unsigned b = 0; b < EQUEUE_PRIORITY_BANDS; b++) {
+        btails[b] = &bands[b];
+    }
+
+    for (struct equeue_event *e = head; e;) {
+        struct equeue_event *next = e->next;
+        *btails[e->priority] = e;
+        btails[e->priority] = &e->next;
+        e = next;
+    }
+
+    struct equeue_event **btail = &head;
+    for (unsigned b = 0; b < EQUEUE_PRIORITY_BANDS; b++) {
+        if (bands[b]) {
+            *btail = bands[b];
+            btail = btails[b];
+        }
+    }
+    *btail = 0;
+
+#if EQUEUE_MAX_DISPATCHERS > 1
+    // park events pinned to another dispatcher and wake their owners
+    struct equeue_event *parked = 0;
+    struct equeue_event **ptail = &parked;
+    unsigned wake = 0;
+
+    for (struct equeue_event **p = &head; *p;) {
+        struct equeue_event *e = *p;
+        if (e->affinity && e->affinity != affinity) {
+            *p = e->next;
+
+            e->next = 0;
+            *ptail = e;
+            ptail = &e->next;
+            wake |= 1u << (e->affinity - 1);
+        } else {
+            p = &e->next;
+        }
+    }
+
+    if (parked) {
+        equeue_mutex_lock(&q->queuelock);
+        *q->pinned_tail = parked;
+        q->pinned_tail = ptail;
+        equeue_mutex_unlock(&q->queuelock);
+
+        for (unsigned i = 0; i < EQUEUE_MAX_DISPATCHERS; i++) {
+            if (wake & (1u << i)) {
+                equeue_sema_signal(&q->eventsema[i]);
+            }
+        }
+    }
+#endif
+
+    // claimed events were due first
+    *ctail = head;
+    return claimed;
+}
+
+// sort the lock-free irq post list into the queue, must only be called
+// from the dispatching thread
+static void equeue_drain_posted(equeue_t *q)
+{
+    if (!q->posted) {
+        return;
+    }
+
+    // atomically take ownership of the whole list
+    struct equeue_event *es;
+    do {
+        es = q->posted;
+    } while (!equeue_atomic_cas_ptr((void *volatile *)&q->posted, es, 0));
+
+    // the list is pushed in lifo order, reverse it so events with the same
+    // target keep their posting order
+    struct equeue_event *prev = 0;
+    while (es) {
+        struct equeue_event *e = es;
+        es = e->next;
+        e->next = prev;
+        prev = e;
+    }
+
+    while (prev) {
+        struct equeue_event *e = prev;
+        prev = e->next;
+        equeue_enqueue(q, e, equeue_tick());
+    }
 }
 
 int equeue_post(equeue_t *q, void (*cb)(void *), void *p)
@@ -376,10 +765,96 @@ int equeue_post(equeue_t *q, void (*cb)(void *), void *p)
     e->target = tick + e->target;
 
     int id = equeue_enqueue(q, e, tick);
-    equeue_sema_signal(&q->eventsema);
+    equeue_signal(q);
+    return id;
+}
+
+int equeue_post_irq(equeue_t *q, void (*cb)(void *), void *p)
+{
+    struct equeue_event *e = (struct equeue_event *)p - 1;
+    unsigned tick = equeue_tick();
+    e->cb = cb;
+    e->target = tick + e->target;
+
+    // the id can be computed without touching the queue
+    int id = (e->id << q->npw2) | ((unsigned char *)e - q->buffer);
+
+    // a backgrounded queue has no dispatch loop to drain the list, fall
+    // back to the locked path so the background timer gets updated
+    if (q->background.active) {
+        equeue_enqueue(q, e, tick);
+        equeue_signal(q);
+        return id;
+    }
+
+    // null ref marks the event as awaiting drain for equeue_cancel
+    e->ref = 0;
+
+    // push onto the mpsc list with a single cas
+    struct equeue_event *next;
+    do {
+        next = q->posted;
+        e->next = next;
+    } while (!equeue_atomic_cas_ptr((void *volatile *)&q->posted, next, e));
+
+    equeue_signal(q);
     return id;
 }
 
+void equeue_post_user_allocated(equeue_t *q, void (*cb)(void *), void *p,
+                                int ms, int period)
+{
+    struct equeue_event *e = (struct equeue_event *)p;
+    unsigned tick = equeue_tick();
+
+    equeue_mutex_lock(&q->queuelock);
+
+    // a post while the event is already pending coalesces into the
+    // earlier post
+    if (e->id) {
+        equeue_mutex_unlock(&q->queuelock);
+        return;
+    }
+
+    // a zero size marks the event as caller-owned, dispatch and cancel
+    // leave its memory alone
+    e->id = 1;
+    e->size = 0;
+    e->cb = cb;
+    e->target = tick + ((ms > 0) ? (unsigned)ms : 0);
+    e->period = period;
+
+    equeue_schedule(q, e, tick);
+    equeue_mutex_unlock(&q->queuelock);
+
+    equeue_signal(q);
+}
+
+void equeue_cancel_user_allocated(equeue_t *q, void *p)
+{
+    struct equeue_event *e = (struct equeue_event *)p;
+
+    equeue_mutex_lock(&q->queuelock);
+    if (!e->id) {
+        equeue_mutex_unlock(&q->queuelock);
+        return;
+    }
+
+    // clear the event and check if already in-flight
+    e->cb = 0;
+    e->period = -1;
+
+    int diff = equeue_tickdiff(e->target, q->tick);
+    if (diff < 0 || (diff == 0 && e->generation != q->generation)) {
+        equeue_mutex_unlock(&q->queuelock);
+        return;
+    }
+
+    equeue_queue_remove(q, e);
+    e->id = 0;
+    equeue_mutex_unlock(&q->queuelock);
+}
+
 void equeue_cancel(equeue_t *q, int id)
 {
     if (!id) {
@@ -417,10 +892,77 @@ void equeue_break(equeue_t *q)
     equeue_mutex_lock(&q->queuelock);
     q->break_requested = true;
     equeue_mutex_unlock(&q->queuelock);
-    equeue_sema_signal(&q->eventsema);
+    equeue_signal(q);
 }
 
-void equeue_dispatch(equeue_t *q, int ms)
+// simple callbacks
+struct ecallback {
+    void (*cb)(void *);
+    void *data;
+};
+
+static void ecallback_dispatch(void *p)
+{
+    struct ecallback *e = (struct ecallback *)p;
+    e->cb(e->data);
+}
+
+#if EQUEUE_INSTRUMENTATION
+// record one dispatch against the callback's statistics slot
+static void equeue_stats_record(equeue_t *q, void (*cb)(void *),
+                                unsigned execution, unsigned latency)
+{
+    equeue_mutex_lock(&q->queuelock);
+
+    struct equeue_stat *slot = 0;
+    for (unsigned i = 0; i < EQUEUE_STATS_ENTRIES; i++) {
+        if (q->stats[i].cb == cb) {
+            slot = &q->stats[i];
+            break;
+        }
+        if (!slot && !q->stats[i].cb) {
+            slot = &q->stats[i];
+        }
+    }
+
+    // table full, additional callbacks go untracked
+    if (slot) {
+        slot->cb = cb;
+        slot->dispatched += 1;
+        slot->execution_us += execution;
+        if (execution > slot->max_execution_us) {
+            slot->max_execution_us = execution;
+        }
+        if (latency > slot->max_latency) {
+            slot->max_latency = latency;
+        }
+    }
+
+    equeue_mutex_unlock(&q->queuelock);
+}
+
+bool equeue_stats_read(equeue_t *q, unsigned i, struct equeue_stat *stat)
+{
+    if (i >= EQUEUE_STATS_ENTRIES) {
+        return false;
+    }
+
+    equeue_mutex_lock(&q->queuelock);
+    *stat = q->stats[i];
+    equeue_mutex_unlock(&q->queuelock);
+    return true;
+}
+
+void equeue_stats_reset(equeue_t *q)
+{
+    equeue_mutex_lock(&q->queuelock);
+    memset(q->stats, 0, sizeof(q->stats));
+    equeue_mutex_unlock(&q->queuelock);
+}
+#endif
+
+EQUEUE_RAM_FUNC
+void equeue_dispatch_id(equeue_t *q, int ms, unsigned id)
 {
 #ifdef TARGET_SIMULATOR
     if (!q->dispatch_called) {
@@ -433,8 +975,11 @@ void equeue_dispatch(equeue_t *q, int ms)
     q->background.active = false;
 
     while (1) {
+        // sort in events posted from interrupts via the lock-free path
+        equeue_drain_posted(q);
+
         // collect all the available events and next deadline
-        struct equeue_event *es = equeue_dequeue(q, tick);
+        struct equeue_event *es = equeue_dequeue(q, tick, id + 1);
 
         // dispatch events
         while (es) {
@@ -443,15 +988,45 @@ void equeue_dispatch(equeue_t *q, int ms)
 
             // actually dispatch the callbacks
             void (*cb)(void *) = e->cb;
+
+            // completed one-shot user-allocated events are marked free
+            // before their callback runs so they can be reposted from the
+            // callback itself or an interrupt
+            bool user_allocated = (e->size == 0);
+            if (user_allocated && e->period < 0) {
+                e->id = 0;
+            }
+
             if (cb) {
+#if EQUEUE_INSTRUMENTATION
+                // attribute equeue_call events to the wrapped callback
+                void (*stat_cb)(void *) = cb;
+                if (cb == ecallback_dispatch) {
+                    stat_cb = ((struct ecallback *)(e + 1))->cb;
+                }
+
+                unsigned latency = equeue_clampdiff(equeue_tick(), e->target);
+                unsigned start = equeue_utick();
                 cb(e + 1);
+                equeue_stats_record(q, stat_cb, equeue_utick() - start, latency);
+#else
+                cb(e + 1);
+#endif
             }
 
             // reenqueue periodic events or deallocate
             if (e->period >= 0) {
                 e->target += e->period;
-                equeue_enqueue(q, e, equeue_tick());
-            } else {
+                if (user_allocated) {
+                    // caller-owned events live outside the buffer, so no
+                    // id can be derived from their offset
+                    equeue_mutex_lock(&q->queuelock);
+                    equeue_schedule(q, e, equeue_tick());
+                    equeue_mutex_unlock(&q->queuelock);
+                } else {
+                    equeue_enqueue(q, e, equeue_tick());
+                }
+            } else if (!user_allocated) {
                 equeue_incid(q, e);
                 equeue_dealloc(q, e + 1);
             }
@@ -467,9 +1042,9 @@ void equeue_dispatch(equeue_t *q, int ms)
                 // update background timer if necessary
                 if (q->background.update) {
                     equeue_mutex_lock(&q->queuelock);
-                    if (q->background.update && q->queue) {
-                        q->background.update(q->background.timer,
-                                             equeue_clampdiff(q->queue->target, tick));
+                    int delay = equeue_scheduled_delay(q, tick);
+                    if (q->background.update && delay >= 0) {
+                        q->background.update(q->background.timer, delay);
                     }
                     q->background.active = true;
                     equeue_mutex_unlock(&q->queuelock);
@@ -481,16 +1056,14 @@ void equeue_dispatch(equeue_t *q, int ms)
 
         // find closest deadline
         equeue_mutex_lock(&q->queuelock);
-        if (q->queue) {
-            int diff = equeue_clampdiff(q->queue->target, tick);
-            if ((unsigned)diff < (unsigned)deadline) {
-                deadline = diff;
-            }
+        int diff = equeue_scheduled_delay(q, tick);
+        if (diff >= 0 && (unsigned)diff < (unsigned)deadline) {
+            deadline = diff;
         }
         equeue_mutex_unlock(&q->queuelock);
 
         // wait for events
-        equeue_sema_wait(&q->eventsema, deadline);
+        equeue_sema_wait(&q->eventsema[id], deadline);
 
         // check if we were notified to break out of dispatch
         if (q->break_requested) {
@@ -513,6 +1086,12 @@ void equeue_dispatch(equeue_t *q, int ms)
     }
 }
 
+EQUEUE_RAM_FUNC
+void equeue_dispatch(equeue_t *q, int ms)
+{
+    equeue_dispatch_id(q, ms, 0);
+}
+
 
 // event functions
 void equeue_event_delay(void *p, int ms)
@@ -533,19 +1112,33 @@ void equeue_event_dtor(void *p, void (*dtor)(void *))
     e->dtor = dtor;
 }
 
+void equeue_event_priority(void *p, unsigned priority)
+{
+    struct equeue_event *e = (struct equeue_event *)p - 1;
+    e->priority = (priority < EQUEUE_PRIORITY_BANDS)
+                  ? priority : EQUEUE_PRIORITY_BANDS - 1;
+}
 
-// simple callbacks
-struct ecallback {
-    void (*cb)(void *);
-    void *data;
-};
+void equeue_event_affinity(void *p, int dispatcher)
+{
+    struct equeue_event *e = (struct equeue_event *)p - 1;
+    if (dispatcher < 0) {
+        e->affinity = 0;
+    } else {
+        // affinities are stored with a +1 bias so zero means any dispatcher
+        e->affinity = (dispatcher < EQUEUE_MAX_DISPATCHERS)
+                      ? dispatcher + 1 : EQUEUE_MAX_DISPATCHERS;
+    }
+}
 
-static void ecallback_dispatch(void *p)
+void equeue_event_slack(void *p, int ms)
 {
-    struct ecallback *e = (struct ecallback *)p;
-    e->cb(e->data);
+    struct equeue_event *e = (struct equeue_event *)p - 1;
+    e->slack = ms;
 }
 
+
+// simple calls
 int equeue_call(equeue_t *q, void (*cb)(void *), void *data)
 {
     struct ecallback *e = equeue_alloc(q, sizeof(struct ecallback));
@@ -598,9 +1191,11 @@ void equeue_background(equeue_t *q,
     q->background.update = update;
     q->background.timer = timer;
 
-    if (q->background.update && q->queue) {
-        q->background.update(q->background.timer,
-                             equeue_clampdiff(q->queue->target, equeue_tick()));
+    if (q->background.update) {
+        int delay = equeue_scheduled_delay(q, equeue_tick());
+        if (delay >= 0) {
+            q->background.update(q->background.timer, delay);
+        }
     }
     q->background.active = true;
     equeue_mutex_unlock(&q->queuelock);
@@ -36,11 +36,67 @@ extern "C" {
 // This size is guaranteed to fit events created by event_call
 #define EQUEUE_EVENT_SIZE (sizeof(struct equeue_event) + 2*sizeof(void*))
 
+// Timer wheel geometry
+//
+// Delayed events further out than two slices are kept in a hashed timer
+// wheel and only sorted into the pending queue once their slice comes up,
+// making delayed posts O(1) in the number of outstanding timers. Each of
+// the EQUEUE_WHEEL_SLOTS slots covers a slice of 2^EQUEUE_WHEEL_SHIFT
+// ticks, the defaults give a 256ms slice and an ~8s revolution.
+#ifndef EQUEUE_WHEEL_SLOTS
+#define EQUEUE_WHEEL_SLOTS 32
+#endif
+#ifndef EQUEUE_WHEEL_SHIFT
+#define EQUEUE_WHEEL_SHIFT 8
+#endif
+
+#if EQUEUE_INSTRUMENTATION
+// Number of distinct callbacks tracked per queue when instrumentation
+// is enabled, callbacks past this many go untracked
+#ifndef EQUEUE_STATS_ENTRIES
+#define EQUEUE_STATS_ENTRIES 16
+#endif
+
+// Per-callback dispatch statistics
+struct equeue_stat {
+    void (*cb)(void *);         // tracked callback, null if the slot is unused
+    unsigned dispatched;        // number of times the callback was dispatched
+    uint64_t execution_us;      // cumulative execution time in microseconds
+    unsigned max_execution_us;  // worst-case execution time in microseconds
+    unsigned max_latency;       // worst-case delay in ticks between an event
+                                // falling due and its dispatch starting
+};
+#endif
+
+// Number of cooperating dispatcher threads supported per queue
+//
+// Each dispatcher calls equeue_dispatch_id with its own id and pulls ready
+// events from the shared queue, so a long-running handler on one thread
+// does not head-of-line block independent events. Events pinned to a
+// dispatcher with equeue_event_affinity are parked for that dispatcher
+// when another one encounters them. Each supported dispatcher costs one
+// semaphore per queue, so the default is a single dispatcher.
+#ifndef EQUEUE_MAX_DISPATCHERS
+#define EQUEUE_MAX_DISPATCHERS 1
+#endif
+
+// Number of priority bands used to order dispatch
+//
+// Within a dispatch batch, events in higher (numerically lower) bands are
+// always drained first. Every expired event still dispatches in its batch,
+// so lower bands are delayed by at most one batch and never starved.
+#ifndef EQUEUE_PRIORITY_BANDS
+#define EQUEUE_PRIORITY_BANDS 3
+#endif
+
 // Internal event structure
 struct equeue_event {
     unsigned size;
     uint8_t id;
     uint8_t generation;
+    uint8_t wheel;
+    uint8_t priority;
+    uint8_t affinity;
 
     struct equeue_event *next;
     struct equeue_event *sibling;
@@ -48,6 +104,7 @@ struct equeue_event {
 
     unsigned target;
     int period;
+    int slack;
     void (*dtor)(void *);
 
     void (*cb)(void *);
@@ -57,6 +114,12 @@ struct equeue_event {
 // Event queue structure
 typedef struct equeue {
     struct equeue_event *queue;
+    struct equeue_event *volatile posted;
+    struct equeue_event *pinned;
+    struct equeue_event **pinned_tail;
+    struct equeue_event *wheel[EQUEUE_WHEEL_SLOTS];
+    unsigned wheel_tick;
+    unsigned wheel_count;
     unsigned tick;
     bool break_requested;
     uint8_t generation;
@@ -70,6 +133,7 @@ typedef struct equeue {
         size_t size;
         unsigned char *data;
     } slab;
+    unsigned alloc_failures;
 
     struct equeue_background {
         bool active;
@@ -77,16 +141,29 @@ typedef struct equeue {
         void *timer;
     } background;
 
-    equeue_sema_t eventsema;
+    equeue_sema_t eventsema[EQUEUE_MAX_DISPATCHERS];
     equeue_mutex_t queuelock;
     equeue_mutex_t memlock;
 
+#if EQUEUE_INSTRUMENTATION
+    struct equeue_stat stats[EQUEUE_STATS_ENTRIES];
+#endif
+
 #ifdef TARGET_SIMULATOR
     bool dispatch_called;
 #endif
 } equeue_t;
 
 
+// Size-class description for pooled event allocation
+//
+// The size is the usable event size of the class as passed to equeue_alloc,
+// the count is the number of slots reserved for the class.
+struct equeue_pool {
+    size_t size;
+    size_t count;
+};
+
 // Queue lifetime operations
 //
 // Creates and destroys an event queue. The event queue either allocates a
@@ -99,6 +176,26 @@ int equeue_create(equeue_t *queue, size_t size);
 int equeue_create_inplace(equeue_t *queue, size_t size, void *buffer);
 void equeue_destroy(equeue_t *queue);
 
+// Queue lifetime operations with static size-class pools
+//
+// As equeue_create/equeue_create_inplace, but the buffer is carved into
+// fixed slots of the specified size classes up front and the slab never
+// serves further allocations. Every equeue_alloc becomes a constant-time
+// pop from the smallest class that fits, chunks are never split or merged,
+// so fragmentation is structurally impossible and the worst-case capacity
+// of each class holds for the lifetime of the queue. Allocations larger
+// than the largest class always fail.
+//
+// equeue_create_pools sizes and allocates the buffer itself. For
+// equeue_create_pools_inplace the provided buffer must fit every slot
+// after the per-event overhead and alignment of EQUEUE_EVENT_SIZE -
+// 2*sizeof(void*) bytes is added to each class size; if it does not,
+// a negative error code is returned.
+int equeue_create_pools(equeue_t *queue,
+                        const struct equeue_pool *pools, unsigned npools);
+int equeue_create_pools_inplace(equeue_t *queue, size_t size, void *buffer,
+                                const struct equeue_pool *pools, unsigned npools);
+
 // Dispatch events
 //
 // Executes events until the specified milliseconds have passed. If ms is
@@ -110,6 +207,23 @@ void equeue_destroy(equeue_t *queue);
 // equeue_dispatch does not wait and is irq safe.
 void equeue_dispatch(equeue_t *queue, int ms);
 
+// Dispatch events as one of several cooperating dispatchers
+//
+// Behaves as equeue_dispatch, but identifies the calling thread as the
+// dispatcher with the given id, 0 <= id < EQUEUE_MAX_DISPATCHERS. Multiple
+// threads may dispatch the same queue concurrently, each pulling ready
+// events from the shared queue, so a long-running handler on one thread
+// does not delay independent events.
+//
+// Events are run by whichever dispatcher gets to them first unless pinned
+// with equeue_event_affinity. When a dispatcher encounters a due event
+// pinned to another dispatcher, the event is parked and the owning
+// dispatcher woken. Pinning an event to an id no thread dispatches with
+// leaves it parked forever.
+//
+// equeue_dispatch is equivalent to equeue_dispatch_id with an id of 0.
+void equeue_dispatch_id(equeue_t *queue, int ms, unsigned id);
+
 // Break out of a running event loop
 //
 // Forces the specified event queue's dispatch loop to terminate. Pending
@@ -157,12 +271,28 @@ void equeue_dealloc(equeue_t *queue, void *event);
 
 // Configure an allocated event
 //
-// equeue_event_delay  - Millisecond delay before dispatching an event
-// equeue_event_period - Millisecond period for repeating dispatching an event
-// equeue_event_dtor   - Destructor to run when the event is deallocated
+// equeue_event_delay    - Millisecond delay before dispatching an event
+// equeue_event_period   - Millisecond period for repeating dispatching an event
+// equeue_event_dtor     - Destructor to run when the event is deallocated
+// equeue_event_priority - Priority band of the event, 0 is the highest band
+//                         and values are clamped to EQUEUE_PRIORITY_BANDS-1,
+//                         events default to the middle band
+// equeue_event_affinity - Dispatcher the event is pinned to when several
+//                         threads dispatch the queue, useful for handlers
+//                         that touch non-thread-safe state. A negative
+//                         dispatcher removes the pin, events default to
+//                         running on any dispatcher
+// equeue_event_slack    - Milliseconds the event may be deferred to share
+//                         a wakeup with an event already scheduled in the
+//                         window, batching compatible deadlines into a
+//                         single dispatch. Applied on every post of a
+//                         periodic event, events default to no slack
 void equeue_event_delay(void *event, int ms);
 void equeue_event_period(void *event, int ms);
 void equeue_event_dtor(void *event, void (*dtor)(void *));
+void equeue_event_priority(void *event, unsigned priority);
+void equeue_event_affinity(void *event, int dispatcher);
+void equeue_event_slack(void *event, int ms);
 
 // Post an event onto the event queue
 //
@@ -178,6 +308,51 @@ void equeue_event_dtor(void *event, void (*dtor)(void *));
 // be passed to equeue_cancel.
 int equeue_post(equeue_t *queue, void (*cb)(void *), void *event);
 
+// Post an event onto the event queue without entering a mutex section
+//
+// Behaves as equeue_post, but links the event onto a lock-free
+// multiple-producer single-consumer list with a single compare-and-swap
+// instead of taking the queue lock, which on embedded platforms maps to a
+// critical section. This makes posting from interrupt handlers cost a
+// handful of cycles and never extends interrupt-disabled windows.
+//
+// The posted events are sorted into the queue by the dispatch loop, so the
+// event only becomes visible to dispatch (and accurately delayed) once the
+// dispatching thread wakes up. If the queue is backgrounded onto a timer
+// rather than actively dispatched, equeue_post_irq falls back to the locked
+// post path so the background timer can be updated.
+int equeue_post_irq(equeue_t *queue, void (*cb)(void *), void *event);
+
+// Post an event with caller-owned storage onto the event queue
+//
+// The equeue_post_user_allocated function takes a callback and a pointer to
+// storage owned by the caller that begins with a struct equeue_event header,
+// zero-initialized before first use. The callback is executed in the context
+// of the event queue's dispatch loop with a pointer to the memory directly
+// following the header as its argument.
+//
+// Because no allocation takes place, the post cannot fail, runs in bounded
+// time, and is irq safe, making it suitable for hard-real-time interrupt
+// paths. Posting an event that is already pending coalesces into the earlier
+// post and has no further effect. A one-shot event may be posted again as
+// soon as its callback has started executing, a periodic event stays pending
+// until cancelled.
+//
+// The storage must stay valid until the event has been dispatched or
+// cancelled, or the queue destroyed.
+void equeue_post_user_allocated(equeue_t *queue, void (*cb)(void *),
+                                void *event, int ms, int period);
+
+// Cancel a pending event with caller-owned storage
+//
+// Attempts to cancel an event posted with equeue_post_user_allocated. It is
+// safe to call after the event has already been dispatched, and the storage
+// may be reposted or released afterwards.
+//
+// The equeue_cancel_user_allocated function is irq safe, with the same
+// in-flight caveat as equeue_cancel.
+void equeue_cancel_user_allocated(equeue_t *queue, void *event);
+
 // Cancel an in-flight event
 //
 // Attempts to cancel an event referenced by the unique id returned from
@@ -200,6 +375,31 @@ void equeue_cancel(equeue_t *queue, int id);
 //
 int equeue_timeleft(equeue_t *q, int id);
 
+#if EQUEUE_INSTRUMENTATION
+// Read back dispatch statistics
+//
+// Statistics are aggregated per distinct callback function. The
+// equeue_stats_read function copies the statistics slot at index i into
+// stat and returns true, or returns false once i is past the last slot,
+// allowing the table to be iterated with a simple counting loop. Unused
+// slots have a null cb. The equeue_stats_reset function clears the table.
+//
+// Both functions are irq safe.
+bool equeue_stats_read(equeue_t *queue, unsigned i, struct equeue_stat *stat);
+void equeue_stats_reset(equeue_t *queue);
+#endif
+
+// Number of failed event allocations since the queue was created
+//
+// Counts equeue_alloc calls that returned null because the slab, chunk list
+// and size-class pools were all exhausted. Every count is an event a caller
+// tried to post but could not - callers that ignore the null return drop the
+// event silently, so a non-zero count is the first place to look when events
+// go missing under load.
+//
+// This function is irq safe.
+unsigned equeue_alloc_failures(equeue_t *queue);
+
 // Background an event queue onto a single-shot timer
 //
 // The provided update function will be called to indicate when the queue
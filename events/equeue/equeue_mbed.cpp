@@ -32,11 +32,55 @@
 
 using namespace mbed;
 
+#if EQUEUE_INSTRUMENTATION
+#include "hal/ticker_api.h"
+#include "hal/us_ticker_api.h"
+
+unsigned equeue_utick()
+{
+    return ticker_read(get_us_ticker_data());
+}
+#endif
+
+// Virtual time operations
+#if EQUEUE_VIRTUAL_TIME
+static volatile bool equeue_vtime_on = false;
+static volatile uint32_t equeue_vtime_ms = 0;
+
+void equeue_vtime_start(unsigned start_ms)
+{
+    core_util_critical_section_enter();
+    equeue_vtime_ms = start_ms;
+    equeue_vtime_on = true;
+    core_util_critical_section_exit();
+}
+
+void equeue_vtime_stop(void)
+{
+    equeue_vtime_on = false;
+}
+
+void equeue_vtime_advance(unsigned ms)
+{
+    core_util_atomic_incr_u32((uint32_t *)&equeue_vtime_ms, ms);
+}
+
+bool equeue_vtime_active(void)
+{
+    return equeue_vtime_on;
+}
+#endif
+
 // Ticker operations
 #if MBED_CONF_RTOS_PRESENT
 
 unsigned equeue_tick()
 {
+#if EQUEUE_VIRTUAL_TIME
+    if (equeue_vtime_on) {
+        return equeue_vtime_ms;
+    }
+#endif
     return osKernelGetTickCount();
 }
 
@@ -84,6 +128,12 @@ static void equeue_tick_init()
 
 unsigned equeue_tick()
 {
+#if EQUEUE_VIRTUAL_TIME
+    if (equeue_vtime_on) {
+        return equeue_vtime_ms;
+    }
+#endif
+
     if (!equeue_tick_inited) {
         equeue_tick_init();
     }
@@ -119,6 +169,13 @@ void equeue_mutex_unlock(equeue_mutex_t *m)
 }
 
 
+// Atomic operations
+bool equeue_atomic_cas_ptr(void *volatile *ptr, void *expected, void *desired)
+{
+    return core_util_atomic_cas_ptr((void *volatile *)ptr, &expected, desired);
+}
+
+
 // Semaphore operations
 #ifdef MBED_CONF_RTOS_PRESENT
 
@@ -145,6 +202,19 @@ void equeue_sema_signal(equeue_sema_t *s)
 
 bool equeue_sema_wait(equeue_sema_t *s, int ms)
 {
+#if EQUEUE_VIRTUAL_TIME
+    if (ms > 0 && equeue_vtime_on) {
+        // Never sleep through virtual time: consume a pending signal if
+        // there is one, otherwise jump the clock to the deadline
+        if (osEventFlagsWait(s->id, 1, osFlagsWaitAny, 0) == 1) {
+            return true;
+        }
+        osThreadYield();
+        equeue_vtime_advance((unsigned)ms);
+        return false;
+    }
+#endif
+
     if (ms < 0) {
         ms = osWaitForever;
     }
@@ -177,6 +247,22 @@ static void equeue_sema_timeout(equeue_sema_t *s)
 
 bool equeue_sema_wait(equeue_sema_t *s, int ms)
 {
+#if EQUEUE_VIRTUAL_TIME
+    if (ms > 0 && equeue_vtime_on) {
+        // Never sleep through virtual time: consume a pending signal if
+        // there is one, otherwise jump the clock to the deadline
+        core_util_critical_section_enter();
+        int vsignal = *s;
+        *s = false;
+        core_util_critical_section_exit();
+
+        if (vsignal <= 0) {
+            equeue_vtime_advance((unsigned)ms);
+        }
+        return vsignal > 0;
+    }
+#endif
+
     int signal = 0;
     ALIAS_TIMEOUT timeout;
     if (ms == 0) {
@@ -55,6 +55,59 @@ extern "C" {
 #endif
 
 
+// Opt-in dispatch instrumentation
+//
+// When enabled, the equeue records per-callback dispatch statistics
+// (dispatch count, cumulative and worst-case execution time, worst-case
+// queue-to-dispatch latency) that can be read back while the queue runs.
+// Costs one timestamped critical section per dispatched event plus a
+// small statistics table per queue, so it is disabled by default.
+#ifndef EQUEUE_INSTRUMENTATION
+#if defined(MBED_CONF_EVENTS_INSTRUMENTATION) && MBED_CONF_EVENTS_INSTRUMENTATION
+#define EQUEUE_INSTRUMENTATION 1
+#else
+#define EQUEUE_INSTRUMENTATION 0
+#endif
+#endif
+
+// Number of cooperating dispatcher threads supported per queue, see
+// equeue_dispatch_id. Each supported dispatcher costs one semaphore per
+// queue, so the default is a single dispatcher.
+#if !defined(EQUEUE_MAX_DISPATCHERS) && defined(MBED_CONF_EVENTS_DISPATCHERS)
+#define EQUEUE_MAX_DISPATCHERS MBED_CONF_EVENTS_DISPATCHERS
+#endif
+
+// Opt-in RAM placement of the dispatch loop
+//
+// When enabled, the dispatch functions are pinned in RAM so event
+// dispatch executes with zero wait states regardless of flash latency
+// and the flash accelerator's state. Costs RAM for the dispatch code
+// permanently, so it is disabled by default.
+#ifndef EQUEUE_RAM_FUNC
+#if defined(EQUEUE_PLATFORM_MBED) && defined(MBED_CONF_EVENTS_DISPATCH_FROM_RAM) && MBED_CONF_EVENTS_DISPATCH_FROM_RAM
+#include "platform/mbed_toolchain.h"
+#define EQUEUE_RAM_FUNC MBED_RAM_FUNC
+#else
+#define EQUEUE_RAM_FUNC
+#endif
+#endif
+
+// Opt-in virtual time for accelerated testing
+//
+// When enabled, the tick source can be switched at runtime onto a
+// software clock that jumps straight to the next scheduled deadline
+// whenever a dispatching thread would otherwise sleep, so time-dependent
+// logic (long periods, tick wraps) runs as fast as the events execute.
+// Intended for test builds only; the clock is global, so run one queue
+// at a time while it is active. Disabled by default.
+#ifndef EQUEUE_VIRTUAL_TIME
+#if defined(MBED_CONF_EVENTS_VIRTUAL_TIME) && MBED_CONF_EVENTS_VIRTUAL_TIME
+#define EQUEUE_VIRTUAL_TIME 1
+#else
+#define EQUEUE_VIRTUAL_TIME 0
+#endif
+#endif
+
 // Platform millisecond counter
 //
 // Return a tick that represents the number of milliseconds that have passed
@@ -65,6 +118,30 @@ extern "C" {
 // Must intentionally overflow to 0 after 2^32-1
 unsigned equeue_tick(void);
 
+#if EQUEUE_VIRTUAL_TIME
+// Virtual time operations
+//
+// equeue_vtime_start switches equeue_tick onto the virtual clock,
+// starting it at start_ms (pick a value near 2^32 to exercise tick
+// wraps), and equeue_vtime_stop switches back to the hardware tick.
+// While the clock is active, a timed equeue_sema_wait that finds no
+// pending signal advances it by the full wait instead of sleeping, and
+// equeue_vtime_advance jumps it forward explicitly.
+void equeue_vtime_start(unsigned start_ms);
+void equeue_vtime_stop(void);
+void equeue_vtime_advance(unsigned ms);
+bool equeue_vtime_active(void);
+#endif
+
+#if EQUEUE_INSTRUMENTATION
+// Platform microsecond counter
+//
+// Only required when instrumentation is enabled, where it timestamps the
+// execution of each dispatched callback. Overflows naturally, only
+// differences between nearby reads are used.
+unsigned equeue_utick(void);
+#endif
+
 
 // Platform mutex type
 //
@@ -143,6 +220,17 @@ void equeue_sema_signal(equeue_sema_t *sema);
 bool equeue_sema_wait(equeue_sema_t *sema, int ms);
 
 
+// Platform atomic pointer compare-and-swap
+//
+// Atomically compares the pointer at ptr with expected and, only if they
+// are equal, stores desired at ptr. Returns true if the swap took place.
+//
+// Must be safe to call from interrupt contexts. Used by the lock-free
+// equeue_post_irq path, which relies on it to link events without taking
+// a mutex section.
+bool equeue_atomic_cas_ptr(void *volatile *ptr, void *expected, void *desired);
+
+
 #ifdef __cplusplus
 }
 #endif
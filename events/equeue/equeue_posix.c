@@ -22,17 +22,76 @@
 #include <time.h>
 #include <sys/time.h>
 #include <errno.h>
+#include <sched.h>
+
+
+// Virtual time operations
+#if EQUEUE_VIRTUAL_TIME
+static bool equeue_vtime_on = false;
+static unsigned equeue_vtime_ms = 0;
+static pthread_mutex_t equeue_vtime_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+void equeue_vtime_start(unsigned start_ms)
+{
+    pthread_mutex_lock(&equeue_vtime_mutex);
+    equeue_vtime_ms = start_ms;
+    equeue_vtime_on = true;
+    pthread_mutex_unlock(&equeue_vtime_mutex);
+}
+
+void equeue_vtime_stop(void)
+{
+    pthread_mutex_lock(&equeue_vtime_mutex);
+    equeue_vtime_on = false;
+    pthread_mutex_unlock(&equeue_vtime_mutex);
+}
+
+void equeue_vtime_advance(unsigned ms)
+{
+    pthread_mutex_lock(&equeue_vtime_mutex);
+    equeue_vtime_ms += ms;
+    pthread_mutex_unlock(&equeue_vtime_mutex);
+}
+
+bool equeue_vtime_active(void)
+{
+    pthread_mutex_lock(&equeue_vtime_mutex);
+    bool on = equeue_vtime_on;
+    pthread_mutex_unlock(&equeue_vtime_mutex);
+    return on;
+}
+#endif
 
 
 // Tick operations
 unsigned equeue_tick(void)
 {
+#if EQUEUE_VIRTUAL_TIME
+    pthread_mutex_lock(&equeue_vtime_mutex);
+    bool on = equeue_vtime_on;
+    unsigned vtick = equeue_vtime_ms;
+    pthread_mutex_unlock(&equeue_vtime_mutex);
+    if (on) {
+        return vtick;
+    }
+#endif
+
     struct timeval tv;
     gettimeofday(&tv, 0);
     return (unsigned)(tv.tv_sec * 1000 + tv.tv_usec / 1000);
 }
 
 
+#if EQUEUE_INSTRUMENTATION
+unsigned equeue_utick(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+    return (unsigned)(tv.tv_sec * 1000000 + tv.tv_usec);
+}
+#endif
+
+
 // Mutex operations
 int equeue_mutex_create(equeue_mutex_t *m)
 {
@@ -55,6 +114,13 @@ void equeue_mutex_unlock(equeue_mutex_t *m)
 }
 
 
+// Atomic operations
+bool equeue_atomic_cas_ptr(void *volatile *ptr, void *expected, void *desired)
+{
+    return __sync_bool_compare_and_swap(ptr, expected, desired);
+}
+
+
 // Semaphore operations
 int equeue_sema_create(equeue_sema_t *s)
 {
@@ -88,6 +154,23 @@ void equeue_sema_signal(equeue_sema_t *s)
 
 bool equeue_sema_wait(equeue_sema_t *s, int ms)
 {
+#if EQUEUE_VIRTUAL_TIME
+    if (ms > 0 && equeue_vtime_active()) {
+        // Never sleep through virtual time: consume a pending signal if
+        // there is one, otherwise jump the clock to the deadline
+        pthread_mutex_lock(&s->mutex);
+        bool vsignal = s->signal;
+        s->signal = false;
+        pthread_mutex_unlock(&s->mutex);
+
+        if (!vsignal) {
+            equeue_vtime_advance((unsigned)ms);
+            sched_yield();
+        }
+        return vsignal;
+    }
+#endif
+
     pthread_mutex_lock(&s->mutex);
     if (!s->signal) {
         if (ms < 0) {
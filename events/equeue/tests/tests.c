@@ -18,6 +18,7 @@
 #include "equeue.h"
 #include <unistd.h>
 #include <stdio.h>
+#include <string.h>
 #include <setjmp.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -208,6 +209,147 @@ void simple_post_test(void)
     equeue_destroy(&q);
 }
 
+void wheel_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 4096);
+    test_assert(!err);
+
+    // far enough out to take the timer wheel path, near event stays first
+    bool before = false;
+    bool after = false;
+    bool cancelled = false;
+
+    int id1 = equeue_call_in(&q, 10, simple_func, &before);
+    int id2 = equeue_call_in(&q, 3 * (1 << EQUEUE_WHEEL_SHIFT), simple_func, &after);
+    int id3 = equeue_call_in(&q, 4 * (1 << EQUEUE_WHEEL_SHIFT), simple_func, &cancelled);
+    test_assert(id1 && id2 && id3);
+
+    equeue_cancel(&q, id3);
+
+    equeue_dispatch(&q, 2 * (1 << EQUEUE_WHEEL_SHIFT));
+    test_assert(before);
+    test_assert(!after);
+
+    equeue_dispatch(&q, 3 * (1 << EQUEUE_WHEEL_SHIFT));
+    test_assert(after);
+    test_assert(!cancelled);
+
+    equeue_destroy(&q);
+}
+
+struct order {
+    int *counter;
+    int expected;
+};
+
+static void order_func(void *p)
+{
+    struct order *o = (struct order *)p;
+    test_assert(*o->counter == o->expected);
+    *o->counter += 1;
+}
+
+void priority_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    // posted low, normal, high - dispatched high, normal, low
+    int counter = 0;
+
+    struct order *lo = equeue_alloc(&q, sizeof(struct order));
+    test_assert(lo);
+    lo->counter = &counter;
+    lo->expected = 2;
+    equeue_event_priority(lo, EQUEUE_PRIORITY_BANDS - 1);
+    test_assert(equeue_post(&q, order_func, lo));
+
+    struct order *mid = equeue_alloc(&q, sizeof(struct order));
+    test_assert(mid);
+    mid->counter = &counter;
+    mid->expected = 1;
+    test_assert(equeue_post(&q, order_func, mid));
+
+    struct order *hi = equeue_alloc(&q, sizeof(struct order));
+    test_assert(hi);
+    hi->counter = &counter;
+    hi->expected = 0;
+    equeue_event_priority(hi, 0);
+    test_assert(equeue_post(&q, order_func, hi));
+
+    equeue_dispatch(&q, 0);
+    test_assert(counter == 3);
+
+    equeue_destroy(&q);
+}
+
+void simple_post_irq_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int touched = false;
+    struct indirect *i = equeue_alloc(&q, sizeof(struct indirect));
+    test_assert(i);
+
+    i->touched = &touched;
+    int id = equeue_post_irq(&q, indirect_func, i);
+    test_assert(id);
+
+    equeue_dispatch(&q, 0);
+    test_assert(*i->touched);
+
+    // posted but cancelled before the dispatch loop drains it
+    touched = false;
+    i = equeue_alloc(&q, sizeof(struct indirect));
+    test_assert(i);
+
+    i->touched = &touched;
+    id = equeue_post_irq(&q, indirect_func, i);
+    test_assert(id);
+    equeue_cancel(&q, id);
+
+    equeue_dispatch(&q, 0);
+    test_assert(!touched);
+
+    equeue_destroy(&q);
+}
+
+#if EQUEUE_INSTRUMENTATION
+void stats_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    bool touched = false;
+    for (int i = 0; i < 3; i++) {
+        equeue_call(&q, simple_func, &touched);
+    }
+    equeue_dispatch(&q, 0);
+    test_assert(touched);
+
+    // all three posts hit the same callback slot
+    struct equeue_stat stat;
+    unsigned dispatched = 0;
+    for (unsigned i = 0; equeue_stats_read(&q, i, &stat); i++) {
+        if (stat.cb == simple_func) {
+            dispatched = stat.dispatched;
+        }
+    }
+    test_assert(dispatched == 3);
+
+    equeue_stats_reset(&q);
+    test_assert(equeue_stats_read(&q, 0, &stat));
+    test_assert(!stat.cb);
+
+    equeue_destroy(&q);
+}
+#endif
+
 // Misc tests
 void destructor_test(void)
 {
@@ -266,19 +408,178 @@ void destructor_test(void)
     test_assert(touched == 3);
 }
 
+void pool_test(void)
+{
+    equeue_t q;
+    struct equeue_pool pools[] = {{32, 4}, {96, 2}};
+    int err = equeue_create_pools(&q, pools, 2);
+    test_assert(!err);
+
+    // each class is exhausted independently of the other
+    void *small[4];
+    void *large[2];
+    for (int i = 0; i < 4; i++) {
+        small[i] = equeue_alloc(&q, 32);
+        test_assert(small[i]);
+    }
+    for (int i = 0; i < 2; i++) {
+        large[i] = equeue_alloc(&q, 96);
+        test_assert(large[i]);
+    }
+    test_assert(!equeue_alloc(&q, 32));
+
+    // oversized allocations always fail
+    test_assert(!equeue_alloc(&q, 128));
+
+    // freed slots go back to their class regardless of requested size
+    equeue_dealloc(&q, large[0]);
+    void *p = equeue_alloc(&q, 48);
+    test_assert(p);
+    test_assert(!equeue_alloc(&q, 96));
+
+    equeue_destroy(&q);
+}
+
+#if EQUEUE_MAX_DISPATCHERS > 1
+void affinity_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int touched = 0;
+    int pinned_touched = 0;
+
+    equeue_call(&q, simple_func, &touched);
+
+    struct indirect *i = equeue_alloc(&q, sizeof(struct indirect));
+    test_assert(i);
+    i->touched = &pinned_touched;
+    equeue_event_affinity(i, 1);
+    equeue_post(&q, indirect_func, i);
+
+    // dispatcher 0 runs unpinned events and parks the pinned one
+    equeue_dispatch_id(&q, 0, 0);
+    test_assert(touched == 1);
+    test_assert(pinned_touched == 0);
+
+    // dispatcher 1 claims the parked event
+    equeue_dispatch_id(&q, 0, 1);
+    test_assert(pinned_touched == 1);
+
+    equeue_destroy(&q);
+}
+#endif
+
+void slack_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int touched = 0;
+    int id0 = equeue_call_in(&q, 50, simple_func, &touched);
+    test_assert(id0);
+
+    // within the slack window the deadline snaps onto the existing wakeup
+    struct indirect *i = equeue_alloc(&q, sizeof(struct indirect));
+    test_assert(i);
+    i->touched = &touched;
+    equeue_event_delay(i, 40);
+    equeue_event_slack(i, 20);
+    int id1 = equeue_post(&q, indirect_func, i);
+    test_assert(id1);
+
+    int left0 = equeue_timeleft(&q, id0);
+    int left1 = equeue_timeleft(&q, id1);
+    test_assert(left1 >= left0 - 1 && left1 <= left0 + 1);
+
+    // outside the window the deadline is untouched
+    i = equeue_alloc(&q, sizeof(struct indirect));
+    test_assert(i);
+    i->touched = &touched;
+    equeue_event_delay(i, 10);
+    equeue_event_slack(i, 5);
+    int id2 = equeue_post(&q, indirect_func, i);
+    test_assert(id2);
+    test_assert(equeue_timeleft(&q, id2) <= 15);
+
+    equeue_dispatch(&q, 60);
+    test_assert(touched == 3);
+
+    equeue_destroy(&q);
+}
+
+struct uevent {
+    struct equeue_event e;
+    int touched;
+};
+
+void uevent_func(void *p)
+{
+    struct uevent *ue = (struct uevent *)((char *)p - sizeof(struct equeue_event));
+    ue->touched += 1;
+}
+
+void user_allocated_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    struct uevent ue;
+    memset(&ue, 0, sizeof(ue));
+
+    // a double post coalesces into a single dispatch
+    equeue_post_user_allocated(&q, uevent_func, &ue.e, 0, -1);
+    equeue_post_user_allocated(&q, uevent_func, &ue.e, 0, -1);
+    equeue_dispatch(&q, 0);
+    test_assert(ue.touched == 1);
+
+    // one-shot events can be reposted after dispatch
+    equeue_post_user_allocated(&q, uevent_func, &ue.e, 0, -1);
+    equeue_dispatch(&q, 0);
+    test_assert(ue.touched == 2);
+
+    // cancelled before dispatch
+    equeue_post_user_allocated(&q, uevent_func, &ue.e, 10, -1);
+    equeue_cancel_user_allocated(&q, &ue.e);
+    equeue_dispatch(&q, 15);
+    test_assert(ue.touched == 2);
+
+    // periodic events stay pending until cancelled
+    equeue_post_user_allocated(&q, uevent_func, &ue.e, 0, 10);
+    equeue_dispatch(&q, 25);
+    test_assert(ue.touched >= 4);
+    equeue_cancel_user_allocated(&q, &ue.e);
+
+    int touched = ue.touched;
+    equeue_dispatch(&q, 15);
+    test_assert(ue.touched == touched);
+
+    equeue_destroy(&q);
+}
+
 void allocation_failure_test(void)
 {
     equeue_t q;
     int err = equeue_create(&q, 2048);
     test_assert(!err);
 
+    test_assert(equeue_alloc_failures(&q) == 0);
     void *p = equeue_alloc(&q, 4096);
     test_assert(!p);
+    test_assert(equeue_alloc_failures(&q) == 1);
 
+    unsigned failures = 1;
     for (int i = 0; i < 100; i++) {
         p = equeue_alloc(&q, 0);
+        if (!p) {
+            failures += 1;
+        }
     }
     test_assert(!p);
+    test_assert(equeue_alloc_failures(&q) == failures);
 
     equeue_destroy(&q);
 }
@@ -802,6 +1103,58 @@ void sibling_test(void)
     equeue_destroy(&q);
 }
 
+#if EQUEUE_VIRTUAL_TIME
+void virtual_time_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    equeue_vtime_start(0);
+
+    // an hour and a day out - unreachable in real time
+    int touched = 0;
+    equeue_call_in(&q, 60 * 60 * 1000, simple_func, &touched);
+    equeue_call_in(&q, 24 * 60 * 60 * 1000, simple_func, &touched);
+
+    time_t start = time(0);
+    equeue_dispatch(&q, 25 * 60 * 60 * 1000);
+    test_assert(touched == 2);
+    test_assert(time(0) - start < 10);
+
+    // periodic events keep their cadence in virtual time
+    int count = 0;
+    unsigned vstart = equeue_tick();
+    int id = equeue_call_every(&q, 10 * 60 * 1000, simple_func, &count);
+    equeue_dispatch(&q, 60 * 60 * 1000);
+    test_assert(count == 6);
+    test_assert(equeue_tick() - vstart == 60 * 60 * 1000);
+
+    equeue_cancel(&q, id);
+    equeue_vtime_stop();
+    equeue_destroy(&q);
+}
+
+void virtual_time_wrap_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    // start 10 seconds before the tick wraps
+    equeue_vtime_start((unsigned) - 10000);
+
+    int touched = 0;
+    equeue_call_in(&q, 20000, simple_func, &touched);
+
+    equeue_dispatch(&q, 30000);
+    test_assert(touched == 1);
+
+    equeue_vtime_stop();
+    equeue_destroy(&q);
+}
+#endif
+
 int main()
 {
     printf("beginning tests...\n");
@@ -810,8 +1163,20 @@ int main()
     test_run(simple_call_in_test);
     test_run(simple_call_every_test);
     test_run(simple_post_test);
+    test_run(simple_post_irq_test);
+    test_run(wheel_test);
+    test_run(priority_test);
+#if EQUEUE_INSTRUMENTATION
+    test_run(stats_test);
+#endif
     test_run(destructor_test);
     test_run(allocation_failure_test);
+    test_run(pool_test);
+    test_run(user_allocated_test);
+    test_run(slack_test);
+#if EQUEUE_MAX_DISPATCHERS > 1
+    test_run(affinity_test);
+#endif
     test_run(cancel_test, 20);
     test_run(cancel_inflight_test);
     test_run(cancel_unnecessarily_test);
@@ -830,6 +1195,10 @@ int main()
     test_run(multithreaded_barrage_test, 20);
     test_run(break_request_cleared_on_timeout);
     test_run(sibling_test);
+#if EQUEUE_VIRTUAL_TIME
+    test_run(virtual_time_test);
+    test_run(virtual_time_wrap_test);
+#endif
     printf("done!\n");
     return test_failure;
 }
@@ -21,10 +21,61 @@
 using rtos::Thread;
 #endif
 
+#if MBED_CONF_EVENTS_SHARED_TICKLESS && defined(DEVICE_LPTICKER) && defined(MBED_CONF_RTOS_PRESENT)
+#define USE_TICKLESS_DISPATCH 1
+#include "drivers/LowPowerTimeout.h"
+#include "rtos/EventFlags.h"
+#endif
+
 using namespace events;
 
 namespace mbed {
 
+#if USE_TICKLESS_DISPATCH
+/* Dispatches an event queue from a low power timeout instead of a timed
+ * wait on the kernel tick. The queue is backgrounded, so equeue itself
+ * reprograms the timeout whenever the next deadline changes, and between
+ * events the dispatch thread blocks with no timeout at all - the sleep
+ * manager is free to enter deep sleep and the LP-timer match is the only
+ * thing that wakes the MCU.
+ */
+class TicklessDispatcher {
+public:
+    TicklessDispatcher(EventQueue *queue) : _queue(queue)
+    {
+    }
+
+    void dispatch_forever()
+    {
+        _queue->background(callback(this, &TicklessDispatcher::update));
+        while (true) {
+            _flags.wait_any(1);
+            _queue->dispatch(0);
+        }
+    }
+
+private:
+    void update(int ms)
+    {
+        if (ms < 0) {
+            _timeout.detach();
+        } else {
+            _timeout.attach_us(callback(this, &TicklessDispatcher::wake),
+                               (us_timestamp_t)ms * 1000);
+        }
+    }
+
+    void wake()
+    {
+        _flags.set(1);
+    }
+
+    EventQueue *_queue;
+    LowPowerTimeout _timeout;
+    rtos::EventFlags _flags;
+};
+#endif
+
 #ifdef MBED_CONF_RTOS_PRESENT
 /* Create an event queue, and start the thread that dispatches it. Static
  * variables mean this happens once the first time each template instantiation
@@ -42,7 +93,12 @@ EventQueue *do_shared_event_queue_with_thread(const char *name)
 
     Thread::State state = thread.get_state();
     if (state == Thread::Inactive || state == Thread::Deleted) {
+#if USE_TICKLESS_DISPATCH
+        static TicklessDispatcher dispatcher(&queue);
+        osStatus status = thread.start(callback(&dispatcher, &TicklessDispatcher::dispatch_forever));
+#else
         osStatus status = thread.start(callback(&queue, &EventQueue::dispatch_forever));
+#endif
         MBED_ASSERT(status == osOK);
         if (status != osOK) {
             return NULL;
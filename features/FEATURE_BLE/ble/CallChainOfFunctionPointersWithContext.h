@@ -72,15 +72,243 @@
  * }
  * @endcode
  *
- * @note memory allocation is used to add new function like objects into the
- * call chain.
+ * @note With the default capacity of 0, memory allocation is used to add new
+ * function like objects into the call chain; the callbacks are stored in a
+ * linked list, and the most recently added callback is called first. With a
+ * nonzero capacity, the callbacks are stored by value in an array inside the
+ * object: registration never allocates, call() iterates contiguous memory in
+ * registration order, and add() fails by returning NULL once the chain holds
+ * Capacity callbacks.
  *
  * @tparam ContextType Type of the parameter accepted by the callbacks hosted
  * in the object.
+ * @tparam Capacity Maximum number of callbacks stored inline in the object,
+ * or 0 to store an unbounded number of callbacks in a heap allocated linked
+ * list.
  */
-template <typename ContextType>
+template <typename ContextType, size_t Capacity = 0>
 class CallChainOfFunctionPointersWithContext :
-    public SafeBool<CallChainOfFunctionPointersWithContext<ContextType> > {
+    public SafeBool<CallChainOfFunctionPointersWithContext<ContextType, Capacity> > {
+public:
+    /**
+     * Alias of the FunctionPointerWithContext type this object can store.
+     */
+    typedef FunctionPointerWithContext<ContextType> *pFunctionPointerWithContext_t;
+
+public:
+    /**
+     * Create an empty callchain.
+     */
+    CallChainOfFunctionPointersWithContext() : count(0), currentCalled(0) { }
+
+    /**
+     * Destruction of the callchain.
+     */
+    virtual ~CallChainOfFunctionPointersWithContext() { }
+
+    /**
+     * Add a function pointer at the end of the chain.
+     *
+     * @param[in] function A pointer to a void function.
+     *
+     * @return The FunctionPointerWithContext object stored for @p function or
+     * NULL if the chain already holds Capacity callbacks.
+     */
+    pFunctionPointerWithContext_t add(void (*function)(ContextType context))
+    {
+        return common_add(FunctionPointerWithContext<ContextType>(function));
+    }
+
+    /**
+     * Add a member function bound to its instance at the end of the chain.
+     *
+     * @param[in] tptr Pointer to the object to call the member function on.
+     * @param[in] mptr Pointer to the member function to be called.
+     *
+     * @return The FunctionPointerWithContext object stored for @p tptr and
+     * @p mptr or NULL if the chain already holds Capacity callbacks.
+     */
+    template<typename T>
+    pFunctionPointerWithContext_t add(T *tptr, void (T::*mptr)(ContextType context))
+    {
+        return common_add(FunctionPointerWithContext<ContextType>(tptr, mptr));
+    }
+
+    /**
+     * Add a FunctionPointerWithContext at the end of the chain.
+     *
+     * @param[in] func The FunctionPointerWithContext to add.
+     *
+     * @return The function object stored for @p func or NULL if the chain
+     * already holds Capacity callbacks.
+     */
+    pFunctionPointerWithContext_t add(const FunctionPointerWithContext<ContextType> &func)
+    {
+        return common_add(func);
+    }
+
+    /**
+     * Detach a function pointer from a callchain.
+     *
+     * @param[in] toDetach FunctionPointerWithContext instance to detach from
+     * this callchain.
+     *
+     * @return true if a function pointer has been detached and false otherwise.
+     *
+     * @note It is safe to remove a function pointer while
+     * call(ContextType) is traversing the chain.
+     *
+     * @attention Pointers returned by add() are invalidated: the callbacks
+     * stored after the detached one move down by one slot.
+     */
+    bool detach(const FunctionPointerWithContext<ContextType> &toDetach)
+    {
+        for (size_t i = 0; i < count; i++) {
+            if (functions[i] == toDetach) {
+                for (size_t j = i; j < (count - 1); j++) {
+                    functions[j] = functions[j + 1];
+                }
+                count--;
+                /* Keep the traversal of call() consistent: the callbacks
+                 * stored after the detached one moved down by one slot. The
+                 * index may wrap around when the first callback detaches
+                 * itself; the increment in call() brings it back in range. */
+                if (i <= currentCalled) {
+                    currentCalled--;
+                }
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Remove all functions registered in the chain.
+     */
+    void clear(void)
+    {
+        count = 0;
+    }
+
+    /**
+     * Check whether the callchain contains any callbacks.
+     *
+     * @return true if the callchain is not empty and false otherwise.
+     */
+    bool hasCallbacksAttached(void) const
+    {
+        return (count != 0);
+    }
+
+    /**
+     * Call sequentially each member of the chain, in registration order.
+     *
+     * @param[in] context Parameter to pass to the functions called.
+     */
+    void call(ContextType context)
+    {
+        ((const CallChainOfFunctionPointersWithContext*) this)->call(context);
+    }
+
+    /**
+     * Call sequentially each member of the chain, in registration order.
+     *
+     * @param[in] context Parameter to pass to the functions called.
+     */
+    void call(ContextType context) const
+    {
+        currentCalled = 0;
+        while (currentCalled < count) {
+            functions[currentCalled].call(context);
+            currentCalled++;
+        }
+    }
+
+    /**
+     * Call sequentially each member of the chain.
+     *
+     * @param[in] context Parameter to pass to the functions called.
+     */
+    void operator()(ContextType context) const
+    {
+        call(context);
+    }
+
+    /**
+     * Test if the callchain is empty or not.
+     *
+     * @return true if the callchain is not empty and false otherwise.
+     *
+     * @note used by SafeBool to offer a safe boolean conversion.
+     */
+    bool toBool() const
+    {
+        return (count != 0);
+    }
+
+private:
+    /**
+     * Add a callback at the end of the callchain.
+     *
+     * @return A pointer to the stored callback or NULL if the chain is full.
+     */
+    pFunctionPointerWithContext_t common_add(
+        const FunctionPointerWithContext<ContextType> &func
+    ) {
+        if (count == Capacity) {
+            return NULL;
+        }
+
+        functions[count] = func;
+        return &functions[count++];
+    }
+
+private:
+    /**
+     * Inline storage of the callbacks; entries [0 : count) are registered.
+     */
+    FunctionPointerWithContext<ContextType> functions[Capacity];
+
+    /**
+     * Number of callbacks registered in the chain.
+     */
+    size_t count;
+
+    /**
+     * Index of the function being called.
+     *
+     * It is used to maintain the data structure integrity if a function is
+     * removed during the call() operation.
+     *
+     * @note It has to be mutable to accomodate the const version of call(). The
+     * iterator doesn't leak outside the object; therefore, it remains seen as
+     * const from an external standpoint.
+     */
+    mutable size_t currentCalled;
+
+    /* Disallow copy constructor and assignment operators. */
+private:
+    CallChainOfFunctionPointersWithContext(
+        const CallChainOfFunctionPointersWithContext&
+    );
+    CallChainOfFunctionPointersWithContext &operator=(
+        const CallChainOfFunctionPointersWithContext&
+    );
+};
+
+/**
+ * Specialization of the callchain for the default capacity of 0: the
+ * callbacks are stored in a heap allocated linked list, so the number of
+ * callbacks the chain accepts is not bounded, and the most recently added
+ * callback is called first.
+ *
+ * @tparam ContextType Type of the parameter accepted by the callbacks hosted
+ * in the object.
+ */
+template <typename ContextType>
+class CallChainOfFunctionPointersWithContext<ContextType, 0> :
+    public SafeBool<CallChainOfFunctionPointersWithContext<ContextType, 0> > {
 public:
     /**
      * Alias of the FunctionPointerWithContext type this object can store.
@@ -649,6 +649,59 @@ public:
         }
     };
 
+    /**
+     * Connection event start notification.
+     *
+     * Instances of this event are passed to the handler registered with
+     * Gap::onConnectionEventStart() at the anchor point of each connection
+     * event.
+     *
+     * Applications streaming sensor data can use the anchor timing to sample
+     * just before the data is transmitted instead of buffering up to a full
+     * connection interval of samples.
+     *
+     * @note Constructor is not meant to be called by user code.
+     * The BLE API vendor code generates ConnectionEventStartParams_t.
+     */
+    struct ConnectionEventStartParams_t {
+        /**
+         * ID of the connection the event belongs to.
+         */
+        Handle_t handle;
+
+        /**
+         * Timestamp of the anchor point of this connection event, in
+         * microseconds in the timebase of the vendor stack.
+         */
+        uint32_t anchorTimestamp;
+
+        /**
+         * Predicted timestamp of the anchor point of the next connection
+         * event, in the same timebase as anchorTimestamp. Unless the vendor
+         * stack predicts otherwise, this is the anchor timestamp plus the
+         * connection interval.
+         */
+        uint32_t nextAnchorTimestamp;
+
+        /**
+         * Construct a ConnectionEventStartParams_t.
+         *
+         * @param[in] handleIn Value assigned to handle.
+         * @param[in] anchorTimestampIn Value assigned to anchorTimestamp.
+         * @param[in] nextAnchorTimestampIn Value assigned to
+         * nextAnchorTimestamp.
+         */
+        ConnectionEventStartParams_t(
+            Handle_t handleIn,
+            uint32_t anchorTimestampIn,
+            uint32_t nextAnchorTimestampIn
+        ) : handle(handleIn),
+            anchorTimestamp(anchorTimestampIn),
+            nextAnchorTimestamp(nextAnchorTimestampIn)
+        {
+        }
+    };
+
     /**
      * @copydoc ble::peripheral_privacy_configuration_t
      */
@@ -733,6 +786,14 @@ public:
      */
     typedef FunctionPointerWithContext<bool> RadioNotificationEventCallback_t;
 
+    /**
+     * Connection event start handler.
+     *
+     * @see Gap::onConnectionEventStart().
+     */
+    typedef FunctionPointerWithContext<const ConnectionEventStartParams_t *>
+        ConnectionEventStartCallback_t;
+
     /**
      * Gap shutdown event handler.
      *
@@ -1935,6 +1996,25 @@ public:
     )
     virtual ble_error_t initRadioNotification(void);
 
+    /**
+     * Enable connection event start notifications.
+     *
+     * Once enabled, the handler registered with onConnectionEventStart() is
+     * invoked at the anchor point of every connection event with the anchor
+     * timestamp and a prediction of the next anchor. Applications can use it
+     * to align work with radio timing; for example, sampling a sensor just
+     * before its value is transmitted removes the need to buffer samples for
+     * up to a full connection interval.
+     *
+     * @return BLE_ERROR_NONE on successful initialization,
+     * BLE_ERROR_NOT_IMPLEMENTED if the vendor stack does not expose
+     * connection event timing and otherwise an appropriate error code.
+     *
+     * @note Unlike radio notifications, events carry the connection handle
+     * and therefore remain usable with multiple concurrent connections.
+     */
+    virtual ble_error_t initConnectionEventMonitoring(void);
+
 private:
     /**
      * Set the advertising data and scan response in the vendor subsytem.
@@ -2217,6 +2297,38 @@ public:
     )
     void onRadioNotification(T *tptr, void (T::*mptr)(bool));
 
+    /**
+     * Set the connection event start handler.
+     *
+     * The handler is invoked at the anchor point of every connection event
+     * once initConnectionEventMonitoring() has succeeded.
+     *
+     * @param[in] callback Application handler to be invoked at the start of
+     * each connection event.
+     *
+     * @attention The handler may run in interrupt context, depending on the
+     * vendor stack; it must be short and must not call BLE APIs directly.
+     */
+    void onConnectionEventStart(ConnectionEventStartCallback_t callback);
+
+    /**
+     * Set the connection event start handler.
+     *
+     * @param[in] tptr Instance to be used to invoke mptr.
+     * @param[in] mptr Application handler to be invoked at the start of each
+     * connection event.
+     *
+     * @attention The handler may run in interrupt context, depending on the
+     * vendor stack; it must be short and must not call BLE APIs directly.
+     */
+    template<typename T>
+    void onConnectionEventStart(
+        T *tptr,
+        void (T::*mptr)(const ConnectionEventStartParams_t *)
+    ) {
+        connectionEventStartCallback.attach(tptr, mptr);
+    }
+
     /**
      * Register a Gap shutdown event handler.
      *
@@ -2295,6 +2407,7 @@ public:
         connectionCallChain.clear();
         disconnectionCallChain.clear();
         radioNotificationCallback = NULL;
+        connectionEventStartCallback = NULL;
         onAdvertisementReport = NULL;
         _eventHandler = NULL;
 
@@ -2315,6 +2428,7 @@ protected:
         scanningActive(false),
         timeoutCallbackChain(),
         radioNotificationCallback(),
+        connectionEventStartCallback(),
         onAdvertisementReport(),
         connectionCallChain(),
         disconnectionCallChain()
@@ -2430,6 +2544,30 @@ public:
         disconnectionCallChain.call(&callbackParams);
     }
 
+    /**
+     * Notify the registered handler of a connection event start.
+     *
+     * @attention This function is meant to be called from the BLE stack specific
+     * implementation at the anchor point of a connection event, once
+     * initConnectionEventMonitoring() has been called.
+     *
+     * @param[in] handle Handle of the connection the event belongs to.
+     * @param[in] anchorTimestamp Timestamp of the anchor point, in
+     * microseconds in the timebase of the vendor stack.
+     * @param[in] nextAnchorTimestamp Predicted timestamp of the next anchor
+     * point, in the same timebase.
+     */
+    void processConnectionEventStart(
+        Handle_t handle,
+        uint32_t anchorTimestamp,
+        uint32_t nextAnchorTimestamp
+    ) {
+        ConnectionEventStartParams_t callbackParams(
+            handle, anchorTimestamp, nextAnchorTimestamp
+        );
+        connectionEventStartCallback.call(&callbackParams);
+    }
+
     /**
      * Forward a received advertising packet to all registered event handlers
      * listening for scanned packet events.
@@ -2576,6 +2714,12 @@ protected:
      */
     RadioNotificationEventCallback_t radioNotificationCallback;
 
+    /**
+     * The registered callback handler for connection event start
+     * notifications.
+     */
+    ConnectionEventStartCallback_t connectionEventStartCallback;
+
     /**
      * The registered callback handler for scanned advertisement packet
      * notifications.
@@ -0,0 +1,230 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_GATT_ATTRIBUTE_CACHE_H__
+#define MBED_GATT_ATTRIBUTE_CACHE_H__
+
+#include "ble/UUID.h"
+#include "ble/BLEProtocol.h"
+#include "ble/GattAttribute.h"
+#include "ble/DiscoveredCharacteristic.h"
+#include "ble/blecommon.h"
+
+/**
+ * Maximum number of characteristics the attribute cache holds per peer.
+ */
+#ifndef BLE_GATT_ATTRIBUTE_CACHE_SIZE
+#define BLE_GATT_ATTRIBUTE_CACHE_SIZE 16
+#endif
+
+/**
+ * @addtogroup ble
+ * @{
+ * @addtogroup gatt
+ * @{
+ * @addtogroup client
+ * @{
+ */
+
+/**
+ * Cache of GATT discovery results, persisted for bonded peers.
+ *
+ * @par purpose
+ *
+ * Service discovery walks the peer's full attribute table on every
+ * connection, which can take more than a second at typical connection
+ * intervals before any data flows. The Bluetooth specification allows a
+ * client to skip rediscovery for a bonded peer as long as the server's
+ * database has not changed; this class implements that: it records the
+ * characteristics reported by ServiceDiscovery, persists them in kvstore
+ * keyed by the peer identity address, and restores them on reconnection so
+ * the application can read, write and subscribe using the cached handles in
+ * the first connection event.
+ *
+ * @par validation
+ *
+ * A cache entry is stored together with the value of the peer's Database
+ * Hash characteristic (or any other change marker available, such as the
+ * Service Changed configuration). On load, the stored marker is compared
+ * against the value read from the peer; on mismatch the entry is discarded
+ * and the application falls back to full discovery.
+ *
+ * @par usage
+ *
+ * @code
+ * GattAttributeCache cache;
+ *
+ * // on connection to a bonded peer, after reading the database hash:
+ * if (cache.load(peer_address, db_hash, sizeof(db_hash))) {
+ *     const GattAttributeCache::CachedCharacteristic *c = cache.find(uuid);
+ *     // subscribe/read/write using c->value_handle immediately
+ * } else {
+ *     cache.start(peer_address);
+ *     ble.gattClient().launchServiceDiscovery(
+ *         connection, NULL, makeFunctionPointer(&cache, &GattAttributeCache::add)
+ *     );
+ *     // from the discovery termination callback:
+ *     cache.commit(db_hash, sizeof(db_hash));
+ * }
+ * @endcode
+ *
+ * @note Only cache discovery results of bonded peers: for unbonded peers the
+ * specification requires rediscovery on every connection, and an identity
+ * address is needed as a stable key.
+ */
+class GattAttributeCache {
+public:
+    /**
+     * Discovery results retained for one characteristic.
+     */
+    struct CachedCharacteristic {
+        /**
+         * The UUID of the characteristic.
+         */
+        UUID uuid;
+
+        /**
+         * Handle of the characteristic's declaration attribute.
+         */
+        GattAttribute::Handle_t decl_handle;
+
+        /**
+         * Handle used to read or write the value of the characteristic.
+         */
+        GattAttribute::Handle_t value_handle;
+
+        /**
+         * Last attribute handle of the characteristic definition; descriptors
+         * live in the range [value_handle + 1 : last_handle].
+         */
+        GattAttribute::Handle_t last_handle;
+
+        /**
+         * Characteristic properties as defined by the Bluetooth
+         * specification: bit 0 broadcast, bit 1 read, bit 2 write without
+         * response, bit 3 write, bit 4 notify, bit 5 indicate, bit 6
+         * authenticated signed write.
+         */
+        uint8_t properties;
+    };
+
+    /**
+     * Construct an empty cache.
+     */
+    GattAttributeCache();
+
+    /**
+     * Begin capturing discovery results for a peer, discarding any entries
+     * currently held in RAM.
+     *
+     * @param[in] peer_identity Identity address of the bonded peer.
+     */
+    void start(const BLEProtocol::AddressBytes_t peer_identity);
+
+    /**
+     * Record one discovered characteristic.
+     *
+     * The signature matches the characteristic callback of service
+     * discovery, so this function can be registered directly as the
+     * discovery callback. Characteristics beyond
+     * BLE_GATT_ATTRIBUTE_CACHE_SIZE are ignored.
+     *
+     * @param[in] characteristic The discovered characteristic to record.
+     */
+    void add(const DiscoveredCharacteristic *characteristic);
+
+    /**
+     * Persist the captured results in kvstore, keyed by the peer identity
+     * given to start(), together with the peer's database change marker.
+     *
+     * @param[in] database_hash Value of the peer's Database Hash
+     * characteristic, or NULL when the peer does not expose one.
+     * @param[in] hash_length Length of @p database_hash in bytes, up to 16.
+     *
+     * @return BLE_ERROR_NONE on success.
+     */
+    ble_error_t commit(const uint8_t *database_hash, size_t hash_length);
+
+    /**
+     * Restore the cached results of a peer from kvstore.
+     *
+     * The stored database change marker is compared with @p database_hash;
+     * a mismatch means the peer's attribute table changed, so the stored
+     * entry is removed and the load fails.
+     *
+     * @param[in] peer_identity Identity address of the bonded peer.
+     * @param[in] database_hash Value of the peer's Database Hash
+     * characteristic, or NULL when the peer does not expose one.
+     * @param[in] hash_length Length of @p database_hash in bytes.
+     *
+     * @return true if the cache now holds the peer's characteristics and
+     * discovery can be skipped; false if full discovery is required.
+     */
+    bool load(
+        const BLEProtocol::AddressBytes_t peer_identity,
+        const uint8_t *database_hash,
+        size_t hash_length
+    );
+
+    /**
+     * Remove the persisted results of a peer, for example when the bond is
+     * deleted or a Service Changed indication is received.
+     *
+     * @param[in] peer_identity Identity address of the peer.
+     */
+    void invalidate(const BLEProtocol::AddressBytes_t peer_identity);
+
+    /**
+     * Get the number of characteristics held in the cache.
+     *
+     * @return The number of entries accessible with at().
+     */
+    size_t count() const;
+
+    /**
+     * Access a cached characteristic by index.
+     *
+     * @param[in] index Index of the entry, in [0 : count()).
+     *
+     * @return The entry or NULL if @p index is out of range.
+     */
+    const CachedCharacteristic *at(size_t index) const;
+
+    /**
+     * Find a cached characteristic by UUID.
+     *
+     * @param[in] uuid The UUID of the characteristic searched.
+     *
+     * @return The first entry with a matching UUID or NULL if none matches.
+     */
+    const CachedCharacteristic *find(const UUID &uuid) const;
+
+private:
+    void make_key(char *key, const BLEProtocol::AddressBytes_t peer_identity) const;
+
+    CachedCharacteristic _entries[BLE_GATT_ATTRIBUTE_CACHE_SIZE];
+    size_t _count;
+    BLEProtocol::AddressBytes_t _peer_identity;
+    bool _capturing;
+};
+
+/**
+ * @}
+ * @}
+ * @}
+ */
+
+#endif /* ifndef MBED_GATT_ATTRIBUTE_CACHE_H__ */
@@ -0,0 +1,270 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_GATT_NOTIFICATION_QUEUE_H__
+#define MBED_GATT_NOTIFICATION_QUEUE_H__
+
+#include <string.h>
+
+#include "ble/GattServer.h"
+#include "ble/GattAttribute.h"
+#include "ble/Gap.h"
+
+/**
+ * @addtogroup ble
+ * @{
+ * @addtogroup gatt
+ * @{
+ * @addtogroup server
+ * @{
+ */
+
+/**
+ * Queue of characteristic value updates flushed as the controller's
+ * transmit buffers drain.
+ *
+ * @par purpose
+ *
+ * GattServer::write() fails with BLE_STACK_BUSY when the controller has no
+ * free transmit buffer, which forces every application streaming
+ * notifications to hand-roll retry timers. This class queues the update
+ * instead and retries from the onDataSent() event, which fires exactly when
+ * transmit buffers become available again. Because a write is attempted
+ * again as soon as a buffer frees up, the controller's queue is kept full
+ * and the link layer can pack several notifications into each connection
+ * event, where the stack supports it.
+ *
+ * @par coalescing
+ *
+ * Updates queued with coalescing enabled (the default) represent current
+ * state, such as a sensor reading: if an update for the same characteristic
+ * and connection is already waiting, its value is overwritten in place
+ * rather than queued behind it. A stale reading is never sent when a fresh
+ * one is available, and a slow link degrades to a lower update rate instead
+ * of a growing backlog. Queue updates with coalescing disabled when every
+ * value must reach the client, for example samples of a waveform.
+ *
+ * @par usage
+ *
+ * @code
+ * GattNotificationQueue<> updates(ble.gattServer());
+ *
+ * // in the sensor acquisition path, instead of gattServer().write():
+ * updates.enqueue(
+ *     connection, imu_characteristic.getValueHandle(), sample, sizeof(sample)
+ * );
+ * @endcode
+ *
+ * @par context
+ *
+ * Like the rest of the BLE API, this class is not synchronized; call it from
+ * the same execution context that processes BLE events.
+ *
+ * @tparam QueueSize Maximum number of updates waiting for a transmit buffer.
+ * @tparam MaxValueSize Largest characteristic value that can be queued, in
+ * bytes. The default fits a notification in the minimum ATT_MTU.
+ */
+template <size_t QueueSize = 8, size_t MaxValueSize = 20>
+class GattNotificationQueue {
+public:
+    /**
+     * Construct a notification queue operating on @p server.
+     *
+     * The constructor registers an onDataSent() handler on the server; the
+     * queue must outlive the server's use of that handler, so instantiate it
+     * with static or application lifetime.
+     *
+     * @param[in] server The GattServer updates are written to.
+     */
+    GattNotificationQueue(GattServer &server) :
+        _server(server),
+        _head(0),
+        _count(0),
+        _dropped(0)
+    {
+        _server.onDataSent(this, &GattNotificationQueue::on_data_sent);
+    }
+
+    /**
+     * Update a characteristic value, queueing the update if the stack is
+     * busy.
+     *
+     * The update is first attempted directly; BLE_STACK_BUSY is absorbed by
+     * placing the value in the queue, to be retried when the controller
+     * reports free transmit buffers through onDataSent().
+     *
+     * @param[in] connectionHandle Connection to notify.
+     * @param[in] attributeHandle Handle for the value attribute of the
+     * characteristic.
+     * @param[in] value A pointer to a buffer holding the new value.
+     * @param[in] size Size of the new value (in bytes).
+     * @param[in] coalesce If true and an update for the same characteristic
+     * and connection is already queued, overwrite its value instead of
+     * queueing another update.
+     *
+     * @return BLE_ERROR_NONE if the update has been sent or queued,
+     * BLE_ERROR_PARAM_OUT_OF_RANGE if the value does not fit in an entry or
+     * BLE_ERROR_NO_MEM if the queue is full.
+     */
+    ble_error_t enqueue(
+        Gap::Handle_t connectionHandle,
+        GattAttribute::Handle_t attributeHandle,
+        const uint8_t *value,
+        uint16_t size,
+        bool coalesce = true
+    ) {
+        if (size > MaxValueSize) {
+            return BLE_ERROR_PARAM_OUT_OF_RANGE;
+        }
+
+        /* Preserve ordering: never overtake updates already waiting. */
+        if (_count == 0) {
+            ble_error_t err = _server.write(
+                connectionHandle, attributeHandle, value, size
+            );
+            if (err != BLE_STACK_BUSY) {
+                return err;
+            }
+        }
+
+        if (coalesce) {
+            Entry *entry = find(connectionHandle, attributeHandle);
+            if (entry) {
+                memcpy(entry->value, value, size);
+                entry->length = size;
+                return BLE_ERROR_NONE;
+            }
+        }
+
+        if (_count == QueueSize) {
+            _dropped++;
+            return BLE_ERROR_NO_MEM;
+        }
+
+        Entry &entry = _entries[(_head + _count) % QueueSize];
+        entry.connection = connectionHandle;
+        entry.attribute = attributeHandle;
+        entry.length = size;
+        entry.coalesce = coalesce;
+        memcpy(entry.value, value, size);
+        _count++;
+
+        return BLE_ERROR_NONE;
+    }
+
+    /**
+     * Write queued updates to the stack until it reports busy or the queue
+     * is empty.
+     *
+     * This runs automatically from the onDataSent() event; applications only
+     * need it to drain the queue eagerly, for example after raising the
+     * connection interval.
+     */
+    void flush()
+    {
+        while (_count) {
+            Entry &entry = _entries[_head];
+            ble_error_t err = _server.write(
+                entry.connection, entry.attribute, entry.value, entry.length
+            );
+            if (err == BLE_STACK_BUSY) {
+                return;
+            }
+            /* Sent, or failed for a reason waiting cannot fix (for example
+             * the client disconnected); either way the entry is done. */
+            if (err != BLE_ERROR_NONE) {
+                _dropped++;
+            }
+            _head = (_head + 1) % QueueSize;
+            _count--;
+        }
+    }
+
+    /**
+     * Get the number of updates waiting for a transmit buffer.
+     *
+     * @return The number of queued updates.
+     */
+    size_t pending() const
+    {
+        return _count;
+    }
+
+    /**
+     * Get the number of updates lost since construction, either because the
+     * queue was full or because a queued write failed with an error other
+     * than BLE_STACK_BUSY.
+     *
+     * @return The number of dropped updates.
+     */
+    uint32_t dropped() const
+    {
+        return _dropped;
+    }
+
+    /**
+     * Discard all queued updates, for example on disconnection.
+     */
+    void reset()
+    {
+        _head = 0;
+        _count = 0;
+    }
+
+private:
+    struct Entry {
+        Gap::Handle_t connection;
+        GattAttribute::Handle_t attribute;
+        uint16_t length;
+        bool coalesce;
+        uint8_t value[MaxValueSize];
+    };
+
+    void on_data_sent(unsigned count)
+    {
+        (void)count;
+        flush();
+    }
+
+    Entry *find(
+        Gap::Handle_t connectionHandle,
+        GattAttribute::Handle_t attributeHandle
+    ) {
+        for (size_t i = 0; i < _count; i++) {
+            Entry &entry = _entries[(_head + i) % QueueSize];
+            if (entry.coalesce &&
+                    entry.connection == connectionHandle &&
+                    entry.attribute == attributeHandle) {
+                return &entry;
+            }
+        }
+        return NULL;
+    }
+
+    GattServer &_server;
+    Entry _entries[QueueSize];
+    size_t _head;
+    size_t _count;
+    uint32_t _dropped;
+};
+
+/**
+ * @}
+ * @}
+ * @}
+ */
+
+#endif /* ifndef MBED_GATT_NOTIFICATION_QUEUE_H__ */
@@ -32,6 +32,18 @@
  * @{
  */
 
+/**
+ * UUID constructors are usable in constant expressions when the toolchain
+ * dialect allows it (C++14 relaxed constexpr); UUID objects with static
+ * storage duration are then built at compile time and can live in read-only
+ * memory. On older dialects, the constructors compile as plain runtime code.
+ */
+#if defined(__cplusplus) && (__cplusplus >= 201402L)
+#define BLE_UUID_CONSTEXPR constexpr
+#else
+#define BLE_UUID_CONSTEXPR
+#endif
+
 /**
  * Convert a character containing an hexadecimal digit into an unsigned integer.
  *
@@ -39,7 +51,7 @@
  *
  * @return The corresponding value as unsigned integer.
  */
-static uint8_t char2int(char c)
+static BLE_UUID_CONSTEXPR uint8_t char2int(char c)
 {
     if ((c >= '0') && (c <= '9')) {
         return c - '0';
@@ -143,16 +155,21 @@ public:
      *
      * @note Internally, the UUID is stored in the little endian order as a
      * 16-byte array.
+     *
+     * @note When built as C++14 or later, this constructor is constexpr: a
+     * UUID declared constexpr from a string literal is parsed at compile time
+     * and placed in read-only memory.
      */
-    UUID(const char* stringUUID) :
+    BLE_UUID_CONSTEXPR UUID(const char* stringUUID) :
         type(UUID_TYPE_LONG),
         baseUUID(),
-        shortUUID(0)
+        shortUUID(0),
+        shortened(false)
     {
         bool nibble = false;
         uint8_t byte = 0;
         size_t baseIndex = 0;
-        uint8_t tempUUID[LENGTH_OF_LONG_UUID];
+        uint8_t tempUUID[LENGTH_OF_LONG_UUID] = { 0 };
 
         /*
          * Iterate through string; abort if NULL is encountered prematurely.
@@ -195,7 +212,7 @@ public:
      * @param[in] longUUID The 128-bit (16-byte) of the UUID value.
      * @param[in] order Bytes order of @p longUUID.
      */
-    UUID(const LongUUIDBytes_t longUUID, ByteOrder_t order = UUID::MSB) : type(UUID_TYPE_LONG), baseUUID(), shortUUID(0) {
+    BLE_UUID_CONSTEXPR UUID(const LongUUIDBytes_t longUUID, ByteOrder_t order = UUID::MSB) : type(UUID_TYPE_LONG), baseUUID(), shortUUID(0), shortened(false) {
         setupLong(longUUID, order);
     }
 
@@ -215,10 +232,11 @@ public:
      * @note User defined UUIDs are commonly named vendor-specific UUIDs across
      * the Bluetooth literature.
      */
-    UUID(ShortUUIDBytes_t _shortUUID) :
+    BLE_UUID_CONSTEXPR UUID(ShortUUIDBytes_t _shortUUID) :
         type(UUID_TYPE_SHORT),
         baseUUID(),
-        shortUUID(_shortUUID) {
+        shortUUID(_shortUUID),
+        shortened(false) {
     }
 
     /**
@@ -226,11 +244,15 @@ public:
      *
      * @param[in] source The UUID to copy.
      */
-    UUID(const UUID &source)
+    BLE_UUID_CONSTEXPR UUID(const UUID &source) :
+        type(source.type),
+        baseUUID(),
+        shortUUID(source.shortUUID),
+        shortened(source.shortened)
     {
-        type      = source.type;
-        shortUUID = source.shortUUID;
-        memcpy(baseUUID, source.baseUUID, LENGTH_OF_LONG_UUID);
+        for (size_t i = 0; i < LENGTH_OF_LONG_UUID; i++) {
+            baseUUID[i] = source.baseUUID[i];
+        }
     }
 
     /**
@@ -241,9 +263,11 @@ public:
      * @post shortOrLong() returns the value UUID_TYPE_SHORT.
      * @post getShortUUID() returns the value BLE_UUID_UNKNOWN.
      */
-    UUID(void) :
+    BLE_UUID_CONSTEXPR UUID(void) :
         type(UUID_TYPE_SHORT),
-        shortUUID(BLE_UUID_UNKNOWN) {
+        baseUUID(),
+        shortUUID(BLE_UUID_UNKNOWN),
+        shortened(false) {
     }
 
     /**
@@ -252,19 +276,20 @@ public:
      * @param[in] longUUID New 16-byte wide UUID value.
      * @param[in] order Byte ordering of @p longUUID.
      */
-    void setupLong(const LongUUIDBytes_t longUUID, ByteOrder_t order = UUID::MSB)
+    BLE_UUID_CONSTEXPR void setupLong(const LongUUIDBytes_t longUUID, ByteOrder_t order = UUID::MSB)
     {
         type = UUID_TYPE_LONG;
-        if (order == UUID::MSB) {
+        for (size_t i = 0; i < LENGTH_OF_LONG_UUID; i++) {
             /*
-             * Switch endian. Input is big-endian, internal representation
-             * is little endian.
+             * Switch endian when the input is big-endian; internal
+             * representation is little endian.
              */
-            std::reverse_copy(longUUID, longUUID + LENGTH_OF_LONG_UUID, baseUUID);
-        } else {
-            std::copy(longUUID, longUUID + LENGTH_OF_LONG_UUID, baseUUID);
+            baseUUID[i] = (order == UUID::MSB) ?
+                longUUID[LENGTH_OF_LONG_UUID - 1 - i] :
+                longUUID[i];
         }
         shortUUID = (uint16_t)((baseUUID[13] << 8) | (baseUUID[12]));
+        shortened = isBluetoothBase(baseUUID);
     }
 
 public:
@@ -333,9 +358,18 @@ public:
             return true;
         }
 
-        if ((this->type == UUID_TYPE_LONG) && (other.type == UUID_TYPE_LONG) &&
-            (memcmp(this->baseUUID, other.baseUUID, LENGTH_OF_LONG_UUID) == 0)) {
-            return true;
+        if ((this->type == UUID_TYPE_LONG) && (other.type == UUID_TYPE_LONG)) {
+            /*
+             * Both values sit on the Bluetooth base UUID: the 16-bit parts
+             * are the only bytes that can differ. When only one of them does,
+             * some byte outside the 16-bit part differs, so the UUIDs cannot
+             * be equal.
+             */
+            if (this->shortened || other.shortened) {
+                return (this->shortened == other.shortened) &&
+                       (this->shortUUID == other.shortUUID);
+            }
+            return memcmp(this->baseUUID, other.baseUUID, LENGTH_OF_LONG_UUID) == 0;
         }
 
         return false;
@@ -354,6 +388,29 @@ public:
     }
 
 private:
+    /**
+     * Indicate whether a UUID in the internal (little-endian) representation
+     * sits on the Bluetooth base UUID 0000xxxx-0000-1000-8000-00805F9B34FB.
+     *
+     * @param[in] uuid UUID value in little-endian byte order.
+     *
+     * @return true if all bytes outside the 16-bit part match the base UUID.
+     */
+    static BLE_UUID_CONSTEXPR bool isBluetoothBase(const uint8_t *uuid)
+    {
+        const uint8_t base[LENGTH_OF_LONG_UUID] = {
+            0xFB, 0x34, 0x9B, 0x5F, 0x80, 0x00, 0x00, 0x80,
+            0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+        };
+        for (size_t i = 0; i < LENGTH_OF_LONG_UUID; i++) {
+            /* Bytes 12 and 13 hold the 16-bit part. */
+            if ((i != 12) && (i != 13) && (uuid[i] != base[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     /**
      * Representation type of the UUID.
      */
@@ -368,6 +425,12 @@ private:
      * Container of UUID value if the UUID type is equal to UUID_TYPE_SHORT.
      */
     ShortUUIDBytes_t shortUUID;
+
+    /**
+     * Set for 128-bit UUIDs sitting on the Bluetooth base UUID; it lets
+     * operator== compare the 16-bit parts instead of the full 16 bytes.
+     */
+    bool shortened;
 };
 
 /**
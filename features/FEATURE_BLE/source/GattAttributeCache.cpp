@@ -0,0 +1,244 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ble/GattAttributeCache.h"
+#include "kvstore_global_api.h"
+#include "mbed_error.h"
+
+namespace {
+
+/* Serialized layout, all integers little-endian:
+ *   header: version(1), count(1), hash_length(1), hash(16)
+ *   record: uuid_length(1), uuid(16), decl(2), value(2), last(2), props(1)
+ * Long UUIDs are stored in the UUID class internal (little-endian) order so
+ * they round-trip byte for byte. */
+const uint8_t CACHE_VERSION = 1;
+const size_t MAX_HASH_LENGTH = 16;
+const size_t HEADER_LENGTH = 3 + MAX_HASH_LENGTH;
+const size_t RECORD_LENGTH = 1 + UUID::LENGTH_OF_LONG_UUID + 2 + 2 + 2 + 1;
+const size_t BLOB_LENGTH =
+    HEADER_LENGTH + (BLE_GATT_ATTRIBUTE_CACHE_SIZE * RECORD_LENGTH);
+
+/* "/kv/ble_gatt_cache_" + 12 hex digits + '\0' */
+const size_t KEY_LENGTH = 19 + (BLEProtocol::ADDR_LEN * 2) + 1;
+
+void write_u16(uint8_t *p, uint16_t value)
+{
+    p[0] = (uint8_t)(value & 0xFF);
+    p[1] = (uint8_t)(value >> 8);
+}
+
+uint16_t read_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+uint8_t properties_to_byte(const DiscoveredCharacteristic::Properties_t &props)
+{
+    return (props.broadcast() ? 0x01 : 0) |
+           (props.read() ? 0x02 : 0) |
+           (props.writeWoResp() ? 0x04 : 0) |
+           (props.write() ? 0x08 : 0) |
+           (props.notify() ? 0x10 : 0) |
+           (props.indicate() ? 0x20 : 0) |
+           (props.authSignedWrite() ? 0x40 : 0);
+}
+
+} // end of anonymous namespace
+
+GattAttributeCache::GattAttributeCache() :
+    _count(0),
+    _capturing(false)
+{
+    memset(_peer_identity, 0, sizeof(_peer_identity));
+}
+
+void GattAttributeCache::start(const BLEProtocol::AddressBytes_t peer_identity)
+{
+    memcpy(_peer_identity, peer_identity, BLEProtocol::ADDR_LEN);
+    _count = 0;
+    _capturing = true;
+}
+
+void GattAttributeCache::add(const DiscoveredCharacteristic *characteristic)
+{
+    if (!_capturing || characteristic == NULL ||
+            _count >= BLE_GATT_ATTRIBUTE_CACHE_SIZE) {
+        return;
+    }
+
+    CachedCharacteristic &entry = _entries[_count++];
+    entry.uuid = characteristic->getUUID();
+    entry.decl_handle = characteristic->getDeclHandle();
+    entry.value_handle = characteristic->getValueHandle();
+    entry.last_handle = characteristic->getLastHandle();
+    entry.properties = properties_to_byte(characteristic->getProperties());
+}
+
+ble_error_t GattAttributeCache::commit(
+    const uint8_t *database_hash,
+    size_t hash_length
+)
+{
+    if (!_capturing) {
+        return BLE_ERROR_OPERATION_NOT_PERMITTED;
+    }
+    if (hash_length > MAX_HASH_LENGTH ||
+            (database_hash == NULL && hash_length != 0)) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+    _capturing = false;
+
+    uint8_t blob[BLOB_LENGTH];
+    memset(blob, 0, sizeof(blob));
+    blob[0] = CACHE_VERSION;
+    blob[1] = (uint8_t)_count;
+    blob[2] = (uint8_t)hash_length;
+    if (hash_length) {
+        memcpy(&blob[3], database_hash, hash_length);
+    }
+
+    uint8_t *record = &blob[HEADER_LENGTH];
+    for (size_t i = 0; i < _count; i++) {
+        const CachedCharacteristic &entry = _entries[i];
+        record[0] = entry.uuid.getLen();
+        memcpy(&record[1], entry.uuid.getBaseUUID(), entry.uuid.getLen());
+        write_u16(&record[17], entry.decl_handle);
+        write_u16(&record[19], entry.value_handle);
+        write_u16(&record[21], entry.last_handle);
+        record[23] = entry.properties;
+        record += RECORD_LENGTH;
+    }
+
+    char key[KEY_LENGTH];
+    make_key(key, _peer_identity);
+
+    int err = kv_set(
+        key, blob, HEADER_LENGTH + (_count * RECORD_LENGTH), 0
+    );
+    return (err == MBED_SUCCESS) ? BLE_ERROR_NONE : BLE_ERROR_INTERNAL_STACK_FAILURE;
+}
+
+bool GattAttributeCache::load(
+    const BLEProtocol::AddressBytes_t peer_identity,
+    const uint8_t *database_hash,
+    size_t hash_length
+)
+{
+    _count = 0;
+    _capturing = false;
+    memcpy(_peer_identity, peer_identity, BLEProtocol::ADDR_LEN);
+
+    char key[KEY_LENGTH];
+    make_key(key, peer_identity);
+
+    uint8_t blob[BLOB_LENGTH];
+    size_t actual_size = 0;
+    if (kv_get(key, blob, sizeof(blob), &actual_size) != MBED_SUCCESS) {
+        return false;
+    }
+    if (actual_size < HEADER_LENGTH || blob[0] != CACHE_VERSION) {
+        kv_remove(key);
+        return false;
+    }
+
+    /* The peer's database changed since the entry was stored: discard it
+     * and force full rediscovery. */
+    if (blob[2] != hash_length ||
+            (hash_length && memcmp(&blob[3], database_hash, hash_length) != 0)) {
+        kv_remove(key);
+        return false;
+    }
+
+    size_t count = blob[1];
+    if (count > BLE_GATT_ATTRIBUTE_CACHE_SIZE ||
+            actual_size < HEADER_LENGTH + (count * RECORD_LENGTH)) {
+        kv_remove(key);
+        return false;
+    }
+
+    const uint8_t *record = &blob[HEADER_LENGTH];
+    for (size_t i = 0; i < count; i++) {
+        CachedCharacteristic &entry = _entries[i];
+        if (record[0] == UUID::LENGTH_OF_LONG_UUID) {
+            entry.uuid.setupLong(&record[1], UUID::LSB);
+        } else {
+            entry.uuid = UUID(read_u16(&record[1]));
+        }
+        entry.decl_handle = read_u16(&record[17]);
+        entry.value_handle = read_u16(&record[19]);
+        entry.last_handle = read_u16(&record[21]);
+        entry.properties = record[23];
+        record += RECORD_LENGTH;
+    }
+    _count = count;
+
+    return true;
+}
+
+void GattAttributeCache::invalidate(const BLEProtocol::AddressBytes_t peer_identity)
+{
+    char key[KEY_LENGTH];
+    make_key(key, peer_identity);
+    kv_remove(key);
+
+    if (memcmp(peer_identity, _peer_identity, BLEProtocol::ADDR_LEN) == 0) {
+        _count = 0;
+        _capturing = false;
+    }
+}
+
+size_t GattAttributeCache::count() const
+{
+    return _count;
+}
+
+const GattAttributeCache::CachedCharacteristic *GattAttributeCache::at(
+    size_t index
+) const
+{
+    if (index >= _count) {
+        return NULL;
+    }
+    return &_entries[index];
+}
+
+const GattAttributeCache::CachedCharacteristic *GattAttributeCache::find(
+    const UUID &uuid
+) const
+{
+    for (size_t i = 0; i < _count; i++) {
+        if (_entries[i].uuid == uuid) {
+            return &_entries[i];
+        }
+    }
+    return NULL;
+}
+
+void GattAttributeCache::make_key(
+    char *key,
+    const BLEProtocol::AddressBytes_t peer_identity
+) const
+{
+    sprintf(
+        key, "/kv/ble_gatt_cache_%02x%02x%02x%02x%02x%02x",
+        peer_identity[5], peer_identity[4], peer_identity[3],
+        peer_identity[2], peer_identity[1], peer_identity[0]
+    );
+}
@@ -288,6 +288,13 @@ ble_error_t Gap::initRadioNotification(void)
     return BLE_ERROR_NOT_IMPLEMENTED;
 }
 
+ble_error_t Gap::initConnectionEventMonitoring(void)
+{
+    /* Requesting action from porter(s): override this API if this capability
+       is supported. */
+    return BLE_ERROR_NOT_IMPLEMENTED;
+}
+
 
 #if defined(__GNUC__) && !defined(__CC_ARM)
 #pragma GCC diagnostic push
@@ -594,6 +601,11 @@ void Gap::onRadioNotification(void (*callback)(bool param))
     radioNotificationCallback.attach(callback);
 }
 
+void Gap::onConnectionEventStart(ConnectionEventStartCallback_t callback)
+{
+    connectionEventStartCallback = callback;
+}
+
 void Gap::onShutdown(const GapShutdownCallback_t& callback)
 {
     shutdownCallChain.add(callback);
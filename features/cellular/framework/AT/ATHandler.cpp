@@ -442,22 +442,47 @@ ssize_t ATHandler::read_bytes(uint8_t *buf, size_t len)
         return -1;
     }
 
-    bool debug_on = _debug_on;
     size_t read_len = 0;
-    for (; read_len < len; read_len++) {
-        int c = get_char();
-        if (c == -1) {
+
+    // Drain what the parser has already buffered
+    if (_recv_pos < _recv_len) {
+        read_len = _recv_len - _recv_pos;
+        if (read_len > len) {
+            read_len = len;
+        }
+        memcpy(buf, _recv_buff + _recv_pos, read_len);
+        _recv_pos += read_len;
+    }
+
+    // The rest of the payload is binary with a known length, so transfer it
+    // from the file handle straight into the caller's buffer in chunks
+    // instead of a char at a time through the parse buffer
+    while (read_len < len) {
+        pollfh fhs;
+        fhs.fh = _fileHandle;
+        fhs.events = POLLIN;
+        int count = poll(&fhs, 1, poll_timeout());
+        if (count <= 0 || !(fhs.revents & POLLIN)) {
+            tr_warn("AT timeout");
             set_error(NSAPI_ERROR_DEVICE_ERROR);
-            _debug_on = debug_on;
             return -1;
         }
-        buf[read_len] = c;
-        if (_debug_on && read_len >= DEBUG_MAXLEN) {
-            debug_print("..", sizeof(".."));
-            _debug_on = false;
+        ssize_t ret = _fileHandle->read(buf + read_len, len - read_len);
+        if (ret < 0) {
+            set_error(NSAPI_ERROR_DEVICE_ERROR);
+            return -1;
+        }
+        // Data read directly bypasses fill_buffer(), so print it here
+        if (_debug_on && read_len < DEBUG_MAXLEN) {
+            if (read_len + ret < DEBUG_MAXLEN) {
+                debug_print((char *)buf + read_len, ret);
+            } else {
+                debug_print("..", sizeof(".."));
+            }
         }
+        read_len += ret;
     }
-    _debug_on = debug_on;
+
     return read_len;
 }
 
@@ -692,8 +717,17 @@ bool ATHandler::match(const char *str, size_t size)
 bool ATHandler::match_urc()
 {
     rewind_buffer();
+    if (_recv_len == 0) {
+        return false;
+    }
+    const char first = _recv_buff[0];
     size_t prefix_len = 0;
     for (struct oob_t *oob = _oobs; oob; oob = oob->next) {
+        // Cheap first-byte reject, so the registered URCs cost one compare
+        // each per parsed line instead of a full prefix compare
+        if (oob->prefix[0] != first) {
+            continue;
+        }
         prefix_len = oob->prefix_len;
         if (_recv_len >= prefix_len) {
             if (match(oob->prefix, prefix_len)) {
@@ -228,6 +228,12 @@ public:
     /** Starts the command writing by clearing the last error and writing the given command.
      *  In case of failure when writing, the last error is set to NSAPI_ERROR_DEVICE_ERROR.
      *
+     *  Commands can be pipelined: independent commands may be written back-to-back with
+     *  cmd_start()/cmd_stop() before any response is read, and their responses then read
+     *  in the same order with resp_start()/resp_stop(). The modem answers in request
+     *  order, so this cuts a sequence of round trips down to roughly one. Only pipeline
+     *  commands whose failure does not change how the next one is interpreted.
+     *
      *  @param cmd  AT command to be written to modem
      */
     virtual void cmd_start(const char *cmd);
@@ -306,6 +312,8 @@ public:
     void skip_param(ssize_t len, uint32_t count);
 
     /** Reads given number of bytes from receiving buffer without checking any subparameter delimiters, such as comma.
+     *  Bytes beyond the receiving buffer are transferred from the file handle directly into buf in bulk,
+     *  so this is the preferred way to read long length-prefixed binary payloads.
      *
      *  @param buf output buffer for the read
      *  @param len maximum number of bytes to read
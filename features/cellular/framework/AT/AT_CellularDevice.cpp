@@ -25,6 +25,7 @@
 #include "AT_CellularStack.h"
 #include "CellularLog.h"
 #include "ATHandler.h"
+#include "CellularMux.h"
 #include "UARTSerial.h"
 #include "FileHandle.h"
 
@@ -33,8 +34,13 @@ using namespace mbed;
 
 #define DEFAULT_AT_TIMEOUT 1000 // at default timeout in milliseconds
 
+// Mux channel assignment when a multiplexer is set. Which DLCI carries what
+// is our convention, not the modem's - it sees independent channels.
+#define CMUX_COMMAND_DLCI 1 // shared command/data path
+#define CMUX_SMS_DLCI 2     // SMS and its URCs, isolated from the data path
+
 AT_CellularDevice::AT_CellularDevice(FileHandle *fh) : CellularDevice(fh), _atHandlers(0), _network(0), _sms(0),
-    _sim(0), _power(0), _information(0), _context_list(0), _default_timeout(DEFAULT_AT_TIMEOUT),
+    _sim(0), _power(0), _information(0), _context_list(0), _mux(0), _default_timeout(DEFAULT_AT_TIMEOUT),
     _modem_debug_on(false)
 {
 }
@@ -72,11 +78,21 @@ AT_CellularDevice::~AT_CellularDevice()
     }
 }
 
-// each parser is associated with one filehandle (that is UART)
+void AT_CellularDevice::set_multiplexer(CellularMux *mux)
+{
+    _mux = mux;
+}
+
+// each parser is associated with one filehandle (that is UART or mux channel)
 ATHandler *AT_CellularDevice::get_at_handler(FileHandle *fileHandle)
 {
     if (!fileHandle) {
-        fileHandle = _fh;
+        if (_mux) {
+            fileHandle = _mux->get_channel(CMUX_COMMAND_DLCI);
+        }
+        if (!fileHandle) {
+            fileHandle = _fh;
+        }
     }
     ATHandler *atHandler = _atHandlers;
     while (atHandler) {
@@ -193,6 +209,12 @@ CellularNetwork *AT_CellularDevice::open_network(FileHandle *fh)
 CellularSMS *AT_CellularDevice::open_sms(FileHandle *fh)
 {
     if (!_sms) {
+        if (!fh && _mux) {
+            // Own channel and ATHandler for SMS: its URCs never interleave
+            // with data-path transactions. Falls through to the shared
+            // handler if the channel cannot be opened.
+            fh = _mux->get_channel(CMUX_SMS_DLCI);
+        }
         ATHandler *atHandler = get_at_handler(fh);
         if (atHandler) {
             _sms = open_sms_impl(*atHandler);
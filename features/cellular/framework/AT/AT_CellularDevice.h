@@ -23,6 +23,7 @@
 namespace mbed {
 
 class ATHandler;
+class CellularMux;
 class AT_CellularInformation;
 class AT_CellularNetwork;
 class AT_CellularPower;
@@ -72,6 +73,22 @@ public:
 
     virtual nsapi_error_t init_module();
 
+    /** Route AT subsystems over a 27.010 multiplexer.
+     *
+     *  Call after CellularMux::start(). Subsystems opened afterwards
+     *  without an explicit file handle take their channels from the mux:
+     *  the shared command path runs on DLCI 1 and SMS gets its own DLCI
+     *  with its own ATHandler, so unsolicited result codes such as +CMTI
+     *  arrive on a separate channel with separate parser state and never
+     *  force the data-path parser to rewind and rescan mid-transaction.
+     *
+     *  Subsystems already open keep the handler they were opened with.
+     *
+     *  @param mux  Started multiplexer, or NULL to open subsequent
+     *              subsystems on the plain modem file handle again
+     */
+    void set_multiplexer(CellularMux *mux);
+
     ATHandler *_atHandlers;
 
     ATHandler *get_at_handler(FileHandle *fh);
@@ -134,6 +151,7 @@ public:
     AT_CellularPower *_power;
     AT_CellularInformation *_information;
     AT_CellularContext *_context_list;
+    CellularMux *_mux;
     int _default_timeout;
     bool _modem_debug_on;
 };
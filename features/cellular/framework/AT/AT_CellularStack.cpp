@@ -15,9 +15,13 @@
  * limitations under the License.
  */
 
+#include <stdlib.h>
 #include "AT_CellularStack.h"
 #include "CellularUtil.h"
 #include "CellularLog.h"
+#if MBED_CONF_CELLULAR_TCP_COALESCE_WINDOW > 0
+#include "events/mbed_events.h"
+#endif
 
 using namespace mbed_cellular_util;
 using namespace mbed;
@@ -172,6 +176,18 @@ nsapi_error_t AT_CellularStack::socket_close(nsapi_socket_t handle)
 
     // Close the socket on the modem if it was created
     _at.lock();
+#if MBED_CONF_CELLULAR_TCP_COALESCE_WINDOW > 0
+    if (socket->tx_flush_id) {
+        mbed::mbed_event_queue()->cancel(socket->tx_flush_id);
+        socket->tx_flush_id = 0;
+    }
+    if (sock_created) {
+        // best effort, data still unsent after this is lost with the socket
+        flush_tx_buffer(socket);
+    }
+    free(socket->tx_buf);
+    socket->tx_buf = NULL;
+#endif
     if (sock_created) {
         err = socket_close_impl(sock_id);
     }
@@ -273,7 +289,15 @@ nsapi_size_or_error_t AT_CellularStack::socket_sendto(nsapi_socket_t handle, con
 
     _at.lock();
 
+#if MBED_CONF_CELLULAR_TCP_COALESCE_WINDOW > 0
+    if (socket->proto == NSAPI_TCP) {
+        ret_val = send_coalesced(socket, addr, data, size);
+    } else {
+        ret_val = socket_sendto_impl(socket, addr, data, size);
+    }
+#else
     ret_val = socket_sendto_impl(socket, addr, data, size);
+#endif
 
     _at.unlock();
 
@@ -286,6 +310,107 @@ nsapi_size_or_error_t AT_CellularStack::socket_sendto(nsapi_socket_t handle, con
     return ret_val;
 }
 
+#if MBED_CONF_CELLULAR_TCP_COALESCE_WINDOW > 0
+nsapi_size_or_error_t AT_CellularStack::send_coalesced(CellularSocket *socket, const SocketAddress &addr,
+                                                       const void *data, nsapi_size_t size)
+{
+    // Large writes go to the modem directly, after any buffered data so the
+    // stream stays in order
+    if (size >= MBED_CONF_CELLULAR_TCP_COALESCE_BUFFER) {
+        nsapi_size_or_error_t err = flush_tx_buffer(socket);
+        if (err < 0) {
+            return err;
+        }
+        if (socket->tx_len > 0) {
+            // modem did not take the buffered data, can't overtake it
+            return NSAPI_ERROR_WOULD_BLOCK;
+        }
+        return socket_sendto_impl(socket, addr, data, size);
+    }
+
+    if (!socket->tx_buf) {
+        socket->tx_buf = (uint8_t *)malloc(MBED_CONF_CELLULAR_TCP_COALESCE_BUFFER);
+        if (!socket->tx_buf) {
+            return socket_sendto_impl(socket, addr, data, size);
+        }
+    }
+
+    if (socket->tx_len + size > MBED_CONF_CELLULAR_TCP_COALESCE_BUFFER) {
+        nsapi_size_or_error_t err = flush_tx_buffer(socket);
+        if (err < 0) {
+            return err;
+        }
+        if (socket->tx_len + size > MBED_CONF_CELLULAR_TCP_COALESCE_BUFFER) {
+            return NSAPI_ERROR_WOULD_BLOCK;
+        }
+    }
+
+    memcpy(socket->tx_buf + socket->tx_len, data, size);
+    socket->tx_len += size;
+
+    if (!socket->tx_flush_id) {
+        socket->tx_flush_id = mbed::mbed_event_queue()->call_in(MBED_CONF_CELLULAR_TCP_COALESCE_WINDOW,
+                                                                callback(this, &AT_CellularStack::flush_tx_event), socket);
+        if (!socket->tx_flush_id) {
+            // no room on the event queue, send now rather than leave data sitting
+            nsapi_size_or_error_t err = flush_tx_buffer(socket);
+            if (err < 0) {
+                return err;
+            }
+        }
+    }
+
+    return size;
+}
+
+nsapi_size_or_error_t AT_CellularStack::flush_tx_buffer(CellularSocket *socket)
+{
+    if (!socket->tx_buf || socket->tx_len == 0) {
+        return NSAPI_ERROR_OK;
+    }
+
+    nsapi_size_or_error_t sent = socket_sendto_impl(socket, socket->remoteAddress, socket->tx_buf, socket->tx_len);
+    if (sent == NSAPI_ERROR_WOULD_BLOCK) {
+        // keep the data buffered, retried on the next write or flush event
+        return NSAPI_ERROR_OK;
+    }
+    if (sent < 0) {
+        tr_error("Socket %d flush error %d", find_socket_index(socket), sent);
+        return sent;
+    }
+
+    tr_info("Socket %d sent %d coalesced bytes", find_socket_index(socket), sent);
+
+    if ((nsapi_size_t)sent < socket->tx_len) {
+        memmove(socket->tx_buf, socket->tx_buf + sent, socket->tx_len - sent);
+    }
+    socket->tx_len -= sent;
+
+    return NSAPI_ERROR_OK;
+}
+
+void AT_CellularStack::flush_tx_event(CellularSocket *socket)
+{
+    _at.lock();
+
+    // the socket may have been closed (and deleted) before this event ran
+    if (find_socket_index(socket) == -1) {
+        _at.unlock();
+        return;
+    }
+
+    socket->tx_flush_id = 0;
+    flush_tx_buffer(socket);
+    if (socket->tx_len > 0) {
+        // modem was not ready for all of it, try again after another window
+        socket->tx_flush_id = mbed::mbed_event_queue()->call_in(MBED_CONF_CELLULAR_TCP_COALESCE_WINDOW,
+                                                                callback(this, &AT_CellularStack::flush_tx_event), socket);
+    }
+
+    _at.unlock();
+}
+#endif // MBED_CONF_CELLULAR_TCP_COALESCE_WINDOW > 0
+
 nsapi_size_or_error_t AT_CellularStack::socket_recv(nsapi_socket_t handle, void *data, unsigned size)
 {
     return socket_recvfrom(handle, NULL, data, size);
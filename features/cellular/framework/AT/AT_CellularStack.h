@@ -29,6 +29,18 @@ namespace mbed {
 // a1.a2.a3.a4.a5.a6.a7.a8.a9.a10.a11.a12.a13.a14.a15.a16 for IPv6.
 #define PDP_IPV6_SIZE 63+1
 
+/** Milliseconds to hold back small TCP writes so that consecutive writes can be
+ *  combined into a single modem send command. 0 disables coalescing. */
+#ifndef MBED_CONF_CELLULAR_TCP_COALESCE_WINDOW
+#define MBED_CONF_CELLULAR_TCP_COALESCE_WINDOW 0
+#endif
+
+/** Per-socket buffer for coalesced TCP writes in bytes. Writes of this size or
+ *  larger bypass the buffer and go straight to the modem. */
+#ifndef MBED_CONF_CELLULAR_TCP_COALESCE_BUFFER
+#define MBED_CONF_CELLULAR_TCP_COALESCE_BUFFER 256
+#endif
+
 /**
  * Class AT_CellularStack.
  *
@@ -97,6 +109,11 @@ protected:
             rx_avail(false),
             pending_bytes(0)
         {
+#if MBED_CONF_CELLULAR_TCP_COALESCE_WINDOW > 0
+            tx_buf = NULL;
+            tx_len = 0;
+            tx_flush_id = 0;
+#endif
         }
         // Socket id from cellular device
         int id;
@@ -112,6 +129,11 @@ protected:
         bool tx_ready; // socket is ready for sending on modem stack
         bool rx_avail; // socket has data for reading on modem stack
         nsapi_size_t pending_bytes; // The number of received bytes pending
+#if MBED_CONF_CELLULAR_TCP_COALESCE_WINDOW > 0
+        uint8_t *tx_buf; // coalescing buffer for small TCP writes, allocated on first use
+        nsapi_size_t tx_len; // number of bytes waiting in tx_buf
+        int tx_flush_id; // pending flush event id on the shared queue, 0 if none
+#endif
     };
 
     /**
@@ -184,6 +206,22 @@ protected:
 private:
     int find_socket_index(nsapi_socket_t handle);
 
+#if MBED_CONF_CELLULAR_TCP_COALESCE_WINDOW > 0
+    /** Buffer a small TCP write, scheduling a delayed flush, or pass it to the
+     *  modem directly when buffering does not apply. ATHandler must be locked.
+     */
+    nsapi_size_or_error_t send_coalesced(CellularSocket *socket, const SocketAddress &addr,
+                                         const void *data, nsapi_size_t size);
+
+    /** Send buffered TCP data to the modem. ATHandler must be locked.
+     *  Keeps any unsent remainder buffered, returns negative only on hard errors.
+     */
+    nsapi_size_or_error_t flush_tx_buffer(CellularSocket *socket);
+
+    /** Delayed flush handler, runs on the shared event queue. */
+    void flush_tx_event(CellularSocket *socket);
+#endif
+
     // mutex for write/read to a _socket array, needed when multiple threads may open sockets simultaneously
     PlatformMutex _socket_mutex;
 };
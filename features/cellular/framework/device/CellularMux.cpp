@@ -0,0 +1,498 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CellularMux.h"
+#include "CellularLog.h"
+#include "events/mbed_events.h"
+#include "platform/mbed_poll.h"
+#include "platform/mbed_wait_api.h"
+
+#include <errno.h>
+#include <string.h>
+#include <new>
+
+// TS 27.010 basic option framing
+#define MUX_FRAME_FLAG          0xF9
+#define MUX_PF                  0x10
+#define MUX_CONTROL_SABM        0x2F
+#define MUX_CONTROL_UA          0x63
+#define MUX_CONTROL_DM          0x0F
+#define MUX_CONTROL_DISC        0x43
+#define MUX_CONTROL_UIH         0xEF
+
+#define MUX_ADDRESS_EA          0x01
+#define MUX_ADDRESS_CR          0x02
+
+#define MUX_UA_FLAG             (1UL << 0)
+#define MUX_DM_FLAG             (1UL << 1)
+
+namespace mbed {
+
+CellularMux::CellularMux(FileHandle *fh) :
+    _fh(fh),
+    _response_dlci(0xFF),
+    _started(false),
+    _rx_state(RX_FLAG_SEARCH),
+    _rx_address(0),
+    _rx_control(0),
+    _rx_length(0),
+    _rx_offset(0),
+    _rx_fcs(0)
+{
+    memset(_channels, 0, sizeof(_channels));
+
+    // Reflected CRC-8 (x^8 + x^2 + x + 1) used as the frame check sequence
+    for (int i = 0; i < 256; i++) {
+        uint8_t crc = i;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? ((crc >> 1) ^ 0xE0) : (crc >> 1);
+        }
+        _crc_table[i] = crc;
+    }
+}
+
+CellularMux::~CellularMux()
+{
+    stop();
+}
+
+nsapi_error_t CellularMux::start()
+{
+    _mutex.lock();
+
+    if (_started) {
+        _mutex.unlock();
+        return NSAPI_ERROR_OK;
+    }
+
+    // Frame reception runs on the shared event queue
+    _fh->set_blocking(false);
+    _fh->sigio(callback(this, &CellularMux::fh_event));
+
+    nsapi_error_t err = control_request(0, MUX_CONTROL_SABM);
+    if (err == NSAPI_ERROR_OK) {
+        _started = true;
+        tr_info("CMUX started");
+    } else {
+        tr_error("CMUX control channel open failed (%d)", err);
+        _fh->sigio(NULL);
+    }
+
+    _mutex.unlock();
+    return err;
+}
+
+FileHandle *CellularMux::get_channel(int dlci)
+{
+    if (dlci < 1 || dlci > 63) {
+        return NULL;
+    }
+
+    _mutex.lock();
+
+    if (!_started) {
+        _mutex.unlock();
+        return NULL;
+    }
+
+    int free_slot = -1;
+    for (int i = 0; i < MBED_CONF_CELLULAR_CMUX_MAX_CHANNELS; i++) {
+        if (_channels[i] && _channels[i]->dlci() == dlci) {
+            Channel *ch = _channels[i];
+            _mutex.unlock();
+            return ch;
+        }
+        if (!_channels[i] && free_slot < 0) {
+            free_slot = i;
+        }
+    }
+
+    if (free_slot < 0) {
+        _mutex.unlock();
+        return NULL;
+    }
+
+    if (control_request(dlci, MUX_CONTROL_SABM) != NSAPI_ERROR_OK) {
+        tr_error("CMUX DLCI %d open failed", dlci);
+        _mutex.unlock();
+        return NULL;
+    }
+
+    Channel *ch = new (std::nothrow) Channel(this, dlci);
+    _channels[free_slot] = ch;
+
+    _mutex.unlock();
+    return ch;
+}
+
+void CellularMux::stop()
+{
+    _mutex.lock();
+
+    if (!_started) {
+        _mutex.unlock();
+        return;
+    }
+
+    for (int i = 0; i < MBED_CONF_CELLULAR_CMUX_MAX_CHANNELS; i++) {
+        if (_channels[i]) {
+            control_request(_channels[i]->dlci(), MUX_CONTROL_DISC);
+            delete _channels[i];
+            _channels[i] = NULL;
+        }
+    }
+
+    // Closing the control channel returns the modem to AT mode
+    control_request(0, MUX_CONTROL_DISC);
+
+    _fh->sigio(NULL);
+    _fh->set_blocking(true);
+    _started = false;
+
+    _mutex.unlock();
+}
+
+void CellularMux::fh_event()
+{
+    // May be called from interrupt context - parse on the event queue
+    mbed_event_queue()->call(this, &CellularMux::process_input);
+}
+
+void CellularMux::process_input()
+{
+    uint8_t buf[64];
+
+    while (true) {
+        ssize_t len = _fh->read(buf, sizeof(buf));
+        if (len <= 0) {
+            break;
+        }
+        for (ssize_t i = 0; i < len; i++) {
+            parse_byte(buf[i]);
+        }
+    }
+}
+
+void CellularMux::parse_byte(uint8_t c)
+{
+    switch (_rx_state) {
+        case RX_FLAG_SEARCH:
+            if (c == MUX_FRAME_FLAG) {
+                _rx_state = RX_ADDRESS;
+            }
+            break;
+
+        case RX_ADDRESS:
+            if (c == MUX_FRAME_FLAG) {
+                break;  // consecutive flags between frames
+            }
+            _rx_address = c;
+            _rx_fcs = _crc_table[0xFF ^ c];
+            _rx_state = RX_CONTROL;
+            break;
+
+        case RX_CONTROL:
+            _rx_control = c;
+            _rx_fcs = _crc_table[_rx_fcs ^ c];
+            _rx_state = RX_LENGTH;
+            break;
+
+        case RX_LENGTH:
+            _rx_fcs = _crc_table[_rx_fcs ^ c];
+            _rx_length = c >> 1;
+            if (c & MUX_ADDRESS_EA) {
+                _rx_offset = 0;
+                _rx_state = _rx_length ? RX_PAYLOAD : RX_FCS;
+            } else {
+                _rx_state = RX_LENGTH_EXT;
+            }
+            break;
+
+        case RX_LENGTH_EXT:
+            _rx_fcs = _crc_table[_rx_fcs ^ c];
+            _rx_length |= (size_t)c << 7;
+            _rx_offset = 0;
+            _rx_state = _rx_length ? RX_PAYLOAD : RX_FCS;
+            break;
+
+        case RX_PAYLOAD:
+            if (_rx_length > sizeof(_rx_payload)) {
+                tr_error("CMUX frame too long (%d)", (int)_rx_length);
+                _rx_state = RX_FLAG_SEARCH;
+                break;
+            }
+            _rx_payload[_rx_offset++] = c;
+            if (_rx_offset == _rx_length) {
+                _rx_state = RX_FCS;
+            }
+            break;
+
+        case RX_FCS:
+            // For UIH the FCS covers the header only
+            if ((uint8_t)(0xFF - _rx_fcs) == c) {
+                dispatch_frame();
+            } else {
+                tr_warn("CMUX FCS error on DLCI %d", _rx_address >> 2);
+            }
+            _rx_state = RX_FLAG_SEARCH;
+            break;
+    }
+}
+
+void CellularMux::dispatch_frame()
+{
+    uint8_t dlci = _rx_address >> 2;
+
+    switch (_rx_control & ~MUX_PF) {
+        case MUX_CONTROL_UA:
+            if (dlci == _response_dlci) {
+                _flags.set(MUX_UA_FLAG);
+            }
+            break;
+
+        case MUX_CONTROL_DM:
+            if (dlci == _response_dlci) {
+                _flags.set(MUX_DM_FLAG);
+            }
+            break;
+
+        case MUX_CONTROL_UIH:
+            if (dlci == 0) {
+                // Mux control commands (MSC, FCon/FCoff, ...) - flow is
+                // handled per-channel by the rx buffers, nothing to do
+                break;
+            }
+            for (int i = 0; i < MBED_CONF_CELLULAR_CMUX_MAX_CHANNELS; i++) {
+                if (_channels[i] && _channels[i]->dlci() == dlci) {
+                    _channels[i]->data_received(_rx_payload, _rx_length);
+                    return;
+                }
+            }
+            tr_debug("CMUX data on closed DLCI %d dropped", dlci);
+            break;
+
+        default:
+            // We are the initiator - the modem should not command us
+            tr_debug("CMUX unexpected control 0x%02x", _rx_control);
+            break;
+    }
+}
+
+uint8_t CellularMux::fcs(const uint8_t *data, size_t len) const
+{
+    uint8_t crc = 0xFF;
+    while (len--) {
+        crc = _crc_table[crc ^ *data++];
+    }
+    return 0xFF - crc;
+}
+
+nsapi_error_t CellularMux::send_frame(uint8_t dlci, uint8_t control, const uint8_t *data, size_t len)
+{
+    uint8_t header[5];
+    size_t header_len = 3;
+
+    header[0] = MUX_FRAME_FLAG;
+    header[1] = (dlci << 2) | MUX_ADDRESS_CR | MUX_ADDRESS_EA;
+    header[2] = control;
+    if (len <= 0x7F) {
+        header[3] = (len << 1) | MUX_ADDRESS_EA;
+        header_len = 4;
+    } else {
+        header[3] = (len & 0x7F) << 1;
+        header[4] = len >> 7;
+        header_len = 5;
+    }
+
+    uint8_t trailer[2];
+    trailer[0] = fcs(header + 1, header_len - 1);
+    trailer[1] = MUX_FRAME_FLAG;
+
+    _mutex.lock();
+    nsapi_error_t err = write_all(header, header_len);
+    if (err == NSAPI_ERROR_OK && len) {
+        err = write_all(data, len);
+    }
+    if (err == NSAPI_ERROR_OK) {
+        err = write_all(trailer, sizeof(trailer));
+    }
+    _mutex.unlock();
+
+    return err;
+}
+
+nsapi_error_t CellularMux::control_request(uint8_t dlci, uint8_t control)
+{
+    _mutex.lock();
+
+    _flags.clear(MUX_UA_FLAG | MUX_DM_FLAG);
+    _response_dlci = dlci;
+
+    nsapi_error_t err = send_frame(dlci, control | MUX_PF, NULL, 0);
+    if (err == NSAPI_ERROR_OK) {
+        uint32_t flags = _flags.wait_any(MUX_UA_FLAG | MUX_DM_FLAG,
+                                         MBED_CONF_CELLULAR_CMUX_CONTROL_TIMEOUT);
+        if (flags & osFlagsError) {
+            err = NSAPI_ERROR_TIMEOUT;
+        } else if (flags & MUX_DM_FLAG) {
+            err = NSAPI_ERROR_DEVICE_ERROR;
+        }
+    }
+
+    _response_dlci = 0xFF;
+    _mutex.unlock();
+    return err;
+}
+
+nsapi_error_t CellularMux::write_all(const uint8_t *data, size_t len)
+{
+    while (len) {
+        pollfh fhs;
+        fhs.fh = _fh;
+        fhs.events = POLLOUT;
+        poll(&fhs, 1, -1);
+        ssize_t ret = _fh->write(data, len);
+        if (ret < 0) {
+            if (ret == -EAGAIN) {
+                continue;
+            }
+            return NSAPI_ERROR_DEVICE_ERROR;
+        }
+        data += ret;
+        len -= ret;
+    }
+    return NSAPI_ERROR_OK;
+}
+
+CellularMux::Channel::Channel(CellularMux *mux, uint8_t dlci) :
+    _mux(mux),
+    _dlci(dlci),
+    _blocking(true)
+{
+}
+
+ssize_t CellularMux::Channel::read(void *buffer, size_t size)
+{
+    char *ptr = static_cast<char *>(buffer);
+    size_t data_read = 0;
+
+    if (size == 0) {
+        return 0;
+    }
+
+    while (_rxbuf.empty()) {
+        if (!_blocking) {
+            return -EAGAIN;
+        }
+        wait_ms(1);
+    }
+
+    while (data_read < size && _rxbuf.pop(*ptr)) {
+        ptr++;
+        data_read++;
+    }
+
+    return data_read;
+}
+
+ssize_t CellularMux::Channel::write(const void *buffer, size_t size)
+{
+    const uint8_t *ptr = static_cast<const uint8_t *>(buffer);
+    size_t written = 0;
+
+    while (written < size) {
+        size_t chunk = size - written;
+        if (chunk > MBED_CONF_CELLULAR_CMUX_MAX_FRAME_SIZE) {
+            chunk = MBED_CONF_CELLULAR_CMUX_MAX_FRAME_SIZE;
+        }
+        nsapi_error_t err = _mux->send_frame(_dlci, MUX_CONTROL_UIH, ptr + written, chunk);
+        if (err != NSAPI_ERROR_OK) {
+            return written ? (ssize_t)written : -EIO;
+        }
+        written += chunk;
+    }
+
+    return written;
+}
+
+off_t CellularMux::Channel::seek(off_t offset, int whence)
+{
+    return -ESPIPE;
+}
+
+int CellularMux::Channel::close()
+{
+    // Channels stay allocated until CellularMux::stop(), which releases
+    // the DLCIs on the modem side as well
+    return 0;
+}
+
+int CellularMux::Channel::isatty()
+{
+    return 1;
+}
+
+void CellularMux::Channel::set_blocking(bool blocking)
+{
+    _blocking = blocking;
+}
+
+short CellularMux::Channel::poll(short events) const
+{
+    short revents = 0;
+
+    if ((events & POLLIN) && !_rxbuf.empty()) {
+        revents |= POLLIN;
+    }
+    if (events & POLLOUT) {
+        // Writes block until the frame is on the wire, but can always proceed
+        revents |= POLLOUT;
+    }
+
+    return revents;
+}
+
+void CellularMux::Channel::sigio(Callback<void()> func)
+{
+    _sigio_cb = func;
+    // Report immediately if data is already pending, as FileHandle::sigio requires
+    if (_sigio_cb && !_rxbuf.empty()) {
+        _sigio_cb();
+    }
+}
+
+void CellularMux::Channel::data_received(const uint8_t *data, size_t len)
+{
+    bool was_empty = _rxbuf.empty();
+
+    for (size_t i = 0; i < len; i++) {
+        if (_rxbuf.full()) {
+            tr_error("CMUX DLCI %d rx overflow, %d bytes dropped", _dlci, (int)(len - i));
+            break;
+        }
+        _rxbuf.push(data[i]);
+    }
+
+    if (was_empty && !_rxbuf.empty()) {
+        wake_poll();
+        if (_sigio_cb) {
+            _sigio_cb();
+        }
+    }
+}
+
+} // namespace mbed
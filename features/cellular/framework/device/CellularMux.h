@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CELLULAR_MUX_H_
+#define CELLULAR_MUX_H_
+
+#include "platform/FileHandle.h"
+#include "platform/PlatformMutex.h"
+#include "platform/CircularBuffer.h"
+#include "platform/Callback.h"
+#include "rtos/EventFlags.h"
+#include "nsapi_types.h"
+
+/** Number of simultaneously open user channels (DLCIs), control channel excluded */
+#ifndef MBED_CONF_CELLULAR_CMUX_MAX_CHANNELS
+#define MBED_CONF_CELLULAR_CMUX_MAX_CHANNELS 3
+#endif
+
+/** Receive buffer of each virtual channel in bytes */
+#ifndef MBED_CONF_CELLULAR_CMUX_RX_BUFFER_SIZE
+#define MBED_CONF_CELLULAR_CMUX_RX_BUFFER_SIZE 1024
+#endif
+
+/** Maximum frame payload (N1). Must not exceed what was negotiated with AT+CMUX. */
+#ifndef MBED_CONF_CELLULAR_CMUX_MAX_FRAME_SIZE
+#define MBED_CONF_CELLULAR_CMUX_MAX_FRAME_SIZE 1509
+#endif
+
+/** Response timeout for mux control frames (T1) in milliseconds */
+#ifndef MBED_CONF_CELLULAR_CMUX_CONTROL_TIMEOUT
+#define MBED_CONF_CELLULAR_CMUX_CONTROL_TIMEOUT 5000
+#endif
+
+namespace mbed {
+
+/** 3GPP TS 27.010 basic-option multiplexer on top of a single serial FileHandle.
+ *
+ *  Splits the physical modem connection into independent virtual channels
+ *  (DLCIs) which are themselves FileHandles, so an ATHandler and a PPP data
+ *  stream can run concurrently over one UART instead of trading it through
+ *  command/data mode switches.
+ *
+ *  The modem must be switched to multiplexed mode first (AT+CMUX=0,...,
+ *  sent over the plain file handle). After that, call start() to open the
+ *  mux control channel and get_channel() for each user channel. Frame
+ *  reception runs on the shared event queue, so control requests and
+ *  blocking channel reads must not be made from that queue's thread.
+ */
+class CellularMux {
+public:
+    /** Create a multiplexer on the given file handle
+     *
+     *  @param fh   File handle of the physical modem connection
+     */
+    CellularMux(FileHandle *fh);
+
+    ~CellularMux();
+
+    /** Open the multiplexer control channel (DLCI 0)
+     *
+     *  The modem must already be in CMUX mode. Takes over the file
+     *  handle's sigio callback.
+     *
+     *  @return NSAPI_ERROR_OK on success, negative error code on failure
+     */
+    nsapi_error_t start();
+
+    /** Open a user channel
+     *
+     *  Establishes the DLCI with the modem on first use and returns the
+     *  same FileHandle on later calls. Reads are buffered and non-blocking
+     *  mode is supported; writes always block until the frame has been
+     *  handed to the physical file handle. Which DLCI carries AT and which
+     *  carries data is modem-specific.
+     *
+     *  @param dlci Channel number, 1-63
+     *  @return     File handle of the virtual channel, NULL on failure
+     */
+    FileHandle *get_channel(int dlci);
+
+    /** Close all user channels and the control channel
+     *
+     *  The modem drops back to non-multiplexed mode (DISC on DLCI 0).
+     */
+    void stop();
+
+private:
+    class Channel : public FileHandle {
+    public:
+        Channel(CellularMux *mux, uint8_t dlci);
+
+        virtual ssize_t read(void *buffer, size_t size);
+        virtual ssize_t write(const void *buffer, size_t size);
+        virtual off_t seek(off_t offset, int whence = SEEK_SET);
+        virtual int close();
+        virtual int isatty();
+        virtual void set_blocking(bool blocking);
+        virtual short poll(short events) const;
+        virtual void sigio(Callback<void()> func);
+
+        uint8_t dlci() const
+        {
+            return _dlci;
+        }
+
+        /** Queue received payload and signal readers; runs on the event queue */
+        void data_received(const uint8_t *data, size_t len);
+
+    private:
+        CellularMux *_mux;
+        CircularBuffer<char, MBED_CONF_CELLULAR_CMUX_RX_BUFFER_SIZE> _rxbuf;
+        Callback<void()> _sigio_cb;
+        uint8_t _dlci;
+        bool _blocking;
+    };
+
+    friend class Channel;
+
+    // Frame parser states
+    enum RxState {
+        RX_FLAG_SEARCH,
+        RX_ADDRESS,
+        RX_CONTROL,
+        RX_LENGTH,
+        RX_LENGTH_EXT,
+        RX_PAYLOAD,
+        RX_FCS
+    };
+
+    void fh_event();
+    void process_input();
+    void parse_byte(uint8_t c);
+    void dispatch_frame();
+    uint8_t fcs(const uint8_t *data, size_t len) const;
+    nsapi_error_t send_frame(uint8_t dlci, uint8_t control, const uint8_t *data, size_t len);
+    nsapi_error_t control_request(uint8_t dlci, uint8_t control);
+    nsapi_error_t write_all(const uint8_t *data, size_t len);
+
+    FileHandle *_fh;
+    PlatformMutex _mutex;
+    rtos::EventFlags _flags;
+    Channel *_channels[MBED_CONF_CELLULAR_CMUX_MAX_CHANNELS];
+    uint8_t _crc_table[256];
+    volatile uint8_t _response_dlci;
+    bool _started;
+
+    // Receive frame assembly
+    RxState _rx_state;
+    uint8_t _rx_address;
+    uint8_t _rx_control;
+    size_t _rx_length;
+    size_t _rx_offset;
+    uint8_t _rx_fcs;
+    uint8_t _rx_payload[MBED_CONF_CELLULAR_CMUX_MAX_FRAME_SIZE];
+};
+
+} // namespace mbed
+
+#endif // CELLULAR_MUX_H_
@@ -464,6 +464,95 @@ void generate_derived_key_wrong_key_type_test()
 
 }
 
+/*
+ * Test that cached derivations return the same key and that the cache
+ * survives explicit invalidation
+ */
+void generate_derived_key_cache_test()
+{
+    unsigned char output1[DEVICE_KEY_16BYTE];
+    unsigned char output2[DEVICE_KEY_16BYTE];
+    unsigned char salt[] = "cache consistency salt";
+    size_t salt_size = sizeof(salt);
+    DeviceKey &devkey = DeviceKey::get_instance();
+    KVMap &kv_map = KVMap::get_instance();
+    KVStore *inner_store = kv_map.get_internal_kv_instance(NULL);
+    TEST_ASSERT_NOT_EQUAL(NULL, inner_store);
+
+    int ret = inner_store->reset();
+    TEST_ASSERT_EQUAL_INT(DEVICEKEY_SUCCESS, ret);
+
+    ret = inject_dummy_rot_key();
+    TEST_ASSERT_EQUAL_INT(DEVICEKEY_SUCCESS, ret);
+
+    memset(output1, 0, sizeof(output1));
+    memset(output2, 0, sizeof(output2));
+
+    //Second derivation is served from the cache and must match the first
+    ret = devkey.generate_derived_key(salt, salt_size, output1, DEVICE_KEY_16BYTE);
+    TEST_ASSERT_EQUAL_INT32(DEVICEKEY_SUCCESS, ret);
+    ret = devkey.generate_derived_key(salt, salt_size, output2, DEVICE_KEY_16BYTE);
+    TEST_ASSERT_EQUAL_INT32(DEVICEKEY_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(output1, output2, DEVICE_KEY_16BYTE);
+
+    //After invalidation the key is recomputed from the ROT and must still match
+    devkey.invalidate_derived_key_cache();
+    memset(output2, 0, sizeof(output2));
+    ret = devkey.generate_derived_key(salt, salt_size, output2, DEVICE_KEY_16BYTE);
+    TEST_ASSERT_EQUAL_INT32(DEVICEKEY_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(output1, output2, DEVICE_KEY_16BYTE);
+}
+
+/*
+ * Test that batch derivation produces the same keys as one-by-one derivation
+ */
+void generate_derived_keys_batch_test()
+{
+    unsigned char batch_out16[DEVICE_KEY_16BYTE];
+    unsigned char batch_out32[DEVICE_KEY_32BYTE];
+    unsigned char single_out16[DEVICE_KEY_16BYTE];
+    unsigned char single_out32[DEVICE_KEY_32BYTE];
+    unsigned char salt1[] = "batch salt number one";
+    unsigned char salt2[] = "batch salt number two";
+    DeviceKey &devkey = DeviceKey::get_instance();
+    KVMap &kv_map = KVMap::get_instance();
+    KVStore *inner_store = kv_map.get_internal_kv_instance(NULL);
+    TEST_ASSERT_NOT_EQUAL(NULL, inner_store);
+
+    int ret = inner_store->reset();
+    TEST_ASSERT_EQUAL_INT(DEVICEKEY_SUCCESS, ret);
+
+    ret = inject_dummy_rot_key();
+    TEST_ASSERT_EQUAL_INT(DEVICEKEY_SUCCESS, ret);
+
+    memset(batch_out16, 0, sizeof(batch_out16));
+    memset(batch_out32, 0, sizeof(batch_out32));
+
+    DeviceKey::derived_key_request_t requests[2];
+    requests[0].isalt = salt1;
+    requests[0].isalt_size = sizeof(salt1);
+    requests[0].output = batch_out16;
+    requests[0].ikey_type = DEVICE_KEY_16BYTE;
+    requests[1].isalt = salt2;
+    requests[1].isalt_size = sizeof(salt2);
+    requests[1].output = batch_out32;
+    requests[1].ikey_type = DEVICE_KEY_32BYTE;
+
+    ret = devkey.generate_derived_keys(requests, 2);
+    TEST_ASSERT_EQUAL_INT32(DEVICEKEY_SUCCESS, ret);
+
+    devkey.invalidate_derived_key_cache();
+    memset(single_out16, 0, sizeof(single_out16));
+    memset(single_out32, 0, sizeof(single_out32));
+    ret = devkey.generate_derived_key(salt1, sizeof(salt1), single_out16, DEVICE_KEY_16BYTE);
+    TEST_ASSERT_EQUAL_INT32(DEVICEKEY_SUCCESS, ret);
+    ret = devkey.generate_derived_key(salt2, sizeof(salt2), single_out32, DEVICE_KEY_32BYTE);
+    TEST_ASSERT_EQUAL_INT32(DEVICEKEY_SUCCESS, ret);
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(single_out16, batch_out16, DEVICE_KEY_16BYTE);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(single_out32, batch_out32, DEVICE_KEY_32BYTE);
+}
+
 utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
 {
     greentea_case_failure_abort_handler(source, reason);
@@ -481,7 +570,9 @@ Case cases[] = {
     Case("Device Key - derived key consistency 32 byte key", generate_derived_key_consistency_32_byte_key_test, greentea_failure_handler),
     Case("Device Key - derived key key type 16",             generate_derived_key_key_type_16_test,             greentea_failure_handler),
     Case("Device Key - derived key key type 32",             generate_derived_key_key_type_32_test,             greentea_failure_handler),
-    Case("Device Key - derived key wrong key type",          generate_derived_key_wrong_key_type_test,          greentea_failure_handler)
+    Case("Device Key - derived key wrong key type",          generate_derived_key_wrong_key_type_test,          greentea_failure_handler),
+    Case("Device Key - derived key cache",                   generate_derived_key_cache_test,                   greentea_failure_handler),
+    Case("Device Key - derived keys batch",                  generate_derived_keys_batch_test,                  greentea_failure_handler)
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
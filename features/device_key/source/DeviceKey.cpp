@@ -62,6 +62,10 @@ DeviceKey::DeviceKey()
     if (ret != MBED_SUCCESS) {
         tr_error("DeviceKey: Fail to initialize KvStore configuration.");
     }
+#if MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE > 0
+    memset(_cache, 0, sizeof(_cache));
+    _cache_next = 0;
+#endif
     return;
 }
 
@@ -80,8 +84,83 @@ int DeviceKey::generate_derived_key(const unsigned char *salt, size_t isalt_size
         return DEVICEKEY_INVALID_KEY_TYPE;
     }
 
+#if MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE > 0
+    if (cache_lookup(salt, isalt_size, output, ikey_type)) {
+        return DEVICEKEY_SUCCESS;
+    }
+#endif
+
     actual_size = DEVICE_KEY_16BYTE != ikey_type ? DEVICE_KEY_32BYTE : DEVICE_KEY_16BYTE;
 
+    int ret = load_root_of_trust(key_buff, actual_size);
+    if (DEVICEKEY_SUCCESS != ret) {
+        return ret;
+    }
+
+    ret = get_derived_key(key_buff, actual_size, salt, isalt_size, output, ikey_type);
+#if MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE > 0
+    if (DEVICEKEY_SUCCESS == ret) {
+        cache_store(salt, isalt_size, output, ikey_type);
+    }
+#endif
+    return ret;
+}
+
+int DeviceKey::generate_derived_keys(derived_key_request_t *requests, size_t count)
+{
+    uint32_t key_buff[DEVICE_KEY_32BYTE / sizeof(uint32_t)];
+    size_t loaded_size = 0;
+    int ret;
+
+    for (size_t i = 0; i < count; i++) {
+        if (DEVICE_KEY_16BYTE != requests[i].ikey_type && DEVICE_KEY_32BYTE != requests[i].ikey_type) {
+            return DEVICEKEY_INVALID_KEY_TYPE;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+#if MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE > 0
+        if (cache_lookup(requests[i].isalt, requests[i].isalt_size, requests[i].output,
+                         requests[i].ikey_type)) {
+            continue;
+        }
+#endif
+
+        //Fetch the ROT once per key size used by the batch instead of once per key
+        size_t actual_size = DEVICE_KEY_16BYTE != requests[i].ikey_type ? DEVICE_KEY_32BYTE : DEVICE_KEY_16BYTE;
+        if (actual_size != loaded_size) {
+            ret = load_root_of_trust(key_buff, actual_size);
+            if (DEVICEKEY_SUCCESS != ret) {
+                return ret;
+            }
+            loaded_size = actual_size;
+        }
+
+        ret = get_derived_key(key_buff, actual_size, requests[i].isalt, requests[i].isalt_size,
+                              requests[i].output, requests[i].ikey_type);
+        if (DEVICEKEY_SUCCESS != ret) {
+            return ret;
+        }
+#if MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE > 0
+        cache_store(requests[i].isalt, requests[i].isalt_size, requests[i].output, requests[i].ikey_type);
+#endif
+    }
+
+    return DEVICEKEY_SUCCESS;
+}
+
+void DeviceKey::invalidate_derived_key_cache()
+{
+#if MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE > 0
+    _cache_mutex.lock();
+    memset(_cache, 0, sizeof(_cache));
+    _cache_next = 0;
+    _cache_mutex.unlock();
+#endif
+}
+
+int DeviceKey::load_root_of_trust(uint32_t *key_buff, size_t actual_size)
+{
     //First try to read the key from KVStore
     int ret = read_key_from_kvstore(key_buff, actual_size);
     if (DEVICEKEY_SUCCESS != ret && DEVICEKEY_NOT_FOUND != ret) {
@@ -101,13 +180,62 @@ int DeviceKey::generate_derived_key(const unsigned char *salt, size_t isalt_size
         }
     }
 
-    ret = get_derived_key(key_buff, actual_size, salt, isalt_size, output, ikey_type);
-    return ret;
+    return DEVICEKEY_SUCCESS;
+}
+
+#if MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE > 0
+bool DeviceKey::cache_lookup(const unsigned char *isalt, size_t isalt_size, unsigned char *output,
+                             uint16_t ikey_type)
+{
+    if (isalt_size > MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SALT_SIZE) {
+        return false;
+    }
+
+    _cache_mutex.lock();
+    for (size_t i = 0; i < MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE; i++) {
+        if (_cache[i].valid && _cache[i].key_type == ikey_type &&
+                _cache[i].salt_size == isalt_size &&
+                0 == memcmp(_cache[i].salt, isalt, isalt_size)) {
+            memcpy(output, _cache[i].key, ikey_type);
+            _cache_mutex.unlock();
+            return true;
+        }
+    }
+    _cache_mutex.unlock();
+    return false;
 }
 
+void DeviceKey::cache_store(const unsigned char *isalt, size_t isalt_size, const unsigned char *key,
+                            uint16_t ikey_type)
+{
+    if (isalt_size > MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SALT_SIZE) {
+        return;
+    }
+
+    _cache_mutex.lock();
+    derived_key_cache_entry_t *entry = &_cache[_cache_next];
+    _cache_next = (_cache_next + 1) % MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE;
+
+    memset(entry, 0, sizeof(*entry));
+    memcpy(entry->salt, isalt, isalt_size);
+    memcpy(entry->key, key, ikey_type);
+    entry->salt_size = (uint16_t)isalt_size;
+    entry->key_type = ikey_type;
+    entry->valid = true;
+    _cache_mutex.unlock();
+}
+#endif
+
 int DeviceKey::device_inject_root_of_trust(uint32_t *value, size_t isize)
 {
-    return write_key_to_kvstore(value, isize);
+    int ret = write_key_to_kvstore(value, isize);
+#if MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE > 0
+    //Keys cached before the injection were derived from a different ROT
+    if (DEVICEKEY_SUCCESS == ret) {
+        invalidate_derived_key_cache();
+    }
+#endif
+    return ret;
 }
 
 int DeviceKey::write_key_to_kvstore(uint32_t *input, size_t isize)
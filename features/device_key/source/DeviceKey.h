@@ -19,6 +19,14 @@
 #include "stddef.h"
 #include "stdint.h"
 #include "platform/NonCopyable.h"
+#include "PlatformMutex.h"
+
+#ifndef MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE
+#define MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE 4
+#endif
+#ifndef MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SALT_SIZE
+#define MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SALT_SIZE 32
+#endif
 
 #define DEVICEKEY_ENABLED 1
 
@@ -91,6 +99,34 @@ public:
      */
     int generate_derived_key(const unsigned char *isalt, size_t isalt_size, unsigned char *output, uint16_t ikey_type);
 
+    /** A single derivation of a batch passed to generate_derived_keys() */
+    typedef struct {
+        const unsigned char *isalt; /**< Input buffer used to create the new key */
+        size_t isalt_size;          /**< Size of the data in the salt buffer */
+        unsigned char *output;      /**< Buffer to receive the derived key */
+        uint16_t ikey_type;         /**< Type of the required key. Must be 16 bytes or 32 bytes */
+    } derived_key_request_t;
+
+    /** Derive several keys in one call. The root of trust is fetched from the
+     *  KVStore once for the whole batch instead of once per key, so deriving n
+     *  keys costs one KVStore read plus n CMAC computations (minus any cache hits).
+     * @param requests Array of derivation requests, each filled like the
+     *                 generate_derived_key parameters.
+     * @param count Number of entries in the requests array.
+     * @return 0 on success, negative error code of the first failing derivation
+     */
+    int generate_derived_keys(derived_key_request_t *requests, size_t count);
+
+    /** Empty the derived key cache and zeroize the cached key material.
+     *
+     *  Derived keys are cached in RAM so repeated derivations with the same
+     *  salt - for example secure storage access after wake from deep sleep,
+     *  since RAM content is retained - skip the CMAC computation. Call this
+     *  after injecting a new root of trust, or to scrub key material when the
+     *  keys are no longer needed.
+     */
+    void invalidate_derived_key_cache();
+
     /** Set a device key into the KVStore. If entropy support is missing, call this method
      *  before calling device_key_derived_key. This method should be called only once!
      * @param value Input buffer contain the key.
@@ -142,6 +178,41 @@ private:
      */
     int generate_key_by_random(uint32_t *output, size_t size);
 
+    /** Read the ROT key from the KVStore, creating and saving a random one
+     *  on first use
+     * @param key_buff Buffer for the returned key, at least actual_size bytes.
+     * @param actual_size Size of the requested key. Must be 16 bytes or 32 bytes.
+     * @return 0 on success, negative error code on failure
+     */
+    int load_root_of_trust(uint32_t *key_buff, size_t actual_size);
+
+#if MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE > 0
+    /** Look up a cached derived key
+     * @param isalt Salt the key was derived from.
+     * @param isalt_size Size of the salt.
+     * @param output Buffer receiving the key on a hit.
+     * @param ikey_type Requested key size.
+     * @return true on a cache hit
+     */
+    bool cache_lookup(const unsigned char *isalt, size_t isalt_size, unsigned char *output, uint16_t ikey_type);
+
+    /** Store a derived key in the cache, replacing entries round-robin.
+     *  Keys derived from salts longer than the configured maximum are not cached.
+     */
+    void cache_store(const unsigned char *isalt, size_t isalt_size, const unsigned char *key, uint16_t ikey_type);
+
+    typedef struct {
+        unsigned char salt[MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SALT_SIZE];
+        unsigned char key[DEVICE_KEY_32BYTE];
+        uint16_t salt_size;
+        uint16_t key_type;
+        bool valid;
+    } derived_key_cache_entry_t;
+
+    derived_key_cache_entry_t _cache[MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SIZE];
+    size_t _cache_next;
+    PlatformMutex _cache_mutex;
+#endif
 };
 /** @}*/
 
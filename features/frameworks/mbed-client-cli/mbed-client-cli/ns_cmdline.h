@@ -193,6 +193,14 @@ void cmd_mutex_lock(void);
 void cmd_mutex_unlock(void);
 /** Refresh output */
 void cmd_output(void);
+/** Write out any buffered output.
+ * When output buffering is enabled (MBED_CMDLINE_OUTPUT_BUFFER_SIZE > 0),
+ * prints are collected and written out in batches; the command line flushes
+ * itself after input handling and command completion, but application code
+ * using cmd_printf outside of command callbacks should call this when it
+ * wants the output to leave. Does nothing when buffering is disabled.
+ */
+void cmd_output_flush(void);
 /** default cmd response function, use stdout
  *  \param fmt  The format string is a character string, beginning and ending in its initial shift state, if any. The format string is composed of zero or more directives.
  *  \param ap   list of parameters needed by format string. This must correspond properly with the conversion specifier.
@@ -136,6 +136,16 @@
 #ifndef MBED_CMDLINE_INCLUDE_MAN
 #define MBED_CMDLINE_INCLUDE_MAN 1
 #endif
+// Number of buckets in the command dispatch index
+#ifndef MBED_CMDLINE_DISPATCH_BUCKETS
+#define MBED_CMDLINE_DISPATCH_BUCKETS 16
+#endif
+// Output buffer size. When nonzero, echo and response prints are collected
+// into the buffer and written out in batches instead of one write per
+// cmd_printf call. 0 keeps the old write-through behaviour.
+#ifndef MBED_CMDLINE_OUTPUT_BUFFER_SIZE
+#define MBED_CMDLINE_OUTPUT_BUFFER_SIZE 0
+#endif
 
 
 typedef struct cmd_history_s {
@@ -149,6 +159,8 @@ typedef struct cmd_command_s {
     const char *man_ptr;
     cmd_run_cb *run_cb;
     bool        busy;
+    uint32_t    name_hash;            // hash of name_ptr, avoids strcmp on lookup
+    struct cmd_command_s *bucket_next; // chain in the dispatch index bucket
     ns_list_link_t link;
 } cmd_command_t;
 
@@ -201,6 +213,11 @@ typedef struct cmd_class_s {
     history_list_t history_list;      // input history
     uint8_t history_max_count;        // history max size
     command_list_t command_list;      // commands list
+    cmd_command_t *command_index[MBED_CMDLINE_DISPATCH_BUCKETS]; // command dispatch index
+#if MBED_CMDLINE_OUTPUT_BUFFER_SIZE > 0
+    char out_buffer[MBED_CMDLINE_OUTPUT_BUFFER_SIZE]; // buffered output
+    int  out_buffer_len;              // bytes waiting in out_buffer
+#endif
     alias_list_t alias_list;          // alias list
     variable_list_t variable_list;    // variables list
     bool vt100_on;                    // control characters
@@ -293,12 +310,45 @@ static const char *find_last_space(const char *from, const char *to);
 static int replace_string(
     char *str, int str_len,
     const char *old_str, const char *new_str);
+static uint32_t         cmd_hash(const char *name);
+static void             cmd_index_add(cmd_command_t *cmd_ptr);
+static void             cmd_index_remove(cmd_command_t *cmd_ptr);
 
 void default_cmd_response_out(const char *fmt, va_list ap)
 {
     vprintf(fmt, ap);
     fflush(stdout);
 }
+#if MBED_CMDLINE_OUTPUT_BUFFER_SIZE > 0
+static void cmd_out_fmt(const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    cmd.out(fmt, ap);
+    va_end(ap);
+}
+static void cmd_output_flush_nolock(void)
+{
+    if (cmd.out_buffer_len > 0) {
+        cmd_out_fmt("%s", cmd.out_buffer);
+        cmd.out_buffer_len = 0;
+    }
+}
+void cmd_output_flush(void)
+{
+    if (cmd.mutex_wait_fnc) {
+        cmd.mutex_wait_fnc();
+    }
+    cmd_output_flush_nolock();
+    if (cmd.mutex_release_fnc) {
+        cmd.mutex_release_fnc();
+    }
+}
+#else
+void cmd_output_flush(void)
+{
+}
+#endif
 void cmd_printf(const char *fmt, ...)
 {
     va_list ap;
@@ -311,7 +361,28 @@ void cmd_vprintf(const char *fmt, va_list ap)
     if (cmd.mutex_wait_fnc) {
         cmd.mutex_wait_fnc();
     }
+#if MBED_CMDLINE_OUTPUT_BUFFER_SIZE > 0
+    va_list ap2;
+    va_copy(ap2, ap);
+    int space = MBED_CMDLINE_OUTPUT_BUFFER_SIZE - cmd.out_buffer_len;
+    int len = vsnprintf(cmd.out_buffer + cmd.out_buffer_len, space, fmt, ap2);
+    va_end(ap2);
+    if (len >= space) {
+        // did not fit - drop the truncated tail, flush and retry once
+        cmd.out_buffer[cmd.out_buffer_len] = 0;
+        cmd_output_flush_nolock();
+        if (len >= MBED_CMDLINE_OUTPUT_BUFFER_SIZE) {
+            // larger than the whole buffer, write through
+            cmd.out(fmt, ap);
+        } else {
+            cmd.out_buffer_len = vsnprintf(cmd.out_buffer, MBED_CMDLINE_OUTPUT_BUFFER_SIZE, fmt, ap);
+        }
+    } else if (len > 0) {
+        cmd.out_buffer_len += len;
+    }
+#else
     cmd.out(fmt, ap);
+#endif
     if (cmd.mutex_release_fnc) {
         cmd.mutex_release_fnc();
     }
@@ -342,6 +413,9 @@ void cmd_init(cmd_print_t *outf)
     cmd.tab_lookup_n = 0;
     cmd.cmd_buffer_ptr = 0;
     cmd.idle = true;
+#if MBED_CMDLINE_OUTPUT_BUFFER_SIZE > 0
+    cmd.out_buffer_len = 0;
+#endif
     cmd.ready_cb = cmd_next;
     cmd.passthrough_fnc = NULL;
     cmd_variable_add(VAR_PROMPT, DEFAULT_PROMPT);
@@ -357,6 +431,7 @@ void cmd_init(cmd_print_t *outf)
 void cmd_request_screen_size(void)
 {
     cmd_printf(REQUEST_SCREEN_SIZE);
+    cmd_output_flush();
 }
 
 const char *cmdline_get_prompt(void)
@@ -509,6 +584,7 @@ void cmd_next(int retcode)
         if (cmd.echo) {
             cmd_output();    //ready
         }
+        cmd_output_flush();
     }
 }
 static cmd_exe_t *cmd_pop(void)
@@ -641,6 +717,7 @@ void cmd_init_screen()
     }
     cmd_printf(MBED_CMDLINE_BOOT_MESSAGE);
     cmd_output();
+    cmd_output_flush();
 }
 uint8_t cmd_history_size(uint8_t max)
 {
@@ -701,6 +778,38 @@ static char *cmd_input_lookup_var(char *name, int namelength, int n)
     }
     return str;
 }
+// FNV-1a
+static uint32_t cmd_hash(const char *name)
+{
+    uint32_t hash = 2166136261u;
+    while (*name) {
+        hash ^= (uint8_t)*name++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+static void cmd_index_add(cmd_command_t *cmd_ptr)
+{
+    // append to the bucket chain, so the oldest of duplicate names keeps
+    // winning lookups like it did with the list scan
+    cmd_command_t **chain_ptr = &cmd.command_index[cmd_ptr->name_hash % MBED_CMDLINE_DISPATCH_BUCKETS];
+    while (*chain_ptr) {
+        chain_ptr = &(*chain_ptr)->bucket_next;
+    }
+    cmd_ptr->bucket_next = NULL;
+    *chain_ptr = cmd_ptr;
+}
+static void cmd_index_remove(cmd_command_t *cmd_ptr)
+{
+    cmd_command_t **chain_ptr = &cmd.command_index[cmd_ptr->name_hash % MBED_CMDLINE_DISPATCH_BUCKETS];
+    while (*chain_ptr) {
+        if (*chain_ptr == cmd_ptr) {
+            *chain_ptr = cmd_ptr->bucket_next;
+            return;
+        }
+        chain_ptr = &(*chain_ptr)->bucket_next;
+    }
+}
 static cmd_command_t *cmd_find(const char *name)
 {
     cmd_command_t *cmd_ptr = NULL;
@@ -709,8 +818,10 @@ static cmd_command_t *cmd_find(const char *name)
         return NULL;
     }
 
-    ns_list_foreach(cmd_command_t, cur_ptr, &cmd.command_list) {
-        if (strcmp(name, cur_ptr->name_ptr) == 0) {
+    uint32_t hash = cmd_hash(name);
+    for (cmd_command_t *cur_ptr = cmd.command_index[hash % MBED_CMDLINE_DISPATCH_BUCKETS];
+            cur_ptr; cur_ptr = cur_ptr->bucket_next) {
+        if (cur_ptr->name_hash == hash && strcmp(name, cur_ptr->name_ptr) == 0) {
             cmd_ptr = cur_ptr;
             break;
         }
@@ -740,7 +851,9 @@ void cmd_add(const char *name, cmd_run_cb *callback, const char *info, const cha
 #endif
     cmd_ptr->run_cb = callback;
     cmd_ptr->busy = false;
+    cmd_ptr->name_hash = cmd_hash(name);
     ns_list_add_to_end(&cmd.command_list, cmd_ptr);
+    cmd_index_add(cmd_ptr);
     return;
 }
 
@@ -752,6 +865,7 @@ void cmd_delete(const char *name)
         return;
     }
     ns_list_remove(&cmd.command_list, cmd_ptr);
+    cmd_index_remove(cmd_ptr);
     MEM_FREE(cmd_ptr);
     return;
 }
@@ -1158,7 +1272,14 @@ static void cmd_reset_tab(void)
     cmd.tab_lookup_cmd_n = 0;
     cmd.tab_lookup_n = 0;
 }
+static void cmd_char_input_internal(int16_t u_data);
 void cmd_char_input(int16_t u_data)
+{
+    cmd_char_input_internal(u_data);
+    // echo and possible line redraw leave in a single write
+    cmd_output_flush();
+}
+static void cmd_char_input_internal(int16_t u_data)
 {
     if (cmd.prev_cr && u_data == '\n') {
         // ignore \n if previous character was \r ->
@@ -133,6 +133,27 @@ extern sn_coap_hdr_s *sn_coap_protocol_parse(struct coap_s *handle, sn_nsdl_addr
 
 extern int8_t sn_coap_protocol_exec(struct coap_s *handle, uint32_t current_time);
 
+/**
+ * \fn uint32_t sn_coap_protocol_next_timed_event(struct coap_s *handle)
+ *
+ * \brief Returns the time of the next pending timed event: the nearest
+ *        message re-sending deadline, or the expiry of the oldest entry in
+ *        the duplication detection or blockwise lists.
+ *
+ *        Instead of calling sn_coap_protocol_exec at a fixed rate, the
+ *        application can call this after every CoAP operation and arm a
+ *        single timer for the returned time, so nothing runs and the device
+ *        can sleep while no message is due.
+ *
+ * \param *handle Pointer to CoAP library handle
+ *
+ * \return System time in seconds (same clock as given to
+ *         sn_coap_protocol_exec) when the next timed event is due,
+ *         0 if nothing is pending
+ */
+
+extern uint32_t sn_coap_protocol_next_timed_event(struct coap_s *handle);
+
 /**
  * \fn int8_t sn_coap_protocol_set_block_size(uint16_t block_size)
  *
@@ -107,6 +107,19 @@
  */
 #undef SN_COAP_BLOCKWISE_ENABLED                    /* 0 */
 
+/**
+ * \def SN_COAP_BLOCKWISE_PAYLOAD_POOL_SIZE
+ * \brief Sets the number of received blockwise payload blocks carved from
+ * a pool pre-allocated at sn_coap_protocol_init(). Storing and removing
+ * a block then needs no heap allocation, which avoids heap fragmentation
+ * and allocator overhead during long blockwise transfers.
+ * Each pool block reserves SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE bytes of
+ * payload room plus list and addressing overhead.
+ * By default, this feature is disabled, 0 disables the feature and keeps
+ * per-block heap allocation.
+ */
+#undef SN_COAP_BLOCKWISE_PAYLOAD_POOL_SIZE          /* 0 */
+
 /**
  * \def SN_COAP_RESENDING_MAX_COUNT
  * \brief Defines how many times CoAP library tries to re-send the CoAP packet.
@@ -140,6 +140,19 @@ struct sn_coap_hdr_;
 #define SN_COAP_MAX_INCOMING_BLOCK_MESSAGE_SIZE UINT16_MAX
 #endif
 
+/* Init value for the count of blockwise payload blocks carved from a pool     */
+/* pre-allocated at sn_coap_protocol_init(). Setting of this value to 0 keeps  */
+/* per-block heap allocation                                                   */
+#ifdef YOTTA_CFG_COAP_BLOCKWISE_PAYLOAD_POOL_SIZE
+#define SN_COAP_BLOCKWISE_PAYLOAD_POOL_SIZE YOTTA_CFG_COAP_BLOCKWISE_PAYLOAD_POOL_SIZE
+#elif defined MBED_CONF_MBED_CLIENT_SN_COAP_BLOCKWISE_PAYLOAD_POOL_SIZE
+#define SN_COAP_BLOCKWISE_PAYLOAD_POOL_SIZE MBED_CONF_MBED_CLIENT_SN_COAP_BLOCKWISE_PAYLOAD_POOL_SIZE
+#endif
+
+#ifndef SN_COAP_BLOCKWISE_PAYLOAD_POOL_SIZE
+#define SN_COAP_BLOCKWISE_PAYLOAD_POOL_SIZE         0
+#endif
+
 /* * For Option handling * */
 #define COAP_OPTION_MAX_AGE_DEFAULT                 60 /**< Default value of Max-Age if option not present */
 #define COAP_OPTION_URI_PORT_NONE                   (-1) /**< Internal value to represent no Uri-Port option */
@@ -212,6 +225,18 @@ typedef struct coap_blockwise_payload_ {
 
 typedef NS_LIST_HEAD(coap_blockwise_payload_s, link) coap_blockwise_payload_list_t;
 
+#if SN_COAP_BLOCKWISE_PAYLOAD_POOL_SIZE
+/* A pool block holds the list entry followed by fixed size room for the      */
+/* payload, the source address and the token, so storing a received block     */
+/* needs no heap allocation                                                   */
+#define SN_COAP_BLOCKWISE_PAYLOAD_POOL_ADDR_SIZE    16 /* IPv6 address */
+#define SN_COAP_BLOCKWISE_PAYLOAD_POOL_TOKEN_SIZE   8  /* Maximum CoAP token */
+#define SN_COAP_BLOCKWISE_PAYLOAD_POOL_BLOCK_SIZE   (sizeof(coap_blockwise_payload_s) + \
+        SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE + \
+        SN_COAP_BLOCKWISE_PAYLOAD_POOL_ADDR_SIZE + \
+        SN_COAP_BLOCKWISE_PAYLOAD_POOL_TOKEN_SIZE)
+#endif
+
 struct coap_s {
     void *(*sn_coap_protocol_malloc)(uint16_t);
     void (*sn_coap_protocol_free)(void *);
@@ -232,6 +257,9 @@ struct coap_s {
     #if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwise is not enabled, this part of code will not be compiled */
         coap_blockwise_msg_list_t     linked_list_blockwise_sent_msgs; /* Blockwise message to to be sent is stored to this Linked list */
         coap_blockwise_payload_list_t linked_list_blockwise_received_payloads; /* Blockwise payload to to be received is stored to this Linked list */
+        #if SN_COAP_BLOCKWISE_PAYLOAD_POOL_SIZE
+            coap_blockwise_payload_list_t linked_list_blockwise_payload_pool; /* Free pool blocks for received blockwise payloads */
+        #endif
     #endif
 
     uint32_t system_time;    /* System time seconds */
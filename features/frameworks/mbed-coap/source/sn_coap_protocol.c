@@ -76,6 +76,7 @@ static coap_send_msg_s      *sn_coap_protocol_allocate_mem_for_msg(struct coap_s
 static void                  sn_coap_protocol_release_allocated_send_msg_mem(struct coap_s *handle, coap_send_msg_s *freed_send_msg_ptr);
 static uint16_t              sn_coap_count_linked_list_size(const coap_send_msg_list_t *linked_list_ptr);
 static uint32_t              sn_coap_calculate_new_resend_time(const uint32_t current_time, const uint8_t interval, const uint8_t counter);
+static void                  sn_coap_protocol_linked_list_send_msg_insert(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr);
 #endif
 
 /* * * * * * * * * * * * * * * * * */
@@ -136,6 +137,14 @@ int8_t sn_coap_protocol_destroy(struct coap_s *handle)
             sn_coap_protocol_linked_list_blockwise_payload_remove(handle, tmp);
         }
     }
+
+#if SN_COAP_BLOCKWISE_PAYLOAD_POOL_SIZE
+    /* The payload removals above returned all pool blocks in use to the pool */
+    ns_list_foreach_safe(coap_blockwise_payload_s, tmp, &handle->linked_list_blockwise_payload_pool) {
+        ns_list_remove(&handle->linked_list_blockwise_payload_pool, tmp);
+        handle->sn_coap_protocol_free(tmp);
+    }
+#endif
 #endif
 
     handle->sn_coap_protocol_free(handle);
@@ -196,6 +205,27 @@ struct coap_s *sn_coap_protocol_init(void *(*used_malloc_func_ptr)(uint16_t), vo
     ns_list_init(&handle->linked_list_blockwise_received_payloads);
     handle->sn_coap_block_data_size = SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE;
 
+#if SN_COAP_BLOCKWISE_PAYLOAD_POOL_SIZE
+    /* * * * Pre-allocate pool blocks for received blockwise payloads * * * */
+    ns_list_init(&handle->linked_list_blockwise_payload_pool);
+
+    uint16_t i;
+    for (i = 0; i < SN_COAP_BLOCKWISE_PAYLOAD_POOL_SIZE; i++) {
+        coap_blockwise_payload_s *pool_block_ptr = used_malloc_func_ptr(SN_COAP_BLOCKWISE_PAYLOAD_POOL_BLOCK_SIZE);
+
+        if (pool_block_ptr == NULL) {
+            ns_list_foreach_safe(coap_blockwise_payload_s, tmp, &handle->linked_list_blockwise_payload_pool) {
+                ns_list_remove(&handle->linked_list_blockwise_payload_pool, tmp);
+                used_free_func_ptr(tmp);
+            }
+            used_free_func_ptr(handle);
+            return NULL;
+        }
+
+        ns_list_add_to_end(&handle->linked_list_blockwise_payload_pool, pool_block_ptr);
+    }
+#endif
+
 #endif /* ENABLE_RESENDINGS */
 
     /* Randomize global message ID */
@@ -837,55 +867,61 @@ int8_t sn_coap_protocol_exec(struct coap_s *handle, uint32_t current_time)
     /* foreach_safe isn't sufficient because callback routine could cancel messages. */
 rescan:
     ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
+        /* List is kept in resending time order, so the first message that is
+         * not yet due ends the scan */
+        if (current_time < stored_msg_ptr->resending_time) {
+            break;
+        }
         // First check that msg belongs to handle
         if( stored_msg_ptr->coap == handle ){
-            /* Check if it is time to send this message */
-            if (current_time >= stored_msg_ptr->resending_time) {
-                /* * * Increase Resending counter  * * */
-                stored_msg_ptr->resending_counter++;
+            /* * * Increase Resending counter  * * */
+            stored_msg_ptr->resending_counter++;
 
-                /* Check if all re-sendings have been done */
-                if (stored_msg_ptr->resending_counter > handle->sn_coap_resending_count) {
-                    coap_version_e coap_version = COAP_VERSION_UNKNOWN;
+            /* Check if all re-sendings have been done */
+            if (stored_msg_ptr->resending_counter > handle->sn_coap_resending_count) {
+                coap_version_e coap_version = COAP_VERSION_UNKNOWN;
 
-                    /* Get message ID from stored sending message */
-                    uint16_t temp_msg_id = (stored_msg_ptr->send_msg_ptr->packet_ptr[2] << 8);
-                    temp_msg_id += (uint16_t)stored_msg_ptr->send_msg_ptr->packet_ptr[3];
+                /* Get message ID from stored sending message */
+                uint16_t temp_msg_id = (stored_msg_ptr->send_msg_ptr->packet_ptr[2] << 8);
+                temp_msg_id += (uint16_t)stored_msg_ptr->send_msg_ptr->packet_ptr[3];
 
-                    /* Remove message from Linked list */
-                    ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
-                    --handle->count_resent_msgs;
+                /* Remove message from Linked list */
+                ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
+                --handle->count_resent_msgs;
 
-                    /* If RX callback have been defined.. */
-                    if (stored_msg_ptr->coap->sn_coap_rx_callback != 0) {
-                        sn_coap_hdr_s *tmp_coap_hdr_ptr;
-                        /* Parse CoAP message, set status and call RX callback */
-                        tmp_coap_hdr_ptr = sn_coap_parser(stored_msg_ptr->coap, stored_msg_ptr->send_msg_ptr->packet_len, stored_msg_ptr->send_msg_ptr->packet_ptr, &coap_version);
+                /* If RX callback have been defined.. */
+                if (stored_msg_ptr->coap->sn_coap_rx_callback != 0) {
+                    sn_coap_hdr_s *tmp_coap_hdr_ptr;
+                    /* Parse CoAP message, set status and call RX callback */
+                    tmp_coap_hdr_ptr = sn_coap_parser(stored_msg_ptr->coap, stored_msg_ptr->send_msg_ptr->packet_len, stored_msg_ptr->send_msg_ptr->packet_ptr, &coap_version);
 
-                        if (tmp_coap_hdr_ptr != 0) {
-                            tmp_coap_hdr_ptr->coap_status = COAP_STATUS_BUILDER_MESSAGE_SENDING_FAILED;
-                            stored_msg_ptr->coap->sn_coap_rx_callback(tmp_coap_hdr_ptr, stored_msg_ptr->send_msg_ptr->dst_addr_ptr, stored_msg_ptr->param);
+                    if (tmp_coap_hdr_ptr != 0) {
+                        tmp_coap_hdr_ptr->coap_status = COAP_STATUS_BUILDER_MESSAGE_SENDING_FAILED;
+                        stored_msg_ptr->coap->sn_coap_rx_callback(tmp_coap_hdr_ptr, stored_msg_ptr->send_msg_ptr->dst_addr_ptr, stored_msg_ptr->param);
 
-                            sn_coap_parser_release_allocated_coap_msg_mem(stored_msg_ptr->coap, tmp_coap_hdr_ptr);
-                        }
+                        sn_coap_parser_release_allocated_coap_msg_mem(stored_msg_ptr->coap, tmp_coap_hdr_ptr);
                     }
-
-                    /* Free memory of stored message */
-                    sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
-                } else {
-                    /* Send message  */
-                    stored_msg_ptr->coap->sn_coap_tx_callback(stored_msg_ptr->send_msg_ptr->packet_ptr,
-                            stored_msg_ptr->send_msg_ptr->packet_len, stored_msg_ptr->send_msg_ptr->dst_addr_ptr, stored_msg_ptr->param);
-
-                    /* * * Count new Resending time  * * */
-                    stored_msg_ptr->resending_time = sn_coap_calculate_new_resend_time(current_time,
-                                                                                       handle->sn_coap_resending_intervall,
-                                                                                       stored_msg_ptr->resending_counter);
                 }
-                /* Callback routine could have wiped the list (eg as a response to sending failed) */
-                /* Be super cautious and rescan from the start */
-                goto rescan;
+
+                /* Free memory of stored message */
+                sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
+            } else {
+                /* Send message  */
+                stored_msg_ptr->coap->sn_coap_tx_callback(stored_msg_ptr->send_msg_ptr->packet_ptr,
+                        stored_msg_ptr->send_msg_ptr->packet_len, stored_msg_ptr->send_msg_ptr->dst_addr_ptr, stored_msg_ptr->param);
+
+                /* * * Count new Resending time  * * */
+                stored_msg_ptr->resending_time = sn_coap_calculate_new_resend_time(current_time,
+                                                                                   handle->sn_coap_resending_intervall,
+                                                                                   stored_msg_ptr->resending_counter);
+
+                /* Move message to its new place in the time ordered list */
+                ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
+                sn_coap_protocol_linked_list_send_msg_insert(handle, stored_msg_ptr);
             }
+            /* Callback routine could have wiped the list (eg as a response to sending failed) */
+            /* Be super cautious and rescan from the start */
+            goto rescan;
         }
     }
 
@@ -894,6 +930,64 @@ rescan:
     return 0;
 }
 
+uint32_t sn_coap_protocol_next_timed_event(struct coap_s *handle)
+{
+    uint32_t next_time = 0;
+
+    if (!handle) {
+        return 0;
+    }
+
+#if ENABLE_RESENDINGS
+    {
+        /* Re-sending queue is kept in resending time order, so the head
+         * carries the nearest deadline */
+        const coap_send_msg_s *stored_msg_ptr = ns_list_get_first(&handle->linked_list_resent_msgs);
+        if (stored_msg_ptr) {
+            next_time = stored_msg_ptr->resending_time;
+        }
+    }
+#endif
+
+#if SN_COAP_DUPLICATION_MAX_MSGS_COUNT
+    {
+        /* Duplication infos are stored in arrival order, so the head is the
+         * oldest; it expires once it has been stored for longer than
+         * SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED */
+        const coap_duplication_info_s *duplication_info_ptr = ns_list_get_first(&handle->linked_list_duplication_msgs);
+        if (duplication_info_ptr) {
+            uint32_t removal_time = duplication_info_ptr->timestamp + SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED + 1;
+            if (next_time == 0 || removal_time < next_time) {
+                next_time = removal_time;
+            }
+        }
+    }
+#endif
+
+#if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+    {
+        /* Blockwise lists are also stored in arrival order */
+        const coap_blockwise_msg_s *blockwise_msg_ptr = ns_list_get_first(&handle->linked_list_blockwise_sent_msgs);
+        if (blockwise_msg_ptr) {
+            uint32_t removal_time = blockwise_msg_ptr->timestamp + SN_COAP_BLOCKWISE_MAX_TIME_DATA_STORED + 1;
+            if (next_time == 0 || removal_time < next_time) {
+                next_time = removal_time;
+            }
+        }
+
+        const coap_blockwise_payload_s *blockwise_payload_ptr = ns_list_get_first(&handle->linked_list_blockwise_received_payloads);
+        if (blockwise_payload_ptr) {
+            uint32_t removal_time = blockwise_payload_ptr->timestamp + SN_COAP_BLOCKWISE_MAX_TIME_DATA_STORED + 1;
+            if (next_time == 0 || removal_time < next_time) {
+                next_time = removal_time;
+            }
+        }
+    }
+#endif
+
+    return next_time;
+}
+
 #if ENABLE_RESENDINGS  /* If Message resending is not used at all, this part of code will not be compiled */
 
 /**************************************************************************//**
@@ -967,11 +1061,38 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle
     stored_msg_ptr->param = param;
 
     /* Storing Resending message to Linked list */
-    ns_list_add_to_end(&handle->linked_list_resent_msgs, stored_msg_ptr);
+    sn_coap_protocol_linked_list_send_msg_insert(handle, stored_msg_ptr);
     ++handle->count_resent_msgs;
     return 1;
 }
 
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_linked_list_send_msg_insert(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+ *
+ * \brief Inserts message to re-sending Linked list in resending time order
+ *
+ *        Keeping the list ordered by resending time means the head is always
+ *        the nearest deadline: sn_coap_protocol_exec can stop scanning at the
+ *        first message that is not due, and sn_coap_protocol_next_timed_event
+ *        reads the next deadline in constant time.
+ *
+ * \param *handle Pointer to CoAP library handle
+ *
+ * \param *stored_msg_ptr is pointer to message to be inserted
+ *****************************************************************************/
+
+static void sn_coap_protocol_linked_list_send_msg_insert(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+{
+    ns_list_foreach(coap_send_msg_s, tmp_msg_ptr, &handle->linked_list_resent_msgs) {
+        if (tmp_msg_ptr->resending_time > stored_msg_ptr->resending_time) {
+            ns_list_add_before(&handle->linked_list_resent_msgs, tmp_msg_ptr, stored_msg_ptr);
+            return;
+        }
+    }
+
+    ns_list_add_to_end(&handle->linked_list_resent_msgs, stored_msg_ptr);
+}
+
 /**************************************************************************//**
  * \fn static sn_nsdl_transmit_s *sn_coap_protocol_linked_list_send_msg_search(sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
  *
@@ -1319,6 +1440,38 @@ static void sn_coap_protocol_linked_list_blockwise_payload_store(struct coap_s *
 
     coap_blockwise_payload_s *stored_blockwise_payload_ptr = NULL;
 
+#if SN_COAP_BLOCKWISE_PAYLOAD_POOL_SIZE
+    /* * * * Carving a pool block for stored Payload  * * * */
+
+    if ((stored_payload_len > SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE) ||
+            (addr_ptr->addr_len > SN_COAP_BLOCKWISE_PAYLOAD_POOL_ADDR_SIZE) ||
+            (token_len > SN_COAP_BLOCKWISE_PAYLOAD_POOL_TOKEN_SIZE)) {
+        tr_error("sn_coap_protocol_linked_list_blockwise_payload_store - block does not fit in a pool block!");
+        return;
+    }
+
+    stored_blockwise_payload_ptr = ns_list_get_first(&handle->linked_list_blockwise_payload_pool);
+
+    if (stored_blockwise_payload_ptr == NULL) {
+        tr_error("sn_coap_protocol_linked_list_blockwise_payload_store - blockwise pool exhausted!");
+        return;
+    }
+
+    ns_list_remove(&handle->linked_list_blockwise_payload_pool, stored_blockwise_payload_ptr);
+
+    /* Point payload, address and token into the room reserved in the block */
+    stored_blockwise_payload_ptr->payload_ptr = (uint8_t *)stored_blockwise_payload_ptr + sizeof(coap_blockwise_payload_s);
+    stored_blockwise_payload_ptr->addr_ptr = stored_blockwise_payload_ptr->payload_ptr + SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE;
+
+    if (token_ptr && token_len) {
+        stored_blockwise_payload_ptr->token_ptr = stored_blockwise_payload_ptr->addr_ptr + SN_COAP_BLOCKWISE_PAYLOAD_POOL_ADDR_SIZE;
+        memcpy(stored_blockwise_payload_ptr->token_ptr, token_ptr, token_len);
+        stored_blockwise_payload_ptr->token_len = token_len;
+    } else {
+        stored_blockwise_payload_ptr->token_ptr = NULL;
+        stored_blockwise_payload_ptr->token_len = 0;
+    }
+#else
     /* * * * Allocating memory for stored Payload  * * * */
 
     /* Allocate memory for stored Payload's structure */
@@ -1371,6 +1524,7 @@ static void sn_coap_protocol_linked_list_blockwise_payload_store(struct coap_s *
         stored_blockwise_payload_ptr->token_ptr = NULL;
         stored_blockwise_payload_ptr->token_len = 0;
     }
+#endif
 
     /* * * * Filling fields of stored Payload  * * * */
 
@@ -1491,6 +1645,10 @@ static void sn_coap_protocol_linked_list_blockwise_payload_remove(struct coap_s
                                                                   coap_blockwise_payload_s *removed_payload_ptr)
 {
     ns_list_remove(&handle->linked_list_blockwise_received_payloads, removed_payload_ptr);
+#if SN_COAP_BLOCKWISE_PAYLOAD_POOL_SIZE
+    /* Return the pool block carved for the stored payload */
+    ns_list_add_to_end(&handle->linked_list_blockwise_payload_pool, removed_payload_ptr);
+#else
     /* Free memory of stored payload */
     if (removed_payload_ptr->addr_ptr != NULL) {
         handle->sn_coap_protocol_free(removed_payload_ptr->addr_ptr);
@@ -1509,6 +1667,7 @@ static void sn_coap_protocol_linked_list_blockwise_payload_remove(struct coap_s
 
     handle->sn_coap_protocol_free(removed_payload_ptr);
     removed_payload_ptr = 0;
+#endif
 }
 
 /**************************************************************************//**
@@ -263,6 +263,93 @@ void mbed_trace_mutex_wait_function_set(void (*mutex_wait_f)(void));
  * be acquired from a single thread repeatedly.
  */
 void mbed_trace_mutex_release_function_set(void (*mutex_release_f)(void));
+/**
+ * Enable or disable deferred mode.
+ * In deferred mode a trace call only stores the format string pointer, group
+ * pointer and raw argument words into a queue (the strings live in flash, so
+ * the pointers suffice) and returns - the line is formatted and printed later
+ * when mbed_trace_deferred_dequeue or mbed_trace_deferred_flush is called,
+ * typically from a low-priority thread or event queue. This takes the cost of
+ * vsnprintf and the print function out of the traced path, so debug tracing
+ * can stay enabled in time-critical code.
+ *
+ * Limitations of deferred mode:
+ *  - only word-sized arguments are captured: int, unsigned, pointers. Formats
+ *    using float, double or 64-bit integer conversions are not supported.
+ *  - at most 8 arguments are captured per call.
+ *  - string arguments must stay valid until the queue is drained, which means
+ *    string literals; the mbed_trace_array/mbed_trace_ipv6 helpers return
+ *    pointers to a shared temporary buffer and cannot be used.
+ *  - TRACE_LEVEL_CMD calls are printed synchronously as before.
+ * When the queue is full further calls are dropped and counted.
+ * The queue is allocated on the first enable; queue length can be configured
+ * with MBED_TRACE_DEFERRED_QUEUE_LENGTH (default 32 records).
+ * @param enable  1 to defer formatting, 0 to format at the call site again
+ * @return 0 when success, otherwise non zero (queue allocation failed)
+ */
+int mbed_trace_deferred_enable(uint8_t enable);
+/**
+ * Format and print the oldest queued trace call.
+ * Call repeatedly from the drain context while it returns non zero.
+ * @return 1 when a queued call was printed, 0 when the queue was empty
+ */
+int mbed_trace_deferred_dequeue(void);
+/**
+ * Format and print every queued trace call.
+ */
+void mbed_trace_deferred_flush(void);
+/**
+ * Get the number of trace calls dropped because the deferred queue was full.
+ */
+uint32_t mbed_trace_deferred_dropped(void);
+/**
+ * Add an additional trace sink.
+ * Sinks receive the formatted trace line in parallel with the print function
+ * set by mbed_trace_print_function_set, each with its own level filter and an
+ * optional token-bucket rate limit - for example the console at info level
+ * alongside an in-RAM crash ring at debug level and a network sink limited to
+ * a few lines per second. A line is formatted once and fanned out to every
+ * sink whose filter accepts it; when no sink (and not the default output)
+ * accepts the level, the call returns after a single mask test.
+ *
+ * Rate limiting needs a millisecond clock, see mbed_trace_clock_function_set.
+ * Without a clock the bucket cannot refill and the limit is not enforced.
+ *
+ * The number of sinks is configured with MBED_TRACE_MAX_SINKS (default 4).
+ * @param print_f        sink output function, same contract as
+ *                       mbed_trace_print_function_set
+ * @param level_mask     TRACE_ACTIVE_LEVEL_* mask of levels this sink receives
+ * @param lines_per_sec  sustained line rate the token bucket refills at,
+ *                       0 for no rate limit
+ * @param burst          bucket capacity in lines, i.e. the longest burst let
+ *                       through at full speed (ignored when lines_per_sec is 0)
+ * @return sink id (>= 0) when successful, otherwise -1 (sink table full)
+ */
+int8_t mbed_trace_sink_add(void (*print_f)(const char *), uint8_t level_mask,
+                           uint32_t lines_per_sec, uint32_t burst);
+/**
+ * Remove a trace sink.
+ * @param sink_id  id returned by mbed_trace_sink_add
+ */
+void mbed_trace_sink_remove(int8_t sink_id);
+/**
+ * Change the level filter of a trace sink.
+ * @param sink_id     id returned by mbed_trace_sink_add
+ * @param level_mask  new TRACE_ACTIVE_LEVEL_* mask
+ */
+void mbed_trace_sink_level_set(int8_t sink_id, uint8_t level_mask);
+/**
+ * Get the number of lines a sink's rate limit has dropped.
+ * @param sink_id  id returned by mbed_trace_sink_add
+ * @return dropped line count since the sink was added
+ */
+uint32_t mbed_trace_sink_dropped(int8_t sink_id);
+/**
+ * Set the millisecond clock used for sink rate limiting.
+ * The function must return a monotonic millisecond count; wrapping is
+ * handled. On an RTOS build the kernel tick count is a natural source.
+ */
+void mbed_trace_clock_function_set(uint32_t (*clock_f)(void));
 /**
  * When trace group contains text in filters,
  * trace print will be ignored.
@@ -394,6 +481,15 @@ char *mbed_trace_array(const uint8_t *buf, uint16_t len);
 #undef mbed_trace_cmdprint_function_set
 #undef mbed_trace_mutex_wait_function_set
 #undef mbed_trace_mutex_release_function_set
+#undef mbed_trace_deferred_enable
+#undef mbed_trace_deferred_dequeue
+#undef mbed_trace_deferred_flush
+#undef mbed_trace_deferred_dropped
+#undef mbed_trace_sink_add
+#undef mbed_trace_sink_remove
+#undef mbed_trace_sink_level_set
+#undef mbed_trace_sink_dropped
+#undef mbed_trace_clock_function_set
 #undef mbed_trace_exclude_filters_set
 #undef mbed_trace_exclude_filters_get
 #undef mbed_trace_include_filters_set
@@ -419,6 +515,15 @@ char *mbed_trace_array(const uint8_t *buf, uint16_t len);
 #define mbed_trace_cmdprint_function_set(...)       ((void) 0)
 #define mbed_trace_mutex_wait_function_set(...)     ((void) 0)
 #define mbed_trace_mutex_release_function_set(...)  ((void) 0)
+#define mbed_trace_deferred_enable(...)             ((int) 0)
+#define mbed_trace_deferred_dequeue(...)            ((int) 0)
+#define mbed_trace_deferred_flush(...)              ((void) 0)
+#define mbed_trace_deferred_dropped(...)            ((uint32_t) 0)
+#define mbed_trace_sink_add(...)                    ((int8_t) -1)
+#define mbed_trace_sink_remove(...)                 ((void) 0)
+#define mbed_trace_sink_level_set(...)              ((void) 0)
+#define mbed_trace_sink_dropped(...)                ((uint32_t) 0)
+#define mbed_trace_clock_function_set(...)          ((void) 0)
 #define mbed_trace_exclude_filters_set(...)         ((void) 0)
 #define mbed_trace_exclude_filters_get(...)         ((const char *) 0)
 #define mbed_trace_include_filters_set(...)         ((void) 0)
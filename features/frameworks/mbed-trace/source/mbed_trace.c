@@ -92,10 +92,68 @@
 #define DEFAULT_TRACE_CONFIG              TRACE_MODE_COLOR | TRACE_ACTIVE_LEVEL_ALL | TRACE_CARRIAGE_RETURN
 #endif
 
+/** default number of records in the deferred-mode queue */
+#ifdef MBED_TRACE_DEFERRED_QUEUE_LENGTH
+#define DEFAULT_TRACE_DEFERRED_QUEUE_LENGTH   MBED_TRACE_DEFERRED_QUEUE_LENGTH
+#else
+#define DEFAULT_TRACE_DEFERRED_QUEUE_LENGTH   32
+#endif
+
+/** number of argument words captured per deferred record; must match the
+    argument expansion in mbed_trace_deferred_emit */
+#define TRACE_DEFERRED_MAX_ARGS               8
+
+/** default number of additional trace sinks */
+#ifdef MBED_TRACE_MAX_SINKS
+#define DEFAULT_TRACE_MAX_SINKS               MBED_TRACE_MAX_SINKS
+#else
+#define DEFAULT_TRACE_MAX_SINKS               4
+#endif
+
+/** tokens are counted in thousandths of a line so that a millisecond clock
+    refills a lines-per-second rate without division */
+#define TRACE_SINK_TOKEN_SCALE                1000
+
+/** one queued trace call: the format string and group tag live in flash,
+    so storing the pointers and the raw argument words is enough to
+    rebuild the line later */
+typedef struct trace_deferred_s {
+    /** trace level of the call */
+    uint8_t dlevel;
+    /** trace group of the call */
+    const char *grp;
+    /** format string of the call */
+    const char *fmt;
+    /** raw argument words of the call */
+    uintptr_t args[TRACE_DEFERRED_MAX_ARGS];
+} trace_deferred_t;
+
+/** one additional trace sink with its own level filter and token bucket */
+typedef struct trace_sink_s {
+    /** sink output function, NULL when the slot is free */
+    void (*print_f)(const char *);
+    /** levels this sink receives */
+    uint8_t level_mask;
+    /** token refill rate in lines per second, 0 for no rate limit */
+    uint32_t rate;
+    /** bucket capacity in thousandths of a line */
+    uint32_t burst_scaled;
+    /** tokens currently in the bucket, in thousandths of a line */
+    uint32_t tokens_scaled;
+    /** clock reading at the last refill */
+    uint32_t last_refill;
+    /** lines dropped by the rate limit */
+    uint32_t dropped;
+} trace_sink_t;
+
 /** default print function, just redirect str to printf */
 static void mbed_trace_realloc(char **buffer, int *length_ptr, int new_length);
 static void mbed_trace_default_print(const char *str);
 static void mbed_trace_reset_tmp(void);
+static void mbed_vtracef_internal(uint8_t dlevel, const char *grp, const char *fmt, va_list ap, int allow_defer);
+static void mbed_trace_deferred_enqueue(uint8_t dlevel, const char *grp, const char *fmt, va_list ap);
+static void mbed_trace_update_active_levels(void);
+static void mbed_trace_dispatch(uint8_t dlevel, const char *line);
 
 typedef struct trace_s {
     /** trace configuration bits */
@@ -131,6 +189,24 @@ typedef struct trace_s {
     void (*mutex_release_f)(void);
     /** number of times the mutex has been locked */
     int mutex_lock_count;
+    /** deferred mode active */
+    uint8_t deferred;
+    /** deferred-mode record queue */
+    trace_deferred_t *deferred_queue;
+    /** index of the oldest queued record */
+    int deferred_head;
+    /** number of queued records */
+    int deferred_count;
+    /** records dropped because the queue was full */
+    uint32_t deferred_dropped;
+    /** union of the configured level mask and every sink's level mask; a
+        trace call whose level is not in this mask has no consumer anywhere
+        and is dropped with a single mask test */
+    uint8_t active_levels;
+    /** millisecond clock used for sink rate limiting */
+    uint32_t (*clock_f)(void);
+    /** additional trace sinks */
+    trace_sink_t sinks[DEFAULT_TRACE_MAX_SINKS];
 } trace_t;
 
 static trace_t m_trace = {
@@ -148,7 +224,15 @@ static trace_t m_trace = {
     .cmd_printf = 0,
     .mutex_wait_f = 0,
     .mutex_release_f = 0,
-    .mutex_lock_count = 0
+    .mutex_lock_count = 0,
+    .deferred = 0,
+    .deferred_queue = 0,
+    .deferred_head = 0,
+    .deferred_count = 0,
+    .deferred_dropped = 0,
+    .active_levels = (DEFAULT_TRACE_CONFIG) & TRACE_MASK_LEVEL,
+    .clock_f = 0,
+    .sinks = {{0}}
 };
 
 int mbed_trace_init(void)
@@ -191,6 +275,7 @@ void mbed_trace_free(void)
     MBED_TRACE_MEM_FREE(m_trace.tmp_data);
     MBED_TRACE_MEM_FREE(m_trace.filters_exclude);
     MBED_TRACE_MEM_FREE(m_trace.filters_include);
+    MBED_TRACE_MEM_FREE(m_trace.deferred_queue);
 
     // reset to default values
     m_trace.trace_config = DEFAULT_TRACE_CONFIG;
@@ -208,6 +293,14 @@ void mbed_trace_free(void)
     m_trace.mutex_wait_f = 0;
     m_trace.mutex_release_f = 0;
     m_trace.mutex_lock_count = 0;
+    m_trace.deferred = 0;
+    m_trace.deferred_queue = 0;
+    m_trace.deferred_head = 0;
+    m_trace.deferred_count = 0;
+    m_trace.deferred_dropped = 0;
+    m_trace.active_levels = (DEFAULT_TRACE_CONFIG) & TRACE_MASK_LEVEL;
+    m_trace.clock_f = 0;
+    memset(m_trace.sinks, 0, sizeof(m_trace.sinks));
 }
 static void mbed_trace_realloc(char **buffer, int *length_ptr, int new_length)
 {
@@ -228,6 +321,7 @@ void mbed_trace_buffer_sizes(int lineLength, int tmpLength)
 void mbed_trace_config_set(uint8_t config)
 {
     m_trace.trace_config = config;
+    mbed_trace_update_active_levels();
 }
 uint8_t mbed_trace_config_get(void)
 {
@@ -249,6 +343,68 @@ void mbed_trace_cmdprint_function_set(void (*printf)(const char *))
 {
     m_trace.cmd_printf = printf;
 }
+static void mbed_trace_update_active_levels(void)
+{
+    uint8_t levels = m_trace.trace_config & TRACE_MASK_LEVEL;
+    for (int i = 0; i < DEFAULT_TRACE_MAX_SINKS; i++) {
+        if (m_trace.sinks[i].print_f) {
+            levels |= m_trace.sinks[i].level_mask;
+        }
+    }
+    m_trace.active_levels = levels;
+}
+int8_t mbed_trace_sink_add(void (*print_f)(const char *), uint8_t level_mask,
+                           uint32_t lines_per_sec, uint32_t burst)
+{
+    if (print_f == NULL) {
+        return -1;
+    }
+    for (int8_t i = 0; i < DEFAULT_TRACE_MAX_SINKS; i++) {
+        trace_sink_t *sink = &m_trace.sinks[i];
+        if (sink->print_f == NULL) {
+            sink->level_mask = level_mask;
+            sink->rate = lines_per_sec;
+            sink->burst_scaled = burst * TRACE_SINK_TOKEN_SCALE;
+            //start with a full bucket so the sink is usable immediately
+            sink->tokens_scaled = sink->burst_scaled;
+            sink->last_refill = m_trace.clock_f ? m_trace.clock_f() : 0;
+            sink->dropped = 0;
+            //publish the output function last; dispatch treats a set
+            //function as the slot being live
+            sink->print_f = print_f;
+            mbed_trace_update_active_levels();
+            return i;
+        }
+    }
+    return -1;
+}
+void mbed_trace_sink_remove(int8_t sink_id)
+{
+    if (sink_id < 0 || sink_id >= DEFAULT_TRACE_MAX_SINKS) {
+        return;
+    }
+    m_trace.sinks[sink_id].print_f = 0;
+    mbed_trace_update_active_levels();
+}
+void mbed_trace_sink_level_set(int8_t sink_id, uint8_t level_mask)
+{
+    if (sink_id < 0 || sink_id >= DEFAULT_TRACE_MAX_SINKS) {
+        return;
+    }
+    m_trace.sinks[sink_id].level_mask = level_mask;
+    mbed_trace_update_active_levels();
+}
+uint32_t mbed_trace_sink_dropped(int8_t sink_id)
+{
+    if (sink_id < 0 || sink_id >= DEFAULT_TRACE_MAX_SINKS) {
+        return 0;
+    }
+    return m_trace.sinks[sink_id].dropped;
+}
+void mbed_trace_clock_function_set(uint32_t (*clock_f)(void))
+{
+    m_trace.clock_f = clock_f;
+}
 void mbed_trace_mutex_wait_function_set(void (*mutex_wait_f)(void))
 {
     m_trace.mutex_wait_f = mutex_wait_f;
@@ -304,6 +460,43 @@ static void mbed_trace_default_print(const char *str)
 {
     puts(str);
 }
+static int mbed_trace_sink_take_token(trace_sink_t *sink)
+{
+    if (m_trace.clock_f == NULL) {
+        //no clock, the bucket cannot refill - do not enforce the limit
+        return 1;
+    }
+    uint32_t now = m_trace.clock_f();
+    uint32_t elapsed = now - sink->last_refill; //wrap-safe on unsigned
+    if (elapsed) {
+        //rate lines/s equals rate thousandths of a line per millisecond
+        uint64_t tokens = (uint64_t)sink->tokens_scaled + (uint64_t)elapsed * sink->rate;
+        sink->tokens_scaled = (tokens > sink->burst_scaled) ? sink->burst_scaled : (uint32_t)tokens;
+        sink->last_refill = now;
+    }
+    if (sink->tokens_scaled >= TRACE_SINK_TOKEN_SCALE) {
+        sink->tokens_scaled -= TRACE_SINK_TOKEN_SCALE;
+        return 1;
+    }
+    return 0;
+}
+static void mbed_trace_dispatch(uint8_t dlevel, const char *line)
+{
+    if ((m_trace.trace_config & TRACE_MASK_LEVEL) & dlevel) {
+        m_trace.printf(line);
+    }
+    for (int i = 0; i < DEFAULT_TRACE_MAX_SINKS; i++) {
+        trace_sink_t *sink = &m_trace.sinks[i];
+        if (sink->print_f == NULL || !(sink->level_mask & dlevel)) {
+            continue;
+        }
+        if (sink->rate && !mbed_trace_sink_take_token(sink)) {
+            sink->dropped++;
+            continue;
+        }
+        sink->print_f(line);
+    }
+}
 void mbed_tracef(uint8_t dlevel, const char *grp, const char *fmt, ...)
 {
     va_list ap;
@@ -313,6 +506,20 @@ void mbed_tracef(uint8_t dlevel, const char *grp, const char *fmt, ...)
 }
 void mbed_vtracef(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
 {
+    mbed_vtracef_internal(dlevel, grp, fmt, ap, 1);
+}
+static void mbed_vtracef_internal(uint8_t dlevel, const char *grp, const char *fmt, va_list ap, int allow_defer)
+{
+    if (!(m_trace.active_levels & dlevel) && !m_trace.mutex_wait_f) {
+        //no consumer anywhere - neither the default output nor any sink -
+        //accepts this level, so the call costs one mask test. When a trace
+        //mutex is in use a helper function may already hold the lock for
+        //this call, so the shortcut cannot be taken and the level is
+        //checked below as before.
+        mbed_trace_reset_tmp();
+        return;
+    }
+
     if (m_trace.mutex_wait_f) {
         m_trace.mutex_wait_f();
         m_trace.mutex_lock_count++;
@@ -329,7 +536,16 @@ void mbed_vtracef(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
         mbed_trace_reset_tmp();
         goto end;
     }
-    if ((m_trace.trace_config & TRACE_MASK_LEVEL) &  dlevel) {
+    if (allow_defer && m_trace.deferred && dlevel != TRACE_LEVEL_CMD &&
+            (m_trace.active_levels & dlevel)) {
+        //store the call for the drain to format later; the format string
+        //arguments were copied as raw words, so the mutex is only held for
+        //the queue insert
+        mbed_trace_deferred_enqueue(dlevel, grp, fmt, ap);
+        mbed_trace_reset_tmp();
+        goto end;
+    }
+    if (m_trace.active_levels & dlevel) {
         bool color = (m_trace.trace_config & TRACE_MODE_COLOR) != 0;
         bool plain = (m_trace.trace_config & TRACE_MODE_PLAIN) != 0;
         bool cr    = (m_trace.trace_config & TRACE_CARRIAGE_RETURN) != 0;
@@ -343,8 +559,8 @@ void mbed_vtracef(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
                 m_trace.cmd_printf(m_trace.line);
                 m_trace.cmd_printf("\n");
             } else {
-                //print out whole data
-                m_trace.printf(m_trace.line);
+                //fan the whole data out to every sink that wants the level
+                mbed_trace_dispatch(dlevel, m_trace.line);
             }
         } else {
             if (color) {
@@ -468,8 +684,8 @@ void mbed_vtracef(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
                     //bLeft -= retval;
                 }
             }
-            //print out whole data
-            m_trace.printf(m_trace.line);
+            //fan the whole data out to every sink that wants the level
+            mbed_trace_dispatch(dlevel, m_trace.line);
         }
         //return tmp data pointer back to the beginning
         mbed_trace_reset_tmp();
@@ -493,6 +709,87 @@ end:
         } while (--count > 0);
     }
 }
+static void mbed_trace_deferred_enqueue(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
+{
+    if (m_trace.deferred_queue == NULL) {
+        return;
+    }
+    if (m_trace.deferred_count >= DEFAULT_TRACE_DEFERRED_QUEUE_LENGTH) {
+        m_trace.deferred_dropped++;
+        return;
+    }
+    trace_deferred_t *rec = &m_trace.deferred_queue[
+                      (m_trace.deferred_head + m_trace.deferred_count) % DEFAULT_TRACE_DEFERRED_QUEUE_LENGTH];
+    rec->dlevel = dlevel;
+    rec->grp = grp;
+    rec->fmt = fmt;
+    // Copy a fixed number of argument words without looking at the format
+    // string; words the format does not consume are just ignored when the
+    // line is built. This is why deferred mode only supports word-sized
+    // arguments (int, unsigned, pointers, string literals).
+    for (int i = 0; i < TRACE_DEFERRED_MAX_ARGS; i++) {
+        rec->args[i] = va_arg(ap, uintptr_t);
+    }
+    m_trace.deferred_count++;
+}
+static void mbed_trace_deferred_emit(uint8_t dlevel, const char *grp, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    mbed_vtracef_internal(dlevel, grp, fmt, ap, 0);
+    va_end(ap);
+}
+int mbed_trace_deferred_enable(uint8_t enable)
+{
+    if (enable && m_trace.deferred_queue == NULL) {
+        m_trace.deferred_queue = MBED_TRACE_MEM_ALLOC(
+                                     DEFAULT_TRACE_DEFERRED_QUEUE_LENGTH * sizeof(trace_deferred_t));
+        if (m_trace.deferred_queue == NULL) {
+            //memory allocation fail
+            return -1;
+        }
+        m_trace.deferred_head = 0;
+        m_trace.deferred_count = 0;
+    }
+    m_trace.deferred = enable ? 1 : 0;
+    return 0;
+}
+int mbed_trace_deferred_dequeue(void)
+{
+    trace_deferred_t rec;
+
+    if (m_trace.mutex_wait_f) {
+        m_trace.mutex_wait_f();
+    }
+    if (m_trace.deferred_queue == NULL || m_trace.deferred_count == 0) {
+        if (m_trace.mutex_release_f) {
+            m_trace.mutex_release_f();
+        }
+        return 0;
+    }
+    rec = m_trace.deferred_queue[m_trace.deferred_head];
+    m_trace.deferred_head = (m_trace.deferred_head + 1) % DEFAULT_TRACE_DEFERRED_QUEUE_LENGTH;
+    m_trace.deferred_count--;
+    if (m_trace.mutex_release_f) {
+        m_trace.mutex_release_f();
+    }
+
+    // format and print outside the queue lock; the expansion must cover
+    // TRACE_DEFERRED_MAX_ARGS words
+    mbed_trace_deferred_emit(rec.dlevel, rec.grp, rec.fmt,
+                             rec.args[0], rec.args[1], rec.args[2], rec.args[3],
+                             rec.args[4], rec.args[5], rec.args[6], rec.args[7]);
+    return 1;
+}
+void mbed_trace_deferred_flush(void)
+{
+    while (mbed_trace_deferred_dequeue()) {
+    }
+}
+uint32_t mbed_trace_deferred_dropped(void)
+{
+    return m_trace.deferred_dropped;
+}
 static void mbed_trace_reset_tmp(void)
 {
     m_trace.tmp_data_ptr = m_trace.tmp_data;
@@ -499,3 +499,35 @@ TEST(trace, uninitialized)
     STRCMP_EQUAL("hello", buf);
 }
 
+TEST(trace, deferred_mode)
+{
+    CHECK(mbed_trace_deferred_enable(1) == 0);
+
+    buf[0] = 0;
+    mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "deferred %d %s", 42, "args");
+    STRCMP_EQUAL("", buf); // nothing printed at the call site
+
+    CHECK(mbed_trace_deferred_dequeue() == 1);
+    STRCMP_EQUAL("deferred 42 args", buf);
+    CHECK(mbed_trace_deferred_dequeue() == 0);
+
+    mbed_trace_deferred_enable(0);
+    mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "immediate again");
+    STRCMP_EQUAL("immediate again", buf);
+}
+TEST(trace, deferred_queue_full)
+{
+    CHECK(mbed_trace_deferred_enable(1) == 0);
+
+    // the default queue holds 32 records, the rest are dropped
+    for (int i = 0; i < 40; i++) {
+        mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "msg %d", i);
+    }
+    CHECK(mbed_trace_deferred_dropped() == 8);
+
+    mbed_trace_deferred_flush();
+    STRCMP_EQUAL("msg 31", buf);
+    CHECK(mbed_trace_deferred_dequeue() == 0);
+
+    mbed_trace_deferred_enable(0);
+}
@@ -65,6 +65,16 @@ typedef struct mem_stat_t {
 } mem_stat_t;
 
 
+/**
+ * /struct mem_fragmentation_stat_t
+ * /brief Struct for heap fragmentation stats, filled by walking the heap sector on request
+ */
+typedef struct mem_fragmentation_stat_t {
+    ns_mem_heap_size_t heap_free_bytes;             /**< Free Heap data in bytes. */
+    ns_mem_heap_size_t heap_largest_hole_bytes;     /**< Biggest continuous free data area in bytes. */
+    uint32_t heap_hole_cnt;                         /**< Count of free data areas. */
+} mem_fragmentation_stat_t;
+
 typedef struct ns_mem_book ns_mem_book_t;
 
 /**
@@ -136,6 +146,20 @@ extern const mem_stat_t *ns_dyn_mem_get_mem_stat(void);
   */
 extern int ns_dyn_mem_set_temporary_alloc_free_heap_threshold(uint8_t free_heap_percentage, ns_mem_heap_size_t free_heap_amount);
 
+/**
+  * \brief Read fragmentation and occupancy statistics of the heap.
+  *
+  * Walks the heap sector and fills the given structure with the current free
+  * byte count, the largest continuous free data area and the count of free
+  * areas. Values use the same byte units as mem_stat_t, so both structures
+  * can be reported through the same statistics collection path.
+  *
+  * \param stat Pointer to structure to fill
+  *
+  * \return 0 on success, <0 otherwise
+  */
+extern int ns_dyn_mem_fragmentation_stat_get(mem_fragmentation_stat_t *stat);
+
 /**
   * \brief Init and set Dynamical heap pointer and length.
   *
@@ -210,6 +234,21 @@ extern const mem_stat_t *ns_mem_get_mem_stat(ns_mem_book_t *book);
   */
 extern int ns_mem_set_temporary_alloc_free_heap_threshold(ns_mem_book_t *book, uint8_t free_heap_percentage, ns_mem_heap_size_t free_heap_amount);
 
+/**
+  * \brief Read fragmentation and occupancy statistics of the heap.
+  *
+  * Walks the heap sector and fills the given structure with the current free
+  * byte count, the largest continuous free data area and the count of free
+  * areas. Values use the same byte units as mem_stat_t, so both structures
+  * can be reported through the same statistics collection path.
+  *
+  * \param book Address of book keeping structure
+  * \param stat Pointer to structure to fill
+  *
+  * \return 0 on success, <0 otherwise
+  */
+extern int ns_mem_fragmentation_stat_get(ns_mem_book_t *book, mem_fragmentation_stat_t *stat);
+
 #ifdef __cplusplus
 }
 #endif
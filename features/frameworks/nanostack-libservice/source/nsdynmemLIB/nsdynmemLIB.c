@@ -29,10 +29,16 @@ typedef enum mem_stat_update_t {
 
 typedef struct {
     ns_list_link_t link;
+    ns_list_link_t size_link;
 } hole_t;
 
 typedef int ns_mem_word_size_t; // internal signed heap block size type
 
+/* Largest hole data size in words kept on the exact-fit lists. 16 words is
+ * enough to cover the hot small allocations (packet headers, timers and
+ * event storage), which then recycle a same-sized hole in O(1). */
+#define NS_MEM_FAST_HOLE_MAX_WORDS 16
+
 /* struct for book keeping variables */
 struct ns_mem_book {
     ns_mem_word_size_t     *heap_main;
@@ -40,6 +46,7 @@ struct ns_mem_book {
     mem_stat_t *mem_stat_info_ptr;
     void (*heap_failure_callback)(heap_fail_t);
     NS_LIST_HEAD(hole_t, link) holes_list;
+    NS_LIST_HEAD(hole_t, size_link) fast_hole_lists[NS_MEM_FAST_HOLE_MAX_WORDS + 1]; /* exact-fit hole lists indexed by hole word size */
     ns_mem_heap_size_t heap_size;
     ns_mem_heap_size_t temporary_alloc_heap_limit;   /* Amount of reserved heap temporary alloc can't exceed */
 };
@@ -68,6 +75,26 @@ static void heap_failure(ns_mem_book_t *book, heap_fail_t reason)
     }
 }
 
+/* Every hole on holes_list with data size <= NS_MEM_FAST_HOLE_MAX_WORDS is
+ * also kept on the exact-fit list of its size. Call fast_hole_remove before
+ * a hole descriptor is removed or its size words rewritten, and
+ * fast_hole_add after the final size words are in place. */
+static void fast_hole_add(ns_mem_book_t *book, hole_t *hole)
+{
+    ns_mem_word_size_t size = -*block_start_from_hole(hole);
+    if (size <= NS_MEM_FAST_HOLE_MAX_WORDS) {
+        ns_list_add_to_start(&book->fast_hole_lists[size], hole);
+    }
+}
+
+static void fast_hole_remove(ns_mem_book_t *book, hole_t *hole)
+{
+    ns_mem_word_size_t size = -*block_start_from_hole(hole);
+    if (size <= NS_MEM_FAST_HOLE_MAX_WORDS) {
+        ns_list_remove(&book->fast_hole_lists[size], hole);
+    }
+}
+
 #endif
 
 void ns_dyn_mem_init(void *heap, ns_mem_heap_size_t h_size,
@@ -119,7 +146,11 @@ ns_mem_book_t *ns_mem_init(void *heap, ns_mem_heap_size_t h_size,
     book->heap_main_end = ptr;
 
     ns_list_init(&book->holes_list);
+    for (ns_mem_word_size_t i = 0; i <= NS_MEM_FAST_HOLE_MAX_WORDS; i++) {
+        ns_list_init(&book->fast_hole_lists[i]);
+    }
     ns_list_add_to_start(&book->holes_list, hole_from_block_start(book->heap_main));
+    fast_hole_add(book, hole_from_block_start(book->heap_main));
 
     book->mem_stat_info_ptr = info_ptr;
     //RESET Memory by Hea Len
@@ -264,23 +295,39 @@ static void *ns_mem_internal_alloc(ns_mem_book_t *book, const ns_mem_block_size_
         goto done;
     }
 
-    // ns_list_foreach, either forwards or backwards, result to ptr
-    for (hole_t *cur_hole = direction > 0 ? ns_list_get_first(&book->holes_list)
-                            : ns_list_get_last(&book->holes_list);
-            cur_hole;
-            cur_hole = direction > 0 ? ns_list_get_next(&book->holes_list, cur_hole)
-                       : ns_list_get_previous(&book->holes_list, cur_hole)
-        ) {
-        ns_mem_word_size_t *p = block_start_from_hole(cur_hole);
-        if (ns_mem_block_validate(p) != 0 || *p >= 0) {
-            //Validation failed, or this supposed hole has positive (allocated) size
-            heap_failure(book, NS_DYN_MEM_HEAP_SECTOR_CORRUPTED);
-            break;
-        }
-        if (-*p >= data_size) {
-            // Found a big enough block
+    // Exact-fit fast path: a small request recycles a same-sized hole in O(1)
+    // without splitting, filling the hole completely
+    if (data_size >= HOLE_T_SIZE && data_size <= NS_MEM_FAST_HOLE_MAX_WORDS) {
+        hole_t *exact_hole = ns_list_get_first(&book->fast_hole_lists[data_size]);
+        if (exact_hole) {
+            ns_mem_word_size_t *p = block_start_from_hole(exact_hole);
+            if (ns_mem_block_validate(p) != 0 || *p >= 0) {
+                heap_failure(book, NS_DYN_MEM_HEAP_SECTOR_CORRUPTED);
+                goto done;
+            }
             block_ptr = p;
-            break;
+        }
+    }
+
+    if (!block_ptr) {
+        // ns_list_foreach, either forwards or backwards, result to ptr
+        for (hole_t *cur_hole = direction > 0 ? ns_list_get_first(&book->holes_list)
+                                : ns_list_get_last(&book->holes_list);
+                cur_hole;
+                cur_hole = direction > 0 ? ns_list_get_next(&book->holes_list, cur_hole)
+                           : ns_list_get_previous(&book->holes_list, cur_hole)
+            ) {
+            ns_mem_word_size_t *p = block_start_from_hole(cur_hole);
+            if (ns_mem_block_validate(p) != 0 || *p >= 0) {
+                //Validation failed, or this supposed hole has positive (allocated) size
+                heap_failure(book, NS_DYN_MEM_HEAP_SECTOR_CORRUPTED);
+                break;
+            }
+            if (-*p >= data_size) {
+                // Found a big enough block
+                block_ptr = p;
+                break;
+            }
         }
     }
 
@@ -291,6 +338,8 @@ static void *ns_mem_internal_alloc(ns_mem_book_t *book, const ns_mem_block_size_
     // Separate declaration from initialization to keep IAR happy as the gotos skip this block.
     ns_mem_word_size_t block_data_size;
     block_data_size = -*block_ptr;
+    // Hole descriptor is removed or resized below, drop it from the exact-fit list first
+    fast_hole_remove(book, hole_from_block_start(block_ptr));
     if (block_data_size >= (data_size + 2 + HOLE_T_SIZE)) {
         ns_mem_word_size_t hole_size = block_data_size - data_size - 2;
         ns_mem_word_size_t *hole_ptr;
@@ -316,6 +365,7 @@ static void *ns_mem_internal_alloc(ns_mem_book_t *book, const ns_mem_block_size_
 
         hole_ptr[0] = -hole_size;
         hole_ptr[1 + hole_size] = -hole_size;
+        fast_hole_add(book, hole_from_block_start(hole_ptr));
     } else {
         // Not enough room for a left-over hole, so use the whole block
         data_size = block_data_size;
@@ -397,6 +447,8 @@ static void ns_mem_free_and_merge_with_adjacent_blocks(ns_mem_book_t *book, ns_m
             }
             if (block_size >= 1 + HOLE_T_SIZE + 1) {
                 existing_start = hole_from_block_start(start);
+                // Size words are rewritten below when blocks are merged
+                fast_hole_remove(book, existing_start);
             }
         }
     }
@@ -424,6 +476,7 @@ static void ns_mem_free_and_merge_with_adjacent_blocks(ns_mem_book_t *book, ns_m
         // (Can't use ns_list_replace, because of danger of overlap)
         // Optimisation - note our position for insertion below.
         before = ns_list_get_next(&book->holes_list, existing_end);
+        fast_hole_remove(book, existing_end);
         ns_list_remove(&book->holes_list, existing_end);
     }
     if (existing_start) {
@@ -454,6 +507,10 @@ static void ns_mem_free_and_merge_with_adjacent_blocks(ns_mem_book_t *book, ns_m
     }
     *start = -merged_data_size;
     *end = -merged_data_size;
+    if (existing_start || merged_data_size >= HOLE_T_SIZE) {
+        // Merged hole has a descriptor on holes_list, keep the exact-fit index in sync
+        fast_hole_add(book, to_add);
+    }
 }
 #endif
 
@@ -501,3 +558,46 @@ void ns_dyn_mem_free(void *block)
 {
     ns_mem_free(default_book, block);
 }
+
+int ns_mem_fragmentation_stat_get(ns_mem_book_t *book, mem_fragmentation_stat_t *stat)
+{
+#ifndef STANDARD_MALLOC
+    if (!book || !stat) {
+        return -1;
+    }
+    memset(stat, 0, sizeof(mem_fragmentation_stat_t));
+    platform_enter_critical();
+    // Walk the whole heap sector block by block - unlike holes_list this also
+    // sees the small holes which are too small to carry a hole descriptor
+    ns_mem_word_size_t *ptr = book->heap_main;
+    while (ptr < book->heap_main_end) {
+        ns_mem_word_size_t size = *ptr;
+        if (ns_mem_block_validate(ptr) != 0) {
+            heap_failure(book, NS_DYN_MEM_HEAP_SECTOR_CORRUPTED);
+            platform_exit_critical();
+            return -2;
+        }
+        if (size < 0) {
+            size = -size;
+            ns_mem_heap_size_t hole_bytes = (ns_mem_heap_size_t) size * sizeof(ns_mem_word_size_t);
+            stat->heap_free_bytes += hole_bytes;
+            stat->heap_hole_cnt++;
+            if (hole_bytes > stat->heap_largest_hole_bytes) {
+                stat->heap_largest_hole_bytes = hole_bytes;
+            }
+        }
+        ptr += 1 + size + 1;
+    }
+    platform_exit_critical();
+    return 0;
+#else
+    (void) book;
+    (void) stat;
+    return -3;
+#endif
+}
+
+int ns_dyn_mem_fragmentation_stat_get(mem_fragmentation_stat_t *stat)
+{
+    return ns_mem_fragmentation_stat_get(default_book, stat);
+}
@@ -0,0 +1,97 @@
+/****************************************************************************
+ * Copyright (c) 2019, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ****************************************************************************
+ */
+
+#include "utest/utest_measured_case.h"
+#include "greentea-client/test_env.h"
+
+#ifdef __MBED__
+#include "cmsis.h"
+#endif
+
+#if defined(__MBED__) && defined(DWT_CTRL_CYCCNTENA_Msk)
+
+uint32_t utest::v1::measured_case_clock_read()
+{
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    return DWT->CYCCNT;
+}
+
+bool utest::v1::measured_case_clock_is_cycle_accurate()
+{
+    return true;
+}
+
+#else
+
+#if defined(__MBED__) && DEVICE_USTICKER
+#include "hal/ticker_api.h"
+#include "hal/us_ticker_api.h"
+#endif
+
+uint32_t utest::v1::measured_case_clock_read()
+{
+#if defined(__MBED__) && DEVICE_USTICKER
+    return ticker_read(get_us_ticker_data());
+#else
+    return 0;
+#endif
+}
+
+bool utest::v1::measured_case_clock_is_cycle_accurate()
+{
+    return false;
+}
+
+#endif
+
+static uint32_t sample_median(uint32_t *samples, size_t count)
+{
+    // insertion sort; sample counts are small
+    for (size_t i = 1; i < count; i++) {
+        uint32_t sample = samples[i];
+        size_t j = i;
+        for (; j > 0 && samples[j - 1] > sample; j--) {
+            samples[j] = samples[j - 1];
+        }
+        samples[j] = sample;
+    }
+
+    return samples[(count - 1) / 2];
+}
+
+void utest::v1::measured_case_emit_samples(const char *description, uint32_t *samples, size_t count)
+{
+    static bool unit_sent = false;
+
+    if (count == 0) {
+        return;
+    }
+
+    if (!unit_sent) {
+        greentea_send_kv("measured_case_unit", measured_case_clock_is_cycle_accurate() ? "cycles" : "us");
+        unit_sent = true;
+    }
+
+    uint32_t median = sample_median(samples, count);
+    // samples are sorted now; the minimum is the first one
+    greentea_send_kv("measured_case", description, samples[0], median);
+}
@@ -26,6 +26,7 @@
 #include "utest/utest_case.h"
 #include "utest/utest_default_handlers.h"
 #include "utest/utest_harness.h"
+#include "utest/utest_measured_case.h"
 #include "utest/utest_serial.h"
 
 #endif // UTEST_H
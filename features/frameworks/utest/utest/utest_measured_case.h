@@ -0,0 +1,138 @@
+/****************************************************************************
+ * Copyright (c) 2019, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ****************************************************************************
+ */
+
+#ifndef UTEST_MEASURED_CASE_H
+#define UTEST_MEASURED_CASE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "utest/utest_types.h"
+#include "utest/utest_case.h"
+#include "utest/utest_default_handlers.h"
+
+#ifndef MBED_CONF_UTEST_MEASURED_CASE_REPETITIONS
+#define MBED_CONF_UTEST_MEASURED_CASE_REPETITIONS 16
+#endif
+
+namespace utest {
+/** \addtogroup frameworks */
+/** @{*/
+namespace v1 {
+
+    /**
+     * Read the measurement clock used by MeasuredCase.
+     *
+     * On cores with a DWT cycle counter the reading is in CPU cycles;
+     * otherwise it falls back to the microsecond ticker. The counter is
+     * started on first use.
+     *
+     * @return the current clock reading.
+     */
+    uint32_t measured_case_clock_read();
+
+    /**
+     * @return `true` if measured_case_clock_read() returns CPU cycles,
+     * `false` if it returns microseconds.
+     */
+    bool measured_case_clock_is_cycle_accurate();
+
+    /**
+     * Compute min and median of the samples taken by a measured case and
+     * emit them through the greentea key-value protocol as
+     * \verbatim {{measured_case;<description>;<min>;<median>}} \endverbatim
+     * preceded by a one-time
+     * \verbatim {{measured_case_unit;cycles|us}} \endverbatim
+     * message. The sample array is sorted in place; for an even number of
+     * samples the lower middle sample is reported as the median.
+     *
+     * @param description textual description of the measured case.
+     * @param samples the samples taken, one per repetition.
+     * @param count the number of samples.
+     */
+    void measured_case_emit_samples(const char *description, uint32_t *samples, size_t count);
+
+    /** Measured test case.
+     *
+     * Runs the case body `repetitions` times with the measurement clock
+     * captured immediately around each run, then reports the minimum and
+     * median readings to the host through greentea_send_kv. Minimum and
+     * median are reported rather than the mean because interrupt and
+     * scheduler noise only ever lengthens a run. Host-side timestamps are
+     * far too coarse for microbenchmarks; the readings here are taken on
+     * the target within a couple of instructions of the body.
+     *
+     * The body is a template parameter so each measured case gets its own
+     * handler and sample storage while the object itself remains layout
+     * compatible with Case and can be placed in a Case array:
+     *
+     * @code
+     * void queue_post_body() {
+     *     queue.call(do_nothing);
+     * }
+     *
+     * Case cases[] = {
+     *     MeasuredCase<queue_post_body>("queue post latency"),
+     * };
+     * @endcode
+     *
+     * @note The case fails like any other case if the body raises a
+     * failure; results are only emitted after the last repetition.
+     */
+    template <void (*body)(), size_t repetitions = MBED_CONF_UTEST_MEASURED_CASE_REPETITIONS>
+    class MeasuredCase : public Case
+    {
+    public:
+        MeasuredCase(const char *description,
+                     const case_failure_handler_t failure_handler = default_handler) :
+            Case(description, run, failure_handler)
+        {
+            _description = description;
+        }
+
+    private:
+        static control_t run(const size_t call_count)
+        {
+            uint32_t start = measured_case_clock_read();
+            body();
+            uint32_t stop = measured_case_clock_read();
+
+            _samples[call_count - 1] = stop - start;
+            if (call_count < repetitions) {
+                return CaseRepeatHandler;
+            }
+
+            measured_case_emit_samples(_description, _samples, repetitions);
+            return CaseNext;
+        }
+
+        static const char *_description;
+        static uint32_t _samples[repetitions];
+    };
+
+    template <void (*body)(), size_t repetitions>
+    const char *MeasuredCase<body, repetitions>::_description;
+
+    template <void (*body)(), size_t repetitions>
+    uint32_t MeasuredCase<body, repetitions>::_samples[repetitions];
+
+}   // namespace v1
+}   // namespace utest
+
+#endif // UTEST_MEASURED_CASE_H
+
+/** @}*/
@@ -481,6 +481,23 @@ public:
      */
     virtual lorawan_status_t get_backoff_metadata(int &backoff) = 0;
 
+    /** Get hold of the next TX opportunity
+     *
+     * Returns the time until the duty cycle permits the next uplink, whether
+     * or not a transmission is pending. Unlike get_backoff_metadata(), which
+     * is only valid while a deferred transmission sits in the TX pipe, this
+     * API can be polled at any time, e.g., to schedule sensor sampling right
+     * before the next transmit opportunity.
+     *
+     * @param wait_time     Time in milliseconds until the next uplink may be
+     *                      sent, 0 if an uplink is possible right away.
+     *
+     * @return              LORAWAN_STATUS_OK if the wait time is available,
+     *                      otherwise other negative error code if request failed:
+     *                      LORAWAN_STATUS_NOT_INITIALIZED if system is not initialized with initialize()
+     */
+    virtual lorawan_status_t get_next_tx_opportunity(int &wait_time) = 0;
+
     /** Cancel outgoing transmission
      *
      * This API is used to cancel any outstanding transmission in the TX pipe.
@@ -158,6 +158,12 @@ lorawan_status_t LoRaWANInterface::get_backoff_metadata(int &backoff)
     return _lw_stack.acquire_backoff_metadata(backoff);
 }
 
+lorawan_status_t LoRaWANInterface::get_next_tx_opportunity(int &wait_time)
+{
+    Lock lock(*this);
+    return _lw_stack.acquire_next_tx_opportunity(wait_time);
+}
+
 int16_t LoRaWANInterface::receive(uint8_t port, uint8_t *data, uint16_t length, int flags)
 {
     Lock lock(*this);
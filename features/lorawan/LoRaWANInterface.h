@@ -73,6 +73,7 @@ public:
     virtual lorawan_status_t get_tx_metadata(lorawan_tx_metadata &metadata);
     virtual lorawan_status_t get_rx_metadata(lorawan_rx_metadata &metadata);
     virtual lorawan_status_t get_backoff_metadata(int &backoff);
+    virtual lorawan_status_t get_next_tx_opportunity(int &wait_time);
     virtual lorawan_status_t cancel_sending(void);
     virtual lorawan_status_t get_session(loramac_protocol_params *params);
     virtual lorawan_status_t set_session(loramac_protocol_params *params);
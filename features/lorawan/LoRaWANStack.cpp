@@ -39,6 +39,15 @@ SPDX-License-Identifier: BSD-3-Clause
 /**
  * Control flags for transient states
  */
+#if MBED_CONF_LORA_DEDICATED_EVENT_QUEUE
+/**
+ * Storage pre-allocated for the dedicated MAC event queue and the stack of
+ * the thread dispatching it
+ */
+#define MAC_QUEUE_SIZE              (MBED_CONF_LORA_DEDICATED_EVENT_QUEUE_SIZE * EVENTS_EVENT_SIZE)
+#define MAC_THREAD_STACK_SIZE       2048
+#endif
+
 #define IDLE_FLAG                   0x00000000
 #define RETRY_EXHAUSTED_FLAG        0x00000001
 #define MSG_RECVD_FLAG              0x00000002
@@ -75,6 +84,10 @@ LoRaWANStack::LoRaWANStack()
       _automatic_uplink_ongoing(false),
       _ready_for_rx(true),
       _queue(NULL)
+#if MBED_CONF_LORA_DEDICATED_EVENT_QUEUE
+      , _mac_event_queue(MAC_QUEUE_SIZE)
+      , _mac_thread(osPriorityHigh, MAC_THREAD_STACK_SIZE, NULL, "lora_mac")
+#endif
 {
     _tx_metadata.stale = true;
     _rx_metadata.stale = true;
@@ -116,9 +129,30 @@ lorawan_status_t LoRaWANStack::initialize_mac_layer(EventQueue *queue)
     tr_debug("Initializing MAC layer");
     _queue = queue;
 
+#if MBED_CONF_LORA_DEDICATED_EVENT_QUEUE
+    if (DEVICE_STATE_NOT_INITIALIZED == _device_current_state) {
+        const osStatus status = _mac_thread.start(
+                                    mbed::callback(&_mac_event_queue,
+                                                   &events::EventQueue::dispatch_forever));
+        if (status != osOK) {
+            tr_error("Failed to start dedicated MAC event thread");
+            return LORAWAN_STATUS_SERVICE_UNKNOWN;
+        }
+    }
+#endif
+
     return state_controller(DEVICE_STATE_IDLE);
 }
 
+events::EventQueue *LoRaWANStack::mac_queue(void)
+{
+#if MBED_CONF_LORA_DEDICATED_EVENT_QUEUE
+    return &_mac_event_queue;
+#else
+    return _queue;
+#endif
+}
+
 lorawan_status_t LoRaWANStack::set_lora_callbacks(const lorawan_app_callbacks_t *callbacks)
 {
     if (DEVICE_STATE_NOT_INITIALIZED == _device_current_state) {
@@ -497,7 +531,7 @@ lorawan_status_t LoRaWANStack::acquire_backoff_metadata(int &backoff)
     int id = _loramac.get_backoff_timer_event_id();
 
     if (_loramac.get_backoff_timer_event_id() > 0) {
-        backoff = _queue->time_left(id);
+        backoff = mac_queue()->time_left(id);
         return LORAWAN_STATUS_OK;
     }
 
@@ -505,13 +539,23 @@ lorawan_status_t LoRaWANStack::acquire_backoff_metadata(int &backoff)
     return LORAWAN_STATUS_METADATA_NOT_AVAILABLE;
 }
 
+lorawan_status_t LoRaWANStack::acquire_next_tx_opportunity(int &wait_time)
+{
+    if (DEVICE_STATE_NOT_INITIALIZED == _device_current_state) {
+        return LORAWAN_STATUS_NOT_INITIALIZED;
+    }
+
+    wait_time = _loramac.get_next_tx_opportunity();
+    return LORAWAN_STATUS_OK;
+}
+
 /*****************************************************************************
  * Interrupt handlers                                                        *
  ****************************************************************************/
 void LoRaWANStack::tx_interrupt_handler(void)
 {
     _tx_timestamp = _loramac.get_current_time();
-    const int ret = _queue->call(this, &LoRaWANStack::process_transmission);
+    const int ret = mac_queue()->call(this, &LoRaWANStack::process_transmission);
     MBED_ASSERT(ret != 0);
     (void)ret;
 }
@@ -527,31 +571,31 @@ void LoRaWANStack::rx_interrupt_handler(const uint8_t *payload, uint16_t size,
     memcpy(_rx_payload, payload, size);
 
     const uint8_t *ptr = _rx_payload;
-    const int ret = _queue->call(this, &LoRaWANStack::process_reception,
-                                 ptr, size, rssi, snr);
+    const int ret = mac_queue()->call(this, &LoRaWANStack::process_reception,
+                                      ptr, size, rssi, snr);
     MBED_ASSERT(ret != 0);
     (void)ret;
 }
 
 void LoRaWANStack::rx_error_interrupt_handler(void)
 {
-    const int ret = _queue->call(this, &LoRaWANStack::process_reception_timeout,
-                                 false);
+    const int ret = mac_queue()->call(this, &LoRaWANStack::process_reception_timeout,
+                                      false);
     MBED_ASSERT(ret != 0);
     (void)ret;
 }
 
 void LoRaWANStack::tx_timeout_interrupt_handler(void)
 {
-    const int ret = _queue->call(this, &LoRaWANStack::process_transmission_timeout);
+    const int ret = mac_queue()->call(this, &LoRaWANStack::process_transmission_timeout);
     MBED_ASSERT(ret != 0);
     (void)ret;
 }
 
 void LoRaWANStack::rx_timeout_interrupt_handler(void)
 {
-    const int ret = _queue->call(this, &LoRaWANStack::process_reception_timeout,
-                                 true);
+    const int ret = mac_queue()->call(this, &LoRaWANStack::process_reception_timeout,
+                                      true);
     MBED_ASSERT(ret != 0);
     (void)ret;
 }
@@ -631,8 +675,8 @@ void LoRaWANStack::post_process_tx_with_reception()
         if (QOS_level > LORAWAN_DEFAULT_QOS && _qos_cnt < QOS_level
                 && (prev_QOS_level == QOS_level)) {
             _ctrl_flags &= ~TX_DONE_FLAG;
-            const int ret = _queue->call(this, &LoRaWANStack::state_controller,
-                                         DEVICE_STATE_SCHEDULING);
+            const int ret = mac_queue()->call(this, &LoRaWANStack::state_controller,
+                                              DEVICE_STATE_SCHEDULING);
             MBED_ASSERT(ret != 0);
             (void) ret;
             _qos_cnt++;
@@ -667,8 +711,8 @@ void LoRaWANStack::post_process_tx_no_reception()
 
         if (QOS_level > LORAWAN_DEFAULT_QOS && (prev_QOS_level == QOS_level)) {
             if (_qos_cnt < QOS_level) {
-                const int ret = _queue->call(this, &LoRaWANStack::state_controller,
-                                             DEVICE_STATE_SCHEDULING);
+                const int ret = mac_queue()->call(this, &LoRaWANStack::state_controller,
+                                                  DEVICE_STATE_SCHEDULING);
                 MBED_ASSERT(ret != 0);
                 (void)ret;
                 _qos_cnt++;
@@ -926,7 +970,7 @@ void LoRaWANStack::mlme_indication_handler()
         _automatic_uplink_ongoing = true;
         tr_debug("mlme indication: sending empty uplink to port 0 to acknowledge MAC commands...");
         const uint8_t port = 0;
-        const int ret = _queue->call(this, &LoRaWANStack::send_automatic_uplink_message, port);
+        const int ret = mac_queue()->call(this, &LoRaWANStack::send_automatic_uplink_message, port);
         MBED_ASSERT(ret != 0);
         (void)ret;
 #else
@@ -1067,7 +1111,7 @@ void LoRaWANStack::mcps_indication_handler()
         if (!_automatic_uplink_ongoing) {
             tr_debug("Sending empty uplink message...");
             _automatic_uplink_ongoing = true;
-            const int ret = _queue->call(this, &LoRaWANStack::send_automatic_uplink_message, mcps_indication->port);
+            const int ret = mac_queue()->call(this, &LoRaWANStack::send_automatic_uplink_message, mcps_indication->port);
             MBED_ASSERT(ret != 0);
             (void)ret;
         }
@@ -1256,8 +1300,8 @@ void LoRaWANStack::process_idle_state(lorawan_status_t &op_status)
 
 void LoRaWANStack::process_uninitialized_state(lorawan_status_t &op_status)
 {
-    op_status = _loramac.initialize(_queue, mbed::callback(this,
-                                                           &LoRaWANStack::handle_scheduling_failure));
+    op_status = _loramac.initialize(mac_queue(), mbed::callback(this,
+                                                                &LoRaWANStack::handle_scheduling_failure));
 
     if (op_status == LORAWAN_STATUS_OK) {
         _device_current_state = DEVICE_STATE_IDLE;
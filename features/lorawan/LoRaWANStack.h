@@ -42,6 +42,9 @@
 
 #include <stdint.h>
 #include "events/EventQueue.h"
+#if MBED_CONF_LORA_DEDICATED_EVENT_QUEUE
+#include "rtos/Thread.h"
+#endif
 #include "platform/Callback.h"
 #include "platform/NonCopyable.h"
 #include "platform/ScopedLock.h"
@@ -370,6 +373,21 @@ public:
      */
     lorawan_status_t acquire_backoff_metadata(int &backoff);
 
+    /** Acquire next TX opportunity
+     *
+     * Get hold of the time until the duty cycle permits the next uplink,
+     * whether or not a transmission is pending. Applications can use it to
+     * schedule sampling against the next transmit opportunity.
+     *
+     * @param    wait_time   A reference to the inbound integer which will be
+     *                       filled with the wait time in milliseconds,
+     *                       0 if an uplink is possible right away.
+     *
+     * @return               LORAWAN_STATUS_OK if successful,
+     *                       LORAWAN_STATUS_NOT_INITIALIZED otherwise
+     */
+    lorawan_status_t acquire_next_tx_opportunity(int &wait_time);
+
     /** Stops sending
      *
      * Stop sending any outstanding messages if they are not yet queued for
@@ -497,6 +515,15 @@ private:
     void post_process_tx_with_reception(void);
     void post_process_tx_no_reception(void);
 
+    /** Queue used for time-critical MAC and radio events.
+     *
+     * Returns the dedicated MAC event queue when
+     * MBED_CONF_LORA_DEDICATED_EVENT_QUEUE is set and the application
+     * provided queue otherwise. Application callbacks are always dispatched
+     * from the application provided queue.
+     */
+    events::EventQueue *mac_queue(void);
+
 private:
     LoRaMac _loramac;
     radio_events_t radio_events;
@@ -516,6 +543,10 @@ private:
     volatile bool _ready_for_rx;
     uint8_t _rx_payload[LORAMAC_PHY_MAXPAYLOAD];
     events::EventQueue *_queue;
+#if MBED_CONF_LORA_DEDICATED_EVENT_QUEUE
+    events::EventQueue _mac_event_queue;
+    rtos::Thread _mac_thread;
+#endif
     lorawan_time_t _tx_timestamp;
 };
 
@@ -1065,6 +1065,20 @@ int LoRaMac::get_backoff_timer_event_id(void)
     return _params.timers.backoff_timer.timer_id;
 }
 
+lorawan_time_t LoRaMac::get_next_tx_opportunity(void)
+{
+    lorawan_time_t band_delay = _lora_phy->get_next_tx_availability(_is_nwk_joined,
+                                                                    _params.is_dutycycle_on);
+    lorawan_time_t aggregated_delay = 0;
+    lorawan_time_t elapsed = _lora_time.get_elapsed_time(_params.timers.aggregated_last_tx_time);
+
+    if (_params.timers.aggregated_timeoff > elapsed) {
+        aggregated_delay = _params.timers.aggregated_timeoff - elapsed;
+    }
+
+    return MAX(band_delay, aggregated_delay);
+}
+
 lorawan_status_t LoRaMac::clear_tx_pipe(void)
 {
     if (!_can_cancel_tx) {
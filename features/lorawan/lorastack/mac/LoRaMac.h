@@ -389,6 +389,13 @@ public:
      */
     int get_backoff_timer_event_id(void);
 
+    /**
+     * Returns the time in milliseconds until the duty cycle permits the next
+     * uplink, 0 if an uplink is possible right away. Pure query, nothing is
+     * scheduled and no MAC state is changed.
+     */
+    lorawan_time_t get_next_tx_opportunity(void);
+
     /**
      * Clears out the TX pipe by discarding any outgoing message if the backoff
      * timer is still running.
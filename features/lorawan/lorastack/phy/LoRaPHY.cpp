@@ -41,6 +41,7 @@ LoRaPHY::LoRaPHY()
       _lora_time(NULL)
 {
     memset(&phy_params, 0, sizeof(phy_params));
+    memset(dr_eligible_mask, 0, sizeof(dr_eligible_mask));
 }
 
 LoRaPHY::~LoRaPHY()
@@ -51,6 +52,26 @@ LoRaPHY::~LoRaPHY()
 void LoRaPHY::initialize(LoRaWANTimeHandler *lora_time)
 {
     _lora_time = lora_time;
+
+    // The regional channel list has been filled in by the subclass
+    // constructor at this point, so the per-datarate plan can be indexed once
+    // here instead of being rederived on every TX attempt
+    build_dr_channel_plan();
+}
+
+void LoRaPHY::build_dr_channel_plan()
+{
+    memset(dr_eligible_mask, 0, sizeof(dr_eligible_mask));
+
+    for (uint8_t i = 0; i < phy_params.max_channel_cnt; i++) {
+        dr_range_t dr_range = phy_params.channels.channel_list[i].dr_range;
+
+        for (uint8_t dr = 0; dr < LORA_PHY_PLAN_NB_DATARATES; dr++) {
+            if (val_in_range(dr, dr_range.fields.min, dr_range.fields.max)) {
+                mask_bit_set(dr_eligible_mask[dr], i);
+            }
+        }
+    }
 }
 
 bool LoRaPHY::mask_bit_test(const uint16_t *mask, unsigned bit)
@@ -489,25 +510,32 @@ uint8_t LoRaPHY::enabled_channel_count(uint8_t datarate,
 {
     uint8_t count = 0;
     uint8_t delay_transmission = 0;
+    band_t *band_table = (band_t *) phy_params.bands.table;
+    const uint16_t *dr_mask = dr_eligible_mask[datarate % LORA_PHY_PLAN_NB_DATARATES];
 
-    for (uint8_t i = 0; i < phy_params.max_channel_cnt; i++) {
-        if (mask_bit_test(channel_mask, i)) {
+    for (uint8_t i = 0; i < phy_params.max_channel_cnt; i += 16) {
+        // Fold the precomputed datarate plan into the active mask: blocks of
+        // 16 channels drop out with a single AND instead of re-validating
+        // every channel's datarate range against the regional tables
+        uint16_t eligible = channel_mask[i / 16] & dr_mask[i / 16];
 
-            if (val_in_range(datarate, phy_params.channels.channel_list[i].dr_range.fields.min,
-                             phy_params.channels.channel_list[i].dr_range.fields.max) == 0) {
-                // data rate range invalid for this channel
+        if (eligible == 0) {
+            continue;
+        }
+
+        for (uint8_t j = 0; j < 16 && (i + j) < phy_params.max_channel_cnt; j++) {
+            if ((eligible & (1U << j)) == 0) {
                 continue;
             }
 
-            band_t *band_table = (band_t *) phy_params.bands.table;
-            if (band_table[phy_params.channels.channel_list[i].band].off_time > 0) {
+            if (band_table[phy_params.channels.channel_list[i + j].band].off_time > 0) {
                 // Check if the band is available for transmission
                 delay_transmission++;
                 continue;
             }
 
             // otherwise count the channel as enabled
-            channel_indices[count++] = i;
+            channel_indices[count++] = i + j;
         }
     }
 
@@ -1242,6 +1270,36 @@ void LoRaPHY::calculate_backoff(bool joined, bool last_tx_was_join_req, bool dc_
     }
 }
 
+lorawan_time_t LoRaPHY::get_next_tx_availability(bool joined, bool dc_enabled)
+{
+    band_t *band_table = (band_t *) phy_params.bands.table;
+    lorawan_time_t next_free = (lorawan_time_t)(-1);
+
+    if (!dc_enabled) {
+        return 0;
+    }
+
+    for (uint8_t i = 0; i < phy_params.bands.size; i++) {
+        lorawan_time_t elapsed;
+
+        if (MBED_CONF_LORA_DUTY_CYCLE_ON_JOIN && joined == false) {
+            elapsed = MAX(_lora_time->get_elapsed_time(band_table[i].last_join_tx_time),
+                          _lora_time->get_elapsed_time(band_table[i].last_tx_time));
+        } else {
+            elapsed = _lora_time->get_elapsed_time(band_table[i].last_tx_time);
+        }
+
+        if (band_table[i].off_time <= elapsed) {
+            // this band may transmit right away
+            return 0;
+        }
+
+        next_free = MIN(band_table[i].off_time - elapsed, next_free);
+    }
+
+    return next_free;
+}
+
 lorawan_status_t LoRaPHY::set_next_channel(channel_selection_params_t *params,
                                            uint8_t *channel, lorawan_time_t *time,
                                            lorawan_time_t *aggregate_timeoff)
@@ -1387,6 +1445,8 @@ lorawan_status_t LoRaPHY::add_channel(const channel_params_t *new_channel,
 
     mask_bit_set(phy_params.channels.mask, id);
 
+    build_dr_channel_plan();
+
     return LORAWAN_STATUS_OK;
 }
 
@@ -1403,6 +1463,8 @@ bool LoRaPHY::remove_channel(uint8_t channel_id)
     const channel_params_t empty_channel = { 0, 0, {0}, 0 };
     phy_params.channels.channel_list[channel_id] = empty_channel;
 
+    build_dr_channel_plan();
+
     return disable_channel(phy_params.channels.mask, channel_id,
                            phy_params.max_channel_cnt);
 }
@@ -40,6 +40,14 @@
 #include "LoRaRadio.h"
 #include "lora_phy_ds.h"
 
+/*!
+ * Dimensions of the precomputed per-datarate channel plan. Sized for the
+ * largest supported region (CN470, 96 channels); datarate indices are 4-bit
+ * fields in the LoRaWAN specification.
+ */
+#define LORA_PHY_PLAN_MASK_SIZE                     6
+#define LORA_PHY_PLAN_NB_DATARATES                  16
+
 class LoRaPHY : private mbed::NonCopyable<LoRaPHY> {
 
 public:
@@ -121,6 +129,22 @@ public:
     void calculate_backoff(bool joined, bool last_tx_was_join_req, bool dc_enabled, uint8_t channel,
                            lorawan_time_t elapsed_time, lorawan_time_t tx_toa);
 
+    /**
+     * @brief get_next_tx_availability Computes how long the duty cycle keeps
+     *                                 every band closed for transmission.
+     *
+     * Pure query - unlike update_band_timeoff(), the band bookkeeping is
+     * left untouched, so applications may poll it to schedule work against
+     * the next transmit opportunity.
+     *
+     * @param joined       Set to true, if the node has already joined a network, otherwise false.
+     * @param dc_enabled   Set to true, if the duty cycle is enabled, otherwise false.
+     *
+     * @return Time in milliseconds until some band may transmit again,
+     *         0 if a transmission is possible right away.
+     */
+    lorawan_time_t get_next_tx_availability(bool joined, bool dc_enabled);
+
     /**
       * Tests if a channel is on or off in the channel mask
       */
@@ -649,6 +673,13 @@ protected:
                                   const uint16_t *mask, uint8_t *enabledChannels,
                                   uint8_t *delayTx);
 
+    /**
+     * Precomputes one channel mask per datarate from the regional channel
+     * list, so that per-TX channel selection is reduced to table lookups.
+     * Called at initialization and whenever the channel list changes.
+     */
+    void build_dr_channel_plan();
+
     bool is_datarate_supported(const int8_t datarate) const;
 
 private:
@@ -667,6 +698,12 @@ protected:
     LoRaRadio *_radio;
     LoRaWANTimeHandler *_lora_time;
     loraphy_params_t phy_params;
+
+    /**
+     * Per-datarate channel plan: bit i of dr_eligible_mask[dr] is set when
+     * channel i's datarate range admits dr.
+     */
+    uint16_t dr_eligible_mask[LORA_PHY_PLAN_NB_DATARATES][LORA_PHY_PLAN_MASK_SIZE];
 };
 
 #endif /* MBED_OS_LORAPHY_BASE_ */
@@ -29,6 +29,8 @@
 #include "lwip/inet.h"
 #include "lwip/netif.h"
 #include "lwip/dhcp.h"
+#include "lwip/prot/dhcp.h"
+#include "lwip/etharp.h"
 #include "lwip/tcpip.h"
 #include "lwip/tcp.h"
 #include "lwip/ip.h"
@@ -316,6 +318,203 @@ char *LWIP::Interface::get_gateway(char *buf, nsapi_size_t buflen)
 #endif
 }
 
+#if LWIP_IPV4
+
+#define IF_SNAPSHOT_MAGIC   0x4C57534EUL /* "LWSN" */
+#define IF_SNAPSHOT_VERSION 1
+
+/* Serialized interface state - lives in retained RAM or a kvstore while
+ * the system deep sleeps. All addresses are IPv4 in network byte order. */
+struct lwip_if_snapshot {
+    u32_t magic;
+    u8_t version;
+    u8_t dhcp;       /* lease fields below are valid */
+    u8_t arp_count;
+    u8_t hwaddr_len; /* snapshot must match the interface it came from */
+    u8_t hwaddr[NETIF_MAX_HWADDR_LEN];
+    u32_t ip_addr;
+    u32_t netmask;
+    u32_t gateway;
+    /* DHCP lease */
+    u32_t dhcp_server;
+    u32_t lease_t0;     /* lease period (seconds) */
+    u32_t lease_t1;     /* renew time (seconds) */
+    u32_t lease_t2;     /* rebind time (seconds) */
+    u16_t lease_used;   /* coarse-timer ticks already consumed */
+    u16_t unused;
+    /* IPv4 peers resolved in the ARP cache */
+    u32_t arp_peer[ARP_TABLE_SIZE];
+};
+
+/* Coarse-timer tick count for a period in seconds, as dhcp_bind() computes it */
+static u16_t dhcp_coarse_ticks(u32_t secs)
+{
+    u32_t ticks = (secs + DHCP_COARSE_TIMER_SECS / 2) / DHCP_COARSE_TIMER_SECS;
+    if (ticks > 0xffff) {
+        ticks = 0xffff;
+    }
+    if (ticks == 0) {
+        ticks = 1;
+    }
+    return (u16_t)ticks;
+}
+
+#endif /* LWIP_IPV4 */
+
+nsapi_error_t LWIP::Interface::snapshot(void *buf, nsapi_size_t *size)
+{
+#if LWIP_IPV4
+    if (size == NULL) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+    if (buf == NULL || *size < sizeof(struct lwip_if_snapshot)) {
+        *size = sizeof(struct lwip_if_snapshot);
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+    if (ppp) {
+        /* PPP addresses are renegotiated by IPCP on every link establishment */
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+    if (connected != NSAPI_STATUS_GLOBAL_UP && connected != NSAPI_STATUS_LOCAL_UP) {
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+
+    struct lwip_if_snapshot *snap = static_cast<struct lwip_if_snapshot *>(buf);
+    memset(snap, 0, sizeof(*snap));
+    snap->magic = IF_SNAPSHOT_MAGIC;
+    snap->version = IF_SNAPSHOT_VERSION;
+    snap->hwaddr_len = netif.hwaddr_len;
+    memcpy(snap->hwaddr, netif.hwaddr, netif.hwaddr_len);
+
+    const ip4_addr_t *addr = netif_ip4_addr(&netif);
+    if (ip4_addr_isany(addr)) {
+        return NSAPI_ERROR_NO_ADDRESS;
+    }
+    snap->ip_addr = ip4_addr_get_u32(addr);
+    snap->netmask = ip4_addr_get_u32(netif_ip4_netmask(&netif));
+    snap->gateway = ip4_addr_get_u32(netif_ip4_gw(&netif));
+
+#if LWIP_DHCP
+    struct dhcp *dhcp = netif_dhcp_data(&netif);
+    if (dhcp_started && dhcp != NULL && dhcp_supplied_address(&netif)) {
+        snap->dhcp = 1;
+        snap->dhcp_server = ip_addr_get_ip4_u32(&dhcp->server_ip_addr);
+        snap->lease_t0 = dhcp->offered_t0_lease;
+        snap->lease_t1 = dhcp->offered_t1_renew;
+        snap->lease_t2 = dhcp->offered_t2_rebind;
+        snap->lease_used = dhcp->lease_used;
+    }
+#endif
+
+#if LWIP_ARP
+    for (u8_t i = 0; i < ARP_TABLE_SIZE && snap->arp_count < ARP_TABLE_SIZE; i++) {
+        ip4_addr_t *peer;
+        struct netif *peer_netif;
+        struct eth_addr *eth;
+        if (etharp_get_entry(i, &peer, &peer_netif, &eth) && peer_netif == &netif) {
+            snap->arp_peer[snap->arp_count++] = ip4_addr_get_u32(peer);
+        }
+    }
+#endif
+
+    *size = sizeof(struct lwip_if_snapshot);
+    return NSAPI_ERROR_OK;
+#else
+    (void) buf;
+    (void) size;
+    return NSAPI_ERROR_UNSUPPORTED;
+#endif
+}
+
+nsapi_error_t LWIP::Interface::restore(const void *buf, nsapi_size_t size)
+{
+#if LWIP_IPV4
+    if (buf == NULL || size < sizeof(struct lwip_if_snapshot)) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    const struct lwip_if_snapshot *snap = static_cast<const struct lwip_if_snapshot *>(buf);
+    if (snap->magic != IF_SNAPSHOT_MAGIC || snap->version != IF_SNAPSHOT_VERSION) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+    if (ppp) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+    if (snap->hwaddr_len != netif.hwaddr_len ||
+            memcmp(snap->hwaddr, netif.hwaddr, netif.hwaddr_len) != 0) {
+        /* Snapshot came from a different interface */
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    ip4_addr_t ip_addr, netmask_addr, gw_addr;
+    ip4_addr_set_u32(&ip_addr, snap->ip_addr);
+    ip4_addr_set_u32(&netmask_addr, snap->netmask);
+    ip4_addr_set_u32(&gw_addr, snap->gateway);
+
+    if (snap->dhcp) {
+#if LWIP_DHCP
+        if (!dhcp_started) {
+            /* Link not up yet - DHCP has not been started. Retry once it is. */
+            return NSAPI_ERROR_NO_CONNECTION;
+        }
+        struct dhcp *dhcp = netif_dhcp_data(&netif);
+        if (dhcp == NULL) {
+            return NSAPI_ERROR_DEVICE_ERROR;
+        }
+
+        /* Re-seat the saved lease, install its address so traffic can flow
+         * immediately, then confirm with a unicast renewal - one round trip
+         * instead of the full discover/offer/request/ack exchange. A NAK
+         * drops the client back to normal discovery. */
+        ip4_addr_set_u32(&dhcp->offered_ip_addr, snap->ip_addr);
+        ip4_addr_set_u32(&dhcp->offered_sn_mask, snap->netmask);
+        ip4_addr_set_u32(&dhcp->offered_gw_addr, snap->gateway);
+        dhcp->subnet_mask_given = (snap->netmask != 0);
+        ip_addr_set_ip4_u32(&dhcp->server_ip_addr, snap->dhcp_server);
+        dhcp->offered_t0_lease = snap->lease_t0;
+        dhcp->offered_t1_renew = snap->lease_t1;
+        dhcp->offered_t2_rebind = snap->lease_t2;
+        dhcp->lease_used = snap->lease_used;
+        if (snap->lease_t0 != 0xffffffffUL) {
+            dhcp->t0_timeout = dhcp_coarse_ticks(snap->lease_t0);
+        }
+        if (snap->lease_t1 != 0xffffffffUL) {
+            dhcp->t1_timeout = dhcp_coarse_ticks(snap->lease_t1);
+            dhcp->t1_renew_time = dhcp->t1_timeout;
+        }
+        if (snap->lease_t2 != 0xffffffffUL) {
+            dhcp->t2_timeout = dhcp_coarse_ticks(snap->lease_t2);
+            dhcp->t2_rebind_time = dhcp->t2_timeout;
+        }
+        dhcp->state = DHCP_STATE_BOUND;
+
+        netif_set_addr(&netif, &ip_addr, &netmask_addr, &gw_addr);
+        dhcp_renew(&netif);
+#else
+        return NSAPI_ERROR_UNSUPPORTED;
+#endif
+    } else {
+        netif_set_addr(&netif, &ip_addr, &netmask_addr, &gw_addr);
+    }
+
+#if LWIP_ARP
+    /* Pre-warm the ARP cache - resolution runs while the application starts
+     * up, instead of stalling its first packet behind an ARP exchange */
+    for (u8_t i = 0; i < snap->arp_count && i < ARP_TABLE_SIZE; i++) {
+        ip4_addr_t peer;
+        ip4_addr_set_u32(&peer, snap->arp_peer[i]);
+        etharp_request(&netif, &peer);
+    }
+#endif
+
+    return NSAPI_ERROR_OK;
+#else
+    (void) buf;
+    (void) size;
+    return NSAPI_ERROR_UNSUPPORTED;
+#endif
+}
+
 LWIP::Interface::Interface() :
     hw(NULL), has_addr_state(0),
     connected(NSAPI_STATUS_DISCONNECTED),
@@ -144,6 +144,33 @@ err_t LWIP::Interface::emac_if_init(struct netif *netif)
     /* Interface capabilities */
     netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_ETHERNET;
 
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+    /* Disable software checksums for the protocols the hardware covers */
+    static const struct {
+        uint32_t emac_cap;
+        u16_t netif_flag;
+    } csum_map[] = {
+        { EMAC::CSUM_OFFLOAD_GEN_IP,      NETIF_CHECKSUM_GEN_IP },
+        { EMAC::CSUM_OFFLOAD_GEN_UDP,     NETIF_CHECKSUM_GEN_UDP },
+        { EMAC::CSUM_OFFLOAD_GEN_TCP,     NETIF_CHECKSUM_GEN_TCP },
+        { EMAC::CSUM_OFFLOAD_GEN_ICMP,    NETIF_CHECKSUM_GEN_ICMP },
+        { EMAC::CSUM_OFFLOAD_GEN_ICMP6,   NETIF_CHECKSUM_GEN_ICMP6 },
+        { EMAC::CSUM_OFFLOAD_CHECK_IP,    NETIF_CHECKSUM_CHECK_IP },
+        { EMAC::CSUM_OFFLOAD_CHECK_UDP,   NETIF_CHECKSUM_CHECK_UDP },
+        { EMAC::CSUM_OFFLOAD_CHECK_TCP,   NETIF_CHECKSUM_CHECK_TCP },
+        { EMAC::CSUM_OFFLOAD_CHECK_ICMP,  NETIF_CHECKSUM_CHECK_ICMP },
+        { EMAC::CSUM_OFFLOAD_CHECK_ICMP6, NETIF_CHECKSUM_CHECK_ICMP6 }
+    };
+    uint32_t csum_caps = mbed_if->emac->get_checksum_offload();
+    u16_t chksum_ctrl = NETIF_CHECKSUM_ENABLE_ALL;
+    for (unsigned int i = 0; i < sizeof csum_map / sizeof csum_map[0]; i++) {
+        if (csum_caps & csum_map[i].emac_cap) {
+            chksum_ctrl &= ~csum_map[i].netif_flag;
+        }
+    }
+    NETIF_SET_CHECKSUM_CTRL(netif, chksum_ctrl);
+#endif /* LWIP_CHECKSUM_CTRL_PER_NETIF */
+
     if (!mbed_if->emac->power_up()) {
         err = ERR_IF;
     }
@@ -14,8 +14,67 @@
  */
 
 #include "pbuf.h"
+#include "lwip/memp.h"
+#include "lwip/stats.h"
 #include "LWIPMemoryManager.h"
 
+#if MEMP_STATS
+
+mbed::Callback<void(bool)> LWIPMemoryManager::pool_watermark_cb;
+uint32_t LWIPMemoryManager::pool_watermark;
+bool LWIPMemoryManager::pool_low;
+
+uint32_t LWIPMemoryManager::pool_free_count()
+{
+    const struct stats_mem *memp = lwip_stats.memp[MEMP_PBUF_POOL];
+    return memp->avail - memp->used;
+}
+
+void LWIPMemoryManager::check_pool_watermark()
+{
+    if (!pool_watermark_cb) {
+        return;
+    }
+
+    uint32_t free_count = pool_free_count();
+    if (!pool_low && free_count < pool_watermark) {
+        pool_low = true;
+        pool_watermark_cb(true);
+    } else if (pool_low && free_count >= pool_watermark) {
+        pool_low = false;
+        pool_watermark_cb(false);
+    }
+}
+
+#endif /* MEMP_STATS */
+
+bool LWIPMemoryManager::get_pool_stats(pool_stats *stats)
+{
+#if MEMP_STATS
+    const struct stats_mem *memp = lwip_stats.memp[MEMP_PBUF_POOL];
+    stats->avail = memp->avail;
+    stats->used = memp->used;
+    stats->max = memp->max;
+    stats->err = memp->err;
+    return true;
+#else
+    (void) stats;
+    return false;
+#endif
+}
+
+void LWIPMemoryManager::set_pool_watermark(uint32_t free_pbufs, mbed::Callback<void(bool)> cb)
+{
+#if MEMP_STATS
+    pool_watermark = free_pbufs;
+    pool_watermark_cb = cb;
+    pool_low = false;
+#else
+    (void) free_pbufs;
+    (void) cb;
+#endif
+}
+
 emac_mem_buf_t *LWIPMemoryManager::alloc_heap(uint32_t size, uint32_t align)
 {
     struct pbuf *pbuf = pbuf_alloc(PBUF_RAW, size + align, PBUF_RAM);
@@ -32,7 +91,23 @@ emac_mem_buf_t *LWIPMemoryManager::alloc_pool(uint32_t size, uint32_t align)
 {
     uint32_t total_align = count_total_align(size, align);
 
+#if MBED_CONF_LWIP_PBUF_POOL_RESERVE > 0
+    // Leave the configured reserve for allocations made inside the stack
+    // (for example PPP input), so a saturated emac receive path cannot
+    // take the last pool pbufs. Best effort - concurrent allocations from
+    // other contexts may race with the check.
+    uint32_t alloc_unit = get_pool_alloc_unit(align);
+    uint32_t needed = (size + total_align + alloc_unit - 1) / alloc_unit;
+    if (pool_free_count() < needed + MBED_CONF_LWIP_PBUF_POOL_RESERVE) {
+        check_pool_watermark();
+        return NULL;
+    }
+#endif
+
     struct pbuf *pbuf = pbuf_alloc(PBUF_RAW, size + total_align, PBUF_POOL);
+#if MEMP_STATS
+    check_pool_watermark();
+#endif
     if (pbuf == NULL) {
         return NULL;
     }
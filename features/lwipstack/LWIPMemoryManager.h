@@ -17,10 +17,47 @@
 #define LWIP_MEMORY_MANAGER_H
 
 #include "EMACMemoryManager.h"
+#include "platform/Callback.h"
 
 class LWIPMemoryManager : public EMACMemoryManager {
 public:
 
+    /** Pbuf pool occupancy counters
+     *
+     * Filled by get_pool_stats(). Available when lwip.pbuf-pool-stats or
+     * lwip.pbuf-pool-reserve is enabled.
+     */
+    struct pool_stats {
+        uint32_t avail;    /**< Total number of pbufs in the pool */
+        uint32_t used;     /**< Pbufs currently in use */
+        uint32_t max;      /**< Highest in-use count seen */
+        uint32_t err;      /**< Failed pool allocations */
+    };
+
+    /** Read pbuf pool occupancy
+     *
+     * The pool is shared by all interfaces, so the counters describe the
+     * whole system. Useful for tuning lwip.pbuf-pool-size.
+     *
+     * @param stats    Structure to fill with the counters
+     * @return         True if statistics are compiled in, false otherwise
+     */
+    static bool get_pool_stats(pool_stats *stats);
+
+    /** Register a pool low-watermark callback
+     *
+     * The callback is invoked with true when the number of free pool pbufs
+     * falls below the watermark, and with false once a later allocation
+     * check sees it recovered. It is evaluated on the allocation path and
+     * may run in the context of a driver thread, so it must be short and
+     * must not allocate from the pool. Requires the pool counters to be
+     * compiled in; otherwise the call has no effect.
+     *
+     * @param free_pbufs  Number of free pbufs below which the callback fires
+     * @param cb          Callback to invoke on watermark crossings
+     */
+    static void set_pool_watermark(uint32_t free_pbufs, mbed::Callback<void(bool)> cb);
+
     /**
      * Allocates memory buffer from the heap
      *
@@ -162,6 +199,27 @@ public:
 
 private:
 
+    /**
+     * Returns the number of free pbufs in the pool
+     *
+     * Only available when the pool counters are compiled in.
+     *
+     * @return         Free pbuf count
+     */
+    static uint32_t pool_free_count();
+
+    /**
+     * Evaluates the pool watermark after an allocation attempt
+     *
+     * Invokes the registered callback when the free count crosses the
+     * watermark in either direction.
+     */
+    static void check_pool_watermark();
+
+    static mbed::Callback<void(bool)> pool_watermark_cb;
+    static uint32_t pool_watermark;
+    static bool pool_low;
+
     /**
      * Returns a total memory alignment size
      *
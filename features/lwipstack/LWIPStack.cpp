@@ -403,7 +403,11 @@ nsapi_size_or_error_t LWIP::socket_send(nsapi_socket_t handle, const void *data,
     struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
     size_t bytes_written = 0;
 
-    err_t err = netconn_write_partly(s->conn, data, size, NETCONN_COPY, &bytes_written);
+    // While corked, tell lwIP more data follows so small writes are held
+    // back and coalesced into full segments instead of one packet each
+    u8_t flags = NETCONN_COPY | (s->cork ? NETCONN_MORE : 0);
+
+    err_t err = netconn_write_partly(s->conn, data, size, flags, &bytes_written);
     if (err != ERR_OK) {
         return err_remap(err);
     }
@@ -435,6 +439,135 @@ nsapi_size_or_error_t LWIP::socket_recv(nsapi_socket_t handle, void *data, nsapi
     return recv;
 }
 
+nsapi_size_or_error_t LWIP::socket_recv_buffer(nsapi_socket_t handle, nsapi_buffer_t *buffer)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (!s->buf) {
+        err_t err = netconn_recv(s->conn, &s->buf);
+        s->offset = 0;
+
+        if (err != ERR_OK) {
+            return err_remap(err);
+        }
+    }
+
+    // Walk the pbuf chain to the first byte not yet consumed. The pbuf
+    // stays owned by the socket until released, so the view needs no
+    // additional reference
+    struct pbuf *p = s->buf->p;
+    u16_t offset = s->offset;
+    while (p && offset >= p->len) {
+        offset -= p->len;
+        p = p->next;
+    }
+
+    if (!p) {
+        netbuf_delete(s->buf);
+        s->buf = 0;
+        return NSAPI_ERROR_WOULD_BLOCK;
+    }
+
+    buffer->data = (uint8_t *)p->payload + offset;
+    buffer->len = p->len - offset;
+    buffer->buffer = s->buf;
+
+    return buffer->len;
+}
+
+nsapi_error_t LWIP::socket_release_buffer(nsapi_socket_t handle, const nsapi_buffer_t *buffer)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (!s->buf || buffer->buffer != s->buf) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    s->offset += buffer->len;
+    if (s->offset >= netbuf_len(s->buf)) {
+        netbuf_delete(s->buf);
+        s->buf = 0;
+    }
+
+    return 0;
+}
+
+nsapi_error_t LWIP::socket_acquire_tx_buffer(nsapi_socket_t handle, nsapi_size_t size, nsapi_buffer_t *buffer)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (NETCONNTYPE_GROUP(s->conn->type) != NETCONN_UDP) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+    if (size == 0 || size > 0xffff) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    struct netbuf *buf = netbuf_new();
+    if (!buf) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    // Allocate the datagram payload up front - the application fills it
+    // in place, so the commit sends without copying
+    if (!netbuf_alloc(buf, (u16_t)size)) {
+        netbuf_delete(buf);
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    buffer->data = buf->p->payload;
+    buffer->len = size;
+    buffer->buffer = buf;
+
+    return 0;
+}
+
+nsapi_size_or_error_t LWIP::socket_send_tx_buffer(nsapi_socket_t handle, const SocketAddress &address, const nsapi_buffer_t *buffer, nsapi_size_t size)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+    struct netbuf *buf = (struct netbuf *)buffer->buffer;
+    ip_addr_t ip_addr;
+
+    if (!buf) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+    if (size > buffer->len) {
+        netbuf_delete(buf);
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    nsapi_addr_t addr = address.get_addr();
+    if (!convert_mbed_addr_to_lwip(&ip_addr, &addr)) {
+        netbuf_delete(buf);
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    if (size < buffer->len) {
+        // Datagram shorter than the lease - trim the payload in place
+        pbuf_realloc(buf->p, (u16_t)size);
+    }
+
+    err_t err = netconn_sendto(s->conn, buf, &ip_addr, address.get_port());
+    netbuf_delete(buf);
+    if (err != ERR_OK) {
+        return err_remap(err);
+    }
+
+    return size;
+}
+
+nsapi_error_t LWIP::socket_release_tx_buffer(nsapi_socket_t handle, const nsapi_buffer_t *buffer)
+{
+    struct netbuf *buf = (struct netbuf *)buffer->buffer;
+
+    if (!buf) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    netbuf_delete(buf);
+    return 0;
+}
+
 nsapi_size_or_error_t LWIP::socket_sendto(nsapi_socket_t handle, const SocketAddress &address, const void *data, nsapi_size_t size)
 {
     struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
@@ -462,6 +595,79 @@ nsapi_size_or_error_t LWIP::socket_sendto(nsapi_socket_t handle, const SocketAdd
     return size;
 }
 
+nsapi_size_or_error_t LWIP::socket_sendmsg(nsapi_socket_t handle, const SocketAddress &address, const nsapi_iovec_t *iov, int iovcnt)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (iovcnt <= 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+#if LWIP_TCP
+    if (NETCONNTYPE_GROUP(s->conn->type) == NETCONN_TCP) {
+        // Hand each element to lwIP separately, flagging that more data
+        // follows so segments are filled across element boundaries
+        size_t total = 0;
+
+        for (int i = 0; i < iovcnt; i++) {
+            size_t bytes_written = 0;
+            u8_t flags = NETCONN_COPY | ((i < iovcnt - 1 || s->cork) ? NETCONN_MORE : 0);
+
+            err_t err = netconn_write_partly(s->conn, iov[i].iov_base, iov[i].iov_len, flags, &bytes_written);
+            total += bytes_written;
+            if (err != ERR_OK) {
+                return total ? (nsapi_size_or_error_t)total : err_remap(err);
+            }
+            if (bytes_written < iov[i].iov_len) {
+                break;
+            }
+        }
+
+        return (nsapi_size_or_error_t)total;
+    }
+#endif
+
+    ip_addr_t ip_addr;
+
+    nsapi_addr_t addr = address.get_addr();
+    if (!convert_mbed_addr_to_lwip(&ip_addr, &addr)) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    struct netbuf *buf = netbuf_new();
+    if (!buf) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    // Chain the elements into one datagram, referencing the caller's
+    // buffers without copying - netconn_sendto returns only once the
+    // driver is done with them
+    nsapi_size_t size = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, (u16_t)iov[i].iov_len, PBUF_REF);
+        if (!p) {
+            netbuf_delete(buf);
+            return NSAPI_ERROR_NO_MEMORY;
+        }
+        p->payload = (void *)iov[i].iov_base;
+
+        if (!buf->p) {
+            buf->p = buf->ptr = p;
+        } else {
+            pbuf_cat(buf->p, p);
+        }
+        size += iov[i].iov_len;
+    }
+
+    err_t err = netconn_sendto(s->conn, buf, &ip_addr, address.get_port());
+    netbuf_delete(buf);
+    if (err != ERR_OK) {
+        return err_remap(err);
+    }
+
+    return size;
+}
+
 nsapi_size_or_error_t LWIP::socket_recvfrom(nsapi_socket_t handle, SocketAddress *address, void *data, nsapi_size_t size)
 {
     struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
@@ -533,6 +739,32 @@ nsapi_error_t LWIP::setsockopt(nsapi_socket_t handle, int level, int optname, co
 
             s->conn->pcb.tcp->keep_intvl = *(int *)optval;
             return 0;
+
+        case NSAPI_CORK:
+            if (optlen != sizeof(int) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            if (*(int *)optval) {
+                s->cork = true;
+            } else {
+                // Uncork - push out whatever has been held back
+                s->cork = false;
+                tcp_output(s->conn->pcb.tcp);
+            }
+            return 0;
+
+        case NSAPI_RCVWND_AUTOTUNE:
+#if LWIP_TCP_RCVWND_AUTOTUNE
+            if (optlen != sizeof(int) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            tcp_rcvwnd_autotune(s->conn->pcb.tcp, *(int *)optval ? 1 : 0);
+            return 0;
+#else
+            return NSAPI_ERROR_UNSUPPORTED;
+#endif
 #endif
 
         case NSAPI_REUSEADDR:
@@ -110,6 +110,26 @@ public:
          */
         virtual char *get_gateway(char *buf, nsapi_size_t buflen);
 
+        /** Snapshot IPv4 configuration, DHCP lease and ARP peers for retention across deep sleep
+         *
+         * @param         buf   Destination buffer for the snapshot, or NULL to query size
+         * @param[in,out] size  In: size of buf in bytes; out: bytes used or required
+         * @return              NSAPI_ERROR_OK on success, or error code
+         */
+        virtual nsapi_error_t snapshot(void *buf, nsapi_size_t *size);
+
+        /** Restore state captured by snapshot() after waking
+         *
+         * Installs the saved addresses immediately, re-seats the DHCP lease
+         * and confirms it with a unicast renewal, and re-requests the saved
+         * ARP peers so resolution overlaps application start-up.
+         *
+         * @param buf   Buffer previously filled by snapshot()
+         * @param size  Size of the snapshot in bytes
+         * @return      NSAPI_ERROR_OK on success, or error code
+         */
+        virtual nsapi_error_t restore(const void *buf, nsapi_size_t size);
+
     private:
         friend LWIP;
 
@@ -337,6 +357,92 @@ protected:
     virtual nsapi_size_or_error_t socket_recv(nsapi_socket_t handle,
                                               void *data, nsapi_size_t size);
 
+    /** Send a message assembled from several buffers
+     *
+     *  On TCP each element is handed to lwIP separately, flagged so
+     *  segments are filled across element boundaries. On UDP the elements
+     *  are chained into one datagram as PBUF_REF pbufs, referencing the
+     *  caller's buffers without copying.
+     *
+     *  This call is non-blocking. If sendmsg would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  The SocketAddress of the remote host
+     *  @param iov      Array of buffers making up the message
+     *  @param iovcnt   Number of elements in iov
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_sendmsg(nsapi_socket_t handle, const SocketAddress &address,
+                                                 const nsapi_iovec_t *iov, int iovcnt);
+
+    /** Receive data over a socket without copying
+     *
+     *  Fills buffer with a view of one contiguous fragment of the pbuf
+     *  holding the received data. The pbuf stays owned by the socket and
+     *  is freed once all of its fragments have been handed back with
+     *  socket_release_buffer.
+     *
+     *  This call is non-blocking. If recv would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param buffer   Destination for the description of the received fragment
+     *  @return         Length of the fragment on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recv_buffer(nsapi_socket_t handle,
+                                                     nsapi_buffer_t *buffer);
+
+    /** Release a buffer acquired with socket_recv_buffer
+     *
+     *  @param handle   Socket handle
+     *  @param buffer   Fragment previously filled in by socket_recv_buffer
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t socket_release_buffer(nsapi_socket_t handle,
+                                                const nsapi_buffer_t *buffer);
+
+    /** Acquire a transmit buffer from the stack
+     *
+     *  Leases a netbuf with its payload allocated up front: the caller
+     *  fills the payload in place, so committing sends the application's
+     *  bytes without the copy socket_sendto performs.
+     *
+     *  Only supported on UDP sockets.
+     *
+     *  @param handle   Socket handle
+     *  @param size     Requested payload capacity in bytes
+     *  @param buffer   Destination for the description of the leased buffer
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t socket_acquire_tx_buffer(nsapi_socket_t handle, nsapi_size_t size,
+                                                   nsapi_buffer_t *buffer);
+
+    /** Send a buffer acquired with socket_acquire_tx_buffer
+     *
+     *  The lease is consumed whatever the outcome.
+     *
+     *  @param handle   Socket handle
+     *  @param address  The SocketAddress of the remote host
+     *  @param buffer   Buffer previously filled in by socket_acquire_tx_buffer
+     *  @param size     Number of bytes to send, at most the leased capacity
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_send_tx_buffer(nsapi_socket_t handle, const SocketAddress &address,
+                                                        const nsapi_buffer_t *buffer, nsapi_size_t size);
+
+    /** Release an unsent buffer acquired with socket_acquire_tx_buffer
+     *
+     *  @param handle   Socket handle
+     *  @param buffer   Buffer previously filled in by socket_acquire_tx_buffer
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t socket_release_tx_buffer(nsapi_socket_t handle,
+                                                   const nsapi_buffer_t *buffer);
+
     /** Send a packet over a UDP socket
      *
      *  Sends data to the specified address. Returns the number of bytes
@@ -458,6 +564,7 @@ private:
         struct netconn *conn;
         struct netbuf *buf;
         u16_t offset;
+        bool cork;
 
         void (*cb)(void *);
         void *data;
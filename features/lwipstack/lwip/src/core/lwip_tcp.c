@@ -775,6 +775,61 @@ tcp_update_rcv_ann_wnd(struct tcp_pcb *pcb)
   }
 }
 
+#if LWIP_TCP_RCVWND_AUTOTUNE
+/* Window right-shift shared by every auto-tuned pcb, stepped on PBUF_POOL
+   occupancy threshold crossings in tcp_autotune_wnd_max() */
+static u8_t tcp_autotune_shift;
+
+/**
+ * @ingroup tcp_raw
+ * Enable or disable receive window auto-tuning for a pcb. While enabled,
+ * growth of the window advertised to the remote host is capped by live
+ * PBUF_POOL occupancy instead of the fixed TCP_WND, so a lone connection
+ * can use the whole pool while many concurrent ones are throttled before
+ * they exhaust it.
+ *
+ * @param pcb the tcp_pcb to tune
+ * @param enable 1 to scale the window by pool occupancy, 0 for TCP_WND
+ */
+void
+tcp_rcvwnd_autotune(struct tcp_pcb *pcb, u8_t enable)
+{
+  pcb->rcv_wnd_autotune = enable;
+}
+
+/**
+ * Compute the occupancy-scaled receive window cap for an auto-tuned pcb.
+ *
+ * The shift steps up when pool occupancy crosses TCP_RCVWND_AUTOTUNE_HIGH
+ * percent and back down below TCP_RCVWND_AUTOTUNE_LOW percent; the gap
+ * between the thresholds keeps the cap from oscillating around a single
+ * threshold. The cap only limits further window growth - the announced
+ * right edge is never pulled back (tcp_update_rcv_ann_wnd keeps it
+ * constant), so shrinking is always TCP-legal.
+ */
+static tcpwnd_size_t
+tcp_autotune_wnd_max(const struct tcp_pcb *pcb)
+{
+  const struct stats_mem *pool = lwip_stats.memp[MEMP_PBUF_POOL];
+  u32_t used_pct = (u32_t)pool->used * 100 / pool->avail;
+  tcpwnd_size_t wnd;
+
+  if (used_pct >= TCP_RCVWND_AUTOTUNE_HIGH) {
+    if ((TCP_WND_MAX(pcb) >> tcp_autotune_shift) > TCP_RCVWND_AUTOTUNE_MIN) {
+      tcp_autotune_shift++;
+    }
+  } else if (used_pct <= TCP_RCVWND_AUTOTUNE_LOW && tcp_autotune_shift > 0) {
+    tcp_autotune_shift--;
+  }
+
+  wnd = (tcpwnd_size_t)(TCP_WND_MAX(pcb) >> tcp_autotune_shift);
+  if (wnd < TCP_RCVWND_AUTOTUNE_MIN) {
+    wnd = TCP_RCVWND_AUTOTUNE_MIN;
+  }
+  return wnd;
+}
+#endif /* LWIP_TCP_RCVWND_AUTOTUNE */
+
 /**
  * @ingroup tcp_raw
  * This function should be called by the application when it has
@@ -788,14 +843,21 @@ void
 tcp_recved(struct tcp_pcb *pcb, u16_t len)
 {
   int wnd_inflation;
+  tcpwnd_size_t wnd_max = TCP_WND_MAX(pcb);
 
   /* pcb->state LISTEN not allowed here */
   LWIP_ASSERT("don't call tcp_recved for listen-pcbs",
     pcb->state != LISTEN);
 
+#if LWIP_TCP_RCVWND_AUTOTUNE
+  if (pcb->rcv_wnd_autotune) {
+    wnd_max = tcp_autotune_wnd_max(pcb);
+  }
+#endif
+
   pcb->rcv_wnd += len;
-  if (pcb->rcv_wnd > TCP_WND_MAX(pcb)) {
-    pcb->rcv_wnd = TCP_WND_MAX(pcb);
+  if (pcb->rcv_wnd > wnd_max) {
+    pcb->rcv_wnd = wnd_max;
   } else if (pcb->rcv_wnd == 0) {
     /* rcv_wnd overflowed */
     if ((pcb->state == CLOSE_WAIT) || (pcb->state == LAST_ACK)) {
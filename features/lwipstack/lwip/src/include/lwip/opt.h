@@ -1298,6 +1298,43 @@
 #define TCP_WND_UPDATE_THRESHOLD   LWIP_MIN((TCP_WND / 4), (TCP_MSS * 4))
 #endif
 
+/**
+ * LWIP_TCP_RCVWND_AUTOTUNE==1: scale the receive window cap of opted-in
+ * pcbs by PBUF_POOL occupancy instead of fixing it at TCP_WND. When the
+ * pool fills past TCP_RCVWND_AUTOTUNE_HIGH percent the cap is halved a
+ * step at a time, down to TCP_RCVWND_AUTOTUNE_MIN, and grows back once
+ * occupancy drops below TCP_RCVWND_AUTOTUNE_LOW percent. Enabled per pcb
+ * with tcp_rcvwnd_autotune(). Requires MEMP_STATS for the pool counters.
+ */
+#if !defined LWIP_TCP_RCVWND_AUTOTUNE || defined __DOXYGEN__
+#define LWIP_TCP_RCVWND_AUTOTUNE        0
+#endif
+
+/**
+ * TCP_RCVWND_AUTOTUNE_HIGH: PBUF_POOL occupancy percentage above which
+ * auto-tuned receive window caps shrink.
+ */
+#if !defined TCP_RCVWND_AUTOTUNE_HIGH || defined __DOXYGEN__
+#define TCP_RCVWND_AUTOTUNE_HIGH        75
+#endif
+
+/**
+ * TCP_RCVWND_AUTOTUNE_LOW: PBUF_POOL occupancy percentage below which
+ * auto-tuned receive window caps grow back. The gap up to
+ * TCP_RCVWND_AUTOTUNE_HIGH is the hysteresis band.
+ */
+#if !defined TCP_RCVWND_AUTOTUNE_LOW || defined __DOXYGEN__
+#define TCP_RCVWND_AUTOTUNE_LOW         50
+#endif
+
+/**
+ * TCP_RCVWND_AUTOTUNE_MIN: floor of the auto-tuned receive window cap,
+ * so a starved pool still leaves every connection a usable window.
+ */
+#if !defined TCP_RCVWND_AUTOTUNE_MIN || defined __DOXYGEN__
+#define TCP_RCVWND_AUTOTUNE_MIN         (2 * TCP_MSS)
+#endif
+
 /**
  * LWIP_EVENT_API and LWIP_CALLBACK_API: Only one of these should be set to 1.
  *     LWIP_EVENT_API==1: The user defines lwip_tcp_event() to receive all
@@ -238,6 +238,9 @@ struct tcp_pcb {
   tcpwnd_size_t rcv_wnd;   /* receiver window available */
   tcpwnd_size_t rcv_ann_wnd; /* receiver window to announce */
   u32_t rcv_ann_right_edge; /* announced right edge of window */
+#if LWIP_TCP_RCVWND_AUTOTUNE
+  u8_t rcv_wnd_autotune; /* scale the rcv_wnd cap by pbuf pool occupancy */
+#endif
 
   /* Retransmission timer. */
   s16_t rtime;
@@ -389,6 +392,9 @@ void             tcp_backlog_accepted(struct tcp_pcb* pcb);
 #define          tcp_accepted(pcb) /* compatibility define, not needed any more */
 
 void             tcp_recved  (struct tcp_pcb *pcb, u16_t len);
+#if LWIP_TCP_RCVWND_AUTOTUNE
+void             tcp_rcvwnd_autotune(struct tcp_pcb *pcb, u8_t enable);
+#endif
 err_t            tcp_bind    (struct tcp_pcb *pcb, const ip_addr_t *ipaddr,
                               u16_t port);
 err_t            tcp_connect (struct tcp_pcb *pcb, const ip_addr_t *ipaddr,
@@ -91,6 +91,10 @@ struct pppos_pcb_s {
   u16_t in_fcs;                    /* Input Frame Check Sequence value. */
   u8_t in_state;                   /* The input process state. */
   u8_t in_escaped;                 /* Escape next character. */
+
+  /* PPPoS tx byte-stuffing statistics, reset when the session connects */
+  u32_t out_data;                  /* Frame bytes submitted for output. */
+  u32_t out_stuffed;               /* Frame bytes that needed an escape sequence. */
 };
 
 /* Create a new PPPoS session. */
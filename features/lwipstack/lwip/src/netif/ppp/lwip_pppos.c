@@ -73,6 +73,7 @@ static void pppos_input_callback(void *arg);
 static void pppos_input_free_current_packet(pppos_pcb *pppos);
 static void pppos_input_drop(pppos_pcb *pppos);
 static err_t pppos_output_append(pppos_pcb *pppos, err_t err, struct pbuf *nb, u8_t c, u8_t accm, u16_t *fcs);
+static err_t pppos_output_append_buf(pppos_pcb *pppos, err_t err, struct pbuf *nb, const u8_t *s, u16_t n, u16_t *fcs);
 static err_t pppos_output_last(pppos_pcb *pppos, err_t err, struct pbuf *nb, u16_t *fcs);
 
 /* Callbacks structure for PPP core */
@@ -228,9 +229,7 @@ pppos_write(ppp_pcb *ppp, void *ctx, struct pbuf *p)
   fcs_out = PPP_INITFCS;
   s = (u8_t*)p->payload;
   n = p->len;
-  while (n-- > 0) {
-    err = pppos_output_append(pppos, err,  nb, *s++, 1, &fcs_out);
-  }
+  err = pppos_output_append_buf(pppos, err, nb, s, n, &fcs_out);
 
   err = pppos_output_last(pppos, err, nb, &fcs_out);
   if (err == ERR_OK) {
@@ -281,12 +280,7 @@ pppos_netif_output(ppp_pcb *ppp, void *ctx, struct pbuf *pb, u16_t protocol)
 
   /* Load packet. */
   for(p = pb; p; p = p->next) {
-    u16_t n = p->len;
-    u8_t *s = (u8_t*)p->payload;
-
-    while (n-- > 0) {
-      err = pppos_output_append(pppos, err,  nb, *s++, 1, &fcs_out);
-    }
+    err = pppos_output_append_buf(pppos, err, nb, (u8_t*)p->payload, p->len, &fcs_out);
   }
 
   err = pppos_output_last(pppos, err, nb, &fcs_out);
@@ -833,6 +827,70 @@ pppos_output_append(pppos_pcb *pppos, err_t err, struct pbuf *nb, u8_t c, u8_t a
   return ERR_OK;
 }
 
+/*
+ * pppos_output_append_buf - append a buffer of characters to the given
+ * pbuf, escaping as needed. Instead of taking a call per byte, runs of
+ * characters that need no escaping are located with the ACCM bitmap,
+ * copied with MEMCPY and folded into the FCS in one tight loop. The pbuf
+ * is flushed to the output callback whenever it fills, so the serial
+ * layer keeps seeing writes of up to the pbuf size.
+ */
+static err_t
+pppos_output_append_buf(pppos_pcb *pppos, err_t err, struct pbuf *nb, const u8_t *s, u16_t n, u16_t *fcs)
+{
+  u16_t fcs_out;
+
+  if (err != ERR_OK) {
+    return err;
+  }
+
+  fcs_out = *fcs;
+  pppos->out_data += n;
+  while (n > 0) {
+    u16_t room = PBUF_POOL_BUFSIZE - nb->len;
+    u16_t run, i;
+
+    /* Make sure there is room for at least an escaped character. */
+    if (room < 2) {
+      u32_t l = pppos->output_cb(pppos->ppp, (u8_t*)nb->payload, nb->len, pppos->ppp->ctx_cb);
+      if (l != nb->len) {
+        *fcs = fcs_out;
+        return ERR_IF;
+      }
+      nb->len = 0;
+      room = PBUF_POOL_BUFSIZE;
+    }
+
+    /* Longest run of characters that fit and need no escaping. */
+    run = n < room ? n : room;
+    for (i = 0; i < run; i++) {
+      if (ESCAPE_P(pppos->out_accm, s[i])) {
+        break;
+      }
+    }
+
+    if (i > 0) {
+      MEMCPY((u8_t*)nb->payload + nb->len, s, i);
+      nb->len += i;
+      n -= i;
+      while (i-- > 0) {
+        fcs_out = PPP_FCS(fcs_out, *s);
+        s++;
+      }
+    } else {
+      fcs_out = PPP_FCS(fcs_out, *s);
+      *((u8_t*)nb->payload + nb->len++) = PPP_ESCAPE;
+      *((u8_t*)nb->payload + nb->len++) = *s ^ PPP_TRANS;
+      s++;
+      n--;
+      pppos->out_stuffed++;
+    }
+  }
+
+  *fcs = fcs_out;
+  return ERR_OK;
+}
+
 static err_t
 pppos_output_last(pppos_pcb *pppos, err_t err, struct pbuf *nb, u16_t *fcs)
 {
@@ -159,6 +159,12 @@
 #define TCP_WND                     MBED_CONF_LWIP_TCP_WND
 #endif
 
+// Scale per-socket receive windows by pbuf pool occupancy; enabled per
+// socket with the NSAPI_RCVWND_AUTOTUNE socket option
+#if MBED_CONF_LWIP_TCP_WND_AUTOTUNE
+#define LWIP_TCP_RCVWND_AUTOTUNE    1
+#endif
+
 #ifdef MBED_CONF_LWIP_TCP_MAXRTX
 #define TCP_MAXRTX                  MBED_CONF_LWIP_TCP_MAXRTX
 #endif
@@ -319,8 +325,33 @@
 #define LWIP_DBG_MIN_LEVEL          LWIP_DBG_LEVEL_ALL
 #else
 #define LWIP_NOASSERT               1
+#if MBED_CONF_LWIP_PBUF_POOL_STATS || (MBED_CONF_LWIP_PBUF_POOL_RESERVE > 0) || MBED_CONF_LWIP_TCP_WND_AUTOTUNE
+// Only the pbuf pool counters are wanted - used for occupancy reporting,
+// the pool reserve in LWIPMemoryManager and TCP receive window
+// auto-tuning; keep the other statistics off
+#define LWIP_STATS                  1
+#define LWIP_STATS_DISPLAY          0
+#define MEMP_STATS                  1
+#define MEM_STATS                   0
+#define SYS_STATS                   0
+#define LINK_STATS                  0
+#define ETHARP_STATS                0
+#define IP_STATS                    0
+#define IPFRAG_STATS                0
+#define ICMP_STATS                  0
+#define IGMP_STATS                  0
+#define UDP_STATS                   0
+#define TCP_STATS                   0
+#define IP6_STATS                   0
+#define ICMP6_STATS                 0
+#define IP6_FRAG_STATS              0
+#define MLD6_STATS                  0
+#define ND6_STATS                   0
+#define MIB2_STATS                  0
+#else
 #define LWIP_STATS                  0
 #endif
+#endif
 
 #define TRACE_TO_ASCII_HEX_DUMP     0
 
@@ -371,6 +402,11 @@
 // Checksum-on-copy disabled due to https://savannah.nongnu.org/bugs/?50914
 #define LWIP_CHECKSUM_ON_COPY       0
 
+// Per-netif checksum control, so software checksums can be skipped on
+// interfaces whose EMAC reports hardware checksum offload. Interfaces
+// without offload (including PPP) keep all software checksums enabled.
+#define LWIP_CHECKSUM_CTRL_PER_NETIF 1
+
 #define LWIP_NETIF_HOSTNAME         1
 #define LWIP_NETIF_STATUS_CALLBACK  1
 #define LWIP_NETIF_LINK_CALLBACK    1
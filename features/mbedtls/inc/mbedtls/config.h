@@ -1376,6 +1376,23 @@
  */
 #define MBEDTLS_SSL_MAX_FRAGMENT_LENGTH
 
+/**
+ * \def MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH
+ *
+ * When this option is enabled, the SSL buffer will be resized automatically
+ * based on the negotiated maximum fragment length in each direction: the
+ * I/O buffers are allocated for the configured maximum fragment length,
+ * shrunk to the negotiated length once the handshake completes, and grown
+ * back on session reset. With several concurrent connections this reduces
+ * the per-connection RAM cost from two full-size buffers to two buffers of
+ * the fragment length actually in use.
+ *
+ * Requires: MBEDTLS_SSL_MAX_FRAGMENT_LENGTH
+ *
+ * Uncomment this macro to enable variable SSL buffer lengths.
+ */
+//#define MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH
+
 /**
  * \def MBEDTLS_SSL_PROTO_SSL3
  *
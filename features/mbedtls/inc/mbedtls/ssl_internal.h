@@ -213,6 +213,26 @@
 #define MBEDTLS_SSL_OUT_BUFFER_LEN  \
     ( ( MBEDTLS_SSL_HEADER_LEN ) + ( MBEDTLS_SSL_OUT_PAYLOAD_LEN ) )
 
+static inline size_t mbedtls_ssl_get_in_buf_len( const mbedtls_ssl_context *ctx )
+{
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    return ctx->in_buf_len;
+#else
+    ((void) ctx);
+    return MBEDTLS_SSL_IN_BUFFER_LEN;
+#endif
+}
+
+static inline size_t mbedtls_ssl_get_out_buf_len( const mbedtls_ssl_context *ctx )
+{
+#if defined(MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH)
+    return ctx->out_buf_len;
+#else
+    ((void) ctx);
+    return MBEDTLS_SSL_OUT_BUFFER_LEN;
+#endif
+}
+
 #ifdef MBEDTLS_ZLIB_SUPPORT
 /* Compression buffer holds both IN and OUT buffers, so should be size of the larger */
 #define MBEDTLS_SSL_COMPRESS_BUFFER_LEN (                               \
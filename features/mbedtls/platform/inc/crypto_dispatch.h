@@ -0,0 +1,101 @@
+ /*
+  *  crypto_dispatch.h
+  *
+  *  Runtime dispatch of elliptic curve point operations to a hardware
+  *  accelerator driver registered at boot.
+  *
+  *  Copyright (C) 2019, Arm Limited, All Rights Reserved
+  *  SPDX-License-Identifier: Apache-2.0
+  *
+  *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+  *  not use this file except in compliance with the License.
+  *  You may obtain a copy of the License at
+  *
+  *  http://www.apache.org/licenses/LICENSE-2.0
+  *
+  *  Unless required by applicable law or agreed to in writing, software
+  *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+  *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  *  See the License for the specific language governing permissions and
+  *  limitations under the License.
+  *
+  */
+
+#ifndef __CRYPTO_DISPATCH_H__
+#define __CRYPTO_DISPATCH_H__
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include "mbedtls/ecp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief   Driver table for the MBEDTLS_ECP_INTERNAL_ALT extension points.
+ *
+ * A target port probes its accelerator during crypto_platform_setup() and
+ * registers a table with mbed_crypto_ecp_register(). The dispatch layer
+ * then forwards the mbedtls_internal_ecp_*() calls to the driver. While no
+ * driver is registered (or for groups the driver reports as not capable via
+ * \c grp_capable), Mbed TLS falls back to its software implementation, so
+ * one image runs accelerated where hardware is present and in software
+ * elsewhere.
+ *
+ * ECP is the only module where Mbed TLS keeps the software path compiled in
+ * next to the alternative one; the AES and SHA-256 ALT hooks replace the
+ * software implementation at compile time, so they cannot be dispatched at
+ * runtime without forking the library sources.
+ *
+ * Function pointers may be left NULL when the corresponding
+ * MBEDTLS_ECP_*_ALT option is not enabled; a NULL \c grp_capable disables
+ * the driver entirely.
+ */
+typedef struct mbed_crypto_ecp_driver {
+    unsigned char (*grp_capable)(const mbedtls_ecp_group *grp);
+    int (*init)(const mbedtls_ecp_group *grp);
+    void (*free)(const mbedtls_ecp_group *grp);
+    int (*randomize_jac)(const mbedtls_ecp_group *grp, mbedtls_ecp_point *pt,
+                         int (*f_rng)(void *, unsigned char *, size_t), void *p_rng);
+    int (*add_mixed)(const mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
+                     const mbedtls_ecp_point *P, const mbedtls_ecp_point *Q);
+    int (*double_jac)(const mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
+                      const mbedtls_ecp_point *P);
+    int (*normalize_jac_many)(const mbedtls_ecp_group *grp,
+                              mbedtls_ecp_point *T[], size_t t_len);
+    int (*normalize_jac)(const mbedtls_ecp_group *grp, mbedtls_ecp_point *pt);
+    int (*double_add_mxz)(const mbedtls_ecp_group *grp, mbedtls_ecp_point *R,
+                          mbedtls_ecp_point *S, const mbedtls_ecp_point *P,
+                          const mbedtls_ecp_point *Q, const mbedtls_mpi *d);
+    int (*randomize_mxz)(const mbedtls_ecp_group *grp, mbedtls_ecp_point *P,
+                         int (*f_rng)(void *, unsigned char *, size_t), void *p_rng);
+    int (*normalize_mxz)(const mbedtls_ecp_group *grp, mbedtls_ecp_point *P);
+} mbed_crypto_ecp_driver_t;
+
+/**
+ * \brief   Register the accelerator driver table.
+ *
+ * Call once at boot, before any TLS or crypto operation. Pass NULL to
+ * unregister and force the software implementation.
+ *
+ * \param driver    Driver table, must stay valid while registered.
+ */
+void mbed_crypto_ecp_register(const mbed_crypto_ecp_driver_t *driver);
+
+/**
+ * \brief   Get the currently registered driver table.
+ *
+ * \return  Registered driver table, or NULL when none is registered.
+ */
+const mbed_crypto_ecp_driver_t *mbed_crypto_ecp_driver(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CRYPTO_DISPATCH_H__ */
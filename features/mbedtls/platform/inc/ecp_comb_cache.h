@@ -0,0 +1,87 @@
+ /*
+  *  ecp_comb_cache.h
+  *
+  *  Persistent base-point precomputation cache for repeated ECDHE.
+  *
+  *  Copyright (C) 2019, Arm Limited, All Rights Reserved
+  *  SPDX-License-Identifier: Apache-2.0
+  *
+  *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+  *  not use this file except in compliance with the License.
+  *  You may obtain a copy of the License at
+  *
+  *  http://www.apache.org/licenses/LICENSE-2.0
+  *
+  *  Unless required by applicable law or agreed to in writing, software
+  *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+  *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  *  See the License for the specific language governing permissions and
+  *  limitations under the License.
+  *
+  */
+
+#ifndef __ECP_COMB_CACHE_H__
+#define __ECP_COMB_CACHE_H__
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_ECP_C)
+
+#include "mbedtls/ecp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief   Precompute and retain the base-point comb table for a curve.
+ *
+ * Mbed TLS builds the comb precomputation table for fixed-point
+ * multiplication once per group, but every ECDHE handshake loads a fresh
+ * group into its ECDH context and rebuilds it. Warming a curve here keeps
+ * one group alive for the lifetime of the device; groups loaded with
+ * mbed_ecp_group_load_cached() then start from a copy of its table and
+ * mbedtls_ecdh_gen_public() skips straight to the comb multiplication.
+ *
+ * Call once per curve at boot, before any concurrent crypto use. Only
+ * short Weierstrass curves (e.g. secp256r1) use comb tables; warming a
+ * Montgomery curve such as Curve25519 is accepted but has no table to
+ * retain, as its ladder needs no precomputation.
+ *
+ * \param id    Curve to warm
+ *
+ * \return      0 on success, an Mbed TLS error code on failure
+ */
+int mbed_ecp_comb_cache_warm(mbedtls_ecp_group_id id);
+
+/**
+ * \brief   Load a group, seeding it from the precomputation cache.
+ *
+ * Drop-in replacement for mbedtls_ecp_group_load(). If the curve has been
+ * warmed, the cached comb table is copied into the group; otherwise (or if
+ * the copy fails for lack of memory) the group is still loaded and the
+ * table is rebuilt on demand as before.
+ *
+ * \param grp   Destination group, must be initialized
+ * \param id    Curve to load
+ *
+ * \return      0 on success, an Mbed TLS error code on failure
+ */
+int mbed_ecp_group_load_cached(mbedtls_ecp_group *grp, mbedtls_ecp_group_id id);
+
+/**
+ * \brief   Free all cached groups and their tables.
+ */
+void mbed_ecp_comb_cache_free(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBEDTLS_ECP_C */
+
+#endif /* __ECP_COMB_CACHE_H__ */
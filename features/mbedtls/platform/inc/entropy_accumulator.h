@@ -0,0 +1,78 @@
+ /*
+  *  entropy_accumulator.h
+  *
+  *  Background TRNG entropy accumulation, off the handshake critical path.
+  *
+  *  Copyright (C) 2019, Arm Limited, All Rights Reserved
+  *  SPDX-License-Identifier: Apache-2.0
+  *
+  *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+  *  not use this file except in compliance with the License.
+  *  You may obtain a copy of the License at
+  *
+  *  http://www.apache.org/licenses/LICENSE-2.0
+  *
+  *  Unless required by applicable law or agreed to in writing, software
+  *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+  *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  *  See the License for the specific language governing permissions and
+  *  limitations under the License.
+  *
+  */
+
+#ifndef __ENTROPY_ACCUMULATOR_H__
+#define __ENTROPY_ACCUMULATOR_H__
+
+#if DEVICE_TRNG
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief   Take accumulated entropy out of the background pool.
+ *
+ * Used by mbedtls_hardware_poll() to satisfy entropy requests without
+ * waiting on the TRNG. Consumed bytes are zeroized and never handed out
+ * twice. Safe to call from any context, including before the accumulator
+ * has been started (it then simply returns 0).
+ *
+ * \param output    Buffer to fill
+ * \param len       Bytes requested
+ *
+ * \return          Bytes actually taken, up to \p len
+ */
+size_t mbed_entropy_pool_read(unsigned char *output, size_t len);
+
+#ifdef __cplusplus
+}
+
+/**
+ * \brief   Start accumulating TRNG entropy in the background.
+ *
+ * Schedules a periodic top-up job on the shared event queue that drips
+ * bytes from the TRNG into a small pool while the system is otherwise
+ * idle. With the pool kept full, entropy collection for CTR-DRBG seeding
+ * and reseeding is already done by the time mbedtls_ssl_handshake() asks
+ * for it, instead of stalling the first connect on the TRNG throughput.
+ *
+ * Call once from threaded context, ideally early at boot so the pool is
+ * full before the first handshake. Calling again is a no-op.
+ */
+void mbed_entropy_accumulator_start();
+
+/**
+ * \brief   Stop the background accumulation.
+ *
+ * The pool keeps any bytes already gathered; mbedtls_hardware_poll()
+ * falls back to synchronous TRNG reads once they are used up.
+ */
+void mbed_entropy_accumulator_stop();
+
+#endif /* __cplusplus */
+
+#endif /* DEVICE_TRNG */
+
+#endif /* __ENTROPY_ACCUMULATOR_H__ */
@@ -0,0 +1,86 @@
+ /*
+  *  sha256_storage.h
+  *
+  *  SHA-256 helpers over storage, for firmware image verification.
+  *
+  *  Copyright (C) 2019, Arm Limited, All Rights Reserved
+  *  SPDX-License-Identifier: Apache-2.0
+  *
+  *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+  *  not use this file except in compliance with the License.
+  *  You may obtain a copy of the License at
+  *
+  *  http://www.apache.org/licenses/LICENSE-2.0
+  *
+  *  Unless required by applicable law or agreed to in writing, software
+  *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+  *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  *  See the License for the specific language governing permissions and
+  *  limitations under the License.
+  *
+  */
+
+#ifndef __SHA256_STORAGE_H__
+#define __SHA256_STORAGE_H__
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_SHA256_C) && defined(__cplusplus)
+
+#include "mbedtls/sha256.h"
+#include "BlockDevice.h"
+
+#if DEVICE_FLASH
+#include "FlashIAP.h"
+#endif
+
+/**
+ * \brief          Compute the SHA-256 or SHA-224 of a block device region.
+ *
+ *                 Reads the region through one bounded chunk buffer and feeds
+ *                 it straight into the hash, so the whole image is never
+ *                 staged in RAM. Hardware SHA engines are used automatically
+ *                 where a target enables the SHA-256 ALT layer.
+ *
+ * \param bd       Initialized block device to read from
+ * \param addr     Address of the region to hash
+ * \param size     Size of the region in bytes
+ * \param output   SHA-224/256 checksum result
+ * \param is224    0 = use SHA-256, 1 = use SHA-224
+ *
+ * \return         0 on success, an Mbed TLS or block device error code on
+ *                 failure
+ */
+int mbedtls_sha256_blockdevice(mbed::BlockDevice *bd, mbed::bd_addr_t addr,
+                               mbed::bd_size_t size, unsigned char output[32],
+                               int is224);
+
+#if DEVICE_FLASH
+/**
+ * \brief          Compute the SHA-256 or SHA-224 of an internal flash region.
+ *
+ *                 Internal flash is memory mapped, so the region is hashed
+ *                 in place with no read copy at all - the hash input pointer
+ *                 is the flash address itself.
+ *
+ * \param flash    Initialized FlashIAP instance
+ * \param addr     Flash address of the region to hash
+ * \param size     Size of the region in bytes
+ * \param output   SHA-224/256 checksum result
+ * \param is224    0 = use SHA-256, 1 = use SHA-224
+ *
+ * \return         0 on success, an Mbed TLS error code or
+ *                 BD_ERROR_DEVICE_ERROR for a region outside the flash on
+ *                 failure
+ */
+int mbedtls_sha256_flash(mbed::FlashIAP *flash, uint32_t addr, uint32_t size,
+                         unsigned char output[32], int is224);
+#endif /* DEVICE_FLASH */
+
+#endif /* MBEDTLS_SHA256_C && __cplusplus */
+
+#endif /* __SHA256_STORAGE_H__ */
@@ -0,0 +1,132 @@
+ /*
+  *  crypto_dispatch.c
+  *
+  *  Runtime dispatch of elliptic curve point operations to a hardware
+  *  accelerator driver registered at boot.
+  *
+  *  Copyright (C) 2019, Arm Limited, All Rights Reserved
+  *  SPDX-License-Identifier: Apache-2.0
+  *
+  *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+  *  not use this file except in compliance with the License.
+  *  You may obtain a copy of the License at
+  *
+  *  http://www.apache.org/licenses/LICENSE-2.0
+  *
+  *  Unless required by applicable law or agreed to in writing, software
+  *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+  *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  *  See the License for the specific language governing permissions and
+  *  limitations under the License.
+  *
+  */
+
+#include "crypto_dispatch.h"
+
+static const mbed_crypto_ecp_driver_t *ecp_driver;
+
+void mbed_crypto_ecp_register(const mbed_crypto_ecp_driver_t *driver)
+{
+    ecp_driver = driver;
+}
+
+const mbed_crypto_ecp_driver_t *mbed_crypto_ecp_driver(void)
+{
+    return ecp_driver;
+}
+
+#if defined(MBEDTLS_ECP_INTERNAL_ALT)
+
+/* Mbed TLS consults grp_capable before each point operation and falls back
+ * to its software implementation when it returns zero, so returning zero
+ * with no registered driver gives the software path. The remaining hooks
+ * are only reached for groups the driver has claimed. */
+unsigned char mbedtls_internal_ecp_grp_capable(const mbedtls_ecp_group *grp)
+{
+    if (ecp_driver == NULL || ecp_driver->grp_capable == NULL) {
+        return 0;
+    }
+    return ecp_driver->grp_capable(grp);
+}
+
+int mbedtls_internal_ecp_init(const mbedtls_ecp_group *grp)
+{
+    return ecp_driver->init ? ecp_driver->init(grp) : 0;
+}
+
+void mbedtls_internal_ecp_free(const mbedtls_ecp_group *grp)
+{
+    if (ecp_driver->free) {
+        ecp_driver->free(grp);
+    }
+}
+
+#if defined(MBEDTLS_ECP_RANDOMIZE_JAC_ALT)
+int mbedtls_internal_ecp_randomize_jac(const mbedtls_ecp_group *grp,
+                                       mbedtls_ecp_point *pt, int (*f_rng)(void *, unsigned char *, size_t),
+                                       void *p_rng)
+{
+    return ecp_driver->randomize_jac(grp, pt, f_rng, p_rng);
+}
+#endif
+
+#if defined(MBEDTLS_ECP_ADD_MIXED_ALT)
+int mbedtls_internal_ecp_add_mixed(const mbedtls_ecp_group *grp,
+                                   mbedtls_ecp_point *R, const mbedtls_ecp_point *P,
+                                   const mbedtls_ecp_point *Q)
+{
+    return ecp_driver->add_mixed(grp, R, P, Q);
+}
+#endif
+
+#if defined(MBEDTLS_ECP_DOUBLE_JAC_ALT)
+int mbedtls_internal_ecp_double_jac(const mbedtls_ecp_group *grp,
+                                    mbedtls_ecp_point *R, const mbedtls_ecp_point *P)
+{
+    return ecp_driver->double_jac(grp, R, P);
+}
+#endif
+
+#if defined(MBEDTLS_ECP_NORMALIZE_JAC_MANY_ALT)
+int mbedtls_internal_ecp_normalize_jac_many(const mbedtls_ecp_group *grp,
+                                            mbedtls_ecp_point *T[], size_t t_len)
+{
+    return ecp_driver->normalize_jac_many(grp, T, t_len);
+}
+#endif
+
+#if defined(MBEDTLS_ECP_NORMALIZE_JAC_ALT)
+int mbedtls_internal_ecp_normalize_jac(const mbedtls_ecp_group *grp,
+                                       mbedtls_ecp_point *pt)
+{
+    return ecp_driver->normalize_jac(grp, pt);
+}
+#endif
+
+#if defined(MBEDTLS_ECP_DOUBLE_ADD_MXZ_ALT)
+int mbedtls_internal_ecp_double_add_mxz(const mbedtls_ecp_group *grp,
+                                        mbedtls_ecp_point *R, mbedtls_ecp_point *S, const mbedtls_ecp_point *P,
+                                        const mbedtls_ecp_point *Q, const mbedtls_mpi *d)
+{
+    return ecp_driver->double_add_mxz(grp, R, S, P, Q, d);
+}
+#endif
+
+#if defined(MBEDTLS_ECP_RANDOMIZE_MXZ_ALT)
+int mbedtls_internal_ecp_randomize_mxz(const mbedtls_ecp_group *grp,
+                                       mbedtls_ecp_point *P, int (*f_rng)(void *, unsigned char *, size_t),
+                                       void *p_rng)
+{
+    return ecp_driver->randomize_mxz(grp, P, f_rng, p_rng);
+}
+#endif
+
+#if defined(MBEDTLS_ECP_NORMALIZE_MXZ_ALT)
+int mbedtls_internal_ecp_normalize_mxz(const mbedtls_ecp_group *grp,
+                                       mbedtls_ecp_point *P)
+{
+    return ecp_driver->normalize_mxz(grp, P);
+}
+#endif
+
+#endif /* MBEDTLS_ECP_INTERNAL_ALT */
@@ -0,0 +1,150 @@
+ /*
+  *  ecp_comb_cache.c
+  *
+  *  Persistent base-point precomputation cache for repeated ECDHE.
+  *
+  *  Copyright (C) 2019, Arm Limited, All Rights Reserved
+  *  SPDX-License-Identifier: Apache-2.0
+  *
+  *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+  *  not use this file except in compliance with the License.
+  *  You may obtain a copy of the License at
+  *
+  *  http://www.apache.org/licenses/LICENSE-2.0
+  *
+  *  Unless required by applicable law or agreed to in writing, software
+  *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+  *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  *  See the License for the specific language governing permissions and
+  *  limitations under the License.
+  *
+  */
+
+#include "ecp_comb_cache.h"
+
+#if defined(MBEDTLS_ECP_C)
+
+#if defined(MBEDTLS_PLATFORM_C)
+#include "mbedtls/platform.h"
+#else
+#include <stdlib.h>
+#define mbedtls_calloc    calloc
+#define mbedtls_free      free
+#endif
+
+/* Number of curves that can be warmed at once; a TLS deployment normally
+ * pins one or two */
+#define ECP_COMB_CACHE_MAX_CURVES 2
+
+static mbedtls_ecp_group cache_groups[ECP_COMB_CACHE_MAX_CURVES];
+static size_t cache_count;
+
+static const mbedtls_ecp_group *comb_cache_find(mbedtls_ecp_group_id id)
+{
+    for (size_t i = 0; i < cache_count; i++) {
+        if (cache_groups[i].id == id) {
+            return &cache_groups[i];
+        }
+    }
+    return NULL;
+}
+
+int mbed_ecp_comb_cache_warm(mbedtls_ecp_group_id id)
+{
+    if (comb_cache_find(id) != NULL) {
+        return 0;
+    }
+    if (cache_count >= ECP_COMB_CACHE_MAX_CURVES) {
+        return MBEDTLS_ERR_ECP_ALLOC_FAILED;
+    }
+
+    mbedtls_ecp_group *grp = &cache_groups[cache_count];
+    mbedtls_ecp_group_init(grp);
+
+    int ret = mbedtls_ecp_group_load(grp, id);
+    if (ret != 0) {
+        mbedtls_ecp_group_free(grp);
+        return ret;
+    }
+
+    /* Montgomery curves (G has no Y coordinate, same test the library
+     * uses internally) take the ladder path and have no comb table to
+     * retain; keep the group so repeated warms stay cheap no-ops. */
+    if (grp->G.Y.p == NULL) {
+        cache_count++;
+        return 0;
+    }
+
+    /* A multiplication by the base point makes ecp_mul_comb() build the
+     * comb table and store it in grp->T; keeping this group alive keeps
+     * the table. */
+    mbedtls_ecp_point R;
+    mbedtls_mpi m;
+    mbedtls_ecp_point_init(&R);
+    mbedtls_mpi_init(&m);
+
+    MBEDTLS_MPI_CHK(mbedtls_mpi_lset(&m, 2));
+    MBEDTLS_MPI_CHK(mbedtls_ecp_mul(grp, &R, &m, &grp->G, NULL, NULL));
+
+cleanup:
+    mbedtls_ecp_point_free(&R);
+    mbedtls_mpi_free(&m);
+    if (ret != 0) {
+        mbedtls_ecp_group_free(grp);
+        return ret;
+    }
+
+    cache_count++;
+    return 0;
+}
+
+int mbed_ecp_group_load_cached(mbedtls_ecp_group *grp, mbedtls_ecp_group_id id)
+{
+    int ret = mbedtls_ecp_group_load(grp, id);
+    if (ret != 0) {
+        return ret;
+    }
+
+    const mbedtls_ecp_group *cached = comb_cache_find(id);
+    if (cached == NULL || cached->T == NULL) {
+        return 0;
+    }
+
+    /* Deep-copy the cached table so the group owns its copy and
+     * mbedtls_ecp_group_free() works unchanged. The table size matches
+     * what ecp_mul_comb() will expect, as the window size depends only on
+     * the curve and the build configuration. On allocation failure the
+     * group is still fully usable; the table is just rebuilt on demand. */
+    mbedtls_ecp_point *T = mbedtls_calloc(cached->T_size,
+                                          sizeof(mbedtls_ecp_point));
+    if (T == NULL) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < cached->T_size; i++) {
+        mbedtls_ecp_point_init(&T[i]);
+    }
+    for (size_t i = 0; i < cached->T_size; i++) {
+        if (mbedtls_ecp_copy(&T[i], &cached->T[i]) != 0) {
+            for (size_t j = 0; j < cached->T_size; j++) {
+                mbedtls_ecp_point_free(&T[j]);
+            }
+            mbedtls_free(T);
+            return 0;
+        }
+    }
+
+    grp->T = T;
+    grp->T_size = cached->T_size;
+    return 0;
+}
+
+void mbed_ecp_comb_cache_free(void)
+{
+    for (size_t i = 0; i < cache_count; i++) {
+        mbedtls_ecp_group_free(&cache_groups[i]);
+    }
+    cache_count = 0;
+}
+
+#endif /* MBEDTLS_ECP_C */
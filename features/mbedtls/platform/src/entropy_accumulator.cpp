@@ -0,0 +1,115 @@
+ /*
+  *  entropy_accumulator.cpp
+  *
+  *  Background TRNG entropy accumulation, off the handshake critical path.
+  *
+  *  Copyright (C) 2019, Arm Limited, All Rights Reserved
+  *  SPDX-License-Identifier: Apache-2.0
+  *
+  *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+  *  not use this file except in compliance with the License.
+  *  You may obtain a copy of the License at
+  *
+  *  http://www.apache.org/licenses/LICENSE-2.0
+  *
+  *  Unless required by applicable law or agreed to in writing, software
+  *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+  *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  *  See the License for the specific language governing permissions and
+  *  limitations under the License.
+  *
+  */
+
+#include "entropy_accumulator.h"
+
+#if DEVICE_TRNG
+
+#include <string.h>
+
+#include "hal/trng_api.h"
+#include "platform/mbed_critical.h"
+#include "events/mbed_shared_queues.h"
+
+/* Pool size; 256 bytes covers CTR-DRBG seeding plus several reseeds */
+#ifndef MBED_ENTROPY_POOL_SIZE
+#define MBED_ENTROPY_POOL_SIZE 256
+#endif
+
+/* Bytes gathered per top-up job, kept small so each job stays well under
+ * the shared queue's 10 ms guideline even on slow TRNGs */
+#ifndef MBED_ENTROPY_POOL_FILL_CHUNK
+#define MBED_ENTROPY_POOL_FILL_CHUNK 16
+#endif
+
+/* Interval between top-up jobs */
+#ifndef MBED_ENTROPY_POOL_FILL_PERIOD_MS
+#define MBED_ENTROPY_POOL_FILL_PERIOD_MS 50
+#endif
+
+static unsigned char entropy_pool[MBED_ENTROPY_POOL_SIZE];
+static size_t entropy_pool_len;
+static int entropy_fill_id;
+
+size_t mbed_entropy_pool_read(unsigned char *output, size_t len)
+{
+    core_util_critical_section_enter();
+    if (len > entropy_pool_len) {
+        len = entropy_pool_len;
+    }
+    if (len > 0) {
+        entropy_pool_len -= len;
+        memcpy(output, &entropy_pool[entropy_pool_len], len);
+        memset(&entropy_pool[entropy_pool_len], 0, len);
+    }
+    core_util_critical_section_exit();
+    return len;
+}
+
+static void entropy_pool_fill()
+{
+    /* Snapshot under lock; only this job ever grows the pool, so the free
+     * space cannot shrink while the TRNG read runs outside the lock */
+    core_util_critical_section_enter();
+    size_t space = MBED_ENTROPY_POOL_SIZE - entropy_pool_len;
+    core_util_critical_section_exit();
+    if (space == 0) {
+        return;
+    }
+
+    unsigned char chunk[MBED_ENTROPY_POOL_FILL_CHUNK];
+    size_t want = space < sizeof(chunk) ? space : sizeof(chunk);
+    size_t got = 0;
+
+    trng_t trng_obj;
+    trng_init(&trng_obj);
+    int ret = trng_get_bytes(&trng_obj, chunk, want, &got);
+    trng_free(&trng_obj);
+    if (ret != 0 || got == 0) {
+        return;
+    }
+
+    core_util_critical_section_enter();
+    memcpy(&entropy_pool[entropy_pool_len], chunk, got);
+    entropy_pool_len += got;
+    core_util_critical_section_exit();
+    memset(chunk, 0, sizeof(chunk));
+}
+
+void mbed_entropy_accumulator_start()
+{
+    if (entropy_fill_id != 0) {
+        return;
+    }
+    entropy_fill_id = mbed::mbed_event_queue()->call_every(
+                          MBED_ENTROPY_POOL_FILL_PERIOD_MS, entropy_pool_fill);
+}
+
+void mbed_entropy_accumulator_stop()
+{
+    if (entropy_fill_id != 0) {
+        mbed::mbed_event_queue()->cancel(entropy_fill_id);
+        entropy_fill_id = 0;
+    }
+}
+
+#endif /* DEVICE_TRNG */
@@ -17,12 +17,25 @@
 #if DEVICE_TRNG
 
 #include "hal/trng_api.h"
+#include "entropy_accumulator.h"
 
 int mbedtls_hardware_poll( void *data, unsigned char *output, size_t len, size_t *olen ) {
+    /* Prefer entropy gathered in the background, so handshakes do not
+     * stall on the TRNG; fall back to a synchronous read for whatever
+     * the pool cannot cover */
+    size_t taken = mbed_entropy_pool_read(output, len);
+    if (taken == len) {
+        *olen = len;
+        return 0;
+    }
+
     trng_t trng_obj;
     trng_init(&trng_obj);
-    int ret = trng_get_bytes(&trng_obj, output, len, olen);
+    int ret = trng_get_bytes(&trng_obj, output + taken, len - taken, olen);
     trng_free(&trng_obj);
+    if (ret == 0) {
+        *olen += taken;
+    }
     return ret;
 }
 
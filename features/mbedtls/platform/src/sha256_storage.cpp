@@ -0,0 +1,127 @@
+ /*
+  *  sha256_storage.cpp
+  *
+  *  SHA-256 helpers over storage, for firmware image verification.
+  *
+  *  Copyright (C) 2019, Arm Limited, All Rights Reserved
+  *  SPDX-License-Identifier: Apache-2.0
+  *
+  *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+  *  not use this file except in compliance with the License.
+  *  You may obtain a copy of the License at
+  *
+  *  http://www.apache.org/licenses/LICENSE-2.0
+  *
+  *  Unless required by applicable law or agreed to in writing, software
+  *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+  *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  *  See the License for the specific language governing permissions and
+  *  limitations under the License.
+  *
+  */
+
+#include "sha256_storage.h"
+
+#if defined(MBEDTLS_SHA256_C)
+
+#include <new>
+#include <string.h>
+
+using namespace mbed;
+
+/* Preferred chunk buffer size; grown to the device read size when needed */
+#define SHA256_STORAGE_CHUNK_SIZE 512
+
+int mbedtls_sha256_blockdevice(BlockDevice *bd, bd_addr_t addr,
+                               bd_size_t size, unsigned char output[32],
+                               int is224)
+{
+    if (bd == NULL || output == NULL) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    bd_size_t read_size = bd->get_read_size();
+    if (read_size == 0 || addr + size > bd->size()) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    /* Reads must be aligned to the read size, so cover the requested region
+     * with aligned chunks and hash only the requested bytes of each */
+    bd_size_t buf_size = read_size;
+    if (buf_size < SHA256_STORAGE_CHUNK_SIZE) {
+        buf_size = read_size * (SHA256_STORAGE_CHUNK_SIZE / read_size);
+    }
+    uint8_t *buf = new (std::nothrow) uint8_t[buf_size];
+    if (buf == NULL) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    mbedtls_sha256_context ctx;
+    mbedtls_sha256_init(&ctx);
+
+    int ret = mbedtls_sha256_starts_ret(&ctx, is224);
+
+    bd_addr_t pos = addr - (addr % read_size);
+    bd_addr_t end = addr + size;
+    bd_addr_t aligned_end = end + (read_size - end % read_size) % read_size;
+
+    while (ret == 0 && pos < aligned_end) {
+        bd_size_t chunk = buf_size;
+        if (pos + chunk > aligned_end) {
+            chunk = aligned_end - pos;
+        }
+        ret = bd->read(buf, pos, chunk);
+        if (ret == 0) {
+            /* Hash the intersection of this chunk with the requested region */
+            bd_addr_t data_start = pos < addr ? addr : pos;
+            bd_addr_t data_end = pos + chunk > end ? end : pos + chunk;
+            ret = mbedtls_sha256_update_ret(&ctx, buf + (data_start - pos),
+                                            data_end - data_start);
+        }
+        pos += chunk;
+    }
+
+    if (ret == 0) {
+        ret = mbedtls_sha256_finish_ret(&ctx, output);
+    }
+
+    mbedtls_sha256_free(&ctx);
+    memset(buf, 0, buf_size);
+    delete[] buf;
+    return ret;
+}
+
+#if DEVICE_FLASH
+int mbedtls_sha256_flash(FlashIAP *flash, uint32_t addr, uint32_t size,
+                         unsigned char output[32], int is224)
+{
+    if (flash == NULL || output == NULL) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    uint32_t flash_start = flash->get_flash_start();
+    uint32_t flash_size = flash->get_flash_size();
+    if (addr < flash_start || size > flash_size ||
+            addr - flash_start > flash_size - size) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    mbedtls_sha256_context ctx;
+    mbedtls_sha256_init(&ctx);
+
+    /* Internal flash is memory mapped - hash straight from the flash
+     * address, no FlashIAP::read staging copy */
+    int ret = mbedtls_sha256_starts_ret(&ctx, is224);
+    if (ret == 0) {
+        ret = mbedtls_sha256_update_ret(&ctx, (const unsigned char *)addr, size);
+    }
+    if (ret == 0) {
+        ret = mbedtls_sha256_finish_ret(&ctx, output);
+    }
+
+    mbedtls_sha256_free(&ctx);
+    return ret;
+}
+#endif /* DEVICE_FLASH */
+
+#endif /* MBEDTLS_SHA256_C */
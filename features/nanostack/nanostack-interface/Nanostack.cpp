@@ -41,6 +41,16 @@
 #define MALLOC  ns_dyn_mem_alloc
 #define FREE    ns_dyn_mem_free
 
+// Buffer ownership: payloads cross this bridge with a single copy, made by
+// nanostack's own socket API. do_sendto() hands the caller's buffer straight
+// to socket_sendmsg(), which copies it into nanostack's buffer_t for the
+// asynchronous TX path, and socket_recvfrom() lets nanostack fill the
+// caller's buffer directly from its queued data. No intermediate staging
+// buffer is allocated here. That one copy per direction is fixed by the
+// NSAPI contract - send() buffers stay owned by the caller on return and
+// recv() fills caller-owned storage - so a shared refcounted pool would
+// need an API change on both sides, not a change in this adaptation.
+
 // Socket state progressions:
 // UDP: UNOPENED -> DATAGRAM
 // TCP client: UNOPENED -> OPENED -> CONNECTING -> STREAM -> CLOSED
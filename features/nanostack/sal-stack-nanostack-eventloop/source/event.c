@@ -32,9 +32,18 @@ typedef struct arm_core_tasklet {
 } arm_core_tasklet_t;
 
 static NS_LIST_DEFINE(arm_core_tasklet_list, arm_core_tasklet_t, link);
-static NS_LIST_DEFINE(event_queue_active, arm_event_storage_t, link);
 static NS_LIST_DEFINE(free_event_entry, arm_event_storage_t, link);
 
+/* Queued events are kept in one list per priority, so queueing is a plain
+ * O(1) append and the dispatcher drains the lanes strictly in priority order. */
+typedef NS_LIST_HEAD(arm_event_storage_t, link) event_queue_t;
+#define EVENT_QUEUE_LANES (ARM_LIB_LOW_PRIORITY_EVENT + 1)
+static event_queue_t event_queue_active[EVENT_QUEUE_LANES] = {
+    NS_LIST_INIT(event_queue_active[0]),
+    NS_LIST_INIT(event_queue_active[1]),
+    NS_LIST_INIT(event_queue_active[2]),
+};
+
 // Statically allocate initial pool of events.
 #define STARTUP_EVENT_POOL_SIZE 10
 static arm_event_storage_t startup_event_pool[STARTUP_EVENT_POOL_SIZE];
@@ -48,6 +57,26 @@ static arm_event_storage_t *event_dynamically_allocate(void);
 static arm_event_storage_t *event_core_get(void);
 static void event_core_write(arm_event_storage_t *event);
 
+// Requires lock to be held
+static event_queue_t *event_queue_lane(arm_library_event_priority_e priority)
+{
+    if (priority >= EVENT_QUEUE_LANES) {
+        priority = ARM_LIB_LOW_PRIORITY_EVENT;
+    }
+    return &event_queue_active[priority];
+}
+
+// Requires lock to be held
+static bool event_queue_is_empty(void)
+{
+    for (unsigned lane = 0; lane < EVENT_QUEUE_LANES; lane++) {
+        if (!ns_list_is_empty(&event_queue_active[lane])) {
+            return false;
+        }
+    }
+    return true;
+}
+
 static arm_core_tasklet_t *event_tasklet_handler_get(uint8_t tasklet_id)
 {
     ns_list_foreach(arm_core_tasklet_t, cur, &arm_core_tasklet_list) {
@@ -142,7 +171,7 @@ void eventOS_event_send_timer_allocated(arm_event_storage_t *event)
 
 void eventOS_event_cancel_critical(arm_event_storage_t *event)
 {
-    ns_list_remove(&event_queue_active, event);
+    ns_list_remove(event_queue_lane(event->data.priority), event);
 }
 
 static arm_event_storage_t *event_dynamically_allocate(void)
@@ -204,11 +233,15 @@ void event_core_free_push(arm_event_storage_t *free)
 
 static arm_event_storage_t *event_core_read(void)
 {
+    arm_event_storage_t *event = NULL;
     platform_enter_critical();
-    arm_event_storage_t *event = ns_list_get_first(&event_queue_active);
-    if (event) {
-        event->state = ARM_LIB_EVENT_RUNNING;
-        ns_list_remove(&event_queue_active, event);
+    for (unsigned lane = 0; lane < EVENT_QUEUE_LANES; lane++) {
+        event = ns_list_get_first(&event_queue_active[lane]);
+        if (event) {
+            event->state = ARM_LIB_EVENT_RUNNING;
+            ns_list_remove(&event_queue_active[lane], event);
+            break;
+        }
     }
     platform_exit_critical();
     return event;
@@ -217,31 +250,26 @@ static arm_event_storage_t *event_core_read(void)
 void event_core_write(arm_event_storage_t *event)
 {
     platform_enter_critical();
-    bool added = false;
-    ns_list_foreach(arm_event_storage_t, event_tmp, &event_queue_active) {
-        // note enum ordering means we're checking if event_tmp is LOWER priority than event
-        if (event_tmp->data.priority > event->data.priority) {
-            ns_list_add_before(&event_queue_active, event_tmp, event);
-            added = true;
-            break;
-        }
-    }
-    if (!added) {
-        ns_list_add_to_end(&event_queue_active, event);
-    }
+    bool need_wakeup = event_queue_is_empty();
+    ns_list_add_to_end(event_queue_lane(event->data.priority), event);
     event->state = ARM_LIB_EVENT_QUEUED;
-
-    /* Wake From Idle */
     platform_exit_critical();
-    eventOS_scheduler_signal();
+
+    /* Wake From Idle - the scheduler only idles once every lane has been
+     * drained, so signalling is needed just for the first event of a batch. */
+    if (need_wakeup) {
+        eventOS_scheduler_signal();
+    }
 }
 
 // Requires lock to be held
 arm_event_storage_t *eventOS_event_find_by_id_critical(uint8_t tasklet_id, uint8_t event_id)
 {
-    ns_list_foreach(arm_event_storage_t, cur, &event_queue_active) {
-        if (cur->data.receiver == tasklet_id && cur->data.event_id == event_id) {
-            return cur;
+    for (unsigned lane = 0; lane < EVENT_QUEUE_LANES; lane++) {
+        ns_list_foreach(arm_event_storage_t, cur, &event_queue_active[lane]) {
+            if (cur->data.receiver == tasklet_id && cur->data.event_id == event_id) {
+                return cur;
+            }
         }
     }
 
@@ -259,7 +287,9 @@ void eventOS_scheduler_init(void)
 {
     /* Reset Event List variables */
     ns_list_init(&free_event_entry);
-    ns_list_init(&event_queue_active);
+    for (unsigned lane = 0; lane < EVENT_QUEUE_LANES; lane++) {
+        ns_list_init(&event_queue_active[lane]);
+    }
     ns_list_init(&arm_core_tasklet_list);
 
     //Add first 10 entries to "free" list
@@ -28,9 +28,21 @@
 
 #define TRACE_GROUP "mnei"
 
+static uint_fast16_t neighbor_table_class_hash_bucket(mac_neighbor_table_t *table_class, const uint8_t *mac64)
+{
+    uint32_t hash = common_read_32_bit(mac64) ^ common_read_32_bit(mac64 + 4);
+    hash ^= hash >> 16;
+    return hash & (table_class->hash_bucket_count - 1);
+}
+
 mac_neighbor_table_t *mac_neighbor_table_create(uint8_t table_size, neighbor_entry_remove_notify *remove_cb, neighbor_entry_nud_notify *nud_cb, void *user_indentifier)
 {
-    mac_neighbor_table_t *table_class = ns_dyn_mem_alloc(sizeof(mac_neighbor_table_t) + sizeof(mac_neighbor_table_entry_t) * table_size);
+    //Size hash index from configured table size, next power of two for cheap masking
+    uint16_t hash_bucket_count = 4;
+    while (hash_bucket_count < table_size) {
+        hash_bucket_count <<= 1;
+    }
+    mac_neighbor_table_t *table_class = ns_dyn_mem_alloc(sizeof(mac_neighbor_table_t) + sizeof(mac_neighbor_table_entry_t) * table_size + sizeof(mac_neighbor_table_hash_list_t) * hash_bucket_count);
     if (!table_class) {
         return NULL;
     }
@@ -43,6 +55,12 @@ mac_neighbor_table_t *mac_neighbor_table_create(uint8_t table_size, neighbor_ent
     table_class->user_remove_notify_cb = remove_cb;
     ns_list_init(&table_class->neighbour_list);
     ns_list_init(&table_class->free_list);
+    //Hash buckets live after the entry buffer in the same allocation
+    table_class->hash_bucket_count = hash_bucket_count;
+    table_class->hash_table = (mac_neighbor_table_hash_list_t *) &table_class->neighbor_entry_buffer[table_size];
+    for (uint16_t i = 0; i < hash_bucket_count; i++) {
+        ns_list_init(&table_class->hash_table[i]);
+    }
     for (uint8_t i = 0; i < table_size; i++) {
         memset(cur_ptr, 0, sizeof(mac_neighbor_table_entry_t));
         cur_ptr->index = i;
@@ -64,6 +82,7 @@ void mac_neighbor_table_delete(mac_neighbor_table_t *table_class)
 static void neighbor_table_class_remove_entry(mac_neighbor_table_t *table_class, mac_neighbor_table_entry_t *entry)
 {
     ns_list_remove(&table_class->neighbour_list, entry);
+    ns_list_remove(&table_class->hash_table[neighbor_table_class_hash_bucket(table_class, entry->mac64)], entry);
     table_class->neighbour_list_size--;
     if (entry->nud_active) {
         entry->nud_active = false;
@@ -137,6 +156,7 @@ mac_neighbor_table_entry_t *mac_neighbor_table_entry_allocate(mac_neighbor_table
     ns_list_add_to_end(&table_class->neighbour_list, entry);
     table_class->neighbour_list_size++;
     memcpy(entry->mac64, mac64, 8);
+    ns_list_add_to_end(&table_class->hash_table[neighbor_table_class_hash_bucket(table_class, mac64)], entry);
     entry->mac16 = 0xffff;
     entry->rx_on_idle = true;
     entry->ffd_device = true;
@@ -207,20 +227,20 @@ mac_neighbor_table_entry_t *mac_neighbor_table_address_discover(mac_neighbor_tab
     if (address_type == ADDR_802_15_4_SHORT) {
         short_address = common_read_16_bit(address);
     } else if (address_type == ADDR_802_15_4_LONG) {
-
+        //MAC64 is hash indexed so discover only needs to scan one bucket
+        ns_list_foreach(mac_neighbor_table_entry_t, cur, &table_class->hash_table[neighbor_table_class_hash_bucket(table_class, address)]) {
+            if (memcmp(cur->mac64, address, 8) == 0) {
+                return cur;
+            }
+        }
+        return NULL;
     } else {
         return NULL;
     }
 
     ns_list_foreach(mac_neighbor_table_entry_t, cur, &table_class->neighbour_list) {
-        if (address_type == ADDR_802_15_4_SHORT) {
-            if (cur->mac16 != 0xffff && cur->mac16 == short_address) {
-                return cur;
-            }
-        } else {
-            if (memcmp(cur->mac64, address, 8) == 0) {
-                return cur;
-            }
+        if (cur->mac16 != 0xffff && cur->mac16 == short_address) {
+            return cur;
         }
     }
 
@@ -46,9 +46,11 @@ typedef struct mac_neighbor_table_entry {
     bool            nud_active: 1;          /*!< True Neighbor NUD process is active, false not active process */
     unsigned        link_role: 2;           /*!< Link role: NORMAL_NEIGHBOUR, PRIORITY_PARENT_NEIGHBOUR, SECONDARY_PARENT_NEIGHBOUR, CHILD_NEIGHBOUR */
     ns_list_link_t  link;
+    ns_list_link_t  hash_link;              /*!< Link for MAC64 keyed hash index */
 } mac_neighbor_table_entry_t;
 
 typedef NS_LIST_HEAD(mac_neighbor_table_entry_t, link) mac_neighbor_table_list_t;
+typedef NS_LIST_HEAD(mac_neighbor_table_entry_t, hash_link) mac_neighbor_table_hash_list_t;
 
 #define mac_neighbor_info(interface) ((interface)->mac_parameters->mac_neighbor_table) /*!< Helper macro for give mac neighbor class pointer from interface pointer. */
 
@@ -78,7 +80,9 @@ typedef bool neighbor_entry_nud_notify(mac_neighbor_table_entry_t *entry_ptr, vo
 typedef struct mac_neighbor_table_class {
     mac_neighbor_table_list_t neighbour_list;               /*!< List of active neighbors */
     mac_neighbor_table_list_t free_list;                    /*!< List of free neighbors entries */
+    mac_neighbor_table_hash_list_t *hash_table;             /*!< MAC64 keyed hash index over active neighbors */
     uint32_t nud_threshold;                                 /*!< NUD threshold time which generates keep alive message */
+    uint16_t hash_bucket_count;                             /*!< Bucket count of hash index, power of two */
     uint8_t list_total_size;                                /*!< Total number allocated neighbor entries */
     uint8_t active_nud_process;                             /*!< Indicate Active NUD Process */
     uint8_t neighbour_list_size;                            /*!< Active Neighbor list size */
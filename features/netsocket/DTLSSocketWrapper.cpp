@@ -33,6 +33,16 @@ DTLSSocketWrapper::DTLSSocketWrapper(Socket *transport, const char *hostname, co
     mbedtls_ssl_set_timer_cb(get_ssl_context(), this, timing_set_delay, timing_get_delay);
 }
 
+void DTLSSocketWrapper::set_handshake_timeout(uint32_t min_ms, uint32_t max_ms)
+{
+#if defined(MBEDTLS_SSL_PROTO_DTLS)
+    mbedtls_ssl_conf_handshake_timeout(get_ssl_config(), min_ms, max_ms);
+#else
+    (void) min_ms;
+    (void) max_ms;
+#endif
+}
+
 void DTLSSocketWrapper::timing_set_delay(void *ctx, uint32_t int_ms, uint32_t fin_ms)
 {
     DTLSSocketWrapper *context = static_cast<DTLSSocketWrapper *>(ctx);
@@ -26,6 +26,20 @@
 class DTLSSocketWrapper : public TLSSocketWrapper {
 public:
     DTLSSocketWrapper(Socket *transport, const char *hostname = NULL, control_transport control = TRANSPORT_CONNECT_AND_CLOSE);
+
+    /** Set DTLS handshake retransmission timeouts
+     *
+     *  A short initial timeout speeds up handshakes on reliable low-latency
+     *  links, while lossy or high-latency links need a larger maximum to
+     *  avoid spurious retransmissions. Must be called before the handshake
+     *  is started. See mbedtls_ssl_conf_handshake_timeout() for the
+     *  retransmission plan derived from these values.
+     *
+     *  @param min_ms Initial retransmission timeout in milliseconds
+     *  @param max_ms Maximum retransmission timeout in milliseconds
+     */
+    void set_handshake_timeout(uint32_t min_ms, uint32_t max_ms);
+
 private:
     static void timing_set_delay(void *ctx, uint32_t int_ms, uint32_t fin_ms);
     static int timing_get_delay(void *ctx);
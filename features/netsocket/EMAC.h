@@ -55,6 +55,39 @@ public:
     //typedef void (*emac_link_state_change_fn)(void *data, bool up);
     typedef mbed::Callback<void (bool up)> emac_link_state_change_cb_t;
 
+    /**
+     * Checksum offload capability bits, reported by @a get_checksum_offload
+     */
+    enum {
+        CSUM_OFFLOAD_NONE       = 0,
+        CSUM_OFFLOAD_GEN_IP     = 0x0001, /**< Inserts IPv4 header checksum on transmit */
+        CSUM_OFFLOAD_GEN_UDP    = 0x0002, /**< Inserts UDP checksum on transmit */
+        CSUM_OFFLOAD_GEN_TCP    = 0x0004, /**< Inserts TCP checksum on transmit */
+        CSUM_OFFLOAD_GEN_ICMP   = 0x0008, /**< Inserts ICMP checksum on transmit */
+        CSUM_OFFLOAD_GEN_ICMP6  = 0x0010, /**< Inserts ICMPv6 checksum on transmit */
+        CSUM_OFFLOAD_CHECK_IP   = 0x0100, /**< Verifies IPv4 header checksum on receive */
+        CSUM_OFFLOAD_CHECK_UDP  = 0x0200, /**< Verifies UDP checksum on receive */
+        CSUM_OFFLOAD_CHECK_TCP  = 0x0400, /**< Verifies TCP checksum on receive */
+        CSUM_OFFLOAD_CHECK_ICMP = 0x0800, /**< Verifies ICMP checksum on receive */
+        CSUM_OFFLOAD_CHECK_ICMP6 = 0x1000 /**< Verifies ICMPv6 checksum on receive */
+    };
+
+    /**
+     * Return checksum offload capabilities of the device
+     *
+     * The IP stack skips software checksum generation and verification for
+     * the protocols the hardware covers. A driver reporting a CHECK
+     * capability must drop frames whose hardware-verified checksum failed
+     * instead of passing them to the link input callback. The default is no
+     * offload.
+     *
+     * @return     Bitmask of CSUM_OFFLOAD capability bits
+     */
+    virtual uint32_t get_checksum_offload() const
+    {
+        return CSUM_OFFLOAD_NONE;
+    }
+
     /**
      * Return maximum transmission unit
      *
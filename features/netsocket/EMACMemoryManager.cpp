@@ -14,6 +14,18 @@
  */
 
 #include "EMACMemoryManager.h"
+#include "platform/mbed_dma_buffer.h"
+#include "platform/mbed_dma_memcpy.h"
+
+emac_mem_buf_t *EMACMemoryManager::alloc_rx_buf(uint32_t size, uint32_t align)
+{
+    // Receive DMA needs a contiguous buffer, so the pool can only be used
+    // when the requested size fits in a single pool allocation unit
+    if (size <= get_pool_alloc_unit(align)) {
+        return alloc_pool(size, align);
+    }
+    return alloc_heap(size, align);
+}
 
 void EMACMemoryManager::copy_to_buf(emac_mem_buf_t *to_buf, const void *ptr, uint32_t len)
 {
@@ -28,7 +40,7 @@ void EMACMemoryManager::copy_to_buf(emac_mem_buf_t *to_buf, const void *ptr, uin
             len -= copy_to_len;
         }
 
-        memcpy(copy_to_ptr, ptr, copy_to_len);
+        mbed_dma_memcpy(copy_to_ptr, ptr, copy_to_len);
         ptr = static_cast<const uint8_t *>(ptr) + copy_to_len;
 
         to_buf = get_next(to_buf);
@@ -50,7 +62,7 @@ uint32_t EMACMemoryManager::copy_from_buf(void *ptr, uint32_t len, const emac_me
             len -= copy_from_len;
         }
 
-        memcpy(ptr, copy_from_ptr, copy_from_len);
+        mbed_dma_memcpy(ptr, copy_from_ptr, copy_from_len);
         ptr = static_cast<uint8_t *>(ptr) + copy_from_len;
         copied_len += copy_from_len;
 
@@ -60,3 +72,27 @@ uint32_t EMACMemoryManager::copy_from_buf(void *ptr, uint32_t len, const emac_me
     return copied_len;
 }
 
+
+void EMACMemoryManager::dma_tx_prepare(const emac_mem_buf_t *buf)
+{
+    while (buf) {
+        mbed_dma_buf_tx_prepare(get_ptr(buf), get_len(buf));
+        buf = get_next(buf);
+    }
+}
+
+void EMACMemoryManager::dma_rx_prepare(emac_mem_buf_t *buf)
+{
+    while (buf) {
+        mbed_dma_buf_rx_prepare(get_ptr(buf), get_len(buf));
+        buf = get_next(buf);
+    }
+}
+
+void EMACMemoryManager::dma_rx_complete(emac_mem_buf_t *buf)
+{
+    while (buf) {
+        mbed_dma_buf_rx_complete(get_ptr(buf), get_len(buf));
+        buf = get_next(buf);
+    }
+}
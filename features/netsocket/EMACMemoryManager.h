@@ -67,6 +67,26 @@ public:
      */
     virtual emac_mem_buf_t *alloc_pool(uint32_t size, uint32_t align) = 0;
 
+    /**
+     * Allocates a receive buffer for posting to DMA
+     *
+     * Allocates a single contiguous buffer that the emac can post directly as a
+     * receive DMA descriptor, so that received frames are handed up the stack
+     * in the buffer the hardware wrote them to, without an intermediate copy.
+     * The buffer is allocated from the pool if the (aligned) pool allocation
+     * unit is large enough, otherwise from the heap.
+     *
+     * On receive the emac should pass the filled buffer to the link input
+     * callback after adjusting its length, and post a freshly allocated
+     * replacement to the descriptor. If no replacement can be allocated the
+     * emac must re-post the original buffer and drop the frame.
+     *
+     * @param size     Size of the memory to allocate in bytes
+     * @param align    Memory alignment requirement in bytes
+     * @return         Allocated memory buffer, or NULL in case of error
+     */
+    virtual emac_mem_buf_t *alloc_rx_buf(uint32_t size, uint32_t align);
+
     /**
      * Get memory buffer pool allocation unit
      *
@@ -181,6 +201,44 @@ public:
      * @param len      Payload size, must be less or equal allocated size
      */
     virtual void set_len(emac_mem_buf_t *buf, uint32_t len) = 0;
+
+    /**
+     * Prepare a buffer chain for reading by transmit DMA
+     *
+     * Cleans the data cache for every buffer in the chain so the device
+     * sees the frame the CPU assembled. Call after filling the chain and
+     * before posting it to the transmit descriptors. On cores without a
+     * data cache this is a no-op.
+     *
+     * @param buf      Memory buffer chain the device will read
+     */
+    void dma_tx_prepare(const emac_mem_buf_t *buf);
+
+    /**
+     * Prepare a buffer chain for writing by receive DMA
+     *
+     * Cleans and invalidates the data cache for every buffer in the
+     * chain. Call before posting buffers from alloc_rx_buf to the receive
+     * descriptors. Each buffer must be cache-line aligned and sized, so
+     * request MBED_DMA_BUF_ALIGNMENT alignment from alloc_rx_buf. On
+     * cores without a data cache this is a no-op.
+     *
+     * @param buf      Memory buffer chain the device will write
+     */
+    void dma_rx_prepare(emac_mem_buf_t *buf);
+
+    /**
+     * Make a buffer chain written by receive DMA visible to the CPU
+     *
+     * Invalidates the data cache for every buffer in the chain. Call
+     * after the device reports the frame complete and before reading or
+     * passing the chain up the stack. The same alignment rules as for
+     * dma_rx_prepare apply. On cores without a data cache this is a
+     * no-op.
+     *
+     * @param buf      Memory buffer chain the device wrote
+     */
+    void dma_rx_complete(emac_mem_buf_t *buf);
 };
 
 #endif /* EMAC_MEMORY_MANAGER_H */
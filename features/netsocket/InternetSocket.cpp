@@ -16,14 +16,16 @@
 
 #include "device.h"
 #include "InternetSocket.h"
+#include "TrafficShaper.h"
 #include "platform/Callback.h"
+#include "mbed_assert.h"
 
 using namespace mbed;
 
 InternetSocket::InternetSocket()
     : _stack(0), _socket(0), _timeout(osWaitForever),
       _readers(0), _writers(0), _pending(0),
-      _factory_allocated(false)
+      _factory_allocated(false), _qos_class(0)
 {
     _socket_stats.stats_new_socket_entry(this);
 }
@@ -173,7 +175,18 @@ nsapi_error_t InternetSocket::setsockopt(int level, int optname, const void *opt
     _lock.lock();
     nsapi_error_t ret;
 
-    if (!_socket) {
+    if ((level == NSAPI_SOCKET) && (optname == NSAPI_QOS_CLASS)) {
+        // Handled in the socket layer - the QoS class steers the
+        // traffic shaper, the stack never sees it
+        if (optval && (optlen == sizeof(int)) &&
+                (*static_cast<const int *>(optval) >= 0) &&
+                (*static_cast<const int *>(optval) < NSAPI_QOS_CLASS_COUNT)) {
+            _qos_class = *static_cast<const int *>(optval);
+            ret = NSAPI_ERROR_OK;
+        } else {
+            ret = NSAPI_ERROR_PARAMETER;
+        }
+    } else if (!_socket) {
         ret = NSAPI_ERROR_NO_SOCKET;
     } else {
         ret = _stack->setsockopt(_socket, level, optname, optval, optlen);
@@ -188,7 +201,15 @@ nsapi_error_t InternetSocket::getsockopt(int level, int optname, void *optval, u
     _lock.lock();
     nsapi_error_t ret;
 
-    if (!_socket) {
+    if ((level == NSAPI_SOCKET) && (optname == NSAPI_QOS_CLASS)) {
+        if (optval && optlen && (*optlen >= sizeof(int))) {
+            *static_cast<int *>(optval) = _qos_class;
+            *optlen = sizeof(int);
+            ret = NSAPI_ERROR_OK;
+        } else {
+            ret = NSAPI_ERROR_PARAMETER;
+        }
+    } else if (!_socket) {
         ret = NSAPI_ERROR_NO_SOCKET;
     } else {
         ret = _stack->getsockopt(_socket, level, optname, optval, optlen);
@@ -198,6 +219,137 @@ nsapi_error_t InternetSocket::getsockopt(int level, int optname, void *optval, u
     return ret;
 
 }
+nsapi_size_or_error_t InternetSocket::sendmsg(const SocketAddress &address, const nsapi_iovec_t *iov, int iovcnt)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    _writers++;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        ret = _stack->socket_sendmsg(_socket, address, iov, iovcnt);
+        if ((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) {
+            _socket_stats.stats_update_sent_bytes(this, ret);
+            break;
+        } else {
+#ifdef MBED_CONF_RTOS_PRESENT
+            uint32_t flag;
+#endif
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+#ifdef MBED_CONF_RTOS_PRESENT
+            flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+#endif
+            _lock.lock();
+
+#ifdef MBED_CONF_RTOS_PRESENT
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+#endif
+        }
+    }
+
+    _writers--;
+    if (!_socket) {
+#ifdef MBED_CONF_RTOS_PRESENT
+        _event_flag.set(FINISHED_FLAG);
+#endif
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_size_or_error_t InternetSocket::sendmsg(const nsapi_iovec_t *iov, int iovcnt)
+{
+    if (!_remote_peer) {
+        return NSAPI_ERROR_NO_ADDRESS;
+    }
+    return sendmsg(_remote_peer, iov, iovcnt);
+}
+
+nsapi_size_or_error_t InternetSocket::recv_buffer(nsapi_buffer_t *buffer)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    // If this assert is hit then there are two threads
+    // performing a recv at the same time which is undefined
+    // behavior
+    MBED_ASSERT(_readers == 0);
+    _readers++;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        ret = _stack->socket_recv_buffer(_socket, buffer);
+        if ((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) {
+            _socket_stats.stats_update_recv_bytes(this, ret);
+            break;
+        } else {
+#ifdef MBED_CONF_RTOS_PRESENT
+            uint32_t flag;
+#endif
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+#ifdef MBED_CONF_RTOS_PRESENT
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+#endif
+            _lock.lock();
+
+#ifdef MBED_CONF_RTOS_PRESENT
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+#endif
+        }
+    }
+
+    _readers--;
+    if (!_socket) {
+#ifdef MBED_CONF_RTOS_PRESENT
+        _event_flag.set(FINISHED_FLAG);
+#endif
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_error_t InternetSocket::release_recv_buffer(const nsapi_buffer_t *buffer)
+{
+    _lock.lock();
+    nsapi_error_t ret;
+
+    if (!_socket) {
+        ret = NSAPI_ERROR_NO_SOCKET;
+    } else {
+        ret = _stack->socket_release_buffer(_socket, buffer);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
 void InternetSocket::event()
 {
 
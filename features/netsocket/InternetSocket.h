@@ -116,6 +116,44 @@ public:
      */
     virtual nsapi_error_t getsockopt(int level, int optname, void *optval, unsigned *optlen);
 
+    /** Send a message assembled from several buffers.
+     *
+     *  Vectored variant of Socket::sendto. The elements of iov are sent
+     *  back to back as one message - one datagram on connectionless
+     *  sockets, one contiguous byte sequence on stream sockets - without
+     *  first being gathered into a scratch buffer.
+     *
+     *  Like POSIX sendmsg, a stream socket may send only part of the
+     *  message; the return value counts bytes consumed across the vector
+     *  in order.
+     *
+     *  @param address  Remote address, ignored on connected stream sockets
+     *  @param iov      Array of buffers making up the message
+     *  @param iovcnt   Number of elements in iov
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t sendmsg(const SocketAddress &address, const nsapi_iovec_t *iov, int iovcnt);
+
+    /** Send a message assembled from several buffers to the connected peer.
+     *
+     *  @see InternetSocket::sendmsg
+     *
+     *  @param iov      Array of buffers making up the message
+     *  @param iovcnt   Number of elements in iov
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t sendmsg(const nsapi_iovec_t *iov, int iovcnt);
+
+    /** @copydoc Socket::recv_buffer
+     */
+    virtual nsapi_size_or_error_t recv_buffer(nsapi_buffer_t *buffer);
+
+    /** @copydoc Socket::release_recv_buffer
+     */
+    virtual nsapi_error_t release_recv_buffer(const nsapi_buffer_t *buffer);
+
     /** @copydoc Socket::sigio
      */
     virtual void sigio(mbed::Callback<void()> func);
@@ -174,6 +212,7 @@ protected:
     uint8_t _writers;
     volatile unsigned _pending;
     bool _factory_allocated;
+    uint8_t _qos_class;
 
     // Event flags
     static const int READ_FLAG     = 0x1u;
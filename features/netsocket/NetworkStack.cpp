@@ -112,6 +112,37 @@ nsapi_error_t NetworkStack::getstackopt(int level, int optname, void *optval, un
     return NSAPI_ERROR_UNSUPPORTED;
 }
 
+nsapi_size_or_error_t NetworkStack::socket_sendmsg(nsapi_socket_t handle, const SocketAddress &address,
+                                                   const nsapi_iovec_t *iov, int iovcnt)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recv_buffer(nsapi_socket_t handle, nsapi_buffer_t *buffer)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_error_t NetworkStack::socket_release_buffer(nsapi_socket_t handle, const nsapi_buffer_t *buffer)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_error_t NetworkStack::socket_acquire_tx_buffer(nsapi_socket_t handle, nsapi_size_t size, nsapi_buffer_t *buffer)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_send_tx_buffer(nsapi_socket_t handle, const SocketAddress &address, const nsapi_buffer_t *buffer, nsapi_size_t size)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_error_t NetworkStack::socket_release_tx_buffer(nsapi_socket_t handle, const nsapi_buffer_t *buffer)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
 nsapi_error_t NetworkStack::setsockopt(void *handle, int level, int optname, const void *optval, unsigned optlen)
 {
     return NSAPI_ERROR_UNSUPPORTED;
@@ -285,6 +285,82 @@ protected:
     virtual nsapi_size_or_error_t socket_recv(nsapi_socket_t handle,
                                               void *data, nsapi_size_t size) = 0;
 
+    /** Receive data over a socket without copying
+     *
+     *  Zero-copy variant of socket_recv. On success, buffer describes one
+     *  contiguous fragment of the stack's own receive buffer. The fragment
+     *  remains valid until it is handed back with socket_release_buffer.
+     *
+     *  This call is non-blocking. If recv would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  The default implementation returns NSAPI_ERROR_UNSUPPORTED. Stacks
+     *  that can expose their receive buffers override it.
+     *
+     *  @param handle   Socket handle
+     *  @param buffer   Destination for the description of the received fragment
+     *  @return         Length of the fragment on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recv_buffer(nsapi_socket_t handle,
+                                                     nsapi_buffer_t *buffer);
+
+    /** Release a buffer acquired with socket_recv_buffer
+     *
+     *  Marks the fragment as consumed so the stack can free the underlying
+     *  buffer once all of its fragments have been released.
+     *
+     *  @param handle   Socket handle
+     *  @param buffer   Fragment previously filled in by socket_recv_buffer
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t socket_release_buffer(nsapi_socket_t handle,
+                                                const nsapi_buffer_t *buffer);
+
+    /** Acquire a transmit buffer from the stack
+     *
+     *  Leases one of the stack's own transmit buffers to the caller, who
+     *  fills it in place and commits it with socket_send_tx_buffer - the
+     *  transmit-side counterpart of socket_recv_buffer, removing the
+     *  per-packet copy from the send path. A lease not committed must be
+     *  handed back with socket_release_tx_buffer.
+     *
+     *  The default implementation returns NSAPI_ERROR_UNSUPPORTED. Stacks
+     *  that can lease their transmit buffers override it.
+     *
+     *  @param handle   Socket handle
+     *  @param size     Requested payload capacity in bytes
+     *  @param buffer   Destination for the description of the leased buffer
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t socket_acquire_tx_buffer(nsapi_socket_t handle, nsapi_size_t size,
+                                                   nsapi_buffer_t *buffer);
+
+    /** Send a buffer acquired with socket_acquire_tx_buffer
+     *
+     *  Transmits the leased buffer's contents to the specified address
+     *  without copying. The lease is consumed whatever the outcome - the
+     *  buffer must not be accessed or released afterwards.
+     *
+     *  @param handle   Socket handle
+     *  @param address  The SocketAddress of the remote host
+     *  @param buffer   Buffer previously filled in by socket_acquire_tx_buffer
+     *  @param size     Number of bytes to send, at most the leased capacity
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_send_tx_buffer(nsapi_socket_t handle, const SocketAddress &address,
+                                                        const nsapi_buffer_t *buffer, nsapi_size_t size);
+
+    /** Release an unsent buffer acquired with socket_acquire_tx_buffer
+     *
+     *  @param handle   Socket handle
+     *  @param buffer   Buffer previously filled in by socket_acquire_tx_buffer
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t socket_release_tx_buffer(nsapi_socket_t handle,
+                                                   const nsapi_buffer_t *buffer);
+
     /** Send a packet over a UDP socket
      *
      *  Sends data to the specified address. Returns the number of bytes
@@ -303,6 +379,29 @@ protected:
     virtual nsapi_size_or_error_t socket_sendto(nsapi_socket_t handle, const SocketAddress &address,
                                                 const void *data, nsapi_size_t size) = 0;
 
+    /** Send a message assembled from several buffers
+     *
+     *  Vectored variant of socket_sendto. The elements of iov are sent
+     *  back to back as one message - one datagram on connectionless
+     *  sockets, one contiguous byte sequence on stream sockets. The
+     *  address is ignored on connected stream sockets.
+     *
+     *  This call is non-blocking. If sendmsg would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  The default implementation returns NSAPI_ERROR_UNSUPPORTED. Stacks
+     *  that can gather buffers on the way down override it.
+     *
+     *  @param handle   Socket handle
+     *  @param address  The SocketAddress of the remote host
+     *  @param iov      Array of buffers making up the message
+     *  @param iovcnt   Number of elements in iov
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_sendmsg(nsapi_socket_t handle, const SocketAddress &address,
+                                                 const nsapi_iovec_t *iov, int iovcnt);
+
     /** Receive a packet over a UDP socket
      *
      *  Receives data and stores the source address in address if address
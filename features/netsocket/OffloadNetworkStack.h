@@ -0,0 +1,74 @@
+/* mbed OS IP stack API
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_OFFLOAD_NETWORK_STACK_H
+#define MBED_OFFLOAD_NETWORK_STACK_H
+
+#include "nsapi.h"
+
+#include "NetworkStack.h"
+
+/**
+ * mbed OS API for network stacks terminated on an external module
+ *
+ * Sibling of OnboardNetworkStack for modules (ESP32, WINC1500, cellular
+ * modems and similar) that run TCP - and possibly TLS - on the module
+ * itself. An offload stack does not register EMAC interfaces or run an
+ * onboard IP stack: each NetworkStack socket_* call maps onto a bulk
+ * module command, so products built on such modules carry neither lwIP
+ * nor mbedtls.
+ *
+ * Contract for implementations, beyond the base NetworkStack semantics:
+ *
+ * - socket_connect() opens the connection on the module; socket_send()
+ *   and socket_recv() transfer whole payloads per transport command
+ *   rather than byte-by-byte. The caller's buffer is handed directly to
+ *   the transport for the duration of the call, so implementations may
+ *   DMA from/to it without an intermediate copy - callers must not pass
+ *   buffers that the transport cannot reach (for example, flash-resident
+ *   data on targets whose DMA controllers cannot read flash).
+ *
+ * - Implementations able to gather multi-part datagrams in one module
+ *   command should override socket_sendmsg(); those able to expose the
+ *   module's receive windows without copying should override
+ *   socket_recv_buffer()/socket_release_buffer().
+ *
+ * - Stacks that terminate TLS on the module report it through
+ *   is_tls_supported() and accept the NSAPI_TLSSOCKET_LEVEL socket
+ *   options (see nsapi_tlssocket_level_option_t): certificates, keys and
+ *   the peer hostname are configured with setsockopt() on an open,
+ *   unconnected socket, NSAPI_TLSSOCKET_ENABLE arms TLS, and the
+ *   following socket_connect() performs the handshake on the module.
+ */
+class OffloadNetworkStack : public NetworkStack {
+public:
+
+    /** Check whether this stack terminates TLS on the module
+     *
+     *  When true, sockets opened on this stack accept the
+     *  NSAPI_TLSSOCKET_LEVEL options, and TLS-capable socket classes can
+     *  delegate the handshake and record protection to the module
+     *  instead of instantiating mbedtls.
+     *
+     *  @return         True if the module offers on-module TLS sockets
+     */
+    virtual bool is_tls_supported() const
+    {
+        return false;
+    }
+};
+
+#endif /* MBED_OFFLOAD_NETWORK_STACK_H */
@@ -119,6 +119,54 @@ public:
          * @return              Pointer to a buffer, or NULL if the buffer is too small
          */
         virtual char *get_gateway(char *buf, nsapi_size_t buflen) = 0;
+
+        /** Snapshot the interface's network state for retention across deep sleep
+         *
+         * Serializes the state needed to resume networking without a full
+         * reattach - IP configuration, the DHCP lease and its timers, and
+         * resolved neighbour addresses - into a caller-supplied buffer that
+         * can be kept in retained RAM or a kvstore while the system deep
+         * sleeps. TCP connections are not retained; peers needing session
+         * continuity across sleep should use application-level resumption.
+         *
+         * Call while the interface is connected, immediately before sleep.
+         * If @a buf is NULL or @a size is too small, the required size is
+         * stored in @a size and NSAPI_ERROR_NO_MEMORY returned.
+         *
+         * @param         buf   Destination buffer for the snapshot, or NULL to query size
+         * @param[in,out] size  In: size of buf in bytes; out: bytes used or required
+         * @return              NSAPI_ERROR_OK on success, NSAPI_ERROR_UNSUPPORTED if the
+         *                      stack cannot snapshot this interface, or error code
+         */
+        virtual nsapi_error_t snapshot(void *buf, nsapi_size_t *size)
+        {
+            (void) buf;
+            (void) size;
+            return NSAPI_ERROR_UNSUPPORTED;
+        }
+
+        /** Restore network state captured by snapshot() after waking
+         *
+         * Re-applies the serialized state so the interface is usable without
+         * waiting out address acquisition: addresses are installed
+         * immediately and a retained DHCP lease is confirmed with the server
+         * in the background, falling back to normal acquisition if the
+         * server declines it. Call after initiating bringup(), once the link
+         * is up; a snapshot that does not match this interface (different
+         * hardware address, layout version or stack) is rejected with
+         * NSAPI_ERROR_PARAMETER and normal bringup proceeds unaffected.
+         *
+         * @param buf   Buffer previously filled by snapshot()
+         * @param size  Size of the snapshot in bytes
+         * @return      NSAPI_ERROR_OK on success, NSAPI_ERROR_UNSUPPORTED if the
+         *              stack cannot restore this interface, or error code
+         */
+        virtual nsapi_error_t restore(const void *buf, nsapi_size_t size)
+        {
+            (void) buf;
+            (void) size;
+            return NSAPI_ERROR_UNSUPPORTED;
+        }
     };
 
     /** Register a network interface with the IP stack
@@ -0,0 +1,224 @@
+/* Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RawEthernet.h"
+
+#include <string.h>
+
+#define ETH_HEADER_LEN      14
+#define ETH_ETHERTYPE_OFF   12
+
+#define RING_SIZE           MBED_CONF_NSAPI_RAW_ETHERNET_FRAME_RING_SIZE
+
+RawEthernet::RawEthernet(EMAC &emac, EMACMemoryManager &mem_mngr) :
+    _emac(emac), _mem(mem_mngr), _frame_cb(), _num_filters(0), _powered(false),
+    _link_up(false), _dropped(0), _head(0), _tail(0)
+{
+    memset(_ethertypes, 0, sizeof(_ethertypes));
+    memset(_ring, 0, sizeof(_ring));
+}
+
+RawEthernet::~RawEthernet()
+{
+    power_down();
+}
+
+nsapi_error_t RawEthernet::power_up()
+{
+    if (_powered) {
+        return NSAPI_ERROR_OK;
+    }
+
+    _dropped = 0;
+
+    _emac.set_memory_manager(_mem);
+    _emac.set_link_input_cb(mbed::callback(this, &RawEthernet::link_input_handler));
+    _emac.set_link_state_cb(mbed::callback(this, &RawEthernet::link_state_handler));
+
+    if (!_emac.power_up()) {
+        return NSAPI_ERROR_DEVICE_ERROR;
+    }
+
+    _powered = true;
+    return NSAPI_ERROR_OK;
+}
+
+void RawEthernet::power_down()
+{
+    if (!_powered) {
+        return;
+    }
+
+    _emac.power_down();
+    _powered = false;
+    _link_up = false;
+
+    // The producer is stopped now, so the ring can be drained in place
+    emac_mem_buf_t *frame;
+    while ((frame = receive_frame()) != NULL) {
+        _mem.free(frame);
+    }
+}
+
+nsapi_error_t RawEthernet::add_ethertype_filter(uint16_t ethertype)
+{
+    if (_num_filters >= RAW_ETHERNET_MAX_FILTERS) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    _ethertypes[_num_filters] = ethertype;
+    _num_filters++;
+    return NSAPI_ERROR_OK;
+}
+
+void RawEthernet::remove_ethertype_filter(uint16_t ethertype)
+{
+    for (uint8_t i = 0; i < _num_filters; i++) {
+        if (_ethertypes[i] == ethertype) {
+            _ethertypes[i] = _ethertypes[_num_filters - 1];
+            _num_filters--;
+            return;
+        }
+    }
+}
+
+bool RawEthernet::frame_wanted(const emac_mem_buf_t *buf) const
+{
+    if (_num_filters == 0) {
+        return true;
+    }
+
+    if (_mem.get_len(buf) < ETH_HEADER_LEN) {
+        return false;
+    }
+
+    const uint8_t *frame = static_cast<const uint8_t *>(_mem.get_ptr(buf));
+    uint16_t ethertype = (frame[ETH_ETHERTYPE_OFF] << 8) | frame[ETH_ETHERTYPE_OFF + 1];
+
+    for (uint8_t i = 0; i < _num_filters; i++) {
+        if (_ethertypes[i] == ethertype) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void RawEthernet::link_input_handler(emac_mem_buf_t *buf)
+{
+    if (!frame_wanted(buf)) {
+        _mem.free(buf);
+        return;
+    }
+
+    uint32_t head = _head;
+    uint32_t next = (head + 1) % RING_SIZE;
+
+    if (next == _tail) {
+        // Ring full - the reader is not keeping up, shed the frame here
+        // rather than stalling the driver
+        _dropped++;
+        _mem.free(buf);
+        return;
+    }
+
+    // Publish the frame before moving the head so the reader never sees
+    // an unwritten slot
+    _ring[head] = buf;
+    _head = next;
+
+    if (_frame_cb) {
+        _frame_cb();
+    }
+}
+
+void RawEthernet::link_state_handler(bool up)
+{
+    _link_up = up;
+}
+
+emac_mem_buf_t *RawEthernet::receive_frame()
+{
+    uint32_t tail = _tail;
+
+    if (tail == _head) {
+        return NULL;
+    }
+
+    emac_mem_buf_t *frame = _ring[tail];
+    _tail = (tail + 1) % RING_SIZE;
+    return frame;
+}
+
+void RawEthernet::release_frame(emac_mem_buf_t *frame)
+{
+    if (frame) {
+        _mem.free(frame);
+    }
+}
+
+void *RawEthernet::frame_ptr(const emac_mem_buf_t *frame) const
+{
+    return _mem.get_ptr(frame);
+}
+
+uint32_t RawEthernet::frame_len(const emac_mem_buf_t *frame) const
+{
+    return _mem.get_len(frame);
+}
+
+emac_mem_buf_t *RawEthernet::frame_next(const emac_mem_buf_t *frame) const
+{
+    return _mem.get_next(frame);
+}
+
+emac_mem_buf_t *RawEthernet::alloc_frame(uint32_t size)
+{
+    return _mem.alloc_pool(size, _emac.get_align_preference());
+}
+
+nsapi_error_t RawEthernet::send_frame(emac_mem_buf_t *frame)
+{
+    if (!frame) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    if (!_powered) {
+        _mem.free(frame);
+        return NSAPI_ERROR_DEVICE_ERROR;
+    }
+
+    // link_out takes ownership of the buffer whatever the outcome
+    if (!_emac.link_out(frame)) {
+        return NSAPI_ERROR_DEVICE_ERROR;
+    }
+
+    return NSAPI_ERROR_OK;
+}
+
+void RawEthernet::set_frame_cb(mbed::Callback<void()> cb)
+{
+    _frame_cb = cb;
+}
+
+bool RawEthernet::get_link_state() const
+{
+    return _link_up;
+}
+
+uint32_t RawEthernet::get_dropped_count() const
+{
+    return _dropped;
+}
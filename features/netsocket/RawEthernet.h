@@ -0,0 +1,206 @@
+/* Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RAW_ETHERNET_H
+#define RAW_ETHERNET_H
+
+#include "EMAC.h"
+#include "netsocket/nsapi_types.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+
+#ifndef MBED_CONF_NSAPI_RAW_ETHERNET_FRAME_RING_SIZE
+#define MBED_CONF_NSAPI_RAW_ETHERNET_FRAME_RING_SIZE 8
+#endif
+
+/** Maximum number of EtherType filters that can be registered at a time */
+#define RAW_ETHERNET_MAX_FILTERS 4
+
+/** Raw Ethernet frame access on top of the EMAC API.
+ *
+ * Successor of the legacy mbed::Ethernet class for targets with an EMAC
+ * driver. Received frames are handed up in the buffers the hardware wrote
+ * them to - obtained from the EMAC memory manager, never copied - and queued
+ * on a lock-free single-producer single-consumer ring between the driver's
+ * link input context and the application. The application reads a frame with
+ * receive_frame(), inspects it in place through frame_ptr()/frame_len() and
+ * hands the buffer back with release_frame().
+ *
+ * Frames can be filtered by EtherType so that only the protocols of interest
+ * cross the ring; everything else is freed in the driver context. With no
+ * filters registered all frames are delivered.
+ *
+ * The class drives the EMAC directly and therefore cannot be used on an EMAC
+ * that is attached to an IP stack. The memory manager is supplied by the
+ * caller, keeping this class independent of any particular stack's buffer
+ * scheme.
+ *
+ * @note Synchronization level: Thread safe for one reader and the driver's
+ *       input context. receive_frame()/release_frame() must not be called
+ *       from more than one thread at a time.
+ */
+class RawEthernet : private mbed::NonCopyable<RawEthernet> {
+public:
+    /** Construct a raw Ethernet interface on an EMAC device.
+     *
+     *  @param emac      EMAC device to drive. Must not be in use by an IP stack.
+     *  @param mem_mngr  Memory manager providing the frame buffers.
+     */
+    RawEthernet(EMAC &emac, EMACMemoryManager &mem_mngr);
+
+    /** Destroy the interface.
+     *
+     *  Powers the EMAC down if it is still up and frees any queued frames.
+     */
+    ~RawEthernet();
+
+    /** Power the EMAC up and start receiving frames.
+     *
+     *  @return NSAPI_ERROR_OK on success, NSAPI_ERROR_DEVICE_ERROR if the
+     *          hardware could not be initialized.
+     */
+    nsapi_error_t power_up();
+
+    /** Power the EMAC down.
+     *
+     *  Frames still queued on the ring are freed.
+     */
+    void power_down();
+
+    /** Deliver only frames carrying one of the registered EtherTypes.
+     *
+     *  Frames that match no registered filter are freed in the driver
+     *  context and never cross the ring. With no filters registered, all
+     *  frames are delivered. Register filters before calling power_up().
+     *
+     *  @param ethertype EtherType in host byte order, e.g. 0x88F7 for PTP.
+     *  @return          NSAPI_ERROR_OK on success, NSAPI_ERROR_NO_MEMORY if
+     *                   RAW_ETHERNET_MAX_FILTERS filters are already registered.
+     */
+    nsapi_error_t add_ethertype_filter(uint16_t ethertype);
+
+    /** Remove a previously registered EtherType filter.
+     *
+     *  @param ethertype EtherType in host byte order.
+     */
+    void remove_ethertype_filter(uint16_t ethertype);
+
+    /** Take the oldest received frame off the ring.
+     *
+     *  The returned buffer is the one the hardware wrote the frame to; no
+     *  copy has taken place. The caller owns it and must hand it back with
+     *  release_frame().
+     *
+     *  @return A received frame, or NULL if the ring is empty.
+     */
+    emac_mem_buf_t *receive_frame();
+
+    /** Hand a frame taken with receive_frame() back to the memory manager.
+     *
+     *  @param frame Frame to free.
+     */
+    void release_frame(emac_mem_buf_t *frame);
+
+    /** Return a pointer to the frame payload, starting at the destination address.
+     *
+     *  Valid for the first (or only) buffer of the frame; use frame_next()
+     *  to walk the remainder of a chained frame.
+     *
+     *  @param frame Frame buffer.
+     *  @return      Pointer to the payload.
+     */
+    void *frame_ptr(const emac_mem_buf_t *frame) const;
+
+    /** Return the payload length of a frame buffer.
+     *
+     *  @param frame Frame buffer.
+     *  @return      Length in bytes of this buffer, excluding any chained buffers.
+     */
+    uint32_t frame_len(const emac_mem_buf_t *frame) const;
+
+    /** Return the next buffer of a chained frame.
+     *
+     *  @param frame Frame buffer.
+     *  @return      The next buffer, or NULL if this is the last one.
+     */
+    emac_mem_buf_t *frame_next(const emac_mem_buf_t *frame) const;
+
+    /** Allocate a frame buffer for transmission.
+     *
+     *  The buffer is allocated from the memory manager with the EMAC's
+     *  preferred alignment, so it can be handed to send_frame() without an
+     *  intermediate copy. Fill it through frame_ptr().
+     *
+     *  @param size Frame size in bytes, including the Ethernet header.
+     *  @return     An allocated frame, or NULL if out of memory.
+     */
+    emac_mem_buf_t *alloc_frame(uint32_t size);
+
+    /** Send a frame.
+     *
+     *  Ownership of the buffer passes to the driver whatever the outcome -
+     *  it must not be accessed or released afterwards.
+     *
+     *  @param frame Frame allocated with alloc_frame() and filled in by the caller.
+     *  @return      NSAPI_ERROR_OK on success, NSAPI_ERROR_DEVICE_ERROR if
+     *               the driver rejected the frame.
+     */
+    nsapi_error_t send_frame(emac_mem_buf_t *frame);
+
+    /** Register a callback to be called when a frame is queued on the ring.
+     *
+     *  The callback may be called from interrupt context and must not block;
+     *  typically it signals the thread that calls receive_frame().
+     *
+     *  @param cb Callback, or a default-constructed Callback to detach.
+     */
+    void set_frame_cb(mbed::Callback<void()> cb);
+
+    /** Return the link state.
+     *
+     *  @return true if the Ethernet link is up.
+     */
+    bool get_link_state() const;
+
+    /** Return the number of frames dropped because the ring was full.
+     *
+     *  @return Dropped frame count since power up.
+     */
+    uint32_t get_dropped_count() const;
+
+private:
+    void link_input_handler(emac_mem_buf_t *buf);
+    void link_state_handler(bool up);
+    bool frame_wanted(const emac_mem_buf_t *buf) const;
+
+    EMAC &_emac;
+    EMACMemoryManager &_mem;
+    mbed::Callback<void()> _frame_cb;
+
+    uint16_t _ethertypes[RAW_ETHERNET_MAX_FILTERS];
+    uint8_t _num_filters;
+    bool _powered;
+    volatile bool _link_up;
+    volatile uint32_t _dropped;
+
+    /* Single-producer single-consumer ring: the driver's input context
+     * writes _head, the reader writes _tail, so no locking is needed as
+     * long as the indices are read and written whole */
+    emac_mem_buf_t *_ring[MBED_CONF_NSAPI_RAW_ETHERNET_FRAME_RING_SIZE];
+    volatile uint32_t _head;
+    volatile uint32_t _tail;
+};
+
+#endif /* RAW_ETHERNET_H */
@@ -142,6 +142,49 @@ public:
     virtual nsapi_size_or_error_t recvfrom(SocketAddress *address,
                                            void *data, nsapi_size_t size) = 0;
 
+    /** Receive data from a socket without copying.
+     *
+     *  Exposes the network stack's own receive buffer instead of copying
+     *  its contents into a caller-supplied buffer. On success, buffer
+     *  describes one contiguous fragment of received data, which remains
+     *  valid until it is handed back with release_recv_buffer(). A payload
+     *  spanning several of the stack's internal buffers is delivered as a
+     *  sequence of fragments; each fragment must be released before the
+     *  next one is acquired.
+     *
+     *  By default, recv_buffer blocks until some data is received. If socket
+     *  is set to non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK can be
+     *  returned to indicate no data.
+     *
+     *  Stacks that cannot expose their internal buffers return
+     *  NSAPI_ERROR_UNSUPPORTED, in which case the caller should fall back
+     *  to recv().
+     *
+     *  @param buffer   Destination for the description of the received fragment
+     *  @return         Length of the fragment on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t recv_buffer(nsapi_buffer_t *buffer)
+    {
+        (void)buffer;
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    /** Release a buffer acquired with recv_buffer().
+     *
+     *  Marks the fragment as consumed, allowing the stack to free the
+     *  underlying buffer once all of its fragments have been released.
+     *  The data described by the view must not be accessed afterwards.
+     *
+     *  @param buffer   Fragment previously filled in by recv_buffer()
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t release_recv_buffer(const nsapi_buffer_t *buffer)
+    {
+        (void)buffer;
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
     /** Bind a specific address to a socket.
      *
      *  Binding a socket specifies the address and port on which to receive
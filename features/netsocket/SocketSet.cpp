@@ -0,0 +1,129 @@
+/* SocketSet
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SocketSet.h"
+
+#ifdef MBED_CONF_RTOS_PRESENT
+
+void SocketSet::slot_t::event()
+{
+    set->_flags.set(flag);
+}
+
+SocketSet::SocketSet()
+{
+    for (int i = 0; i < MBED_CONF_NSAPI_SOCKET_SET_MAX_SOCKETS; i++) {
+        _slots[i].set = this;
+        _slots[i].socket = NULL;
+        _slots[i].flag = 1UL << i;
+    }
+}
+
+SocketSet::~SocketSet()
+{
+    for (int i = 0; i < MBED_CONF_NSAPI_SOCKET_SET_MAX_SOCKETS; i++) {
+        if (_slots[i].socket) {
+            _slots[i].socket->sigio(NULL);
+        }
+    }
+}
+
+nsapi_error_t SocketSet::add(Socket *socket)
+{
+    if (socket == NULL) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    _lock.lock();
+
+    int free_slot = -1;
+    for (int i = 0; i < MBED_CONF_NSAPI_SOCKET_SET_MAX_SOCKETS; i++) {
+        if (_slots[i].socket == socket) {
+            _lock.unlock();
+            return NSAPI_ERROR_PARAMETER;
+        }
+        if (_slots[i].socket == NULL && free_slot < 0) {
+            free_slot = i;
+        }
+    }
+
+    if (free_slot < 0) {
+        _lock.unlock();
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    _slots[free_slot].socket = socket;
+    socket->sigio(mbed::callback(&_slots[free_slot], &slot_t::event));
+
+    _lock.unlock();
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t SocketSet::remove(Socket *socket)
+{
+    _lock.lock();
+
+    for (int i = 0; i < MBED_CONF_NSAPI_SOCKET_SET_MAX_SOCKETS; i++) {
+        if (_slots[i].socket != socket) {
+            continue;
+        }
+
+        socket->sigio(NULL);
+        _slots[i].socket = NULL;
+        _flags.clear(_slots[i].flag);
+
+        _lock.unlock();
+        return NSAPI_ERROR_OK;
+    }
+
+    _lock.unlock();
+    return NSAPI_ERROR_NO_SOCKET;
+}
+
+int SocketSet::wait(Socket **ready, int size, uint32_t millisec)
+{
+    uint32_t mask = 0;
+
+    _lock.lock();
+    for (int i = 0; i < MBED_CONF_NSAPI_SOCKET_SET_MAX_SOCKETS; i++) {
+        if (_slots[i].socket) {
+            mask |= _slots[i].flag;
+        }
+    }
+    _lock.unlock();
+
+    if (mask == 0) {
+        return 0;
+    }
+
+    uint32_t flags = _flags.wait_any(mask, millisec);
+    if (flags & osFlagsError) {
+        return 0;
+    }
+
+    int count = 0;
+    _lock.lock();
+    for (int i = 0; i < MBED_CONF_NSAPI_SOCKET_SET_MAX_SOCKETS && count < size; i++) {
+        if ((flags & _slots[i].flag) && _slots[i].socket) {
+            ready[count++] = _slots[i].socket;
+        }
+    }
+    _lock.unlock();
+
+    return count;
+}
+
+#endif // MBED_CONF_RTOS_PRESENT
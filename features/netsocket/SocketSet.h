@@ -0,0 +1,105 @@
+
+/** \addtogroup netsocket */
+/** @{*/
+/* SocketSet
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SOCKETSET_H
+#define SOCKETSET_H
+
+#include "netsocket/Socket.h"
+#ifdef MBED_CONF_RTOS_PRESENT
+
+#include "rtos/EventFlags.h"
+#include "PlatformMutex.h"
+
+/** Event multiplexer over a set of sockets.
+ *
+ *  Collapses one-thread-per-socket designs into a single event loop:
+ *  register sockets once, then block on wait until any of them signals
+ *  an event. Each registered socket's sigio is routed into one shared
+ *  EventFlags, so a wait costs one flag wait regardless of how many
+ *  sockets are in the set.
+ *
+ *  Socket events do not carry a direction, so wait reports which
+ *  sockets signaled and the caller probes them with non-blocking
+ *  operations - the same edge-triggered pattern sigio callers use
+ *  today, minus the per-socket threads or callbacks. Events that fired
+ *  before a socket was added are not seen; probe a socket once after
+ *  adding it.
+ *
+ *  Adding a socket takes over its sigio callback; removing it or
+ *  destroying the set restores no callback.
+ */
+class SocketSet {
+public:
+    SocketSet();
+
+    /** Destroy the set, unregistering all sockets.
+     */
+    ~SocketSet();
+
+    /** Add a socket to the set.
+     *
+     *  @param socket   Socket to add.
+     *  @return         NSAPI_ERROR_OK on success,
+     *                  NSAPI_ERROR_PARAMETER if socket is NULL or already added,
+     *                  NSAPI_ERROR_NO_MEMORY if the set is full.
+     */
+    nsapi_error_t add(Socket *socket);
+
+    /** Remove a socket from the set.
+     *
+     *  Clears the socket's sigio callback and any pending event.
+     *
+     *  @param socket   Socket to remove.
+     *  @return         NSAPI_ERROR_OK on success,
+     *                  NSAPI_ERROR_NO_SOCKET if the socket is not in the set.
+     */
+    nsapi_error_t remove(Socket *socket);
+
+    /** Wait until any socket in the set signals an event.
+     *
+     *  Returns every socket that signaled since it was last reported,
+     *  clearing their pending events.
+     *
+     *  @param ready    Array filled with the sockets that signaled.
+     *  @param size     Capacity of the ready array.
+     *  @param millisec Timeout in milliseconds, osWaitForever to block
+     *                  indefinitely.
+     *  @return         Number of sockets written to ready, 0 on timeout
+     *                  or if the set is empty.
+     */
+    int wait(Socket **ready, int size, uint32_t millisec = osWaitForever);
+
+private:
+    // One registered socket, routes its sigio into the shared flags
+    struct slot_t {
+        SocketSet *set;
+        Socket *socket;
+        uint32_t flag;
+        void event();
+    };
+
+    slot_t _slots[MBED_CONF_NSAPI_SOCKET_SET_MAX_SOCKETS];
+    rtos::EventFlags _flags;
+    PlatformMutex _lock;
+};
+
+#endif // MBED_CONF_RTOS_PRESENT
+#endif // SOCKETSET_H
+
+/** @}*/
@@ -17,6 +17,7 @@
 #include "SocketStats.h"
 #include "platform/mbed_error.h"
 #include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
 #ifdef MBED_CONF_RTOS_PRESENT
 #include "rtos/Kernel.h"
 #endif
@@ -27,7 +28,9 @@
 #if MBED_CONF_NSAPI_SOCKET_STATS_ENABLE
 SingletonPtr<PlatformMutex> SocketStats::_mutex;
 mbed_stats_socket_t SocketStats::_stats[MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT];
+mbed_stats_socket_event_t SocketStats::_events[MBED_CONF_NSAPI_SOCKET_STATS_EVENT_LOG_SIZE];
 uint32_t SocketStats::_size = 0;
+uint32_t SocketStats::_event_count = 0;
 
 int SocketStats::get_entry_position(const Socket *const reference_id)
 {
@@ -38,6 +41,17 @@ int SocketStats::get_entry_position(const Socket *const reference_id)
     }
     return -1;
 }
+
+void SocketStats::log_socket_event(const Socket *const reference_id, socket_state state)
+{
+    uint32_t index = core_util_atomic_incr_u32(&_event_count, 1) - 1;
+    mbed_stats_socket_event_t *entry = &_events[index % MBED_CONF_NSAPI_SOCKET_STATS_EVENT_LOG_SIZE];
+    entry->reference_id = (Socket *)reference_id;
+    entry->state = state;
+#ifdef MBED_CONF_RTOS_PRESENT
+    entry->tick = rtos::Kernel::get_ms_count();
+#endif
+}
 #endif
 
 size_t SocketStats::mbed_stats_socket_get_each(mbed_stats_socket_t *stats, size_t count)
@@ -58,6 +72,26 @@ size_t SocketStats::mbed_stats_socket_get_each(mbed_stats_socket_t *stats, size_
     return i;
 }
 
+size_t SocketStats::mbed_stats_socket_get_events(mbed_stats_socket_event_t *events, size_t count)
+{
+    MBED_ASSERT(events != NULL);
+    size_t i = 0;
+#if MBED_CONF_NSAPI_SOCKET_STATS_ENABLE
+    uint32_t total = _event_count;
+    uint32_t available = (total < MBED_CONF_NSAPI_SOCKET_STATS_EVENT_LOG_SIZE) ?
+                         total : MBED_CONF_NSAPI_SOCKET_STATS_EVENT_LOG_SIZE;
+    if (count < available) {
+        available = count;
+    }
+    // Copy the most recent transitions, oldest first
+    uint32_t start = total - available;
+    for (; i < available; i++) {
+        events[i] = _events[(start + i) % MBED_CONF_NSAPI_SOCKET_STATS_EVENT_LOG_SIZE];
+    }
+#endif
+    return i;
+}
+
 SocketStats::SocketStats()
 {
 }
@@ -102,6 +136,11 @@ void SocketStats::stats_update_socket_state(const Socket *const reference_id, so
     _mutex->lock();
     int position = get_entry_position(reference_id);
     if (position >= 0) {
+        // Sockets report their state on every data call, so only record
+        // actual transitions in the event log
+        if (_stats[position].state != state) {
+            log_socket_event(reference_id, state);
+        }
         _stats[position].state = state;
 #ifdef MBED_CONF_RTOS_PRESENT
         _stats[position].last_change_tick = rtos::Kernel::get_ms_count();
@@ -135,6 +174,30 @@ void SocketStats::stats_update_proto(const Socket *const reference_id, nsapi_pro
 #endif
 }
 
+void SocketStats::stats_update_listen_backlog(const Socket *const reference_id, int backlog)
+{
+#if MBED_CONF_NSAPI_SOCKET_STATS_ENABLE
+    _mutex->lock();
+    int position = get_entry_position(reference_id);
+    if (position >= 0) {
+        _stats[position].listen_backlog = backlog;
+    }
+    _mutex->unlock();
+#endif
+}
+
+void SocketStats::stats_accepted_connection(const Socket *const reference_id)
+{
+#if MBED_CONF_NSAPI_SOCKET_STATS_ENABLE
+    _mutex->lock();
+    int position = get_entry_position(reference_id);
+    if (position >= 0) {
+        _stats[position].accepted_count++;
+    }
+    _mutex->unlock();
+#endif
+}
+
 void SocketStats::stats_update_sent_bytes(const Socket *const reference_id, size_t sent_bytes)
 {
 #if MBED_CONF_NSAPI_SOCKET_STATS_ENABLE
@@ -142,6 +205,7 @@ void SocketStats::stats_update_sent_bytes(const Socket *const reference_id, size
     int position = get_entry_position(reference_id);
     if ((position >= 0) && ((int32_t)sent_bytes > 0)) {
         _stats[position].sent_bytes += sent_bytes;
+        _stats[position].sent_count++;
     }
     _mutex->unlock();
 #endif
@@ -154,6 +218,7 @@ void SocketStats::stats_update_recv_bytes(const Socket *const reference_id, size
     int position = get_entry_position(reference_id);
     if ((position >= 0) && ((int32_t)recv_bytes > 0)) {
         _stats[position].recv_bytes += recv_bytes;
+        _stats[position].recv_count++;
     }
     _mutex->unlock();
 #endif
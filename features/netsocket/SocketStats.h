@@ -27,6 +27,10 @@
 #define MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT      10
 #endif
 
+#ifndef MBED_CONF_NSAPI_SOCKET_STATS_EVENT_LOG_SIZE
+#define MBED_CONF_NSAPI_SOCKET_STATS_EVENT_LOG_SIZE 16
+#endif
+
 /** Enum of socket states
   *
   * Can be used to specify current state of socket - open, closed, connected or listen.
@@ -49,9 +53,21 @@ typedef struct {
     nsapi_protocol_t proto;         /**< Specifies a protocol used with socket */
     size_t sent_bytes;              /**< Data sent through this socket */
     size_t recv_bytes;              /**< Data received through this socket */
+    size_t sent_count;              /**< Number of completed send operations on this socket */
+    size_t recv_count;              /**< Number of completed receive operations on this socket */
+    int listen_backlog;             /**< Backlog passed to listen(), 0 if the socket never listened */
+    size_t accepted_count;          /**< Connections accepted off this listening socket */
     us_timestamp_t last_change_tick;/**< osKernelGetTick() when state last changed */
 } mbed_stats_socket_t;
 
+/** One socket state transition recorded in the event log
+  */
+typedef struct {
+    Socket *reference_id;           /**< Used for identifying socket */
+    socket_state state;             /**< State the socket entered */
+    us_timestamp_t tick;            /**< osKernelGetTick() when the transition happened */
+} mbed_stats_socket_event_t;
+
 /**  SocketStats class
  *
  *   Class to get the network socket statistics
@@ -85,6 +101,20 @@ public:
      */
     static size_t mbed_stats_socket_get_each(mbed_stats_socket_t *stats, size_t count);
 
+    /**
+     *  Fill the passed array with the most recent socket state transitions, oldest first.
+     *
+     *  The event log is a ring buffer of the last `MBED_CONF_NSAPI_SOCKET_STATS_EVENT_LOG_SIZE`
+     *  transitions, written without taking the statistics mutex. It is best-effort telemetry:
+     *  a transition arriving during the copy may overwrite the oldest entry being read.
+     *
+     *  @param events   A pointer to an array of mbed_stats_socket_event_t structures to fill
+     *  @param count    The number of mbed_stats_socket_event_t structures in the provided array
+     *  @return         The number of mbed_stats_socket_event_t structures that have been filled,
+     *                  at most the number of transitions still held in the log.
+     */
+    static size_t mbed_stats_socket_get_events(mbed_stats_socket_event_t *events, size_t count);
+
 #if !defined(DOXYGEN_ONLY)
     /** Add entry of newly created socket in statistics array.
      *  API used by socket (TCP or UDP) layers only, not to be used by application.
@@ -143,11 +173,41 @@ public:
      */
     void stats_update_recv_bytes(const Socket *const reference_id, size_t recv_bytes);
 
+    /** Record the backlog a listening socket was configured with.
+     *  API used by socket (TCP or UDP) layers only, not to be used by application.
+     *
+     *  @param reference_id   ID to identify socket in data array.
+     *  @param backlog Parameter to record the backlog passed to listen().
+     *
+     */
+    void stats_update_listen_backlog(const Socket *const reference_id, int backlog);
+
+    /** Count a connection accepted off a listening socket, which is cumulative per socket.
+     *  API used by socket (TCP or UDP) layers only, not to be used by application.
+     *
+     *  @param reference_id   ID to identify the listening socket in data array.
+     *
+     */
+    void stats_accepted_connection(const Socket *const reference_id);
+
 #if MBED_CONF_NSAPI_SOCKET_STATS_ENABLE
 private:
     static mbed_stats_socket_t _stats[MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT];
+    static mbed_stats_socket_event_t _events[MBED_CONF_NSAPI_SOCKET_STATS_EVENT_LOG_SIZE];
     static SingletonPtr<PlatformMutex> _mutex;
     static uint32_t _size;
+    static uint32_t _event_count;
+
+    /** Internal function to append a state transition to the event log.
+     *
+     *  Reserves a slot with a single atomic increment so the log does not
+     *  add mutex contention on the data path.
+     *
+     *  @param reference_id   ID to identify the socket in the data array.
+     *  @param state          State the socket entered.
+     *
+     */
+    void log_socket_event(const Socket *const reference_id, socket_state state);
 
     /** Internal function to scan the array and get the position of the element in the list.
      *
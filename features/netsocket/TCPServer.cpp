@@ -55,6 +55,7 @@ nsapi_error_t TCPServer::accept(TCPSocket *connection, SocketAddress *address)
             _stack->socket_attach(socket, &Callback<void()>::thunk, &connection->_event);
             _socket_stats.stats_update_peer(connection, *address);
             _socket_stats.stats_update_socket_state(connection, SOCK_CONNECTED);
+            _socket_stats.stats_accepted_connection(this);
             connection->_lock.unlock();
             break;
         } else if ((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) {
@@ -15,15 +15,39 @@
  */
 
 #include "TCPSocket.h"
+#include "TrafficShaper.h"
 #include "Timer.h"
 #include "mbed_assert.h"
+#include "events/mbed_events.h"
 
-TCPSocket::TCPSocket()
+#ifndef MBED_CONF_NSAPI_CONNECT_ATTEMPT_DELAY
+#define MBED_CONF_NSAPI_CONNECT_ATTEMPT_DELAY 250
+#endif
+
+TCPSocket::TCPSocket() :
+    _accept_pool_count(0),
+    _connect_state(CONNECT_IDLE),
+    _connect_fallback_id(0)
 {
     _socket_stats.stats_update_proto(this, NSAPI_TCP);
 }
 
-TCPSocket::TCPSocket(TCPSocket *parent, nsapi_socket_t socket, SocketAddress address)
+TCPSocket::TCPSocket(TCPSocket *parent, nsapi_socket_t socket, SocketAddress address) :
+    _accept_pool_count(0),
+    _connect_state(CONNECT_IDLE),
+    _connect_fallback_id(0)
+{
+    init_accepted(parent, socket, address);
+}
+
+TCPSocket::~TCPSocket()
+{
+    while (_accept_pool_count > 0) {
+        delete _accept_pool[--_accept_pool_count];
+    }
+}
+
+void TCPSocket::init_accepted(TCPSocket *parent, nsapi_socket_t socket, const SocketAddress &address)
 {
     _socket = socket;
     _stack = parent->_stack;
@@ -34,8 +58,11 @@ TCPSocket::TCPSocket(TCPSocket *parent, nsapi_socket_t socket, SocketAddress add
     _stack->socket_attach(socket, &mbed::Callback<void()>::thunk, &_event);
 }
 
-TCPSocket::~TCPSocket()
+void TCPSocket::refill_accept_pool()
 {
+    while (_accept_pool_count < MBED_CONF_NSAPI_TCP_ACCEPT_POOL_SIZE) {
+        _accept_pool[_accept_pool_count++] = new TCPSocket();
+    }
 }
 
 nsapi_protocol_t TCPSocket::get_proto()
@@ -131,6 +158,249 @@ nsapi_error_t TCPSocket::connect(const char *host, uint16_t port)
     return connect(address);
 }
 
+nsapi_error_t TCPSocket::connect_async(const char *host, uint16_t port, mbed::Callback<void(nsapi_error_t)> callback)
+{
+    if (!host || !callback) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    _lock.lock();
+
+    if (!_socket) {
+        _lock.unlock();
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+    if (_connect_state != CONNECT_IDLE) {
+        _lock.unlock();
+        return NSAPI_ERROR_IN_PROGRESS;
+    }
+
+    _connect_cb = callback;
+    _connect_state = CONNECT_RESOLVING;
+    _connect_port = port;
+    _connect_current = 0;
+    _connect_last_err = NSAPI_ERROR_DNS_FAILURE;
+    for (int i = 0; i < 2; i++) {
+        _connect_valid[i] = false;
+        _connect_tried[i] = false;
+        _connect_dns_done[i] = false;
+    }
+
+    // Route socket events through the state machine for the duration of the
+    // connect, chaining any sigio callback the application has registered
+    _chained_sigio_cb = _callback;
+    _callback = mbed::callback(this, &TCPSocket::connect_async_sigio);
+
+    NetworkStack *stack = _stack;
+    _lock.unlock();
+
+    // Resolve both families in parallel. The callbacks run on the shared
+    // event queue and may fire before these calls return on a cache hit;
+    // a failure to even start a query counts as that family failing.
+    nsapi_value_or_error_t ret = stack->gethostbyname_async(host,
+                                                            mbed::callback(this, &TCPSocket::connect_async_dns6_cb), NSAPI_IPv6);
+    if (ret < 0) {
+        connect_async_dns_cb(0, ret, NULL);
+    }
+    ret = stack->gethostbyname_async(host,
+                                     mbed::callback(this, &TCPSocket::connect_async_dns4_cb), NSAPI_IPv4);
+    if (ret < 0) {
+        connect_async_dns_cb(1, ret, NULL);
+    }
+
+    return NSAPI_ERROR_OK;
+}
+
+void TCPSocket::connect_async_dns6_cb(nsapi_error_t result, SocketAddress *address)
+{
+    connect_async_dns_cb(0, result, address);
+}
+
+void TCPSocket::connect_async_dns4_cb(nsapi_error_t result, SocketAddress *address)
+{
+    connect_async_dns_cb(1, result, address);
+}
+
+void TCPSocket::connect_async_dns_cb(int family, nsapi_error_t result, SocketAddress *address)
+{
+    _lock.lock();
+
+    if (_connect_state == CONNECT_IDLE || _connect_dns_done[family]) {
+        _lock.unlock();
+        return;
+    }
+
+    _connect_dns_done[family] = true;
+    if (result >= 0 && address) {
+        _connect_addr[family] = *address;
+        _connect_addr[family].set_port(_connect_port);
+        _connect_valid[family] = true;
+    }
+
+    connect_async_advance();
+    _lock.unlock();
+}
+
+void TCPSocket::connect_async_sigio()
+{
+    // May run from interrupt or stack thread context - bounce to the
+    // event queue where the state machine runs
+    mbed::mbed_event_queue()->call(this, &TCPSocket::connect_async_event);
+    if (_chained_sigio_cb) {
+        _chained_sigio_cb();
+    }
+}
+
+void TCPSocket::connect_async_event()
+{
+    _lock.lock();
+
+    if (_connect_state != CONNECT_CONNECTING) {
+        _lock.unlock();
+        return;
+    }
+    if (!_socket) {
+        connect_async_finish(NSAPI_ERROR_NO_SOCKET);
+        _lock.unlock();
+        return;
+    }
+
+    _pending = 0;
+    nsapi_error_t ret = _stack->socket_connect(_socket, _connect_addr[_connect_current]);
+    if (ret == NSAPI_ERROR_OK || ret == NSAPI_ERROR_IS_CONNECTED) {
+        connect_async_finish(NSAPI_ERROR_OK);
+    } else if (ret != NSAPI_ERROR_IN_PROGRESS && ret != NSAPI_ERROR_ALREADY &&
+               ret != NSAPI_ERROR_WOULD_BLOCK) {
+        // Attempt failed - recycle the socket and try any remaining address
+        _connect_last_err = ret;
+        _connect_state = CONNECT_RESOLVING;
+        ret = connect_async_recycle_socket();
+        if (ret != NSAPI_ERROR_OK) {
+            connect_async_finish(ret);
+        } else {
+            connect_async_advance();
+        }
+    }
+
+    _lock.unlock();
+}
+
+void TCPSocket::connect_async_fallback()
+{
+    _lock.lock();
+
+    _connect_fallback_id = 0;
+    if (_connect_state == CONNECT_CONNECTING) {
+        int alt = 1 - _connect_current;
+        if (_connect_valid[alt] && !_connect_tried[alt]) {
+            // The preferred attempt is stalling - abandon it in favour of
+            // the other family
+            _connect_last_err = NSAPI_ERROR_TIMEOUT;
+            _connect_state = CONNECT_RESOLVING;
+            nsapi_error_t ret = connect_async_recycle_socket();
+            if (ret != NSAPI_ERROR_OK) {
+                connect_async_finish(ret);
+            } else {
+                connect_async_advance();
+            }
+        } else if (!_connect_dns_done[alt]) {
+            // Other family still resolving - check again later
+            _connect_fallback_id = mbed::mbed_event_queue()->call_in(
+                                       MBED_CONF_NSAPI_CONNECT_ATTEMPT_DELAY,
+                                       this, &TCPSocket::connect_async_fallback);
+        }
+    }
+
+    _lock.unlock();
+}
+
+void TCPSocket::connect_async_advance()
+{
+    // _lock held. Start the next connect attempt, preferring IPv6 when
+    // both families have an address.
+    if (_connect_state != CONNECT_RESOLVING) {
+        return;
+    }
+
+    int next;
+    if (_connect_valid[0] && !_connect_tried[0]) {
+        next = 0;
+    } else if (_connect_valid[1] && !_connect_tried[1]) {
+        next = 1;
+    } else if (!_connect_dns_done[0] || !_connect_dns_done[1]) {
+        // Wait for the remaining resolution
+        return;
+    } else {
+        connect_async_finish(_connect_last_err);
+        return;
+    }
+
+    _connect_current = next;
+    _connect_tried[next] = true;
+    _pending = 0;
+    nsapi_error_t ret = _stack->socket_connect(_socket, _connect_addr[next]);
+    if (ret == NSAPI_ERROR_OK || ret == NSAPI_ERROR_IS_CONNECTED) {
+        connect_async_finish(NSAPI_ERROR_OK);
+        return;
+    }
+    if (ret == NSAPI_ERROR_IN_PROGRESS || ret == NSAPI_ERROR_ALREADY ||
+        ret == NSAPI_ERROR_WOULD_BLOCK) {
+        _connect_state = CONNECT_CONNECTING;
+        // Give the other family a chance if this attempt stalls
+        int alt = 1 - next;
+        if (!_connect_fallback_id &&
+                (!_connect_dns_done[alt] || (_connect_valid[alt] && !_connect_tried[alt]))) {
+            _connect_fallback_id = mbed::mbed_event_queue()->call_in(
+                                       MBED_CONF_NSAPI_CONNECT_ATTEMPT_DELAY,
+                                       this, &TCPSocket::connect_async_fallback);
+        }
+        return;
+    }
+
+    // Attempt failed outright - recycle the socket and try any remaining
+    // address
+    _connect_last_err = ret;
+    ret = connect_async_recycle_socket();
+    if (ret != NSAPI_ERROR_OK) {
+        connect_async_finish(ret);
+    } else {
+        connect_async_advance();
+    }
+}
+
+nsapi_error_t TCPSocket::connect_async_recycle_socket()
+{
+    // _lock held. A TCP socket is not usable after a failed connect
+    // attempt, so get a fresh one from the stack for the next address.
+    NetworkStack *stack = _stack;
+    close();
+    return open(stack);
+}
+
+void TCPSocket::connect_async_finish(nsapi_error_t status)
+{
+    // _lock held
+    if (_connect_fallback_id) {
+        mbed::mbed_event_queue()->cancel(_connect_fallback_id);
+        _connect_fallback_id = 0;
+    }
+    _connect_state = CONNECT_IDLE;
+    _callback = _chained_sigio_cb;
+    _chained_sigio_cb = NULL;
+    mbed::Callback<void(nsapi_error_t)> cb = _connect_cb;
+    _connect_cb = NULL;
+
+    if (status == NSAPI_ERROR_OK) {
+        _remote_peer = _connect_addr[_connect_current];
+        _socket_stats.stats_update_peer(this, _remote_peer);
+        _socket_stats.stats_update_socket_state(this, SOCK_CONNECTED);
+    }
+
+    // Hand the result to the application from the event queue, so the
+    // callback is free to call back into the socket
+    mbed::mbed_event_queue()->call(cb, status);
+}
+
 nsapi_size_or_error_t TCPSocket::send(const void *data, nsapi_size_t size)
 {
     _lock.lock();
@@ -144,6 +414,22 @@ nsapi_size_or_error_t TCPSocket::send(const void *data, nsapi_size_t size)
     MBED_ASSERT(_writers == 0);
     _writers++;
 
+    // Pace against the socket's QoS class before taking link capacity,
+    // releasing the lock so other threads aren't held while we wait
+    _lock.unlock();
+    nsapi_error_t paced = TrafficShaper::acquire(_qos_class, size, _timeout);
+    _lock.lock();
+    if (paced != NSAPI_ERROR_OK) {
+        _writers--;
+        if (!_socket) {
+#ifdef MBED_CONF_RTOS_PRESENT
+            _event_flag.set(FINISHED_FLAG);
+#endif
+        }
+        _lock.unlock();
+        return paced;
+    }
+
     // Unlike recv, we should write the whole thing if blocking. POSIX only
     // allows partial as a side-effect of signal handling; it normally tries to
     // write everything if blocking. Without signals we can always write all.
@@ -286,6 +572,9 @@ nsapi_error_t TCPSocket::listen(int backlog)
         ret = _stack->socket_listen(_socket, backlog);
         if (NSAPI_ERROR_OK == ret) {
             _socket_stats.stats_update_socket_state(this, SOCK_LISTEN);
+            _socket_stats.stats_update_listen_backlog(this, backlog);
+            // construct connection objects ahead of the first burst
+            refill_accept_pool();
         }
     }
 
@@ -301,6 +590,10 @@ TCPSocket *TCPSocket::accept(nsapi_error_t *error)
 
     _readers++;
 
+    // top the pool back up while no connection is waiting, so a burst
+    // of connections is served by pops alone
+    refill_accept_pool();
+
     while (true) {
         if (!_socket) {
             ret = NSAPI_ERROR_NO_SOCKET;
@@ -313,9 +606,15 @@ TCPSocket *TCPSocket::accept(nsapi_error_t *error)
         ret = _stack->socket_accept(_socket, &socket, &address);
 
         if (0 == ret) {
-            connection = new TCPSocket(this, socket, address);
+            if (_accept_pool_count > 0) {
+                connection = _accept_pool[--_accept_pool_count];
+                connection->init_accepted(this, socket, address);
+            } else {
+                connection = new TCPSocket(this, socket, address);
+            }
             _socket_stats.stats_update_peer(connection, address);
             _socket_stats.stats_update_socket_state(connection, SOCK_CONNECTED);
+            _socket_stats.stats_accepted_connection(this);
             break;
         } else if ((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) {
             break;
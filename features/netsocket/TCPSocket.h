@@ -23,6 +23,10 @@
 #include "netsocket/InternetSocket.h"
 #include "netsocket/NetworkStack.h"
 #include "netsocket/NetworkInterface.h"
+
+#ifndef MBED_CONF_NSAPI_TCP_ACCEPT_POOL_SIZE
+#define MBED_CONF_NSAPI_TCP_ACCEPT_POOL_SIZE 4
+#endif
 #ifdef MBED_CONF_RTOS_PRESENT
 #include "rtos/EventFlags.h"
 #endif
@@ -92,6 +96,32 @@ public:
      */
     virtual nsapi_error_t connect(const SocketAddress &address);
 
+    /** Connects TCP socket to a remote host without blocking
+     *
+     *  Resolves the hostname for IPv6 and IPv4 in parallel and connects to
+     *  the first address that becomes available, preferring IPv6. If the
+     *  preferred attempt has not completed within
+     *  nsapi.connect-attempt-delay milliseconds and the other family has an
+     *  address, the attempt is abandoned in favour of the other family
+     *  ("happy eyeballs", RFC 8305), so a broken IPv6 path costs the
+     *  fallback delay instead of a full TCP connect timeout.
+     *
+     *  The completion callback is invoked on the shared event queue with
+     *  NSAPI_ERROR_OK once connected, or with the last error once every
+     *  address has failed. While the connect is pending the socket must be
+     *  kept open and its sigio callback must not be changed; a previously
+     *  registered sigio callback keeps being called. A failed attempt
+     *  recycles the underlying socket, so a bind() made before this call
+     *  does not survive falling back to another address.
+     *
+     *  @param host     Hostname of the remote host
+     *  @param port     Port of the remote host
+     *  @param callback Completion callback
+     *  @return         NSAPI_ERROR_OK if the connect was started,
+     *                  negative error code on failure to start it
+     */
+    nsapi_error_t connect_async(const char *host, uint16_t port, mbed::Callback<void(nsapi_error_t)> callback);
+
     /** Send data over a TCP socket
      *
      *  The socket must be connected to a remote host. Returns the number of
@@ -197,6 +227,56 @@ private:
      *  To be used within accept() function. Close() will clean this up.
      */
     TCPSocket(TCPSocket *parent, nsapi_socket_t socket, SocketAddress address);
+
+    /** Take over a stack socket accepted on a listening parent
+     *
+     *  Used by accept() on pool-allocated connection objects; does what
+     *  the factory constructor above does, post construction.
+     */
+    void init_accepted(TCPSocket *parent, nsapi_socket_t socket, const SocketAddress &address);
+
+    /** Top the accept pool back up to its configured size
+     *
+     *  Called with _lock held from listen() and from accept(), so
+     *  connection objects are constructed while the socket is idle
+     *  rather than between a connection arriving and accept()
+     *  returning it.
+     */
+    void refill_accept_pool();
+
+    TCPSocket *_accept_pool[MBED_CONF_NSAPI_TCP_ACCEPT_POOL_SIZE];
+    int _accept_pool_count;
+
+    /* Asynchronous connect state machine. DNS results, socket events and
+     * the fallback timer are all serialized on the shared event queue.
+     * Address slot 0 is the preferred family (IPv6), slot 1 is IPv4. */
+    enum connect_async_state {
+        CONNECT_IDLE,
+        CONNECT_RESOLVING,
+        CONNECT_CONNECTING
+    };
+
+    void connect_async_dns6_cb(nsapi_error_t result, SocketAddress *address);
+    void connect_async_dns4_cb(nsapi_error_t result, SocketAddress *address);
+    void connect_async_dns_cb(int family, nsapi_error_t result, SocketAddress *address);
+    void connect_async_sigio();
+    void connect_async_event();
+    void connect_async_fallback();
+    void connect_async_advance();
+    void connect_async_finish(nsapi_error_t status);
+    nsapi_error_t connect_async_recycle_socket();
+
+    mbed::Callback<void(nsapi_error_t)> _connect_cb;
+    mbed::Callback<void()> _chained_sigio_cb;
+    SocketAddress _connect_addr[2];
+    connect_async_state _connect_state;
+    int _connect_fallback_id;
+    nsapi_error_t _connect_last_err;
+    uint16_t _connect_port;
+    uint8_t _connect_current;
+    bool _connect_valid[2];
+    bool _connect_tried[2];
+    bool _connect_dns_done[2];
 };
 
 
@@ -25,12 +25,203 @@
 #define TRACE_GROUP "TLSW"
 #include "mbed-trace/mbed_trace.h"
 #include "mbedtls/debug.h"
+#include "mbedtls/sha256.h"
 #include "mbed_error.h"
 #include "Kernel.h"
+#include "PlatformMutex.h"
+#include "SingletonPtr.h"
 
 // This class requires Mbed TLS SSL/TLS client code
 #if defined(MBEDTLS_SSL_CLI_C)
 
+/* Number of handshake states advanced per event queue dispatch during an
+ * asynchronous handshake; bounds how long one socket holds the thread */
+#if defined(MBED_CONF_NSAPI_TLS_HANDSHAKE_STEPS_PER_EVENT)
+#define TLS_HANDSHAKE_STEPS_PER_EVENT MBED_CONF_NSAPI_TLS_HANDSHAKE_STEPS_PER_EVENT
+#else
+#define TLS_HANDSHAKE_STEPS_PER_EVENT 4
+#endif
+
+#if defined(MBEDTLS_X509_CRT_PARSE_C) && (MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0)
+
+// Sessions saved from completed handshakes, keyed by hostname. Applying
+// a saved session before the next handshake to the same host turns the
+// full handshake into an abbreviated one (session ID or ticket based,
+// whichever the server supports).
+struct TLS_SESSION_CACHE_ENTRY {
+    char *hostname;
+    mbedtls_ssl_session session;
+    uint64_t accessed;
+};
+
+static TLS_SESSION_CACHE_ENTRY *tls_session_cache[MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE];
+static SingletonPtr<PlatformMutex> tls_session_cache_mutex;
+
+static void tls_session_cache_entry_free(TLS_SESSION_CACHE_ENTRY *entry)
+{
+    mbedtls_ssl_session_free(&entry->session);
+    free(entry->hostname);
+    delete entry;
+}
+
+static void tls_session_cache_add(const char *hostname, mbedtls_ssl_context *ssl)
+{
+    int index = -1;
+
+    tls_session_cache_mutex->lock();
+
+    // Reuse the entry already stored for the same host
+    for (int i = 0; i < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; i++) {
+        if (tls_session_cache[i] && strcmp(tls_session_cache[i]->hostname, hostname) == 0) {
+            index = i;
+            mbedtls_ssl_session_free(&tls_session_cache[i]->session);
+            break;
+        }
+    }
+
+    if (index < 0) {
+        // Take a free slot, or recycle the least recently used one
+        index = 0;
+        for (int i = 0; i < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; i++) {
+            if (!tls_session_cache[i]) {
+                index = i;
+                break;
+            }
+            if (tls_session_cache[i]->accessed < tls_session_cache[index]->accessed) {
+                index = i;
+            }
+        }
+
+        if (tls_session_cache[index]) {
+            tls_session_cache_entry_free(tls_session_cache[index]);
+            tls_session_cache[index] = NULL;
+        }
+
+        TLS_SESSION_CACHE_ENTRY *entry = new (std::nothrow) TLS_SESSION_CACHE_ENTRY;
+        if (!entry) {
+            tls_session_cache_mutex->unlock();
+            return;
+        }
+        entry->hostname = (char *)malloc(strlen(hostname) + 1);
+        if (!entry->hostname) {
+            delete entry;
+            tls_session_cache_mutex->unlock();
+            return;
+        }
+        strcpy(entry->hostname, hostname);
+        mbedtls_ssl_session_init(&entry->session);
+        tls_session_cache[index] = entry;
+    }
+
+    if (mbedtls_ssl_get_session(ssl, &tls_session_cache[index]->session) != 0) {
+        tls_session_cache_entry_free(tls_session_cache[index]);
+        tls_session_cache[index] = NULL;
+    } else {
+        tls_session_cache[index]->accessed = rtos::Kernel::get_ms_count();
+    }
+
+    tls_session_cache_mutex->unlock();
+}
+
+static void tls_session_cache_restore(const char *hostname, mbedtls_ssl_context *ssl)
+{
+    tls_session_cache_mutex->lock();
+
+    for (int i = 0; i < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; i++) {
+        if (tls_session_cache[i] && strcmp(tls_session_cache[i]->hostname, hostname) == 0) {
+            if (mbedtls_ssl_set_session(ssl, &tls_session_cache[i]->session) == 0) {
+                tls_session_cache[i]->accessed = rtos::Kernel::get_ms_count();
+            }
+            break;
+        }
+    }
+
+    tls_session_cache_mutex->unlock();
+}
+
+#endif /* MBEDTLS_X509_CRT_PARSE_C && MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0 */
+
+#if defined(MBEDTLS_X509_CRT_PARSE_C) && defined(MBEDTLS_SHA256_C)
+
+// Root CA chains parsed once and shared between sockets, keyed by a
+// digest of the unparsed input. Connecting several sockets with the same
+// certificate bundle costs one parse and one parsed copy in total.
+struct TLS_CACERT_CACHE_ENTRY {
+    unsigned char digest[32];
+    mbedtls_x509_crt crt;
+    unsigned int refs;
+    TLS_CACERT_CACHE_ENTRY *next;
+};
+
+static TLS_CACERT_CACHE_ENTRY *tls_cacert_cache;
+static SingletonPtr<PlatformMutex> tls_cacert_cache_mutex;
+
+static mbedtls_x509_crt *tls_cacert_cache_get(const void *root_ca, size_t len, int *error)
+{
+    unsigned char digest[32];
+
+    *error = mbedtls_sha256_ret(static_cast<const unsigned char *>(root_ca), len, digest, 0);
+    if (*error != 0) {
+        return NULL;
+    }
+
+    tls_cacert_cache_mutex->lock();
+
+    for (TLS_CACERT_CACHE_ENTRY *entry = tls_cacert_cache; entry; entry = entry->next) {
+        if (memcmp(entry->digest, digest, sizeof(digest)) == 0) {
+            entry->refs++;
+            tls_cacert_cache_mutex->unlock();
+            return &entry->crt;
+        }
+    }
+
+    TLS_CACERT_CACHE_ENTRY *entry = new (std::nothrow) TLS_CACERT_CACHE_ENTRY;
+    if (!entry) {
+        tls_cacert_cache_mutex->unlock();
+        *error = MBEDTLS_ERR_X509_ALLOC_FAILED;
+        return NULL;
+    }
+
+    memcpy(entry->digest, digest, sizeof(digest));
+    mbedtls_x509_crt_init(&entry->crt);
+
+    *error = mbedtls_x509_crt_parse(&entry->crt, static_cast<const unsigned char *>(root_ca), len);
+    if (*error != 0) {
+        mbedtls_x509_crt_free(&entry->crt);
+        delete entry;
+        tls_cacert_cache_mutex->unlock();
+        return NULL;
+    }
+
+    entry->refs = 1;
+    entry->next = tls_cacert_cache;
+    tls_cacert_cache = entry;
+
+    tls_cacert_cache_mutex->unlock();
+    return &entry->crt;
+}
+
+static void tls_cacert_cache_put(mbedtls_x509_crt *crt)
+{
+    tls_cacert_cache_mutex->lock();
+
+    for (TLS_CACERT_CACHE_ENTRY **link = &tls_cacert_cache; *link; link = &(*link)->next) {
+        TLS_CACERT_CACHE_ENTRY *entry = *link;
+        if (&entry->crt == crt) {
+            if (--entry->refs == 0) {
+                *link = entry->next;
+                mbedtls_x509_crt_free(&entry->crt);
+                delete entry;
+            }
+            break;
+        }
+    }
+
+    tls_cacert_cache_mutex->unlock();
+}
+
+#endif /* MBEDTLS_X509_CRT_PARSE_C && MBEDTLS_SHA256_C */
+
 TLSSocketWrapper::TLSSocketWrapper(Socket *transport, const char *hostname, control_transport control) :
     _transport(transport),
     _timeout(-1),
@@ -39,11 +230,14 @@ TLSSocketWrapper::TLSSocketWrapper(Socket *transport, const char *hostname, cont
     _clicert(NULL),
 #endif
     _ssl_conf(NULL),
+    _handshake_queue(NULL),
+    _handshake_event_id(0),
     _connect_transport(control == TRANSPORT_CONNECT || control == TRANSPORT_CONNECT_AND_CLOSE),
     _close_transport(control == TRANSPORT_CLOSE || control == TRANSPORT_CONNECT_AND_CLOSE),
     _tls_initialized(false),
     _handshake_completed(false),
     _cacert_allocated(false),
+    _cacert_shared(false),
     _clicert_allocated(false),
     _ssl_conf_allocated(false)
 {
@@ -86,6 +280,19 @@ nsapi_error_t TLSSocketWrapper::set_root_ca_cert(const void *root_ca, size_t len
 {
 #if !defined(MBEDTLS_X509_CRT_PARSE_C)
     return NSAPI_ERROR_UNSUPPORTED;
+#elif defined(MBEDTLS_SHA256_C)
+    int ret;
+    mbedtls_x509_crt *crt = tls_cacert_cache_get(root_ca, len, &ret);
+    if (!crt) {
+        if (ret == MBEDTLS_ERR_X509_ALLOC_FAILED) {
+            return NSAPI_ERROR_NO_MEMORY;
+        }
+        print_mbedtls_error("mbedtls_x509_crt_parse", ret);
+        return NSAPI_ERROR_PARAMETER;
+    }
+    set_ca_chain(crt);
+    _cacert_shared = true;
+    return NSAPI_ERROR_OK;
 #else
     mbedtls_x509_crt *crt;
 
@@ -150,7 +357,6 @@ nsapi_error_t TLSSocketWrapper::set_client_cert_key(const void *client_cert, siz
 
 nsapi_error_t TLSSocketWrapper::start_handshake(bool first_call)
 {
-    const char DRBG_PERS[] = "mbed TLS client";
     int ret;
 
     if (!_transport) {
@@ -161,6 +367,28 @@ nsapi_error_t TLSSocketWrapper::start_handshake(bool first_call)
         return continue_handshake();
     }
 
+    ret = init_tls();
+    if (ret != NSAPI_ERROR_OK) {
+        return ret;
+    }
+
+    ret = continue_handshake();
+    if (first_call) {
+        if (ret == NSAPI_ERROR_ALREADY) {
+            ret = NSAPI_ERROR_IN_PROGRESS; // If first call should return IN_PROGRESS
+        }
+        if (ret == NSAPI_ERROR_IS_CONNECTED) {
+            ret = NSAPI_ERROR_OK;   // If we happened to complete the request on the first call, return OK.
+        }
+    }
+    return ret;
+}
+
+nsapi_error_t TLSSocketWrapper::init_tls()
+{
+    const char DRBG_PERS[] = "mbed TLS client";
+    int ret;
+
 #ifdef MBEDTLS_X509_CRT_PARSE_C
     tr_info("Starting TLS handshake with %s", _ssl.hostname);
 #else
@@ -185,6 +413,17 @@ nsapi_error_t TLSSocketWrapper::start_handshake(bool first_call)
     mbedtls_debug_set_threshold(MBED_CONF_TLS_SOCKET_DEBUG_LEVEL);
 #endif
 
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH) && (MBED_CONF_NSAPI_TLS_MAX_FRAG_LEN > 0)
+    /* Must be set before mbedtls_ssl_setup() so the I/O buffers are sized
+     * from the configured fragment length when variable buffer lengths are
+     * enabled */
+    if ((ret = mbedtls_ssl_conf_max_frag_len(get_ssl_config(),
+                                             MBED_CONF_NSAPI_TLS_MAX_FRAG_LEN)) != 0) {
+        print_mbedtls_error("mbedtls_ssl_conf_max_frag_len", ret);
+        return NSAPI_ERROR_PARAMETER;
+    }
+#endif
+
     tr_debug("mbedtls_ssl_setup()");
     if ((ret = mbedtls_ssl_setup(&_ssl, get_ssl_config())) != 0) {
         print_mbedtls_error("mbedtls_ssl_setup", ret);
@@ -195,18 +434,17 @@ nsapi_error_t TLSSocketWrapper::start_handshake(bool first_call)
     _transport->sigio(mbed::callback(this, &TLSSocketWrapper::event));
     mbedtls_ssl_set_bio(&_ssl, this, ssl_send, ssl_recv, NULL);
 
+#if defined(MBEDTLS_X509_CRT_PARSE_C) && (MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0)
+    /* Offer a previously saved session for this host, so the server can
+     * accept an abbreviated handshake instead of a full one */
+    if (_ssl.hostname) {
+        tls_session_cache_restore(_ssl.hostname, &_ssl);
+    }
+#endif
+
     _tls_initialized = true;
 
-    ret = continue_handshake();
-    if (first_call) {
-        if (ret == NSAPI_ERROR_ALREADY) {
-            ret = NSAPI_ERROR_IN_PROGRESS; // If first call should return IN_PROGRESS
-        }
-        if (ret == NSAPI_ERROR_IS_CONNECTED) {
-            ret = NSAPI_ERROR_OK;   // If we happened to complete the request on the first call, return OK.
-        }
-    }
-    return ret;
+    return NSAPI_ERROR_OK;
 }
 
 nsapi_error_t TLSSocketWrapper::continue_handshake()
@@ -247,6 +485,11 @@ nsapi_error_t TLSSocketWrapper::continue_handshake()
         }
     }
 
+    return handshake_finished();
+}
+
+nsapi_error_t TLSSocketWrapper::handshake_finished()
+{
 #ifdef MBEDTLS_X509_CRT_PARSE_C
     /* It also means the handshake is done, time to print info */
     tr_info("TLS connection to %s established", _ssl.hostname);
@@ -274,10 +517,99 @@ nsapi_error_t TLSSocketWrapper::continue_handshake()
     delete[] buf;
 #endif
 
+#if defined(MBEDTLS_X509_CRT_PARSE_C) && (MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0)
+    /* Save the negotiated session for resumption on the next connect */
+    if (_ssl.hostname) {
+        tls_session_cache_add(_ssl.hostname, &_ssl);
+    }
+#endif
+
     _handshake_completed = true;
     return NSAPI_ERROR_IS_CONNECTED;
 }
 
+nsapi_error_t TLSSocketWrapper::start_handshake_async(events::EventQueue *queue)
+{
+    nsapi_error_t err;
+
+    if (!_transport) {
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+
+    if (_handshake_completed) {
+        return NSAPI_ERROR_IS_CONNECTED;
+    }
+
+    if (_handshake_queue) {
+        return NSAPI_ERROR_IN_PROGRESS;
+    }
+
+    if (!_tls_initialized) {
+        err = init_tls();
+        if (err != NSAPI_ERROR_OK) {
+            return err;
+        }
+    }
+
+    _handshake_queue = queue ? queue : mbed::mbed_event_queue();
+    schedule_handshake_step();
+    return NSAPI_ERROR_IN_PROGRESS;
+}
+
+void TLSSocketWrapper::schedule_handshake_step()
+{
+    if (_handshake_event_id) {
+        // a step is already queued
+        return;
+    }
+    _handshake_event_id = _handshake_queue->call(mbed::callback(this, &TLSSocketWrapper::handshake_step_event));
+}
+
+void TLSSocketWrapper::handshake_step_event()
+{
+    int ret = 0;
+
+    _handshake_event_id = 0;
+
+    if (_handshake_completed || !_tls_initialized) {
+        return;
+    }
+
+    /* Advance a bounded number of handshake states so one socket cannot
+     * monopolize the dispatch thread; other sockets sharing the queue
+     * interleave their own steps between ours */
+    for (int i = 0; i < TLS_HANDSHAKE_STEPS_PER_EVENT && _ssl.state != MBEDTLS_SSL_HANDSHAKE_OVER; i++) {
+        ret = mbedtls_ssl_handshake_step(&_ssl);
+        if (ret != 0) {
+            break;
+        }
+    }
+
+    if (_ssl.state == MBEDTLS_SSL_HANDSHAKE_OVER) {
+        handshake_finished();
+        _handshake_queue = NULL;
+        /* Wake any waiter and fire the application sigio */
+        event();
+        return;
+    }
+
+    if (ret == 0) {
+        /* Budget exhausted mid-flight - yield and continue on the next dispatch */
+        schedule_handshake_step();
+        return;
+    }
+
+    if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
+        /* Blocked on the transport - the sigio event reschedules us */
+        return;
+    }
+
+    /* Fatal. Leave the errored context in place so the application sees the
+     * failure through connect()/send()/recv() after its sigio fires */
+    print_mbedtls_error("mbedtls_ssl_handshake_step", ret);
+    _handshake_queue = NULL;
+    event();
+}
 
 nsapi_error_t TLSSocketWrapper::send(const void *data, nsapi_size_t size)
 {
@@ -529,6 +861,13 @@ mbedtls_x509_crt *TLSSocketWrapper::get_ca_chain()
 
 void TLSSocketWrapper::set_ca_chain(mbedtls_x509_crt *crt)
 {
+#if defined(MBEDTLS_SHA256_C)
+    if (_cacert && _cacert_shared) {
+        tls_cacert_cache_put(_cacert);
+        _cacert = NULL;
+        _cacert_shared = false;
+    }
+#endif
     if (_cacert && _cacert_allocated) {
         mbedtls_x509_crt_free(_cacert);
         delete _cacert;
@@ -589,6 +928,14 @@ nsapi_error_t TLSSocketWrapper::close()
 
     tr_info("Closing TLS");
 
+    if (_handshake_queue) {
+        if (_handshake_event_id) {
+            _handshake_queue->cancel(_handshake_event_id);
+            _handshake_event_id = 0;
+        }
+        _handshake_queue = NULL;
+    }
+
     int ret = 0;
     if (_handshake_completed) {
         _transport->set_blocking(true);
@@ -694,6 +1041,10 @@ void TLSSocketWrapper::event()
 #ifdef MBED_CONF_RTOS_PRESENT
     _event_flag.set(1);
 #endif
+    if (_handshake_queue) {
+        /* Transport progress unblocks an asynchronous handshake */
+        schedule_handshake_step();
+    }
     if (_sigio) {
         _sigio();
     }
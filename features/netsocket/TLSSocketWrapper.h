@@ -23,6 +23,7 @@
 #include "rtos/EventFlags.h"
 #endif
 #include "platform/Callback.h"
+#include "events/EventQueue.h"
 #include "mbedtls/platform.h"
 #include "mbedtls/ssl.h"
 #include "mbedtls/entropy.h"
@@ -66,6 +67,10 @@ public:
     void set_hostname(const char *hostname);
 
     /** Sets the certification of Root CA.
+     *
+     * The parsed chain is shared between sockets: passing the same
+     * certificate data to several sockets costs one parse and holds one
+     * parsed copy, released when the last socket using it is destroyed.
      *
      * @param root_ca Root CA Certificate in any mbed-TLS supported format.
      * @param len     Length of certificate (including terminating 0 for PEM).
@@ -121,6 +126,28 @@ public:
      */
     virtual nsapi_size_or_error_t recv(void *data, nsapi_size_t size);
 
+    /** Start the TLS handshake asynchronously
+     *
+     *  The handshake is advanced a bounded number of states per event queue
+     *  dispatch, rescheduled by the transport's sigio events, so several TLS
+     *  sockets sharing one queue handshake concurrently instead of each
+     *  monopolizing the thread until done. The per-dispatch budget is set
+     *  with the nsapi.tls-handshake-steps-per-event configuration value.
+     *
+     *  The underlying transport must already be connected. When the handshake
+     *  finishes - successfully or not - the sigio callback is called; the
+     *  outcome is then visible through connect(), which returns
+     *  NSAPI_ERROR_IS_CONNECTED on success. send() and recv() must not be
+     *  called while the asynchronous handshake is in progress.
+     *
+     *  @param queue Event queue to run the handshake on, or NULL for the
+     *               shared event queue.
+     *  @return NSAPI_ERROR_IN_PROGRESS when the handshake was started,
+     *          NSAPI_ERROR_IS_CONNECTED if it has already completed,
+     *          negative error code on failure to start.
+     */
+    nsapi_error_t start_handshake_async(events::EventQueue *queue = NULL);
+
     /* = Functions inherited from Socket = */
     virtual nsapi_error_t close();
     virtual nsapi_error_t connect(const SocketAddress &address = SocketAddress());
@@ -200,8 +227,16 @@ protected:
 
 
 private:
+    /** Initialise the TLS context and attach it to the transport */
+    nsapi_error_t init_tls();
     /** Continue already initialised handshake */
     nsapi_error_t continue_handshake();
+    /** Record and report a completed handshake */
+    nsapi_error_t handshake_finished();
+    /** Advance a bounded number of handshake states on the event queue */
+    void handshake_step_event();
+    /** Queue the next handshake step unless one is already pending */
+    void schedule_handshake_step();
     /**
      * Helper for pretty-printing mbed TLS error codes
      */
@@ -253,11 +288,16 @@ private:
 #endif
     mbedtls_ssl_config *_ssl_conf;
 
+    /** Event queue driving an asynchronous handshake, NULL when none is in progress */
+    events::EventQueue *_handshake_queue;
+    int _handshake_event_id;
+
     bool _connect_transport: 1;
     bool _close_transport: 1;
     bool _tls_initialized: 1;
     bool _handshake_completed: 1;
     bool _cacert_allocated: 1;
+    bool _cacert_shared: 1;
     bool _clicert_allocated: 1;
     bool _ssl_conf_allocated: 1;
 
@@ -0,0 +1,131 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TrafficShaper.h"
+#include "rtos/Kernel.h"
+#include "rtos/ThisThread.h"
+
+/* Sleep quantum while a sender waits for tokens or yields to a higher
+ * class; bounds how stale the strict-priority decision can get */
+#define SHAPER_WAIT_QUANTUM_MS 5
+
+TrafficShaper::shaper_class TrafficShaper::_classes[NSAPI_QOS_CLASS_COUNT];
+SingletonPtr<PlatformMutex> TrafficShaper::_mutex;
+
+void TrafficShaper::refill(shaper_class *cls, uint64_t now)
+{
+    uint64_t credit = (now - cls->filled) * cls->rate / 1000;
+    if (credit == 0) {
+        return;
+    }
+    if (credit > cls->burst - cls->tokens) {
+        cls->tokens = cls->burst;
+    } else {
+        cls->tokens += credit;
+    }
+    cls->filled = now;
+}
+
+bool TrafficShaper::higher_class_waiting(uint8_t qos_class)
+{
+    for (uint8_t i = 0; i < qos_class; i++) {
+        if (_classes[i].rate && _classes[i].waiting) {
+            return true;
+        }
+    }
+    return false;
+}
+
+nsapi_error_t TrafficShaper::set_class_rate(uint8_t qos_class, uint32_t bytes_per_second, uint32_t burst_bytes)
+{
+    if ((qos_class >= NSAPI_QOS_CLASS_COUNT) || (bytes_per_second && !burst_bytes)) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    _mutex->lock();
+    shaper_class *cls = &_classes[qos_class];
+    cls->rate = bytes_per_second;
+    cls->burst = burst_bytes;
+    // Start full so the first sends after configuration aren't paced
+    cls->tokens = burst_bytes;
+    cls->filled = rtos::Kernel::get_ms_count();
+    _mutex->unlock();
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t TrafficShaper::acquire(uint8_t qos_class, uint32_t size, uint32_t timeout)
+{
+    if (qos_class >= NSAPI_QOS_CLASS_COUNT) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    shaper_class *cls = &_classes[qos_class];
+    uint64_t deadline = 0;
+    bool waiting = false;
+
+    _mutex->lock();
+    if ((timeout != 0) && (timeout != osWaitForever)) {
+        deadline = rtos::Kernel::get_ms_count() + timeout;
+    }
+
+    while (true) {
+        if (!cls->rate) {
+            // Unshaped class - pass through, but still yield the link
+            // while a shaped higher-priority sender is waiting
+            if (!higher_class_waiting(qos_class)) {
+                break;
+            }
+        } else {
+            uint64_t now = rtos::Kernel::get_ms_count();
+            refill(cls, now);
+
+            // Sends larger than the bucket drain it completely
+            uint32_t needed = (size < cls->burst) ? size : cls->burst;
+            if (!higher_class_waiting(qos_class) && (cls->tokens >= needed)) {
+                cls->tokens -= (size < cls->tokens) ? size : cls->tokens;
+                break;
+            }
+        }
+
+        if (timeout == 0) {
+            _mutex->unlock();
+            return NSAPI_ERROR_WOULD_BLOCK;
+        }
+        if (deadline && (rtos::Kernel::get_ms_count() >= deadline)) {
+            if (waiting) {
+                cls->waiting--;
+            }
+            _mutex->unlock();
+            return NSAPI_ERROR_WOULD_BLOCK;
+        }
+
+        // Advertise the pending demand so lower classes hold off
+        if (!waiting && cls->rate) {
+            cls->waiting++;
+            waiting = true;
+        }
+
+        _mutex->unlock();
+        rtos::ThisThread::sleep_for(SHAPER_WAIT_QUANTUM_MS);
+        _mutex->lock();
+    }
+
+    if (waiting) {
+        cls->waiting--;
+    }
+    _mutex->unlock();
+    return NSAPI_ERROR_OK;
+}
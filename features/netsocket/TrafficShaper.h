@@ -0,0 +1,95 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRAFFIC_SHAPER_H
+#define TRAFFIC_SHAPER_H
+
+#include "platform/SingletonPtr.h"
+#include "platform/PlatformMutex.h"
+#include "netsocket/nsapi_types.h"
+
+/** Number of traffic-shaping QoS classes, 0 is the highest priority */
+#define NSAPI_QOS_CLASS_COUNT 4
+
+/**  TrafficShaper class
+ *
+ *   Token-bucket pacing shared by all sockets, arbitrating one network
+ *   link between traffic classes. A socket joins a class with the
+ *   NSAPI_QOS_CLASS socket option; each class has a byte rate and burst
+ *   allowance set by the application. Sends from a class with no rate
+ *   configured pass through untouched, so nothing changes until classes
+ *   are set up.
+ *
+ *   Scheduling between classes is strict priority: while a sender of a
+ *   higher-priority (lower-numbered) shaped class is waiting for
+ *   tokens, lower-priority classes do not draw any, so bulk transfers
+ *   yield the link to interactive and telemetry traffic instead of
+ *   starving it.
+ */
+class TrafficShaper {
+public:
+
+    /** Configure the token bucket of a QoS class
+     *
+     *  @param qos_class        Class to configure, 0 (highest priority) to
+     *                          NSAPI_QOS_CLASS_COUNT - 1
+     *  @param bytes_per_second Sustained rate the class may send at,
+     *                          0 to leave the class unshaped
+     *  @param burst_bytes      Bucket depth - the largest burst the class
+     *                          may send after idling
+     *  @return                 NSAPI_ERROR_OK, or NSAPI_ERROR_PARAMETER on
+     *                          an invalid class or a burst smaller than
+     *                          one MTU-sized send
+     */
+    static nsapi_error_t set_class_rate(uint8_t qos_class, uint32_t bytes_per_second, uint32_t burst_bytes);
+
+    /** Take tokens for a send, waiting if the class is over its rate
+     *
+     *  Called by the socket layer before handing data to the stack; not
+     *  an application API. Sends larger than the bucket depth drain the
+     *  bucket completely instead of blocking forever.
+     *
+     *  @param qos_class Class the sending socket belongs to
+     *  @param size      Number of bytes about to be sent
+     *  @param timeout   Socket timeout - 0 returns immediately with
+     *                   NSAPI_ERROR_WOULD_BLOCK when tokens are short,
+     *                   osWaitForever waits without limit
+     *  @return          NSAPI_ERROR_OK when the send may proceed,
+     *                   NSAPI_ERROR_WOULD_BLOCK on timeout
+     */
+    static nsapi_error_t acquire(uint8_t qos_class, uint32_t size, uint32_t timeout);
+
+private:
+    /** One token bucket per QoS class */
+    struct shaper_class {
+        uint32_t rate;     /**< Sustained bytes per second, 0 if unshaped */
+        uint32_t burst;    /**< Bucket depth in bytes */
+        uint32_t tokens;   /**< Bytes currently available */
+        uint64_t filled;   /**< Kernel ms count of the last refill */
+        uint8_t  waiting;  /**< Senders blocked waiting for tokens */
+    };
+
+    /* Credit a bucket for the time passed since its last refill */
+    static void refill(shaper_class *cls, uint64_t now);
+
+    /* True while a shaped class above qos_class has a sender waiting */
+    static bool higher_class_waiting(uint8_t qos_class);
+
+    static shaper_class _classes[NSAPI_QOS_CLASS_COUNT];
+    static SingletonPtr<PlatformMutex> _mutex;
+};
+
+#endif /* TRAFFIC_SHAPER_H */
@@ -15,6 +15,7 @@
  */
 
 #include "UDPSocket.h"
+#include "TrafficShaper.h"
 #include "Timer.h"
 #include "mbed_assert.h"
 
@@ -64,6 +65,23 @@ nsapi_size_or_error_t UDPSocket::sendto(const SocketAddress &address, const void
         _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
         _socket_stats.stats_update_peer(this, address);
     }
+
+    // Pace against the socket's QoS class before taking link capacity,
+    // releasing the lock so other threads aren't held while we wait
+    _lock.unlock();
+    nsapi_error_t paced = TrafficShaper::acquire(_qos_class, size, _timeout);
+    _lock.lock();
+    if (paced != NSAPI_ERROR_OK) {
+        _writers--;
+        if (!_socket || !_writers) {
+#ifdef MBED_CONF_RTOS_PRESENT
+            _event_flag.set(FINISHED_FLAG);
+#endif
+        }
+        _lock.unlock();
+        return paced;
+    }
+
     while (true) {
         if (!_socket) {
             ret = NSAPI_ERROR_NO_SOCKET;
@@ -109,6 +127,65 @@ nsapi_size_or_error_t UDPSocket::sendto(const SocketAddress &address, const void
     return ret;
 }
 
+nsapi_error_t UDPSocket::acquire_tx_buffer(nsapi_buffer_t *buffer, nsapi_size_t size)
+{
+    _lock.lock();
+    nsapi_error_t ret;
+
+    if (!_socket) {
+        ret = NSAPI_ERROR_NO_SOCKET;
+    } else {
+        ret = _stack->socket_acquire_tx_buffer(_socket, size, buffer);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_size_or_error_t UDPSocket::sendto_tx_buffer(const SocketAddress &address, const nsapi_buffer_t *buffer, nsapi_size_t size)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    _writers++;
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+        _socket_stats.stats_update_peer(this, address);
+    }
+
+    if (!_socket) {
+        ret = NSAPI_ERROR_NO_SOCKET;
+    } else {
+        _pending = 0;
+        ret = _stack->socket_send_tx_buffer(_socket, address, buffer, size);
+        _socket_stats.stats_update_sent_bytes(this, ret);
+    }
+
+    _writers--;
+    if (!_socket || !_writers) {
+#ifdef MBED_CONF_RTOS_PRESENT
+        _event_flag.set(FINISHED_FLAG);
+#endif
+    }
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_error_t UDPSocket::release_tx_buffer(const nsapi_buffer_t *buffer)
+{
+    _lock.lock();
+    nsapi_error_t ret;
+
+    if (!_socket) {
+        ret = NSAPI_ERROR_NO_SOCKET;
+    } else {
+        ret = _stack->socket_release_tx_buffer(_socket, buffer);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
 nsapi_size_or_error_t UDPSocket::send(const void *data, nsapi_size_t size)
 {
     if (!_remote_peer) {
@@ -191,6 +268,93 @@ nsapi_size_or_error_t UDPSocket::recv(void *buffer, nsapi_size_t size)
     return recvfrom(NULL, buffer, size);
 }
 
+nsapi_size_or_error_t UDPSocket::recvfrom_multiple(packet_view *views, nsapi_size_t count)
+{
+    if (!views || count == 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+    nsapi_size_t received = 0;
+
+    _readers++;
+
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+    }
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        nsapi_size_or_error_t recv = NSAPI_ERROR_OK;
+
+        // Drain the datagrams already queued on the socket, one view per
+        // datagram, without releasing the lock in between
+        while (received < count) {
+            packet_view *view = &views[received];
+            recv = _stack->socket_recvfrom(_socket, &view->address, view->data, view->size);
+            if (recv < 0) {
+                break;
+            }
+
+            // Filter incomming packets using connected peer address
+            if (_remote_peer && _remote_peer != view->address) {
+                continue;
+            }
+
+            view->length = recv;
+            received++;
+            _socket_stats.stats_update_recv_bytes(this, recv);
+        }
+
+        if (received > 0) {
+            // Return the burst without waiting for the remaining views to fill
+            ret = received;
+            break;
+        }
+
+        // Non-blocking sockets always return. Blocking only returns when success or errors other than WOULD_BLOCK
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != recv)) {
+            ret = recv;
+            break;
+        } else {
+#ifdef MBED_CONF_RTOS_PRESENT
+            uint32_t flag;
+#endif
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+#ifdef MBED_CONF_RTOS_PRESENT
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+#endif
+            _lock.lock();
+
+#ifdef MBED_CONF_RTOS_PRESENT
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+#endif
+        }
+    }
+
+    _readers--;
+    if (!_socket || !_readers) {
+#ifdef MBED_CONF_RTOS_PRESENT
+        _event_flag.set(FINISHED_FLAG);
+#endif
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
 Socket *UDPSocket::accept(nsapi_error_t *error)
 {
     if (error) {
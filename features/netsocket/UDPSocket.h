@@ -113,6 +113,81 @@ public:
     virtual nsapi_size_or_error_t recvfrom(SocketAddress *address,
                                            void *data, nsapi_size_t size);
 
+    /** One datagram of a batch receive.
+     */
+    struct packet_view {
+        SocketAddress address;       /**< Destination for the source address */
+        void *data;                  /**< Destination buffer for the datagram */
+        nsapi_size_t size;           /**< Size of the buffer in bytes */
+        nsapi_size_or_error_t length; /**< Filled with the received length */
+    };
+
+    /** Receive several queued datagrams in one call.
+     *
+     *  Drains datagrams already queued on the socket into the views,
+     *  paying the socket lock and the trip into the stack once per burst
+     *  instead of once per packet. Each view is filled with one datagram
+     *  and its source address.
+     *
+     *  By default, recvfrom_multiple blocks until at least one datagram
+     *  is received, then returns with however many more were already
+     *  queued, without waiting for the views to fill. If socket is set
+     *  to nonblocking or times out with no datagram,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned.
+     *
+     *  @note If a datagram is larger than its view's buffer, the excess
+     *  data is silently discarded.
+     *
+     *  @note If socket is connected, only packets coming from connected peer
+     *  address are accepted.
+     *
+     *  @param views    Array of datagram views to fill.
+     *  @param count    Number of elements in views.
+     *  @return         Number of datagrams received on success, negative
+     *                  error code on failure.
+     */
+    nsapi_size_or_error_t recvfrom_multiple(packet_view *views, nsapi_size_t count);
+
+    /** Acquire a transmit buffer from the network stack.
+     *
+     *  Leases one of the stack's own transmit buffers: the application
+     *  fills buffer->data in place and commits it with sendto_tx_buffer(),
+     *  so the datagram is sent without the per-packet copy that sendto()
+     *  performs. A lease that is not sent must be handed back with
+     *  release_tx_buffer().
+     *
+     *  Stacks that cannot lease their transmit buffers return
+     *  NSAPI_ERROR_UNSUPPORTED, in which case the caller should fall back
+     *  to sendto().
+     *
+     *  @param buffer   Destination for the description of the leased buffer.
+     *  @param size     Requested payload capacity in bytes.
+     *  @return         NSAPI_ERROR_OK on success, negative error code on failure.
+     */
+    nsapi_error_t acquire_tx_buffer(nsapi_buffer_t *buffer, nsapi_size_t size);
+
+    /** Send a buffer acquired with acquire_tx_buffer() to the specified address.
+     *
+     *  Transmits the leased buffer's contents without copying. The lease
+     *  is consumed whatever the outcome - the buffer must not be accessed
+     *  or released afterwards.
+     *
+     *  @param address  The SocketAddress of the remote host.
+     *  @param buffer   Buffer previously filled in by acquire_tx_buffer().
+     *  @param size     Number of bytes to send, at most the leased capacity.
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure.
+     */
+    nsapi_size_or_error_t sendto_tx_buffer(const SocketAddress &address,
+                                           const nsapi_buffer_t *buffer, nsapi_size_t size);
+
+    /** Release an unsent buffer acquired with acquire_tx_buffer().
+     *
+     *  @param buffer   Buffer previously filled in by acquire_tx_buffer().
+     *  @return         NSAPI_ERROR_OK on success, negative error code on failure.
+     */
+    nsapi_error_t release_tx_buffer(const nsapi_buffer_t *buffer);
+
     /** Set the remote address for next send() call and filtering
      *  of incoming packets. To reset the address, zero initialized
      *  SocketAddress must be in the address parameter.
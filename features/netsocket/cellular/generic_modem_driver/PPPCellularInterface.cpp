@@ -50,6 +50,18 @@ using namespace mbed;
 #define AT_PARSER_TIMEOUT       8*1000 //miliseconds
 #endif //MBED_CONF_PPP_CELL_IFACE_AT_PARSER_TIMEOUT
 
+#if MBED_CONF_PPP_CELL_IFACE_BAUD_RATE
+#define UART_BAUD_RATE          MBED_CONF_PPP_CELL_IFACE_BAUD_RATE
+#else
+#define UART_BAUD_RATE          115200
+#endif //MBED_CONF_PPP_CELL_IFACE_BAUD_RATE
+
+#if MBED_CONF_PPP_CELL_IFACE_BAUD_RATE_MAX
+#define UART_BAUD_RATE_MAX      MBED_CONF_PPP_CELL_IFACE_BAUD_RATE_MAX
+#else
+#define UART_BAUD_RATE_MAX      UART_BAUD_RATE
+#endif //MBED_CONF_PPP_CELL_IFACE_BAUD_RATE_MAX
+
 static bool initialized;
 static bool set_sim_pin_check_request;
 static bool change_pin;
@@ -300,6 +312,17 @@ void PPPCellularInterface::modem_power_down()
     //meant to be overridden
 }
 
+void PPPCellularInterface::modem_set_baud(int baud)
+{
+    //meant to be overridden
+}
+
+bool PPPCellularInterface::modem_enable_flow_control()
+{
+    //meant to be overridden
+    return false;
+}
+
 void PPPCellularInterface::modem_debug_on(bool on)
 {
     _debug_trace_on = on;
@@ -802,15 +825,19 @@ bool PPPCellularInterface::power_up()
                         "E0;" //turn off modem echoing
                         "+CMEE=2;"//turn on verbose responses
                         "&K0"//turn off RTC/CTS handshaking
-                        "+IPR=115200;"//setup baud rate
+                        "+IPR=%d;"//setup baud rate
                         "&C1;"//set DCD circuit(109), changes in accordance with the carrier detect status
-                        "&D0")//set DTR circuit, we ignore the state change of DTR
+                        "&D0",//set DTR circuit, we ignore the state change of DTR
+                        UART_BAUD_RATE)
               && _at->recv("OK");
 
     if (!success) {
         goto failure;
     }
 
+    /* Best effort: a failed negotiation leaves us at the bring-up rate */
+    negotiate_baud_rate();
+
     /* If everything alright, return from here with success*/
     return success;
 
@@ -819,6 +846,75 @@ failure:
     return false;
 }
 
+/**
+ * Moves the UART to the highest rate both ends support
+ *
+ * The modem is brought up at the safe configured rate first; only once the
+ * AT link is known good do we command it higher with +IPR. Rates above the
+ * bring-up rate are attempted only with CTS/RTS handshaking in place - at
+ * multi-megabit rates an unthrottled burst overruns the UART FIFO long
+ * before PPP gets a look in.
+ */
+void PPPCellularInterface::negotiate_baud_rate()
+{
+    /* Candidate rates in descending order */
+    static const int candidates[] = {3000000, 921600, 460800, 230400};
+
+    if (UART_BAUD_RATE_MAX <= UART_BAUD_RATE) {
+        /* negotiation not enabled in the configuration */
+        return;
+    }
+
+    if (!modem_enable_flow_control()) {
+        tr_debug("No CTS/RTS available, staying at %d baud", UART_BAUD_RATE);
+        return;
+    }
+
+    /* Turn on CTS/RTS handshaking on the modem side; the preliminary setup
+     * switched it off for the bring-up probe */
+    if (!(_at->send("AT&K3") && _at->recv("OK"))) {
+        tr_warn("Modem rejected CTS/RTS handshaking");
+        return;
+    }
+
+    for (unsigned i = 0; i < sizeof(candidates) / sizeof(candidates[0]); i++) {
+        int rate = candidates[i];
+        if (rate > UART_BAUD_RATE_MAX || rate <= UART_BAUD_RATE) {
+            continue;
+        }
+
+        /* The modem acknowledges at the old rate and switches after the OK */
+        if (!(_at->send("AT+IPR=%d", rate) && _at->recv("OK"))) {
+            /* rate not supported by the modem, still at the old rate */
+            continue;
+        }
+
+        /* Let the OK drain off the wire before retuning our end */
+        wait_ms(100);
+        modem_set_baud(rate);
+        _at->flush();
+
+        /* Re-sync: the first exchange after a rate switch may be garbled */
+        bool verified = false;
+        for (int retry = 0; retry < 3 && !verified; retry++) {
+            verified = _at->send("AT") && _at->recv("OK");
+        }
+        if (verified) {
+            tr_info("UART rate negotiated to %d baud", rate);
+            return;
+        }
+
+        /* No contact at the new rate - fall back to the bring-up rate and
+         * check the modem is still with us before trying a lower rate */
+        modem_set_baud(UART_BAUD_RATE);
+        _at->flush();
+        if (!(_at->send("AT+IPR=%d", UART_BAUD_RATE) && _at->recv("OK"))) {
+            tr_warn("Modem lost after baud change, staying at %d baud", UART_BAUD_RATE);
+            return;
+        }
+    }
+}
+
 /**
  * Get a pointer to the underlying network stack
  */
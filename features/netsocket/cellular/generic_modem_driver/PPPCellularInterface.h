@@ -329,6 +329,7 @@ private:
     nsapi_error_t setup_context_and_credentials();
     bool power_up();
     void power_down();
+    void negotiate_baud_rate();
     void ppp_status_cb(nsapi_event_t, intptr_t);
 
 protected:
@@ -389,6 +390,26 @@ protected:
      */
     virtual void modem_power_down();
 
+    /** Changes the baud rate of the serial port attached to the modem
+     *
+     *  Called during baud rate negotiation, after the modem has been commanded
+     *  to a new rate with +IPR, to retune the local end of the link.
+     *  It is meant to be overridden; the default implementation does nothing,
+     *  which together with the default modem_enable_flow_control() keeps the
+     *  link at the configured bring-up rate.
+     */
+    virtual void modem_set_baud(int baud);
+
+    /** Enables CTS/RTS flow control on the serial port attached to the modem
+     *
+     *  Rates above the bring-up rate are only attempted when this succeeds.
+     *  It is meant to be overridden; the default implementation reports no
+     *  flow control, which disables baud rate negotiation.
+     *
+     *  @return true if hardware flow control is now active on the local end
+     */
+    virtual bool modem_enable_flow_control();
+
     /** Provide access to the underlying stack
      *
      *  @return The underlying network stack
@@ -23,6 +23,8 @@ UARTCellularInterface::UARTCellularInterface(PinName txd, PinName rxd, PinName d
     _serial(txd, rxd, baud)
 {
     _dcd_pin = dcd;
+    _rts_pin = rts;
+    _cts_pin = cts;
     _active_high = active_high;
 }
 
@@ -36,4 +38,20 @@ void UARTCellularInterface::enable_hup(bool enable)
     _serial.set_data_carrier_detect(enable ? _dcd_pin : NC, _active_high);
 }
 
+void UARTCellularInterface::modem_set_baud(int baud)
+{
+    _serial.set_baud(baud);
+}
+
+bool UARTCellularInterface::modem_enable_flow_control()
+{
+#if DEVICE_SERIAL_FC
+    if (_rts_pin != NC && _cts_pin != NC) {
+        _serial.set_flow_control(mbed::SerialBase::RTSCTS, _rts_pin, _cts_pin);
+        return true;
+    }
+#endif
+    return false;
+}
+
 #endif // NSAPI_PPP_AVAILABLE
@@ -56,6 +56,8 @@ public:
 private:
     mbed::UARTSerial _serial;
     PinName _dcd_pin;
+    PinName _rts_pin;
+    PinName _cts_pin;
     bool _active_high;
 
 protected:
@@ -70,6 +72,20 @@ protected:
      */
     MBED_DEPRECATED_SINCE("mbed-os-5.9", "This API will be deprecated, use mbed-os/features/cellular/easy_cellular/EasyCellularConnection.h instead.")
     virtual void enable_hup(bool enable);
+
+    /** Changes the baud rate of the UART during baud rate negotiation
+     *
+     *  @deprecated This API will be deprecated in mbed-os-5.9. Use mbed-os/features/cellular/easy_cellular/EasyCellularConnection.h instead.
+     */
+    MBED_DEPRECATED_SINCE("mbed-os-5.9", "This API will be deprecated, use mbed-os/features/cellular/easy_cellular/EasyCellularConnection.h instead.")
+    virtual void modem_set_baud(int baud);
+
+    /** Enables CTS/RTS on the UART when the pins were given in the constructor
+     *
+     *  @deprecated This API will be deprecated in mbed-os-5.9. Use mbed-os/features/cellular/easy_cellular/EasyCellularConnection.h instead.
+     */
+    MBED_DEPRECATED_SINCE("mbed-os-5.9", "This API will be deprecated, use mbed-os/features/cellular/easy_cellular/EasyCellularConnection.h instead.")
+    virtual bool modem_enable_flow_control();
 };
 
 #endif //NSAPI_PPP_AVAILABLE
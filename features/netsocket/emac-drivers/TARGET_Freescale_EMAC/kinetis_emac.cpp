@@ -146,10 +146,14 @@ void Kinetis_EMAC::tx_reclaim()
 
 /** \brief Ethernet receive interrupt handler
  *
- *  This function handles the receive interrupt.
+ *  This function handles the receive interrupt. Further receive
+ *  interrupts are masked until the worker thread drains the descriptor
+ *  ring, so a packet flood costs one interrupt and one thread wakeup
+ *  per ring drain rather than per frame.
  */
 void Kinetis_EMAC::rx_isr()
 {
+    ENET_DisableInterrupts(ENET, kENET_RxFrameInterrupt);
     if (thread) {
         osThreadFlagsSet(thread, FLAG_RX);
     }
@@ -203,7 +207,7 @@ bool Kinetis_EMAC::low_level_init_successful()
 
     /* Create buffers for each receive BD */
     for (i = 0; i < ENET_RX_RING_LEN; i++) {
-        rx_buff[i] = memory_manager->alloc_heap(ENET_ETH_MAX_FLEN, ENET_BUFF_ALIGNMENT);
+        rx_buff[i] = memory_manager->alloc_rx_buf(ENET_ETH_MAX_FLEN, ENET_BUFF_ALIGNMENT);
         if (NULL == rx_buff[i])
             return false;
 
@@ -293,7 +297,7 @@ emac_mem_buf_t *Kinetis_EMAC::low_level_input(int idx)
         memory_manager->set_len(p, length);
 
         /* Attempt to queue new buffer */
-        temp_rxbuf = memory_manager->alloc_heap(ENET_ETH_MAX_FLEN, ENET_BUFF_ALIGNMENT);
+        temp_rxbuf = memory_manager->alloc_rx_buf(ENET_ETH_MAX_FLEN, ENET_BUFF_ALIGNMENT);
         if (NULL == temp_rxbuf) {
             /* Re-queue the same buffer */
             update_read_buffer(NULL);
@@ -362,17 +366,33 @@ void Kinetis_EMAC::thread_function(void* pvParameters)
 
 /** \brief  Packet reception task
  *
- * This task is called when a packet is received. It will
- * pass the packet to the LWIP core.
+ * This task is called when a packet is received. It polls the
+ * descriptor ring with receive interrupts masked and passes up to
+ * ENET_RX_POLL_BUDGET frames to the LWIP core per call. If the budget
+ * is exhausted the thread re-signals itself and keeps polling, so a
+ * sustained flood is absorbed without taking any interrupts; once the
+ * ring drains, receive interrupts are re-enabled.
  */
 void Kinetis_EMAC::packet_rx()
 {
     static int idx = 0;
+    int budget = ENET_RX_POLL_BUDGET;
 
     while ((g_handle.rxBdCurrent->control & ENET_BUFFDESCRIPTOR_RX_EMPTY_MASK) == 0) {
+        if (budget-- == 0) {
+            // Stay in polling mode, but bounce through the flag wait so
+            // pending transmit cleanup can interleave
+            osThreadFlagsSet(thread, FLAG_RX);
+            return;
+        }
         input(idx);
         idx = (idx + 1) % ENET_RX_RING_LEN;
     }
+
+    // Ring drained - leave polling mode. A frame that lands between the
+    // last ring check and the unmask leaves its event flag pending, so
+    // the interrupt fires as soon as it is re-enabled.
+    ENET_EnableInterrupts(ENET, kENET_RxFrameInterrupt);
 }
 
 /** \brief  Transmit cleanup task
@@ -34,6 +34,7 @@
 
 #define ENET_RX_RING_LEN              MBED_CONF_KINETIS_EMAC_RX_RING_LEN
 #define ENET_TX_RING_LEN              MBED_CONF_KINETIS_EMAC_TX_RING_LEN
+#define ENET_RX_POLL_BUDGET           MBED_CONF_KINETIS_EMAC_RX_POLL_BUDGET
 
 #define ENET_ETH_MAX_FLEN             (1522) // recommended size for a VLAN frame
 
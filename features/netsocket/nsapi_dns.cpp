@@ -47,6 +47,7 @@
 struct DNS_CACHE {
     nsapi_addr_t address;
     char *host;
+    nsapi_error_t status;  /*!< NSAPI_ERROR_OK, or the cached failure */
     uint64_t expires;      /*!< time to live in milliseconds */
     uint64_t accessed;     /*!< last accessed */
 };
@@ -87,7 +88,11 @@ struct DNS_QUERY {
 };
 
 static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, uint32_t ttl);
+static void nsapi_dns_cache_add_negative(const char *host);
 static nsapi_size_or_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address);
+#if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
+static void nsapi_dns_cache_store(const char *host, nsapi_addr_t *address, nsapi_error_t status, uint32_t ttl);
+#endif
 
 static nsapi_error_t nsapi_dns_get_server_addr(NetworkStack *stack, uint8_t *index, uint8_t *total_attempts, uint8_t *send_success, SocketAddress *dns_addr);
 
@@ -309,32 +314,40 @@ static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, uint32_t *ttl,
     return count;
 }
 
-static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, uint32_t ttl)
-{
 #if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
+static void nsapi_dns_cache_store(const char *host, nsapi_addr_t *address, nsapi_error_t status, uint32_t ttl)
+{
     // RFC 1034: if TTL is zero, entry is not added to cache
     if (ttl == 0) {
         return;
     }
 
-    // Checks if already cached
-    if (nsapi_dns_cache_find(host, address->version, NULL) == NSAPI_ERROR_OK) {
-        return;
-    }
-
     dns_cache_mutex->lock();
 
     int index = -1;
     uint64_t accessed = UINT64_MAX;
 
-    // Finds free or last accessed entry
+    // Reuses an existing entry for the host, so that a fresh result
+    // replaces a cached failure and vice versa
     for (int i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
-        if (!dns_cache[i]) {
+        if (dns_cache[i] && strcmp(dns_cache[i]->host, host) == 0 &&
+                (status != NSAPI_ERROR_OK || dns_cache[i]->status != NSAPI_ERROR_OK ||
+                 dns_cache[i]->address.version == address->version)) {
             index = i;
             break;
-        } else if (dns_cache[i]->accessed <= accessed) {
-            accessed = dns_cache[i]->accessed;
-            index = i;
+        }
+    }
+
+    // Finds free or last accessed entry
+    if (index < 0) {
+        for (int i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
+            if (!dns_cache[i]) {
+                index = i;
+                break;
+            } else if (dns_cache[i]->accessed <= accessed) {
+                accessed = dns_cache[i]->accessed;
+                index = i;
+            }
         }
     }
 
@@ -351,7 +364,12 @@ static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, uint32_
     }
 
     if (dns_cache[index]) {
-        dns_cache[index]->address = *address;
+        if (address) {
+            dns_cache[index]->address = *address;
+        } else {
+            memset(&dns_cache[index]->address, 0, sizeof(nsapi_addr_t));
+        }
+        dns_cache[index]->status = status;
         dns_cache[index]->host = new (std::nothrow) char[strlen(host) + 1];
         strcpy(dns_cache[index]->host, host);
         uint64_t ms_count = rtos::Kernel::get_ms_count();
@@ -360,6 +378,22 @@ static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, uint32_
     }
 
     dns_cache_mutex->unlock();
+}
+#endif
+
+static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, uint32_t ttl)
+{
+#if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
+    nsapi_dns_cache_store(host, address, NSAPI_ERROR_OK, ttl);
+#endif
+}
+
+static void nsapi_dns_cache_add_negative(const char *host)
+{
+#if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0) && (MBED_CONF_NSAPI_DNS_NEGATIVE_CACHE_TTL > 0)
+    // RFC 2308: cache that the host does not exist, so repeated lookups
+    // of a dead name do not each query the servers again
+    nsapi_dns_cache_store(host, NULL, NSAPI_ERROR_DNS_FAILURE, MBED_CONF_NSAPI_DNS_NEGATIVE_CACHE_TTL);
 #endif
 }
 
@@ -378,13 +412,21 @@ static nsapi_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t vers
                 delete dns_cache[i]->host;
                 delete dns_cache[i];
                 dns_cache[i] = NULL;
-            } else if ((version == NSAPI_UNSPEC || version == dns_cache[i]->address.version) &&
-                       strcmp(dns_cache[i]->host, host) == 0) {
-                if (address) {
-                    *address = dns_cache[i]->address;
+            } else if (strcmp(dns_cache[i]->host, host) == 0) {
+                if (dns_cache[i]->status != NSAPI_ERROR_OK) {
+                    // Cached failure, matches any version; an address
+                    // entry for the host still takes precedence
+                    if (ret_val == NSAPI_ERROR_NO_ADDRESS) {
+                        ret_val = dns_cache[i]->status;
+                    }
+                    dns_cache[i]->accessed = ms_count;
+                } else if (version == NSAPI_UNSPEC || version == dns_cache[i]->address.version) {
+                    if (address) {
+                        *address = dns_cache[i]->address;
+                    }
+                    dns_cache[i]->accessed = ms_count;
+                    ret_val = NSAPI_ERROR_OK;
                 }
-                dns_cache[i]->accessed = ms_count;
-                ret_val = NSAPI_ERROR_OK;
             }
         }
     }
@@ -442,8 +484,12 @@ static nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const
     }
 
     // check cache
-    if (nsapi_dns_cache_find(host, version, addr) == NSAPI_ERROR_OK) {
+    nsapi_error_t cached = nsapi_dns_cache_find(host, version, addr);
+    if (cached == NSAPI_ERROR_OK) {
         return 1;
+    } else if (cached == NSAPI_ERROR_DNS_FAILURE) {
+        // a recent query authoritatively failed
+        return NSAPI_ERROR_DNS_FAILURE;
     }
 
     // create a udp socket
@@ -519,6 +565,9 @@ static nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const
             result = resp;
         } else if (resp < 0) {
             continue;
+        } else {
+            // the name server answered there is no such host
+            nsapi_dns_cache_add_negative(host);
         }
 
         /* The DNS response is final, no need to check other servers */
@@ -586,6 +635,30 @@ nsapi_value_or_error_t nsapi_dns_query_async(NetworkStack *stack, const char *ho
     return nsapi_dns_query_multiple_async(stack, host, callback, 0, call_in_cb, version);
 }
 
+nsapi_error_t nsapi_dns_prewarm(NetworkStack *stack, const char *host, nsapi_version_t version)
+{
+    if (!stack || !host) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    SocketAddress address;
+
+    // literal IP addresses need no resolution
+    if (address.set_ip_address(host)) {
+        return NSAPI_ERROR_OK;
+    }
+
+    if (nsapi_dns_cache_find(host, version, NULL) != NSAPI_ERROR_NO_ADDRESS) {
+        // the address - or a still valid failure - is already cached
+        return NSAPI_ERROR_OK;
+    }
+
+    // the background query's response is stored in the cache as usual,
+    // there is no completion callback to call
+    nsapi_value_or_error_t ret = stack->gethostbyname_async(host, NULL, version);
+    return (ret >= 0) ? NSAPI_ERROR_OK : (nsapi_error_t)ret;
+}
+
 void nsapi_dns_call_in_set(call_in_callback_cb_t callback)
 {
     *dns_call_in.get() = callback;
@@ -608,6 +681,7 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
     dns_mutex->lock();
 
     if (!stack) {
+        dns_mutex->unlock();
         return NSAPI_ERROR_PARAMETER;
     }
 
@@ -619,10 +693,19 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
     }
 
     nsapi_addr address;
-    if (nsapi_dns_cache_find(host, version, &address) == NSAPI_ERROR_OK) {
+    nsapi_error_t cached = nsapi_dns_cache_find(host, version, &address);
+    if (cached == NSAPI_ERROR_OK) {
         SocketAddress addr(address);
         dns_mutex->unlock();
-        callback(NSAPI_ERROR_OK, &addr);
+        if (callback) {
+            callback(NSAPI_ERROR_OK, &addr);
+        }
+        return NSAPI_ERROR_OK;
+    } else if (cached == NSAPI_ERROR_DNS_FAILURE) {
+        dns_mutex->unlock();
+        if (callback) {
+            callback(NSAPI_ERROR_DNS_FAILURE, NULL);
+        }
         return NSAPI_ERROR_OK;
     }
 
@@ -715,28 +798,36 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
 
 static void nsapi_dns_query_async_initiate_next(void)
 {
-    int id = INT32_MAX;
-    DNS_QUERY *query = NULL;
+    int ongoing = 0;
 
-    // Trigger next query to start, find one that has been on queue longest
     for (int i = 0; i < DNS_QUERY_QUEUE_SIZE; i++) {
-        if (dns_query_queue[i]) {
-            if (dns_query_queue[i]->state == DNS_CREATED) {
-                if (dns_query_queue[i]->unique_id <= id) {
-                    query = dns_query_queue[i];
-                    id = dns_query_queue[i]->unique_id;
-                }
-                // If some query is already ongoing do not trigger
-            } else if (dns_query_queue[i]->state == DNS_INITIATED) {
-                query = NULL;
-                break;
-            }
+        if (dns_query_queue[i] && dns_query_queue[i]->state == DNS_INITIATED) {
+            ongoing++;
         }
     }
 
-    if (query) {
+    // Trigger queued queries to start, the ones that have been on queue
+    // longest first, keeping up to the configured number in flight at a
+    // time - responses are matched to queries by DNS message id
+    while (ongoing < MBED_CONF_NSAPI_DNS_PARALLEL_QUERIES) {
+        int id = INT32_MAX;
+        DNS_QUERY *query = NULL;
+
+        for (int i = 0; i < DNS_QUERY_QUEUE_SIZE; i++) {
+            if (dns_query_queue[i] && dns_query_queue[i]->state == DNS_CREATED &&
+                    dns_query_queue[i]->unique_id <= id) {
+                query = dns_query_queue[i];
+                id = dns_query_queue[i]->unique_id;
+            }
+        }
+
+        if (!query) {
+            break;
+        }
+
         query->state = DNS_INITIATED;
         nsapi_dns_call_in(query->call_in_cb, 0, mbed::callback(nsapi_dns_query_async_create, reinterpret_cast<void *>(query->unique_id)));
+        ongoing++;
     }
 }
 
@@ -1131,6 +1222,9 @@ static void nsapi_dns_query_async_response(void *ptr)
             if (query->addr_count > 0) {
                 status = query->count;
             }
+        } else if (status == NSAPI_ERROR_DNS_FAILURE) {
+            // The server responded but had no address for the host
+            nsapi_dns_cache_add_negative(query->host);
         }
 
         nsapi_dns_query_async_resp(query, status, addresses);
@@ -179,6 +179,35 @@ nsapi_size_or_error_t nsapi_dns_query_multiple(S *stack, const char *host,
                                     host, addr, addr_count, version);
 }
 
+/** Pre-warm the DNS cache with the address of a given hostname
+ *
+ *  Starts a background query whose result is stored in the DNS cache,
+ *  so that a later gethostbyname for the host resolves from the cache
+ *  in milliseconds instead of waiting on the network. Does nothing if
+ *  the host is already cached or is a literal IP address.
+ *
+ *  @param stack    Network stack as target for DNS query
+ *  @param host     Hostname to resolve
+ *  @param version  IP version to resolve (defaults to NSAPI_IPv4)
+ *  @return         0 if cached or a query was started, negative error
+ *                  code on failure
+ */
+nsapi_error_t nsapi_dns_prewarm(NetworkStack *stack, const char *host, nsapi_version_t version = NSAPI_IPv4);
+
+/** Pre-warm the DNS cache with the address of a given hostname
+ *
+ *  @param stack    Network stack as target for DNS query
+ *  @param host     Hostname to resolve
+ *  @param version  IP version to resolve (defaults to NSAPI_IPv4)
+ *  @return         0 if cached or a query was started, negative error
+ *                  code on failure
+ */
+template <typename S>
+nsapi_error_t nsapi_dns_prewarm(S *stack, const char *host, nsapi_version_t version = NSAPI_IPv4)
+{
+    return nsapi_dns_prewarm(nsapi_create_stack(stack), host, version);
+}
+
 /** Cancels asynchronous hostname translation
   *
   *  When translation is cancelled, callback will not be called.
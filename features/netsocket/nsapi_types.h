@@ -193,6 +193,44 @@ typedef struct nsapi_addr {
 typedef void *nsapi_socket_t;
 
 
+/** I/O vector element for scatter-gather operations
+ *
+ *  Describes one contiguous piece of a message assembled from several
+ *  buffers, for example a protocol header followed by a payload.
+ */
+typedef struct nsapi_iovec {
+    /** Pointer to the data
+     */
+    const void *iov_base;
+
+    /** Length of the data in bytes
+     */
+    nsapi_size_t iov_len;
+} nsapi_iovec_t;
+
+
+/** View of a network stack owned receive buffer
+ *
+ *  Describes one contiguous fragment of data received by the network
+ *  stack, handed out by a zero-copy receive. The data stays in the
+ *  stack's own buffer and remains valid until the view is handed back
+ *  to the stack.
+ */
+typedef struct nsapi_buffer {
+    /** Pointer to the received data inside the stack's buffer
+     */
+    void *data;
+
+    /** Length of the contiguous fragment in bytes
+     */
+    nsapi_size_t len;
+
+    /** Stack-private buffer handle, must not be modified
+     */
+    void *buffer;
+} nsapi_buffer_t;
+
+
 /** Enum of socket protocols
  *
  *  The socket protocol specifies a particular protocol to
@@ -234,6 +272,7 @@ typedef enum nsapi_stack_option {
  */
 typedef enum nsapi_socket_level {
     NSAPI_SOCKET    = 7000, /*!< Socket option level - see nsapi_socket_option_t for options */
+    NSAPI_TLSSOCKET_LEVEL = 7099, /*!< TLS socket option level - see nsapi_tlssocket_level_option_t for options */
 } nsapi_socket_level_t;
 
 /** Enum of standardized socket option names for level NSAPI_SOCKET
@@ -254,8 +293,30 @@ typedef enum nsapi_socket_option {
     NSAPI_RCVBUF,            /*!< Sets recv buffer size */
     NSAPI_ADD_MEMBERSHIP,    /*!< Add membership to multicast address */
     NSAPI_DROP_MEMBERSHIP,   /*!< Drop membership to multicast address */
+    NSAPI_CORK,              /*!< Hold small sends until uncorked so they coalesce into full segments */
+    NSAPI_RCVWND_AUTOTUNE,   /*!< Scale the TCP receive window by stack buffer pool occupancy */
+    NSAPI_QOS_CLASS,         /*!< Assign the socket to a traffic-shaping QoS class - see TrafficShaper */
 } nsapi_socket_option_t;
 
+/** Enum of standardized socket option names for level NSAPI_TLSSOCKET_LEVEL
+ *  of Socket::setsockopt and getsockopt.
+ *
+ *  Accepted by stacks that terminate TLS on an external module - see
+ *  OffloadNetworkStack. Certificates, keys and the peer hostname are set
+ *  on an open, unconnected socket; NSAPI_TLSSOCKET_ENABLE arms TLS so
+ *  the following connect performs the handshake on the module.
+ *  Stacks without on-module TLS return NSAPI_ERROR_UNSUPPORTED.
+ *
+ *  @enum nsapi_tlssocket_level_option
+ */
+typedef enum nsapi_tlssocket_level_option {
+    NSAPI_TLSSOCKET_SET_HOSTNAME,   /*!< Set hostname for peer certificate verification */
+    NSAPI_TLSSOCKET_SET_CACERT,     /*!< Set server CA certificate */
+    NSAPI_TLSSOCKET_SET_CLCERT,     /*!< Set client certificate */
+    NSAPI_TLSSOCKET_SET_CLKEY,      /*!< Set client private key */
+    NSAPI_TLSSOCKET_ENABLE          /*!< Enable TLS on the socket before connecting */
+} nsapi_tlssocket_level_option_t;
+
 /** Supported IP protocol versions of IP stack
  *
  *  @enum nsapi_ip_stack
@@ -63,6 +63,30 @@ public:
         ~PayloadBuilder() { }
     };
 
+    /**
+     * Position of a record payload within the message being built.
+     *
+     * A view is captured with last_record_view() right after a successful
+     * append and stays valid until the builder is reset. It allows the
+     * payload of a single record to be rewritten in place with
+     * update_record_payload() - headers and length fields are untouched, so
+     * the message stays well formed - instead of re-serializing the whole
+     * message when only one record changed.
+     */
+    struct RecordView {
+        RecordView() : payload_offset(0), payload_size(0) { }
+
+        /**
+         * Offset of the payload in the message buffer.
+         */
+        size_t payload_offset;
+
+        /**
+         * Size of the payload in bytes.
+         */
+        size_t payload_size;
+    };
+
     /**
      * Create a new MessageBuilder that can be used to construct valid NDEF
      * messages.
@@ -168,6 +192,44 @@ public:
      */
     Span<const uint8_t> get_message() const;
 
+    /**
+     * Return the view of the payload of the last record appended.
+     *
+     * @return The view of the last payload appended or an empty view if no
+     * record has been appended since construction or the last reset.
+     */
+    RecordView last_record_view() const;
+
+    /**
+     * Replace the payload of a previously appended record in place.
+     *
+     * The new payload must have exactly the size recorded in the view; the
+     * record header and length fields are left untouched so the update is
+     * valid even once the message is complete.
+     *
+     * @param view The view of the record payload to replace.
+     * @param payload The new payload.
+     *
+     * @return true if the payload has been replaced or false if the sizes
+     * do not match or the view does not refer to serialized data.
+     */
+    bool update_record_payload(const RecordView &view, const RecordPayload &payload);
+
+    /**
+     * Replace the payload of a previously appended record in place.
+     *
+     * The builder must produce exactly the size recorded in the view; the
+     * record header and length fields are left untouched so the update is
+     * valid even once the message is complete.
+     *
+     * @param view The view of the record payload to replace.
+     * @param builder The builder that will construct the new payload.
+     *
+     * @return true if the payload has been replaced or false if the sizes
+     * do not match or the view does not refer to serialized data.
+     */
+    bool update_record_payload(const RecordView &view, const PayloadBuilder &builder);
+
 private:
     // append fields
     void append_header(const Record &record, const PayloadBuilder *);
@@ -185,6 +247,7 @@ private:
     // builder state.
     Span<uint8_t> _message_buffer;
     size_t _position;
+    RecordView _last_record;
     bool _message_started;
     bool _message_ended;
     bool _in_chunk;
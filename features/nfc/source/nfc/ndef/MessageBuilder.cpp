@@ -25,6 +25,7 @@ namespace ndef {
 MessageBuilder::MessageBuilder(const Span<uint8_t> &buffer) :
     _message_buffer(buffer),
     _position(0),
+    _last_record(),
     _message_started(false),
     _message_ended(false),
     _in_chunk(false)
@@ -151,6 +152,7 @@ bool MessageBuilder::append_record(const Record &record, const PayloadBuilder *b
 void MessageBuilder::reset()
 {
     _position = 0;
+    _last_record = RecordView();
     _message_started = false;
     _message_ended = false;
     _in_chunk = false;
@@ -160,6 +162,7 @@ void MessageBuilder::reset(const Span<uint8_t> &buffer)
 {
     _message_buffer = buffer;
     _position = 0;
+    _last_record = RecordView();
     _message_started = false;
     _message_ended = false;
     _in_chunk = false;
@@ -179,6 +182,45 @@ Span<const uint8_t> MessageBuilder::get_message() const
     }
 }
 
+MessageBuilder::RecordView MessageBuilder::last_record_view() const
+{
+    return _last_record;
+}
+
+bool MessageBuilder::update_record_payload(const RecordView &view, const RecordPayload &payload)
+{
+    if (!view.payload_size || view.payload_size != (size_t) payload.size()) {
+        return false;
+    }
+
+    if ((view.payload_offset + view.payload_size) > _position) {
+        return false;
+    }
+
+    memcpy(
+        _message_buffer.data() + view.payload_offset,
+        payload.data(),
+        view.payload_size
+    );
+
+    return true;
+}
+
+bool MessageBuilder::update_record_payload(const RecordView &view, const PayloadBuilder &builder)
+{
+    if (!view.payload_size || view.payload_size != builder.size()) {
+        return false;
+    }
+
+    if ((view.payload_offset + view.payload_size) > _position) {
+        return false;
+    }
+
+    builder.build(_message_buffer.subspan(view.payload_offset, view.payload_size));
+
+    return true;
+}
+
 size_t MessageBuilder::compute_record_size(const Record &record, const PayloadBuilder *builder)
 {
     size_t record_size = 0;
@@ -285,6 +327,8 @@ void MessageBuilder::append_id(const Record &record)
 void MessageBuilder::append_payload(const Record &record, const PayloadBuilder *builder)
 {
     size_t size = get_payload_size(record, builder);
+    _last_record.payload_offset = _position;
+    _last_record.payload_size = size;
     if (!size) {
         return;
     }
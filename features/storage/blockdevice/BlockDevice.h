@@ -21,6 +21,7 @@
 #define MBED_BLOCK_DEVICE_H
 
 #include <stdint.h>
+#include "platform/Callback.h"
 
 namespace mbed {
 
@@ -122,6 +123,91 @@ public:
         return 0;
     }
 
+    /** Read blocks from a block device without blocking on the transaction
+     *
+     *  The callback is invoked with the operation status once the read completes.
+     *  The base class emulates asynchronous behavior by performing the read
+     *  synchronously, so the callback may be invoked before this function returns.
+     *  Drivers whose hardware can run transfers in the background should override
+     *  this, in which case the callback may be invoked from interrupt or another
+     *  thread's context. The buffer must stay valid until the callback is invoked.
+     *
+     *  Only one asynchronous operation may be in flight per device at a time.
+     *
+     *  @param buffer   Buffer to write blocks to
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of the read block size
+     *  @param callback Callback invoked with the read status on completion
+     *  @return         0 if the read was accepted or a negative error code on failure
+     *                  (in which case the callback is not invoked)
+     */
+    virtual int read_async(void *buffer, bd_addr_t addr, bd_size_t size, Callback<void(int)> callback)
+    {
+        int ret = read(buffer, addr, size);
+        if (callback) {
+            callback(ret);
+        }
+        return 0;
+    }
+
+    /** Program blocks to a block device without blocking on the transaction
+     *
+     *  The blocks must have been erased prior to being programmed
+     *
+     *  The callback is invoked with the operation status once the program completes.
+     *  The base class emulates asynchronous behavior by performing the program
+     *  synchronously, so the callback may be invoked before this function returns.
+     *  Drivers whose hardware can run transfers in the background should override
+     *  this, in which case the callback may be invoked from interrupt or another
+     *  thread's context. The buffer must stay valid until the callback is invoked.
+     *
+     *  Only one asynchronous operation may be in flight per device at a time.
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of the program block size
+     *  @param callback Callback invoked with the program status on completion
+     *  @return         0 if the program was accepted or a negative error code on failure
+     *                  (in which case the callback is not invoked)
+     */
+    virtual int program_async(const void *buffer, bd_addr_t addr, bd_size_t size, Callback<void(int)> callback)
+    {
+        int ret = program(buffer, addr, size);
+        if (callback) {
+            callback(ret);
+        }
+        return 0;
+    }
+
+    /** Erase blocks on a block device without blocking on the transaction
+     *
+     *  The state of an erased block is undefined until it has been programmed,
+     *  unless get_erase_value returns a non-negative byte value
+     *
+     *  The callback is invoked with the operation status once the erase completes.
+     *  The base class emulates asynchronous behavior by performing the erase
+     *  synchronously, so the callback may be invoked before this function returns.
+     *  Drivers whose hardware can run transfers in the background should override
+     *  this, in which case the callback may be invoked from interrupt or another
+     *  thread's context.
+     *
+     *  Only one asynchronous operation may be in flight per device at a time.
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of the erase block size
+     *  @param callback Callback invoked with the erase status on completion
+     *  @return         0 if the erase was accepted or a negative error code on failure
+     *                  (in which case the callback is not invoked)
+     */
+    virtual int erase_async(bd_addr_t addr, bd_size_t size, Callback<void(int)> callback)
+    {
+        int ret = erase(addr, size);
+        if (callback) {
+            callback(ret);
+        }
+        return 0;
+    }
+
     /** Mark blocks as no longer in use
      *
      *  This function provides a hint to the underlying block device that a region of blocks
@@ -17,9 +17,14 @@
 #include "BufferedBlockDevice.h"
 #include "platform/mbed_assert.h"
 #include "platform/mbed_critical.h"
+#include "platform/mbed_dma_memcpy.h"
 #include <algorithm>
 #include <string.h>
 
+#ifndef MBED_CONF_BLOCKDEVICE_WRITE_CACHE_UNITS
+#define MBED_CONF_BLOCKDEVICE_WRITE_CACHE_UNITS 4
+#endif
+
 namespace mbed {
 
 static inline uint32_t align_down(bd_size_t val, bd_size_t size)
@@ -28,7 +33,9 @@ static inline uint32_t align_down(bd_size_t val, bd_size_t size)
 }
 
 BufferedBlockDevice::BufferedBlockDevice(BlockDevice *bd)
-    : _bd(bd), _bd_program_size(0), _bd_read_size(0), _write_cache_addr(0), _write_cache_valid(false),
+    : _bd(bd), _bd_program_size(0), _bd_read_size(0), _bd_size(0),
+      _write_cache_units(MBED_CONF_BLOCKDEVICE_WRITE_CACHE_UNITS), _write_cache_addrs(0),
+      _write_cache_dirty(0), _write_cache_evict_ind(0),
       _write_cache(0), _read_buf(0), _init_ref_count(0), _is_initialized(false)
 {
 }
@@ -56,7 +63,9 @@ int BufferedBlockDevice::init()
     _bd_size = _bd->size();
 
     if (!_write_cache) {
-        _write_cache = new uint8_t[_bd_program_size];
+        _write_cache = new uint8_t[_write_cache_units * _bd_program_size];
+        _write_cache_addrs = new bd_addr_t[_write_cache_units];
+        _write_cache_dirty = new bool[_write_cache_units];
     }
 
     if (!_read_buf) {
@@ -81,8 +90,15 @@ int BufferedBlockDevice::deinit()
         return BD_ERROR_OK;
     }
 
+    // Best effort - don't drop cached writes on the floor
+    flush();
+
     delete[] _write_cache;
     _write_cache = 0;
+    delete[] _write_cache_addrs;
+    _write_cache_addrs = 0;
+    delete[] _write_cache_dirty;
+    _write_cache_dirty = 0;
     delete[] _read_buf;
     _read_buf = 0;
     _is_initialized = false;
@@ -96,20 +112,82 @@ int BufferedBlockDevice::flush()
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    if (_write_cache_valid) {
-        int ret = _bd->program(_write_cache, _write_cache_addr, _bd_program_size);
+    // Program dirty units in ascending address order, so the underlying device
+    // sees one sequential sweep per flush. Units stay cached (clean) for reads.
+    for (;;) {
+        int ind = -1;
+        for (int i = 0; i < _write_cache_units; i++) {
+            if (_write_cache_dirty[i] && ((ind < 0) || (_write_cache_addrs[i] < _write_cache_addrs[ind]))) {
+                ind = i;
+            }
+        }
+        if (ind < 0) {
+            break;
+        }
+        int ret = _bd->program(_write_cache + ind * _bd_program_size, _write_cache_addrs[ind],
+                               _bd_program_size);
         if (ret) {
             return ret;
         }
-        invalidate_write_cache();
+        _write_cache_dirty[ind] = false;
     }
     return 0;
 }
 
 void BufferedBlockDevice::invalidate_write_cache()
 {
-    _write_cache_addr = _bd_size;
-    _write_cache_valid = false;
+    for (int i = 0; i < _write_cache_units; i++) {
+        _write_cache_addrs[i] = _bd_size;
+        _write_cache_dirty[i] = false;
+    }
+    _write_cache_evict_ind = 0;
+}
+
+int BufferedBlockDevice::find_cache_unit(bd_addr_t addr) const
+{
+    for (int i = 0; i < _write_cache_units; i++) {
+        if (_write_cache_addrs[i] == addr) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int BufferedBlockDevice::allocate_cache_unit(bd_addr_t addr, int &ind)
+{
+    int ret;
+
+    ind = -1;
+    for (int i = 0; i < _write_cache_units; i++) {
+        if (_write_cache_addrs[i] == _bd_size) {
+            ind = i;
+            break;
+        }
+    }
+
+    if (ind < 0) {
+        // Cache full - evict a unit (round robin), flushing it first if dirty
+        ind = _write_cache_evict_ind;
+        _write_cache_evict_ind = (_write_cache_evict_ind + 1) % _write_cache_units;
+        if (_write_cache_dirty[ind]) {
+            ret = _bd->program(_write_cache + ind * _bd_program_size, _write_cache_addrs[ind],
+                               _bd_program_size);
+            if (ret) {
+                return ret;
+            }
+        }
+        _write_cache_addrs[ind] = _bd_size;
+        _write_cache_dirty[ind] = false;
+    }
+
+    // Partial programs need the rest of the unit content, so read it now
+    ret = _bd->read(_write_cache + ind * _bd_program_size, addr, _bd_program_size);
+    if (ret) {
+        return ret;
+    }
+
+    _write_cache_addrs[ind] = addr;
+    return 0;
 }
 
 int BufferedBlockDevice::sync()
@@ -134,37 +212,40 @@ int BufferedBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 
     MBED_ASSERT(_write_cache && _read_buf);
     // Common case - no need to involve write cache or read buffer
-    if (_bd->is_valid_read(addr, size) &&
-            ((addr + size <= _write_cache_addr) || (addr > _write_cache_addr + _bd_program_size))) {
-        return _bd->read(b, addr, size);
+    if (_bd->is_valid_read(addr, size)) {
+        bool overlap = false;
+        for (int i = 0; i < _write_cache_units; i++) {
+            if ((addr + size > _write_cache_addrs[i]) && (addr < _write_cache_addrs[i] + _bd_program_size)) {
+                overlap = true;
+                break;
+            }
+        }
+        if (!overlap) {
+            return _bd->read(b, addr, size);
+        }
     }
 
     uint8_t *buf = static_cast<uint8_t *>(b);
 
-    // Read logic: Split read to chunks, according to whether we cross the write cache
+    // Read logic: Split read to chunks of up to one program unit, taking each
+    // one from the write cache if it holds that unit
     while (size) {
-        bd_size_t chunk;
-        bool read_from_bd = true;
-        if (addr < _write_cache_addr) {
-            chunk = std::min(size, _write_cache_addr - addr);
-        } else if ((addr >= _write_cache_addr) && (addr < _write_cache_addr + _bd_program_size)) {
-            // One case we need to take our data from cache
-            chunk = std::min(size, _bd_program_size - addr % _bd_program_size);
-            memcpy(buf, _write_cache + addr % _bd_program_size, chunk);
-            read_from_bd = false;
-        } else {
-            chunk = size;
-        }
+        bd_addr_t unit_addr = align_down(addr, _bd_program_size);
+        bd_size_t offs_in_unit = addr - unit_addr;
+        bd_size_t chunk = std::min(size, _bd_program_size - offs_in_unit);
+        int ind = find_cache_unit(unit_addr);
 
-        // Now, in case we read from the BD, make sure we are aligned with its read size.
-        // If not, use read buffer as a helper.
-        if (read_from_bd) {
+        if (ind >= 0) {
+            mbed_dma_memcpy(buf, _write_cache + ind * _bd_program_size + offs_in_unit, chunk);
+        } else {
+            // Read from the BD, making sure we are aligned with its read size.
+            // If not, use read buffer as a helper.
             bd_size_t offs_in_read_buf = addr % _bd_read_size;
             int ret;
             if (offs_in_read_buf || (chunk < _bd_read_size)) {
                 chunk = std::min(chunk, _bd_read_size - offs_in_read_buf);
                 ret = _bd->read(_read_buf, addr - offs_in_read_buf, _bd_read_size);
-                memcpy(buf, _read_buf + offs_in_read_buf, chunk);
+                mbed_dma_memcpy(buf, _read_buf + offs_in_read_buf, chunk);
             } else {
                 chunk = align_down(chunk, _bd_read_size);
                 ret = _bd->read(buf, addr, chunk);
@@ -192,62 +273,40 @@ int BufferedBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 
     int ret;
 
-    bd_addr_t aligned_addr = align_down(addr, _bd_program_size);
-
     const uint8_t *buf = static_cast <const uint8_t *>(b);
 
-    // Need to flush if moved to another program unit
-    if (aligned_addr != _write_cache_addr) {
-        ret = flush();
-        if (ret) {
-            return ret;
-        }
-        _write_cache_addr = aligned_addr;
-    }
-
-    // Write logic: Keep data in cache as long as we don't reach the end of the program unit.
-    // Otherwise, program to the underlying BD.
+    // Write logic: Partial program units are collected in the write cache until
+    // flushed (by sync, eviction or an overlapping erase). Whole units are
+    // programmed directly to the underlying BD.
     while (size) {
-        _write_cache_addr = align_down(addr, _bd_program_size);
-        bd_addr_t offs_in_buf = addr - _write_cache_addr;
+        bd_addr_t unit_addr = align_down(addr, _bd_program_size);
+        bd_addr_t offs_in_unit = addr - unit_addr;
         bd_size_t chunk;
-        if (offs_in_buf) {
-            chunk = std::min(_bd_program_size - offs_in_buf, size);
-        } else if (size >= _bd_program_size) {
-            chunk = align_down(size, _bd_program_size);
-        } else {
-            chunk = size;
-        }
 
-        const uint8_t *prog_buf;
-        if (chunk < _bd_program_size) {
-            // If cache not valid, and program doesn't cover an entire unit, it means we need to
-            // read it from the underlying BD
-            if (!_write_cache_valid) {
-                ret = _bd->read(_write_cache, _write_cache_addr, _bd_program_size);
-                if (ret) {
-                    return ret;
+        if (!offs_in_unit && (size >= _bd_program_size)) {
+            // Whole program units - program directly, dropping stale cached units
+            chunk = align_down(size, _bd_program_size);
+            for (int i = 0; i < _write_cache_units; i++) {
+                if ((_write_cache_addrs[i] >= addr) && (_write_cache_addrs[i] < addr + chunk)) {
+                    _write_cache_addrs[i] = _bd_size;
+                    _write_cache_dirty[i] = false;
                 }
             }
-            memcpy(_write_cache + offs_in_buf, buf, chunk);
-            prog_buf = _write_cache;
-        } else {
-            prog_buf = buf;
-        }
-
-        // Only program if we reached the end of a program unit
-        if (!((offs_in_buf + chunk) % _bd_program_size)) {
-            ret = _bd->program(prog_buf, _write_cache_addr, std::max(chunk, _bd_program_size));
+            ret = _bd->program(buf, addr, chunk);
             if (ret) {
                 return ret;
             }
-            ret = _bd->sync();
-            if (ret) {
-                return ret;
-            }
-            invalidate_write_cache();
         } else {
-            _write_cache_valid = true;
+            chunk = std::min(_bd_program_size - offs_in_unit, size);
+            int ind = find_cache_unit(unit_addr);
+            if (ind < 0) {
+                ret = allocate_cache_unit(unit_addr, ind);
+                if (ret) {
+                    return ret;
+                }
+            }
+            mbed_dma_memcpy(_write_cache + ind * _bd_program_size + offs_in_unit, buf, chunk);
+            _write_cache_dirty[ind] = true;
         }
 
         buf += chunk;
@@ -265,8 +324,11 @@ int BufferedBlockDevice::erase(bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    if ((_write_cache_addr >= addr) && (_write_cache_addr <= addr + size)) {
-        invalidate_write_cache();
+    for (int i = 0; i < _write_cache_units; i++) {
+        if ((_write_cache_addrs[i] >= addr) && (_write_cache_addrs[i] <= addr + size)) {
+            _write_cache_addrs[i] = _bd_size;
+            _write_cache_dirty[i] = false;
+        }
     }
     return _bd->erase(addr, size);
 }
@@ -278,8 +340,11 @@ int BufferedBlockDevice::trim(bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    if ((_write_cache_addr >= addr) && (_write_cache_addr <= addr + size)) {
-        invalidate_write_cache();
+    for (int i = 0; i < _write_cache_units; i++) {
+        if ((_write_cache_addrs[i] >= addr) && (_write_cache_addrs[i] <= addr + size)) {
+            _write_cache_addrs[i] = _bd_size;
+            _write_cache_dirty[i] = false;
+        }
     }
     return _bd->trim(addr, size);
 }
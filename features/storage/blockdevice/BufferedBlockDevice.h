@@ -163,14 +163,16 @@ protected:
     bd_size_t _bd_program_size;
     bd_size_t _bd_read_size;
     bd_size_t _bd_size;
-    bd_size_t _write_cache_addr;
-    bool _write_cache_valid;
+    int _write_cache_units;
+    bd_addr_t *_write_cache_addrs;
+    bool *_write_cache_dirty;
+    int _write_cache_evict_ind;
     uint8_t *_write_cache;
     uint8_t *_read_buf;
     uint32_t _init_ref_count;
     bool _is_initialized;
 
-    /** Flush data in cache
+    /** Flush dirty cache units to the underlying device, in ascending address order
      *
      *  @return         0 on success or a negative error code on failure
      */
@@ -182,6 +184,23 @@ protected:
      */
     void invalidate_write_cache();
 
+    /** Find the cache unit holding a given (aligned) program unit address
+     *
+     *  @param addr     Program unit address
+     *  @return         Cache unit index, or -1 if not cached
+     */
+    int find_cache_unit(bd_addr_t addr) const;
+
+    /** Allocate a cache unit for a given (aligned) program unit address,
+     *  evicting the oldest allocated unit if the cache is full, and load the
+     *  current unit content from the underlying device.
+     *
+     *  @param addr     Program unit address
+     *  @param ind      Allocated cache unit index
+     *  @return         0 on success or a negative error code on failure
+     */
+    int allocate_cache_unit(bd_addr_t addr, int &ind);
+
 };
 } // namespace mbed
 
@@ -0,0 +1,311 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CachedBlockDevice.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+#include <algorithm>
+#include <string.h>
+
+#ifndef MBED_CONF_BLOCKDEVICE_READ_CACHE_BLOCKS
+#define MBED_CONF_BLOCKDEVICE_READ_CACHE_BLOCKS 8
+#endif
+
+#ifndef MBED_CONF_BLOCKDEVICE_READ_AHEAD_BLOCKS
+#define MBED_CONF_BLOCKDEVICE_READ_AHEAD_BLOCKS 4
+#endif
+
+namespace mbed {
+
+// Don't cache in units smaller than this, even if the underlying device allows
+// tiny reads - a cache of one-byte blocks is all bookkeeping and no data
+static const bd_size_t min_cache_block_size = 512;
+
+static inline bd_size_t cache_align_down(bd_size_t val, bd_size_t size)
+{
+    return val / size * size;
+}
+
+CachedBlockDevice::CachedBlockDevice(BlockDevice *bd)
+    : _bd(bd), _bd_size(0), _cache_block_size(0),
+      _num_cache_blocks(MBED_CONF_BLOCKDEVICE_READ_CACHE_BLOCKS),
+      _num_read_ahead_blocks(MBED_CONF_BLOCKDEVICE_READ_AHEAD_BLOCKS),
+      _cache(0), _cache_addrs(0), _cache_stamps(0), _stamp(0), _seq_next_addr(0),
+      _init_ref_count(0), _is_initialized(false)
+{
+}
+
+CachedBlockDevice::~CachedBlockDevice()
+{
+    deinit();
+}
+
+int CachedBlockDevice::init()
+{
+    uint32_t val = core_util_atomic_incr_u32(&_init_ref_count, 1);
+
+    if (val != 1) {
+        return BD_ERROR_OK;
+    }
+
+    int err = _bd->init();
+    if (err) {
+        return err;
+    }
+
+    bd_size_t read_size = _bd->get_read_size();
+    _bd_size = _bd->size();
+
+    // Cache in units of the underlying read block, blown up to a sensible
+    // minimum for devices with byte-granular reads
+    _cache_block_size = read_size;
+    while (_cache_block_size < min_cache_block_size) {
+        _cache_block_size += read_size;
+    }
+
+    if (!_cache) {
+        _cache = new uint8_t[_num_cache_blocks * _cache_block_size];
+        _cache_addrs = new bd_addr_t[_num_cache_blocks];
+        _cache_stamps = new uint64_t[_num_cache_blocks];
+    }
+
+    for (int i = 0; i < _num_cache_blocks; i++) {
+        _cache_addrs[i] = _bd_size;
+        _cache_stamps[i] = 0;
+    }
+    _stamp = 0;
+    _seq_next_addr = _bd_size;
+
+    _is_initialized = true;
+    return BD_ERROR_OK;
+}
+
+int CachedBlockDevice::deinit()
+{
+    if (!_is_initialized) {
+        return BD_ERROR_OK;
+    }
+
+    uint32_t val = core_util_atomic_decr_u32(&_init_ref_count, 1);
+
+    if (val) {
+        return BD_ERROR_OK;
+    }
+
+    delete[] _cache;
+    _cache = 0;
+    delete[] _cache_addrs;
+    _cache_addrs = 0;
+    delete[] _cache_stamps;
+    _cache_stamps = 0;
+    _is_initialized = false;
+    return _bd->deinit();
+}
+
+int CachedBlockDevice::sync()
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return _bd->sync();
+}
+
+void CachedBlockDevice::invalidate_range(bd_addr_t addr, bd_size_t size)
+{
+    for (int i = 0; i < _num_cache_blocks; i++) {
+        if ((_cache_addrs[i] + _cache_block_size > addr) && (_cache_addrs[i] < addr + size)) {
+            _cache_addrs[i] = _bd_size;
+            _cache_stamps[i] = 0;
+        }
+    }
+}
+
+int CachedBlockDevice::find_cache_block(bd_addr_t addr) const
+{
+    for (int i = 0; i < _num_cache_blocks; i++) {
+        if (_cache_addrs[i] == addr) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int CachedBlockDevice::fill_cache_blocks(bd_addr_t addr, int nblocks, int &ind)
+{
+    // Clamp to device end (the last cache block may only be partially backed)
+    int max_blocks = (_bd_size - addr + _cache_block_size - 1) / _cache_block_size;
+    nblocks = std::min(nblocks, std::min(max_blocks, _num_cache_blocks));
+
+    // A multi-block fill needs consecutive cache blocks, so it can be issued as
+    // one underlying read. Pick the least recently used window.
+    int window = 0;
+    uint64_t best_stamps = (uint64_t) -1;
+    for (int i = 0; i + nblocks <= _num_cache_blocks; i++) {
+        uint64_t stamps = 0;
+        for (int j = i; j < i + nblocks; j++) {
+            stamps += _cache_stamps[j];
+        }
+        if (stamps < best_stamps) {
+            best_stamps = stamps;
+            window = i;
+        }
+    }
+
+    // Evicted blocks must be marked invalid first, in case the read fails
+    for (int i = window; i < window + nblocks; i++) {
+        _cache_addrs[i] = _bd_size;
+        _cache_stamps[i] = 0;
+    }
+
+    bd_size_t fill_size = std::min((bd_size_t) nblocks * _cache_block_size, _bd_size - addr);
+    int ret = _bd->read(_cache + window * _cache_block_size, addr, fill_size);
+    if (ret) {
+        return ret;
+    }
+
+    for (int i = 0; i < nblocks; i++) {
+        // A block may now be cached twice (read ahead can overlap residents) -
+        // drop the old copy so lookups stay unambiguous
+        int old_ind = find_cache_block(addr + i * _cache_block_size);
+        if (old_ind >= 0) {
+            _cache_addrs[old_ind] = _bd_size;
+            _cache_stamps[old_ind] = 0;
+        }
+        _cache_addrs[window + i] = addr + i * _cache_block_size;
+        _cache_stamps[window + i] = ++_stamp;
+    }
+
+    ind = window;
+    return 0;
+}
+
+int CachedBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    MBED_ASSERT(_cache);
+
+    // Detect sequential streams - they trigger read ahead on a miss below
+    bool sequential = (addr == _seq_next_addr);
+    _seq_next_addr = addr + size;
+
+    // Reads larger than the cache won't benefit from it - bypass. The cache is
+    // never newer than the device (programs and erases invalidate), so reading
+    // around it is always coherent.
+    if (size >= (bd_size_t) _num_cache_blocks * _cache_block_size) {
+        return _bd->read(b, addr, size);
+    }
+
+    uint8_t *buf = static_cast<uint8_t *>(b);
+
+    while (size) {
+        bd_addr_t block_addr = cache_align_down(addr, _cache_block_size);
+        bd_size_t offs_in_block = addr - block_addr;
+        bd_size_t chunk = std::min(size, _cache_block_size - offs_in_block);
+
+        int ind = find_cache_block(block_addr);
+        if (ind < 0) {
+            int nblocks = sequential ? _num_read_ahead_blocks : 1;
+            int ret = fill_cache_blocks(block_addr, std::max(nblocks, 1), ind);
+            if (ret) {
+                return ret;
+            }
+        }
+
+        memcpy(buf, _cache + ind * _cache_block_size + offs_in_block, chunk);
+        _cache_stamps[ind] = ++_stamp;
+
+        buf += chunk;
+        addr += chunk;
+        size -= chunk;
+    }
+
+    return 0;
+}
+
+int CachedBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    invalidate_range(addr, size);
+    return _bd->program(b, addr, size);
+}
+
+int CachedBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    invalidate_range(addr, size);
+    return _bd->erase(addr, size);
+}
+
+int CachedBlockDevice::trim(bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    invalidate_range(addr, size);
+    return _bd->trim(addr, size);
+}
+
+bd_size_t CachedBlockDevice::get_read_size() const
+{
+    return _bd->get_read_size();
+}
+
+bd_size_t CachedBlockDevice::get_program_size() const
+{
+    return _bd->get_program_size();
+}
+
+bd_size_t CachedBlockDevice::get_erase_size() const
+{
+    return _bd->get_erase_size();
+}
+
+bd_size_t CachedBlockDevice::get_erase_size(bd_addr_t addr) const
+{
+    return _bd->get_erase_size(addr);
+}
+
+int CachedBlockDevice::get_erase_value() const
+{
+    return _bd->get_erase_value();
+}
+
+bd_size_t CachedBlockDevice::size() const
+{
+    return _bd->size();
+}
+
+const char *CachedBlockDevice::get_type() const
+{
+    if (_bd != NULL) {
+        return _bd->get_type();
+    }
+
+    return NULL;
+}
+
+} // namespace mbed
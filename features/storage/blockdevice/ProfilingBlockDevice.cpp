@@ -16,6 +16,11 @@
 
 #include "ProfilingBlockDevice.h"
 #include "stddef.h"
+#include "string.h"
+
+#ifndef MBED_CONF_BLOCKDEVICE_PROFILING_ERASE_REGIONS
+#define MBED_CONF_BLOCKDEVICE_PROFILING_ERASE_REGIONS 32
+#endif
 
 namespace mbed {
 
@@ -24,16 +29,44 @@ ProfilingBlockDevice::ProfilingBlockDevice(BlockDevice *bd)
     , _read_count(0)
     , _program_count(0)
     , _erase_count(0)
+    , _region_erase_counts(0)
+    , _num_regions(0)
+    , _region_size(0)
 {
+    memset(&_read_latency, 0, sizeof(_read_latency));
+    memset(&_program_latency, 0, sizeof(_program_latency));
+    memset(&_erase_latency, 0, sizeof(_erase_latency));
 }
 
 int ProfilingBlockDevice::init()
 {
-    return _bd->init();
+    int err = _bd->init();
+    if (err) {
+        return err;
+    }
+
+    if (!_region_erase_counts) {
+        // Split the device into equally sized regions, each an integral
+        // number of erase blocks, and track erase counts per region
+        bd_size_t erase_size = _bd->get_erase_size();
+        _region_size = (_bd->size() + MBED_CONF_BLOCKDEVICE_PROFILING_ERASE_REGIONS - 1)
+                       / MBED_CONF_BLOCKDEVICE_PROFILING_ERASE_REGIONS;
+        _region_size = ((_region_size + erase_size - 1) / erase_size) * erase_size;
+        _num_regions = (_bd->size() + _region_size - 1) / _region_size;
+        _region_erase_counts = new uint32_t[_num_regions];
+        memset(_region_erase_counts, 0, _num_regions * sizeof(uint32_t));
+    }
+
+    _timer.start();
+    return 0;
 }
 
 int ProfilingBlockDevice::deinit()
 {
+    delete[] _region_erase_counts;
+    _region_erase_counts = 0;
+    _num_regions = 0;
+    _region_size = 0;
     return _bd->deinit();
 }
 
@@ -44,27 +77,42 @@ int ProfilingBlockDevice::sync()
 
 int ProfilingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 {
+    us_timestamp_t start = _timer.read_high_resolution_us();
     int err = _bd->read(b, addr, size);
     if (!err) {
         _read_count += size;
+        _record_latency(_read_latency, (uint32_t)(_timer.read_high_resolution_us() - start));
     }
     return err;
 }
 
 int ProfilingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 {
+    us_timestamp_t start = _timer.read_high_resolution_us();
     int err = _bd->program(b, addr, size);
     if (!err) {
         _program_count += size;
+        _record_latency(_program_latency, (uint32_t)(_timer.read_high_resolution_us() - start));
     }
     return err;
 }
 
 int ProfilingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
 {
+    us_timestamp_t start = _timer.read_high_resolution_us();
     int err = _bd->erase(addr, size);
     if (!err) {
         _erase_count += size;
+        _record_latency(_erase_latency, (uint32_t)(_timer.read_high_resolution_us() - start));
+
+        if (_region_erase_counts) {
+            // attribute one erase per erase block to the covering region
+            bd_addr_t block = addr;
+            while (block < addr + size) {
+                _region_erase_counts[block / _region_size] += 1;
+                block += _bd->get_erase_size(block);
+            }
+        }
     }
     return err;
 }
@@ -104,6 +152,12 @@ void ProfilingBlockDevice::reset()
     _read_count = 0;
     _program_count = 0;
     _erase_count = 0;
+    memset(&_read_latency, 0, sizeof(_read_latency));
+    memset(&_program_latency, 0, sizeof(_program_latency));
+    memset(&_erase_latency, 0, sizeof(_erase_latency));
+    if (_region_erase_counts) {
+        memset(_region_erase_counts, 0, _num_regions * sizeof(uint32_t));
+    }
 }
 
 bd_size_t ProfilingBlockDevice::get_read_count() const
@@ -121,6 +175,118 @@ bd_size_t ProfilingBlockDevice::get_erase_count() const
     return _erase_count;
 }
 
+void ProfilingBlockDevice::get_read_latency(bd_latency_stats_t *stats) const
+{
+    _get_latency(_read_latency, stats);
+}
+
+void ProfilingBlockDevice::get_program_latency(bd_latency_stats_t *stats) const
+{
+    _get_latency(_program_latency, stats);
+}
+
+void ProfilingBlockDevice::get_erase_latency(bd_latency_stats_t *stats) const
+{
+    _get_latency(_erase_latency, stats);
+}
+
+bd_size_t ProfilingBlockDevice::get_erase_region_size() const
+{
+    return _region_size;
+}
+
+uint32_t ProfilingBlockDevice::get_region_erase_count(bd_addr_t addr) const
+{
+    if (!_region_erase_counts || addr / _region_size >= _num_regions) {
+        return 0;
+    }
+    return _region_erase_counts[addr / _region_size];
+}
+
+size_t ProfilingBlockDevice::get_hot_regions(bd_addr_t *addrs, uint32_t *counts, size_t max_regions) const
+{
+    if (!_region_erase_counts) {
+        return 0;
+    }
+
+    // repeated scan for the hottest unreported region, the region array
+    // is small so the quadratic selection is cheaper than sorting a copy
+    size_t found = 0;
+    while (found < max_regions) {
+        uint32_t best_count = 0;
+        uint32_t best_region = 0;
+        for (uint32_t region = 0; region < _num_regions; region++) {
+            bool reported = false;
+            for (size_t i = 0; i < found; i++) {
+                if (addrs[i] == region * _region_size) {
+                    reported = true;
+                    break;
+                }
+            }
+            if (!reported && _region_erase_counts[region] > best_count) {
+                best_count = _region_erase_counts[region];
+                best_region = region;
+            }
+        }
+        if (best_count == 0) {
+            break;
+        }
+        addrs[found] = best_region * _region_size;
+        counts[found] = best_count;
+        found++;
+    }
+    return found;
+}
+
+void ProfilingBlockDevice::_record_latency(op_latency &op, uint32_t elapsed_us)
+{
+    if (op.count == 0 || elapsed_us < op.min_us) {
+        op.min_us = elapsed_us;
+    }
+    if (elapsed_us > op.max_us) {
+        op.max_us = elapsed_us;
+    }
+    op.total_us += elapsed_us;
+    op.count += 1;
+
+    // bucket i collects latencies in [2^i, 2^(i+1)), the last bucket
+    // collects everything above
+    uint32_t bucket = 0;
+    while ((elapsed_us >> (bucket + 1)) && bucket < LATENCY_BUCKETS - 1) {
+        bucket += 1;
+    }
+    op.buckets[bucket] += 1;
+}
+
+void ProfilingBlockDevice::_get_latency(const op_latency &op, bd_latency_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->count = op.count;
+    if (op.count == 0) {
+        return;
+    }
+
+    stats->min_us = op.min_us;
+    stats->max_us = op.max_us;
+    stats->mean_us = (uint32_t)(op.total_us / op.count);
+
+    // walk the histogram until 99% of the samples are covered and report
+    // the upper bound of that bucket, capped by the observed maximum
+    uint64_t threshold = ((uint64_t)op.count * 99 + 99) / 100;
+    uint64_t cumulative = 0;
+    stats->p99_us = op.max_us;
+    for (uint32_t bucket = 0; bucket < LATENCY_BUCKETS; bucket++) {
+        cumulative += op.buckets[bucket];
+        if (cumulative >= threshold) {
+            uint32_t bound = (2u << bucket) - 1;
+            if (bound < op.max_us) {
+                stats->p99_us = bound;
+            }
+            break;
+        }
+    }
+}
+
 const char *ProfilingBlockDevice::get_type() const
 {
     if (_bd != NULL) {
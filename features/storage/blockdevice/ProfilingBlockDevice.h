@@ -27,9 +27,24 @@
 #define MBED_PROFILING_BLOCK_DEVICE_H
 
 #include "BlockDevice.h"
+#include "Timer.h"
 
 namespace mbed {
 
+/** Latency statistics for one block device operation type
+ *
+ *  Latencies are measured in microseconds. The 99th percentile is
+ *  approximated from power-of-two histogram buckets, so it is an upper
+ *  bound accurate to within a factor of two.
+ */
+typedef struct {
+    uint32_t count;     /**< Number of successful operations measured */
+    uint32_t min_us;    /**< Shortest operation in microseconds */
+    uint32_t max_us;    /**< Longest operation in microseconds */
+    uint32_t mean_us;   /**< Mean operation time in microseconds */
+    uint32_t p99_us;    /**< Approximate 99th percentile in microseconds */
+} bd_latency_stats_t;
+
 
 /** Block device for measuring storage operations of another block device
  */
@@ -163,6 +178,56 @@ public:
      */
     bd_size_t get_erase_count() const;
 
+    /** Get latency statistics for read operations
+     *
+     *  @param stats    Latency statistics filled in by the call
+     */
+    void get_read_latency(bd_latency_stats_t *stats) const;
+
+    /** Get latency statistics for program operations
+     *
+     *  @param stats    Latency statistics filled in by the call
+     */
+    void get_program_latency(bd_latency_stats_t *stats) const;
+
+    /** Get latency statistics for erase operations
+     *
+     *  @param stats    Latency statistics filled in by the call
+     */
+    void get_erase_latency(bd_latency_stats_t *stats) const;
+
+    /** Get the size of the regions erase counts are tracked over
+     *
+     *  The device is split into blockdevice.profiling-erase-regions regions
+     *  of equal size, rounded up to a multiple of the erase block size.
+     *
+     *  @return         Size of an erase-count region in bytes, or 0 if the
+     *                  device has not been initialized
+     */
+    bd_size_t get_erase_region_size() const;
+
+    /** Get the number of erase blocks erased in the region containing an address
+     *
+     *  @param addr     Address within the queried region
+     *  @return         Number of erase blocks erased in the region since the
+     *                  last reset
+     */
+    uint32_t get_region_erase_count(bd_addr_t addr) const;
+
+    /** Get the most-erased regions of the device
+     *
+     *  Reports the regions with the highest erase counts in descending
+     *  order, so wear concentrated on a few erase blocks can be spotted
+     *  before the underlying storage wears out.
+     *
+     *  @param addrs    Array filled with the base address of each hot region
+     *  @param counts   Array filled with the erase count of each hot region
+     *  @param max_regions Capacity of the addrs and counts arrays
+     *  @return         Number of regions reported, at most max_regions,
+     *                  skipping regions that have never been erased
+     */
+    size_t get_hot_regions(bd_addr_t *addrs, uint32_t *counts, size_t max_regions) const;
+
     /** Get the BlockDevice class type.
      *
      *  @return         A string represent the BlockDevice class type.
@@ -170,10 +235,32 @@ public:
     virtual const char *get_type() const;
 
 private:
+    static const uint32_t LATENCY_BUCKETS = 16;
+
+    // Running latency figures for one operation type. Buckets hold a
+    // power-of-two histogram used to approximate percentiles.
+    struct op_latency {
+        uint32_t count;
+        uint64_t total_us;
+        uint32_t min_us;
+        uint32_t max_us;
+        uint32_t buckets[LATENCY_BUCKETS];
+    };
+
+    void _record_latency(op_latency &op, uint32_t elapsed_us);
+    static void _get_latency(const op_latency &op, bd_latency_stats_t *stats);
+
     BlockDevice *_bd;
     bd_size_t _read_count;
     bd_size_t _program_count;
     bd_size_t _erase_count;
+    op_latency _read_latency;
+    op_latency _program_latency;
+    op_latency _erase_latency;
+    Timer _timer;
+    uint32_t *_region_erase_counts;
+    uint32_t _num_regions;
+    bd_size_t _region_size;
 };
 
 } // namespace mbed
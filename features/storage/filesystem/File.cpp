@@ -74,6 +74,18 @@ ssize_t File::write(const void *buffer, size_t len)
     return _fs->file_write(_file, buffer, len);
 }
 
+ssize_t File::pread(void *buffer, size_t size, off_t offset)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_pread(_file, buffer, size, offset);
+}
+
+ssize_t File::pwrite(const void *buffer, size_t size, off_t offset)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_pwrite(_file, buffer, size, offset);
+}
+
 int File::sync()
 {
     MBED_ASSERT(_fs);
@@ -85,6 +85,27 @@ public:
      */
     virtual ssize_t write(const void *buffer, size_t size);
 
+    /** Read from a given file offset without moving the file position
+     *
+     *  Routed to the file system's positioned read, so threads sharing
+     *  this file do not need to coordinate the file position.
+     *
+     *  @param buffer   The buffer to read in to
+     *  @param size     The number of bytes to read
+     *  @param offset   The file offset to read from
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t pread(void *buffer, size_t size, off_t offset);
+
+    /** Write to a given file offset without moving the file position
+     *
+     *  @param buffer   The buffer to write from
+     *  @param size     The number of bytes to write
+     *  @param offset   The file offset to write to
+     *  @return         The number of bytes written, negative error on failure
+     */
+    virtual ssize_t pwrite(const void *buffer, size_t size, off_t offset);
+
     /** Flush any buffers associated with the file
      *
      *  @return         0 on success, negative error code on failure
@@ -56,6 +56,36 @@ int FileSystem::statvfs(const char *path, struct statvfs *buf)
     return -ENOSYS;
 }
 
+ssize_t FileSystem::file_pread(fs_file_t file, void *buffer, size_t size, off_t offset)
+{
+    off_t off = file_tell(file);
+    if (off < 0) {
+        return off;
+    }
+    off_t pos = file_seek(file, offset, SEEK_SET);
+    if (pos < 0) {
+        return pos;
+    }
+    ssize_t ret = file_read(file, buffer, size);
+    file_seek(file, off, SEEK_SET);
+    return ret;
+}
+
+ssize_t FileSystem::file_pwrite(fs_file_t file, const void *buffer, size_t size, off_t offset)
+{
+    off_t off = file_tell(file);
+    if (off < 0) {
+        return off;
+    }
+    off_t pos = file_seek(file, offset, SEEK_SET);
+    if (pos < 0) {
+        return pos;
+    }
+    ssize_t ret = file_write(file, buffer, size);
+    file_seek(file, off, SEEK_SET);
+    return ret;
+}
+
 int FileSystem::file_sync(fs_file_t file)
 {
     return 0;
@@ -172,6 +172,35 @@ protected:
      */
     virtual ssize_t file_write(fs_file_t file, const void *buffer, size_t size) = 0;
 
+    /** Read from a given file offset without moving the file position
+     *
+     *  The default implementation brackets file_read with a pair of
+     *  seeks and is not atomic against other users of the file. File
+     *  systems with an internal lock should override it to do the
+     *  positioned read under a single lock acquisition, so that threads
+     *  can share a file handle without coordinating its position.
+     *
+     *  @param file     File handle
+     *  @param buffer   The buffer to read in to
+     *  @param size     The number of bytes to read
+     *  @param offset   The file offset to read from
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t file_pread(fs_file_t file, void *buffer, size_t size, off_t offset);
+
+    /** Write to a given file offset without moving the file position
+     *
+     *  The same atomicity notes as for file_pread apply to the default
+     *  implementation.
+     *
+     *  @param file     File handle
+     *  @param buffer   The buffer to write from
+     *  @param size     The number of bytes to write
+     *  @param offset   The file offset to write to
+     *  @return         The number of bytes written, negative error on failure
+     */
+    virtual ssize_t file_pwrite(fs_file_t file, const void *buffer, size_t size, off_t offset);
+
     /** Flush any buffers associated with the file
      *
      *  @param file     File handle
@@ -33,6 +33,13 @@ namespace mbed {
 
 using namespace mbed;
 
+#if FF_USE_FASTSEEK
+// Number of DWORD entries in the per-file cluster link map used for fast seek.
+// Supports files of up to (FAT_LINKMAP_ENTRIES - 1) / 2 fragments; more
+// fragmented files fall back to normal seeks.
+#define FAT_LINKMAP_ENTRIES 64
+#endif
+
 static int fat_error_remap(FRESULT res)
 {
     switch (res) {
@@ -610,6 +617,24 @@ int FATFileSystem::file_open(fs_file_t *file, const char *path, int flags)
         return fat_error_remap(res);
     }
 
+#if FF_USE_FASTSEEK
+    // For read-only opens, build the cluster link map now, so seeks and reads
+    // over fragmented files don't walk the FAT chain on the fly. Write opens
+    // can't use it, as fast seek mode forbids extending the file.
+    if (!(flags & (O_RDWR | O_WRONLY))) {
+        fh->cltbl = new DWORD[FAT_LINKMAP_ENTRIES];
+        fh->cltbl[0] = FAT_LINKMAP_ENTRIES;
+        res = f_lseek(fh, CREATE_LINKMAP);
+        if (res != FR_OK) {
+            // Table too small for the file's fragment count - fall back to
+            // normal seeks
+            debug_if(FFS_DBG, "f_lseek(CREATE_LINKMAP) failed: %d\n", res);
+            delete[] fh->cltbl;
+            fh->cltbl = NULL;
+        }
+    }
+#endif
+
     unlock();
 
     *file = fh;
@@ -624,6 +649,9 @@ int FATFileSystem::file_close(fs_file_t file)
     FRESULT res = f_close(fh);
     unlock();
 
+#if FF_USE_FASTSEEK
+    delete[] fh->cltbl;
+#endif
     delete fh;
     return fat_error_remap(res);
 }
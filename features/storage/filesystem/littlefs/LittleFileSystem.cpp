@@ -405,6 +405,25 @@ int LittleFileSystem::statvfs(const char *name, struct statvfs *st)
     return 0;
 }
 
+int LittleFileSystem::maintain()
+{
+    _mutex.lock();
+    LFS_INFO("maintain()");
+    int err = lfs_prealloc(&_lfs);
+    LFS_INFO("maintain -> %d", lfs_toerror(err));
+    _mutex.unlock();
+    return lfs_toerror(err);
+}
+
+void LittleFileSystem::get_stats(mbed_stats_littlefs_t *stats)
+{
+    _mutex.lock();
+    stats->dir_relocates = _lfs.stats.dir_relocates;
+    stats->alloc_scans = _lfs.stats.alloc_scans;
+    stats->alloc_scan_blocks = _lfs.stats.alloc_scan_blocks;
+    _mutex.unlock();
+}
+
 ////// File operations //////
 int LittleFileSystem::file_open(fs_file_t *file, const char *path, int flags)
 {
@@ -456,6 +475,38 @@ ssize_t LittleFileSystem::file_write(fs_file_t file, const void *buffer, size_t
     return lfs_toerror(res);
 }
 
+ssize_t LittleFileSystem::file_pread(fs_file_t file, void *buffer, size_t size, off_t offset)
+{
+    lfs_file_t *f = (lfs_file_t *)file;
+    _mutex.lock();
+    LFS_INFO("file_pread(%p, %p, %d, %ld)", file, buffer, size, offset);
+    lfs_soff_t pos = lfs_file_tell(&_lfs, f);
+    lfs_ssize_t res = (pos < 0) ? pos : lfs_file_seek(&_lfs, f, offset, LFS_SEEK_SET);
+    if (res >= 0) {
+        res = lfs_file_read(&_lfs, f, buffer, size);
+        lfs_file_seek(&_lfs, f, pos, LFS_SEEK_SET);
+    }
+    LFS_INFO("file_pread -> %d", lfs_toerror(res));
+    _mutex.unlock();
+    return lfs_toerror(res);
+}
+
+ssize_t LittleFileSystem::file_pwrite(fs_file_t file, const void *buffer, size_t size, off_t offset)
+{
+    lfs_file_t *f = (lfs_file_t *)file;
+    _mutex.lock();
+    LFS_INFO("file_pwrite(%p, %p, %d, %ld)", file, buffer, size, offset);
+    lfs_soff_t pos = lfs_file_tell(&_lfs, f);
+    lfs_ssize_t res = (pos < 0) ? pos : lfs_file_seek(&_lfs, f, offset, LFS_SEEK_SET);
+    if (res >= 0) {
+        res = lfs_file_write(&_lfs, f, buffer, size);
+        lfs_file_seek(&_lfs, f, pos, LFS_SEEK_SET);
+    }
+    LFS_INFO("file_pwrite -> %d", lfs_toerror(res));
+    _mutex.unlock();
+    return lfs_toerror(res);
+}
+
 int LittleFileSystem::file_sync(fs_file_t file)
 {
     lfs_file_t *f = (lfs_file_t *)file;
@@ -25,6 +25,16 @@
 #include "PlatformMutex.h"
 #include "lfs.h"
 
+/** littlefs maintenance statistics
+ *
+ *  Counters accumulate from mount onwards.
+ */
+typedef struct {
+    uint32_t dir_relocates;     /**< Metadata pairs rewritten into a freshly allocated block */
+    uint32_t alloc_scans;       /**< Block allocations that missed the lookahead buffer and scanned storage */
+    uint32_t alloc_scan_blocks; /**< Total number of blocks covered by lookahead scans */
+} mbed_stats_littlefs_t;
+
 namespace mbed {
 
 /**
@@ -158,6 +168,25 @@ public:
      */
     virtual int statvfs(const char *path, struct statvfs *buf);
 
+    /** Performs pending filesystem maintenance
+     *
+     *  Prunes any orphans left by an interrupted operation and refills the
+     *  block allocator's lookahead buffer if it has been exhausted. Both
+     *  otherwise run lazily inside whichever file write needs the next
+     *  block, where they add a scan of the whole filesystem to that write's
+     *  latency. Calling this during known-idle windows keeps worst-case
+     *  write latency predictable.
+     *
+     *  @return         0 on success, negative error code on failure
+     */
+    int maintain();
+
+    /** Reads littlefs maintenance statistics
+     *
+     *  @param stats    The stats structure to fill out
+     */
+    void get_stats(mbed_stats_littlefs_t *stats);
+
 protected:
     /** Open a file on the filesystem
      *
@@ -194,6 +223,32 @@ protected:
      */
     virtual ssize_t file_write(mbed::fs_file_t file, const void *buffer, size_t size);
 
+    /** Read from a given file offset without moving the file position
+     *
+     *  The seek, read and position restore happen under a single
+     *  acquisition of the file system lock, so the operation is atomic
+     *  against other users of the file.
+     *
+     *  @param file     File handle
+     *  @param buffer   The buffer to read in to
+     *  @param size     The number of bytes to read
+     *  @param offset   The file offset to read from
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t file_pread(mbed::fs_file_t file, void *buffer, size_t size, off_t offset);
+
+    /** Write to a given file offset without moving the file position
+     *
+     *  Atomic against other users of the file, like file_pread.
+     *
+     *  @param file     File handle
+     *  @param buffer   The buffer to write from
+     *  @param size     The number of bytes to write
+     *  @param offset   The file offset to write to
+     *  @return         The number of bytes written, negative error on failure
+     */
+    virtual ssize_t file_pwrite(mbed::fs_file_t file, const void *buffer, size_t size, off_t offset);
+
     /** Flush any buffers associated with the file
      *
      *  @param file     File handle
@@ -284,6 +284,19 @@ static int lfs_alloc_lookahead(void *p, lfs_block_t block) {
     return 0;
 }
 
+static int lfs_alloc_scan(lfs_t *lfs) {
+    lfs->free.off = (lfs->free.off + lfs->free.size)
+            % lfs->cfg->block_count;
+    lfs->free.size = lfs_min(lfs->cfg->lookahead, lfs->free.ack);
+    lfs->free.i = 0;
+    lfs->stats.alloc_scans += 1;
+    lfs->stats.alloc_scan_blocks += lfs->free.size;
+
+    // find mask of free blocks from tree
+    memset(lfs->free.buffer, 0, lfs->cfg->lookahead/8);
+    return lfs_traverse(lfs, lfs_alloc_lookahead, lfs);
+}
+
 static int lfs_alloc(lfs_t *lfs, lfs_block_t *block) {
     while (true) {
         while (lfs->free.i != lfs->free.size) {
@@ -315,14 +328,7 @@ static int lfs_alloc(lfs_t *lfs, lfs_block_t *block) {
             return LFS_ERR_NOSPC;
         }
 
-        lfs->free.off = (lfs->free.off + lfs->free.size)
-                % lfs->cfg->block_count;
-        lfs->free.size = lfs_min(lfs->cfg->lookahead, lfs->free.ack);
-        lfs->free.i = 0;
-
-        // find mask of free blocks from tree
-        memset(lfs->free.buffer, 0, lfs->cfg->lookahead/8);
-        int err = lfs_traverse(lfs, lfs_alloc_lookahead, lfs);
+        int err = lfs_alloc_scan(lfs);
         if (err) {
             return err;
         }
@@ -638,6 +644,7 @@ relocate:
         // update references if we relocated
         LFS_DEBUG("Relocating %" PRIu32 " %" PRIu32 " to %" PRIu32 " %" PRIu32,
                 oldpair[0], oldpair[1], dir->pair[0], dir->pair[1]);
+        lfs->stats.dir_relocates += 1;
         int err = lfs_relocate(lfs, oldpair, dir->pair);
         if (err) {
             return err;
@@ -2083,6 +2090,9 @@ static int lfs_init(lfs_t *lfs, const struct lfs_config *cfg) {
     lfs->root[1] = 0xffffffff;
     lfs->files = NULL;
     lfs->dirs = NULL;
+    lfs->stats.dir_relocates = 0;
+    lfs->stats.alloc_scans = 0;
+    lfs->stats.alloc_scan_blocks = 0;
     lfs->deorphaned = false;
 
     return 0;
@@ -2564,3 +2574,28 @@ int lfs_deorphan(lfs_t *lfs) {
 
     return 0;
 }
+
+int lfs_prealloc(lfs_t *lfs) {
+    // deorphan if we haven't yet, this pays the scan now instead of
+    // during the first write after poweron
+    if (!lfs->deorphaned) {
+        int err = lfs_deorphan(lfs);
+        if (err) {
+            return err;
+        }
+    }
+
+    // nothing to do while unallocated blocks remain in the lookahead
+    for (lfs_block_t off = lfs->free.i; off != lfs->free.size; off++) {
+        if (!(lfs->free.buffer[off / 32] & (1U << (off % 32)))) {
+            return 0;
+        }
+    }
+
+    // mirrors the exhausted-lookahead check in lfs_alloc
+    if (lfs->free.ack == 0) {
+        return LFS_ERR_NOSPC;
+    }
+
+    return lfs_alloc_scan(lfs);
+}
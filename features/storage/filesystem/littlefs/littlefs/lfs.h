@@ -267,6 +267,12 @@ typedef struct lfs_free {
     uint32_t *buffer;
 } lfs_free_t;
 
+typedef struct lfs_stats {
+    uint32_t dir_relocates;     // metadata pairs rewritten into a fresh block
+    uint32_t alloc_scans;       // allocations that missed the lookahead buffer
+    uint32_t alloc_scan_blocks; // total blocks covered by lookahead scans
+} lfs_stats_t;
+
 // The littlefs type
 typedef struct lfs {
     const struct lfs_config *cfg;
@@ -279,6 +285,7 @@ typedef struct lfs {
     lfs_cache_t pcache;
 
     lfs_free_t free;
+    lfs_stats_t stats;
     bool deorphaned;
 } lfs_t;
 
@@ -486,6 +493,17 @@ int lfs_traverse(lfs_t *lfs, int (*cb)(void*, lfs_block_t), void *data);
 // Returns a negative error code on failure.
 int lfs_deorphan(lfs_t *lfs);
 
+// Preemptively pays for pending allocator work
+//
+// Prunes any orphans left by an interrupted operation and refills the
+// allocator's lookahead buffer if it has been exhausted. Both otherwise run
+// lazily inside whichever operation needs the next block, where they can add
+// a scan of the whole filesystem to that operation's latency. Calling this
+// during an idle window makes later allocations cheap.
+//
+// Returns a negative error code on failure.
+int lfs_prealloc(lfs_t *lfs);
+
 
 #ifdef __cplusplus
 } /* extern "C" */
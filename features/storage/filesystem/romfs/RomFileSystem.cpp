@@ -0,0 +1,418 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "filesystem/mbed_filesystem.h"
+#include "RomFileSystem.h"
+#include "errno.h"
+#include <string.h>
+
+namespace mbed {
+
+// Image header, written by mkromfs.py. All fields are little-endian.
+#define ROMFS_MAGIC         "ROMF"
+#define ROMFS_VERSION       1
+#define ROMFS_HEADER_SIZE   16
+
+struct romfs_header {
+    char magic[4];
+    uint32_t version;
+    uint32_t count;
+    uint32_t dir_size;
+};
+
+// Per-open-file state, the image entry never changes so only the
+// position needs tracking
+struct romfs_file {
+    const void *entry;
+    uint32_t pos;
+};
+
+////// Generic filesystem operations //////
+RomFileSystem::RomFileSystem(const char *name, BlockDevice *bd)
+    : FileSystem(name)
+    , _bd(NULL), _map(NULL), _dir(NULL), _entries(NULL), _count(0)
+{
+    if (bd) {
+        mount(bd);
+    }
+}
+
+RomFileSystem::~RomFileSystem()
+{
+    // nop if unmounted
+    unmount();
+}
+
+int RomFileSystem::_read(bd_addr_t addr, void *buffer, size_t size)
+{
+    bd_size_t read_size = _bd->get_read_size();
+    if (read_size <= 1) {
+        return _bd->read(buffer, addr, size);
+    }
+
+    // bounce through an aligned buffer for devices with coarse reads
+    uint8_t *out = static_cast<uint8_t *>(buffer);
+    uint8_t *bounce = new uint8_t[read_size];
+    while (size > 0) {
+        bd_addr_t aligned = addr - (addr % read_size);
+        size_t off = addr - aligned;
+        size_t chunk = read_size - off;
+        if (chunk > size) {
+            chunk = size;
+        }
+
+        int err = _bd->read(bounce, aligned, read_size);
+        if (err) {
+            delete[] bounce;
+            return err;
+        }
+
+        memcpy(out, bounce + off, chunk);
+        out += chunk;
+        addr += chunk;
+        size -= chunk;
+    }
+    delete[] bounce;
+    return 0;
+}
+
+const char *RomFileSystem::_name(const entry *e)
+{
+    // offsets in the image are from the image start, the in-ram copy
+    // starts just after the header
+    return reinterpret_cast<const char *>(_dir) + (e->name_off - ROMFS_HEADER_SIZE);
+}
+
+const RomFileSystem::entry *RomFileSystem::_find(const char *path)
+{
+    if (path[0] == '/') {
+        path++;
+    }
+
+    for (uint32_t i = 0; i < _count; i++) {
+        if (strcmp(_name(&_entries[i]), path) == 0) {
+            return &_entries[i];
+        }
+    }
+    return NULL;
+}
+
+int RomFileSystem::mount(BlockDevice *bd)
+{
+    return mount(bd, NULL);
+}
+
+int RomFileSystem::mount(BlockDevice *bd, const void *map_base)
+{
+    _mutex.lock();
+    if (_dir) {
+        _mutex.unlock();
+        return -EINVAL;
+    }
+
+    _bd = bd;
+    int err = _bd->init();
+    if (err) {
+        _bd = NULL;
+        _mutex.unlock();
+        return err;
+    }
+
+    romfs_header header;
+    err = _read(0, &header, sizeof(header));
+    if (!err && (memcmp(header.magic, ROMFS_MAGIC, 4) != 0
+                 || header.version != ROMFS_VERSION
+                 || header.dir_size < header.count * sizeof(entry)
+                 || header.dir_size > _bd->size() - ROMFS_HEADER_SIZE)) {
+        err = -EILSEQ;
+    }
+
+    if (!err) {
+        _dir = new uint8_t[header.dir_size];
+        err = _read(ROMFS_HEADER_SIZE, _dir, header.dir_size);
+        if (err) {
+            delete[] _dir;
+            _dir = NULL;
+        }
+    }
+
+    if (err) {
+        _bd->deinit();
+        _bd = NULL;
+        _mutex.unlock();
+        return err;
+    }
+
+    _count = header.count;
+    _entries = reinterpret_cast<const entry *>(_dir);
+    _map = static_cast<const uint8_t *>(map_base);
+    _mutex.unlock();
+    return 0;
+}
+
+int RomFileSystem::unmount()
+{
+    _mutex.lock();
+    int res = 0;
+    if (_dir) {
+        delete[] _dir;
+        _dir = NULL;
+        _entries = NULL;
+        _count = 0;
+        _map = NULL;
+    }
+
+    if (_bd) {
+        int err = _bd->deinit();
+        if (err && !res) {
+            res = err;
+        }
+        _bd = NULL;
+    }
+
+    _mutex.unlock();
+    return res;
+}
+
+int RomFileSystem::remove(const char *path)
+{
+    return -EROFS;
+}
+
+int RomFileSystem::rename(const char *oldpath, const char *newpath)
+{
+    return -EROFS;
+}
+
+int RomFileSystem::mkdir(const char *path, mode_t mode)
+{
+    return -EROFS;
+}
+
+int RomFileSystem::stat(const char *path, struct stat *st)
+{
+    _mutex.lock();
+    const entry *e = _find(path);
+    if (!e) {
+        _mutex.unlock();
+        return -ENOENT;
+    }
+
+    memset(st, 0, sizeof(struct stat));
+    st->st_size = e->size;
+    st->st_mode = S_IFREG | S_IRUSR | S_IRGRP | S_IROTH;
+    _mutex.unlock();
+    return 0;
+}
+
+int RomFileSystem::statvfs(const char *path, struct statvfs *buf)
+{
+    _mutex.lock();
+    if (!_bd) {
+        _mutex.unlock();
+        return -EINVAL;
+    }
+
+    memset(buf, 0, sizeof(struct statvfs));
+    bd_size_t bsize = _bd->get_read_size();
+    buf->f_bsize = bsize;
+    buf->f_frsize = bsize;
+    buf->f_blocks = _bd->size() / bsize;
+    buf->f_files = _count;
+    buf->f_namemax = NAME_MAX;
+    _mutex.unlock();
+    return 0;
+}
+
+int RomFileSystem::mmap(const char *path, const void **addr, size_t *size)
+{
+    _mutex.lock();
+    const entry *e = _find(path);
+    if (!e) {
+        _mutex.unlock();
+        return -ENOENT;
+    }
+
+    if (!_map) {
+        _mutex.unlock();
+        return -ENXIO;
+    }
+
+    *addr = _map + e->data_off;
+    *size = e->size;
+    _mutex.unlock();
+    return 0;
+}
+
+////// File operations //////
+int RomFileSystem::file_open(fs_file_t *file, const char *path, int flags)
+{
+    if ((flags & (O_WRONLY | O_RDWR | O_CREAT | O_TRUNC | O_APPEND)) != 0) {
+        return -EROFS;
+    }
+
+    _mutex.lock();
+    const entry *e = _find(path);
+    _mutex.unlock();
+    if (!e) {
+        return -ENOENT;
+    }
+
+    romfs_file *f = new romfs_file;
+    f->entry = e;
+    f->pos = 0;
+    *file = f;
+    return 0;
+}
+
+int RomFileSystem::file_close(fs_file_t file)
+{
+    delete static_cast<romfs_file *>(file);
+    return 0;
+}
+
+ssize_t RomFileSystem::file_read(fs_file_t file, void *buffer, size_t size)
+{
+    romfs_file *f = static_cast<romfs_file *>(file);
+    ssize_t res = file_pread(file, buffer, size, f->pos);
+    if (res > 0) {
+        f->pos += res;
+    }
+    return res;
+}
+
+ssize_t RomFileSystem::file_write(fs_file_t file, const void *buffer, size_t size)
+{
+    return -EROFS;
+}
+
+ssize_t RomFileSystem::file_pread(fs_file_t file, void *buffer, size_t size, off_t offset)
+{
+    romfs_file *f = static_cast<romfs_file *>(file);
+    const entry *e = static_cast<const entry *>(f->entry);
+    if (offset < 0) {
+        return -EINVAL;
+    }
+
+    if ((uint32_t)offset >= e->size) {
+        return 0;
+    }
+
+    if (size > e->size - offset) {
+        size = e->size - offset;
+    }
+
+    if (_map) {
+        memcpy(buffer, _map + e->data_off + offset, size);
+        return size;
+    }
+
+    _mutex.lock();
+    int err = _read(e->data_off + offset, buffer, size);
+    _mutex.unlock();
+    return err ? err : (ssize_t)size;
+}
+
+off_t RomFileSystem::file_seek(fs_file_t file, off_t offset, int whence)
+{
+    romfs_file *f = static_cast<romfs_file *>(file);
+    const entry *e = static_cast<const entry *>(f->entry);
+
+    off_t pos;
+    switch (whence) {
+        case SEEK_SET:
+            pos = offset;
+            break;
+        case SEEK_CUR:
+            pos = f->pos + offset;
+            break;
+        case SEEK_END:
+            pos = e->size + offset;
+            break;
+        default:
+            return -EINVAL;
+    }
+
+    if (pos < 0) {
+        return -EINVAL;
+    }
+
+    f->pos = pos;
+    return pos;
+}
+
+off_t RomFileSystem::file_tell(fs_file_t file)
+{
+    return static_cast<romfs_file *>(file)->pos;
+}
+
+off_t RomFileSystem::file_size(fs_file_t file)
+{
+    romfs_file *f = static_cast<romfs_file *>(file);
+    return static_cast<const entry *>(f->entry)->size;
+}
+
+////// Dir operations //////
+int RomFileSystem::dir_open(fs_dir_t *dir, const char *path)
+{
+    // flat namespace, only the root directory exists
+    if (path[0] != '\0' && strcmp(path, "/") != 0) {
+        _mutex.lock();
+        bool found = (_find(path) != NULL);
+        _mutex.unlock();
+        return found ? -ENOTDIR : -ENOENT;
+    }
+
+    uint32_t *d = new uint32_t;
+    *d = 0;
+    *dir = d;
+    return 0;
+}
+
+int RomFileSystem::dir_close(fs_dir_t dir)
+{
+    delete static_cast<uint32_t *>(dir);
+    return 0;
+}
+
+ssize_t RomFileSystem::dir_read(fs_dir_t dir, struct dirent *ent)
+{
+    uint32_t *d = static_cast<uint32_t *>(dir);
+    _mutex.lock();
+    if (*d >= _count) {
+        _mutex.unlock();
+        return 0;
+    }
+
+    const entry *e = &_entries[*d];
+    strncpy(ent->d_name, _name(e), NAME_MAX);
+    ent->d_name[NAME_MAX] = '\0';
+    ent->d_type = DT_REG;
+    *d += 1;
+    _mutex.unlock();
+    return 1;
+}
+
+void RomFileSystem::dir_seek(fs_dir_t dir, off_t offset)
+{
+    *static_cast<uint32_t *>(dir) = offset;
+}
+
+off_t RomFileSystem::dir_tell(fs_dir_t dir)
+{
+    return *static_cast<uint32_t *>(dir);
+}
+
+} // namespace mbed
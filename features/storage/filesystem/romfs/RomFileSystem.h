@@ -0,0 +1,281 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup storage */
+/** @{*/
+
+#ifndef MBED_ROMFILESYSTEM_H
+#define MBED_ROMFILESYSTEM_H
+
+#include "FileSystem.h"
+#include "BlockDevice.h"
+#include "PlatformMutex.h"
+
+namespace mbed {
+
+/**
+ * RomFileSystem, a read-only filesystem for constant assets
+ *
+ * Mounts an image generated offline by mkromfs.py. The image holds a
+ * flat table of named files, so there is no per-access metadata lookup
+ * on the block device - the directory is read once at mount time and
+ * file reads go straight to the stored data.
+ *
+ * When the block device contents are also visible in the address space
+ * (for example QSPI flash in memory-mapped mode), the mapped base can
+ * be passed to mount and files become directly addressable through
+ * mmap, turning asset access into a pointer dereference.
+ *
+ * Synchronization level: Thread safe
+ */
+class RomFileSystem : public mbed::FileSystem {
+public:
+    /** Lifetime of the RomFileSystem
+     *
+     *  @param name     Name to add filesystem to tree as
+     *  @param bd       BlockDevice to mount, may be passed instead to mount call
+     */
+    RomFileSystem(const char *name = NULL, mbed::BlockDevice *bd = NULL);
+
+    virtual ~RomFileSystem();
+
+    /** Mounts a filesystem to a block device
+     *
+     *  @param bd       BlockDevice to mount to
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int mount(mbed::BlockDevice *bd);
+
+    /** Mounts a filesystem to a memory-mappable block device
+     *
+     *  @param bd       BlockDevice to mount to
+     *  @param map_base Address at which the block device contents are
+     *                  visible in the address space, enabling mmap
+     *  @return         0 on success, negative error code on failure
+     */
+    int mount(mbed::BlockDevice *bd, const void *map_base);
+
+    /** Unmounts a filesystem from the underlying block device
+     *
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int unmount();
+
+    /** Remove a file from the filesystem.
+     *
+     *  @param path     The name of the file to remove.
+     *  @return         -EROFS, the filesystem is read-only
+     */
+    virtual int remove(const char *path);
+
+    /** Rename a file in the filesystem.
+     *
+     *  @param path     The name of the file to rename.
+     *  @param newpath  The name to rename it to
+     *  @return         -EROFS, the filesystem is read-only
+     */
+    virtual int rename(const char *path, const char *newpath);
+
+    /** Store information about the file in a stat structure
+     *
+     *  @param path     The name of the file to find information about
+     *  @param st       The stat buffer to write to
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int stat(const char *path, struct stat *st);
+
+    /** Create a directory in the filesystem.
+     *
+     *  @param path     The name of the directory to create.
+     *  @param mode     The permissions with which to create the directory
+     *  @return         -EROFS, the filesystem is read-only
+     */
+    virtual int mkdir(const char *path, mode_t mode);
+
+    /** Store information about the mounted filesystem in a statvfs structure
+     *
+     *  @param path     The name of the file to find information about
+     *  @param buf      The stat buffer to write to
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int statvfs(const char *path, struct statvfs *buf);
+
+    /** Get a direct view of a file's contents
+     *
+     *  Only available when the filesystem was mounted with a map base.
+     *  The returned pointer stays valid until unmount and needs no
+     *  further filesystem calls to use.
+     *
+     *  @param path     The name of the file to map
+     *  @param addr     Destination for the address of the file contents
+     *  @param size     Destination for the size of the file in bytes
+     *  @return         0 on success, -ENXIO if the block device is not
+     *                  memory mapped, negative error code on failure
+     */
+    int mmap(const char *path, const void **addr, size_t *size);
+
+protected:
+    /** Open a file on the filesystem
+     *
+     *  @param file     Destination for the handle to a newly created file
+     *  @param path     The name of the file to open
+     *  @param flags    The flags to open the file in, only O_RDONLY is accepted
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int file_open(mbed::fs_file_t *file, const char *path, int flags);
+
+    /** Close a file
+     *
+     *  @param file     File handle
+     *  return          0 on success, negative error code on failure
+     */
+    virtual int file_close(mbed::fs_file_t file);
+
+    /** Read the contents of a file into a buffer
+     *
+     *  @param file     File handle
+     *  @param buffer   The buffer to read in to
+     *  @param size     The number of bytes to read
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t file_read(mbed::fs_file_t file, void *buffer, size_t size);
+
+    /** Write the contents of a buffer to a file
+     *
+     *  @param file     File handle
+     *  @param buffer   The buffer to write from
+     *  @param size     The number of bytes to write
+     *  @return         -EROFS, the filesystem is read-only
+     */
+    virtual ssize_t file_write(mbed::fs_file_t file, const void *buffer, size_t size);
+
+    /** Read from a given file offset without moving the file position
+     *
+     *  Stateless on a read-only image, so positioned reads from
+     *  different threads need no coordination at all.
+     *
+     *  @param file     File handle
+     *  @param buffer   The buffer to read in to
+     *  @param size     The number of bytes to read
+     *  @param offset   The file offset to read from
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t file_pread(mbed::fs_file_t file, void *buffer, size_t size, off_t offset);
+
+    /** Move the file position to a given offset from from a given location
+     *
+     *  @param file     File handle
+     *  @param offset   The offset from whence to move to
+     *  @param whence   The start of where to seek
+     *      SEEK_SET to start from beginning of file,
+     *      SEEK_CUR to start from current position in file,
+     *      SEEK_END to start from end of file
+     *  @return         The new offset of the file
+     */
+    virtual off_t file_seek(mbed::fs_file_t file, off_t offset, int whence);
+
+    /** Get the file position of the file
+     *
+     *  @param file     File handle
+     *  @return         The current offset in the file
+     */
+    virtual off_t file_tell(mbed::fs_file_t file);
+
+    /** Get the size of the file
+     *
+     *  @param file     File handle
+     *  @return         Size of the file in bytes
+     */
+    virtual off_t file_size(mbed::fs_file_t file);
+
+    /** Open a directory on the filesystem
+     *
+     *  The image namespace is flat, so only the root directory exists.
+     *
+     *  @param dir      Destination for the handle to the directory
+     *  @param path     Name of the directory to open
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int dir_open(mbed::fs_dir_t *dir, const char *path);
+
+    /** Close a directory
+     *
+     *  @param dir      Dir handle
+     *  return          0 on success, negative error code on failure
+     */
+    virtual int dir_close(mbed::fs_dir_t dir);
+
+    /** Read the next directory entry
+     *
+     *  @param dir      Dir handle
+     *  @param ent      The directory entry to fill out
+     *  @return         1 on reading a filename, 0 at end of directory, negative error on failure
+     */
+    virtual ssize_t dir_read(mbed::fs_dir_t dir, struct dirent *ent);
+
+    /** Set the current position of the directory
+     *
+     *  @param dir      Dir handle
+     *  @param offset   Offset of the location to seek to,
+     *                  must be a value returned from dir_tell
+     */
+    virtual void dir_seek(mbed::fs_dir_t dir, off_t offset);
+
+    /** Get the current position of the directory
+     *
+     *  @param dir      Dir handle
+     *  @return         Position of the directory that can be passed to dir_rewind
+     */
+    virtual off_t dir_tell(mbed::fs_dir_t dir);
+
+private:
+    // On-image directory entry, offsets are from the start of the image
+    struct entry {
+        uint32_t name_off;
+        uint32_t data_off;
+        uint32_t size;
+    };
+
+    // Reads from the block device at any offset and length, bouncing
+    // through a read_size-aligned buffer where the device requires it
+    int _read(bd_addr_t addr, void *buffer, size_t size);
+
+    // Looks up an image entry by path, NULL if not present
+    const entry *_find(const char *path);
+
+    // Returns an entry's name from the in-ram directory copy
+    const char *_name(const entry *e);
+
+    mbed::BlockDevice *_bd;     // the block device
+    const uint8_t *_map;        // mapped image base, NULL if not mappable
+    uint8_t *_dir;              // in-ram copy of the directory table
+    const entry *_entries;      // entry table inside _dir
+    uint32_t _count;            // number of files in the image
+
+    // thread-safe locking
+    PlatformMutex _mutex;
+};
+
+} // namespace mbed
+
+// Added "using" for backwards compatibility
+#ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
+using mbed::RomFileSystem;
+#endif
+
+#endif
+
+/** @}*/
@@ -0,0 +1,102 @@
+#!/usr/bin/env python
+# Copyright (c) 2019 ARM Limited
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""
+Builds a RomFileSystem image from a directory tree.
+
+Image layout, all integers little-endian:
+    16 byte header: magic "ROMF", u32 version, u32 count, u32 dir_size
+    count directory entries: u32 name_off, u32 data_off, u32 size
+    NUL-terminated names
+    file data, each file aligned to --align bytes
+
+Offsets are from the start of the image. The namespace is flat, files
+in subdirectories keep their relative path as the name.
+"""
+
+from __future__ import print_function
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = b"ROMF"
+VERSION = 1
+HEADER_SIZE = 16
+ENTRY_SIZE = 12
+
+
+def collect(root):
+    files = []
+    for dirpath, _, names in os.walk(root):
+        for name in names:
+            path = os.path.join(dirpath, name)
+            rel = os.path.relpath(path, root).replace(os.sep, '/')
+            files.append((rel, path))
+    files.sort()
+    return files
+
+
+def build(root, output, align):
+    files = collect(root)
+
+    names = b''
+    name_offs = []
+    for rel, _ in files:
+        name_offs.append(len(names))
+        names += rel.encode('utf-8') + b'\0'
+
+    dir_size = len(files) * ENTRY_SIZE + len(names)
+    names_base = HEADER_SIZE + len(files) * ENTRY_SIZE
+
+    data = b''
+    entries = b''
+    data_base = HEADER_SIZE + dir_size
+    for (rel, path), name_off in zip(files, name_offs):
+        with open(path, 'rb') as f:
+            contents = f.read()
+        pad = -(data_base + len(data)) % align
+        data += b'\xff' * pad
+        entries += struct.pack('<III', names_base + name_off,
+                               data_base + len(data), len(contents))
+        data += contents
+
+    with open(output, 'wb') as f:
+        f.write(struct.pack('<4sIII', MAGIC, VERSION, len(files), dir_size))
+        f.write(entries)
+        f.write(names)
+        f.write(data)
+
+    return len(files)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('root', help="directory to pack")
+    parser.add_argument('output', help="image file to write")
+    parser.add_argument('--align', type=int, default=4,
+                        help="alignment of file data, default 4")
+    args = parser.parse_args()
+
+    if not os.path.isdir(args.root):
+        print("error: %s is not a directory" % args.root, file=sys.stderr)
+        return 1
+
+    count = build(args.root, args.output, args.align)
+    print("wrote %d files to %s" % (count, args.output))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -40,6 +40,8 @@ public:
 
     typedef struct _opaque_set_handle *set_handle_t;
 
+    typedef struct _opaque_get_handle *get_handle_t;
+
     typedef struct _opaque_key_iterator *iterator_t;
 
     /**
@@ -160,6 +162,42 @@ public:
      */
     virtual int set_finalize(set_handle_t handle) = 0;
 
+    /**
+     * @brief Start a chunked KVStore get sequence, given key.
+     *        Allows streaming a large value through a small buffer with
+     *        repeated get_data calls, without allocating the whole value.
+     *
+     * @param[out] handle               Returned get handle.
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[out] value_size           Value data size (NULL to pass nothing).
+     *
+     * @returns MBED_SUCCESS on success or an error code on failure
+     */
+    virtual int get_start(get_handle_t *handle, const char *key, size_t *value_size = NULL) = 0;
+
+    /**
+     * @brief Read a chunk of value data from a chunked get sequence.
+     *
+     * @param[in]  handle               Get handle.
+     * @param[in]  buffer               Value data buffer.
+     * @param[in]  buffer_size          Value data buffer size.
+     * @param[out] actual_size          Actual read size (NULL to pass nothing).
+     * @param[in]  offset               Offset to read from in data.
+     *
+     * @returns MBED_SUCCESS on success or an error code on failure
+     */
+    virtual int get_data(get_handle_t handle, void *buffer, size_t buffer_size,
+                         size_t *actual_size = NULL, size_t offset = 0) = 0;
+
+    /**
+     * @brief Finalize a chunked KVStore get sequence.
+     *
+     * @param[in]  handle               Get handle.
+     *
+     * @returns MBED_SUCCESS on success or an error code on failure
+     */
+    virtual int get_finalize(get_handle_t handle) = 0;
+
     /**
      * @brief Start an iteration over KVStore keys.
      *
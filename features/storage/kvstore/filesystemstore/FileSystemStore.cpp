@@ -31,6 +31,8 @@
 #define FSST_REVISION 1
 #define FSST_MAGIC 0x46535354 // "FSST" hex 'magic' signature
 
+#define FSST_INDEX_BUCKETS 16 // Number of hash buckets in the in-RAM key index
+
 #ifndef FSST_FOLDER_PATH
 #define FSST_FOLDER_PATH "kvstore" //default FileSystemStore folder path on fs
 #endif
@@ -49,21 +51,30 @@ typedef struct {
     File *file_handle;
 } inc_set_handle_t;
 
-// iterator handle
+// iterator handle, walking the in-RAM key index
 typedef struct {
-    void *dir_handle;
+    uint32_t bucket;
+    uint32_t pos;
     char *prefix;
 } key_iterator_handle_t;
 
+// chunked get handle
+typedef struct {
+    File *file_handle;
+    size_t data_size;
+    size_t metadata_size;
+} inc_get_handle_t;
+
 } // anonymous namespace
 
 // Local Functions
 static char *string_ndup(const char *src, size_t size);
+static uint32_t key_hash(const char *key);
 
 
 // Class Functions
 FileSystemStore::FileSystemStore(FileSystem *fs) : _fs(fs),
-    _is_initialized(false)
+    _is_initialized(false), _key_index(NULL)
 {
 
 }
@@ -98,6 +109,17 @@ int FileSystemStore::init()
         }
     }
 
+    _key_index = new key_index_entry_t *[FSST_INDEX_BUCKETS];
+    memset(_key_index, 0, FSST_INDEX_BUCKETS * sizeof(key_index_entry_t *));
+    if (_build_key_index() != 0) {
+        tr_error("KV Dir: %s, building key index failed", _cfg_fs_path);
+        _clear_key_index();
+        delete[] _key_index;
+        _key_index = NULL;
+        status = MBED_ERROR_FAILED_OPERATION;
+        goto exit_point;
+    }
+
     _is_initialized = true;
 exit_point:
 
@@ -113,6 +135,11 @@ int FileSystemStore::deinit()
     _is_initialized = false;
     delete[] _cfg_fs_path;
     delete[] _full_path_key;
+    if (_key_index != NULL) {
+        _clear_key_index();
+        delete[] _key_index;
+        _key_index = NULL;
+    }
     _mutex.unlock();
     return MBED_SUCCESS;
 
@@ -144,6 +171,7 @@ int FileSystemStore::reset()
     }
 
     kv_dir.close();
+    _clear_key_index();
 
 exit_point:
     _mutex.unlock();
@@ -194,8 +222,10 @@ int FileSystemStore::get(const char *key, void *buffer, size_t buffer_size, size
     int status = MBED_SUCCESS;
 
     File kv_file;
+    bool kv_file_opened = false;
     size_t kv_file_size = 0;
     size_t value_actual_size = 0;
+    key_index_entry_t *key_entry = NULL;
 
     _mutex.lock();
 
@@ -204,14 +234,32 @@ int FileSystemStore::get(const char *key, void *buffer, size_t buffer_size, size
         goto exit_point;
     }
 
-    key_metadata_t key_metadata;
+    if (!is_valid_key(key)) {
+        status = MBED_ERROR_INVALID_ARGUMENT;
+        goto exit_point;
+    }
 
-    if ((status = _verify_key_file(key, &key_metadata, &kv_file)) != MBED_SUCCESS) {
-        tr_error("File Verification failed, status: %d", status);
+    // Index lookup replaces a directory walk in the underlying file system
+    key_entry = _find_key_entry(key);
+    if (key_entry == NULL) {
+        status = MBED_ERROR_ITEM_NOT_FOUND;
+        goto exit_point;
+    }
+
+    if (key_entry->metadata_size == 0) {
+        status = MBED_ERROR_INVALID_DATA_DETECTED;
+        goto exit_point;
+    }
+
+    _build_full_path_key(key);
+    if (0 != kv_file.open(_fs, _full_path_key, O_RDONLY)) {
+        tr_error("Couldn't read: %s", _full_path_key);
+        status = MBED_ERROR_ITEM_NOT_FOUND;
         goto exit_point;
     }
+    kv_file_opened = true;
 
-    kv_file_size = kv_file.size() - key_metadata.metadata_size;
+    kv_file_size = kv_file.size() - key_entry->metadata_size;
     // Actual size is the minimum of buffer_size and remainder of data in file (file's data size - offset)
     value_actual_size = buffer_size;
     if (offset > kv_file_size) {
@@ -230,13 +278,12 @@ int FileSystemStore::get(const char *key, void *buffer, size_t buffer_size, size
         *actual_size = value_actual_size;
     }
 
-    kv_file.seek(key_metadata.metadata_size + offset, SEEK_SET);
+    kv_file.seek(key_entry->metadata_size + offset, SEEK_SET);
     // Read remainder of data
     kv_file.read(buffer, value_actual_size);
 
 exit_point:
-    if ((status == MBED_SUCCESS) ||
-            (status == MBED_ERROR_INVALID_DATA_DETECTED)) {
+    if (kv_file_opened) {
         kv_file.close();
     }
     _mutex.unlock();
@@ -247,7 +294,7 @@ exit_point:
 int FileSystemStore::get_info(const char *key, info_t *info)
 {
     int status = MBED_SUCCESS;
-    File kv_file;
+    key_index_entry_t *key_entry = NULL;
 
     _mutex.lock();
 
@@ -256,23 +303,29 @@ int FileSystemStore::get_info(const char *key, info_t *info)
         goto exit_point;
     }
 
-    key_metadata_t key_metadata;
+    if (!is_valid_key(key)) {
+        status = MBED_ERROR_INVALID_ARGUMENT;
+        goto exit_point;
+    }
 
-    if ((status = _verify_key_file(key, &key_metadata, &kv_file)) != MBED_SUCCESS) {
-        tr_error("File Verification failed, status: %d", status);
+    // Size and flags are cached in the index - no file system access needed
+    key_entry = _find_key_entry(key);
+    if (key_entry == NULL) {
+        status = MBED_ERROR_ITEM_NOT_FOUND;
+        goto exit_point;
+    }
+
+    if (key_entry->metadata_size == 0) {
+        status = MBED_ERROR_INVALID_DATA_DETECTED;
         goto exit_point;
     }
 
     if (info != NULL) {
-        info->size = kv_file.size() - key_metadata.metadata_size;
-        info->flags = key_metadata.user_flags;
+        info->size = key_entry->data_size;
+        info->flags = key_entry->user_flags;
     }
 
 exit_point:
-    if ((status == MBED_SUCCESS) ||
-            (status == MBED_ERROR_INVALID_DATA_DETECTED)) {
-        kv_file.close();
-    }
     _mutex.unlock();
 
     return status;
@@ -280,8 +333,7 @@ exit_point:
 
 int FileSystemStore::remove(const char *key)
 {
-    File kv_file;
-    key_metadata_t key_metadata;
+    key_index_entry_t *key_entry = NULL;
 
     _mutex.lock();
 
@@ -292,23 +344,31 @@ int FileSystemStore::remove(const char *key)
         goto exit_point;
     }
 
-    /* If File Exists and is Valid, then check its Write Once Flag to verify its disabled before removing */
-    /* If File exists and is not valid, or is Valid and not Write-Onced then remove it */
-    if ((status = _verify_key_file(key, &key_metadata, &kv_file)) == MBED_SUCCESS) {
-        tr_error("File: %s, Exists Verifying Write Once Disabled before setting new value", _full_path_key);
-        if (key_metadata.user_flags & KVStore::WRITE_ONCE_FLAG) {
-            kv_file.close();
-            status = MBED_ERROR_WRITE_PROTECTED;
-            goto exit_point;
-        }
-    } else if ((status == MBED_ERROR_ITEM_NOT_FOUND) ||
-               (status == MBED_ERROR_INVALID_ARGUMENT)) {
+    if (!is_valid_key(key)) {
+        status = MBED_ERROR_INVALID_ARGUMENT;
+        goto exit_point;
+    }
+
+    /* If Key Exists and is Valid, then check its Write Once Flag to verify its disabled before removing */
+    /* If Key exists and is not valid, or is Valid and not Write-Onced then remove it */
+    key_entry = _find_key_entry(key);
+    if (key_entry == NULL) {
+        status = MBED_ERROR_ITEM_NOT_FOUND;
         goto exit_point;
     }
-    kv_file.close();
 
+    if (key_entry->metadata_size == 0) {
+        status = MBED_ERROR_INVALID_DATA_DETECTED;
+    } else if (key_entry->user_flags & KVStore::WRITE_ONCE_FLAG) {
+        status = MBED_ERROR_WRITE_PROTECTED;
+        goto exit_point;
+    }
+
+    _build_full_path_key(key);
     if (0 != _fs->remove(_full_path_key)) {
         status =  MBED_ERROR_FAILED_OPERATION;
+    } else {
+        _remove_key_entry(key);
     }
 
 exit_point:
@@ -323,6 +383,7 @@ int FileSystemStore::set_start(set_handle_t *handle, const char *key, size_t fin
     inc_set_handle_t *set_handle = NULL;
     File *kv_file;
     key_metadata_t key_metadata;
+    key_index_entry_t *key_entry = NULL;
     int key_len = 0;
 
     if (create_flags & ~supported_flags) {
@@ -339,29 +400,24 @@ int FileSystemStore::set_start(set_handle_t *handle, const char *key, size_t fin
         goto exit_point;
     }
 
-    /* If File Exists and is Valid, then check its Write Once Flag to verify its disabled before setting */
-    /* If File exists and is not valid, or is Valid and not Write-Onced then erase it */
-    status = _verify_key_file(key, &key_metadata, kv_file);
-
-    if (status == MBED_ERROR_INVALID_ARGUMENT) {
-        tr_error("File Verification failed, status: %d", status);
+    if (!is_valid_key(key)) {
+        tr_error("Invalid key: %s", key);
+        status = MBED_ERROR_INVALID_ARGUMENT;
         goto exit_point;
     }
 
-    if (status == MBED_SUCCESS) {
-        tr_info("File: %s, Exists. Verifying Write Once Disabled before setting new value", _full_path_key);
-        if (key_metadata.user_flags & KVStore::WRITE_ONCE_FLAG) {
-            kv_file->close();
+    /* If Key Exists and is Valid, then check its Write Once Flag to verify its disabled before setting */
+    /* If Key exists and is not valid, or is Valid and not Write-Onced then erase it */
+    key_entry = _find_key_entry(key);
+    if ((key_entry != NULL) && (key_entry->metadata_size != 0)) {
+        tr_info("Key: %s, Exists. Verifying Write Once Disabled before setting new value", key);
+        if (key_entry->user_flags & KVStore::WRITE_ONCE_FLAG) {
             status = MBED_ERROR_WRITE_PROTECTED;
             goto exit_point;
         }
     }
 
-    /* For Success (not write_once) and for corrupted data close file before recreating it as a new file */
-    if (status != MBED_ERROR_ITEM_NOT_FOUND) {
-        kv_file->close();
-    }
-
+    _build_full_path_key(key);
     if ((status = kv_file->open(_fs, _full_path_key, O_WRONLY | O_CREAT | O_TRUNC)) != MBED_SUCCESS) {
         tr_info("set_start failed to open: %s, for writing, err: %d", _full_path_key, status);
         status = MBED_ERROR_FAILED_OPERATION ;
@@ -449,6 +505,9 @@ int FileSystemStore::set_finalize(set_handle_t handle)
                      set_handle->data_size, _full_path_key);
             status = MBED_ERROR_INVALID_SIZE;
             _fs->remove(_full_path_key);
+            _remove_key_entry(set_handle->key);
+        } else {
+            _update_key_entry(set_handle->key, set_handle->create_flags, sizeof(key_metadata_t), set_handle->data_size);
         }
         delete[] set_handle->key;
     }
@@ -467,10 +526,128 @@ exit_point:
     return status;
 }
 
+// Chunked get API
+int FileSystemStore::get_start(get_handle_t *handle, const char *key, size_t *value_size)
+{
+    int status = MBED_SUCCESS;
+    File *kv_file = NULL;
+    inc_get_handle_t *get_handle = NULL;
+    key_index_entry_t *key_entry = NULL;
+
+    if (handle == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    _mutex.lock();
+
+    if (false == _is_initialized) {
+        status = MBED_ERROR_NOT_READY;
+        goto exit_point;
+    }
+
+    if (!is_valid_key(key)) {
+        status = MBED_ERROR_INVALID_ARGUMENT;
+        goto exit_point;
+    }
+
+    key_entry = _find_key_entry(key);
+    if (key_entry == NULL) {
+        status = MBED_ERROR_ITEM_NOT_FOUND;
+        goto exit_point;
+    }
+
+    if (key_entry->metadata_size == 0) {
+        status = MBED_ERROR_INVALID_DATA_DETECTED;
+        goto exit_point;
+    }
+
+    kv_file = new File;
+
+    _build_full_path_key(key);
+    if (0 != kv_file->open(_fs, _full_path_key, O_RDONLY)) {
+        tr_error("Couldn't read: %s", _full_path_key);
+        status = MBED_ERROR_ITEM_NOT_FOUND;
+        delete kv_file;
+        goto exit_point;
+    }
+
+    get_handle = new inc_get_handle_t;
+    get_handle->file_handle = kv_file;
+    get_handle->metadata_size = key_entry->metadata_size;
+    get_handle->data_size = kv_file->size() - key_entry->metadata_size;
+    *handle = (get_handle_t)get_handle;
+
+    if (value_size != NULL) {
+        *value_size = get_handle->data_size;
+    }
+
+exit_point:
+    _mutex.unlock();
+
+    return status;
+}
+
+int FileSystemStore::get_data(get_handle_t handle, void *buffer, size_t buffer_size, size_t *actual_size, size_t offset)
+{
+    int status = MBED_SUCCESS;
+    inc_get_handle_t *get_handle = (inc_get_handle_t *)handle;
+    size_t value_actual_size = 0;
+
+    if (handle == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    _mutex.lock();
+
+    // Actual size is the minimum of buffer_size and remainder of data in file (file's data size - offset)
+    value_actual_size = buffer_size;
+    if (offset > get_handle->data_size) {
+        status = MBED_ERROR_INVALID_SIZE;
+        goto exit_point;
+    } else if ((get_handle->data_size - offset) < buffer_size) {
+        value_actual_size = get_handle->data_size - offset;
+    }
+
+    if ((buffer == NULL) && (value_actual_size > 0)) {
+        status = MBED_ERROR_INVALID_DATA_DETECTED;
+        goto exit_point;
+    }
+
+    get_handle->file_handle->seek(get_handle->metadata_size + offset, SEEK_SET);
+    get_handle->file_handle->read(buffer, value_actual_size);
+
+    if (actual_size != NULL) {
+        *actual_size = value_actual_size;
+    }
+
+exit_point:
+    _mutex.unlock();
+
+    return status;
+}
+
+int FileSystemStore::get_finalize(get_handle_t handle)
+{
+    inc_get_handle_t *get_handle = (inc_get_handle_t *)handle;
+
+    if (handle == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    _mutex.lock();
+
+    get_handle->file_handle->close();
+    delete get_handle->file_handle;
+    delete get_handle;
+
+    _mutex.unlock();
+
+    return MBED_SUCCESS;
+}
+
 int FileSystemStore::iterator_open(iterator_t *it, const char *prefix)
 {
     int status = MBED_SUCCESS;
-    Dir *kv_dir = NULL;
     key_iterator_handle_t *key_it = NULL;
 
     if (it == NULL) {
@@ -483,26 +660,13 @@ int FileSystemStore::iterator_open(iterator_t *it, const char *prefix)
         goto exit_point;
     }
     key_it = new key_iterator_handle_t;
-    key_it->dir_handle = NULL;
+    key_it->bucket = 0;
+    key_it->pos = 0;
     key_it->prefix = NULL;
     if (prefix != NULL) {
         key_it->prefix = string_ndup(prefix, KVStore::MAX_KEY_SIZE);
     }
 
-    kv_dir = new Dir;
-    if (kv_dir->open(_fs, _cfg_fs_path) != 0) {
-        tr_error("KV Dir: %s, doesnt exist", _cfg_fs_path); //TBD verify ERRNO NOEXIST
-        delete kv_dir;
-        if (key_it->prefix != NULL) {
-            delete[] key_it->prefix;
-        }
-        delete key_it;
-        status = MBED_ERROR_ITEM_NOT_FOUND;
-        goto exit_point;
-    }
-
-    key_it->dir_handle = kv_dir;
-
     *it = (iterator_t)key_it;
 
 exit_point:
@@ -513,8 +677,6 @@ exit_point:
 
 int FileSystemStore::iterator_next(iterator_t it, char *key, size_t key_size)
 {
-    Dir *kv_dir;
-    struct dirent kv_dir_ent;
     int status = MBED_ERROR_ITEM_NOT_FOUND;
     key_iterator_handle_t *key_it = NULL;
     size_t key_name_size = KVStore::MAX_KEY_SIZE;
@@ -535,24 +697,29 @@ int FileSystemStore::iterator_next(iterator_t it, char *key, size_t key_size)
         goto exit_point;
     }
 
-    kv_dir = (Dir *)key_it->dir_handle;
-
-    while (kv_dir->read(&kv_dir_ent) != 0) {
-        if (kv_dir_ent.d_type != DT_REG) {
-            tr_error("KV_Dir should contain only Regular File - %s", kv_dir_ent.d_name);
-            continue;
-        }
-
-        if ((key_it->prefix == NULL) ||
-                (strncmp(kv_dir_ent.d_name, key_it->prefix, strlen(key_it->prefix)) == 0)) {
-            if (key_name_size < strlen(kv_dir_ent.d_name)) {
-                status = MBED_ERROR_INVALID_SIZE;
-                break;
+    // Walk the in-RAM index instead of reading the directory. Keys set or
+    // removed since the previous call may be skipped or repeated, as with
+    // a directory read.
+    for (; key_it->bucket < FSST_INDEX_BUCKETS; key_it->bucket++, key_it->pos = 0) {
+        key_index_entry_t *key_entry = _key_index[key_it->bucket];
+        uint32_t pos = 0;
+        for (; key_entry != NULL; key_entry = key_entry->next, pos++) {
+            if (pos < key_it->pos) {
+                continue;
+            }
+            key_it->pos = pos + 1;
+
+            if ((key_it->prefix == NULL) ||
+                    (strncmp(key_entry->key, key_it->prefix, strlen(key_it->prefix)) == 0)) {
+                if (key_name_size < strlen(key_entry->key)) {
+                    status = MBED_ERROR_INVALID_SIZE;
+                    goto exit_point;
+                }
+                strncpy(key, key_entry->key, key_name_size);
+                key[key_name_size - 1] = '\0';
+                status = MBED_SUCCESS;
+                goto exit_point;
             }
-            strncpy(key, kv_dir_ent.d_name, key_name_size);
-            key[key_name_size - 1] = '\0';
-            status = MBED_SUCCESS;
-            break;
         }
     }
 
@@ -576,11 +743,6 @@ int FileSystemStore::iterator_close(iterator_t it)
         delete[] key_it->prefix;
     }
 
-    ((Dir *)(key_it->dir_handle))->close();
-
-    if (key_it->dir_handle != NULL) {
-        delete ((Dir *)(key_it->dir_handle));
-    }
     delete key_it;
 
 exit_point:
@@ -618,6 +780,102 @@ exit_point:
     return status;
 }
 
+int FileSystemStore::_build_key_index()
+{
+    Dir kv_dir;
+    struct dirent dir_ent;
+    File kv_file;
+    key_metadata_t key_metadata;
+    int status;
+
+    if (kv_dir.open(_fs, _cfg_fs_path) != 0) {
+        tr_error("KV Dir: %s, dir_open failed", _cfg_fs_path);
+        return -1;
+    }
+
+    while (kv_dir.read(&dir_ent) != 0) {
+        if (dir_ent.d_type != DT_REG) {
+            tr_error("KV_Dir should contain only Regular File - %s", dir_ent.d_name);
+            continue;
+        }
+
+        status = _verify_key_file(dir_ent.d_name, &key_metadata, &kv_file);
+        if (status == MBED_SUCCESS) {
+            _update_key_entry(dir_ent.d_name, key_metadata.user_flags, key_metadata.metadata_size,
+                              kv_file.size() - key_metadata.metadata_size);
+            kv_file.close();
+        } else if (status == MBED_ERROR_INVALID_DATA_DETECTED) {
+            // Keep corrupted key files visible, marked by a zero metadata size
+            _update_key_entry(dir_ent.d_name, 0, 0, 0);
+            kv_file.close();
+        }
+    }
+
+    kv_dir.close();
+    return 0;
+}
+
+void FileSystemStore::_clear_key_index()
+{
+    for (int i = 0; i < FSST_INDEX_BUCKETS; i++) {
+        key_index_entry_t *key_entry = _key_index[i];
+        while (key_entry != NULL) {
+            key_index_entry_t *next_entry = key_entry->next;
+            delete[] key_entry->key;
+            delete key_entry;
+            key_entry = next_entry;
+        }
+        _key_index[i] = NULL;
+    }
+}
+
+FileSystemStore::key_index_entry_t *FileSystemStore::_find_key_entry(const char *key)
+{
+    key_index_entry_t *key_entry = _key_index[key_hash(key) % FSST_INDEX_BUCKETS];
+
+    while (key_entry != NULL) {
+        if (strcmp(key_entry->key, key) == 0) {
+            return key_entry;
+        }
+        key_entry = key_entry->next;
+    }
+
+    return NULL;
+}
+
+void FileSystemStore::_update_key_entry(const char *key, uint32_t user_flags, size_t metadata_size, size_t data_size)
+{
+    key_index_entry_t *key_entry = _find_key_entry(key);
+
+    if (key_entry == NULL) {
+        uint32_t bucket = key_hash(key) % FSST_INDEX_BUCKETS;
+        key_entry = new key_index_entry_t;
+        key_entry->key = string_ndup(key, strlen(key));
+        key_entry->next = _key_index[bucket];
+        _key_index[bucket] = key_entry;
+    }
+
+    key_entry->user_flags = user_flags;
+    key_entry->metadata_size = metadata_size;
+    key_entry->data_size = data_size;
+}
+
+void FileSystemStore::_remove_key_entry(const char *key)
+{
+    key_index_entry_t **key_entry_ptr = &_key_index[key_hash(key) % FSST_INDEX_BUCKETS];
+
+    while (*key_entry_ptr != NULL) {
+        key_index_entry_t *key_entry = *key_entry_ptr;
+        if (strcmp(key_entry->key, key) == 0) {
+            *key_entry_ptr = key_entry->next;
+            delete[] key_entry->key;
+            delete key_entry;
+            return;
+        }
+        key_entry_ptr = &key_entry->next;
+    }
+}
+
 int FileSystemStore::_build_full_path_key(const char *key_src)
 {
     strncpy(&_full_path_key[_cfg_fs_path_size + 1/* for path's \ */], key_src, KVStore::MAX_KEY_SIZE);
@@ -634,5 +892,18 @@ static char *string_ndup(const char *src, size_t size)
     return string_copy;
 }
 
+// djb2 string hash, for spreading keys across the index buckets
+static uint32_t key_hash(const char *key)
+{
+    uint32_t hash = 5381;
+
+    while (*key != '\0') {
+        hash = hash * 33 + *key;
+        key++;
+    }
+
+    return hash;
+}
+
 
 
@@ -183,6 +183,51 @@ public:
      */
     virtual int set_finalize(set_handle_t handle);
 
+    /**
+     * @brief Start a chunked FileSystemStore get sequence, given key. The key file is
+     *        kept open in the handle, so subsequent get_data calls don't reopen and
+     *        reverify it. There are no issues with any other operations while a get
+     *        handle is open.
+     *
+     * @param[out] handle               Returned get handle.
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[out] value_size           Value data size.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_DATA_DETECTED    Data is corrupted.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No such key.
+     */
+    virtual int get_start(get_handle_t *handle, const char *key, size_t *value_size = NULL);
+
+    /**
+     * @brief Read a chunk of value data from a chunked get sequence.
+     *
+     * @param[in]  handle               Get handle.
+     * @param[in]  buffer               Value data buffer.
+     * @param[in]  buffer_size          Value data buffer size.
+     * @param[out] actual_size          Actual read size.
+     * @param[in]  offset               Offset to read from in data.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_SIZE             Invalid size given in function arguments.
+     *          MBED_ERROR_INVALID_DATA_DETECTED    Data is corrupted.
+     */
+    virtual int get_data(get_handle_t handle, void *buffer, size_t buffer_size,
+                         size_t *actual_size = NULL, size_t offset = 0);
+
+    /**
+     * @brief Finalize a chunked FileSystemStore get sequence, closing the key file.
+     *
+     * @param[in]  handle               Get handle.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     */
+    virtual int get_finalize(get_handle_t handle);
+
     /**
      * @brief Start an iteration over FileSystemStore keys.
      *        There are no issues with any other operations while iterator is open.
@@ -233,6 +278,56 @@ private:
         uint32_t user_flags;
     } key_metadata_t;
 
+    // In-RAM key index entry, chained per hash bucket. A metadata_size of 0
+    // marks a key file whose metadata failed validation when indexed.
+    typedef struct key_index_entry {
+        struct key_index_entry *next;
+        char *key;
+        uint32_t user_flags;
+        size_t metadata_size;
+        size_t data_size;
+    } key_index_entry_t;
+
+    /**
+     * @brief Build the in-RAM key index by scanning the KVStore folder once,
+     *        reading each key file's metadata.
+     *
+     * @returns 0 on success or a negative error code on failure
+     */
+    int _build_key_index();
+
+    /**
+     * @brief Free all key index entries, leaving the bucket array empty.
+     */
+    void _clear_key_index();
+
+    /**
+     * @brief Look a key up in the in-RAM index.
+     *
+     * @param[in]  key                  Key name.
+     *
+     * @returns The key's index entry, or NULL if the key doesn't exist
+     */
+    key_index_entry_t *_find_key_entry(const char *key);
+
+    /**
+     * @brief Add a key to the in-RAM index, or update its cached metadata
+     *        if already present.
+     *
+     * @param[in]  key                  Key name.
+     * @param[in]  user_flags           Key flag mask.
+     * @param[in]  metadata_size        Size of the key file's metadata (0 if invalid).
+     * @param[in]  data_size            Size of the key's value data.
+     */
+    void _update_key_entry(const char *key, uint32_t user_flags, size_t metadata_size, size_t data_size);
+
+    /**
+     * @brief Remove a key from the in-RAM index, if present.
+     *
+     * @param[in]  key                  Key name.
+     */
+    void _remove_key_entry(const char *key);
+
     /**
      * @brief Build Full name class member from Key, as a combination of FSST folder and key name
      *
@@ -261,6 +356,7 @@ private:
     char *_cfg_fs_path; /* FileSystemStore path name on FileSystem */
     size_t _cfg_fs_path_size; /* Size of configured FileSystemStore path name on FileSystem */
     char *_full_path_key; /* Full name of Key file currently working on */
+    key_index_entry_t **_key_index; /* Hash buckets of the in-RAM key index */
     size_t _cur_inc_data_size; /* Amount of data added to Key file so far, during incremental add data */
     set_handle_t _cur_inc_set_handle; /* handle of currently key file under incremental set process */
 #endif
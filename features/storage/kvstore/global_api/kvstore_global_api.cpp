@@ -30,6 +30,13 @@ struct _opaque_kv_key_iterator {
     char *path;
 };
 
+// opened key handle, caches the resolved KVStore instance and inner key
+struct _opaque_kv_key_handle {
+    KVStore *kvstore_instance;
+    char *key;
+    uint32_t flags_mask;
+};
+
 int kv_set(const char *full_name_key, const void *buffer, size_t size, uint32_t create_flags)
 {
     int ret = kv_init_storage_config();
@@ -111,6 +118,83 @@ int kv_remove(const char *full_name_key)
     return kv_instance->remove(full_name_key + key_index);
 }
 
+int kv_open(kv_key_handle_t *handle, const char *full_name_key)
+{
+    if (handle == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    int ret = kv_init_storage_config();
+    if (MBED_SUCCESS != ret) {
+        return ret;
+    }
+
+    KVMap &kv_map = KVMap::get_instance();
+    KVStore *kv_instance = NULL;
+    uint32_t flags_mask = 0;
+    size_t key_index = 0;
+    ret = kv_map.lookup(full_name_key, &kv_instance, &key_index, &flags_mask);
+    if (ret != MBED_SUCCESS) {
+        return ret;
+    }
+
+    (*handle) = new _opaque_kv_key_handle;
+    if (*handle == NULL) {
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+
+    (*handle)->kvstore_instance = kv_instance;
+    (*handle)->flags_mask = flags_mask;
+    (*handle)->key = new char[strlen(full_name_key + key_index) + 1];
+    strcpy((*handle)->key, full_name_key + key_index);
+    return ret;
+}
+
+int kv_set_h(kv_key_handle_t handle, const void *buffer, size_t size, uint32_t create_flags)
+{
+    if (handle == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    return handle->kvstore_instance->set(handle->key, buffer, size, create_flags & handle->flags_mask);
+}
+
+int kv_get_h(kv_key_handle_t handle, void *buffer, size_t buffer_size, size_t *actual_size)
+{
+    if (handle == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    return handle->kvstore_instance->get(handle->key, buffer, buffer_size, actual_size);
+}
+
+int kv_get_info_h(kv_key_handle_t handle, kv_info_t *info)
+{
+    if (handle == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    KVStore::info_t inner_info;
+    int ret = handle->kvstore_instance->get_info(handle->key, &inner_info);
+    if (MBED_SUCCESS != ret) {
+        return ret;
+    }
+    info->flags = inner_info.flags;
+    info->size =  inner_info.size;
+    return ret;
+}
+
+int kv_close(kv_key_handle_t handle)
+{
+    if (handle == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    delete[] handle->key;
+    delete handle;
+    return MBED_SUCCESS;
+}
+
 int kv_iterator_open(kv_iterator_t *it, const char *full_prefix)
 {
     if (it == NULL) {
@@ -25,6 +25,8 @@ extern "C" {
 
 typedef struct _opaque_kv_key_iterator *kv_iterator_t;
 
+typedef struct _opaque_kv_key_handle *kv_key_handle_t;
+
 #define KV_WRITE_ONCE_FLAG                      (1 << 0)
 #define KV_REQUIRE_CONFIDENTIALITY_FLAG         (1 << 1)
 #define KV_RESERVED_FLAG                        (1 << 2)
@@ -92,6 +94,66 @@ int kv_get_info(const char *full_name_key, kv_info_t *info);
  */
 int kv_remove(const char *full_name_key);
 
+/**
+ * @brief Open a handle to one KVStore key, resolving the partition once.
+ *
+ *        The handle caches the KVStore instance and key resolved from the
+ *        full name, so repeated accesses through kv_set_h/kv_get_h skip
+ *        the per-call partition lookup. Intended for keys written or read
+ *        frequently, such as telemetry values.
+ *
+ * @param[out] handle               Allocated key handle.
+ *                                  Do not forget to call kv_close to
+ *                                  deallocate the memory.
+ * @param[in]  full_name_key        /Partition_path/Key. Must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+ *
+ * @returns MBED_SUCCESS on success or an error code from underlying KVStore instances
+ */
+int kv_open(kv_key_handle_t *handle, const char *full_name_key);
+
+/**
+ * @brief Set the KVStore item of an opened key handle.
+ *
+ * @param[in]  handle               Key handle.
+ * @param[in]  buffer               Value data buffer.
+ * @param[in]  size                 Value data size.
+ * @param[in]  create_flags         Flag mask.
+ *
+ * @returns MBED_SUCCESS on success or an error code from underlying KVStore instances
+ */
+int kv_set_h(kv_key_handle_t handle, const void *buffer, size_t size, uint32_t create_flags);
+
+/**
+ * @brief Get the KVStore item of an opened key handle.
+ *
+ * @param[in]  handle               Key handle.
+ * @param[in]  buffer               Value data buffer.
+ * @param[in]  buffer_size          Value data buffer size.
+ * @param[out] actual_size          Actual read size.
+ *
+ * @returns MBED_SUCCESS on success or an error code from underlying KVStore instances
+ */
+int kv_get_h(kv_key_handle_t handle, void *buffer, size_t buffer_size, size_t *actual_size);
+
+/**
+ * @brief Get information of an opened key handle. The returned info contains size and flags
+ *
+ * @param[in]  handle               Key handle.
+ * @param[out] info                 Returned information structure.
+ *
+ * @returns MBED_SUCCESS on success or an error code from underlying KVStore instances
+ */
+int kv_get_info_h(kv_key_handle_t handle, kv_info_t *info);
+
+/**
+ * @brief Close a key handle and deallocate its memory.
+ *
+ * @param[in]  handle               Key handle.
+ *
+ * @returns MBED_SUCCESS on success or an error code from underlying KVStore instances
+ */
+int kv_close(kv_key_handle_t handle);
+
 /**
  * @brief Start an iteration over KVStore keys to find all the entries
  *        that fit the full_prefix. There are no issues with any other operations while
@@ -65,9 +65,11 @@ int KVMap::attach(const char *partition_name, kvstore_config_t *kv_config)
         goto exit;
     }
 
-    kv_partition_name = new char[strlen(partition_name + 1)];
+    kv_partition_name = new char[strlen(partition_name) + 1];
     strcpy(kv_partition_name, partition_name);
     _kv_map_table[_kv_num_attached_kvs].partition_name = kv_partition_name;
+    _kv_map_table[_kv_num_attached_kvs].partition_name_len = strlen(partition_name);
+    _kv_map_table[_kv_num_attached_kvs].partition_name_hash = name_hash(partition_name, strlen(partition_name));
     _kv_map_table[_kv_num_attached_kvs].kv_config = kv_config;
     _kv_num_attached_kvs++;
 
@@ -164,6 +166,18 @@ exit:
     return ret;
 }
 
+// djb2 hash, cheap enough to compute in one pass over a partition name
+uint32_t KVMap::name_hash(const char *name, size_t len)
+{
+    uint32_t hash = 5381;
+
+    for (size_t i = 0; i < len; i++) {
+        hash = ((hash << 5) + hash) + (uint8_t)name[i];
+    }
+
+    return hash;
+}
+
 // Full name lookup and then break it into KVStore instance and key
 int KVMap::lookup(const char *full_name, KVStore **kv_instance, size_t *key_index, uint32_t *flags_mask)
 {
@@ -191,6 +205,7 @@ int KVMap::config_lookup(const char *full_name, kvstore_config_t **kv_config, si
     int ret = MBED_SUCCESS;
     int delimiter_index;
     int i;
+    uint32_t partition_hash;
     const char *delimiter_position;
 
     const char *temp_str = full_name;
@@ -221,9 +236,14 @@ int KVMap::config_lookup(const char *full_name, kvstore_config_t **kv_config, si
 
 
     delimiter_index = delimiter_position - temp_str;
+    partition_hash = name_hash(temp_str, delimiter_index);
     for (i = 0; i < _kv_num_attached_kvs; i++) {
 
-        if (strncmp(temp_str, _kv_map_table[i].partition_name, delimiter_index) != 0) {
+        // compare the precomputed hash and length first, the string
+        // compare only confirms the rare matching entry
+        if (_kv_map_table[i].partition_name_hash != partition_hash ||
+                _kv_map_table[i].partition_name_len != (size_t)delimiter_index ||
+                strncmp(temp_str, _kv_map_table[i].partition_name, delimiter_index) != 0) {
             continue;
         }
 
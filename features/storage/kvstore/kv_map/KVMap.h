@@ -77,6 +77,15 @@ typedef struct {
       * Partition name string
       */
     char *partition_name;
+    /**
+      * Partition name length, precomputed at attach time
+      */
+    size_t partition_name_len;
+    /**
+      * Partition name hash, precomputed at attach time so lookups can
+      * reject non-matching entries without a string compare
+      */
+    uint32_t partition_name_hash;
     /**
      * Configuration struct.
      */
@@ -228,6 +237,15 @@ private:
      */
     int config_lookup(const char *full_name, kvstore_config_t **kv_config, size_t *key_index);
 
+    /**
+     * @brief Hash a partition name for the attachment table.
+     *
+     * @param[in] name  Name characters, not necessarily NULL terminated.
+     * @param[in] len   Number of characters to hash.
+     * @return Hash of the name
+     */
+    static uint32_t name_hash(const char *name, size_t len);
+
     // Attachment table
     kv_map_entry_t _kv_map_table[MAX_ATTACHED_KVS];
     int _kv_num_attached_kvs;
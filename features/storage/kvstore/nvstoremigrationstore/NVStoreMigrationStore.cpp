@@ -0,0 +1,620 @@
+/*
+ * Copyright (c) 2019 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NVStoreMigrationStore.h"
+
+#if NVSTORE_ENABLED
+
+#include "mbed_error.h"
+#include <algorithm>
+#include <string.h>
+#include <stdlib.h>
+
+using namespace mbed;
+
+namespace {
+
+// incremental set handle
+typedef struct {
+    KVStore::set_handle_t underlying_handle;
+    uint16_t nv_key;
+    bool has_legacy_key;
+} inc_set_handle_t;
+
+// chunked get handle - serves either the underlying store or a RAM snapshot
+// of a legacy value (legacy_data != NULL), as NVStore has no chunked read
+typedef struct {
+    KVStore::get_handle_t underlying_handle;
+    uint8_t *legacy_data;
+    size_t data_size;
+} inc_get_handle_t;
+
+// iterator handle
+typedef struct {
+    KVStore::iterator_t underlying_it;
+    bool underlying_done;
+    size_t map_pos;
+    char *prefix;
+} key_iterator_handle_t;
+
+} // anonymous namespace
+
+// Local Functions
+static int nvstore_to_kvstore_error(int nv_ret)
+{
+    switch (nv_ret) {
+        case NVSTORE_SUCCESS:
+            return MBED_SUCCESS;
+        case NVSTORE_NOT_FOUND:
+            return MBED_ERROR_ITEM_NOT_FOUND;
+        case NVSTORE_READ_ERROR:
+            return MBED_ERROR_READ_FAILED;
+        case NVSTORE_WRITE_ERROR:
+            return MBED_ERROR_WRITE_FAILED;
+        case NVSTORE_DATA_CORRUPT:
+            return MBED_ERROR_INVALID_DATA_DETECTED;
+        case NVSTORE_BAD_VALUE:
+            return MBED_ERROR_INVALID_ARGUMENT;
+        case NVSTORE_BUFF_TOO_SMALL:
+            return MBED_ERROR_INVALID_SIZE;
+        default:
+            return MBED_ERROR_FAILED_OPERATION;
+    }
+}
+
+
+// Class member functions
+
+NVStoreMigrationStore::NVStoreMigrationStore(KVStore *underlying_kv, const key_map_entry_t *key_map,
+                                             size_t key_map_size) :
+    _underlying_kv(underlying_kv), _key_map(key_map), _key_map_size(key_map_size),
+    _is_initialized(false)
+{
+}
+
+NVStoreMigrationStore::~NVStoreMigrationStore()
+{
+    deinit();
+}
+
+int NVStoreMigrationStore::init()
+{
+    int ret = MBED_SUCCESS;
+
+    _mutex.lock();
+
+    if (_is_initialized) {
+        goto exit_point;
+    }
+
+    ret = _underlying_kv->init();
+    if (ret) {
+        goto exit_point;
+    }
+
+    ret = nvstore_to_kvstore_error(NVStore::get_instance().init());
+    if (ret) {
+        goto exit_point;
+    }
+
+    _is_initialized = true;
+
+exit_point:
+    _mutex.unlock();
+
+    return ret;
+}
+
+int NVStoreMigrationStore::deinit()
+{
+    _mutex.lock();
+    if (_is_initialized) {
+        // NVStore is a shared singleton - leave it initialized for other users
+        _underlying_kv->deinit();
+        _is_initialized = false;
+    }
+    _mutex.unlock();
+
+    return MBED_SUCCESS;
+}
+
+int NVStoreMigrationStore::reset()
+{
+    int ret;
+
+    _mutex.lock();
+
+    if (!_is_initialized) {
+        ret = MBED_ERROR_NOT_READY;
+        goto exit_point;
+    }
+
+    ret = _underlying_kv->reset();
+    if (ret) {
+        goto exit_point;
+    }
+
+    // Only mapped legacy keys belong to this store - other NVStore keys may
+    // be owned by other components
+    for (size_t i = 0; i < _key_map_size; i++) {
+        NVStore::get_instance().remove(_key_map[i].nv_key);
+    }
+
+exit_point:
+    _mutex.unlock();
+
+    return ret;
+}
+
+int NVStoreMigrationStore::set(const char *key, const void *buffer, size_t size, uint32_t create_flags)
+{
+    int ret;
+    uint16_t nv_key;
+
+    _mutex.lock();
+
+    if (!_is_initialized) {
+        ret = MBED_ERROR_NOT_READY;
+        goto exit_point;
+    }
+
+    ret = _underlying_kv->set(key, buffer, size, create_flags);
+    if (ret) {
+        goto exit_point;
+    }
+
+    // The key now lives in the underlying store - drop its legacy copy so it
+    // can't resurrect through the read path after a later remove
+    if (_lookup_legacy_key(key, nv_key)) {
+        NVStore::get_instance().remove(nv_key);
+    }
+
+exit_point:
+    _mutex.unlock();
+
+    return ret;
+}
+
+int NVStoreMigrationStore::get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size,
+                               size_t offset)
+{
+    int ret;
+    uint16_t nv_key;
+    uint8_t *legacy_data = NULL;
+    size_t legacy_size = 0;
+    size_t copy_size;
+
+    _mutex.lock();
+
+    if (!_is_initialized) {
+        ret = MBED_ERROR_NOT_READY;
+        goto exit_point;
+    }
+
+    ret = _underlying_kv->get(key, buffer, buffer_size, actual_size, offset);
+    if (ret != MBED_ERROR_ITEM_NOT_FOUND) {
+        goto exit_point;
+    }
+
+    if (!_lookup_legacy_key(key, nv_key)) {
+        goto exit_point;
+    }
+
+    ret = _read_legacy_value(nv_key, legacy_data, legacy_size);
+    if (ret) {
+        goto exit_point;
+    }
+
+    if (offset > legacy_size) {
+        ret = MBED_ERROR_INVALID_SIZE;
+        goto exit_point;
+    }
+
+    copy_size = std::min(buffer_size, legacy_size - offset);
+    if ((buffer != NULL) && copy_size) {
+        memcpy(buffer, legacy_data + offset, copy_size);
+    }
+    if (actual_size != NULL) {
+        *actual_size = copy_size;
+    }
+    ret = MBED_SUCCESS;
+
+exit_point:
+    delete[] legacy_data;
+    _mutex.unlock();
+
+    return ret;
+}
+
+int NVStoreMigrationStore::get_info(const char *key, info_t *info)
+{
+    int ret;
+    uint16_t nv_key;
+    uint16_t nv_size;
+
+    _mutex.lock();
+
+    if (!_is_initialized) {
+        ret = MBED_ERROR_NOT_READY;
+        goto exit_point;
+    }
+
+    ret = _underlying_kv->get_info(key, info);
+    if (ret != MBED_ERROR_ITEM_NOT_FOUND) {
+        goto exit_point;
+    }
+
+    if (!_lookup_legacy_key(key, nv_key)) {
+        goto exit_point;
+    }
+
+    ret = nvstore_to_kvstore_error(NVStore::get_instance().get_item_size(nv_key, nv_size));
+    if (ret) {
+        goto exit_point;
+    }
+
+    if (info != NULL) {
+        info->size = nv_size;
+        info->flags = 0;
+    }
+
+exit_point:
+    _mutex.unlock();
+
+    return ret;
+}
+
+int NVStoreMigrationStore::remove(const char *key)
+{
+    int ret;
+    uint16_t nv_key;
+
+    _mutex.lock();
+
+    if (!_is_initialized) {
+        ret = MBED_ERROR_NOT_READY;
+        goto exit_point;
+    }
+
+    ret = _underlying_kv->remove(key);
+    if ((ret != MBED_SUCCESS) && (ret != MBED_ERROR_ITEM_NOT_FOUND)) {
+        goto exit_point;
+    }
+
+    if (_lookup_legacy_key(key, nv_key)) {
+        int nv_ret = NVStore::get_instance().remove(nv_key);
+        if ((ret == MBED_ERROR_ITEM_NOT_FOUND) && (nv_ret == NVSTORE_SUCCESS)) {
+            ret = MBED_SUCCESS;
+        }
+    }
+
+exit_point:
+    _mutex.unlock();
+
+    return ret;
+}
+
+// Incremental set API
+int NVStoreMigrationStore::set_start(set_handle_t *handle, const char *key, size_t final_data_size,
+                                     uint32_t create_flags)
+{
+    int ret;
+    inc_set_handle_t *ih;
+
+    if (handle == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    ih = new inc_set_handle_t;
+    ih->has_legacy_key = _lookup_legacy_key(key, ih->nv_key);
+
+    ret = _underlying_kv->set_start(&ih->underlying_handle, key, final_data_size, create_flags);
+    if (ret) {
+        delete ih;
+        return ret;
+    }
+
+    *handle = reinterpret_cast<set_handle_t>(ih);
+    return MBED_SUCCESS;
+}
+
+int NVStoreMigrationStore::set_add_data(set_handle_t handle, const void *value_data, size_t data_size)
+{
+    inc_set_handle_t *ih = reinterpret_cast<inc_set_handle_t *>(handle);
+
+    if (handle == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    return _underlying_kv->set_add_data(ih->underlying_handle, value_data, data_size);
+}
+
+int NVStoreMigrationStore::set_finalize(set_handle_t handle)
+{
+    int ret;
+    inc_set_handle_t *ih = reinterpret_cast<inc_set_handle_t *>(handle);
+
+    if (handle == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    ret = _underlying_kv->set_finalize(ih->underlying_handle);
+    if ((ret == MBED_SUCCESS) && ih->has_legacy_key) {
+        _mutex.lock();
+        NVStore::get_instance().remove(ih->nv_key);
+        _mutex.unlock();
+    }
+
+    delete ih;
+    return ret;
+}
+
+// Chunked get API
+int NVStoreMigrationStore::get_start(get_handle_t *handle, const char *key, size_t *value_size)
+{
+    int ret;
+    uint16_t nv_key;
+    inc_get_handle_t *ih;
+
+    if (handle == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    _mutex.lock();
+
+    if (!_is_initialized) {
+        _mutex.unlock();
+        return MBED_ERROR_NOT_READY;
+    }
+
+    ih = new inc_get_handle_t;
+    ih->legacy_data = NULL;
+    ih->data_size = 0;
+
+    ret = _underlying_kv->get_start(&ih->underlying_handle, key, value_size);
+    if (ret == MBED_SUCCESS) {
+        goto success;
+    }
+
+    if (ret != MBED_ERROR_ITEM_NOT_FOUND) {
+        goto fail;
+    }
+
+    if (!_lookup_legacy_key(key, nv_key)) {
+        goto fail;
+    }
+
+    ret = _read_legacy_value(nv_key, ih->legacy_data, ih->data_size);
+    if (ret) {
+        goto fail;
+    }
+
+    if (value_size != NULL) {
+        *value_size = ih->data_size;
+    }
+
+success:
+    *handle = reinterpret_cast<get_handle_t>(ih);
+    _mutex.unlock();
+    return MBED_SUCCESS;
+
+fail:
+    delete ih;
+    _mutex.unlock();
+    return ret;
+}
+
+int NVStoreMigrationStore::get_data(get_handle_t handle, void *buffer, size_t buffer_size,
+                                    size_t *actual_size, size_t offset)
+{
+    inc_get_handle_t *ih = reinterpret_cast<inc_get_handle_t *>(handle);
+    size_t copy_size;
+
+    if (handle == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (ih->legacy_data == NULL) {
+        return _underlying_kv->get_data(ih->underlying_handle, buffer, buffer_size, actual_size, offset);
+    }
+
+    if (offset > ih->data_size) {
+        return MBED_ERROR_INVALID_SIZE;
+    }
+
+    copy_size = std::min(buffer_size, ih->data_size - offset);
+    if ((buffer != NULL) && copy_size) {
+        memcpy(buffer, ih->legacy_data + offset, copy_size);
+    }
+    if (actual_size != NULL) {
+        *actual_size = copy_size;
+    }
+
+    return MBED_SUCCESS;
+}
+
+int NVStoreMigrationStore::get_finalize(get_handle_t handle)
+{
+    int ret = MBED_SUCCESS;
+    inc_get_handle_t *ih = reinterpret_cast<inc_get_handle_t *>(handle);
+
+    if (handle == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (ih->legacy_data != NULL) {
+        delete[] ih->legacy_data;
+    } else {
+        ret = _underlying_kv->get_finalize(ih->underlying_handle);
+    }
+
+    delete ih;
+    return ret;
+}
+
+int NVStoreMigrationStore::iterator_open(iterator_t *it, const char *prefix)
+{
+    int ret;
+    key_iterator_handle_t *key_it;
+
+    if (it == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    key_it = new key_iterator_handle_t;
+    key_it->underlying_done = false;
+    key_it->map_pos = 0;
+    key_it->prefix = NULL;
+    if (prefix != NULL) {
+        key_it->prefix = new char[strlen(prefix) + 1];
+        strcpy(key_it->prefix, prefix);
+    }
+
+    ret = _underlying_kv->iterator_open(&key_it->underlying_it, prefix);
+    if (ret) {
+        delete[] key_it->prefix;
+        delete key_it;
+        return ret;
+    }
+
+    *it = reinterpret_cast<iterator_t>(key_it);
+    return MBED_SUCCESS;
+}
+
+int NVStoreMigrationStore::iterator_next(iterator_t it, char *key, size_t key_size)
+{
+    int ret;
+    key_iterator_handle_t *key_it = reinterpret_cast<key_iterator_handle_t *>(it);
+
+    if (it == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    _mutex.lock();
+
+    if (!_is_initialized) {
+        ret = MBED_ERROR_NOT_READY;
+        goto exit_point;
+    }
+
+    // Underlying keys first, then mapped legacy keys that weren't migrated yet
+    if (!key_it->underlying_done) {
+        ret = _underlying_kv->iterator_next(key_it->underlying_it, key, key_size);
+        if (ret != MBED_ERROR_ITEM_NOT_FOUND) {
+            goto exit_point;
+        }
+        key_it->underlying_done = true;
+    }
+
+    ret = MBED_ERROR_ITEM_NOT_FOUND;
+    while (key_it->map_pos < _key_map_size) {
+        const key_map_entry_t *entry = &_key_map[key_it->map_pos];
+        key_it->map_pos++;
+
+        if ((key_it->prefix != NULL) &&
+                (strncmp(entry->key, key_it->prefix, strlen(key_it->prefix)) != 0)) {
+            continue;
+        }
+
+        // Migrated keys were already returned by the underlying iteration
+        info_t info;
+        if (_underlying_kv->get_info(entry->key, &info) != MBED_ERROR_ITEM_NOT_FOUND) {
+            continue;
+        }
+
+        uint16_t nv_size;
+        if (NVStore::get_instance().get_item_size(entry->nv_key, nv_size) != NVSTORE_SUCCESS) {
+            continue;
+        }
+
+        if (key_size < strlen(entry->key) + 1) {
+            ret = MBED_ERROR_INVALID_SIZE;
+            goto exit_point;
+        }
+
+        strcpy(key, entry->key);
+        ret = MBED_SUCCESS;
+        goto exit_point;
+    }
+
+exit_point:
+    _mutex.unlock();
+
+    return ret;
+}
+
+int NVStoreMigrationStore::iterator_close(iterator_t it)
+{
+    key_iterator_handle_t *key_it = reinterpret_cast<key_iterator_handle_t *>(it);
+
+    if (it == NULL) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    _underlying_kv->iterator_close(key_it->underlying_it);
+    delete[] key_it->prefix;
+    delete key_it;
+
+    return MBED_SUCCESS;
+}
+
+bool NVStoreMigrationStore::_lookup_legacy_key(const char *key, uint16_t &nv_key) const
+{
+    if (key == NULL) {
+        return false;
+    }
+
+    for (size_t i = 0; i < _key_map_size; i++) {
+        if (strcmp(_key_map[i].key, key) == 0) {
+            nv_key = _key_map[i].nv_key;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int NVStoreMigrationStore::_read_legacy_value(uint16_t nv_key, uint8_t *&buffer, size_t &size)
+{
+    NVStore &nvstore = NVStore::get_instance();
+    uint16_t nv_size, actual_size;
+
+    int nv_ret = nvstore.get_item_size(nv_key, nv_size);
+    if (nv_ret != NVSTORE_SUCCESS) {
+        return nvstore_to_kvstore_error(nv_ret);
+    }
+
+    buffer = new uint8_t[nv_size];
+    nv_ret = nvstore.get(nv_key, nv_size, buffer, actual_size);
+    if (nv_ret != NVSTORE_SUCCESS) {
+        delete[] buffer;
+        buffer = NULL;
+        return nvstore_to_kvstore_error(nv_ret);
+    }
+
+    size = actual_size;
+    return MBED_SUCCESS;
+}
+
+#endif // NVSTORE_ENABLED
@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2019 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_NVSTORE_MIGRATION_STORE_H
+#define MBED_NVSTORE_MIGRATION_STORE_H
+
+#include "KVStore.h"
+#include "nvstore.h"
+
+#if NVSTORE_ENABLED || defined(DOXYGEN_ONLY)
+
+#include "PlatformMutex.h"
+
+namespace mbed {
+
+/** NVStoreMigrationStore migrates fielded NVStore data to a KVStore lazily.
+ *
+ *  This class implements the KVStore interface on top of another KVStore
+ *  (typically a TDBStore), reading through to NVStore for keys that have not
+ *  been migrated yet. A key moves to the underlying store the first time it
+ *  is written, and its legacy NVStore copy is removed then - so migration is
+ *  amortized across normal operation instead of a boot-time full copy, which
+ *  doubles flash wear and delays the first boot after an update.
+ *
+ *  NVStore keys are numeric while KVStore keys are strings, so the adapter
+ *  takes a translation table mapping each legacy NVStore key to its new key
+ *  name. Legacy values read through with no create flags.
+ */
+class NVStoreMigrationStore : public KVStore {
+public:
+
+    /** A translation table entry, naming a legacy NVStore key
+     */
+    typedef struct {
+        const char *key; /**< KVStore key name */
+        uint16_t nv_key; /**< Legacy NVStore key number */
+    } key_map_entry_t;
+
+    /** Create NVStoreMigrationStore
+     *
+     *  @param underlying_kv    KVStore that holds the migrated data
+     *  @param key_map          Translation table from key names to legacy NVStore key
+     *                          numbers. Must stay valid while the store is in use.
+     *  @param key_map_size     Number of entries in the translation table
+     */
+    NVStoreMigrationStore(KVStore *underlying_kv, const key_map_entry_t *key_map, size_t key_map_size);
+
+    virtual ~NVStoreMigrationStore();
+
+    /**
+     * @brief Initialize NVStoreMigrationStore, including the underlying KVStore
+     *        and NVStore. No data is copied at this stage.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_FAILED_OPERATION         Underlying store failed to initialize.
+     */
+    virtual int init();
+
+    /**
+     * @brief Deinitialize NVStoreMigrationStore, release and free resources.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     */
+    virtual int deinit();
+
+    /**
+     * @brief Reset NVStoreMigrationStore contents (clear all keys), including
+     *        the legacy NVStore copies of all mapped keys. NVStore keys outside
+     *        the translation table are not touched.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     */
+    virtual int reset();
+
+    /**
+     * @brief Set one NVStoreMigrationStore item, given key and value. The value
+     *        is written to the underlying store and the legacy NVStore copy, if
+     *        one exists, is removed - migrating the key.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[in]  buffer               Value data buffer.
+     * @param[in]  size                 Value data size.
+     * @param[in]  create_flags         Flag mask.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_WRITE_PROTECTED          Already stored with "write once" flag.
+     */
+    virtual int set(const char *key, const void *buffer, size_t size, uint32_t create_flags);
+
+    /**
+     * @brief Get one NVStoreMigrationStore item by given key, reading through
+     *        to NVStore if the key has not been migrated yet.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[in]  buffer               Value data buffer.
+     * @param[in]  buffer_size          Value data buffer size.
+     * @param[out] actual_size          Actual read size.
+     * @param[in]  offset               Offset to read from in data.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_SIZE             Invalid size given in function arguments.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No such key.
+     */
+    virtual int get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size = NULL, size_t offset = 0);
+
+    /**
+     * @brief Get information of a given key, reading through to NVStore if the
+     *        key has not been migrated yet. Legacy values report no flags.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[out] info                 Returned information structure.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No such key.
+     */
+    virtual int get_info(const char *key, info_t *info);
+
+    /**
+     * @brief Remove an NVStoreMigrationStore item by given key, including its
+     *        legacy NVStore copy if the key has not been migrated yet.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No such key.
+     *          MBED_ERROR_WRITE_PROTECTED          Already stored with "write once" flag.
+     */
+    virtual int remove(const char *key);
+
+    /**
+     * @brief Start an incremental NVStoreMigrationStore set sequence. On
+     *        finalize, the legacy NVStore copy of the key is removed.
+     *
+     * @param[out] handle               Returned incremental set handle.
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[in]  final_data_size      Final value data size.
+     * @param[in]  create_flags         Flag mask.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_WRITE_PROTECTED          Already stored with "write once" flag.
+     */
+    virtual int set_start(set_handle_t *handle, const char *key, size_t final_data_size, uint32_t create_flags);
+
+    /**
+     * @brief Add data to incremental NVStoreMigrationStore set sequence.
+     *
+     * @param[in]  handle               Incremental set handle.
+     * @param[in]  value_data           Value data to add.
+     * @param[in]  data_size            Value data size.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     */
+    virtual int set_add_data(set_handle_t handle, const void *value_data, size_t data_size);
+
+    /**
+     * @brief Finalize an incremental NVStoreMigrationStore set sequence.
+     *
+     * @param[in]  handle               Incremental set handle.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     */
+    virtual int set_finalize(set_handle_t handle);
+
+    /**
+     * @brief Start a chunked NVStoreMigrationStore get sequence, given key.
+     *        Not-yet-migrated values are read out of NVStore into RAM once at
+     *        this stage, as NVStore has no chunked read.
+     *
+     * @param[out] handle               Returned get handle.
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[out] value_size           Value data size.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No such key.
+     */
+    virtual int get_start(get_handle_t *handle, const char *key, size_t *value_size = NULL);
+
+    /**
+     * @brief Read a chunk of value data from a chunked get sequence.
+     *
+     * @param[in]  handle               Get handle.
+     * @param[in]  buffer               Value data buffer.
+     * @param[in]  buffer_size          Value data buffer size.
+     * @param[out] actual_size          Actual read size.
+     * @param[in]  offset               Offset to read from in data.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_SIZE             Invalid size given in function arguments.
+     */
+    virtual int get_data(get_handle_t handle, void *buffer, size_t buffer_size,
+                         size_t *actual_size = NULL, size_t offset = 0);
+
+    /**
+     * @brief Finalize a chunked NVStoreMigrationStore get sequence.
+     *
+     * @param[in]  handle               Get handle.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     */
+    virtual int get_finalize(get_handle_t handle);
+
+    /**
+     * @brief Start an iteration over NVStoreMigrationStore keys. Iteration
+     *        covers the underlying store's keys first, then any mapped legacy
+     *        keys that have not been migrated yet.
+     *
+     * @param[out] it                   Returned iterator handle.
+     * @param[in]  prefix               Key prefix (null for all keys).
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     */
+    virtual int iterator_open(iterator_t *it, const char *prefix = NULL);
+
+    /**
+     * @brief Get next key in iteration.
+     *
+     * @param[in]  it                   Iterator handle.
+     * @param[in]  key                  Buffer for returned key.
+     * @param[in]  key_size             Key buffer size.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No more keys found.
+     */
+    virtual int iterator_next(iterator_t it, char *key, size_t key_size);
+
+    /**
+     * @brief Close iteration.
+     *
+     * @param[in]  it                   Iterator handle.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     */
+    virtual int iterator_close(iterator_t it);
+
+#if !defined(DOXYGEN_ONLY)
+private:
+
+    /**
+     * @brief Look a key name up in the translation table.
+     *
+     * @param[in]  key                  Key name.
+     * @param[out] nv_key               Legacy NVStore key number.
+     *
+     * @returns true if the key has a legacy NVStore mapping
+     */
+    bool _lookup_legacy_key(const char *key, uint16_t &nv_key) const;
+
+    /**
+     * @brief Read a whole legacy value out of NVStore into a heap buffer.
+     *
+     * @param[in]  nv_key               Legacy NVStore key number.
+     * @param[out] buffer               Returned heap buffer (caller frees with delete[]).
+     * @param[out] size                 Returned value size.
+     *
+     * @returns MBED_SUCCESS or a converted NVStore error code
+     */
+    int _read_legacy_value(uint16_t nv_key, uint8_t *&buffer, size_t &size);
+
+    KVStore *_underlying_kv;
+    const key_map_entry_t *_key_map;
+    size_t _key_map_size;
+    PlatformMutex _mutex;
+    bool _is_initialized;
+#endif
+};
+
+} // namespace mbed
+
+#endif // NVSTORE_ENABLED
+#endif // MBED_NVSTORE_MIGRATION_STORE_H
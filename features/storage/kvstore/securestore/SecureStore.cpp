@@ -37,12 +37,23 @@ using namespace mbed;
 
 static const uint32_t securestore_revision = 1;
 
+#ifndef MBED_CONF_STORAGE_SECURESTORE_SCRATCH_BUF_SIZE
+#define MBED_CONF_STORAGE_SECURESTORE_SCRATCH_BUF_SIZE 256
+#endif
+
 static const uint32_t enc_block_size    = 16;
 static const uint32_t cmac_size         = 16;
 static const uint32_t iv_size           = 8;
-static const uint32_t scratch_buf_size  = 256;
+// Encryption, authentication and underlying writes are chunked to the scratch
+// buffer size, so larger values amortize the per-chunk crypto and storage
+// overhead on secure sets/gets at the cost of RAM. Must not be smaller than
+// 256, as the buffer also holds the salts derived from key names.
+static const uint32_t scratch_buf_size  = MBED_CONF_STORAGE_SECURESTORE_SCRATCH_BUF_SIZE;
 static const uint32_t derived_key_size  = 16;
 
+MBED_STATIC_ASSERT(MBED_CONF_STORAGE_SECURESTORE_SCRATCH_BUF_SIZE >= 256,
+                   "SecureStore scratch buffer must be at least 256 bytes");
+
 static const char *const enc_prefix  = "ENC";
 static const char *const auth_prefix = "AUTH";
 
@@ -74,6 +85,12 @@ typedef struct {
     KVStore::iterator_t underlying_it;
 } key_iterator_handle_t;
 
+// chunked get handle
+typedef struct {
+    char *key;
+    size_t data_size;
+} inc_get_handle_t;
+
 } // anonymous namespace
 
 
@@ -729,6 +746,71 @@ int SecureStore::get_info(const char *key, info_t *info)
     return ret;
 }
 
+int SecureStore::get_start(get_handle_t *handle, const char *key, size_t *value_size)
+{
+    int ret;
+    info_t info;
+    inc_get_handle_t *gh;
+
+    if (!handle || !is_valid_key(key)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    _mutex.lock();
+
+    // Authenticate the record once up front and extract the value size
+    ret = do_get(key, 0, 0, 0, 0, &info);
+    if (ret) {
+        goto end;
+    }
+
+    gh = new inc_get_handle_t;
+    gh->key = new char[strlen(key) + 1];
+    strcpy(gh->key, key);
+    gh->data_size = info.size;
+    *handle = reinterpret_cast<get_handle_t>(gh);
+
+    if (value_size) {
+        *value_size = info.size;
+    }
+
+end:
+    _mutex.unlock();
+    return ret;
+}
+
+int SecureStore::get_data(get_handle_t handle, void *buffer, size_t buffer_size,
+                          size_t *actual_size, size_t offset)
+{
+    inc_get_handle_t *gh;
+
+    if (!handle) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    gh = reinterpret_cast<inc_get_handle_t *>(handle);
+
+    _mutex.lock();
+    int ret = do_get(gh->key, buffer, buffer_size, actual_size, offset);
+    _mutex.unlock();
+
+    return ret;
+}
+
+int SecureStore::get_finalize(get_handle_t handle)
+{
+    inc_get_handle_t *gh;
+
+    if (!handle) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    gh = reinterpret_cast<inc_get_handle_t *>(handle);
+    delete[] gh->key;
+    delete gh;
+    return MBED_SUCCESS;
+}
+
 
 int SecureStore::init()
 {
@@ -226,6 +226,59 @@ public:
      */
     virtual int set_finalize(set_handle_t handle);
 
+    /**
+     * @brief Start a chunked KVStore get sequence, given key. Each chunk is
+     *        authenticated and decrypted from the record start, so this doesn't
+     *        save crypto work over get with an offset, but it lets a large value
+     *        be streamed through a small buffer.
+     *
+     * @param[out] handle               Returned get handle.
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[out] value_size           Value data size.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No such key.
+     *          MBED_ERROR_AUTHENTICATION_FAILED    Data authentication failed.
+     *          MBED_ERROR_AUTHENTICATION_RBP_FAILED
+     *                                              Rollback protection data authentication failed.
+     *          or any other error from underlying KVStore instances.
+     */
+    virtual int get_start(get_handle_t *handle, const char *key, size_t *value_size = NULL);
+
+    /**
+     * @brief Read a chunk of value data from a chunked get sequence.
+     *
+     * @param[in]  handle               Get handle.
+     * @param[in]  buffer               Value data buffer.
+     * @param[in]  buffer_size          Value data buffer size.
+     * @param[out] actual_size          Actual read size.
+     * @param[in]  offset               Offset to read from in data.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_SIZE             Invalid size given in function arguments.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No such key.
+     *          MBED_ERROR_AUTHENTICATION_FAILED    Data authentication failed.
+     *          MBED_ERROR_AUTHENTICATION_RBP_FAILED
+     *                                              Rollback protection data authentication failed.
+     *          or any other error from underlying KVStore instances.
+     */
+    virtual int get_data(get_handle_t handle, void *buffer, size_t buffer_size,
+                         size_t *actual_size = NULL, size_t offset = 0);
+
+    /**
+     * @brief Finalize a chunked KVStore get sequence.
+     *
+     * @param[in]  handle               Get handle.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     */
+    virtual int get_finalize(get_handle_t handle);
+
     /**
      * @brief Start an iteration over KVStore keys.
      *        There are no issue with any other operation while iterator is open.
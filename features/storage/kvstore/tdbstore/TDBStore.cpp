@@ -22,16 +22,30 @@
 #include <string.h>
 #include <stdio.h>
 #include "mbed_error.h"
+#include "mbed_progress_checkpoint.h"
 #include "mbed_wait_api.h"
 #include "MbedCRC.h"
 #include "SystemStorage.h"
 
+#ifndef MBED_CONF_STORAGE_TDBSTORE_BACKGROUND_GC
+#define MBED_CONF_STORAGE_TDBSTORE_BACKGROUND_GC 0
+#endif
+
+#ifndef MBED_CONF_STORAGE_TDBSTORE_GC_RECORDS_PER_STEP
+#define MBED_CONF_STORAGE_TDBSTORE_GC_RECORDS_PER_STEP 8
+#endif
+
+#if MBED_CONF_STORAGE_TDBSTORE_BACKGROUND_GC
+#include "events/mbed_events.h"
+#endif
+
 using namespace mbed;
 
 // --------------------------------------------------------- Definitions ----------------------------------------------------------
 
 static const uint32_t delete_flag = (1UL << 31);
-static const uint32_t internal_flags = delete_flag;
+static const uint32_t index_flag = (1UL << 30);
+static const uint32_t internal_flags = delete_flag | index_flag;
 static const uint32_t supported_flags = KVStore::WRITE_ONCE_FLAG;
 
 namespace {
@@ -54,7 +68,38 @@ typedef struct {
 
 static const char *master_rec_key = "TDBS";
 static const uint32_t tdbstore_magic = 0x54686683; // "TDBS" in ASCII
-static const uint32_t tdbstore_revision = 1;
+static const uint32_t tdbstore_revision = 2;
+// First revision supporting the on-flash index checkpoint (and its slot area)
+static const uint32_t index_min_revision = 2;
+
+// on-flash index checkpoint record
+static const char *index_rec_key = "TDBIX";
+static const int index_slot_count = 16;
+static const uint32_t index_checkpoint_period = 32;
+
+typedef struct {
+    uint32_t hash;
+    uint32_t bd_offset;
+} index_entry_t;
+
+// index pointer slot, programmed (append only) after each checkpoint record
+typedef struct {
+    uint32_t checkpoint_offset;
+    uint32_t crc;
+} index_slot_t;
+
+// incremental garbage collection
+typedef enum {
+    TDBSTORE_GC_IDLE          = 0,
+    TDBSTORE_GC_ERASE         = 1,
+    TDBSTORE_GC_COPY          = 2,
+    TDBSTORE_GC_FINALIZE      = 3,
+    TDBSTORE_GC_RESET_STANDBY = 4,
+} gc_state_e;
+
+static const uint32_t gc_not_relocated = 0xFFFFFFFF;
+// Start background garbage collection when the active area is this full (percent)
+static const uint32_t gc_watermark_percent = 75;
 
 typedef struct {
     uint16_t version;
@@ -96,6 +141,15 @@ typedef struct {
     char *prefix;
 } key_iterator_handle_t;
 
+// chunked get handle
+typedef struct {
+    char key[KVStore::MAX_KEY_SIZE];
+    uint32_t bd_offset;
+    uint32_t data_size;
+    uint32_t ram_table_ind;
+    uint32_t hash;
+} inc_get_handle_t;
+
 } // anonymous namespace
 
 
@@ -122,7 +176,10 @@ static uint32_t calc_crc(uint32_t init_crc, uint32_t data_size, const void *data
 TDBStore::TDBStore(BlockDevice *bd) : _ram_table(0), _max_keys(0),
     _num_keys(0), _bd(bd), _buff_bd(0),  _free_space_offset(0), _master_record_offset(0),
     _master_record_size(0), _is_initialized(false), _active_area(0), _active_area_version(0), _size(0),
-    _prog_size(0), _work_buf(0), _key_buf(0), _variant_bd_erase_unit_size(false), _inc_set_handle(0)
+    _prog_size(0), _work_buf(0), _key_buf(0), _variant_bd_erase_unit_size(false), _inc_set_handle(0),
+    _index_slots_offset(0), _records_offset(0), _next_index_slot(0), _sets_since_checkpoint(0),
+    _is_legacy_area(false), _gc_active(false), _gc_state(TDBSTORE_GC_IDLE), _gc_scan_ind(0),
+    _gc_pending(0), _gc_to_offset(0), _gc_new_offsets(0)
 {
 }
 
@@ -614,10 +671,29 @@ int TDBStore::set_finalize(set_handle_t handle)
 
     // Update RAM table
     if (ih->header.flags & delete_flag) {
+        if (_gc_active) {
+            if (_gc_new_offsets[ih->ram_table_ind] != gc_not_relocated) {
+                // Record was already relocated - copy the delete record to the standby
+                // area as well, so a full scan of it won't resurrect the key
+                uint32_t to_next_offset;
+                if (copy_record(_active_area, ih->bd_base_offset, _gc_to_offset,
+                                to_next_offset) == MBED_SUCCESS) {
+                    _gc_to_offset = to_next_offset;
+                } else {
+                    gc_abort();
+                }
+            } else {
+                _gc_pending--;
+            }
+        }
         _num_keys--;
         if (ih->ram_table_ind < _num_keys) {
             memmove(&ram_table[ih->ram_table_ind], &ram_table[ih->ram_table_ind + 1],
                     sizeof(ram_table_entry_t) * (_num_keys - ih->ram_table_ind));
+            if (_gc_active) {
+                memmove(&_gc_new_offsets[ih->ram_table_ind], &_gc_new_offsets[ih->ram_table_ind + 1],
+                        sizeof(uint32_t) * (_num_keys - ih->ram_table_ind));
+            }
         }
         update_all_iterators(false, ih->ram_table_ind);
     } else {
@@ -625,9 +701,21 @@ int TDBStore::set_finalize(set_handle_t handle)
             if (ih->ram_table_ind < _num_keys) {
                 memmove(&ram_table[ih->ram_table_ind + 1], &ram_table[ih->ram_table_ind],
                         sizeof(ram_table_entry_t) * (_num_keys - ih->ram_table_ind));
+                if (_gc_active) {
+                    memmove(&_gc_new_offsets[ih->ram_table_ind + 1], &_gc_new_offsets[ih->ram_table_ind],
+                            sizeof(uint32_t) * (_num_keys - ih->ram_table_ind));
+                }
             }
             _num_keys++;
+            if (_gc_active) {
+                _gc_new_offsets[ih->ram_table_ind] = gc_not_relocated;
+                _gc_pending++;
+            }
             update_all_iterators(true, ih->ram_table_ind);
+        } else if (_gc_active && (_gc_new_offsets[ih->ram_table_ind] != gc_not_relocated)) {
+            // Already relocated record was modified - it needs another copy
+            _gc_new_offsets[ih->ram_table_ind] = gc_not_relocated;
+            _gc_pending++;
         }
         entry = &ram_table[ih->ram_table_ind];
         entry->hash = ih->hash;
@@ -636,6 +724,32 @@ int TDBStore::set_finalize(set_handle_t handle)
 
     _free_space_offset = align_up(ih->bd_curr_offset, _prog_size);
 
+    // Periodically checkpoint the RAM table to flash, so the next init can avoid
+    // a full area scan. Checkpoints stop when the slots run out - the next GC
+    // starts a fresh slot area.
+    _sets_since_checkpoint++;
+    if (!_gc_active && !_is_legacy_area && (_sets_since_checkpoint >= index_checkpoint_period) &&
+            (_next_index_slot < index_slot_count)) {
+        int cp_ret = write_index_checkpoint();
+        if ((cp_ret != MBED_SUCCESS) && (cp_ret != MBED_ERROR_MEDIA_FULL)) {
+            need_gc = true;
+        }
+    }
+
+#if MBED_CONF_STORAGE_TDBSTORE_BACKGROUND_GC
+    // Start relocating records in the background once the area passes the low
+    // watermark, so foreground writes don't absorb a full garbage collection
+    // when space actually runs out
+    if (!_gc_active && !need_gc && (_free_space_offset >= _size / 100 * gc_watermark_percent)) {
+        if (gc_start() == MBED_SUCCESS) {
+            if (!mbed::mbed_event_queue()->call(mbed::callback(this, &TDBStore::gc_event))) {
+                // No room on the event queue - leave it to the synchronous path
+                gc_abort();
+            }
+        }
+    }
+#endif
+
 end:
     if ((need_gc) && (ih->bd_base_offset != _master_record_offset)) {
         garbage_collection();
@@ -712,6 +826,114 @@ end:
     return ret;
 }
 
+int TDBStore::get_start(get_handle_t *handle, const char *key, size_t *value_size)
+{
+    int ret;
+    uint32_t actual_data_size;
+    uint32_t bd_offset, next_bd_offset;
+    uint32_t flags, hash, ram_table_ind;
+    inc_get_handle_t *gh;
+
+    if (!handle || !is_valid_key(key)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    _mutex.lock();
+
+    ret = find_record(_active_area, key, bd_offset, ram_table_ind, hash);
+
+    if (ret != MBED_SUCCESS) {
+        goto end;
+    }
+
+    // Give a large dummy buffer size in order to achieve actual data size
+    // (as copy_data flag is not set, data won't be copied anywhere)
+    ret = read_record(_active_area, bd_offset, const_cast<char *>(key), 0, (uint32_t) -1,
+                      actual_data_size, 0, false, false, false, false, hash, flags,
+                      next_bd_offset);
+
+    if (ret) {
+        goto end;
+    }
+
+    gh = new inc_get_handle_t;
+    strcpy(gh->key, key);
+    gh->bd_offset = bd_offset;
+    gh->data_size = actual_data_size;
+    gh->ram_table_ind = ram_table_ind;
+    gh->hash = hash;
+    *handle = reinterpret_cast<get_handle_t>(gh);
+
+    if (value_size) {
+        *value_size = actual_data_size;
+    }
+
+end:
+    _mutex.unlock();
+    return ret;
+}
+
+int TDBStore::get_data(get_handle_t handle, void *buffer, size_t buffer_size, size_t *actual_size,
+                       size_t offset)
+{
+    int ret = MBED_SUCCESS;
+    uint32_t actual_data_size;
+    uint32_t flags, next_bd_offset;
+    inc_get_handle_t *gh;
+    ram_table_entry_t *entry;
+    bool relocated;
+
+    if (!handle) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    gh = reinterpret_cast<inc_get_handle_t *>(handle);
+
+    _mutex.lock();
+
+    // The record may have moved (garbage collection) or been superseded by a set
+    // since the location was cached, so make sure the RAM table still points to it
+    // before using it, and look the key up again if not
+    relocated = (gh->ram_table_ind >= _num_keys);
+    if (!relocated) {
+        entry = &((ram_table_entry_t *) _ram_table)[gh->ram_table_ind];
+        relocated = (entry->hash != gh->hash) || (entry->bd_offset != gh->bd_offset);
+    }
+
+    if (relocated) {
+        ret = find_record(_active_area, gh->key, gh->bd_offset, gh->ram_table_ind, gh->hash);
+        if (ret != MBED_SUCCESS) {
+            goto end;
+        }
+    }
+
+    ret = read_record(_active_area, gh->bd_offset, gh->key, buffer, buffer_size,
+                      actual_data_size, offset, false, true, false, false, gh->hash, flags,
+                      next_bd_offset);
+
+    if (ret) {
+        goto end;
+    }
+
+    if (actual_size) {
+        *actual_size = actual_data_size;
+    }
+
+end:
+    _mutex.unlock();
+    return ret;
+}
+
+int TDBStore::get_finalize(get_handle_t handle)
+{
+    if (!handle) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    delete reinterpret_cast<inc_get_handle_t *>(handle);
+    return MBED_SUCCESS;
+}
+
 int TDBStore::get_info(const char *key, info_t *info)
 {
     int ret;
@@ -809,6 +1031,8 @@ int TDBStore::copy_record(uint8_t from_area, uint32_t from_offset, uint32_t to_o
         from_offset += chunk_size;
         to_offset += chunk_size;
         total_size -= chunk_size;
+        // One chunk is the unit of work during GC relocation
+        mbed_progress_checkpoint();
     }
 
     to_next_offset = align_up(to_offset, _prog_size);
@@ -817,78 +1041,389 @@ int TDBStore::copy_record(uint8_t from_area, uint32_t from_offset, uint32_t to_o
 
 int TDBStore::garbage_collection()
 {
-    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
-    uint32_t to_offset, to_next_offset;
-    uint32_t chunk_size, reserved_size;
     int ret;
+
+    if (!_gc_active) {
+        ret = gc_start();
+        if (ret) {
+            return ret;
+        }
+    }
+
+    // Drive the incremental cycle to completion synchronously
+    while (_gc_active) {
+        ret = gc_do_step((size_t) -1);
+        if (ret) {
+            return ret;
+        }
+        mbed_progress_checkpoint();
+    }
+
+    return MBED_SUCCESS;
+}
+
+int TDBStore::gc_start()
+{
     size_t ind;
 
-    ret = check_erase_before_write(1 - _active_area, 0, _master_record_offset + _master_record_size);
-    if (ret) {
-        return ret;
+    // All records need relocation. Their new offsets are collected aside and
+    // only applied to the RAM table when switching areas, so reads keep
+    // working from the active area while the cycle is in progress.
+    _gc_new_offsets = new uint32_t[_max_keys];
+    for (ind = 0; ind < _num_keys; ind++) {
+        _gc_new_offsets[ind] = gc_not_relocated;
     }
 
-    ret = do_reserved_data_get(0, RESERVED_AREA_SIZE);
+    _gc_pending = _num_keys;
+    _gc_scan_ind = 0;
+    _gc_to_offset = _records_offset;
+    _gc_state = TDBSTORE_GC_ERASE;
+    _gc_active = true;
 
-    if (!ret) {
-        // Copy reserved data
-        to_offset = 0;
-        reserved_size = _master_record_offset;
+    return MBED_SUCCESS;
+}
+
+int TDBStore::gc_do_step(size_t max_records)
+{
+    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
+    uint32_t to_next_offset, next_offset;
+    uint32_t chunk_size, reserved_size, to_offset;
+    size_t copied;
+    int ret = MBED_SUCCESS;
 
-        while (reserved_size) {
-            chunk_size = std::min(work_buf_size, reserved_size);
-            ret = read_area(_active_area, to_offset, chunk_size, _work_buf);
+    switch (_gc_state) {
+        case TDBSTORE_GC_ERASE:
+            // Erase reserved area, master record and index slot area of the standby area
+            ret = check_erase_before_write(1 - _active_area, 0, _records_offset);
             if (ret) {
-                return ret;
+                goto fail;
+            }
+
+            if (do_reserved_data_get(0, RESERVED_AREA_SIZE) == MBED_SUCCESS) {
+                // Copy reserved data
+                to_offset = 0;
+                reserved_size = _master_record_offset;
+
+                while (reserved_size) {
+                    chunk_size = std::min(work_buf_size, reserved_size);
+                    ret = read_area(_active_area, to_offset, chunk_size, _work_buf);
+                    if (ret) {
+                        goto fail;
+                    }
+                    ret = write_area(1 - _active_area, to_offset, chunk_size, _work_buf);
+                    if (ret) {
+                        goto fail;
+                    }
+                    to_offset += chunk_size;
+                    reserved_size -= chunk_size;
+                }
             }
-            ret = write_area(1 - _active_area, to_offset, chunk_size, _work_buf);
+
+            _gc_state = TDBSTORE_GC_COPY;
+            break;
+
+        case TDBSTORE_GC_COPY:
+            // Copy a bounded number of not yet relocated records to the standby area.
+            // Records modified or added while the cycle is in progress are marked as
+            // not relocated again, so the scan keeps wrapping around until no record
+            // is pending.
+            copied = 0;
+            while (_gc_pending && (copied < max_records)) {
+                if (_gc_scan_ind >= _num_keys) {
+                    _gc_scan_ind = 0;
+                }
+                if (_gc_new_offsets[_gc_scan_ind] == gc_not_relocated) {
+                    ret = copy_record(_active_area, ram_table[_gc_scan_ind].bd_offset,
+                                      _gc_to_offset, to_next_offset);
+                    if (ret) {
+                        goto fail;
+                    }
+                    _gc_new_offsets[_gc_scan_ind] = _gc_to_offset;
+                    _gc_to_offset = to_next_offset;
+                    _gc_pending--;
+                    copied++;
+                }
+                _gc_scan_ind++;
+            }
+
+            if (!_gc_pending) {
+                _gc_state = TDBSTORE_GC_FINALIZE;
+            }
+            break;
+
+        case TDBSTORE_GC_FINALIZE:
+            // Apply the new offsets and switch to the new active area
+            for (size_t ind = 0; ind < _num_keys; ind++) {
+                ram_table[ind].bd_offset = _gc_new_offsets[ind];
+            }
+            delete[] _gc_new_offsets;
+            _gc_new_offsets = 0;
+
+            _free_space_offset = _gc_to_offset;
+            _active_area = 1 - _active_area;
+
+            // Now write master record, with version incremented by 1.
+            _active_area_version++;
+            ret = write_master_record(_active_area, _active_area_version, next_offset);
             if (ret) {
+                _gc_active = false;
+                _gc_state = TDBSTORE_GC_IDLE;
                 return ret;
             }
-            to_offset += chunk_size;
-            reserved_size -= chunk_size;
+
+            // The new area is always written in the current layout, with a fresh index
+            // checkpoint, as all record offsets have just changed
+            _is_legacy_area = false;
+            _next_index_slot = 0;
+            _sets_since_checkpoint = 0;
+            ret = write_index_checkpoint();
+            if ((ret != MBED_SUCCESS) && (ret != MBED_ERROR_MEDIA_FULL)) {
+                _gc_active = false;
+                _gc_state = TDBSTORE_GC_IDLE;
+                return ret;
+            }
+
+            _gc_state = TDBSTORE_GC_RESET_STANDBY;
+            break;
+
+        case TDBSTORE_GC_RESET_STANDBY:
+            // Now reset standby area
+            ret = reset_area(1 - _active_area);
+            _gc_active = false;
+            _gc_state = TDBSTORE_GC_IDLE;
+            return ret;
+
+        default:
+            return MBED_ERROR_INVALID_OPERATION;
+    }
+
+    return MBED_SUCCESS;
+
+fail:
+    // Failed before the area switch - the active area is untouched, so the
+    // cycle can simply be abandoned and retried later
+    gc_abort();
+    return ret;
+}
+
+void TDBStore::gc_abort()
+{
+    delete[] _gc_new_offsets;
+    _gc_new_offsets = 0;
+    _gc_pending = 0;
+    _gc_active = false;
+    _gc_state = TDBSTORE_GC_IDLE;
+}
+
+void TDBStore::gc_event()
+{
+#if MBED_CONF_STORAGE_TDBSTORE_BACKGROUND_GC
+    _mutex.lock();
+
+    if (_is_initialized && _gc_active) {
+        int ret = gc_do_step(MBED_CONF_STORAGE_TDBSTORE_GC_RECORDS_PER_STEP);
+        if ((ret == MBED_SUCCESS) && _gc_active) {
+            // Repost rather than loop, so other events get a chance to run between steps
+            if (!mbed::mbed_event_queue()->call(mbed::callback(this, &TDBStore::gc_event))) {
+                gc_abort();
+            }
         }
     }
 
-    to_offset = _master_record_offset + _master_record_size;
+    _mutex.unlock();
+#endif
+}
+
+
+int TDBStore::write_index_checkpoint()
+{
+    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
+    record_header_t header;
+    index_entry_t *packed = (index_entry_t *) _work_buf;
+    index_slot_t slot;
+    int os_ret, ret;
+    uint32_t base_offset = _free_space_offset;
+    uint32_t data_size = _num_keys * sizeof(index_entry_t);
+    uint32_t rec_size = record_size(index_rec_key, data_size);
+    uint32_t curr_offset, ind, chunk_entries;
+    uint32_t actual_data_size, hash, flags, next_offset;
+
+    if (base_offset + rec_size > _size) {
+        return MBED_ERROR_MEDIA_FULL;
+    }
+
+    ret = check_erase_before_write(_active_area, base_offset, rec_size);
+    if (ret) {
+        return ret;
+    }
 
-    // Initialize in case table is empty
-    to_next_offset = to_offset;
+    header.magic = tdbstore_magic;
+    header.header_size = sizeof(record_header_t);
+    header.revision = tdbstore_revision;
+    header.flags = index_flag;
+    header.key_size = strlen(index_rec_key);
+    header.reserved = 0;
+    header.data_size = data_size;
+    header.crc = calc_crc(initial_crc, sizeof(record_header_t) - sizeof(header.crc), &header);
+    header.crc = calc_crc(header.crc, header.key_size, index_rec_key);
 
-    // Go over ram table and copy all entries to opposite area
-    for (ind = 0; ind < _num_keys; ind++) {
-        uint32_t from_offset = ram_table[ind].bd_offset;
-        ret = copy_record(_active_area, from_offset, to_offset, to_next_offset);
+    // Write key and packed RAM table entries now, header last (as in the set flow)
+    curr_offset = base_offset + align_up(sizeof(record_header_t), _prog_size);
+    ret = write_area(_active_area, curr_offset, header.key_size, index_rec_key);
+    if (ret) {
+        return ret;
+    }
+    curr_offset += header.key_size;
+
+    ind = 0;
+    while (ind < _num_keys) {
+        chunk_entries = std::min((uint32_t)(work_buf_size / sizeof(index_entry_t)), (uint32_t) _num_keys - ind);
+        for (uint32_t i = 0; i < chunk_entries; i++) {
+            packed[i].hash = ram_table[ind + i].hash;
+            packed[i].bd_offset = ram_table[ind + i].bd_offset;
+        }
+        header.crc = calc_crc(header.crc, chunk_entries * sizeof(index_entry_t), packed);
+        ret = write_area(_active_area, curr_offset, chunk_entries * sizeof(index_entry_t), packed);
         if (ret) {
             return ret;
         }
-        // Update RAM table
-        ram_table[ind].bd_offset = to_offset;
-        to_offset = to_next_offset;
+        curr_offset += chunk_entries * sizeof(index_entry_t);
+        ind += chunk_entries;
     }
 
-    to_offset = to_next_offset;
-    _free_space_offset = to_next_offset;
+    ret = write_area(_active_area, base_offset, sizeof(header), &header);
+    if (ret) {
+        return ret;
+    }
 
-    // Now we can switch to the new active area
-    _active_area = 1 - _active_area;
+    os_ret = _buff_bd->sync();
+    if (os_ret) {
+        return MBED_ERROR_WRITE_FAILED;
+    }
 
-    // Now write master record, with version incremented by 1.
-    _active_area_version++;
-    ret = write_master_record(_active_area, _active_area_version, to_offset);
+    // Reread the record to ensure write success (like the set flow does)
+    ret = read_record(_active_area, base_offset, 0, 0, (uint32_t) -1,
+                      actual_data_size, 0, false, false, false, false,
+                      hash, flags, next_offset);
     if (ret) {
         return ret;
     }
 
-    // Now reset standby area
-    ret = reset_area(1 - _active_area);
+    _free_space_offset = next_offset;
+
+    // Point the next free index slot at the checkpoint record
+    slot.checkpoint_offset = base_offset;
+    slot.crc = calc_crc(initial_crc, sizeof(slot.checkpoint_offset), &slot.checkpoint_offset);
+    ret = write_area(_active_area, _index_slots_offset + _next_index_slot * align_up(sizeof(index_slot_t), _prog_size),
+                     sizeof(slot), &slot);
     if (ret) {
         return ret;
     }
 
+    os_ret = _buff_bd->sync();
+    if (os_ret) {
+        return MBED_ERROR_WRITE_FAILED;
+    }
+
+    _next_index_slot++;
+    _sets_since_checkpoint = 0;
+
     return MBED_SUCCESS;
 }
 
+int TDBStore::load_index_checkpoint(uint32_t &offset)
+{
+    index_slot_t slot;
+    // Entries can't be paged through _work_buf, as read_record uses it as scratch
+    index_entry_t packed[work_buf_size / sizeof(index_entry_t)];
+    ram_table_entry_t *ram_table;
+    int ret;
+    uint8_t erase_val = (uint8_t) _bd->get_erase_value();
+    uint32_t slot_size = align_up(sizeof(index_slot_t), _prog_size);
+    uint32_t checkpoint_offset = 0;
+    uint32_t num_entries, data_offset, ind, chunk_entries;
+    uint32_t actual_data_size, hash, flags, next_offset;
+    bool found = false;
+
+    _next_index_slot = 0;
+
+    // Take the last valid slot - checkpoints are appended in slot order
+    for (int i = 0; i < index_slot_count; i++) {
+        ret = read_area(_active_area, _index_slots_offset + i * slot_size, sizeof(slot), &slot);
+        if (ret) {
+            return ret;
+        }
+
+        bool erased = true;
+        for (size_t j = 0; j < sizeof(slot); j++) {
+            erased &= (((uint8_t *) &slot)[j] == erase_val);
+        }
+        if (erased) {
+            break;
+        }
+
+        _next_index_slot = i + 1;
+        if ((slot.crc == calc_crc(initial_crc, sizeof(slot.checkpoint_offset), &slot.checkpoint_offset)) &&
+                (slot.checkpoint_offset >= _records_offset) && (slot.checkpoint_offset < _size)) {
+            checkpoint_offset = slot.checkpoint_offset;
+            found = true;
+        }
+    }
+
+    if (!found) {
+        return MBED_ERROR_ITEM_NOT_FOUND;
+    }
+
+    // Validate the whole checkpoint record (CRC covers header, key and all entries)
+    ret = read_record(_active_area, checkpoint_offset, _key_buf, 0, (uint32_t) -1,
+                      actual_data_size, 0, true, false, false, false,
+                      hash, flags, next_offset);
+    if (ret) {
+        return ret;
+    }
+
+    if (!(flags & index_flag) || strcmp(_key_buf, index_rec_key) ||
+            (actual_data_size % sizeof(index_entry_t))) {
+        return MBED_ERROR_INVALID_DATA_DETECTED;
+    }
+
+    // Scanning resumes right after the checkpoint record
+    uint32_t after_checkpoint = next_offset;
+
+    num_entries = actual_data_size / sizeof(index_entry_t);
+    if (num_entries > _max_keys) {
+        ram_table = new ram_table_entry_t[num_entries];
+        delete[](ram_table_entry_t *) _ram_table;
+        _ram_table = ram_table;
+        _max_keys = num_entries;
+    } else {
+        ram_table = (ram_table_entry_t *) _ram_table;
+    }
+
+    // Page the entries in through the work buffer
+    ind = 0;
+    data_offset = 0;
+    while (ind < num_entries) {
+        chunk_entries = std::min((uint32_t)(work_buf_size / sizeof(index_entry_t)), num_entries - ind);
+        ret = read_record(_active_area, checkpoint_offset, 0, packed, chunk_entries * sizeof(index_entry_t),
+                          actual_data_size, data_offset, false, true, false, false,
+                          hash, flags, next_offset);
+        if (ret) {
+            return ret;
+        }
+        for (uint32_t i = 0; i < chunk_entries; i++) {
+            ram_table[ind + i].hash = packed[i].hash;
+            ram_table[ind + i].bd_offset = packed[i].bd_offset;
+        }
+        ind += chunk_entries;
+        data_offset += chunk_entries * sizeof(index_entry_t);
+    }
+
+    _num_keys = num_entries;
+    offset = after_checkpoint;
+
+    return MBED_SUCCESS;
+}
 
 int TDBStore::build_ram_table()
 {
@@ -903,6 +1438,18 @@ int TDBStore::build_ram_table()
     _num_keys = 0;
     offset = _master_record_offset;
 
+    if (!_is_legacy_area) {
+        // Resume from the last index checkpoint if there is a valid one, so only
+        // records written after it need to be scanned. On any failure fall back
+        // to a full scan.
+        if (load_index_checkpoint(offset) != MBED_SUCCESS) {
+            _num_keys = 0;
+            offset = _master_record_offset;
+        }
+        // Table may have been reallocated while loading the checkpoint
+        ram_table = (ram_table_entry_t *) _ram_table;
+    }
+
     while (offset < _free_space_offset) {
         ret = read_record(_active_area, offset, _key_buf, 0, 0, actual_data_size, 0,
                           true, false, false, true, hash, flags, next_offset);
@@ -911,15 +1458,25 @@ int TDBStore::build_ram_table()
             goto end;
         }
 
+        uint32_t save_offset = offset;
+        offset = next_offset;
+
+        if (!_is_legacy_area && (offset < _records_offset)) {
+            // Jump over the index slot area, which follows the master record
+            offset = _records_offset;
+        }
+
+        if (flags & index_flag) {
+            // Index checkpoint records are not keys
+            continue;
+        }
+
         ret = find_record(_active_area, _key_buf, dummy, ram_table_ind, hash);
 
         if ((ret != MBED_SUCCESS) && (ret != MBED_ERROR_ITEM_NOT_FOUND)) {
             goto end;
         }
 
-        uint32_t save_offset = offset;
-        offset = next_offset;
-
         if (ret == MBED_ERROR_ITEM_NOT_FOUND) {
             // Key doesn't exist, need to add it to RAM table
             ret = MBED_SUCCESS;
@@ -962,6 +1519,15 @@ int TDBStore::increment_max_keys(void **ram_table)
 
     // Copy old content to new table
     memcpy(new_ram_table, old_ram_table, sizeof(ram_table_entry_t) * _max_keys);
+
+    // New offsets table (if garbage collection is in progress) must match in size
+    if (_gc_active) {
+        uint32_t *new_offsets = new uint32_t[_max_keys + 1];
+        memcpy(new_offsets, _gc_new_offsets, sizeof(uint32_t) * _max_keys);
+        delete[] _gc_new_offsets;
+        _gc_new_offsets = new_offsets;
+    }
+
     _max_keys++;
 
     _ram_table = new_ram_table;
@@ -983,6 +1549,7 @@ int TDBStore::init()
     uint32_t actual_data_size;
     int os_ret, ret = MBED_SUCCESS, reserved_ret;
     uint16_t versions[_num_areas];
+    uint16_t tdb_revs[_num_areas];
 
     _mutex.lock();
 
@@ -1023,11 +1590,19 @@ int TDBStore::init()
     _master_record_offset = align_up(RESERVED_AREA_SIZE + sizeof(reserved_trailer_t), _prog_size);
     _master_record_size = record_size(master_rec_key, sizeof(master_record_data_t));
 
+    // Index slot area follows the master record, records follow the slot area
+    // (in pre-index revisions, records immediately follow the master record)
+    _index_slots_offset = _master_record_offset + _master_record_size;
+    _records_offset = _index_slots_offset + index_slot_count * align_up(sizeof(index_slot_t), _prog_size);
+    _next_index_slot = 0;
+    _sets_since_checkpoint = 0;
+
     calc_area_params();
 
     for (uint8_t area = 0; area < _num_areas; area++) {
         area_state[area] = TDBSTORE_AREA_STATE_NONE;
         versions[area] = 0;
+        tdb_revs[area] = 0;
 
         _size = std::min(_size, _area_params[area].size);
 
@@ -1040,10 +1615,10 @@ int TDBStore::init()
             MBED_ERROR(ret, "TDBSTORE: Unable to read record at init");
         }
 
-        // Master record may be either corrupt or erased - either way erase it
-        // (this will do nothing if already erased)
+        // Master record may be either corrupt or erased - either way erase it,
+        // along with the index slot area (this will do nothing if already erased)
         if (ret == MBED_ERROR_INVALID_DATA_DETECTED) {
-            if (check_erase_before_write(area, _master_record_offset, _master_record_size, true)) {
+            if (check_erase_before_write(area, _master_record_offset, _records_offset - _master_record_offset, true)) {
                 MBED_ERROR(MBED_ERROR_READ_FAILED, "TDBSTORE: Unable reset area at init");
             }
             area_state[area] = TDBSTORE_AREA_STATE_EMPTY;
@@ -1051,6 +1626,7 @@ int TDBStore::init()
         }
 
         versions[area] = master_rec.version;
+        tdb_revs[area] = master_rec.tdbstore_revision;
 
         area_state[area] = TDBSTORE_AREA_STATE_VALID;
 
@@ -1064,10 +1640,13 @@ int TDBStore::init()
     if ((area_state[0] == TDBSTORE_AREA_STATE_EMPTY) && (area_state[1] == TDBSTORE_AREA_STATE_EMPTY)) {
         _active_area = 0;
         _active_area_version = 1;
+        _is_legacy_area = false;
         ret = write_master_record(_active_area, _active_area_version, _free_space_offset);
         if (ret) {
             MBED_ERROR(ret, "TDBSTORE: Unable to write master record at init");
         }
+        // Records start after the (erased) index slot area
+        _free_space_offset = _records_offset;
         // Nothing more to do here if active area is empty
         goto end;
     }
@@ -1087,6 +1666,11 @@ int TDBStore::init()
         }
     }
 
+    // An active area written by a pre-index revision has its records immediately
+    // after the master record, with no index slot area. It is read as is, and
+    // converted to the current layout on the next garbage collection.
+    _is_legacy_area = (tdb_revs[_active_area] < index_min_revision);
+
     // Currently set free space offset pointer to the end of free space.
     // Ram table build process needs it, but will update it.
     _free_space_offset = _size;
@@ -1133,6 +1717,9 @@ int TDBStore::deinit()
 {
     _mutex.lock();
     if (_is_initialized) {
+        if (_gc_active) {
+            gc_abort();
+        }
         _buff_bd->deinit();
         delete _buff_bd;
 
@@ -1150,8 +1737,8 @@ int TDBStore::deinit()
 
 int TDBStore::reset_area(uint8_t area)
 {
-    // Erase reserved area and master record
-    return check_erase_before_write(area, 0, _master_record_offset + _master_record_size, true);
+    // Erase reserved area, master record and index slot area
+    return check_erase_before_write(area, 0, _records_offset, true);
 }
 
 int TDBStore::reset()
@@ -1165,6 +1752,10 @@ int TDBStore::reset()
 
     _mutex.lock();
 
+    if (_gc_active) {
+        gc_abort();
+    }
+
     // Reset both areas
     for (area = 0; area < _num_areas; area++) {
         ret = reset_area(area);
@@ -1180,6 +1771,15 @@ int TDBStore::reset()
 
     // Write an initial master record on active area
     ret = write_master_record(_active_area, _active_area_version, _free_space_offset);
+    if (ret) {
+        goto end;
+    }
+
+    // Records start after the (erased) index slot area
+    _free_space_offset = _records_offset;
+    _is_legacy_area = false;
+    _next_index_slot = 0;
+    _sets_since_checkpoint = 0;
 
 end:
     _mutex.unlock();
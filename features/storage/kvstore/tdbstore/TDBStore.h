@@ -203,6 +203,55 @@ public:
      */
     virtual int set_finalize(set_handle_t handle);
 
+    /**
+     * @brief Start a chunked TDBStore get sequence, given key. The record is located
+     *        once and its location cached in the handle, so subsequent get_data calls
+     *        don't repeat the key lookup. There are no issues with any other
+     *        operations while a get handle is open.
+     *
+     * @param[out] handle               Returned get handle.
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[out] value_size           Value data size.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_READ_FAILED              Unable to read from media.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_DATA_DETECTED    Data is corrupt.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No such key.
+     */
+    virtual int get_start(get_handle_t *handle, const char *key, size_t *value_size = NULL);
+
+    /**
+     * @brief Read a chunk of value data from a chunked get sequence.
+     *
+     * @param[in]  handle               Get handle.
+     * @param[in]  buffer               Value data buffer.
+     * @param[in]  buffer_size          Value data buffer size.
+     * @param[out] actual_size          Actual read size.
+     * @param[in]  offset               Offset to read from in data.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_READ_FAILED              Unable to read from media.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_SIZE             Invalid size given in function arguments.
+     *          MBED_ERROR_INVALID_DATA_DETECTED    Data is corrupt.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No such key.
+     */
+    virtual int get_data(get_handle_t handle, void *buffer, size_t buffer_size,
+                         size_t *actual_size = NULL, size_t offset = 0);
+
+    /**
+     * @brief Finalize a chunked TDBStore get sequence.
+     *
+     * @param[in]  handle               Get handle.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     */
+    virtual int get_finalize(get_handle_t handle);
+
     /**
      * @brief Start an iteration over KVStore keys.
      *        There are no issues with any other operations while iterator is open.
@@ -312,6 +361,17 @@ private:
     bool _variant_bd_erase_unit_size;
     void *_inc_set_handle;
     void *_iterator_table[_max_open_iterators];
+    uint32_t _index_slots_offset;
+    uint32_t _records_offset;
+    int _next_index_slot;
+    uint32_t _sets_since_checkpoint;
+    bool _is_legacy_area;
+    bool _gc_active;
+    int _gc_state;
+    size_t _gc_scan_ind;
+    size_t _gc_pending;
+    uint32_t _gc_to_offset;
+    uint32_t *_gc_new_offsets;
 
     /**
      * @brief Read a block from an area.
@@ -413,11 +473,42 @@ private:
 
     /**
      * @brief Garbage collection (compact all records from active area to the standby one).
+     *        Runs an incremental garbage collection cycle to completion, starting one
+     *        if none is in progress.
      *
      * @returns 0 for success, nonzero for failure.
      */
     int garbage_collection();
 
+    /**
+     * @brief Start an incremental garbage collection cycle.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int gc_start();
+
+    /**
+     * @brief Perform a bounded amount of garbage collection work.
+     *        Must be called repeatedly (until the cycle completes) once a cycle
+     *        has been started.
+     *
+     * @param[in]  max_records            Maximum number of records to relocate in this step.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int gc_do_step(size_t max_records);
+
+    /**
+     * @brief Abandon an incremental garbage collection cycle (allowed before the
+     *        area switch only, as the active area is untouched until then).
+     */
+    void gc_abort();
+
+    /**
+     * @brief Event queue callback, performing one background garbage collection step.
+     */
+    void gc_event();
+
     /**
      * @brief Return record size given key and data size.
      *
@@ -476,6 +567,23 @@ private:
      */
     int build_ram_table();
 
+    /**
+     * @brief Write an index checkpoint record, holding the current RAM table,
+     *        and point a free index slot at it.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int write_index_checkpoint();
+
+    /**
+     * @brief Restore the RAM table from the latest valid index checkpoint.
+     *
+     * @param[out] offset                First offset not covered by the checkpoint.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int load_index_checkpoint(uint32_t &offset);
+
     /**
      * @brief Increment maximum number of keys and reallocate RAM table accordingly.
      *
@@ -121,6 +121,12 @@ void LowPowerTickerWrapper::free()
 
 uint32_t LowPowerTickerWrapper::read()
 {
+    // Passthrough when suspended - no pending match to check so the
+    // critical section can be skipped on this wakeup-path call
+    if (_suspended) {
+        return _intf->read();
+    }
+
     core_util_critical_section_enter();
 
     timestamp_t current = _intf->read();
@@ -180,13 +186,9 @@ void LowPowerTickerWrapper::fire_interrupt()
 
 const ticker_info_t *LowPowerTickerWrapper::get_info()
 {
-
-    core_util_critical_section_enter();
-
-    const ticker_info_t *info = _intf->get_info();
-
-    core_util_critical_section_exit();
-    return info;
+    // Cached by _reset() - the hardware info is constant, so neither the
+    // interface call nor a critical section is needed here
+    return _info;
 }
 
 void LowPowerTickerWrapper::_reset()
@@ -202,15 +204,15 @@ void LowPowerTickerWrapper::_reset()
     _last_set_interrupt = 0;
     _last_actual_set_interrupt = 0;
 
-    const ticker_info_t *info = _intf->get_info();
-    if (info->bits >= 32) {
+    _info = _intf->get_info();
+    if (_info->bits >= 32) {
         _mask = 0xffffffff;
     } else {
-        _mask = ((uint64_t)1 << info->bits) - 1;
+        _mask = ((uint64_t)1 << _info->bits) - 1;
     }
 
     // Round us_per_tick up
-    _us_per_tick = (1000000 + info->frequency - 1) / info->frequency;
+    _us_per_tick = (1000000 + _info->frequency - 1) / _info->frequency;
 }
 
 void LowPowerTickerWrapper::_timeout_handler()
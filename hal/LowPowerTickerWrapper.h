@@ -197,6 +197,11 @@ private:
      */
     uint32_t _mask;
 
+    /*
+     * Hardware info cached by _reset() so get_info needs no interface call
+     */
+    const ticker_info_t *_info;
+
     /*
      * Microsecond per low power tick (rounded up)
      */
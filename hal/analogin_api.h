@@ -21,6 +21,7 @@
 #define MBED_ANALOGIN_API_H
 
 #include "device.h"
+#include "hal/pinmap.h"
 
 #if DEVICE_ANALOGIN
 
@@ -45,6 +46,16 @@ typedef struct analogin_s analogin_t;
  */
 void analogin_init(analogin_t *obj, PinName pin);
 
+/** Initialize the analogin peripheral from an explicit pinmap
+ *
+ * Same as analogin_init, but the peripheral and pin function come from the
+ * caller instead of a pinmap table scan. The default implementation falls
+ * back to analogin_init; targets override it to configure the pin directly.
+ * @param obj    The analogin object to initialize
+ * @param pinmap Explicit pinmap, see get_analogin_pinmap in hal/static_pinmap.h
+ */
+void analogin_init_direct(analogin_t *obj, const PinMap *pinmap);
+
 /** Read the input voltage, represented as a float in the range [0.0, 1.0]
  *
  * @param obj The analogin object
@@ -0,0 +1,89 @@
+
+/** \addtogroup hal */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_ANALOGIN_BURST_API_H
+#define MBED_ANALOGIN_BURST_API_H
+
+#include "device.h"
+#include "hal/analogin_api.h"
+
+#if DEVICE_ANALOGIN_BURST
+
+typedef void (*analogin_burst_handler)(uint32_t id);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_analogin_burst Burst Analogin hardware abstraction layer
+ *
+ * The burst analogin HAL captures a fixed number of samples into a
+ * caller-supplied buffer using a hardware timer as conversion trigger and
+ * DMA to move results out of the ADC, so the sample spacing is exact and
+ * no CPU cycles are spent per sample. The handler is invoked from
+ * interrupt context once when the whole buffer has been filled.
+ * @{
+ */
+
+/** Start a timer-triggered, DMA-backed burst capture.
+ *
+ *  Conversions are triggered by hardware at the requested rate and the
+ *  results written to the buffer as 16-bit normalized samples, in the
+ *  same format analogin_read_u16() returns. The handler is called once,
+ *  from interrupt context, after the final sample has been stored.
+ *
+ *  The implementation may round the sample rate to the nearest rate the
+ *  trigger timer can produce.
+ *
+ * @param obj            The analogin object
+ * @param buffer         Destination for the captured samples
+ * @param length         Number of samples to capture
+ * @param sample_rate_hz Requested trigger rate in hertz
+ * @param handler        Handler invoked when the capture completes
+ * @param id             The id passed back to the handler (typically the driver object)
+ */
+void analogin_burst_start(analogin_t *obj, uint16_t *buffer, size_t length, uint32_t sample_rate_hz, analogin_burst_handler handler, uint32_t id);
+
+/** Abort the on-going burst capture, releasing the trigger timer and DMA channel.
+ *
+ *  Samples already stored remain valid; the completion handler is not called.
+ *
+ * @param obj The analogin object
+ */
+void analogin_burst_abort(analogin_t *obj);
+
+/** Attempt to determine if a burst capture is in progress
+ *
+ * @param obj The analogin object
+ * @return Non-zero if a capture is on-going, 0 otherwise
+ */
+uint8_t analogin_burst_active(analogin_t *obj);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/** @}*/
@@ -0,0 +1,148 @@
+
+/** \addtogroup hal */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_AUDIOIN_API_H
+#define MBED_AUDIOIN_API_H
+
+#include "device.h"
+
+#if DEVICE_AUDIOIN
+
+/**
+ * \defgroup AudioInEvents AudioIn Events Macros
+ *
+ * Events reported by the audioin_handler. FRAME_COMPLETE is raised each
+ * time the capture passes a frame boundary of the circular buffer;
+ * ERROR is raised when the peripheral reports a fault (DMA error, frame
+ * sync loss) and the capture has stopped.
+ * @{
+ */
+#define AUDIOIN_EVENT_FRAME_COMPLETE (1 << 0)
+#define AUDIOIN_EVENT_ERROR          (1 << 1)
+/**@}*/
+
+typedef void (*audioin_handler)(uint32_t id, uint32_t event);
+
+/** Audio input HAL structure. audioin_s is declared in the target's hal
+ */
+typedef struct audioin_s audioin_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_audioin AudioIn hardware abstraction layer
+ *
+ * The audioin HAL captures audio from an I2S, SAI or PDM interface
+ * entirely in hardware: the receiver clocks samples in and DMA moves
+ * them through a caller-supplied circular buffer divided into fixed-size
+ * frames. The handler is invoked from interrupt context once per frame
+ * boundary, never per sample, so capture runs at essentially zero CPU
+ * cost. On PDM interfaces the implementation is responsible for
+ * decimating the bitstream to PCM (in a hardware filter where the
+ * peripheral has one) so the buffer always contains 16-bit signed PCM.
+ * @{
+ */
+
+/** Initialize the audioin peripheral for the given pins
+ *
+ *  Passing NC as wclk selects a PDM interface (clock and data only);
+ *  otherwise the pins are the I2S/SAI bit clock, word clock and data
+ *  lines.
+ *
+ * @param obj  The audioin object to initialize
+ * @param data The data (SD/PDM data) pin
+ * @param bclk The bit clock (SCK/PDM clock) pin
+ * @param wclk The word select pin, or NC for PDM
+ */
+void audioin_init(audioin_t *obj, PinName data, PinName bclk, PinName wclk);
+
+/** Release the audioin peripheral
+ *
+ * @param obj The audioin object
+ */
+void audioin_free(audioin_t *obj);
+
+/** Configure the capture format
+ *
+ *  The implementation may round the sample rate to the nearest rate the
+ *  peripheral clock tree can produce; the rate actually configured is
+ *  returned. Channels are interleaved in the capture buffer.
+ *
+ * @param obj            The audioin object
+ * @param sample_rate_hz Requested sample rate in hertz
+ * @param channels       Number of channels (1 or 2)
+ * @return The actual sample rate configured, or 0 if the format is unsupported
+ */
+uint32_t audioin_format(audioin_t *obj, uint32_t sample_rate_hz, uint8_t channels);
+
+/** Start a circular DMA capture into the given buffer
+ *
+ *  The buffer holds frame_count frames of frame_samples 16-bit samples
+ *  each and is filled by hardware in order, wrapping at the end. The
+ *  transfer runs until audioin_stop() is called. The handler is called
+ *  from interrupt context with AUDIOIN_EVENT_FRAME_COMPLETE after each
+ *  frame boundary; the frame just completed is reported by
+ *  audioin_frame_index(). Implementations use double-buffered or
+ *  circular DMA so capture continues while completed frames are
+ *  consumed.
+ *
+ * @param obj           The audioin object
+ * @param buffer        The capture buffer, filled by hardware
+ * @param frame_samples Number of samples in one frame
+ * @param frame_count   Number of frames in the buffer (at least 2)
+ * @param handler       The handler invoked on frame and error events
+ * @param id            The id passed back to the handler (typically the driver object)
+ */
+void audioin_start(audioin_t *obj, int16_t *buffer, size_t frame_samples, size_t frame_count, audioin_handler handler, uint32_t id);
+
+/** Report the index of the frame most recently completed by hardware
+ *
+ * @param obj The audioin object
+ * @return Frame index in the range [0, frame_count)
+ */
+size_t audioin_frame_index(audioin_t *obj);
+
+/** Stop the capture and release the DMA channel
+ *
+ *  Frames already stored remain valid; the handler is not called again.
+ *
+ * @param obj The audioin object
+ */
+void audioin_stop(audioin_t *obj);
+
+/** Attempt to determine if a capture is in progress
+ *
+ * @param obj The audioin object
+ * @return Non-zero if a capture is on-going, 0 otherwise
+ */
+uint8_t audioin_active(audioin_t *obj);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/** @}*/
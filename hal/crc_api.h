@@ -234,6 +234,29 @@ void hal_crc_compute_partial(const uint8_t *data, const size_t size);
  */
 uint32_t hal_crc_get_result(void);
 
+#if DEVICE_CRC_DMA
+
+/** Writes data to the current CRC module using a DMA transfer.
+ *
+ * Equivalent to hal_crc_compute_partial(), but the data is fed into the
+ * CRC data register by a DMA channel instead of the CPU. The function
+ * must not return until the whole buffer has been consumed - the caller
+ * may reuse or free the buffer on return - but the implementation is free
+ * to sleep or yield the CPU while the transfer is in progress.
+ *
+ * The same configuration, chaining and thread-safety rules apply as for
+ * hal_crc_compute_partial(); the two feed functions may be freely mixed
+ * within one calculation.
+ *
+ * Only available on targets with DEVICE_CRC_DMA support.
+ *
+ * \param data Input data stream to be written into the CRC calculation
+ * \param size Size of the data stream in bytes
+ */
+void hal_crc_compute_partial_dma(const uint8_t *data, const size_t size);
+
+#endif // DEVICE_CRC_DMA
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -0,0 +1,99 @@
+
+/** \addtogroup hal */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_DMA_MEMCPY_API_H
+#define MBED_DMA_MEMCPY_API_H
+
+#include "device.h"
+#include "hal/dma_api.h"
+
+#if DEVICE_DMA_MEMCPY
+
+typedef void (*dma_memcpy_handler)(uint32_t id);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_dma_memcpy DMA memcpy hardware abstraction layer
+ *
+ * The DMA memcpy HAL moves memory-to-memory blocks on an otherwise idle
+ * DMA channel so large copies cost no CPU cycles. The implementation
+ * only ever borrows channels that no driver has allocated; when every
+ * channel is busy it reports DMA_ERROR_OUT_OF_CHANNELS and the caller
+ * performs the copy in software, so the service is strictly
+ * opportunistic and can never delay peripheral transfers.
+ *
+ * Cache maintenance is the caller's responsibility: the platform layer
+ * hands buffers to the controller clean and invalidates the destination
+ * after completion using the mbed_dma_buf helpers, so implementations
+ * work on raw addresses only.
+ * @{
+ */
+
+/** Start a memory-to-memory DMA transfer on an idle channel
+ *
+ *  The handler, when not NULL, is called once from interrupt context
+ *  after the last byte has been written. With a NULL handler the caller
+ *  polls dma_memcpy_active() for completion.
+ *
+ * @param dst     Destination address
+ * @param src     Source address
+ * @param len     Number of bytes to copy
+ * @param handler Handler invoked on completion, or NULL to poll
+ * @param id      The id passed back to the handler
+ * @return The channel id used, or DMA_ERROR_OUT_OF_CHANNELS if no idle
+ *         channel is available
+ */
+int dma_memcpy_start(void *dst, const void *src, size_t len, dma_memcpy_handler handler, uint32_t id);
+
+/** Start a memory-fill DMA transfer on an idle channel
+ *
+ *  Fills len bytes at dst with the given byte value. Completion
+ *  semantics match dma_memcpy_start().
+ *
+ * @param dst     Destination address
+ * @param value   Byte value to store
+ * @param len     Number of bytes to fill
+ * @param handler Handler invoked on completion, or NULL to poll
+ * @param id      The id passed back to the handler
+ * @return The channel id used, or DMA_ERROR_OUT_OF_CHANNELS if no idle
+ *         channel is available
+ */
+int dma_memset_start(void *dst, uint8_t value, size_t len, dma_memcpy_handler handler, uint32_t id);
+
+/** Attempt to determine if a transfer is still running on a channel
+ *
+ * @param channelid A channel id returned by dma_memcpy_start or dma_memset_start
+ * @return Non-zero if the transfer is on-going, 0 once it has completed
+ */
+uint8_t dma_memcpy_active(int channelid);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/** @}*/
@@ -0,0 +1,107 @@
+
+/** \addtogroup hal */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_DMA_SERIAL_API_H
+#define MBED_DMA_SERIAL_API_H
+
+#include "device.h"
+#include "hal/serial_api.h"
+
+#if DEVICE_SERIAL_RX_DMA
+
+/**
+ * \defgroup DMASerialRXEvents DMA Serial RX Events Macros
+ *
+ * Events reported by the dma_serial_rx_handler. IDLE is raised when the
+ * receive line goes idle with data pending in the DMA buffer,
+ * HALF_COMPLETE and COMPLETE when the circular DMA transfer passes the
+ * half-way point and wraps respectively. OVERRUN is raised if the
+ * hardware overwrote data that has not been claimed yet.
+ * @{
+ */
+#define DMA_SERIAL_EVENT_RX_IDLE          (1 << 0)
+#define DMA_SERIAL_EVENT_RX_HALF_COMPLETE (1 << 1)
+#define DMA_SERIAL_EVENT_RX_COMPLETE      (1 << 2)
+#define DMA_SERIAL_EVENT_RX_OVERRUN       (1 << 3)
+/**@}*/
+
+typedef void (*dma_serial_rx_handler)(uint32_t id, uint32_t event);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_DMASerial DMA Serial Hardware Abstraction Layer
+ *
+ * The DMA serial HAL lets a driver hand the peripheral a circular receive
+ * buffer that is filled entirely in hardware. Instead of one interrupt
+ * per received byte, the handler is invoked only on idle-line detection
+ * and on half/full completion of the circular transfer, and the driver
+ * drains the buffer up to the index reported by
+ * dma_serial_rx_get_index().
+ * @{
+ */
+
+/** Start a circular DMA receive transfer into the given buffer.
+ *
+ *  The transfer runs until dma_serial_rx_abort() is called; on reaching
+ *  the end of the buffer the DMA controller wraps to the start. The
+ *  handler is called from interrupt context with one or more
+ *  DMA_SERIAL_EVENT_RX flags.
+ *
+ * @param obj     The serial object
+ * @param buffer  The receive buffer, filled by hardware
+ * @param length  The length of the receive buffer in bytes
+ * @param handler The handler invoked on idle-line/half/full events
+ * @param id      The id passed back to the handler (typically the driver object)
+ */
+void dma_serial_rx_init(serial_t *obj, uint8_t *buffer, size_t length, dma_serial_rx_handler handler, uint32_t id);
+
+/** Report the current hardware write position within the receive buffer.
+ *
+ *  Data between the driver's last read position and this index has been
+ *  received and may be consumed. The index wraps at the buffer length.
+ *
+ * @param obj The serial object
+ * @return Offset in bytes of the next location the DMA controller will write
+ */
+size_t dma_serial_rx_get_index(serial_t *obj);
+
+/** Abort the circular DMA receive transfer and release the DMA channel.
+ *
+ *  After this call the peripheral reverts to interrupt-per-byte
+ *  reception and the buffer passed to dma_serial_rx_init() is no longer
+ *  written by hardware.
+ *
+ * @param obj The serial object
+ */
+void dma_serial_rx_abort(serial_t *obj);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/** @}*/
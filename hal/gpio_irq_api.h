@@ -85,6 +85,38 @@ void gpio_irq_enable(gpio_irq_t *obj);
  */
 void gpio_irq_disable(gpio_irq_t *obj);
 
+/** Read the timestamp of the most recent edge on this IRQ pin in microseconds
+ *
+ * The default implementation reads the microsecond ticker, so it carries the
+ * interrupt latency between the edge and the handler and is meant to be
+ * called first thing in the handler. Targets that can route the pin to a
+ * timer capture channel override it (it is defined weak) to return the
+ * hardware-latched capture value converted to microseconds, which removes
+ * the latency jitter entirely.
+ *
+ * @param obj The GPIO object
+ * @return Timestamp of the most recent edge, in microseconds
+ */
+uint32_t gpio_irq_get_capture_us(gpio_irq_t *obj);
+
+/** Read the pin level latched when the pending interrupts were demultiplexed
+ *
+ * Targets that share one interrupt vector across several pins and
+ * dispatch all asserted pins in a single pass latch every configured
+ * pin's input at the start of that pass; handlers on the same vector
+ * then all observe the same multi-pin state no matter how late in the
+ * pass they run, which a live gpio_read cannot guarantee. Meant to be
+ * called from the handler.
+ *
+ * The default implementation returns -1 (it is defined weak); targets
+ * with a batching demux override it.
+ *
+ * @param obj The GPIO object
+ * @return The latched level of the pin (0 or 1), or -1 if the target
+ *         does not latch demux-time state
+ */
+int gpio_irq_get_latched(gpio_irq_t *obj);
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -22,6 +22,7 @@
 
 #include "device.h"
 #include "hal/buffer.h"
+#include "hal/pinmap.h"
 
 #if DEVICE_I2C_ASYNCH
 #include "hal/dma_api.h"
@@ -81,6 +82,18 @@ extern "C" {
  */
 void i2c_init(i2c_t *obj, PinName sda, PinName scl);
 
+/** Initialize the I2C peripheral from an explicit pinmap
+ *
+ *  Same as i2c_init, but the peripheral and pin functions come from the
+ *  caller instead of a pinmap table scan. The default implementation falls
+ *  back to i2c_init; targets override it to configure the peripheral
+ *  directly.
+ *
+ *  @param obj    The I2C object
+ *  @param pinmap Explicit pinmap, see get_i2c_pinmap in hal/static_pinmap.h
+ */
+void i2c_init_direct(i2c_t *obj, const i2c_pinmap_t *pinmap);
+
 /** Configure the I2C frequency
  *
  *  @param obj The I2C object
@@ -146,6 +159,35 @@ int i2c_byte_read(i2c_t *obj, int last);
  */
 int i2c_byte_write(i2c_t *obj, int data);
 
+/** Peripheral-level bus statistics, see i2c_get_stats
+ */
+typedef struct {
+    uint32_t arbitration_lost_count; /**< Transfers lost to another master */
+    uint64_t stretch_time_usec;      /**< Accumulated slave clock stretching in microseconds */
+} i2c_hal_stats_t;
+
+/** Read peripheral-level bus statistics
+ *
+ * Arbitration loss and slave clock stretching are only visible to the
+ * peripheral, so they are counted by the target HAL. The default
+ * implementation returns -1 (it is defined weak); targets whose
+ * peripheral flags these conditions override it and accumulate the
+ * counters from their interrupt handlers.
+ *
+ * @param obj   The I2C object
+ * @param stats Filled with the accumulated statistics
+ * @return 0 if the statistics were filled, -1 if the target does not track them
+ */
+int i2c_get_stats(i2c_t *obj, i2c_hal_stats_t *stats);
+
+/** Reset the counters read by i2c_get_stats
+ *
+ * The default implementation is empty (it is defined weak).
+ *
+ * @param obj The I2C object
+ */
+void i2c_clear_stats(i2c_t *obj);
+
 /**@}*/
 
 #if DEVICE_I2CSLAVE
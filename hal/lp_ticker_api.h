@@ -47,6 +47,16 @@ extern "C" {
  * # Potential bugs
  * * Glitches due to ripple counter - Verified by ::lp_ticker_glitch_test
  *
+ * # Slow write protection
+ * Targets whose low power ticker hardware needs time to latch a compare
+ * value declare this with the target configuration value
+ * lpticker_delay_ticks, which defines LPTICKER_DELAY_TICKS. When it is
+ * greater than zero every access goes through LowPowerTickerWrapper, which
+ * spaces out compare writes and backs early matches with the microsecond
+ * ticker. When it is zero or undefined the wrapper is not built and
+ * get_lp_ticker_data() hands out the hardware interface directly, so clean
+ * hardware pays no indirection on the wakeup path.
+ *
  * @see hal_lp_ticker_tests
  *
  * @{
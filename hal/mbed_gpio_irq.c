@@ -0,0 +1,42 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/gpio_irq_api.h"
+
+#if DEVICE_INTERRUPTIN
+
+#include "hal/ticker_api.h"
+#include "hal/us_ticker_api.h"
+#include "platform/mbed_toolchain.h"
+
+/* Software fallback for targets without timer capture on the IRQ pin: a
+ * microsecond ticker read, as close to the edge as a call from the handler
+ * prologue can get */
+MBED_WEAK uint32_t gpio_irq_get_capture_us(gpio_irq_t *obj)
+{
+    (void)obj;
+    return ticker_read(get_us_ticker_data());
+}
+
+/* Targets whose demux latches pin state at interrupt entry override this */
+MBED_WEAK int gpio_irq_get_latched(gpio_irq_t *obj)
+{
+    (void)obj;
+    return -1;
+}
+
+#endif
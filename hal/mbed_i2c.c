@@ -0,0 +1,39 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/i2c_api.h"
+
+#if DEVICE_I2C
+
+#include "platform/mbed_toolchain.h"
+
+/* Targets whose I2C peripheral flags arbitration loss and clock
+ * stretching override these and accumulate the counters from their
+ * interrupt handlers */
+MBED_WEAK int i2c_get_stats(i2c_t *obj, i2c_hal_stats_t *stats)
+{
+    (void)obj;
+    (void)stats;
+    return -1;
+}
+
+MBED_WEAK void i2c_clear_stats(i2c_t *obj)
+{
+    (void)obj;
+}
+
+#endif
@@ -0,0 +1,61 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Default implementations of the explicit-pinmap init functions. Targets
+ * that have not been ported fall back to the pin-based init, which scans
+ * the pinmap tables as before; ported targets override these to use the
+ * peripheral and functions carried in the pinmap struct directly.
+ */
+
+#include "platform/mbed_toolchain.h"
+#include "device.h"
+
+#if DEVICE_SPI
+#include "hal/spi_api.h"
+
+MBED_WEAK void spi_init_direct(spi_t *obj, const spi_pinmap_t *pinmap)
+{
+    spi_init(obj, pinmap->mosi_pin, pinmap->miso_pin, pinmap->sclk_pin, pinmap->ssel_pin);
+}
+#endif
+
+#if DEVICE_I2C
+#include "hal/i2c_api.h"
+
+MBED_WEAK void i2c_init_direct(i2c_t *obj, const i2c_pinmap_t *pinmap)
+{
+    i2c_init(obj, pinmap->sda_pin, pinmap->scl_pin);
+}
+#endif
+
+#if DEVICE_ANALOGIN
+#include "hal/analogin_api.h"
+
+MBED_WEAK void analogin_init_direct(analogin_t *obj, const PinMap *pinmap)
+{
+    analogin_init(obj, pinmap->pin);
+}
+#endif
+
+#if DEVICE_SERIAL
+#include "hal/serial_api.h"
+
+MBED_WEAK void serial_init_direct(serial_t *obj, const serial_pinmap_t *pinmap)
+{
+    serial_init(obj, pinmap->tx_pin, pinmap->rx_pin);
+}
+#endif
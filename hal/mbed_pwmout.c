@@ -0,0 +1,44 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/pwmout_api.h"
+
+#if DEVICE_PWMOUT
+
+#include "platform/mbed_toolchain.h"
+
+/* Targets with sequence-capable PWM hardware (timer DMA-burst, PWM
+ * sequencer) override these; elsewhere the driver steps the table in
+ * software */
+MBED_WEAK int pwmout_sequence_start(pwmout_t *obj, const float *table, uint32_t count, uint32_t element_us, uint32_t loop, pwmout_sequence_handler handler, uint32_t id)
+{
+    (void)obj;
+    (void)table;
+    (void)count;
+    (void)element_us;
+    (void)loop;
+    (void)handler;
+    (void)id;
+    return -1;
+}
+
+MBED_WEAK void pwmout_sequence_stop(pwmout_t *obj)
+{
+    (void)obj;
+}
+
+#endif
@@ -25,9 +25,14 @@
 #include "lp_ticker_api.h"
 #include <limits.h>
 #include <stdio.h>
+#include <string.h>
 #include "platform/mbed_stats.h"
 #include "platform/mbed_interface.h"
 
+#ifdef MBED_SLEEP_STATS_ENABLED
+#include "cmsis.h"
+#endif
+
 #if DEVICE_SLEEP
 
 // deep sleep locking counter. A target is allowed to deep sleep if counter == 0
@@ -79,10 +84,17 @@ us_timestamp_t mbed_time_deepsleep(void)
 typedef struct sleep_statistic {
     const char *identifier;
     uint8_t count;
+    us_timestamp_t time_blocked;
+    us_timestamp_t lock_start;
 } sleep_statistic_t;
 
 static sleep_statistic_t sleep_stats[STATISTIC_COUNT];
 
+static inline us_timestamp_t sleep_tracker_read_us(void)
+{
+    return ticker_read_us(get_us_ticker_data());
+}
+
 static sleep_statistic_t *sleep_tracker_find(const char *const filename)
 {
     for (int i = 0; i < STATISTIC_COUNT; ++i) {
@@ -121,8 +133,8 @@ static void sleep_tracker_print_stats(void)
             return;
         }
 
-        mbed_error_printf("[id: %s, count: %u]\r\n", sleep_stats[i].identifier,
-                          sleep_stats[i].count);
+        mbed_error_printf("[id: %s, count: %u, blocked_ms: %u]\r\n", sleep_stats[i].identifier,
+                          sleep_stats[i].count, (unsigned int)(sleep_stats[i].time_blocked / 1000));
     }
 }
 
@@ -135,7 +147,11 @@ void sleep_tracker_lock(const char *const filename, int line)
         stat = sleep_tracker_add(filename);
     }
 
-    core_util_atomic_incr_u8(&stat->count, 1);
+    core_util_critical_section_enter();
+    if (stat->count++ == 0) {
+        stat->lock_start = sleep_tracker_read_us();
+    }
+    core_util_critical_section_exit();
 
     mbed_error_printf("LOCK: %s, ln: %i, lock count: %u\r\n", filename, line, deep_sleep_lock);
 }
@@ -150,11 +166,40 @@ void sleep_tracker_unlock(const char *const filename, int line)
         return;
     }
 
-    core_util_atomic_decr_u8(&stat->count, 1);
+    core_util_critical_section_enter();
+    if (--stat->count == 0) {
+        stat->time_blocked += sleep_tracker_read_us() - stat->lock_start;
+    }
+    core_util_critical_section_exit();
 
     mbed_error_printf("UNLOCK: %s, ln: %i, lock count: %u\r\n", filename, line, deep_sleep_lock);
 }
 
+size_t sleep_manager_get_blockers(sleep_manager_blocker_t *blockers, size_t count)
+{
+    MBED_ASSERT(blockers != NULL);
+    size_t filled = 0;
+
+    core_util_critical_section_enter();
+    us_timestamp_t now = sleep_tracker_read_us();
+    for (int i = 0; (i < STATISTIC_COUNT) && (filled < count); ++i) {
+        if (sleep_stats[i].identifier == NULL) {
+            continue;
+        }
+        blockers[filled].identifier = sleep_stats[i].identifier;
+        blockers[filled].count = sleep_stats[i].count;
+        blockers[filled].time_blocked = sleep_stats[i].time_blocked;
+        // Charge the in-progress hold so a stuck lock shows up immediately
+        if (sleep_stats[i].count > 0) {
+            blockers[filled].time_blocked += now - sleep_stats[i].lock_start;
+        }
+        filled++;
+    }
+    core_util_critical_section_exit();
+
+    return filled;
+}
+
 #endif // MBED_SLEEP_TRACING_ENABLED
 
 void sleep_manager_lock_deep_sleep_internal(void)
@@ -184,6 +229,52 @@ bool sleep_manager_can_deep_sleep(void)
     return deep_sleep_lock == 0 ? true : false;
 }
 
+#ifdef MBED_SLEEP_STATS_ENABLED
+
+static mbed_stats_sleep_t sleep_stats;
+
+static void sleep_stats_record(bool deep, us_timestamp_t start, us_timestamp_t end)
+{
+    // Interrupts are still masked here, so the interrupt that ended the
+    // sleep has not run yet and reads back as the pending vector
+    uint32_t pending = (SCB->ICSR & SCB_ICSR_VECTPENDING_Msk) >> SCB_ICSR_VECTPENDING_Pos;
+
+    sleep_stats.wake_count++;
+    sleep_stats.last_wake_time = end;
+    sleep_stats.last_wake_exception = pending ? (int16_t)pending : -1;
+
+    if (pending == 0) {
+        sleep_stats.untracked_wake_count++;
+    } else {
+        int slot;
+        for (slot = 0; slot < MBED_WAKE_SOURCES_MAX; slot++) {
+            if (sleep_stats.sources[slot].count == 0) {
+                sleep_stats.sources[slot].exception = (int16_t)pending;
+            }
+            if (sleep_stats.sources[slot].exception == (int16_t)pending) {
+                sleep_stats.sources[slot].count++;
+                break;
+            }
+        }
+        if (slot == MBED_WAKE_SOURCES_MAX) {
+            sleep_stats.untracked_wake_count++;
+        }
+    }
+
+    us_timestamp_t duration = end - start;
+    int bucket = 0;
+    while ((duration >>= 1) && (bucket < MBED_STATS_SLEEP_HIST_BUCKETS - 1)) {
+        bucket++;
+    }
+    if (deep) {
+        sleep_stats.deep_sleep_hist[bucket]++;
+    } else {
+        sleep_stats.sleep_hist[bucket]++;
+    }
+}
+
+#endif // MBED_SLEEP_STATS_ENABLED
+
 bool sleep_manager_can_deep_sleep_test_check()
 {
     const uint32_t check_time_us = 2000;
@@ -224,6 +315,9 @@ void sleep_manager_sleep_auto(void)
     } else {
         sleep_time += end - start;
     }
+#ifdef MBED_SLEEP_STATS_ENABLED
+    sleep_stats_record(deep, start, end);
+#endif
     core_util_critical_section_exit();
 }
 
@@ -249,3 +343,15 @@ bool sleep_manager_can_deep_sleep(void)
 }
 
 #endif
+
+void mbed_stats_sleep_get(mbed_stats_sleep_t *stats)
+{
+    MBED_ASSERT(stats != NULL);
+#if DEVICE_SLEEP && defined(MBED_SLEEP_STATS_ENABLED)
+    core_util_critical_section_enter();
+    memcpy(stats, &sleep_stats, sizeof(mbed_stats_sleep_t));
+    core_util_critical_section_exit();
+#else
+    memset(stats, 0, sizeof(mbed_stats_sleep_t));
+#endif
+}
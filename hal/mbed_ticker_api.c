@@ -63,6 +63,7 @@ static void initialize(const ticker_data_t *ticker)
     uint64_t max_delta_us =
         ((uint64_t)max_delta * 1000000 + frequency - 1) / frequency;
 
+    ticker->queue->seq++;
     ticker->queue->event_handler = NULL;
     ticker->queue->head = NULL;
     ticker->queue->tick_last_read = ticker->interface->read();
@@ -76,6 +77,7 @@ static void initialize(const ticker_data_t *ticker)
     ticker->queue->dispatching = false;
     ticker->queue->suspended = false;
     ticker->queue->initialized = true;
+    ticker->queue->seq++;
 
     update_present_time(ticker);
     schedule_interrupt(ticker);
@@ -121,23 +123,13 @@ static us_timestamp_t convert_timestamp(us_timestamp_t ref, timestamp_t timestam
 }
 
 /**
- * Update the present timestamp value of a ticker.
+ * Convert elapsed ticks to elapsed microseconds, carrying the sub-microsecond
+ * remainder. Shared between the state-updating path and the lock-free read,
+ * so both assemble exactly the same time from the same snapshot.
  */
-static void update_present_time(const ticker_data_t *const ticker)
+static uint64_t elapsed_ticks_to_us(const ticker_event_queue_t *queue, uint64_t elapsed_ticks,
+                                    uint64_t remainder_in, uint64_t *remainder_out)
 {
-    ticker_event_queue_t *queue = ticker->queue;
-    if (queue->suspended) {
-        return;
-    }
-    uint32_t ticker_time = ticker->interface->read();
-    if (ticker_time == ticker->queue->tick_last_read) {
-        // No work to do
-        return;
-    }
-
-    uint64_t elapsed_ticks = (ticker_time - queue->tick_last_read) & queue->bitmask;
-    queue->tick_last_read = ticker_time;
-
     uint64_t elapsed_us;
     if (1000000 == queue->frequency) {
         // Optimized for 1MHz
@@ -149,10 +141,10 @@ static void update_present_time(const ticker_data_t *const ticker)
         elapsed_us = us_x_ticks >> queue->frequency_shifts;
 
         // Update remainder
-        queue->tick_remainder += us_x_ticks - (elapsed_us << queue->frequency_shifts);
-        if (queue->tick_remainder >= queue->frequency) {
+        remainder_in += us_x_ticks - (elapsed_us << queue->frequency_shifts);
+        if (remainder_in >= queue->frequency) {
             elapsed_us += 1;
-            queue->tick_remainder -= queue->frequency;
+            remainder_in -= queue->frequency;
         }
     } else {
         // General case
@@ -161,15 +153,46 @@ static void update_present_time(const ticker_data_t *const ticker)
         elapsed_us = us_x_ticks / queue->frequency;
 
         // Update remainder
-        queue->tick_remainder += us_x_ticks - elapsed_us * queue->frequency;
-        if (queue->tick_remainder >= queue->frequency) {
+        remainder_in += us_x_ticks - elapsed_us * queue->frequency;
+        if (remainder_in >= queue->frequency) {
             elapsed_us += 1;
-            queue->tick_remainder -= queue->frequency;
+            remainder_in -= queue->frequency;
         }
     }
 
-    // Update current time
-    queue->present_time += elapsed_us;
+    if (remainder_out) {
+        *remainder_out = remainder_in;
+    }
+    return elapsed_us;
+}
+
+/**
+ * Update the present timestamp value of a ticker.
+ *
+ * Mutations of the time state are bracketed by increments of queue->seq for
+ * the benefit of the lock-free read in ticker_read_us(); all callers run
+ * with interrupts masked, so an update can never be observed half-done for
+ * longer than a retry.
+ */
+static void update_present_time(const ticker_data_t *const ticker)
+{
+    ticker_event_queue_t *queue = ticker->queue;
+    if (queue->suspended) {
+        return;
+    }
+    uint32_t ticker_time = ticker->interface->read();
+    if (ticker_time == ticker->queue->tick_last_read) {
+        // No work to do
+        return;
+    }
+
+    uint64_t elapsed_ticks = (ticker_time - queue->tick_last_read) & queue->bitmask;
+
+    queue->seq++;
+    queue->tick_last_read = ticker_time;
+    queue->present_time += elapsed_ticks_to_us(queue, elapsed_ticks,
+                                               queue->tick_remainder, &queue->tick_remainder);
+    queue->seq++;
 }
 
 /**
@@ -297,27 +320,27 @@ void ticker_irq_handler(const ticker_data_t *const ticker)
 
     /* Go through all the pending TimerEvents */
     ticker->queue->dispatching = true;
-    while (1) {
-        if (ticker->queue->head == NULL) {
-            break;
+    update_present_time(ticker);
+    while (ticker->queue->head != NULL) {
+        if (ticker->queue->head->timestamp > ticker->queue->present_time) {
+            /* Not due by the cached time - refresh it once and re-check, so
+             * draining a batch of due events costs a single counter read
+             * rather than one per event */
+            update_present_time(ticker);
+            if (ticker->queue->head->timestamp > ticker->queue->present_time) {
+                break;
+            }
         }
 
-        // update the current timestamp used by the queue
-        update_present_time(ticker);
-
-        if (ticker->queue->head->timestamp <= ticker->queue->present_time) {
-            // This event was in the past:
-            //      point to the following one and execute its handler
-            ticker_event_t *p = ticker->queue->head;
-            ticker->queue->head = ticker->queue->head->next;
-            if (ticker->queue->event_handler != NULL) {
-                (*ticker->queue->event_handler)(p->id); // NOTE: the handler can set new events
-            }
-            /* Note: We continue back to examining the head because calling the
-             * event handler may have altered the chain of pending events. */
-        } else {
-            break;
+        // This event was in the past:
+        //      point to the following one and execute its handler
+        ticker_event_t *p = ticker->queue->head;
+        ticker->queue->head = ticker->queue->head->next;
+        if (ticker->queue->event_handler != NULL) {
+            (*ticker->queue->event_handler)(p->id); // NOTE: the handler can set new events
         }
+        /* Note: We continue back to examining the head because calling the
+         * event handler may have altered the chain of pending events. */
     }
     ticker->queue->dispatching = false;
 
@@ -420,6 +443,40 @@ us_timestamp_t ticker_read_us(const ticker_data_t *const ticker)
 
     initialize(ticker);
 
+    /* Lock-free fast path: assemble the 64-bit time from a seqlock-style
+     * snapshot of the queue's time state plus a fresh counter read, using
+     * the same conversion as update_present_time() so both paths return
+     * identical values. Writers bump queue->seq around every update and
+     * run with interrupts masked, so an even, unchanged seq brackets a
+     * consistent snapshot. Retries are bounded in case we preempted an
+     * updater that cannot make progress (e.g. first-time init). */
+    const volatile ticker_event_queue_t *queue = ticker->queue;
+    for (int retry = 0; retry < 4; retry++) {
+        uint32_t seq = queue->seq;
+        if (seq & 1) {
+            continue;
+        }
+        us_timestamp_t present_time = queue->present_time;
+        uint32_t tick_last_read = queue->tick_last_read;
+        uint64_t tick_remainder = queue->tick_remainder;
+        bool suspended = queue->suspended;
+        if (queue->seq != seq) {
+            // The snapshot may be torn - retry
+            continue;
+        }
+        if (suspended) {
+            // Time is frozen while suspended
+            return present_time;
+        }
+        uint32_t ticker_time = ticker->interface->read();
+        if (queue->seq != seq) {
+            continue;
+        }
+        uint64_t elapsed_ticks = (ticker_time - tick_last_read) & ticker->queue->bitmask;
+        return present_time + elapsed_ticks_to_us(ticker->queue, elapsed_ticks,
+                                                  tick_remainder, NULL);
+    }
+
     core_util_critical_section_enter();
     update_present_time(ticker);
     ret = ticker->queue->present_time;
@@ -447,7 +504,16 @@ void ticker_suspend(const ticker_data_t *const ticker)
 {
     core_util_critical_section_enter();
 
+    // Bring present_time up to date so reads while suspended return the
+    // time of the suspend call - the lock-free read path does not advance
+    // present_time on behalf of the queue.
+    if (ticker->queue->initialized) {
+        update_present_time(ticker);
+    }
+
+    ticker->queue->seq++;
     ticker->queue->suspended = true;
+    ticker->queue->seq++;
 
     core_util_critical_section_exit();
 }
@@ -456,13 +522,16 @@ void ticker_resume(const ticker_data_t *const ticker)
 {
     core_util_critical_section_enter();
 
+    ticker->queue->seq++;
     ticker->queue->suspended = false;
     if (ticker->queue->initialized) {
         ticker->queue->tick_last_read = ticker->interface->read();
+        ticker->queue->seq++;
 
         update_present_time(ticker);
         schedule_interrupt(ticker);
     } else {
+        ticker->queue->seq++;
         initialize(ticker);
     }
 
@@ -234,4 +234,47 @@ void mbed_mpu_enable_ram_xn(bool enable)
     __ISB();
 }
 
+#if MBED_MPU_STACK_GUARD_SIZE == 256
+#define STACK_GUARD_RASR_SIZE        ARM_MPU_REGION_SIZE_256B
+#else
+#define STACK_GUARD_RASR_SIZE        ARM_MPU_REGION_SIZE_32B
+#endif
+
+void mbed_mpu_set_stack_guard(uint32_t stack_base)
+{
+    // Use the highest implemented region - on ARMv7-M the highest region
+    // number takes priority, so the guard overrides the RAM mappings above
+    const uint32_t region = ((MPU->TYPE & MPU_TYPE_DREGION_Msk) >> MPU_TYPE_DREGION_Pos) - 1;
+
+    // Flush memory writes before configuring the MPU.
+    __DMB();
+
+    if (stack_base == 0) {
+        enable_region(false, region);
+    } else {
+        // The region base must be aligned to the region size, so guard the
+        // lowest aligned block inside the stack
+        const uint32_t base = (stack_base + MBED_MPU_STACK_GUARD_SIZE - 1) & ~(MBED_MPU_STACK_GUARD_SIZE - 1);
+        ARM_MPU_SetRegion(
+            ARM_MPU_RBAR(
+                region,                     // Region
+                base),                      // Base
+            ARM_MPU_RASR(
+                1,                          // DisableExec
+                ARM_MPU_AP_PRO,             // AccessPermission - read-only, so stack pushes
+                                            // fault while the RTX magic-word check can still read
+                0,                          // TypeExtField
+                0,                          // IsShareable
+                1,                          // IsCacheable
+                0,                          // IsBufferable
+                0U,                         // SubRegionDisable
+                STACK_GUARD_RASR_SIZE)      // Size
+        );
+    }
+
+    // Ensure changes take effect
+    __DSB();
+    __ISB();
+}
+
 #endif
@@ -208,4 +208,39 @@ void mbed_mpu_enable_ram_xn(bool enable)
     __ISB();
 }
 
+void mbed_mpu_set_stack_guard(uint32_t stack_base)
+{
+    // Use the highest implemented region. ARMv8-M faults any access that
+    // matches more than one enabled region, so overlapping the RAM mappings
+    // above is what makes the guard trip.
+    const uint32_t region = ((MPU->TYPE & MPU_TYPE_DREGION_Msk) >> MPU_TYPE_DREGION_Pos) - 1;
+
+    // Flush memory writes before configuring the MPU.
+    __DMB();
+
+    if (stack_base == 0) {
+        enable_region(false, region);
+    } else {
+        // Regions have a 32 byte granularity, so guard the lowest aligned
+        // block inside the stack
+        const uint32_t base = (stack_base + MBED_MPU_STACK_GUARD_SIZE - 1) & ~(uint32_t)(MBED_MPU_STACK_GUARD_SIZE - 1);
+        ARM_MPU_SetRegion(
+            region,                     // Region
+            ARM_MPU_RBAR(
+                base,                   // Base
+                ARM_MPU_SH_NON,         // Non-shareable
+                1,                      // Read-Only
+                0,                      // Privileged
+                1),                     // Execute Never enabled
+            ARM_MPU_RLAR(
+                base + MBED_MPU_STACK_GUARD_SIZE - 1,   // Limit
+                0)                      // Attribute index 0 - Write-Through, Read-allocate (set up by mbed_mpu_init)
+        );
+    }
+
+    // Ensure changes take effect
+    __DSB();
+    __ISB();
+}
+
 #endif
@@ -21,6 +21,7 @@
 
 #include "device.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -93,6 +94,32 @@ void mbed_mpu_enable_rom_wn(bool enable);
  */
 void mbed_mpu_enable_ram_xn(bool enable);
 
+/**
+ * Size in bytes of the stack guard region programmed by ::mbed_mpu_set_stack_guard.
+ *
+ * The ARMv6-M MPU cannot map regions smaller than 256 bytes; all other
+ * architectures use the minimum 32 byte region.
+ */
+#if defined(__ARM_ARCH_6M__) && (__ARM_ARCH_6M__ == 1U)
+#define MBED_MPU_STACK_GUARD_SIZE    256
+#else
+#define MBED_MPU_STACK_GUARD_SIZE    32
+#endif
+
+/**
+ * Place a guard region at the bottom of a thread stack
+ *
+ * Program an MPU region over the lowest MBED_MPU_STACK_GUARD_SIZE bytes of
+ * the stack so that growing past it raises a precise fault instead of
+ * silently corrupting adjacent memory. The region disallows writes, so stack
+ * pushes into it fault even in privileged mode. Only one guard is active at
+ * a time - the scheduler moves it to the incoming thread's stack on context
+ * switch.
+ *
+ * @param stack_base lowest address of the stack to guard, or 0 to disable the guard
+ */
+void mbed_mpu_set_stack_guard(uint32_t stack_base);
+
 /** Deinitialize the MPU
  *
  * Powerdown the MPU in preparation for powerdown, reset or jumping to another application.
@@ -109,6 +136,8 @@ void mbed_mpu_free(void);
 
 #define mbed_mpu_enable_ram_xn(enable) (void)enable
 
+#define mbed_mpu_set_stack_guard(stack_base) (void)stack_base
+
 #define mbed_mpu_free()
 
 #endif
@@ -21,6 +21,7 @@
 #define MBED_PINMAP_H
 
 #include "PinNames.h"
+#include "platform/mbed_toolchain.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -32,6 +33,63 @@ typedef struct {
     int function;
 } PinMap;
 
+/** Place a peripheral pinmap or init table in its own linkable section
+ *
+ *  Tables marked this way can be discarded individually by linker
+ *  unused-section elimination, even in builds without -fdata-sections:
+ *  linking a driver pulls in only the tables its init functions
+ *  reference, not every table the translation unit happens to define.
+ *  Targets that split their tables per peripheral instance extend the
+ *  same effect to whole instances - a fragment referenced only by an
+ *  unused instance is dropped together with it.
+ *
+ *  The section name stays inside the .rodata namespace so existing
+ *  linker scripts place it without changes:
+ *
+ *  @code
+ *  static const PinMap PinMap_UART_TX[] MBED_PERIPHERAL_TABLE("uart_tx") = {
+ *      {USBTX, UART_0, 0},
+ *      {NC, NC, 0}
+ *  };
+ *  @endcode
+ */
+#define MBED_PERIPHERAL_TABLE(name) MBED_SECTION(".rodata.mbed_peripheral_table." name)
+
+/** Explicit SPI pinmap, carries the peripheral and pin functions that
+ *  spi_init would otherwise resolve by scanning the pinmap tables
+ */
+typedef struct {
+    int peripheral;
+    PinName mosi_pin;
+    int mosi_function;
+    PinName miso_pin;
+    int miso_function;
+    PinName sclk_pin;
+    int sclk_function;
+    PinName ssel_pin;
+    int ssel_function;
+} spi_pinmap_t;
+
+/** Explicit I2C pinmap, see spi_pinmap_t
+ */
+typedef struct {
+    int peripheral;
+    PinName sda_pin;
+    int sda_function;
+    PinName scl_pin;
+    int scl_function;
+} i2c_pinmap_t;
+
+/** Explicit serial pinmap, see spi_pinmap_t
+ */
+typedef struct {
+    int peripheral;
+    PinName tx_pin;
+    int tx_function;
+    PinName rx_pin;
+    int rx_function;
+} serial_pinmap_t;
+
 void pin_function(PinName pin, int function);
 void pin_mode(PinName pin, PinMode mode);
 
@@ -108,6 +108,40 @@ void pwmout_pulsewidth_ms(pwmout_t *obj, int ms);
  */
 void pwmout_pulsewidth_us(pwmout_t *obj, int us);
 
+typedef void (*pwmout_sequence_handler)(uint32_t id);
+
+/** Stream a table of duty cycles through the output autonomously
+ *
+ * The hardware steps to the next table entry every element_us microseconds
+ * without CPU involvement - timer DMA-burst into the compare register,
+ * a PWM sequencer, or whatever the target peripheral offers. The table
+ * must stay valid until the sequence completes or is stopped; the target
+ * may read it directly or stage a converted copy at start.
+ *
+ * The default implementation returns -1 (it is defined weak); targets
+ * with sequence-capable PWM hardware override it. Callers fall back to
+ * stepping the duty cycle in software when streaming is unavailable.
+ *
+ * @param obj        The pwmout object
+ * @param table      Table of duty cycles in range <0.0f, 1.0f>
+ * @param count      Number of entries in the table
+ * @param element_us Microseconds each entry holds the output
+ * @param loop       Non-zero to restart from the first entry after the last
+ * @param handler    Called from interrupt context when a non-looping
+ *                   sequence completes (may be NULL)
+ * @param id         Passed through to the handler
+ * @return 0 if the sequence was started, -1 if the target cannot stream
+ */
+int pwmout_sequence_start(pwmout_t *obj, const float *table, uint32_t count, uint32_t element_us, uint32_t loop, pwmout_sequence_handler handler, uint32_t id);
+
+/** Stop a running duty-cycle sequence, leaving the last written duty active
+ *
+ * The default implementation is empty (it is defined weak).
+ *
+ * @param obj The pwmout object
+ */
+void pwmout_sequence_stop(pwmout_t *obj);
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -182,6 +182,38 @@ qspi_status_t qspi_command_transfer(qspi_t *obj, const qspi_command_t *command,
  */
 qspi_status_t qspi_read(qspi_t *obj, const qspi_command_t *command, void *data, size_t *length);
 
+#if DEVICE_QSPI_MMAP
+
+/** Enter memory-mapped read mode
+ *
+ * The controller is placed in a mode where the external flash contents are
+ * readable directly through the AHB address space, using the given command
+ * as the read frame format (the command's address phase value is ignored -
+ * the bus address supplies it). While mapped, no command transactions may
+ * be issued on this object until qspi_mmap_disable() is called.
+ *
+ * Only available on targets with DEVICE_QSPI_MMAP support.
+ *
+ * @param obj QSPI object
+ * @param command QSPI read command describing the frame format
+ * @param[out] base Start of the mapped window in the address space
+ * @param[out] size Length of the mapped window in bytes
+ * @return QSPI_STATUS_OK if the mapping is active
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_mmap_enable(qspi_t *obj, const qspi_command_t *command, const void **base, size_t *size);
+
+/** Leave memory-mapped read mode, re-enabling command transactions
+ *
+ * @param obj QSPI object
+ * @return QSPI_STATUS_OK if the mapping was torn down
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_mmap_disable(qspi_t *obj);
+
+#endif // DEVICE_QSPI_MMAP
+
 /**@}*/
 
 #ifdef __cplusplus
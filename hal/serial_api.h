@@ -23,6 +23,7 @@
 #include "device.h"
 #include "hal/buffer.h"
 #include "hal/dma_api.h"
+#include "hal/pinmap.h"
 
 #if DEVICE_SERIAL
 
@@ -119,6 +120,18 @@ extern "C" {
  */
 void serial_init(serial_t *obj, PinName tx, PinName rx);
 
+/** Initialize the serial peripheral from an explicit pinmap
+ *
+ *  Same as serial_init, but the peripheral and pin functions come from the
+ *  caller instead of a pinmap table scan. The default implementation falls
+ *  back to serial_init; targets override it to configure the peripheral
+ *  directly.
+ *
+ * @param obj    The serial object
+ * @param pinmap Explicit pinmap, see get_uart_pinmap in hal/static_pinmap.h
+ */
+void serial_init_direct(serial_t *obj, const serial_pinmap_t *pinmap);
+
 /** Release the serial peripheral, not currently invoked. It requires further
  *  resource management.
  *
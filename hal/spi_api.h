@@ -23,6 +23,7 @@
 #include "device.h"
 #include "hal/dma_api.h"
 #include "hal/buffer.h"
+#include "hal/pinmap.h"
 
 #if DEVICE_SPI
 
@@ -72,6 +73,18 @@ extern "C" {
  */
 void spi_init(spi_t *obj, PinName mosi, PinName miso, PinName sclk, PinName ssel);
 
+/** Initialize the SPI peripheral from an explicit pinmap
+ *
+ * Same as spi_init, but the peripheral and pin functions come from the
+ * caller instead of a pinmap table scan. The default implementation falls
+ * back to spi_init; targets override it to configure the peripheral
+ * directly so that pinmaps resolved at compile time skip the scan and let
+ * the linker drop unused tables.
+ * @param[out] obj    The SPI object to initialize
+ * @param[in]  pinmap Explicit pinmap, see get_spi_pinmap in hal/static_pinmap.h
+ */
+void spi_init_direct(spi_t *obj, const spi_pinmap_t *pinmap);
+
 /** Release a SPI object
  *
  * TODO: spi_free is currently unimplemented
@@ -0,0 +1,178 @@
+
+/** \addtogroup hal */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_STATIC_PINMAP_H
+#define MBED_STATIC_PINMAP_H
+
+#include "device.h"
+#include "hal/pinmap.h"
+#include "PeripheralPins.h"
+
+#ifdef __cplusplus
+
+/* The get_*_pinmap helpers below resolve a set of pins to an explicit pinmap
+ * using the same table walk that the pin-based HAL inits perform at runtime.
+ * On targets that declare their pinmap tables constexpr and define
+ * STATIC_PINMAP_READY, the helpers are constexpr too, so a pinmap built from
+ * compile-time pin names is evaluated entirely by the compiler: no scan runs
+ * on the device and the linker can drop the tables. On other targets the same
+ * code runs at init time, which is no worse than the pin-based path.
+ *
+ * Unlike pinmap_peripheral/pinmap_function, lookup failures here cannot raise
+ * a runtime error (constexpr functions cannot), so a pin missing from its
+ * table or a peripheral mismatch yields NC/NC entries; the fallback in the
+ * *_init_direct implementation then reports the error exactly as the
+ * pin-based init would.
+ */
+#if STATIC_PINMAP_READY && __cplusplus >= 201402L
+#define MBED_STATIC_PINMAP_CONSTEXPR constexpr
+#else
+#define MBED_STATIC_PINMAP_CONSTEXPR inline
+#endif
+
+MBED_STATIC_PINMAP_CONSTEXPR int pinmap_static_peripheral(PinName pin, const PinMap *map)
+{
+    if (pin == NC) {
+        return NC;
+    }
+    while (map->pin != NC) {
+        if (map->pin == pin) {
+            return map->peripheral;
+        }
+        map++;
+    }
+    return NC;
+}
+
+MBED_STATIC_PINMAP_CONSTEXPR int pinmap_static_function(PinName pin, const PinMap *map)
+{
+    if (pin == NC) {
+        return NC;
+    }
+    while (map->pin != NC) {
+        if (map->pin == pin) {
+            return map->function;
+        }
+        map++;
+    }
+    return NC;
+}
+
+MBED_STATIC_PINMAP_CONSTEXPR int pinmap_static_merge(int a, int b)
+{
+    // both are the same (inc both NC)
+    if (a == b) {
+        return a;
+    }
+    // one (or both) is not connected
+    if (a == (int)NC) {
+        return b;
+    }
+    if (b == (int)NC) {
+        return a;
+    }
+    // mis-match - cannot error from constexpr, NC makes the init fail
+    return NC;
+}
+
+#if DEVICE_SPI
+/** Resolve an explicit SPI pinmap, for use with spi_init_direct
+ *
+ * @param mosi The pin to use for MOSI
+ * @param miso The pin to use for MISO
+ * @param sclk The pin to use for SCLK
+ * @param ssel The pin to use for SSEL
+ * @return Explicit pinmap for the pins, peripheral NC if they do not map to one
+ */
+MBED_STATIC_PINMAP_CONSTEXPR spi_pinmap_t get_spi_pinmap(PinName mosi, PinName miso, PinName sclk, PinName ssel)
+{
+    const spi_pinmap_t pinmap = {
+        pinmap_static_merge(pinmap_static_merge(pinmap_static_peripheral(mosi, PinMap_SPI_MOSI),
+                                                pinmap_static_peripheral(miso, PinMap_SPI_MISO)),
+                            pinmap_static_merge(pinmap_static_peripheral(sclk, PinMap_SPI_SCLK),
+                                                pinmap_static_peripheral(ssel, PinMap_SPI_SSEL))),
+        mosi, pinmap_static_function(mosi, PinMap_SPI_MOSI),
+        miso, pinmap_static_function(miso, PinMap_SPI_MISO),
+        sclk, pinmap_static_function(sclk, PinMap_SPI_SCLK),
+        ssel, pinmap_static_function(ssel, PinMap_SPI_SSEL)
+    };
+    return pinmap;
+}
+#endif
+
+#if DEVICE_I2C
+/** Resolve an explicit I2C pinmap, for use with i2c_init_direct
+ *
+ * @param sda The sda pin
+ * @param scl The scl pin
+ * @return Explicit pinmap for the pins, peripheral NC if they do not map to one
+ */
+MBED_STATIC_PINMAP_CONSTEXPR i2c_pinmap_t get_i2c_pinmap(PinName sda, PinName scl)
+{
+    const i2c_pinmap_t pinmap = {
+        pinmap_static_merge(pinmap_static_peripheral(sda, PinMap_I2C_SDA),
+                            pinmap_static_peripheral(scl, PinMap_I2C_SCL)),
+        sda, pinmap_static_function(sda, PinMap_I2C_SDA),
+        scl, pinmap_static_function(scl, PinMap_I2C_SCL)
+    };
+    return pinmap;
+}
+#endif
+
+#if DEVICE_SERIAL
+/** Resolve an explicit serial pinmap, for use with serial_init_direct
+ *
+ * @param tx The TX pin name
+ * @param rx The RX pin name
+ * @return Explicit pinmap for the pins, peripheral NC if they do not map to one
+ */
+MBED_STATIC_PINMAP_CONSTEXPR serial_pinmap_t get_uart_pinmap(PinName tx, PinName rx)
+{
+    const serial_pinmap_t pinmap = {
+        pinmap_static_merge(pinmap_static_peripheral(tx, PinMap_UART_TX),
+                            pinmap_static_peripheral(rx, PinMap_UART_RX)),
+        tx, pinmap_static_function(tx, PinMap_UART_TX),
+        rx, pinmap_static_function(rx, PinMap_UART_RX)
+    };
+    return pinmap;
+}
+#endif
+
+#if DEVICE_ANALOGIN
+/** Resolve an explicit analogin pinmap, for use with analogin_init_direct
+ *
+ * @param pin The analogin pin name
+ * @return Explicit pinmap for the pin, peripheral NC if it does not map to one
+ */
+MBED_STATIC_PINMAP_CONSTEXPR PinMap get_analogin_pinmap(PinName pin)
+{
+    const PinMap pinmap = {
+        pin,
+        pinmap_static_peripheral(pin, PinMap_ADC),
+        pinmap_static_function(pin, PinMap_ADC)
+    };
+    return pinmap;
+}
+#endif
+
+#endif /* __cplusplus */
+
+#endif
+
+/** @}*/
@@ -85,6 +85,7 @@ typedef struct {
     bool dispatching;                   /**< The function ticker_irq_handler is dispatching */
     bool suspended;                     /**< Indicate if the instance is suspended */
     uint8_t frequency_shifts;           /**< If frequency is a value of 2^n, this is n, otherwise 0 */
+    volatile uint32_t seq;              /**< Update generation counter for the lock-free read path */
 } ticker_event_queue_t;
 
 /** Ticker's data structure
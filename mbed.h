@@ -52,6 +52,7 @@
 // mbed Peripheral components
 #include "drivers/DigitalIn.h"
 #include "drivers/DigitalOut.h"
+#include "drivers/FastDigitalOut.h"
 #include "drivers/DigitalInOut.h"
 #include "drivers/BusIn.h"
 #include "drivers/BusOut.h"
@@ -60,10 +61,13 @@
 #include "drivers/PortInOut.h"
 #include "drivers/PortOut.h"
 #include "drivers/AnalogIn.h"
+#include "drivers/AudioIn.h"
 #include "drivers/AnalogOut.h"
 #include "drivers/PwmOut.h"
 #include "drivers/Serial.h"
+#include "drivers/FastSerial.h"
 #include "drivers/SPI.h"
+#include "drivers/FastSPI.h"
 #include "drivers/SPISlave.h"
 #include "drivers/I2C.h"
 #include "drivers/I2CSlave.h"
@@ -57,23 +57,42 @@ int ATCmdParser::putc(char c)
     }
 }
 
-int ATCmdParser::getc()
+int ATCmdParser::fill_rx(int timeout)
 {
+    _fill_pos = 0;
+    _fill_len = 0;
+
     pollfh fhs;
     fhs.fh = _fh;
     fhs.events = POLLIN;
 
-    int count = poll(&fhs, 1, _timeout);
-    if (count > 0 && (fhs.revents & POLLIN)) {
-        unsigned char ch;
-        return _fh->read(&ch, 1) == 1 ? ch : -1;
-    } else {
+    int count = poll(&fhs, 1, timeout);
+    if (count <= 0 || !(fhs.revents & POLLIN)) {
+        return 0;
+    }
+
+    ssize_t len = _fh->read(_fillbuf, sizeof(_fillbuf));
+    if (len <= 0) {
         return -1;
     }
+    _fill_len = len;
+    return len;
+}
+
+int ATCmdParser::getc()
+{
+    if (_fill_pos >= _fill_len) {
+        if (fill_rx(_timeout) <= 0) {
+            return -1;
+        }
+    }
+    return _fillbuf[_fill_pos++];
 }
 
 void ATCmdParser::flush()
 {
+    _fill_pos = 0;
+    _fill_len = 0;
     while (_fh->readable()) {
         unsigned char ch;
         _fh->read(&ch, 1);
@@ -96,16 +115,58 @@ int ATCmdParser::write(const char *data, int size)
 int ATCmdParser::read(char *data, int size)
 {
     int i = 0;
-    for (; i < size; i++) {
-        int c = getc();
-        if (c < 0) {
+
+    // Drain the fill buffer first
+    while (i < size && _fill_pos < _fill_len) {
+        data[i++] = _fillbuf[_fill_pos++];
+    }
+
+    // Read the rest in bulk straight into the caller's buffer
+    while (i < size) {
+        pollfh fhs;
+        fhs.fh = _fh;
+        fhs.events = POLLIN;
+
+        int count = poll(&fhs, 1, _timeout);
+        if (count <= 0 || !(fhs.revents & POLLIN)) {
+            return -1;
+        }
+        ssize_t len = _fh->read(data + i, size - i);
+        if (len <= 0) {
             return -1;
         }
-        data[i] = c;
+        i += len;
     }
     return i;
 }
 
+int ATCmdParser::recv_raw(char *data, int size)
+{
+    int i = 0;
+
+    if (size <= 0) {
+        return 0;
+    }
+
+    // Return buffered data immediately if there is any
+    while (i < size && _fill_pos < _fill_len) {
+        data[i++] = _fillbuf[_fill_pos++];
+    }
+    if (i > 0) {
+        return i;
+    }
+
+    pollfh fhs;
+    fhs.fh = _fh;
+    fhs.events = POLLIN;
+
+    int count = poll(&fhs, 1, _timeout);
+    if (count <= 0 || !(fhs.revents & POLLIN)) {
+        return 0;
+    }
+    return _fh->read(data, size);
+}
+
 
 // printf/scanf handling
 int ATCmdParser::vprintf(const char *format, std::va_list args)
@@ -260,8 +321,8 @@ restart:
 
         while (true) {
             // If just peeking for OOBs, and at start of line, check
-            // readability
-            if (!response && j == 0 && !_fh->readable()) {
+            // readability (buffered data counts as readable)
+            if (!response && j == 0 && _fill_pos >= _fill_len && !_fh->readable()) {
                 return false;
             }
             // Receive next character
@@ -64,6 +64,11 @@ private:
     char *_buffer;
     int _timeout;
 
+    // Receive fill buffer, so one FileHandle read serves many getc() calls
+    unsigned char _fillbuf[64];
+    int _fill_len;
+    int _fill_pos;
+
     // Parsing information
     const char *_output_delimiter;
     int _output_delim_size;
@@ -80,6 +85,14 @@ private:
     };
     oob *_oobs;
 
+    /** Refill the receive buffer with one bulk read, waiting up to
+     *  timeout for the first byte.
+     *
+     *  @param timeout Wait for data in milliseconds
+     *  @return number of bytes buffered, 0 on timeout, -1 on failure
+     */
+    int fill_rx(int timeout);
+
 public:
 
     /**
@@ -93,7 +106,8 @@ public:
      */
     ATCmdParser(FileHandle *fh, const char *output_delimiter = "\r",
                 int buffer_size = 256, int timeout = 8000, bool debug = false)
-        : _fh(fh), _buffer_size(buffer_size), _oob_cb_count(0), _in_prev(0), _oobs(NULL)
+        : _fh(fh), _buffer_size(buffer_size), _fill_len(0), _fill_pos(0),
+          _oob_cb_count(0), _in_prev(0), _oobs(NULL)
     {
         _buffer = new char[buffer_size];
         set_timeout(timeout);
@@ -258,6 +272,21 @@ public:
      */
     int read(char *data, int size);
 
+    /**
+     * Read whatever bytes are available from the underlying stream
+     *
+     * Drains the parser's receive buffer first and then reads from the
+     * stream in bulk, returning as soon as any data has been transferred.
+     * Intended for pulling length-prefixed binary payloads (such as +IPD
+     * data) after a recv() match, where waiting for a full fixed-size
+     * read is unnecessary.
+     *
+     * @param data The buffer for filling the read bytes
+     * @param size Maximum number of bytes to read
+     * @return number of bytes read, 0 on timeout, or -1 on failure
+     */
+    int recv_raw(char *data, int size);
+
     /**
      * Direct printf to underlying stream
      * @see printf
@@ -38,15 +38,24 @@ namespace mbed {
 template <typename F>
 class Callback;
 
+// Number of pointer-sized words of inline storage available for function
+// objects bound to a Callback. The default of one word preserves the
+// historic Callback layout, larger values let bigger function objects
+// (such as lambdas capturing several pointers) be stored without
+// changing how Callback behaves - it never allocates from the heap
+#ifndef MBED_CONF_PLATFORM_CALLBACK_STORAGE_WORDS
+#define MBED_CONF_PLATFORM_CALLBACK_STORAGE_WORDS 1
+#endif
+
 // Internal sfinae declarations
 //
-// These are used to eliminate overloads based on type attributes
-// 1. Does a function object have a call operator
-// 2. Does a function object fit in the available storage
-//
-// These eliminations are handled cleanly by the compiler and avoid
-// massive and misleading error messages when confronted with an
-// invalid type (or worse, runtime failures)
+// These are used to eliminate overloads based on whether a function
+// object has a call operator. The elimination is handled cleanly by the
+// compiler and avoids massive and misleading error messages when
+// confronted with an invalid type (or worse, runtime failures). Whether
+// the function object fits in the available storage is checked by a
+// static assert instead, so the diagnostic reports the required and
+// available byte counts rather than an opaque overload failure
 namespace detail {
 struct nil {};
 
@@ -62,12 +71,56 @@ template <typename M, M>
 struct is_type {
     static const bool value = true;
 };
+
+// Mirrors the function pointer union stored inside Callback - a member
+// function pointer has the largest size and alignment of the stored
+// function types, and its size does not depend on the signature
+struct _class;
+union callback_storage {
+    void (*staticfunc)();
+    void (_class::*methodfunc)();
+    uintptr_t words[MBED_CONF_PLATFORM_CALLBACK_STORAGE_WORDS];
+};
+
+// Bytes of inline storage a Callback provides for a function object,
+// the function pointer union plus the bound object pointer
+enum { callback_storage_size = sizeof(callback_storage) + sizeof(void *) };
+
+// The required and available byte counts are template parameters so
+// both appear verbatim in the compiler diagnostic when a function
+// object is too large for the inline storage
+template <unsigned Required, unsigned Available, bool Fits = (Required <= Available)>
+struct callback_storage_fits {
+    static const bool value = true;
+};
+
+template <unsigned Required, unsigned Available>
+struct callback_storage_fits<Required, Available, false> {};
 }
 
+/** Compile-time query of whether a callable can be bound to a Callback
+ *
+ *  Callback stores function objects inline and never allocates from the
+ *  heap - a callable either fits in the inline storage or fails to
+ *  compile. This trait makes the zero-allocation guarantee checkable up
+ *  front on hot-path callables:
+ *
+ *  @code
+ *  MBED_STATIC_ASSERT(callback_is_heap_free<MyFunctor>::value,
+ *                     "MyFunctor must fit in Callback's inline storage");
+ *  @endcode
+ *
+ *  The inline storage holds platform.callback-storage-words pointer-sized
+ *  words plus the bound object pointer.
+ */
+template <typename F>
+struct callback_is_heap_free {
+    static const bool value = sizeof(F) <= detail::callback_storage_size;
+};
+
 #define MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, M)                            \
     typename detail::enable_if<                                             \
-            detail::is_type<M, &F::operator()>::value &&                    \
-            sizeof(F) <= sizeof(uintptr_t)                                  \
+            detail::is_type<M, &F::operator()>::value                       \
         >::type = detail::nil()
 
 /** Callback class based on template specialization
@@ -182,7 +235,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)()))
@@ -192,7 +245,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(const F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)() const))
@@ -202,7 +255,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)() volatile))
@@ -212,7 +265,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(const volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)() const volatile))
@@ -433,7 +486,7 @@ public:
 
     /** Attach a function object
      *  @param f     Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -448,7 +501,7 @@ public:
 
     /** Attach a function object
      *  @param f     Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -463,7 +516,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -478,7 +531,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -618,6 +671,7 @@ private:
         void (*_staticfunc)();
         void (*_boundfunc)(_class *);
         void (_class::*_methodfunc)();
+        uintptr_t _storage[MBED_CONF_PLATFORM_CALLBACK_STORAGE_WORDS];
     } _func;
     void *_obj;
 
@@ -638,8 +692,10 @@ private:
             &Callback::function_dtor<F>,
         };
 
-        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
-                           "Type F must not exceed the size of the Callback class");
+        MBED_STATIC_ASSERT((detail::callback_storage_fits<sizeof(F), sizeof(Callback) - sizeof(_ops)>::value),
+                           "Function object does not fit in Callback's inline storage, the "
+                           "callback_storage_fits arguments above give the required and available "
+                           "bytes, increase platform.callback-storage-words to make room");
         memset(this, 0, sizeof(Callback));
         new (this) F(f);
         _ops = &ops;
@@ -806,7 +862,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0)))
@@ -816,7 +872,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(const F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0) const))
@@ -826,7 +882,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0) volatile))
@@ -836,7 +892,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(const volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0) const volatile))
@@ -1057,7 +1113,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -1072,7 +1128,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -1087,7 +1143,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -1102,7 +1158,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -1243,6 +1299,7 @@ private:
         void (*_staticfunc)(A0);
         void (*_boundfunc)(_class *, A0);
         void (_class::*_methodfunc)(A0);
+        uintptr_t _storage[MBED_CONF_PLATFORM_CALLBACK_STORAGE_WORDS];
     } _func;
     void *_obj;
 
@@ -1263,8 +1320,10 @@ private:
             &Callback::function_dtor<F>,
         };
 
-        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
-                           "Type F must not exceed the size of the Callback class");
+        MBED_STATIC_ASSERT((detail::callback_storage_fits<sizeof(F), sizeof(Callback) - sizeof(_ops)>::value),
+                           "Function object does not fit in Callback's inline storage, the "
+                           "callback_storage_fits arguments above give the required and available "
+                           "bytes, increase platform.callback-storage-words to make room");
         memset(this, 0, sizeof(Callback));
         new (this) F(f);
         _ops = &ops;
@@ -1431,7 +1490,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1)))
@@ -1441,7 +1500,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(const F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1) const))
@@ -1451,7 +1510,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1) volatile))
@@ -1461,7 +1520,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(const volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1) const volatile))
@@ -1682,7 +1741,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -1697,7 +1756,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -1712,7 +1771,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -1727,7 +1786,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -1869,6 +1928,7 @@ private:
         void (*_staticfunc)(A0, A1);
         void (*_boundfunc)(_class *, A0, A1);
         void (_class::*_methodfunc)(A0, A1);
+        uintptr_t _storage[MBED_CONF_PLATFORM_CALLBACK_STORAGE_WORDS];
     } _func;
     void *_obj;
 
@@ -1889,8 +1949,10 @@ private:
             &Callback::function_dtor<F>,
         };
 
-        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
-                           "Type F must not exceed the size of the Callback class");
+        MBED_STATIC_ASSERT((detail::callback_storage_fits<sizeof(F), sizeof(Callback) - sizeof(_ops)>::value),
+                           "Function object does not fit in Callback's inline storage, the "
+                           "callback_storage_fits arguments above give the required and available "
+                           "bytes, increase platform.callback-storage-words to make room");
         memset(this, 0, sizeof(Callback));
         new (this) F(f);
         _ops = &ops;
@@ -2057,7 +2119,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2)))
@@ -2067,7 +2129,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(const F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2) const))
@@ -2077,7 +2139,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2) volatile))
@@ -2087,7 +2149,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(const volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2) const volatile))
@@ -2308,7 +2370,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -2323,7 +2385,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -2338,7 +2400,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -2353,7 +2415,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -2496,6 +2558,7 @@ private:
         void (*_staticfunc)(A0, A1, A2);
         void (*_boundfunc)(_class *, A0, A1, A2);
         void (_class::*_methodfunc)(A0, A1, A2);
+        uintptr_t _storage[MBED_CONF_PLATFORM_CALLBACK_STORAGE_WORDS];
     } _func;
     void *_obj;
 
@@ -2516,8 +2579,10 @@ private:
             &Callback::function_dtor<F>,
         };
 
-        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
-                           "Type F must not exceed the size of the Callback class");
+        MBED_STATIC_ASSERT((detail::callback_storage_fits<sizeof(F), sizeof(Callback) - sizeof(_ops)>::value),
+                           "Function object does not fit in Callback's inline storage, the "
+                           "callback_storage_fits arguments above give the required and available "
+                           "bytes, increase platform.callback-storage-words to make room");
         memset(this, 0, sizeof(Callback));
         new (this) F(f);
         _ops = &ops;
@@ -2684,7 +2749,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2, A3)))
@@ -2694,7 +2759,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(const F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2, A3) const))
@@ -2704,7 +2769,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2, A3) volatile))
@@ -2714,7 +2779,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(const volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2, A3) const volatile))
@@ -2935,7 +3000,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -2950,7 +3015,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -2965,7 +3030,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -2980,7 +3045,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -3124,6 +3189,7 @@ private:
         void (*_staticfunc)(A0, A1, A2, A3);
         void (*_boundfunc)(_class *, A0, A1, A2, A3);
         void (_class::*_methodfunc)(A0, A1, A2, A3);
+        uintptr_t _storage[MBED_CONF_PLATFORM_CALLBACK_STORAGE_WORDS];
     } _func;
     void *_obj;
 
@@ -3144,8 +3210,10 @@ private:
             &Callback::function_dtor<F>,
         };
 
-        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
-                           "Type F must not exceed the size of the Callback class");
+        MBED_STATIC_ASSERT((detail::callback_storage_fits<sizeof(F), sizeof(Callback) - sizeof(_ops)>::value),
+                           "Function object does not fit in Callback's inline storage, the "
+                           "callback_storage_fits arguments above give the required and available "
+                           "bytes, increase platform.callback-storage-words to make room");
         memset(this, 0, sizeof(Callback));
         new (this) F(f);
         _ops = &ops;
@@ -3312,7 +3380,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2, A3, A4)))
@@ -3322,7 +3390,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(const F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2, A3, A4) const))
@@ -3332,7 +3400,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2, A3, A4) volatile))
@@ -3342,7 +3410,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      */
     template <typename F>
     Callback(const volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2, A3, A4) const volatile))
@@ -3563,7 +3631,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -3578,7 +3646,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -3593,7 +3661,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -3608,7 +3676,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to the Callback's inline storage, sized by platform.callback-storage-words
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -3753,6 +3821,7 @@ private:
         void (*_staticfunc)(A0, A1, A2, A3, A4);
         void (*_boundfunc)(_class *, A0, A1, A2, A3, A4);
         void (_class::*_methodfunc)(A0, A1, A2, A3, A4);
+        uintptr_t _storage[MBED_CONF_PLATFORM_CALLBACK_STORAGE_WORDS];
     } _func;
     void *_obj;
 
@@ -3773,8 +3842,10 @@ private:
             &Callback::function_dtor<F>,
         };
 
-        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
-                           "Type F must not exceed the size of the Callback class");
+        MBED_STATIC_ASSERT((detail::callback_storage_fits<sizeof(F), sizeof(Callback) - sizeof(_ops)>::value),
+                           "Function object does not fit in Callback's inline storage, the "
+                           "callback_storage_fits arguments above give the required and available "
+                           "bytes, increase platform.callback-storage-words to make room");
         memset(this, 0, sizeof(Callback));
         new (this) F(f);
         _ops = &ops;
@@ -17,8 +17,10 @@
 #ifndef MBED_CIRCULARBUFFER_H
 #define MBED_CIRCULARBUFFER_H
 
+#include <string.h>
 #include "platform/mbed_critical.h"
 #include "platform/mbed_assert.h"
+#include "platform/mbed_toolchain.h"
 
 namespace mbed {
 
@@ -206,6 +208,257 @@ private:
     bool _full;
 };
 
+/** Templated lock-free circular buffer for a single producer and a single consumer
+ *
+ *  Unlike CircularBuffer, no operation disables interrupts, so a producer
+ *  running in an interrupt handler adds no interrupt latency elsewhere.
+ *  This is safe as long as there is exactly one producer context calling
+ *  push/push_n and one consumer context calling pop/pop_n/peek - either
+ *  of which may be an interrupt handler. empty, full and size may be
+ *  called from both contexts.
+ *
+ *  One slot is kept free to distinguish a full buffer from an empty one,
+ *  so the buffer holds at most BufferSize - 1 elements.
+ *
+ *  @note Synchronization level: Interrupt safe (single producer, single consumer)
+ *  @note T must be trivially copyable - bulk transfers copy with memcpy
+ *  @note CounterType must be unsigned and consistent with BufferSize
+ */
+template<typename T, uint32_t BufferSize, typename CounterType = uint32_t>
+class SPSCCircularBuffer {
+public:
+    SPSCCircularBuffer() : _head(0), _tail(0)
+    {
+        MBED_STATIC_ASSERT(
+            internal::is_unsigned<CounterType>::value,
+            "CounterType must be unsigned"
+        );
+
+        MBED_STATIC_ASSERT(
+            (sizeof(CounterType) >= sizeof(uint32_t)) ||
+            (BufferSize < (((uint64_t) 1) << (sizeof(CounterType) * 8))),
+            "Invalid BufferSize for the CounterType"
+        );
+    }
+
+    ~SPSCCircularBuffer()
+    {
+    }
+
+    /** Push a single element to the buffer
+     *
+     *  Fails instead of overwriting when the buffer is full - the
+     *  producer cannot reclaim the consumer's slots without a lock.
+     *
+     * @param data Data to be pushed to the buffer
+     * @return True if the buffer was not full and the data was pushed
+     */
+    bool push(const T &data)
+    {
+        CounterType head = _head;
+        CounterType next = head + 1;
+        if (next == BufferSize) {
+            next = 0;
+        }
+        if (next == _tail) {
+            return false;
+        }
+        _pool[head] = data;
+        // make the data visible before publishing the new head
+        MBED_COMPILER_BARRIER();
+        _head = next;
+        return true;
+    }
+
+    /** Pop a single element from the buffer
+     *
+     * @param data Data popped from the buffer
+     * @return True if the buffer was not empty and data contains an element
+     */
+    bool pop(T &data)
+    {
+        CounterType tail = _tail;
+        if (tail == _head) {
+            return false;
+        }
+        // read the data only after the head check has confirmed it
+        MBED_COMPILER_BARRIER();
+        data = _pool[tail];
+        // finish reading the data before releasing the slot
+        MBED_COMPILER_BARRIER();
+        tail++;
+        if (tail == BufferSize) {
+            tail = 0;
+        }
+        _tail = tail;
+        return true;
+    }
+
+    /** Push up to len elements to the buffer
+     *
+     *  Contiguous runs are copied with memcpy (at most two copies when
+     *  the data wraps), which is considerably faster than pushing
+     *  elements one at a time for block transfers.
+     *
+     * @param data Array of elements to push
+     * @param len  Number of elements to push
+     * @return Number of elements actually pushed, less than len if the buffer fills
+     */
+    CounterType push_n(const T *data, CounterType len)
+    {
+        CounterType head = _head;
+        CounterType tail = _tail;
+        CounterType free_slots;
+        if (tail > head) {
+            free_slots = tail - head - 1;
+        } else {
+            free_slots = BufferSize - 1 - (head - tail);
+        }
+        if (len > free_slots) {
+            len = free_slots;
+        }
+        if (len == 0) {
+            return 0;
+        }
+
+        CounterType run = BufferSize - head;
+        if (run > len) {
+            run = len;
+        }
+        memcpy(&_pool[head], data, run * sizeof(T));
+        if (len > run) {
+            memcpy(&_pool[0], data + run, (len - run) * sizeof(T));
+        }
+        // make the data visible before publishing the new head
+        MBED_COMPILER_BARRIER();
+        head += len;
+        if (head >= BufferSize) {
+            head -= BufferSize;
+        }
+        _head = head;
+        return len;
+    }
+
+    /** Pop up to len elements from the buffer
+     *
+     *  Contiguous runs are copied with memcpy (at most two copies when
+     *  the data wraps).
+     *
+     * @param data Array the popped elements are copied to
+     * @param len  Maximum number of elements to pop
+     * @return Number of elements actually popped, less than len if the buffer drains
+     */
+    CounterType pop_n(T *data, CounterType len)
+    {
+        CounterType tail = _tail;
+        CounterType head = _head;
+        // read the data only after the head check has confirmed it
+        MBED_COMPILER_BARRIER();
+        CounterType avail;
+        if (head >= tail) {
+            avail = head - tail;
+        } else {
+            avail = BufferSize - (tail - head);
+        }
+        if (len > avail) {
+            len = avail;
+        }
+        if (len == 0) {
+            return 0;
+        }
+
+        CounterType run = BufferSize - tail;
+        if (run > len) {
+            run = len;
+        }
+        memcpy(data, &_pool[tail], run * sizeof(T));
+        if (len > run) {
+            memcpy(data + run, &_pool[0], (len - run) * sizeof(T));
+        }
+        // finish reading the data before releasing the slots
+        MBED_COMPILER_BARRIER();
+        tail += len;
+        if (tail >= BufferSize) {
+            tail -= BufferSize;
+        }
+        _tail = tail;
+        return len;
+    }
+
+    /** Check if the buffer is empty
+     *
+     * @return True if the buffer is empty, false if not
+     */
+    bool empty() const
+    {
+        return _head == _tail;
+    }
+
+    /** Check if the buffer is full
+     *
+     * @return True if the buffer is full, false if not
+     */
+    bool full() const
+    {
+        CounterType next = _head + 1;
+        if (next == BufferSize) {
+            next = 0;
+        }
+        return next == _tail;
+    }
+
+    /** Get the number of elements currently stored in the buffer
+     *
+     *  When called concurrently with push or pop the result may lag by
+     *  the elements in flight, but is never corrupt.
+     *
+     * @return Number of elements stored
+     */
+    CounterType size() const
+    {
+        CounterType head = _head;
+        CounterType tail = _tail;
+        if (head >= tail) {
+            return head - tail;
+        }
+        return BufferSize - (tail - head);
+    }
+
+    /** Peek into the buffer without popping
+     *
+     *  Called from the consumer context only.
+     *
+     * @param data Data peeked from the buffer
+     * @return True if the buffer was not empty and data contains an element
+     */
+    bool peek(T &data) const
+    {
+        CounterType tail = _tail;
+        if (tail == _head) {
+            return false;
+        }
+        MBED_COMPILER_BARRIER();
+        data = _pool[tail];
+        return true;
+    }
+
+    /** Reset the buffer
+     *
+     *  Not lock-free - only call while neither the producer nor the
+     *  consumer context is active.
+     */
+    void reset()
+    {
+        _head = 0;
+        _tail = 0;
+    }
+
+private:
+    T _pool[BufferSize];
+    volatile CounterType _head;
+    volatile CounterType _tail;
+};
+
 /**@}*/
 
 /**@}*/
@@ -20,6 +20,83 @@
 
 namespace mbed {
 
+ssize_t FileHandle::readv(const iovec_t *iov, int count)
+{
+    size_t total = 0;
+
+    for (int i = 0; i < count; i++) {
+        if (iov[i].length == 0) {
+            continue;
+        }
+        ssize_t ret = read(iov[i].buffer, iov[i].length);
+        if (ret < 0) {
+            /* report data already transferred in preference to the error */
+            return total > 0 ? (ssize_t) total : ret;
+        }
+        total += ret;
+        if ((size_t) ret < iov[i].length) {
+            break;
+        }
+    }
+
+    return total;
+}
+
+ssize_t FileHandle::writev(const iovec_t *iov, int count)
+{
+    size_t total = 0;
+
+    for (int i = 0; i < count; i++) {
+        if (iov[i].length == 0) {
+            continue;
+        }
+        ssize_t ret = write(iov[i].buffer, iov[i].length);
+        if (ret < 0) {
+            return total > 0 ? (ssize_t) total : ret;
+        }
+        total += ret;
+        if ((size_t) ret < iov[i].length) {
+            break;
+        }
+    }
+
+    return total;
+}
+
+ssize_t FileHandle::pread(void *buffer, size_t size, off_t offset)
+{
+    /* remember our current position */
+    off_t off = seek(0, SEEK_CUR);
+    if (off < 0) {
+        return off;
+    }
+    off_t pos = seek(offset, SEEK_SET);
+    if (pos < 0) {
+        return pos;
+    }
+    ssize_t ret = read(buffer, size);
+    /* return to our old position */
+    seek(off, SEEK_SET);
+    return ret;
+}
+
+ssize_t FileHandle::pwrite(const void *buffer, size_t size, off_t offset)
+{
+    /* remember our current position */
+    off_t off = seek(0, SEEK_CUR);
+    if (off < 0) {
+        return off;
+    }
+    off_t pos = seek(offset, SEEK_SET);
+    if (pos < 0) {
+        return pos;
+    }
+    ssize_t ret = write(buffer, size);
+    /* return to our old position */
+    seek(off, SEEK_SET);
+    return ret;
+}
+
 off_t FileHandle::size()
 {
     /* remember our current position */
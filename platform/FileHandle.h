@@ -24,6 +24,7 @@ typedef int FILEHANDLE;
 #include "platform/mbed_poll.h"
 #include "platform/platform.h"
 #include "platform/NonCopyable.h"
+#include "platform/Span.h"
 
 namespace mbed {
 /** \addtogroup platform */
@@ -34,6 +35,16 @@ namespace mbed {
  */
 
 
+/** Scatter-gather buffer descriptor, the equivalent of POSIX struct iovec
+ *
+ *  An array of these describes a sequence of separate memory regions to
+ *  be transferred as one logical read or write.
+ */
+struct iovec_t {
+    void *buffer;  /**< Start of the buffer */
+    size_t length; /**< Length of the buffer in bytes */
+};
+
 /** Class FileHandle
  *
  *  An abstract interface that represents operations on a file-like
@@ -75,6 +86,96 @@ public:
      */
     virtual ssize_t write(const void *buffer, size_t size) = 0;
 
+    /** Read the contents of a file into a Span
+     *
+     *  Equivalent to read(void *, size_t) with the buffer and size taken
+     *  from the Span; accepts fixed-extent Spans through the usual Span
+     *  conversions.
+     *
+     *  @param buffer   The Span to read in to
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    ssize_t read(Span<uint8_t> buffer)
+    {
+        return read(buffer.data(), buffer.size());
+    }
+
+    /** Write the contents of a Span to a file
+     *
+     *  Equivalent to write(const void *, size_t) with the buffer and size
+     *  taken from the Span; accepts fixed-extent and non-const Spans
+     *  through the usual Span conversions.
+     *
+     *  @param buffer   The Span to write from
+     *  @return         The number of bytes written, negative error on failure
+     */
+    ssize_t write(Span<const uint8_t> buffer)
+    {
+        return write(buffer.data(), buffer.size());
+    }
+
+    /** Read the contents of a file into multiple buffers (scatter input)
+     *
+     *  Buffers are filled in array order; the equivalent of POSIX readv().
+     *  The default implementation issues one read() per buffer, so
+     *  derived classes able to gather data under a single lock should
+     *  override this.
+     *
+     *  Follows the same semantics as read() - the same blocking and
+     *  error-reporting rules apply to the transfer as a whole.
+     *
+     *  @param iov      An array of buffers to read in to
+     *  @param count    The number of elements in iov
+     *  @return         The total number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t readv(const iovec_t *iov, int count);
+
+    /** Write the contents of multiple buffers to a file (gather output)
+     *
+     *  Buffers are written out in array order with no intervening data;
+     *  the equivalent of POSIX writev(). The default implementation
+     *  issues one write() per buffer, so derived classes able to accept
+     *  all buffers under a single lock should override this.
+     *
+     *  Follows the same semantics as write() - the same blocking and
+     *  error-reporting rules apply to the transfer as a whole.
+     *
+     *  @param iov      An array of buffers to write from
+     *  @param count    The number of elements in iov
+     *  @return         The total number of bytes written, negative error on failure
+     */
+    virtual ssize_t writev(const iovec_t *iov, int count);
+
+    /** Read from a given file offset without moving the file position
+     *
+     *  The equivalent of POSIX pread(). Carrying the offset in the call
+     *  lets several threads read one file handle without coordinating a
+     *  shared file position around every transfer.
+     *
+     *  The default implementation brackets read() with a pair of seeks
+     *  and so is only thread safe if the derived class makes the whole
+     *  sequence atomic; classes backed by a lock should override this to
+     *  do the positioned read under a single lock acquisition.
+     *
+     *  @param buffer   The buffer to read in to
+     *  @param size     The number of bytes to read
+     *  @param offset   The file offset to read from
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t pread(void *buffer, size_t size, off_t offset);
+
+    /** Write to a given file offset without moving the file position
+     *
+     *  The equivalent of POSIX pwrite(). The same threading notes as
+     *  for pread() apply to the default implementation.
+     *
+     *  @param buffer   The buffer to write from
+     *  @param size     The number of bytes to write
+     *  @param offset   The file offset to write to
+     *  @return         The number of bytes written, negative error on failure
+     */
+    virtual ssize_t pwrite(const void *buffer, size_t size, off_t offset);
+
     /** Move the file position to a given offset from from a given location
      *
      *  @param offset   The offset from whence to move to
@@ -264,6 +365,17 @@ public:
     {
         //Default for real files. Do nothing for real files.
     }
+
+protected:
+
+    /** Wake up threads blocked in mbed::poll()
+     *
+     *  The derived class should call this whenever the state of any of its
+     *  poll() events changes, alongside invoking the sigio() callback.
+     *  Pollers re-evaluate their file handles when woken, so spurious
+     *  wake-ups are harmless. May be called from interrupt context.
+     */
+    void wake_poll();
 };
 
 /**@}*/
@@ -0,0 +1,78 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_SCOPEDPROFILER_H
+#define MBED_SCOPEDPROFILER_H
+
+#include "platform/mbed_profiler.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+
+/** \addtogroup platform */
+/** @{*/
+
+/** RAII object measuring the cycles spent in its enclosing scope with
+  * the DWT cycle counter. See mbed_profiler.h for the aggregation and
+  * retrieval API; when the profiler is disabled this compiles to
+  * nothing.
+  *
+  * Usage:
+  * @code
+  *
+  * void handle_input(...) {
+  *     MBED_PROFILE_SCOPE("handle_input");
+  *     // measured code
+  * }
+  * @endcode
+  */
+class ScopedProfiler : private mbed::NonCopyable<ScopedProfiler> {
+public:
+
+    /**
+     * Start measuring, taking the cycle count at construction.
+     *
+     * @param site the static site the measurement is recorded against.
+     */
+    ScopedProfiler(mbed_profiler_site_t *site) : _site(site), _start(mbed_profiler_enter())
+    {
+    }
+
+    /**
+     * Stop measuring and record the visit against the site.
+     */
+    ~ScopedProfiler()
+    {
+        mbed_profiler_exit(_site, _start);
+    }
+
+private:
+    mbed_profiler_site_t *_site;
+    uint32_t _start;
+};
+
+/** Declare a measurement site named @a name and measure from here to the
+  * end of the enclosing scope. Use at most once per scope. */
+#define MBED_PROFILE_SCOPE(name)                                                \
+    static mbed_profiler_site_t mbed_profiler_scope_site =                      \
+        MBED_PROFILER_SITE_INIT(name);                                          \
+    mbed::ScopedProfiler mbed_profiler_scope(&mbed_profiler_scope_site)
+
+/**@}*/
+
+}
+
+#endif
@@ -19,6 +19,7 @@
 #define __SHAREDPTR_H__
 
 #include <stdlib.h>
+#include <new>
 
 #include <stdint.h>
 #include <stddef.h>
@@ -27,6 +28,121 @@
 
 namespace mbed {
 
+template <class T>
+class SharedPtr;
+
+template <class T>
+class WeakPtr;
+
+template <class T>
+SharedPtr<T> make_shared();
+
+template <class T, class Arg1>
+SharedPtr<T> make_shared(const Arg1 &arg1);
+
+template <class T, class Arg1, class Arg2>
+SharedPtr<T> make_shared(const Arg1 &arg1, const Arg2 &arg2);
+
+template <class T, class Arg1, class Arg2, class Arg3>
+SharedPtr<T> make_shared(const Arg1 &arg1, const Arg2 &arg2, const Arg3 &arg3);
+
+template <class T, class Arg1, class Arg2, class Arg3, class Arg4>
+SharedPtr<T> make_shared(const Arg1 &arg1, const Arg2 &arg2, const Arg3 &arg3, const Arg4 &arg4);
+
+namespace internal {
+
+/* Control block shared by every SharedPtr and WeakPtr referring to the same
+ * object. strong_count owns the object; weak_count owns the control block
+ * itself, with all strong references collectively holding one weak count.
+ * Both counts are only ever touched with the core_util atomics, so taking
+ * and dropping references never disables interrupts. */
+struct SharedPtrControl {
+    SharedPtrControl() : strong_count(1), weak_count(1)
+    {
+    }
+
+    virtual ~SharedPtrControl()
+    {
+    }
+
+    /* Destroy the managed object - called when the last strong reference
+     * goes away, which can be before the control block itself is freed. */
+    virtual void destroy_object() = 0;
+
+    volatile uint32_t strong_count;
+    volatile uint32_t weak_count;
+};
+
+/* Control block for an object allocated separately with new. */
+template <class T>
+struct SharedPtrSeparateControl : public SharedPtrControl {
+    SharedPtrSeparateControl(T *ptr) : object(ptr)
+    {
+    }
+
+    virtual void destroy_object()
+    {
+        delete object;
+    }
+
+    T *object;
+};
+
+/* Control block with the object embedded, so make_shared needs a single
+ * heap allocation for object and reference counts together. */
+template <class T>
+struct SharedPtrCombinedControl : public SharedPtrControl {
+    SharedPtrCombinedControl()
+    {
+        new (storage()) T();
+    }
+
+    template <class Arg1>
+    SharedPtrCombinedControl(const Arg1 &arg1)
+    {
+        new (storage()) T(arg1);
+    }
+
+    template <class Arg1, class Arg2>
+    SharedPtrCombinedControl(const Arg1 &arg1, const Arg2 &arg2)
+    {
+        new (storage()) T(arg1, arg2);
+    }
+
+    template <class Arg1, class Arg2, class Arg3>
+    SharedPtrCombinedControl(const Arg1 &arg1, const Arg2 &arg2, const Arg3 &arg3)
+    {
+        new (storage()) T(arg1, arg2, arg3);
+    }
+
+    template <class Arg1, class Arg2, class Arg3, class Arg4>
+    SharedPtrCombinedControl(const Arg1 &arg1, const Arg2 &arg2, const Arg3 &arg3, const Arg4 &arg4)
+    {
+        new (storage()) T(arg1, arg2, arg3, arg4);
+    }
+
+    T *storage()
+    {
+        return reinterpret_cast<T *>(_storage);
+    }
+
+    virtual void destroy_object()
+    {
+        storage()->~T();
+    }
+
+private:
+    /* Raw storage for the object, aligned for the largest scalar types. */
+    union {
+        char _storage[sizeof(T)];
+        long long _align_ll;
+        double _align_d;
+        void *_align_p;
+    };
+};
+
+} // namespace internal
+
 /** Shared pointer class.
   *
   * A shared pointer is a "smart" pointer that retains ownership of an object using
@@ -52,16 +168,19 @@ namespace mbed {
   *
   *
   * It is similar to the std::shared_ptr class introduced in C++11;
-  * however, this is not a compatible implementation (no weak pointer, no make_shared, no custom deleters and so on.)
+  * however, this is not a compatible implementation (no custom deleters,
+  * no pointer casts and so on.)
   *
-  * Usage: SharedPtr<Class> ptr(new Class())
+  * Usage: SharedPtr<Class> ptr(new Class()), or
+  * make_shared<Class>() to put the object and its reference counts in a
+  * single heap allocation.
   *
   * When ptr is passed around by value, the copy constructor and
   * destructor manages the reference count of the raw pointer.
   * If the counter reaches zero, delete is called on the raw pointer.
   *
-  * To avoid loops, use "weak" references by calling the original
-  * pointer directly through ptr.get().
+  * To avoid ownership loops, use WeakPtr for back references - it observes
+  * the object without keeping it alive and can be promoted with lock().
   */
 
 template <class T>
@@ -71,7 +190,7 @@ public:
      * @brief Create empty SharedPtr not pointing to anything.
      * @details Used for variable declaration.
      */
-    SharedPtr(): _ptr(NULL), _counter(NULL)
+    SharedPtr(): _ptr(NULL), _control(NULL)
     {
     }
 
@@ -79,12 +198,11 @@ public:
      * @brief Create new SharedPtr
      * @param ptr Pointer to take control over
      */
-    SharedPtr(T *ptr): _ptr(ptr), _counter(NULL)
+    SharedPtr(T *ptr): _ptr(ptr), _control(NULL)
     {
-        // Allocate counter on the heap, so it can be shared
+        // Allocate control block on the heap, so it can be shared
         if (_ptr != NULL) {
-            _counter = new uint32_t;
-            *_counter = 1;
+            _control = new internal::SharedPtrSeparateControl<T>(ptr);
         }
     }
 
@@ -100,20 +218,20 @@ public:
     /**
      * @brief Copy constructor.
      * @details Create new SharedPtr from other SharedPtr by
-     *          copying pointer to original object and pointer to counter.
+     *          copying pointer to original object and pointer to control block.
      * @param source Object being copied from.
      */
-    SharedPtr(const SharedPtr &source): _ptr(source._ptr), _counter(source._counter)
+    SharedPtr(const SharedPtr &source): _ptr(source._ptr), _control(source._control)
     {
         // Increment reference counter
-        if (_ptr != NULL) {
-            core_util_atomic_incr_u32(_counter, 1);
+        if (_control != NULL) {
+            core_util_atomic_incr_u32(&_control->strong_count, 1);
         }
     }
 
     /**
      * @brief Assignment operator.
-     * @details Cleanup previous reference and assign new pointer and counter.
+     * @details Cleanup previous reference and assign new pointer and control block.
      * @param source Object being assigned from.
      * @return Object being assigned.
      */
@@ -124,12 +242,12 @@ public:
             decrement_counter();
 
             // Assign new values
-            _ptr = source.get();
-            _counter = source.get_counter();
+            _ptr = source._ptr;
+            _control = source._control;
 
             // Increment new counter
-            if (_ptr != NULL) {
-                core_util_atomic_incr_u32(_counter, 1);
+            if (_control != NULL) {
+                core_util_atomic_incr_u32(&_control->strong_count, 1);
             }
         }
 
@@ -145,10 +263,11 @@ public:
         // Clean up by decrementing counter
         decrement_counter();
 
+        _ptr = ptr;
+        _control = NULL;
         if (ptr != NULL) {
-            // Allocate counter on the heap, so it can be shared
-            _counter = new uint32_t;
-            *_counter = 1;
+            // Allocate control block on the heap, so it can be shared
+            _control = new internal::SharedPtrSeparateControl<T>(ptr);
         }
     }
 
@@ -172,15 +291,15 @@ public:
 
     /**
      * @brief Reference count accessor.
+     * @details An aligned 32-bit read is atomic, and the count can change
+     *          the moment it has been read, so no further synchronization
+     *          is applied.
      * @return Reference count.
      */
     uint32_t use_count() const
     {
-        if (_ptr != NULL) {
-            core_util_critical_section_enter();
-            uint32_t current_counter = *_counter;
-            core_util_critical_section_exit();
-            return current_counter;
+        if (_control != NULL) {
+            return _control->strong_count;
         } else {
             return 0;
         }
@@ -215,28 +334,31 @@ public:
 
 private:
     /**
-     * @brief Get pointer to reference counter.
-     * @return Pointer to reference counter.
+     * @brief Adopt an already-counted reference.
+     * @details Used by make_shared and WeakPtr::lock, which have raised
+     *          the strong count themselves.
      */
-    uint32_t *get_counter() const
+    SharedPtr(T *ptr, internal::SharedPtrControl *control): _ptr(ptr), _control(control)
     {
-        return _counter;
     }
 
     /**
      * @brief Decrement reference counter.
-     * @details If count reaches zero, free counter and delete object pointed to.
+     * @details If count reaches zero, destroy the object; the control block
+     *          is freed once no weak references observe it either.
      */
     void decrement_counter()
     {
-        if (_ptr != NULL) {
-            uint32_t new_value = core_util_atomic_decr_u32(_counter, 1);
-            if (new_value == 0) {
-                delete _counter;
-                _counter = NULL;
-                delete _ptr;
-                _ptr = NULL;
+        if (_control != NULL) {
+            if (core_util_atomic_decr_u32(&_control->strong_count, 1) == 0) {
+                _control->destroy_object();
+                // Drop the weak count held collectively by the strong references
+                if (core_util_atomic_decr_u32(&_control->weak_count, 1) == 0) {
+                    delete _control;
+                }
             }
+            _ptr = NULL;
+            _control = NULL;
         }
     }
 
@@ -244,10 +366,238 @@ private:
     // Pointer to shared object
     T *_ptr;
 
-    // Pointer to shared reference counter
-    uint32_t *_counter;
+    // Pointer to shared control block
+    internal::SharedPtrControl *_control;
+
+    template <class U>
+    friend class WeakPtr;
+
+    template <class U>
+    friend SharedPtr<U> make_shared();
+
+    template <class U, class Arg1>
+    friend SharedPtr<U> make_shared(const Arg1 &);
+
+    template <class U, class Arg1, class Arg2>
+    friend SharedPtr<U> make_shared(const Arg1 &, const Arg2 &);
+
+    template <class U, class Arg1, class Arg2, class Arg3>
+    friend SharedPtr<U> make_shared(const Arg1 &, const Arg2 &, const Arg3 &);
+
+    template <class U, class Arg1, class Arg2, class Arg3, class Arg4>
+    friend SharedPtr<U> make_shared(const Arg1 &, const Arg2 &, const Arg3 &, const Arg4 &);
 };
 
+/** Weak pointer class.
+  *
+  * A weak pointer observes an object managed by SharedPtr without keeping
+  * it alive, the equivalent of std::weak_ptr. It breaks reference cycles:
+  * the back reference in a doubly-linked structure or a buffer pool's view
+  * of its outstanding buffers can be a WeakPtr, and the object is still
+  * destroyed when the last SharedPtr goes away.
+  *
+  * Call lock() to promote a weak pointer to a SharedPtr; the result is
+  * empty if the object has already been destroyed.
+  */
+template <class T>
+class WeakPtr {
+public:
+    /**
+     * @brief Create empty WeakPtr not observing anything.
+     */
+    WeakPtr(): _ptr(NULL), _control(NULL)
+    {
+    }
+
+    /**
+     * @brief Create WeakPtr observing the object managed by a SharedPtr.
+     * @param source Shared pointer to observe.
+     */
+    WeakPtr(const SharedPtr<T> &source): _ptr(source._ptr), _control(source._control)
+    {
+        increment_weak();
+    }
+
+    /**
+     * @brief Copy constructor.
+     * @param source Object being copied from.
+     */
+    WeakPtr(const WeakPtr &source): _ptr(source._ptr), _control(source._control)
+    {
+        increment_weak();
+    }
+
+    /**
+     * @brief Destructor.
+     * @details Release the weak reference; the control block is freed when
+     *          neither strong nor weak references remain.
+     */
+    ~WeakPtr()
+    {
+        decrement_weak();
+    }
+
+    /**
+     * @brief Assignment operator.
+     * @param source Object being assigned from.
+     * @return Object being assigned.
+     */
+    WeakPtr &operator=(const WeakPtr &source)
+    {
+        if (this != &source) {
+            decrement_weak();
+            _ptr = source._ptr;
+            _control = source._control;
+            increment_weak();
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Assignment from a SharedPtr.
+     * @param source Shared pointer to observe.
+     * @return Object being assigned.
+     */
+    WeakPtr &operator=(const SharedPtr<T> &source)
+    {
+        decrement_weak();
+        _ptr = source._ptr;
+        _control = source._control;
+        increment_weak();
+
+        return *this;
+    }
+
+    /**
+     * @brief Promote the weak pointer to a SharedPtr.
+     * @details The strong count is only raised if the object is still
+     *          alive, so the returned pointer is safe to dereference
+     *          after a boolean check.
+     * @return SharedPtr owning the object, or an empty SharedPtr if the
+     *         object has already been destroyed.
+     */
+    SharedPtr<T> lock() const
+    {
+        if (_control != NULL) {
+            uint32_t count = _control->strong_count;
+            while (count != 0) {
+                if (core_util_atomic_cas_u32(&_control->strong_count, &count, count + 1)) {
+                    return SharedPtr<T>(_ptr, _control);
+                }
+                // count has been reloaded by the failed compare-and-swap
+            }
+        }
+
+        return SharedPtr<T>();
+    }
+
+    /**
+     * @brief Reference count accessor.
+     * @return Number of SharedPtr instances keeping the object alive.
+     */
+    uint32_t use_count() const
+    {
+        if (_control != NULL) {
+            return _control->strong_count;
+        } else {
+            return 0;
+        }
+    }
+
+    /**
+     * @brief Check whether the observed object has been destroyed.
+     * @return True if no SharedPtr keeps the object alive anymore.
+     */
+    bool expired() const
+    {
+        return (use_count() == 0);
+    }
+
+    /**
+     * @brief Stop observing, without affecting the object.
+     */
+    void reset()
+    {
+        decrement_weak();
+        _ptr = NULL;
+        _control = NULL;
+    }
+
+private:
+    void increment_weak()
+    {
+        if (_control != NULL) {
+            core_util_atomic_incr_u32(&_control->weak_count, 1);
+        }
+    }
+
+    void decrement_weak()
+    {
+        if (_control != NULL) {
+            if (core_util_atomic_decr_u32(&_control->weak_count, 1) == 0) {
+                delete _control;
+            }
+        }
+    }
+
+private:
+    // Pointer to observed object, only dereferenced through lock()
+    T *_ptr;
+
+    // Pointer to shared control block
+    internal::SharedPtrControl *_control;
+};
+
+/** Create a SharedPtr with the object and its reference counts in a single
+  * heap allocation, the equivalent of std::make_shared.
+  *
+  * Overloads forward up to four constructor arguments. Compared to
+  * SharedPtr<T>(new T(...)) this halves the number of heap operations per
+  * object, which matters for small, frequently allocated objects such as
+  * per-packet buffers.
+  *
+  * @return SharedPtr owning the newly constructed object.
+  */
+template <class T>
+SharedPtr<T> make_shared()
+{
+    internal::SharedPtrCombinedControl<T> *control = new internal::SharedPtrCombinedControl<T>();
+    return SharedPtr<T>(control->storage(), control);
+}
+
+/** @copydoc make_shared() */
+template <class T, class Arg1>
+SharedPtr<T> make_shared(const Arg1 &arg1)
+{
+    internal::SharedPtrCombinedControl<T> *control = new internal::SharedPtrCombinedControl<T>(arg1);
+    return SharedPtr<T>(control->storage(), control);
+}
+
+/** @copydoc make_shared() */
+template <class T, class Arg1, class Arg2>
+SharedPtr<T> make_shared(const Arg1 &arg1, const Arg2 &arg2)
+{
+    internal::SharedPtrCombinedControl<T> *control = new internal::SharedPtrCombinedControl<T>(arg1, arg2);
+    return SharedPtr<T>(control->storage(), control);
+}
+
+/** @copydoc make_shared() */
+template <class T, class Arg1, class Arg2, class Arg3>
+SharedPtr<T> make_shared(const Arg1 &arg1, const Arg2 &arg2, const Arg3 &arg3)
+{
+    internal::SharedPtrCombinedControl<T> *control = new internal::SharedPtrCombinedControl<T>(arg1, arg2, arg3);
+    return SharedPtr<T>(control->storage(), control);
+}
+
+/** @copydoc make_shared() */
+template <class T, class Arg1, class Arg2, class Arg3, class Arg4>
+SharedPtr<T> make_shared(const Arg1 &arg1, const Arg2 &arg2, const Arg3 &arg3, const Arg4 &arg4)
+{
+    internal::SharedPtrCombinedControl<T> *control = new internal::SharedPtrCombinedControl<T>(arg1, arg2, arg3, arg4);
+    return SharedPtr<T>(control->storage(), control);
+}
+
 /** Non-member relational operators.
   */
 template <class T, class U>
@@ -292,6 +642,8 @@ bool operator!= (U lhs, const SharedPtr<T> &rhs)
 
 #ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
 using mbed::SharedPtr;
+using mbed::WeakPtr;
+using mbed::make_shared;
 #endif
 
 #endif // __SHAREDPTR_H__
@@ -28,6 +28,9 @@
 #include <stdint.h>
 #include <new>
 #include "platform/mbed_assert.h"
+#ifdef MBED_SINGLETON_STATS_ENABLED
+#include "platform/mbed_stats.h"
+#endif
 #ifdef MBED_CONF_RTOS_PRESENT
 #include "cmsis_os2.h"
 #endif
@@ -96,6 +99,9 @@ struct SingletonPtr {
             singleton_lock();
             if (NULL == _ptr) {
                 _ptr = new (_data) T();
+#ifdef MBED_SINGLETON_STATS_ENABLED
+                mbed_stats_singleton_record((uint32_t)(uintptr_t)_ptr);
+#endif
             }
             singleton_unlock();
         }
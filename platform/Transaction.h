@@ -38,6 +38,8 @@ typedef struct {
     uint32_t event;            /**< Event for a transaction */
     event_callback_t callback; /**< User's callback */
     uint8_t width;             /**< Buffer's word width (8, 16, 32, 64) */
+    uint32_t address;          /**< Target address, for address-oriented buses (I2C); unused otherwise */
+    bool repeated;             /**< Repeated start, do not send stop at end (I2C); unused otherwise */
 } transaction_t;
 
 /** Transaction class defines a transaction.
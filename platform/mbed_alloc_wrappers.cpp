@@ -59,6 +59,39 @@ typedef struct  {
 #define MALLOC_HEADER_SIZE          (sizeof(mbed_heap_overhead_t))
 #define MALLOC_HEADER_PTR(p)        (mbed_heap_overhead_t *)((char *)(p) - MALLOC_HEADER_SIZE)
 #define MALLOC_HEAP_TOTAL_SIZE(p)   (((p)->size) & (~0x1))
+
+/* Smallest free block worth counting when probing for fragmentation and a
+ * cap on the probe's work, to bound the cost of mbed_stats_heap_get */
+#define MBED_HEAP_PROBE_MIN_BLOCK   16
+#define MBED_HEAP_PROBE_MAX_BLOCKS  32
+
+static void update_alloc_size_hist(size_t size)
+{
+    uint32_t bucket = 0;
+    while ((size >> (bucket + 1)) && bucket < MBED_STATS_HEAP_ALLOC_HIST_BUCKETS - 1) {
+        bucket++;
+    }
+    heap_stats.alloc_size_hist[bucket] += 1;
+}
+
+/* Binary search for the largest allocation the heap can currently satisfy,
+ * at most limit bytes. Each trial allocation is freed immediately */
+static uint32_t probe_largest_allocation(uint32_t limit)
+{
+    uint32_t lo = 0;
+    uint32_t hi = limit;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo + 1) / 2;
+        void *p = malloc(mid);
+        if (p != NULL) {
+            free(p);
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return lo;
+}
 #endif
 
 void mbed_stats_heap_get(mbed_stats_heap_t *stats)
@@ -67,9 +100,76 @@ void mbed_stats_heap_get(mbed_stats_heap_t *stats)
     extern uint32_t mbed_heap_size;
     heap_stats.reserved_size = mbed_heap_size;
 
+#ifdef MBED_MEM_TRACING_ENABLED
+    /* raise the trace lock so probe allocations are not traced - taken
+     * before the stats mutex to match the ordering in the wrappers */
+    mbed_mem_trace_lock();
+#endif
     malloc_stats_mutex->lock();
-    memcpy(stats, &heap_stats, sizeof(mbed_stats_heap_t));
+    /* snapshot the application's counters before probing, the probe's own
+     * allocations go through the wrappers and must not leak into them */
+    mbed_stats_heap_t snapshot = heap_stats;
+
+    /* measure the largest allocatable block, then hold successively
+     * largest blocks on a chain to count the sizable free regions */
+    uint32_t block = probe_largest_allocation(mbed_heap_size);
+    uint32_t largest_free_block = block;
+    uint32_t free_block_cnt = 0;
+    void *chain = NULL;
+    while (block >= MBED_HEAP_PROBE_MIN_BLOCK && free_block_cnt < MBED_HEAP_PROBE_MAX_BLOCKS) {
+        void *p = malloc(block);
+        if (p == NULL) {
+            block = probe_largest_allocation(block);
+            continue;
+        }
+        *(void **)p = chain;
+        chain = p;
+        free_block_cnt++;
+    }
+    while (chain != NULL) {
+        void *next = *(void **)chain;
+        free(chain);
+        chain = next;
+    }
+
+    /* undo the probe's effect on the running counters and histogram */
+    heap_stats = snapshot;
+
+    snapshot.largest_free_block = largest_free_block;
+    snapshot.free_block_cnt = free_block_cnt;
+    memcpy(stats, &snapshot, sizeof(mbed_stats_heap_t));
+    malloc_stats_mutex->unlock();
+#ifdef MBED_MEM_TRACING_ENABLED
+    mbed_mem_trace_unlock();
+#endif
+#else
+    memset(stats, 0, sizeof(mbed_stats_heap_t));
+#endif
+}
+
+void mbed_stats_heap_lock(void)
+{
+#ifdef MBED_HEAP_STATS_ENABLED
+    malloc_stats_mutex->lock();
+#endif
+}
+
+void mbed_stats_heap_unlock(void)
+{
+#ifdef MBED_HEAP_STATS_ENABLED
     malloc_stats_mutex->unlock();
+#endif
+}
+
+void mbed_stats_heap_copy(mbed_stats_heap_t *stats)
+{
+#ifdef MBED_HEAP_STATS_ENABLED
+    /* Plain copy of the running counters - no probing, so unlike
+     * mbed_stats_heap_get this is cheap enough for the snapshot's critical
+     * window. largest_free_block and free_block_cnt read 0 here */
+    extern uint32_t mbed_heap_size;
+    memcpy(stats, &heap_stats, sizeof(mbed_stats_heap_t));
+    stats->reserved_size = mbed_heap_size;
 #else
     memset(stats, 0, sizeof(mbed_stats_heap_t));
 #endif
@@ -117,6 +217,7 @@ extern "C" void *malloc_wrapper(struct _reent *r, size_t size, void *caller)
             heap_stats.max_size = heap_stats.current_size;
         }
         heap_stats.overhead_size += MALLOC_HEAP_TOTAL_SIZE(MALLOC_HEADER_PTR(alloc_info)) - size;
+        update_alloc_size_hist(size);
     } else {
         heap_stats.alloc_fail_cnt += 1;
     }
@@ -304,6 +405,7 @@ extern "C" void *malloc_wrapper(size_t size, void *caller)
             heap_stats.max_size = heap_stats.current_size;
         }
         heap_stats.overhead_size += MALLOC_HEAP_TOTAL_SIZE(MALLOC_HEADER_PTR(alloc_info)) - size;
+        update_alloc_size_hist(size);
     } else {
         heap_stats.alloc_fail_cnt += 1;
     }
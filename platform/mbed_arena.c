@@ -0,0 +1,109 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_arena.h"
+
+#include <stdlib.h>
+
+/* Alignment of every returned pointer, enough for long long and double */
+#define MBED_ARENA_ALIGNMENT    8
+
+/* The arena the context-free hook functions allocate from */
+static mbed_arena_t *attached_arena;
+
+void mbed_arena_init(mbed_arena_t *arena, void *buffer, size_t size)
+{
+    arena->buffer = (uint8_t *)buffer;
+    arena->size = size;
+    arena->offset = 0;
+    arena->max_offset = 0;
+    arena->fallback_cnt = 0;
+    arena->fail_cnt = 0;
+    arena->heap_fallback = false;
+    arena->fallback_list = NULL;
+}
+
+void mbed_arena_set_heap_fallback(mbed_arena_t *arena, bool enable)
+{
+    arena->heap_fallback = enable;
+}
+
+void *mbed_arena_alloc(mbed_arena_t *arena, size_t size)
+{
+    size_t offset = (arena->offset + MBED_ARENA_ALIGNMENT - 1) & ~(size_t)(MBED_ARENA_ALIGNMENT - 1);
+    if (size <= arena->size && offset <= arena->size - size) {
+        void *ptr = arena->buffer + offset;
+        arena->offset = offset + size;
+        if (arena->offset > arena->max_offset) {
+            arena->max_offset = arena->offset;
+        }
+        return ptr;
+    }
+
+    if (arena->heap_fallback) {
+        mbed_arena_fallback_node_t *node = (mbed_arena_fallback_node_t *)malloc(sizeof(*node) + size);
+        if (node != NULL) {
+            node->next = arena->fallback_list;
+            arena->fallback_list = node;
+            arena->fallback_cnt += 1;
+            return node + 1;
+        }
+    }
+
+    arena->fail_cnt += 1;
+    return NULL;
+}
+
+void mbed_arena_reset(mbed_arena_t *arena)
+{
+    arena->offset = 0;
+    while (arena->fallback_list != NULL) {
+        mbed_arena_fallback_node_t *node = arena->fallback_list;
+        arena->fallback_list = node->next;
+        free(node);
+    }
+}
+
+size_t mbed_arena_used(const mbed_arena_t *arena)
+{
+    return arena->offset;
+}
+
+size_t mbed_arena_max_used(const mbed_arena_t *arena)
+{
+    return arena->max_offset;
+}
+
+mbed_arena_t *mbed_arena_attach(mbed_arena_t *arena)
+{
+    mbed_arena_t *previous = attached_arena;
+    attached_arena = arena;
+    return previous;
+}
+
+void *mbed_arena_hook_alloc(size_t size)
+{
+    if (attached_arena == NULL) {
+        return NULL;
+    }
+    return mbed_arena_alloc(attached_arena, size);
+}
+
+void mbed_arena_hook_free(void *ptr)
+{
+    (void)ptr;
+}
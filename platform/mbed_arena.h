@@ -0,0 +1,184 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_ARENA_H
+#define MBED_ARENA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_arena arena allocator functions
+ *
+ * A pointer-bump allocator over a fixed caller-supplied buffer, for
+ * small short-lived allocations with a common lifetime - typically one
+ * protocol request or message. Allocation is a few instructions with no
+ * locking, there is no per-allocation free, and the whole arena is
+ * reclaimed in O(1) with mbed_arena_reset. This keeps parsing workloads
+ * off the global heap, avoiding both its mutex and fragmentation.
+ *
+ * Allocations that do not fit can optionally fall back to the heap;
+ * fallback allocations are owned by the arena and freed at reset.
+ *
+ * For C libraries that take context-free malloc/free function pointers
+ * (such as sn_coap_protocol_init), attach the arena and pass the hook
+ * functions:
+ *
+ * @code
+ * static mbed_arena_t coap_arena;
+ * static uint8_t coap_buffer[1024];
+ *
+ * static void *coap_malloc(uint16_t size)
+ * {
+ *     return mbed_arena_hook_alloc(size);
+ * }
+ *
+ * mbed_arena_init(&coap_arena, coap_buffer, sizeof(coap_buffer));
+ * mbed_arena_attach(&coap_arena);
+ * coap = sn_coap_protocol_init(coap_malloc, mbed_arena_hook_free, tx_cb, rx_cb);
+ * ...
+ * // after each response is sent:
+ * mbed_arena_reset(&coap_arena);
+ * @endcode
+ *
+ * @note Synchronization level: Not protected. An arena is meant to be
+ *       used from a single context.
+ * @{
+ */
+
+/** Header chained in front of heap-fallback allocations, sized to keep
+ *  the returned pointer 8-byte aligned. */
+typedef struct mbed_arena_fallback_node {
+    struct mbed_arena_fallback_node *next;
+    void *pad;
+} mbed_arena_fallback_node_t;
+
+/**
+ * An arena allocator instance. Treat the fields as read-only; the stats
+ * fields (max_offset, fallback_cnt, fail_cnt) are cleared by
+ * mbed_arena_init but survive mbed_arena_reset so they cover the whole
+ * run.
+ */
+typedef struct mbed_arena {
+    uint8_t *buffer;        /**< backing buffer */
+    size_t size;            /**< backing buffer size in bytes */
+    size_t offset;          /**< current bump offset */
+    size_t max_offset;      /**< high watermark of the bump offset */
+    uint32_t fallback_cnt;  /**< allocations that fell back to the heap */
+    uint32_t fail_cnt;      /**< allocations that failed outright */
+    bool heap_fallback;     /**< fall back to the heap when the buffer is full */
+    mbed_arena_fallback_node_t *fallback_list;  /**< outstanding heap-fallback allocations */
+} mbed_arena_t;
+
+/**
+ * Initialize an arena over a caller-supplied backing buffer.
+ *
+ * @param arena the arena to initialize.
+ * @param buffer backing storage for allocations.
+ * @param size size of the backing storage in bytes.
+ */
+void mbed_arena_init(mbed_arena_t *arena, void *buffer, size_t size);
+
+/**
+ * Enable or disable falling back to the heap when an allocation does not
+ * fit in the backing buffer. Disabled by default. Fallback allocations
+ * are freed by mbed_arena_reset, not individually.
+ *
+ * @param arena the arena to configure.
+ * @param enable true to fall back to the heap on exhaustion.
+ */
+void mbed_arena_set_heap_fallback(mbed_arena_t *arena, bool enable);
+
+/**
+ * Allocate from the arena. The returned pointer is 8-byte aligned.
+ *
+ * @param arena the arena to allocate from.
+ * @param size number of bytes to allocate.
+ * @return the allocation, or NULL if it does not fit and heap fallback
+ *         is disabled or also fails.
+ */
+void *mbed_arena_alloc(mbed_arena_t *arena, size_t size);
+
+/**
+ * Release every allocation made from the arena. Resetting the bump
+ * offset is O(1); any heap-fallback allocations are freed as well.
+ * All pointers previously returned by mbed_arena_alloc become invalid.
+ *
+ * @param arena the arena to reset.
+ */
+void mbed_arena_reset(mbed_arena_t *arena);
+
+/**
+ * Bytes currently allocated from the backing buffer (excludes heap
+ * fallback).
+ *
+ * @param arena the arena to query.
+ * @return bytes used in the backing buffer.
+ */
+size_t mbed_arena_used(const mbed_arena_t *arena);
+
+/**
+ * High watermark of backing buffer usage since init, for sizing the
+ * buffer from soak-test telemetry.
+ *
+ * @param arena the arena to query.
+ * @return most bytes ever used in the backing buffer.
+ */
+size_t mbed_arena_max_used(const mbed_arena_t *arena);
+
+/**
+ * Make an arena the target of the context-free hook functions below.
+ *
+ * @param arena the arena to attach, or NULL to detach.
+ * @return the previously attached arena, so scoped users can restore it.
+ */
+mbed_arena_t *mbed_arena_attach(mbed_arena_t *arena);
+
+/**
+ * Allocate from the attached arena. Signature-compatible trampoline for
+ * C libraries that take a plain allocation function pointer.
+ *
+ * @param size number of bytes to allocate.
+ * @return the allocation, or NULL if no arena is attached or the
+ *         allocation fails.
+ */
+void *mbed_arena_hook_alloc(size_t size);
+
+/**
+ * Free hook matching mbed_arena_hook_alloc. Arena allocations are only
+ * reclaimed by mbed_arena_reset, so this does nothing.
+ *
+ * @param ptr ignored.
+ */
+void mbed_arena_hook_free(void *ptr);
+
+/** @}*/
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // #ifndef MBED_ARENA_H
@@ -0,0 +1,227 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_boot_measurement.h"
+#include "platform/mbed_toolchain.h"
+#include "device.h"
+
+#include <string.h>
+
+MBED_WEAK uint32_t mbed_boot_flash_generation(void)
+{
+    // 0 means "no proof of flash integrity available"; targets with a
+    // flash write counter override this
+    return 0;
+}
+
+#if DEVICE_FLASH && defined(MBED_CONF_PLATFORM_BOOT_MEASUREMENT_ADDRESS)
+
+#include "hal/flash_api.h"
+
+#define BOOT_MEASUREMENT_MAGIC      0x4D42544DUL
+#define BOOT_MEASUREMENT_ADDRESS    MBED_CONF_PLATFORM_BOOT_MEASUREMENT_ADDRESS
+
+#ifdef MBED_CONF_PLATFORM_BOOT_VERIFY_INTERVAL
+#define BOOT_VERIFY_INTERVAL        MBED_CONF_PLATFORM_BOOT_VERIFY_INTERVAL
+#else
+#define BOOT_VERIFY_INTERVAL        0
+#endif
+
+/* Largest flash page the store path can program in one chunk */
+#define BOOT_MEASUREMENT_CHUNK_MAX  256
+
+/* On-flash record; crc covers every field before it */
+typedef struct boot_measurement_record {
+    uint32_t magic;
+    uint32_t image_address;
+    uint32_t image_size;
+    uint32_t flash_tag;
+    uint32_t boot_count;
+    uint32_t hash_len;
+    uint8_t  hash[MBED_BOOT_MEASUREMENT_HASH_MAX];
+    uint32_t crc;
+} boot_measurement_record_t;
+
+static uint32_t boot_measurement_crc(const void *data, size_t size)
+{
+    const uint8_t *bytes = data;
+    uint32_t crc = 0xFFFFFFFFUL;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= bytes[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & -(crc & 1UL));
+        }
+    }
+    return ~crc;
+}
+
+static bool boot_measurement_read(flash_t *flash, boot_measurement_record_t *record)
+{
+    if (flash_read(flash, BOOT_MEASUREMENT_ADDRESS, (uint8_t *)record, sizeof(*record)) != 0) {
+        return false;
+    }
+    if (record->magic != BOOT_MEASUREMENT_MAGIC ||
+            record->hash_len > MBED_BOOT_MEASUREMENT_HASH_MAX) {
+        return false;
+    }
+    return record->crc == boot_measurement_crc(record, offsetof(boot_measurement_record_t, crc));
+}
+
+static int boot_measurement_write(flash_t *flash, boot_measurement_record_t *record)
+{
+    record->crc = boot_measurement_crc(record, offsetof(boot_measurement_record_t, crc));
+
+    uint32_t page_size = flash_get_page_size(flash);
+    if (page_size > BOOT_MEASUREMENT_CHUNK_MAX) {
+        return -1;
+    }
+
+    if (flash_erase_sector(flash, BOOT_MEASUREMENT_ADDRESS) != 0) {
+        return -1;
+    }
+
+    // Program page by page, padding the tail with the erase value
+    uint8_t chunk[BOOT_MEASUREMENT_CHUNK_MAX];
+    const uint8_t *src = (const uint8_t *)record;
+    uint32_t remaining = sizeof(*record);
+    uint32_t address = BOOT_MEASUREMENT_ADDRESS;
+
+    while (remaining > 0) {
+        uint32_t copy = remaining < page_size ? remaining : page_size;
+        memset(chunk, flash_get_erase_value(flash), page_size);
+        memcpy(chunk, src, copy);
+        if (flash_program_page(flash, address, chunk, page_size) != 0) {
+            return -1;
+        }
+        src += copy;
+        address += page_size;
+        remaining -= copy;
+    }
+    return 0;
+}
+
+bool mbed_boot_measurement_check(uint32_t image_address, uint32_t image_size,
+                                 const uint8_t *expected_hash, uint32_t hash_len)
+{
+    if (expected_hash == NULL || hash_len == 0 ||
+            hash_len > MBED_BOOT_MEASUREMENT_HASH_MAX) {
+        return false;
+    }
+
+    // Without a generation tag there is no proof the flash is unmodified
+    uint32_t generation = mbed_boot_flash_generation();
+    if (generation == 0) {
+        return false;
+    }
+
+    flash_t flash;
+    if (flash_init(&flash) != 0) {
+        return false;
+    }
+
+    bool trusted = false;
+    boot_measurement_record_t record;
+    if (boot_measurement_read(&flash, &record) &&
+            record.image_address == image_address &&
+            record.image_size == image_size &&
+            record.flash_tag == generation &&
+            record.hash_len == hash_len &&
+            memcmp(record.hash, expected_hash, hash_len) == 0) {
+        if (BOOT_VERIFY_INTERVAL > 0) {
+            // Periodic paranoia: fail the check every N trusted boots so the
+            // caller re-verifies in full; counting costs one sector rewrite
+            // per boot
+            if (record.boot_count + 1 >= (uint32_t)BOOT_VERIFY_INTERVAL) {
+                trusted = false;
+            } else {
+                record.boot_count++;
+                trusted = (boot_measurement_write(&flash, &record) == 0);
+            }
+        } else {
+            trusted = true;
+        }
+    }
+
+    flash_free(&flash);
+    return trusted;
+}
+
+int mbed_boot_measurement_store(uint32_t image_address, uint32_t image_size,
+                                const uint8_t *hash, uint32_t hash_len)
+{
+    if (hash == NULL || hash_len == 0 ||
+            hash_len > MBED_BOOT_MEASUREMENT_HASH_MAX) {
+        return -1;
+    }
+
+    flash_t flash;
+    if (flash_init(&flash) != 0) {
+        return -1;
+    }
+
+    boot_measurement_record_t record;
+    memset(&record, 0, sizeof(record));
+    record.magic = BOOT_MEASUREMENT_MAGIC;
+    record.image_address = image_address;
+    record.image_size = image_size;
+    record.flash_tag = mbed_boot_flash_generation();
+    record.boot_count = 0;
+    record.hash_len = hash_len;
+    memcpy(record.hash, hash, hash_len);
+
+    int ret = boot_measurement_write(&flash, &record);
+    flash_free(&flash);
+    return ret;
+}
+
+void mbed_boot_measurement_invalidate(void)
+{
+    flash_t flash;
+    if (flash_init(&flash) != 0) {
+        return;
+    }
+    flash_erase_sector(&flash, BOOT_MEASUREMENT_ADDRESS);
+    flash_free(&flash);
+}
+
+#else /* DEVICE_FLASH && MBED_CONF_PLATFORM_BOOT_MEASUREMENT_ADDRESS */
+
+bool mbed_boot_measurement_check(uint32_t image_address, uint32_t image_size,
+                                 const uint8_t *expected_hash, uint32_t hash_len)
+{
+    (void)image_address;
+    (void)image_size;
+    (void)expected_hash;
+    (void)hash_len;
+    return false;
+}
+
+int mbed_boot_measurement_store(uint32_t image_address, uint32_t image_size,
+                                const uint8_t *hash, uint32_t hash_len)
+{
+    (void)image_address;
+    (void)image_size;
+    (void)hash;
+    (void)hash_len;
+    return -1;
+}
+
+void mbed_boot_measurement_invalidate(void)
+{
+}
+
+#endif /* DEVICE_FLASH && MBED_CONF_PLATFORM_BOOT_MEASUREMENT_ADDRESS */
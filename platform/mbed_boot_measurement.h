@@ -0,0 +1,135 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_BOOT_MEASUREMENT_H
+#define MBED_BOOT_MEASUREMENT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_boot_measurement measured boot cache functions
+ *
+ * Re-hashing the whole application image dominates secure boot time. A
+ * bootloader that has fully verified an image once can record the
+ * measurement here, bound to a flash content generation tag provided by
+ * the target; on later boots, while the tag proves the flash has not been
+ * written, the cached measurement stands in for the re-hash.
+ *
+ * The security property rests entirely on the generation tag: it must
+ * change whenever application flash may have been modified. Targets with
+ * a hardware flash write counter, or a bootloader that owns all flash
+ * write paths and bumps a counter around them, provide the tag by
+ * overriding mbed_boot_flash_generation(). The default implementation
+ * returns 0, which this module treats as "no proof available" - every
+ * check then fails and the bootloader falls back to full verification,
+ * so a missing or lazy override costs time, never integrity.
+ *
+ * For the paranoid, MBED_CONF_PLATFORM_BOOT_VERIFY_INTERVAL forces a
+ * full re-verification every N trusted boots. Counting boots rewrites
+ * the record sector once per boot, so weigh the interval against flash
+ * endurance; the default of 0 counts nothing and rewrites only when a
+ * new measurement is stored.
+ *
+ * The record lives in the flash sector named by
+ * MBED_CONF_PLATFORM_BOOT_MEASUREMENT_ADDRESS, which the bootloader's
+ * layout must reserve; the feature compiles out while the address is
+ * unset (null).
+ *
+ * @note Synchronization level: Not protected
+ * @{
+ */
+
+/** Longest digest the record can hold (SHA-512) */
+#define MBED_BOOT_MEASUREMENT_HASH_MAX 64
+
+/**
+ * Check whether a cached measurement lets the boot skip full verification.
+ *
+ * Succeeds only when a well-formed record exists for exactly this image
+ * address and size, its digest equals the expected digest from the image
+ * header, its generation tag matches mbed_boot_flash_generation(), and
+ * the configured verify interval has not elapsed.
+ *
+ * @param image_address start of the application image in flash.
+ * @param image_size size of the image in bytes.
+ * @param expected_hash digest the image header claims, which the caller
+ *        has authenticated (for example by signature).
+ * @param hash_len digest length in bytes, at most
+ *        MBED_BOOT_MEASUREMENT_HASH_MAX.
+ * @return true if the image is proven unchanged since its last full
+ *         verification and the boot may proceed without re-hashing;
+ *         false if the caller must verify in full.
+ */
+bool mbed_boot_measurement_check(uint32_t image_address, uint32_t image_size,
+                                 const uint8_t *expected_hash, uint32_t hash_len);
+
+/**
+ * Record a measurement after a successful full verification.
+ *
+ * Stores the digest with the current flash generation tag so later boots
+ * can pass mbed_boot_measurement_check. Call only after the image hash
+ * has been computed over flash contents and authenticated.
+ *
+ * @param image_address start of the application image in flash.
+ * @param image_size size of the image in bytes.
+ * @param hash the verified digest of the image.
+ * @param hash_len digest length in bytes, at most
+ *        MBED_BOOT_MEASUREMENT_HASH_MAX.
+ * @return 0 on success, -1 on parameter or flash programming failure.
+ */
+int mbed_boot_measurement_store(uint32_t image_address, uint32_t image_size,
+                                const uint8_t *hash, uint32_t hash_len);
+
+/**
+ * Erase the cached measurement, forcing full verification next boot.
+ *
+ * Call before handing flash write access to anything outside the
+ * bootloader's control (for example before applying a firmware update).
+ */
+void mbed_boot_measurement_invalidate(void);
+
+/**
+ * Current flash content generation tag.
+ *
+ * Must return a value that changes whenever application flash may have
+ * been written, and never otherwise; 0 is reserved for "unsupported".
+ * The default implementation returns 0, disabling the cache. Targets
+ * with a hardware flash write counter, or bootloaders that count their
+ * own writes in durable storage, override this.
+ *
+ * @return the generation tag, or 0 when no proof of flash integrity is
+ *         available.
+ */
+uint32_t mbed_boot_flash_generation(void);
+
+/** @}*/
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // #ifndef MBED_BOOT_MEASUREMENT_H
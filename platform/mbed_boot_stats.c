@@ -0,0 +1,161 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_stats.h"
+#include "mbed_assert.h"
+#include "mbed_critical.h"
+#include "cmsis.h"
+#include <string.h>
+
+#if defined(MBED_BOOT_STATS_ENABLED) || defined(MBED_CTOR_STATS_ENABLED)
+
+static uint32_t boot_timestamp(void)
+{
+#if defined(__CORTEX_M) && (__CORTEX_M >= 3)
+    /* Runs before the tickers are up, so the DWT cycle counter is the only
+     * usable clock; start it on the first milestone unless the target's
+     * reset handler started it already */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    return DWT->CYCCNT;
+#else
+    return 0;
+#endif
+}
+
+#endif // MBED_BOOT_STATS_ENABLED || MBED_CTOR_STATS_ENABLED
+
+#if defined(MBED_BOOT_STATS_ENABLED)
+static mbed_stats_boot_t boot_stats;
+#endif
+
+void mbed_boot_milestone(mbed_boot_milestone_t milestone)
+{
+#if defined(MBED_BOOT_STATS_ENABLED)
+    if (milestone >= MBED_BOOT_MILESTONE_COUNT ||
+            (boot_stats.captured & (1UL << milestone))) {
+        return;
+    }
+    boot_stats.timestamp[milestone] = boot_timestamp();
+    boot_stats.captured |= 1UL << milestone;
+#else
+    (void)milestone;
+#endif
+}
+
+void mbed_stats_boot_get(mbed_stats_boot_t *stats)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, sizeof(mbed_stats_boot_t));
+
+#if defined(MBED_BOOT_STATS_ENABLED)
+    core_util_critical_section_enter();
+    memcpy(stats, &boot_stats, sizeof(mbed_stats_boot_t));
+    core_util_critical_section_exit();
+#endif
+}
+
+#if defined(MBED_CTOR_STATS_ENABLED)
+
+static mbed_stats_ctor_t ctor_stats[MBED_STATS_CTOR_TABLE_SIZE];
+static size_t ctor_count;
+
+#if defined(__GNUC__) && !defined(__CC_ARM) && !defined(__ARMCC_VERSION) && !defined(__ICCARM__)
+
+/* Init array bounds and libc _init, as used by __libc_init_array */
+extern void (*__preinit_array_start[])(void);
+extern void (*__preinit_array_end[])(void);
+extern void (*__init_array_start[])(void);
+extern void (*__init_array_end[])(void);
+extern void _init(void);
+
+static void ctor_profile_run(void (* const *start)(void), void (* const *end)(void))
+{
+    for (void (* const *fn)(void) = start; fn < end; fn++) {
+        uint32_t begin = boot_timestamp();
+        (*fn)();
+        uint32_t elapsed = boot_timestamp() - begin;
+        if (ctor_count < MBED_STATS_CTOR_TABLE_SIZE) {
+            ctor_stats[ctor_count].address = (uint32_t)(uintptr_t)*fn;
+            ctor_stats[ctor_count].cycles = elapsed;
+            ctor_count++;
+        }
+    }
+}
+
+void mbed_init_array_profiled(void)
+{
+    /* Same sequence as __libc_init_array, with each constructor timed */
+    ctor_profile_run(__preinit_array_start, __preinit_array_end);
+    _init();
+    ctor_profile_run(__init_array_start, __init_array_end);
+}
+
+#endif // __GNUC__
+
+#endif // MBED_CTOR_STATS_ENABLED
+
+size_t mbed_stats_ctor_get_each(mbed_stats_ctor_t *stats, size_t count)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, count * sizeof(mbed_stats_ctor_t));
+    size_t i = 0;
+
+#if defined(MBED_CTOR_STATS_ENABLED)
+    for (; i < count && i < ctor_count; i++) {
+        stats[i] = ctor_stats[i];
+    }
+#endif
+    return i;
+}
+
+#if defined(MBED_SINGLETON_STATS_ENABLED)
+static uint32_t singleton_stats[MBED_STATS_CTOR_TABLE_SIZE];
+static size_t singleton_count;
+#endif
+
+void mbed_stats_singleton_record(uint32_t address)
+{
+#if defined(MBED_SINGLETON_STATS_ENABLED)
+    core_util_critical_section_enter();
+    if (singleton_count < MBED_STATS_CTOR_TABLE_SIZE) {
+        singleton_stats[singleton_count++] = address;
+    }
+    core_util_critical_section_exit();
+#else
+    (void)address;
+#endif
+}
+
+size_t mbed_stats_singleton_get_each(uint32_t *addresses, size_t count)
+{
+    MBED_ASSERT(addresses != NULL);
+    memset(addresses, 0, count * sizeof(uint32_t));
+    size_t i = 0;
+
+#if defined(MBED_SINGLETON_STATS_ENABLED)
+    core_util_critical_section_enter();
+    for (; i < count && i < singleton_count; i++) {
+        addresses[i] = singleton_stats[i];
+    }
+    core_util_critical_section_exit();
+#endif
+    return i;
+}
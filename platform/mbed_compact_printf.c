@@ -0,0 +1,448 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_compact_printf.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef MBED_CONF_PLATFORM_COMPACT_PRINTF_ENABLE_FLOATING_POINT
+#define MBED_CONF_PLATFORM_COMPACT_PRINTF_ENABLE_FLOATING_POINT 1
+#endif
+
+/* Longest conversion is a 64-bit value in octal (22 digits) */
+#define CONV_BUF_SIZE 22
+
+/* Fractional digits are generated one at a time into the conversion
+ * buffer, so the precision of %f is capped */
+#define FLOAT_MAX_PRECISION 9
+
+typedef struct {
+    mbed_compact_printf_sink_t sink;
+    void *ctx;
+    int count;
+} formatter_t;
+
+static void formatter_out(formatter_t *f, const char *buffer, size_t length)
+{
+    f->sink(f->ctx, buffer, length);
+    f->count += length;
+}
+
+static void formatter_pad(formatter_t *f, char pad, int count)
+{
+    while (count-- > 0) {
+        formatter_out(f, &pad, 1);
+    }
+}
+
+/* Convert an unsigned value to digits, returning the length */
+static size_t format_unsigned(char *buffer, unsigned long long value, unsigned int base, bool upper)
+{
+    const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    size_t length = 0;
+    do {
+        buffer[length++] = digits[value % base];
+        value /= base;
+    } while (value > 0);
+
+    /* digits were generated least significant first */
+    for (size_t i = 0; i < length / 2; i++) {
+        char tmp = buffer[i];
+        buffer[i] = buffer[length - 1 - i];
+        buffer[length - 1 - i] = tmp;
+    }
+    return length;
+}
+
+/* Emit an optional sign prefix and converted digits honoring field
+ * width, left alignment and zero padding */
+static void emit_number(formatter_t *f, const char *prefix, size_t prefix_length,
+                        const char *digits, size_t digits_length,
+                        int width, bool left, bool zero)
+{
+    int padding = width - (int)(prefix_length + digits_length);
+    if (!left && !zero) {
+        formatter_pad(f, ' ', padding);
+    }
+    formatter_out(f, prefix, prefix_length);
+    if (!left && zero) {
+        formatter_pad(f, '0', padding);
+    }
+    formatter_out(f, digits, digits_length);
+    if (left) {
+        formatter_pad(f, ' ', padding);
+    }
+}
+
+int mbed_compact_vformat(mbed_compact_printf_sink_t sink, void *ctx, const char *format, va_list args)
+{
+    formatter_t f;
+    f.sink = sink;
+    f.ctx = ctx;
+    f.count = 0;
+
+    const char *str = format;
+    while (*str) {
+        if (*str != '%') {
+            const char *start = str;
+            while (*str && *str != '%') {
+                str++;
+            }
+            formatter_out(&f, start, str - start);
+            continue;
+        }
+        str++;
+
+        /* flags */
+        bool left = false;
+        bool zero = false;
+        bool plus = false;
+        bool space = false;
+        for (bool parsing = true; parsing; str++) {
+            switch (*str) {
+                case '-':
+                    left = true;
+                    break;
+                case '0':
+                    zero = true;
+                    break;
+                case '+':
+                    plus = true;
+                    break;
+                case ' ':
+                    space = true;
+                    break;
+                default:
+                    parsing = false;
+                    str--;
+                    break;
+            }
+        }
+
+        /* field width */
+        int width = 0;
+        if (*str == '*') {
+            width = va_arg(args, int);
+            if (width < 0) {
+                left = true;
+                width = -width;
+            }
+            str++;
+        } else {
+            while (*str >= '0' && *str <= '9') {
+                width = width * 10 + (*str++ - '0');
+            }
+        }
+
+        /* precision */
+        int precision = -1;
+        if (*str == '.') {
+            str++;
+            if (*str == '*') {
+                precision = va_arg(args, int);
+                str++;
+            } else {
+                precision = 0;
+                while (*str >= '0' && *str <= '9') {
+                    precision = precision * 10 + (*str++ - '0');
+                }
+            }
+        }
+
+        /* length modifier: 0 = int, 1 = long, 2 = long long, -1 = short,
+         * -2 = char. Short and char arguments arrive promoted to int and
+         * are narrowed back after the va_arg */
+        int length_mod = 0;
+        if (*str == 'l') {
+            length_mod = 1;
+            str++;
+            if (*str == 'l') {
+                length_mod = 2;
+                str++;
+            }
+        } else if (*str == 'h') {
+            length_mod = -1;
+            str++;
+            if (*str == 'h') {
+                length_mod = -2;
+                str++;
+            }
+        } else if (*str == 'z' || *str == 't') {
+            length_mod = 1;
+            str++;
+        }
+
+        char conversion = *str++;
+        char buffer[CONV_BUF_SIZE + 1 + FLOAT_MAX_PRECISION];
+        switch (conversion) {
+            case 'd':
+            case 'i': {
+                long long value;
+                if (length_mod == 2) {
+                    value = va_arg(args, long long);
+                } else if (length_mod == 1) {
+                    value = va_arg(args, long);
+                } else if (length_mod == -1) {
+                    value = (short)va_arg(args, int);
+                } else if (length_mod == -2) {
+                    value = (signed char)va_arg(args, int);
+                } else {
+                    value = va_arg(args, int);
+                }
+                const char *prefix = "";
+                size_t prefix_length = 0;
+                unsigned long long magnitude = (unsigned long long)value;
+                if (value < 0) {
+                    prefix = "-";
+                    prefix_length = 1;
+                    magnitude = -(unsigned long long)value;
+                } else if (plus) {
+                    prefix = "+";
+                    prefix_length = 1;
+                } else if (space) {
+                    prefix = " ";
+                    prefix_length = 1;
+                }
+                size_t length = format_unsigned(buffer, magnitude, 10, false);
+                emit_number(&f, prefix, prefix_length, buffer, length, width, left, zero);
+                break;
+            }
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o': {
+                unsigned long long value;
+                if (length_mod == 2) {
+                    value = va_arg(args, unsigned long long);
+                } else if (length_mod == 1) {
+                    value = va_arg(args, unsigned long);
+                } else if (length_mod == -1) {
+                    value = (unsigned short)va_arg(args, unsigned int);
+                } else if (length_mod == -2) {
+                    value = (unsigned char)va_arg(args, unsigned int);
+                } else {
+                    value = va_arg(args, unsigned int);
+                }
+                unsigned int base = (conversion == 'u') ? 10 : (conversion == 'o') ? 8 : 16;
+                size_t length = format_unsigned(buffer, value, base, conversion == 'X');
+                emit_number(&f, "", 0, buffer, length, width, left, zero);
+                break;
+            }
+            case 'p': {
+                uintptr_t value = (uintptr_t)va_arg(args, void *);
+                size_t length = format_unsigned(buffer, value, 16, false);
+                emit_number(&f, "0x", 2, buffer, length, width, left, zero);
+                break;
+            }
+            case 'c': {
+                char value = (char)va_arg(args, int);
+                emit_number(&f, "", 0, &value, 1, width, left, false);
+                break;
+            }
+            case 's': {
+                const char *value = va_arg(args, const char *);
+                if (!value) {
+                    value = "(null)";
+                }
+                size_t length = 0;
+                while (value[length] && (precision < 0 || length < (size_t)precision)) {
+                    length++;
+                }
+                emit_number(&f, "", 0, value, length, width, left, false);
+                break;
+            }
+#if MBED_CONF_PLATFORM_COMPACT_PRINTF_ENABLE_FLOATING_POINT
+            case 'f':
+            case 'F': {
+                double value = va_arg(args, double);
+                const char *prefix = "";
+                size_t prefix_length = 0;
+                if (value < 0) {
+                    prefix = "-";
+                    prefix_length = 1;
+                    value = -value;
+                } else if (plus) {
+                    prefix = "+";
+                    prefix_length = 1;
+                } else if (space) {
+                    prefix = " ";
+                    prefix_length = 1;
+                }
+                if (value != value) {
+                    emit_number(&f, prefix, prefix_length, "nan", 3, width, left, false);
+                    break;
+                }
+                if ((value != 0 && value == value / 2) || value >= 18446744073709551615.0) {
+                    /* infinite, or beyond what fits an unsigned 64-bit
+                     * integer part */
+                    emit_number(&f, prefix, prefix_length, "inf", 3, width, left, false);
+                    break;
+                }
+                int float_precision = (precision < 0) ? 6 : precision;
+                if (float_precision > FLOAT_MAX_PRECISION) {
+                    float_precision = FLOAT_MAX_PRECISION;
+                }
+                double rounding = 0.5;
+                for (int i = 0; i < float_precision; i++) {
+                    rounding /= 10.0;
+                }
+                value += rounding;
+                unsigned long long integer_part = (unsigned long long)value;
+                size_t length = format_unsigned(buffer, integer_part, 10, false);
+                if (float_precision > 0) {
+                    buffer[length++] = '.';
+                    double fraction = value - (double)integer_part;
+                    for (int i = 0; i < float_precision; i++) {
+                        fraction *= 10.0;
+                        int digit = (int)fraction;
+                        buffer[length++] = (char)('0' + digit);
+                        fraction -= digit;
+                    }
+                }
+                emit_number(&f, prefix, prefix_length, buffer, length, width, left, zero);
+                break;
+            }
+#endif
+            case '%':
+                formatter_out(&f, "%", 1);
+                break;
+            case '\0':
+                return f.count;
+            default:
+                /* unsupported conversion - reproduce it literally so the
+                 * output shows what was asked for */
+                formatter_out(&f, "%", 1);
+                formatter_out(&f, &conversion, 1);
+                break;
+        }
+    }
+    return f.count;
+}
+
+int mbed_compact_format(mbed_compact_printf_sink_t sink, void *ctx, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int count = mbed_compact_vformat(sink, ctx, format, args);
+    va_end(args);
+    return count;
+}
+
+#if MBED_CONF_PLATFORM_STDIO_COMPACT_PRINTF
+
+#include <stdio.h>
+#include "platform/mbed_retarget.h"
+
+/* Replacements for the C library's printf family. Defining the symbols
+ * here makes the linker pick them over the library versions, dropping
+ * the library formatter from the image. Console output goes straight
+ * down the retarget FileHandle::write path, bypassing C library stream
+ * locking and buffering */
+
+static void file_sink(void *ctx, const char *buffer, size_t length)
+{
+    FILE *stream = (FILE *)ctx;
+    if (stream == stdout) {
+        write(STDOUT_FILENO, buffer, length);
+    } else if (stream == stderr) {
+        write(STDERR_FILENO, buffer, length);
+    } else {
+        fwrite(buffer, 1, length, stream);
+    }
+}
+
+typedef struct {
+    char *buffer;
+    size_t size;
+    size_t pos;
+} buffer_sink_ctx_t;
+
+static void buffer_sink(void *ctx, const char *buffer, size_t length)
+{
+    buffer_sink_ctx_t *out = (buffer_sink_ctx_t *)ctx;
+    size_t space = (out->pos < out->size) ? out->size - out->pos : 0;
+    if (length < space) {
+        space = length;
+    }
+    memcpy(out->buffer + out->pos, buffer, space);
+    out->pos += space;
+}
+
+int vprintf(const char *format, va_list args)
+{
+    return mbed_compact_vformat(file_sink, stdout, format, args);
+}
+
+int printf(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int count = mbed_compact_vformat(file_sink, stdout, format, args);
+    va_end(args);
+    return count;
+}
+
+int vfprintf(FILE *stream, const char *format, va_list args)
+{
+    return mbed_compact_vformat(file_sink, stream, format, args);
+}
+
+int fprintf(FILE *stream, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int count = mbed_compact_vformat(file_sink, stream, format, args);
+    va_end(args);
+    return count;
+}
+
+int vsnprintf(char *s, size_t n, const char *format, va_list args)
+{
+    buffer_sink_ctx_t ctx = { s, (n > 0) ? n - 1 : 0, 0 };
+    int count = mbed_compact_vformat(buffer_sink, &ctx, format, args);
+    if (n > 0) {
+        s[ctx.pos] = '\0';
+    }
+    return count;
+}
+
+int snprintf(char *s, size_t n, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int count = vsnprintf(s, n, format, args);
+    va_end(args);
+    return count;
+}
+
+int vsprintf(char *s, const char *format, va_list args)
+{
+    return vsnprintf(s, (size_t)-1, format, args);
+}
+
+int sprintf(char *s, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int count = vsnprintf(s, (size_t)-1, format, args);
+    va_end(args);
+    return count;
+}
+
+#endif // MBED_CONF_PLATFORM_STDIO_COMPACT_PRINTF
@@ -0,0 +1,87 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_COMPACT_PRINTF_H
+#define MBED_COMPACT_PRINTF_H
+
+#include <stdarg.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_compact_printf compact printf functions
+ *
+ * A minimal formatted-output engine that never allocates from the heap
+ * and is a fraction of the flash cost of the C library's printf.
+ *
+ * Supported conversions: d, i, u, x, X, o, p, c, s and %% with the
+ * '-', '0', '+' and ' ' flags, field width (including *), precision
+ * (including *) and the h, hh, l, ll, z and t length modifiers. f and F
+ * print fixed-point decimal (no exponent forms), round halfway values
+ * away from zero rather than to even, and can be compiled out with
+ * platform.compact-printf-enable-floating-point.
+ *
+ * Setting platform.stdio-compact-printf replaces the C library's printf
+ * family with this engine, writing console output directly down the
+ * retarget FileHandle::write path.
+ * @{
+ */
+
+/** Output sink for the compact formatting engine
+ *
+ *  Called with each run of formatted characters. The buffer is not
+ *  NUL-terminated and is only valid for the duration of the call.
+ *
+ *  @param ctx      Opaque pointer passed through from the format call
+ *  @param buffer   Characters to consume
+ *  @param length   Number of characters in buffer
+ */
+typedef void (*mbed_compact_printf_sink_t)(void *ctx, const char *buffer, size_t length);
+
+/** Format a string into a sink without heap allocation
+ *
+ *  @param sink     Sink receiving the formatted output
+ *  @param ctx      Opaque pointer passed to every sink call
+ *  @param format   printf-style format string
+ *  @param args     Arguments for the format string
+ *  @return         Number of characters produced
+ */
+int mbed_compact_vformat(mbed_compact_printf_sink_t sink, void *ctx, const char *format, va_list args);
+
+/** Format a string into a sink without heap allocation
+ *
+ *  @param sink     Sink receiving the formatted output
+ *  @param ctx      Opaque pointer passed to every sink call
+ *  @param format   printf-style format string
+ *  @return         Number of characters produced
+ */
+int mbed_compact_format(mbed_compact_printf_sink_t sink, void *ctx, const char *format, ...);
+
+/**@}*/
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
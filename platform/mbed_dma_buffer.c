@@ -0,0 +1,87 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_dma_buffer.h"
+#include "platform/mbed_assert.h"
+#include "cmsis.h"
+
+#include <stdlib.h>
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+#define DMA_BUF_DCACHE  1
+#else
+#define DMA_BUF_DCACHE  0
+#endif
+
+void *mbed_dma_buf_alloc(size_t size)
+{
+    // Pad to a whole number of lines so invalidation owns its last line
+    size = (size + MBED_DMA_BUF_ALIGNMENT - 1) & ~(size_t)(MBED_DMA_BUF_ALIGNMENT - 1);
+
+    // Over-allocate by one alignment granule plus room for the raw
+    // pointer, which is stashed directly below the aligned block for free
+    uint8_t *raw = malloc(size + MBED_DMA_BUF_ALIGNMENT + sizeof(void *));
+    if (raw == NULL) {
+        return NULL;
+    }
+
+    uintptr_t aligned = ((uintptr_t)raw + sizeof(void *) + MBED_DMA_BUF_ALIGNMENT - 1) &
+                        ~(uintptr_t)(MBED_DMA_BUF_ALIGNMENT - 1);
+    ((void **)aligned)[-1] = raw;
+    return (void *)aligned;
+}
+
+void mbed_dma_buf_free(void *buf)
+{
+    if (buf != NULL) {
+        free(((void **)buf)[-1]);
+    }
+}
+
+void mbed_dma_buf_tx_prepare(const void *buf, size_t len)
+{
+#if DMA_BUF_DCACHE
+    SCB_CleanDCache_by_Addr((uint32_t *)(uintptr_t)buf, (int32_t)len);
+#else
+    (void)buf;
+    (void)len;
+#endif
+}
+
+void mbed_dma_buf_rx_prepare(void *buf, size_t len)
+{
+#if DMA_BUF_DCACHE
+    // Clean first so no dirty line can be written back over the
+    // device's data while the transfer is in flight
+    MBED_ASSERT(((uintptr_t)buf & (MBED_DMA_BUF_ALIGNMENT - 1)) == 0);
+    SCB_CleanInvalidateDCache_by_Addr((uint32_t *)buf, (int32_t)len);
+#else
+    (void)buf;
+    (void)len;
+#endif
+}
+
+void mbed_dma_buf_rx_complete(void *buf, size_t len)
+{
+#if DMA_BUF_DCACHE
+    MBED_ASSERT(((uintptr_t)buf & (MBED_DMA_BUF_ALIGNMENT - 1)) == 0);
+    SCB_InvalidateDCache_by_Addr((uint32_t *)buf, (int32_t)len);
+#else
+    (void)buf;
+    (void)len;
+#endif
+}
@@ -0,0 +1,130 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_DMA_BUFFER_H
+#define MBED_DMA_BUFFER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "device.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_dma_buffer DMA buffer functions
+ *
+ * Buffers shared between the CPU and a bus-master peripheral (Ethernet,
+ * SDIO, SPI or QSPI with DMA) on cores with a data cache need cache
+ * maintenance scoped to the transfer direction: lines must be cleaned
+ * before the device reads memory the CPU wrote, and invalidated before
+ * the CPU reads memory the device wrote. For the invalidating operations
+ * to be safe the buffer must own every cache line it touches, which
+ * means cache-line alignment and a length that is a whole number of
+ * lines - otherwise the operation discards or resurrects neighbouring
+ * data that happens to share a line.
+ *
+ * This module provides a heap allocator that guarantees that ownership
+ * and maintenance helpers named after the transfer phase rather than the
+ * cache operation, so drivers do not need to reason about clean versus
+ * invalidate. On cores without a data cache the allocator degrades to a
+ * natural-alignment malloc and the maintenance helpers compile to
+ * nothing, so portable driver code can call them unconditionally.
+ *
+ * @note Synchronization level: Interrupt safe
+ * @{
+ */
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+/** Alignment and size granule of DMA buffers: the data cache line size */
+#define MBED_DMA_BUF_ALIGNMENT  __SCB_DCACHE_LINE_SIZE
+#else
+/** Alignment and size granule of DMA buffers when there is no data cache */
+#define MBED_DMA_BUF_ALIGNMENT  8
+#endif
+
+/**
+ * Allocate a buffer suitable for DMA from the heap.
+ *
+ * The returned pointer is aligned to MBED_DMA_BUF_ALIGNMENT and the
+ * allocation is padded to a whole number of cache lines, so the
+ * invalidating maintenance helpers never touch memory outside the
+ * buffer.
+ *
+ * @param size number of bytes to allocate.
+ * @return the allocation, or NULL on failure.
+ */
+void *mbed_dma_buf_alloc(size_t size);
+
+/**
+ * Free a buffer allocated with mbed_dma_buf_alloc.
+ *
+ * @param buf the buffer to free, may be NULL.
+ */
+void mbed_dma_buf_free(void *buf);
+
+/**
+ * Prepare a buffer the CPU has written for reading by a device.
+ *
+ * Cleans the buffer's cache lines to memory. Call after filling a
+ * transmit buffer and before starting the transfer. Any alignment is
+ * accepted since cleaning loses no data.
+ *
+ * @param buf start of the region the device will read.
+ * @param len length of the region in bytes.
+ */
+void mbed_dma_buf_tx_prepare(const void *buf, size_t len);
+
+/**
+ * Prepare a buffer for writing by a device.
+ *
+ * Cleans and invalidates the buffer's cache lines so no dirty line can
+ * be evicted over the device's data mid-transfer. Call before posting a
+ * receive buffer to the device. The buffer must be cache-line aligned
+ * and own every line it touches, as mbed_dma_buf_alloc guarantees.
+ *
+ * @param buf start of the region the device will write.
+ * @param len length of the region in bytes.
+ */
+void mbed_dma_buf_rx_prepare(void *buf, size_t len);
+
+/**
+ * Make a buffer a device has written visible to the CPU.
+ *
+ * Invalidates the buffer's cache lines, discarding anything fetched
+ * speculatively while the transfer ran. Call after the transfer
+ * completes and before reading the data. The same alignment rules as
+ * for mbed_dma_buf_rx_prepare apply.
+ *
+ * @param buf start of the region the device wrote.
+ * @param len length of the region in bytes.
+ */
+void mbed_dma_buf_rx_complete(void *buf, size_t len);
+
+/** @}*/
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // #ifndef MBED_DMA_BUFFER_H
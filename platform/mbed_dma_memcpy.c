@@ -0,0 +1,147 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_dma_memcpy.h"
+
+#if DEVICE_DMA_MEMCPY
+
+#include "platform/mbed_dma_buffer.h"
+#include "platform/mbed_critical.h"
+#include "hal/dma_memcpy_api.h"
+
+#ifdef MBED_CONF_PLATFORM_DMA_MEMCPY_THRESHOLD
+#define DMA_MEMCPY_THRESHOLD MBED_CONF_PLATFORM_DMA_MEMCPY_THRESHOLD
+#else
+#define DMA_MEMCPY_THRESHOLD 512
+#endif
+
+/* Concurrent asynchronous transfers tracked for completion-side cache
+ * maintenance; more fall back to software, they do not queue */
+#define DMA_MEMCPY_MAX_PENDING 4
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+/* With a data cache the destination is invalidated after the transfer,
+ * so it must own every cache line it touches */
+static uint8_t dma_dst_maintainable(const void *dst, size_t len)
+{
+    return (((uintptr_t)dst & (MBED_DMA_BUF_ALIGNMENT - 1)) == 0) &&
+           ((len & (MBED_DMA_BUF_ALIGNMENT - 1)) == 0);
+}
+#else
+static uint8_t dma_dst_maintainable(const void *dst, size_t len)
+{
+    (void)dst;
+    (void)len;
+    return 1;
+}
+#endif
+
+void *mbed_dma_memcpy(void *dst, const void *src, size_t len)
+{
+    if (len < DMA_MEMCPY_THRESHOLD || !dma_dst_maintainable(dst, len)) {
+        return memcpy(dst, src, len);
+    }
+
+    mbed_dma_buf_tx_prepare(src, len);
+    mbed_dma_buf_rx_prepare(dst, len);
+    int channel = dma_memcpy_start(dst, src, len, NULL, 0);
+    if (channel == DMA_ERROR_OUT_OF_CHANNELS) {
+        return memcpy(dst, src, len);
+    }
+    while (dma_memcpy_active(channel)) {
+        /* spin-join: the bytes move on the memory buses, not through us */
+    }
+    mbed_dma_buf_rx_complete(dst, len);
+    return dst;
+}
+
+void *mbed_dma_memset(void *dst, int value, size_t len)
+{
+    if (len < DMA_MEMCPY_THRESHOLD || !dma_dst_maintainable(dst, len)) {
+        return memset(dst, value, len);
+    }
+
+    mbed_dma_buf_rx_prepare(dst, len);
+    int channel = dma_memset_start(dst, (uint8_t)value, len, NULL, 0);
+    if (channel == DMA_ERROR_OUT_OF_CHANNELS) {
+        return memset(dst, value, len);
+    }
+    while (dma_memcpy_active(channel)) {
+    }
+    mbed_dma_buf_rx_complete(dst, len);
+    return dst;
+}
+
+typedef struct {
+    void *dst;
+    size_t len;
+    void (*done)(uint32_t id);
+    uint32_t id;
+    uint8_t in_use;
+} dma_memcpy_pending_t;
+
+static dma_memcpy_pending_t dma_memcpy_pending[DMA_MEMCPY_MAX_PENDING];
+
+static void dma_memcpy_async_handler(uint32_t slot)
+{
+    dma_memcpy_pending_t *pending = &dma_memcpy_pending[slot];
+    void (*done)(uint32_t id) = pending->done;
+    uint32_t id = pending->id;
+
+    mbed_dma_buf_rx_complete(pending->dst, pending->len);
+    pending->in_use = 0;
+    if (done) {
+        done(id);
+    }
+}
+
+void mbed_dma_memcpy_async(void *dst, const void *src, size_t len, void (*done)(uint32_t id), uint32_t id)
+{
+    if (len >= DMA_MEMCPY_THRESHOLD && dma_dst_maintainable(dst, len)) {
+        uint32_t slot;
+        core_util_critical_section_enter();
+        for (slot = 0; slot < DMA_MEMCPY_MAX_PENDING; slot++) {
+            if (!dma_memcpy_pending[slot].in_use) {
+                dma_memcpy_pending[slot].in_use = 1;
+                break;
+            }
+        }
+        core_util_critical_section_exit();
+
+        if (slot < DMA_MEMCPY_MAX_PENDING) {
+            dma_memcpy_pending_t *pending = &dma_memcpy_pending[slot];
+            pending->dst = dst;
+            pending->len = len;
+            pending->done = done;
+            pending->id = id;
+
+            mbed_dma_buf_tx_prepare(src, len);
+            mbed_dma_buf_rx_prepare(dst, len);
+            if (dma_memcpy_start(dst, src, len, dma_memcpy_async_handler, slot) != DMA_ERROR_OUT_OF_CHANNELS) {
+                return;
+            }
+            pending->in_use = 0;
+        }
+    }
+
+    memcpy(dst, src, len);
+    if (done) {
+        done(id);
+    }
+}
+
+#endif
@@ -0,0 +1,125 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_DMA_MEMCPY_H
+#define MBED_DMA_MEMCPY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "device.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_dma_memcpy DMA memcpy functions
+ *
+ * Drop-in replacements for memcpy/memset that offload large transfers to
+ * an idle DMA channel on targets with DEVICE_DMA_MEMCPY support.
+ * Transfers below platform.dma-memcpy-threshold, transfers whose
+ * destination cannot be safely cache-maintained, and transfers arriving
+ * while every DMA channel is busy are performed in software, so these
+ * functions are always correct to call and never slower than memcpy by
+ * more than the idle-channel check. On targets without the HAL they
+ * compile directly to memcpy/memset.
+ *
+ * On cores with a data cache the DMA path requires the destination to be
+ * cache-line aligned and the length a whole number of lines (as
+ * mbed_dma_buf_alloc guarantees); otherwise invalidating the destination
+ * would discard neighbouring data sharing its edge lines.
+ *
+ * @note Synchronization level: Interrupt safe
+ * @{
+ */
+
+#if DEVICE_DMA_MEMCPY || defined(DOXYGEN_ONLY)
+
+/** Copy a block of memory, using DMA when profitable.
+ *
+ *  Blocks until the copy has completed; large transfers spin-join on the
+ *  DMA channel instead of moving bytes, leaving the memory buses to do
+ *  the work out of the CPU's way.
+ *
+ * @param dst destination address.
+ * @param src source address; the regions must not overlap.
+ * @param len number of bytes to copy.
+ * @return dst, as memcpy does.
+ */
+void *mbed_dma_memcpy(void *dst, const void *src, size_t len);
+
+/** Fill a block of memory, using DMA when profitable.
+ *
+ * @param dst   destination address.
+ * @param value byte value to store.
+ * @param len   number of bytes to fill.
+ * @return dst, as memset does.
+ */
+void *mbed_dma_memset(void *dst, int value, size_t len);
+
+/** Copy a block of memory asynchronously.
+ *
+ *  When the transfer can go to DMA the function returns immediately and
+ *  the done callback is invoked from interrupt context after the
+ *  destination has been made visible to the CPU. When it cannot - below
+ *  threshold, no idle channel, or cache constraints - the copy is
+ *  performed in software and done is invoked before the function
+ *  returns. The callback is always called exactly once.
+ *
+ * @param dst  destination address.
+ * @param src  source address; the regions must stay valid until done runs.
+ * @param len  number of bytes to copy.
+ * @param done callback invoked once the copy has completed.
+ * @param id   the id passed to the callback.
+ */
+void mbed_dma_memcpy_async(void *dst, const void *src, size_t len, void (*done)(uint32_t id), uint32_t id);
+
+#else
+
+static inline void *mbed_dma_memcpy(void *dst, const void *src, size_t len)
+{
+    return memcpy(dst, src, len);
+}
+
+static inline void *mbed_dma_memset(void *dst, int value, size_t len)
+{
+    return memset(dst, value, len);
+}
+
+static inline void mbed_dma_memcpy_async(void *dst, const void *src, size_t len, void (*done)(uint32_t id), uint32_t id)
+{
+    memcpy(dst, src, len);
+    if (done) {
+        done(id);
+    }
+}
+
+#endif
+
+/** @}*/
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // #ifndef MBED_DMA_MEMCPY_H
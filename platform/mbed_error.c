@@ -129,11 +129,10 @@ WEAK MBED_NORETURN void error(const char *format, ...)
     mbed_halt_system();
 }
 
-//Set an error status with the error handling system
-static mbed_error_status_t handle_error(mbed_error_status_t error_status, unsigned int error_value, const char *filename, int line_number, void *caller)
+//Capture raw error context - no formatting, no locks, no calls that can
+//fault. This is the only work the crash capture path depends on.
+static void capture_error_ctx(mbed_error_ctx *ctx, mbed_error_status_t error_status, unsigned int error_value, const char *filename, int line_number, void *caller)
 {
-    mbed_error_ctx current_error_ctx;
-
     //Error status should always be < 0
     if (error_status >= 0) {
         //This is a weird situation, someone called mbed_error with invalid error code.
@@ -142,28 +141,56 @@ static mbed_error_status_t handle_error(mbed_error_status_t error_status, unsign
     }
 
     //Clear the context capturing buffer
-    memset(&current_error_ctx, 0, sizeof(mbed_error_ctx));
+    memset(ctx, 0, sizeof(mbed_error_ctx));
     //Capture error information
-    current_error_ctx.error_status = error_status;
-    current_error_ctx.error_address = (uint32_t)caller;
-    current_error_ctx.error_value = error_value;
+    ctx->error_status = error_status;
+    ctx->error_address = (uint32_t)caller;
+    ctx->error_value = error_value;
 #ifdef MBED_CONF_RTOS_PRESENT
     //Capture thread info
     osRtxThread_t *current_thread = osRtxInfo.thread.run.curr;
-    current_error_ctx.thread_id = (uint32_t)current_thread;
-    current_error_ctx.thread_entry_address = (uint32_t)current_thread->thread_addr;
-    current_error_ctx.thread_stack_size = current_thread->stack_size;
-    current_error_ctx.thread_stack_mem = (uint32_t)current_thread->stack_mem;
-    current_error_ctx.thread_current_sp = (uint32_t)&current_error_ctx; // Address local variable to get a stack pointer
+    ctx->thread_id = (uint32_t)current_thread;
+    ctx->thread_entry_address = (uint32_t)current_thread->thread_addr;
+    ctx->thread_stack_size = current_thread->stack_size;
+    ctx->thread_stack_mem = (uint32_t)current_thread->stack_mem;
+    ctx->thread_current_sp = (uint32_t)&current_thread; // Address local variable to get a stack pointer
 #endif //MBED_CONF_RTOS_PRESENT
 
 #if MBED_CONF_PLATFORM_ERROR_FILENAME_CAPTURE_ENABLED
     //Capture filename/linenumber if provided
     //Index for tracking error_filename
-    strncpy(current_error_ctx.error_filename, filename, MBED_CONF_PLATFORM_MAX_ERROR_FILENAME_LEN);
-    current_error_ctx.error_line_number = line_number;
+    strncpy(ctx->error_filename, filename, MBED_CONF_PLATFORM_MAX_ERROR_FILENAME_LEN);
+    ctx->error_line_number = line_number;
+#endif
+}
+
+#if MBED_CONF_PLATFORM_CRASH_CAPTURE_ENABLED
+//Store a raw error context into the reserved crash RAM region. Runs before
+//any history/hook/print handling so a secondary fault in those cannot lose
+//the original context; the stored context is decoded on the next boot.
+static void persist_error_ctx(mbed_error_ctx *ctx)
+{
+    //Carry the reboot count over from the previous context if it is intact
+    if (report_error_ctx->crc_error_ctx == compute_crc32(report_error_ctx, offsetof(mbed_error_ctx, crc_error_ctx))) {
+        ctx->error_reboot_count = report_error_ctx->error_reboot_count + 1;
+    } else {
+        ctx->error_reboot_count = 1;
+    }
+    ctx->is_error_processed = 0;//Set the flag that this is a new error
+    ctx->crc_error_ctx = compute_crc32(ctx, offsetof(mbed_error_ctx, crc_error_ctx));
+    //No lock taken here - the caller holds error_in_progress, which is all
+    //that keeps concurrent fatal errors out of this path
+    memcpy(report_error_ctx, ctx, sizeof(mbed_error_ctx));
+}
 #endif
 
+//Set an error status with the error handling system
+static mbed_error_status_t handle_error(mbed_error_status_t error_status, unsigned int error_value, const char *filename, int line_number, void *caller)
+{
+    mbed_error_ctx current_error_ctx;
+
+    capture_error_ctx(&current_error_ctx, error_status, error_value, filename, line_number, caller);
+
     //Prevent corruption by holding out other callers
     core_util_critical_section_enter();
 
@@ -210,9 +237,24 @@ mbed_error_status_t mbed_error_initialize(void)
         //Read report_error_ctx and check if CRC is correct, and with valid status code
         if ((report_error_ctx->crc_error_ctx == crc_val) && (report_error_ctx->is_error_processed == 0)) {
             is_reboot_error_valid = true;
-            //Report the error info
+            //Report the error info. This is the deferred decode of the raw
+            //context stored at fault time; only the stored fields are used,
+            //pointers from the previous boot are not followed.
 #ifndef NDEBUG
             printf("\n== The system has been rebooted due to a fatal error. ==\n");
+            printf("== Error Status: 0x%" PRIX32 " Value: 0x%" PRIX32 " Location: 0x%" PRIX32 " ==\n",
+                   (uint32_t)report_error_ctx->error_status, report_error_ctx->error_value, report_error_ctx->error_address);
+#ifdef MBED_CONF_RTOS_PRESENT
+            printf("== Thread Id: 0x%" PRIX32 " Entry: 0x%" PRIX32 " StackMem: 0x%" PRIX32 " SP: 0x%" PRIX32 " ==\n",
+                   report_error_ctx->thread_id, report_error_ctx->thread_entry_address,
+                   report_error_ctx->thread_stack_mem, report_error_ctx->thread_current_sp);
+#endif
+#if MBED_CONF_PLATFORM_ERROR_FILENAME_CAPTURE_ENABLED
+            if (report_error_ctx->error_filename[0]) {
+                printf("== File: %.*s+%" PRIi32 " ==\n", MBED_CONF_PLATFORM_MAX_ERROR_FILENAME_LEN,
+                       report_error_ctx->error_filename, (int32_t)report_error_ctx->error_line_number);
+            }
+#endif
 #endif
 
             //Call the mbed_error_reboot_callback, this enables applications to do some handling before we do the handling
@@ -271,32 +313,30 @@ mbed_error_status_t mbed_warning(mbed_error_status_t error_status, const char *e
 //Sets a fatal error, this function is marked WEAK to be able to override this for some tests
 WEAK MBED_NORETURN mbed_error_status_t mbed_error(mbed_error_status_t error_status, const char *error_msg, unsigned int error_value, const char *filename, int line_number)
 {
+    void *caller = MBED_CALLER_ADDR();
+
     // Prevent recursion if error is called again during store+print attempt
     if (!core_util_atomic_flag_test_and_set(&error_in_progress)) {
-        //set the error reported
-        (void) handle_error(error_status, error_value, filename, line_number, MBED_CALLER_ADDR());
+#if MBED_CONF_PLATFORM_CRASH_CAPTURE_ENABLED
+        //Phase 1: persist the raw context into crash RAM before anything
+        //else runs. History, hooks and the printed report below can fault
+        //again on a badly damaged system; once this store is done a
+        //secondary fault re-enters with error_in_progress set, skips
+        //capture and goes straight to reset, so the original context
+        //survives to be decoded on the next boot.
+        mbed_error_ctx crash_ctx;
+        capture_error_ctx(&crash_ctx, error_status, error_value, filename, line_number, caller);
+        persist_error_ctx(&crash_ctx);
+#endif
+
+        //Phase 2: best effort bookkeeping and reporting
+        (void) handle_error(error_status, error_value, filename, line_number, caller);
 
         //On fatal errors print the error context/report
         ERROR_REPORT(&last_error_ctx, error_msg, filename, line_number);
     }
 
 #if MBED_CONF_PLATFORM_CRASH_CAPTURE_ENABLED
-    uint32_t crc_val = 0;
-    crc_val = compute_crc32(report_error_ctx, offsetof(mbed_error_ctx, crc_error_ctx));
-    //Read report_error_ctx and check if CRC is correct for report_error_ctx
-    if (report_error_ctx->crc_error_ctx == crc_val) {
-        uint32_t current_reboot_count = report_error_ctx->error_reboot_count;
-        last_error_ctx.error_reboot_count = current_reboot_count + 1;
-    } else {
-        last_error_ctx.error_reboot_count = 1;
-    }
-    last_error_ctx.is_error_processed = 0;//Set the flag that this is a new error
-    //Update the struct with crc
-    last_error_ctx.crc_error_ctx = compute_crc32(&last_error_ctx, offsetof(mbed_error_ctx, crc_error_ctx));
-    //Protect report_error_ctx while we update it
-    core_util_critical_section_enter();
-    memcpy(report_error_ctx, &last_error_ctx, sizeof(mbed_error_ctx));
-    core_util_critical_section_exit();
     //We need not call delete_mbed_crc(crc_obj) here as we are going to reset the system anyway, and calling delete while handling a fatal error may cause nested exception
 #if MBED_CONF_PLATFORM_FATAL_ERROR_AUTO_REBOOT_ENABLED && (MBED_CONF_PLATFORM_ERROR_REBOOT_MAX > 0)
     system_reset();//do a system reset to get the system rebooted
@@ -0,0 +1,65 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_itm_trace.h"
+
+#if defined(MBED_ITM_TRACE_ENABLED) && DEVICE_ITM
+
+#include "hal/itm_api.h"
+
+uint32_t mbed_itm_trace_dropped;
+
+void mbed_itm_trace_init(void)
+{
+    mbed_itm_init();
+
+    /* Enable the built-in trace channels alongside the console port. */
+    ITM->TER |= (1UL << MBED_ITM_TRACE_PORT_SCHED) |
+                (1UL << MBED_ITM_TRACE_PORT_EQUEUE);
+
+    /* Local timestamp packets let the host time each event without any
+     * cost on the target. */
+    ITM->TCR |= ITM_TCR_TSENA_Msk;
+}
+
+void mbed_itm_trace_port_enable(uint32_t port)
+{
+    ITM->TER |= (1UL << port);
+}
+
+uint32_t mbed_itm_trace_lost(void)
+{
+    return mbed_itm_trace_dropped;
+}
+
+#else
+
+void mbed_itm_trace_init(void)
+{
+}
+
+void mbed_itm_trace_port_enable(uint32_t port)
+{
+    (void)port;
+}
+
+uint32_t mbed_itm_trace_lost(void)
+{
+    return 0;
+}
+
+#endif // defined(MBED_ITM_TRACE_ENABLED) && DEVICE_ITM
@@ -0,0 +1,191 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_ITM_TRACE_H
+#define MBED_ITM_TRACE_H
+
+#include <stdint.h>
+
+#ifdef MBED_ITM_TRACE_ENABLED
+#include "device.h"
+#endif
+
+#if defined(MBED_ITM_TRACE_ENABLED) && DEVICE_ITM
+#include "cmsis.h"
+
+#ifndef ITM_STIM_FIFOREADY_Msk
+#define ITM_STIM_FIFOREADY_Msk 1
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_itm_trace ITM trace streaming functions
+ *
+ * A binary trace streaming channel over the ITM/SWO pin, for capturing
+ * timing events at the line rate of the debug probe (megabytes per
+ * second on most probes) instead of printf-tracing over a UART. Each
+ * event is a single 32-bit stimulus port write - a handful of cycles,
+ * atomic in hardware, so events can be emitted from threads and
+ * interrupt handlers without any locking. When the port FIFO is busy
+ * the event is dropped and counted rather than stalling the caller.
+ *
+ * Channels are ITM stimulus ports. Port 0 remains the console text
+ * channel used by SerialWireOutput; the ports below are reserved for
+ * the built-in event sources, and ports from MBED_ITM_TRACE_PORT_USER
+ * up are free for the application (enable them with
+ * mbed_itm_trace_port_enable).
+ *
+ * Host-side decode format
+ * -----------------------
+ * The SWO stream is standard ITM protocol, so any ITM-aware tool
+ * (openocd's tpiu/itm commands, orbuculum's itmdump, or the trace view
+ * of commercial debuggers) splits it back into per-port streams and
+ * local timestamp packets; mbed_itm_trace_init enables local
+ * timestamps so the host can assign a time to every event without any
+ * cost on the target. Within a port the payload is:
+ *
+ * - MBED_ITM_TRACE_PORT_SCHED: one word per context switch, the raw
+ *   osThreadId_t (thread control block address) of the thread switched
+ *   in. Match against mbed_stats_thread_t::id to name threads.
+ * - MBED_ITM_TRACE_PORT_EQUEUE and user ports carrying events from
+ *   mbed_itm_trace_event: bits[31:24] are the event id, bits[23:0] the
+ *   event argument. For the equeue channel the argument is the low 24
+ *   bits of the queue address, distinguishing queue instances.
+ *
+ * The facility is compiled out unless MBED_ITM_TRACE_ENABLED is set
+ * (platform.itm-trace-enabled) and the target has DEVICE_ITM; the emit
+ * calls then compile to nothing, so instrumentation points can be left
+ * in place.
+ *
+ * @note Synchronization level: Interrupt safe. A stimulus port write is
+ *       atomic; the drop counter may undercount under write races.
+ * @{
+ */
+
+/**
+ * Stimulus port assignments of the trace channels.
+ */
+enum {
+    MBED_ITM_TRACE_PORT_CONSOLE = 0,    /**< console text (SerialWireOutput) */
+    MBED_ITM_TRACE_PORT_SCHED   = 1,    /**< context switches, raw thread id words */
+    MBED_ITM_TRACE_PORT_EQUEUE  = 2,    /**< event queue dispatch events */
+    MBED_ITM_TRACE_PORT_USER    = 3     /**< first port free for application channels */
+};
+
+/**
+ * Event ids carried on MBED_ITM_TRACE_PORT_EQUEUE.
+ */
+enum {
+    MBED_ITM_TRACE_EQUEUE_DISPATCH_ENTER = 0x01,    /**< entered EventQueue::dispatch */
+    MBED_ITM_TRACE_EQUEUE_DISPATCH_EXIT  = 0x02     /**< left EventQueue::dispatch */
+};
+
+/**
+ * Initialize the ITM through mbed_itm_init, enable the built-in trace
+ * channels and turn on local timestamp generation. Call once at
+ * startup; safe to call again. Does nothing when the facility is
+ * compiled out.
+ */
+void mbed_itm_trace_init(void);
+
+/**
+ * Enable an additional stimulus port for application trace events.
+ *
+ * @param port the stimulus port to enable, MBED_ITM_TRACE_PORT_USER or above.
+ */
+void mbed_itm_trace_port_enable(uint32_t port);
+
+/**
+ * Number of events dropped because the stimulus port FIFO was busy,
+ * since startup. A non-zero and growing value means the SWO clock is
+ * too slow for the event rate.
+ *
+ * @return the number of dropped events.
+ */
+uint32_t mbed_itm_trace_lost(void);
+
+#if (defined(MBED_ITM_TRACE_ENABLED) && DEVICE_ITM) || defined(DOXYGEN_ONLY)
+
+/** Dropped-event count, incremented by the emit functions. Read it
+ *  through mbed_itm_trace_lost. */
+extern uint32_t mbed_itm_trace_dropped;
+
+/**
+ * Emit one raw 32-bit word on a trace channel. Drops the word rather
+ * than waiting when the port FIFO is busy; does nothing when the port
+ * is not enabled.
+ *
+ * @param port the stimulus port to write to.
+ * @param data the word to emit.
+ */
+static inline void mbed_itm_trace_word(uint32_t port, uint32_t data)
+{
+    if ((ITM->TER & (1UL << port)) == 0UL) {
+        return;
+    }
+    if ((ITM->PORT[port].u32 & ITM_STIM_FIFOREADY_Msk) != 0UL) {
+        ITM->PORT[port].u32 = data;
+    } else {
+        mbed_itm_trace_dropped += 1;
+    }
+}
+
+/**
+ * Emit one event on a trace channel, packed as bits[31:24] = id and
+ * bits[23:0] = arg. Same dropping behaviour as mbed_itm_trace_word.
+ *
+ * @param port the stimulus port to write to.
+ * @param id the event id.
+ * @param arg the event argument; only the low 24 bits are carried.
+ */
+static inline void mbed_itm_trace_event(uint32_t port, uint8_t id, uint32_t arg)
+{
+    mbed_itm_trace_word(port, ((uint32_t)id << 24) | (arg & 0x00FFFFFFUL));
+}
+
+#else
+
+static inline void mbed_itm_trace_word(uint32_t port, uint32_t data)
+{
+    (void)port;
+    (void)data;
+}
+
+static inline void mbed_itm_trace_event(uint32_t port, uint8_t id, uint32_t arg)
+{
+    (void)port;
+    (void)id;
+    (void)arg;
+}
+
+#endif
+
+/** @}*/
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // #ifndef MBED_ITM_TRACE_H
@@ -0,0 +1,189 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_mem_region.h"
+#include "platform/mbed_critical.h"
+
+/* Alignment of every returned pointer and of the block header */
+#define MEM_REGION_ALIGNMENT    8
+
+/* Free and allocated blocks carry their size in front of the payload;
+ * free blocks additionally chain through the payload area. The header is
+ * one alignment granule so payloads stay aligned. */
+typedef struct mem_region_block {
+    size_t size;                        /* payload bytes */
+    struct mem_region_block *next_free; /* valid while the block is free */
+} mem_region_block_t;
+
+#define MEM_REGION_HEADER (sizeof(size_t) <= MEM_REGION_ALIGNMENT ? \
+                           MEM_REGION_ALIGNMENT : sizeof(size_t))
+
+typedef struct {
+    mem_region_block_t *free_list;  /* address-ordered for coalescing */
+    uint8_t *start;
+    size_t size;
+} mem_region_pool_t;
+
+static mem_region_pool_t region_pools[MBED_MEM_REGION_COUNT];
+static uint8_t region_initialized;
+
+MBED_WEAK void mbed_mem_region_init(void)
+{
+    // Targets with TCM or domain SRAM override this and declare pools
+}
+
+static void mem_region_lazy_init(void)
+{
+    core_util_critical_section_enter();
+    if (!region_initialized) {
+        region_initialized = 1;
+        mbed_mem_region_init();
+    }
+    core_util_critical_section_exit();
+}
+
+int mbed_mem_region_add(mbed_mem_region_t region, void *start, size_t size)
+{
+    if (region >= MBED_MEM_REGION_COUNT || start == NULL ||
+            ((uintptr_t)start & (MEM_REGION_ALIGNMENT - 1)) != 0 ||
+            size < 2 * MEM_REGION_HEADER) {
+        return -1;
+    }
+
+    int err = 0;
+    core_util_critical_section_enter();
+    if (region_pools[region].start != NULL) {
+        err = -1;
+    } else {
+        // The whole pool starts life as one free block
+        mem_region_block_t *block = (mem_region_block_t *)start;
+        block->size = (size & ~(size_t)(MEM_REGION_ALIGNMENT - 1)) - MEM_REGION_HEADER;
+        block->next_free = NULL;
+        region_pools[region].free_list = block;
+        region_pools[region].start = (uint8_t *)start;
+        region_pools[region].size = size;
+    }
+    core_util_critical_section_exit();
+    return err;
+}
+
+void *mbed_alloc_from(mbed_mem_region_t region, size_t size)
+{
+    if (region >= MBED_MEM_REGION_COUNT || size == 0) {
+        return NULL;
+    }
+    mem_region_lazy_init();
+
+    size = (size + MEM_REGION_ALIGNMENT - 1) & ~(size_t)(MEM_REGION_ALIGNMENT - 1);
+
+    void *ptr = NULL;
+    core_util_critical_section_enter();
+    mem_region_block_t **link = &region_pools[region].free_list;
+    while (*link != NULL) {
+        mem_region_block_t *block = *link;
+        if (block->size >= size) {
+            if (block->size >= size + MEM_REGION_HEADER + MEM_REGION_ALIGNMENT) {
+                // Split, keeping the tail on the free list
+                mem_region_block_t *tail = (mem_region_block_t *)
+                                           ((uint8_t *)block + MEM_REGION_HEADER + size);
+                tail->size = block->size - size - MEM_REGION_HEADER;
+                tail->next_free = block->next_free;
+                block->size = size;
+                *link = tail;
+            } else {
+                *link = block->next_free;
+            }
+            ptr = (uint8_t *)block + MEM_REGION_HEADER;
+            break;
+        }
+        link = &block->next_free;
+    }
+    core_util_critical_section_exit();
+    return ptr;
+}
+
+void mbed_free_to(mbed_mem_region_t region, void *ptr)
+{
+    if (region >= MBED_MEM_REGION_COUNT || ptr == NULL) {
+        return;
+    }
+
+    mem_region_block_t *block = (mem_region_block_t *)((uint8_t *)ptr - MEM_REGION_HEADER);
+
+    core_util_critical_section_enter();
+    // Insert in address order and coalesce with both neighbours
+    mem_region_block_t **link = &region_pools[region].free_list;
+    while (*link != NULL && *link < block) {
+        link = &(*link)->next_free;
+    }
+
+    mem_region_block_t *next = *link;
+    if (next != NULL &&
+            (uint8_t *)block + MEM_REGION_HEADER + block->size == (uint8_t *)next) {
+        block->size += MEM_REGION_HEADER + next->size;
+        block->next_free = next->next_free;
+    } else {
+        block->next_free = next;
+    }
+    *link = block;
+
+    if (link != &region_pools[region].free_list) {
+        mem_region_block_t *prev = (mem_region_block_t *)
+                                   ((uint8_t *)link - offsetof(mem_region_block_t, next_free));
+        if ((uint8_t *)prev + MEM_REGION_HEADER + prev->size == (uint8_t *)block) {
+            prev->size += MEM_REGION_HEADER + block->size;
+            prev->next_free = block->next_free;
+        }
+    }
+    core_util_critical_section_exit();
+}
+
+size_t mbed_mem_region_free_size(mbed_mem_region_t region)
+{
+    if (region >= MBED_MEM_REGION_COUNT) {
+        return 0;
+    }
+    mem_region_lazy_init();
+
+    size_t total = 0;
+    core_util_critical_section_enter();
+    for (mem_region_block_t *block = region_pools[region].free_list;
+            block != NULL; block = block->next_free) {
+        total += block->size;
+    }
+    core_util_critical_section_exit();
+    return total;
+}
+
+size_t mbed_mem_region_largest_free(mbed_mem_region_t region)
+{
+    if (region >= MBED_MEM_REGION_COUNT) {
+        return 0;
+    }
+    mem_region_lazy_init();
+
+    size_t largest = 0;
+    core_util_critical_section_enter();
+    for (mem_region_block_t *block = region_pools[region].free_list;
+            block != NULL; block = block->next_free) {
+        if (block->size > largest) {
+            largest = block->size;
+        }
+    }
+    core_util_critical_section_exit();
+    return largest;
+}
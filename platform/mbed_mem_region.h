@@ -0,0 +1,150 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_MEM_REGION_H
+#define MBED_MEM_REGION_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "platform/mbed_toolchain.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_mem_region memory region functions
+ *
+ * Cortex-M7 class parts have memories with very different characteristics
+ * - zero-wait-state DTCM/ITCM, domain SRAMs reachable by specific DMA
+ * masters - which the build system maps but the single global heap
+ * ignores. This module lets the target declare an allocation pool per
+ * region and lets drivers and applications ask for memory by region:
+ * descriptor rings from the SRAM their DMA master can reach, hot state
+ * from DTCM. Regions the target has not declared simply fail allocation,
+ * so portable code can try the ideal region and fall back.
+ *
+ * Targets declare their pools by overriding mbed_mem_region_init() and
+ * calling mbed_mem_region_add() with bounds their linker script exports.
+ * Each pool is managed by a first-fit free-list allocator with
+ * coalescing - the same service a heap provides, scoped to one region.
+ *
+ * For static placement the MBED_DTCM/MBED_ITCM/MBED_SRAM_D2/MBED_SRAM_D3
+ * attributes emit the object or function into a region section
+ * (".mbed_dtcm" and friends) that supporting target linker scripts map
+ * to the region; the sections are not load-initialized, so treat placed
+ * objects as zero-initialized at best.
+ *
+ * @note Synchronization level: Interrupt safe
+ * @{
+ */
+
+/**
+ * enum mbed_mem_region_t definition
+ */
+typedef enum {
+    MBED_MEM_DTCM = 0,      /**< Data TCM: zero wait states, core-private */
+    MBED_MEM_ITCM,          /**< Instruction TCM: zero wait states, core-private */
+    MBED_MEM_SRAM_D2,       /**< Domain 2 SRAM, reachable by the D2 DMA masters (Ethernet, SDMMC) */
+    MBED_MEM_SRAM_D3,       /**< Domain 3 SRAM, retained in low-power states */
+    MBED_MEM_REGION_COUNT   /**< Number of region identifiers */
+} mbed_mem_region_t;
+
+/** Place a zero-initialized object in DTCM (requires linker script support) */
+#define MBED_DTCM       MBED_SECTION(".mbed_dtcm")
+/** Place a function in ITCM (requires linker script support and a startup copy) */
+#define MBED_ITCM       MBED_SECTION(".mbed_itcm")
+/** Place a zero-initialized object in D2 SRAM (requires linker script support) */
+#define MBED_SRAM_D2    MBED_SECTION(".mbed_sram_d2")
+/** Place a zero-initialized object in D3 SRAM (requires linker script support) */
+#define MBED_SRAM_D3    MBED_SECTION(".mbed_sram_d3")
+
+/**
+ * Declare an allocation pool covering part of a memory region.
+ *
+ * Called by the target, normally from its mbed_mem_region_init()
+ * override, with bounds exported by the linker script so the pool cannot
+ * collide with statically placed data. Each region can hold one pool.
+ *
+ * @param region the region the pool lives in.
+ * @param start start of the pool, at least 8-byte aligned.
+ * @param size size of the pool in bytes.
+ * @return 0 on success, -1 if the region is invalid, too small or
+ *         already declared.
+ */
+int mbed_mem_region_add(mbed_mem_region_t region, void *start, size_t size);
+
+/**
+ * Declare the target's region pools.
+ *
+ * The default implementation declares nothing, so every regional
+ * allocation fails and callers fall back to the heap. Targets with TCM
+ * or domain SRAM override this; it is called once, before the first
+ * allocation.
+ */
+void mbed_mem_region_init(void);
+
+/**
+ * Allocate from a specific memory region.
+ *
+ * The returned pointer is 8-byte aligned. Fails when the region has no
+ * pool or the pool is exhausted; callers that can live with slower
+ * memory should then fall back to malloc.
+ *
+ * @param region the region to allocate from.
+ * @param size number of bytes to allocate.
+ * @return the allocation, or NULL.
+ */
+void *mbed_alloc_from(mbed_mem_region_t region, size_t size);
+
+/**
+ * Free an allocation made with mbed_alloc_from.
+ *
+ * @param region the region the allocation came from.
+ * @param ptr the allocation to free, may be NULL.
+ */
+void mbed_free_to(mbed_mem_region_t region, void *ptr);
+
+/**
+ * Bytes currently free in a region's pool.
+ *
+ * @param region the region to query.
+ * @return total free bytes, 0 when the region has no pool.
+ */
+size_t mbed_mem_region_free_size(mbed_mem_region_t region);
+
+/**
+ * Size of the largest single allocation a region's pool can currently
+ * satisfy. Comparing this with the free total reveals fragmentation.
+ *
+ * @param region the region to query.
+ * @return largest allocatable size in bytes, 0 when the region has no pool.
+ */
+size_t mbed_mem_region_largest_free(mbed_mem_region_t region);
+
+/** @}*/
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // #ifndef MBED_MEM_REGION_H
@@ -22,6 +22,8 @@
 #include "platform/mbed_critical.h"
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
+#include "hal/ticker_api.h"
+#include "hal/us_ticker_api.h"
 
 /******************************************************************************
  * Internal variables, functions and helpers
@@ -153,3 +155,131 @@ void mbed_mem_trace_default_callback(uint8_t op, void *res, void *caller, ...)
     va_end(va);
 }
 
+/******************************************************************************
+ * Ring buffer backend
+ *****************************************************************************/
+
+#ifndef MBED_CONF_PLATFORM_MEM_TRACE_BUFFER_SIZE
+#define MBED_CONF_PLATFORM_MEM_TRACE_BUFFER_SIZE 64
+#endif
+
+/* Fixed-size binary records claimed with an atomic increment, so writing a
+ * record neither locks nor formats anything during the traced operation. */
+static mbed_mem_trace_record_t ring_records[MBED_CONF_PLATFORM_MEM_TRACE_BUFFER_SIZE];
+static volatile uint32_t ring_write;
+static uint32_t ring_read;
+static uint32_t ring_dropped;
+
+void mbed_mem_trace_ring_callback(uint8_t op, void *res, void *caller, ...)
+{
+    va_list va;
+    uint32_t seq = core_util_atomic_incr_u32(&ring_write, 1) - 1;
+    mbed_mem_trace_record_t *record = &ring_records[seq % MBED_CONF_PLATFORM_MEM_TRACE_BUFFER_SIZE];
+
+    record->op = op;
+    record->res = res;
+    record->caller = caller;
+#if DEVICE_USTICKER
+    record->timestamp_us = (uint32_t)ticker_read(get_us_ticker_data());
+#else
+    record->timestamp_us = 0;
+#endif
+    va_start(va, caller);
+    switch (op) {
+        case MBED_MEM_TRACE_MALLOC:
+            record->arg0 = va_arg(va, size_t);
+            record->arg1 = 0;
+            break;
+
+        case MBED_MEM_TRACE_REALLOC:
+            record->arg1 = (uint32_t)(uintptr_t)va_arg(va, void *);
+            record->arg0 = va_arg(va, size_t);
+            break;
+
+        case MBED_MEM_TRACE_CALLOC:
+            record->arg1 = va_arg(va, size_t);
+            record->arg0 = va_arg(va, size_t);
+            break;
+
+        case MBED_MEM_TRACE_FREE:
+            record->arg0 = 0;
+            record->arg1 = (uint32_t)(uintptr_t)va_arg(va, void *);
+            break;
+
+        default:
+            record->arg0 = 0;
+            record->arg1 = 0;
+            break;
+    }
+    va_end(va);
+}
+
+int mbed_mem_trace_ring_pop(mbed_mem_trace_record_t *record)
+{
+    for (;;) {
+        uint32_t write = ring_write;
+        if (write - ring_read > MBED_CONF_PLATFORM_MEM_TRACE_BUFFER_SIZE) {
+            /* the writer lapped us - skip to the oldest intact record */
+            ring_dropped += write - ring_read - MBED_CONF_PLATFORM_MEM_TRACE_BUFFER_SIZE;
+            ring_read = write - MBED_CONF_PLATFORM_MEM_TRACE_BUFFER_SIZE;
+        }
+        if (ring_read == write) {
+            return 0;
+        }
+        *record = ring_records[ring_read % MBED_CONF_PLATFORM_MEM_TRACE_BUFFER_SIZE];
+        /* if the writer reached this slot while we copied, the copy may be
+         * torn - drop it and try the next oldest record */
+        if (ring_write - ring_read <= MBED_CONF_PLATFORM_MEM_TRACE_BUFFER_SIZE) {
+            ring_read++;
+            return 1;
+        }
+    }
+}
+
+uint32_t mbed_mem_trace_ring_dropped(void)
+{
+    return ring_dropped;
+}
+
+void mbed_mem_trace_ring_reset(void)
+{
+    ring_write = 0;
+    ring_read = 0;
+    ring_dropped = 0;
+}
+
+void mbed_mem_trace_ring_dump(void)
+{
+    mbed_mem_trace_record_t record;
+
+    if (ring_dropped) {
+        printf(MBED_MEM_DEFAULT_TRACER_PREFIX "dropped:%u\n", (unsigned int)ring_dropped);
+    }
+    while (mbed_mem_trace_ring_pop(&record)) {
+        switch (record.op) {
+            case MBED_MEM_TRACE_MALLOC:
+                printf(MBED_MEM_DEFAULT_TRACER_PREFIX "m:%p;%p-%u;%u\n", record.res, record.caller,
+                       (unsigned int)record.arg0, (unsigned int)record.timestamp_us);
+                break;
+
+            case MBED_MEM_TRACE_REALLOC:
+                printf(MBED_MEM_DEFAULT_TRACER_PREFIX "r:%p;%p-%p;%u;%u\n", record.res, record.caller,
+                       (void *)(uintptr_t)record.arg1, (unsigned int)record.arg0, (unsigned int)record.timestamp_us);
+                break;
+
+            case MBED_MEM_TRACE_CALLOC:
+                printf(MBED_MEM_DEFAULT_TRACER_PREFIX "c:%p;%p-%u;%u;%u\n", record.res, record.caller,
+                       (unsigned int)record.arg1, (unsigned int)record.arg0, (unsigned int)record.timestamp_us);
+                break;
+
+            case MBED_MEM_TRACE_FREE:
+                printf(MBED_MEM_DEFAULT_TRACER_PREFIX "f:%p;%p-%p;%u\n", record.res, record.caller,
+                       (void *)(uintptr_t)record.arg1, (unsigned int)record.timestamp_us);
+                break;
+
+            default:
+                printf("?\n");
+        }
+    }
+}
+
@@ -163,6 +163,68 @@ void mbed_mem_trace_free(void *ptr, void *caller);
  */
 void mbed_mem_trace_default_callback(uint8_t op, void *res, void *caller, ...);
 
+/**
+ * A fixed-size binary record of one traced memory operation, as stored
+ * by 'mbed_mem_trace_ring_callback'.
+ */
+typedef struct mbed_mem_trace_record {
+    uint8_t op;             /**< operation ID (MBED_MEM_TRACE_MALLOC etc.) */
+    void *res;              /**< result of the operation (NULL for 'free') */
+    void *caller;           /**< caller of the memory operation */
+    uint32_t arg0;          /**< 'size' argument of malloc/realloc/calloc, 0 for free */
+    uint32_t arg1;          /**< 'ptr' argument of realloc/free, 'nmemb' of calloc, 0 for malloc */
+    uint32_t timestamp_us;  /**< microsecond timestamp of the operation */
+} mbed_mem_trace_record_t;
+
+/**
+ * Ring buffer memory trace callback. DO NOT CALL DIRECTLY. It is meant to be
+ * used as the argument of 'mbed_mem_trace_set_callback'.
+ *
+ * Unlike 'mbed_mem_trace_default_callback', this callback does not format or
+ * print anything during the traced operation. It writes a fixed-size binary
+ * record into a static ring buffer (platform.mem-trace-buffer-size records)
+ * and returns, so tracing perturbs timing little enough to stay enabled in
+ * long-running tests. When the buffer wraps, the oldest records are
+ * overwritten and counted as dropped.
+ *
+ * The stored records are decoded out-of-band with 'mbed_mem_trace_ring_pop'
+ * or 'mbed_mem_trace_ring_dump'.
+ */
+void mbed_mem_trace_ring_callback(uint8_t op, void *res, void *caller, ...);
+
+/**
+ * Pop the oldest record from the trace ring buffer.
+ *
+ * Call from a context that is the same or lower priority than the traced
+ * allocations, typically the thread draining trace output.
+ *
+ * @param record filled with the popped record on success.
+ * @return 1 if a record was popped, 0 if the buffer is empty.
+ */
+int mbed_mem_trace_ring_pop(mbed_mem_trace_record_t *record);
+
+/**
+ * Number of records lost to ring buffer overwrites since the last reset.
+ *
+ * @return the dropped record count.
+ */
+uint32_t mbed_mem_trace_ring_dropped(void);
+
+/**
+ * Empty the trace ring buffer and clear the dropped record count.
+ * @note Only call while tracing is disabled.
+ */
+void mbed_mem_trace_ring_reset(void);
+
+/**
+ * Pop and print every record in the trace ring buffer.
+ *
+ * Lines use the format of 'mbed_mem_trace_default_callback' with the
+ * microsecond timestamp appended after a ';', for example
+ * "#m:0x20003240;0x600d-50;1204988".
+ */
+void mbed_mem_trace_ring_dump(void);
+
 /** @}*/
 
 #ifdef __cplusplus
@@ -16,6 +16,7 @@
  */
 
 #include "mbed_mktime.h"
+#include "mbed_critical.h"
 
 /* Time constants. */
 #define SECONDS_BY_MINUTES 60
@@ -67,6 +68,34 @@ static const uint32_t seconds_before_month[2][12] = {
     }
 };
 
+/* Calendar fields of the most recently converted day. Timestamp-heavy users
+ * (for example log record timestamping) convert many times within the same
+ * day, in which case the year walk and month lookup can be skipped entirely. */
+typedef struct {
+    uint32_t day;               /* days since epoch + 1, 0 when empty */
+    rtc_leap_year_support_t leap_year_support;
+    int tm_year;
+    int tm_mon;
+    int tm_mday;
+    int tm_wday;
+    int tm_yday;
+} rtc_day_cache_t;
+
+static rtc_day_cache_t day_cache;
+
+/* Seconds at midnight of the most recently converted calendar date, the
+ * reverse counterpart of day_cache. */
+typedef struct {
+    bool valid;
+    rtc_leap_year_support_t leap_year_support;
+    int tm_year;
+    int tm_mon;
+    int tm_mday;
+    uint32_t midnight;
+} rtc_midnight_cache_t;
+
+static rtc_midnight_cache_t midnight_cache;
+
 bool _rtc_is_leap_year(int year, rtc_leap_year_support_t leap_year_support)
 {
     /*
@@ -105,9 +134,26 @@ bool _rtc_maketime(const struct tm *time, time_t *seconds, rtc_leap_year_support
         return false;
     }
 
-    uint32_t result = time->tm_sec;
-    result += time->tm_min * SECONDS_BY_MINUTES;
-    result += time->tm_hour * SECONDS_BY_HOUR;
+    uint32_t day_seconds = time->tm_sec;
+    day_seconds += time->tm_min * SECONDS_BY_MINUTES;
+    day_seconds += time->tm_hour * SECONDS_BY_HOUR;
+
+    /* Fast path - when converting another time from the same calendar date,
+     * reuse the cached seconds at midnight of that date. */
+    core_util_critical_section_enter();
+    if (midnight_cache.valid &&
+            (midnight_cache.tm_year == time->tm_year) &&
+            (midnight_cache.tm_mon == time->tm_mon) &&
+            (midnight_cache.tm_mday == time->tm_mday) &&
+            (midnight_cache.leap_year_support == leap_year_support)) {
+        const uint32_t midnight = midnight_cache.midnight;
+        core_util_critical_section_exit();
+        *seconds = midnight + day_seconds;
+        return true;
+    }
+    core_util_critical_section_exit();
+
+    uint32_t result = day_seconds;
     result += (time->tm_mday - 1) * SECONDS_BY_DAY;
     result += seconds_before_month[_rtc_is_leap_year(time->tm_year, leap_year_support)][time->tm_mon];
 
@@ -131,6 +177,19 @@ bool _rtc_maketime(const struct tm *time, time_t *seconds, rtc_leap_year_support
         result += (((time->tm_year - 70) * 365) + count_of_leap_days) * SECONDS_BY_DAY;
     }
 
+    /* Don't cache dates in the last valid year - the fast path would bypass
+     * the edge timestamp check above. */
+    if (time->tm_year != LAST_VALID_YEAR) {
+        core_util_critical_section_enter();
+        midnight_cache.valid = true;
+        midnight_cache.leap_year_support = leap_year_support;
+        midnight_cache.tm_year = time->tm_year;
+        midnight_cache.tm_mon = time->tm_mon;
+        midnight_cache.tm_mday = time->tm_mday;
+        midnight_cache.midnight = result - day_seconds;
+        core_util_critical_section_exit();
+    }
+
     *seconds = result;
 
     return true;
@@ -151,6 +210,23 @@ bool _rtc_localtime(time_t timestamp, struct tm *time_info, rtc_leap_year_suppor
     time_info->tm_hour = seconds % 24;
     seconds = seconds / 24;  // timestamp in days;
 
+    /* Fast path - the remaining fields only depend on the day number, so
+     * when converting another timestamp from the same day reuse them and
+     * skip the year walk below. */
+    core_util_critical_section_enter();
+    if ((day_cache.day == seconds + 1) && (day_cache.leap_year_support == leap_year_support)) {
+        time_info->tm_year = day_cache.tm_year;
+        time_info->tm_mon = day_cache.tm_mon;
+        time_info->tm_mday = day_cache.tm_mday;
+        time_info->tm_wday = day_cache.tm_wday;
+        time_info->tm_yday = day_cache.tm_yday;
+        core_util_critical_section_exit();
+        return true;
+    }
+    core_util_critical_section_exit();
+
+    const uint32_t day = seconds;
+
     /* Compute the weekday.
      * The 1st of January 1970 was a Thursday which is equal to 4 in the weekday representation ranging from [0:6].
      */
@@ -190,5 +266,15 @@ bool _rtc_localtime(time_t timestamp, struct tm *time_info, rtc_leap_year_suppor
     seconds -= seconds_before_month[leap][time_info->tm_mon];
     time_info->tm_mday = (seconds / SECONDS_BY_DAY) + 1;
 
+    core_util_critical_section_enter();
+    day_cache.day = day + 1;
+    day_cache.leap_year_support = leap_year_support;
+    day_cache.tm_year = time_info->tm_year;
+    day_cache.tm_mon = time_info->tm_mon;
+    day_cache.tm_mday = time_info->tm_mday;
+    day_cache.tm_wday = time_info->tm_wday;
+    day_cache.tm_yday = time_info->tm_yday;
+    core_util_critical_section_exit();
+
     return true;
 }
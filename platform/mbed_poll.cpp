@@ -16,9 +16,10 @@
  */
 #include "mbed_poll.h"
 #include "FileHandle.h"
+#include "platform/mbed_critical.h"
 #if MBED_CONF_RTOS_PRESENT
 #include "rtos/Kernel.h"
-#include "rtos/ThisThread.h"
+#include "rtos/Semaphore.h"
 using namespace rtos;
 #else
 #include "drivers/Timer.h"
@@ -27,24 +28,54 @@ using namespace rtos;
 
 namespace mbed {
 
+#if MBED_CONF_RTOS_PRESENT
+/* Threads blocked in poll(), each waiting on its own semaphore for a file
+ * handle to report a state change through FileHandle::wake_poll(). Any
+ * change wakes every waiter and each rescans its own file handles, so
+ * waiters never consume each other's wake-ups. The list is protected by
+ * critical sections as wake_poll() may run from interrupt context. */
+struct PollWaiter {
+    Semaphore *sem;
+    PollWaiter *next;
+};
+
+static PollWaiter *poll_waiters;
+#endif
+
+/* The wake end of the mechanism lives here next to the wait end; derived
+ * FileHandle classes call this alongside their sigio() callback. */
+void FileHandle::wake_poll()
+{
+#if MBED_CONF_RTOS_PRESENT
+    core_util_critical_section_enter();
+    for (PollWaiter *waiter = poll_waiters; waiter; waiter = waiter->next) {
+        waiter->sem->release();
+    }
+    core_util_critical_section_exit();
+#endif
+}
+
 // timeout -1 forever, or milliseconds
 int poll(pollfh fhs[], unsigned nfhs, int timeout)
 {
-    /*
-     * TODO Proper wake-up mechanism.
-     * In order to correctly detect availability of read/write a FileHandle, we needed
-     * a select or poll mechanisms. We opted for poll as POSIX defines in
-     * http://pubs.opengroup.org/onlinepubs/009695399/functions/poll.html Currently,
-     * mbed::poll() just spins and scans filehandles looking for any events we are
-     * interested in. In future, his spinning behaviour will be replaced with
-     * condition variables.
-     */
 #if MBED_CONF_RTOS_PRESENT
     uint64_t start_time = 0;
     if (timeout > 0) {
         start_time = Kernel::get_ms_count();
     }
 #define TIME_ELAPSED() int64_t(Kernel::get_ms_count() - start_time)
+
+    Semaphore sem(0, 1);
+    PollWaiter waiter = { &sem, NULL };
+
+    if (timeout != 0) {
+        /* Register as a waiter before the first scan, so a state change
+         * arriving between the scan and the wait is not lost */
+        core_util_critical_section_enter();
+        waiter.next = poll_waiters;
+        poll_waiters = &waiter;
+        core_util_critical_section_exit();
+    }
 #else
 #if MBED_CONF_PLATFORM_POLL_USE_LOWPOWER_TIMER
     LowPowerTimer timer;
@@ -77,16 +108,33 @@ int poll(pollfh fhs[], unsigned nfhs, int timeout)
             break;
         }
 
-        /* Nothing selected - this is where timeout handling would be needed */
         if (timeout == 0 || (timeout > 0 && TIME_ELAPSED() > timeout)) {
             break;
         }
-#ifdef MBED_CONF_RTOS_PRESENT
-        // TODO - proper blocking
-        // wait for condition variable, wait queue whatever here
-        rtos::ThisThread::sleep_for(1);
+#if MBED_CONF_RTOS_PRESENT
+        /* Block until a file handle signals a state change or the timeout
+         * expires - no periodic wake-ups while idle */
+        uint32_t wait_ms = osWaitForever;
+        if (timeout > 0) {
+            int64_t remaining = timeout - TIME_ELAPSED();
+            wait_ms = remaining > 0 ? remaining : 0;
+        }
+        sem.wait(wait_ms);
 #endif
     }
+
+#if MBED_CONF_RTOS_PRESENT
+    if (timeout != 0) {
+        core_util_critical_section_enter();
+        for (PollWaiter **p = &poll_waiters; *p; p = &(*p)->next) {
+            if (*p == &waiter) {
+                *p = waiter.next;
+                break;
+            }
+        }
+        core_util_critical_section_exit();
+    }
+#endif
     return count;
 }
 
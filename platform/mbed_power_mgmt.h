@@ -28,6 +28,7 @@
 #include "mbed_toolchain.h"
 #include "hal/ticker_api.h"
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -94,6 +95,32 @@ extern "C" {
 void sleep_tracker_lock(const char *const filename, int line);
 void sleep_tracker_unlock(const char *const filename, int line);
 
+/**
+ * Deep sleep blocker attribution entry, see sleep_manager_get_blockers()
+ */
+typedef struct sleep_manager_blocker {
+    const char *identifier;       /**< File that took the deep sleep lock */
+    uint8_t count;                /**< Number of deep sleep locks currently held by this file */
+    us_timestamp_t time_blocked;  /**< Cumulative time this file has held at least one deep sleep lock */
+} sleep_manager_blocker_t;
+
+/** Enumerate the holders of the deep sleep lock
+ *
+ * Fills the passed array with one entry per file that holds or has held
+ * the deep sleep lock, including the time it has blocked deep sleep so
+ * far - in-progress holds are charged up to the time of the call, so a
+ * driver that never releases its lock is visible immediately.
+ *
+ * Only available when sleep tracing is enabled (MBED_SLEEP_TRACING_ENABLED).
+ *
+ * This function is IRQ and thread safe
+ *
+ * @param blockers A pointer to an array of sleep_manager_blocker_t structures to fill
+ * @param count    The number of sleep_manager_blocker_t structures in the provided array
+ * @return         The number of sleep_manager_blocker_t structures that have been filled
+ */
+size_t sleep_manager_get_blockers(sleep_manager_blocker_t *blockers, size_t count);
+
 #define sleep_manager_lock_deep_sleep()              \
     do                                               \
     {                                                \
@@ -256,6 +283,48 @@ us_timestamp_t mbed_time_idle(void);
  */
 us_timestamp_t mbed_uptime(void);
 
+/** Number of distinct wake sources tracked by the sleep statistics */
+#define MBED_WAKE_SOURCES_MAX    8
+
+/** Buckets in the sleep-residency histograms of mbed_stats_sleep_t.
+ *  Bucket i counts sleeps that lasted [2^i, 2^(i+1)) microseconds, with the
+ *  last bucket also counting everything longer. */
+#define MBED_STATS_SLEEP_HIST_BUCKETS    24
+
+/** One wake source tracked by the sleep statistics */
+typedef struct {
+    int16_t exception;          /**< Cortex-M exception number pending at wake (IRQ number + 16); valid while count is non-zero */
+    uint32_t count;             /**< Wakes attributed to this source */
+} mbed_stats_wake_source_t;
+
+/**
+ * struct mbed_stats_sleep_t definition
+ */
+typedef struct {
+    uint32_t wake_count;            /**< Wakes from sleep or deep sleep since boot */
+    uint32_t untracked_wake_count;  /**< Wakes with no pending vector visible, or beyond MBED_WAKE_SOURCES_MAX distinct sources */
+    mbed_stats_wake_source_t sources[MBED_WAKE_SOURCES_MAX]; /**< Per-source wake counts, filled in order of first appearance */
+    uint32_t sleep_hist[MBED_STATS_SLEEP_HIST_BUCKETS];      /**< Residency histogram of sleeps */
+    uint32_t deep_sleep_hist[MBED_STATS_SLEEP_HIST_BUCKETS]; /**< Residency histogram of deep sleeps */
+    us_timestamp_t last_wake_time;  /**< Timestamp of the most recent wake */
+    int16_t last_wake_exception;    /**< Exception number of the most recent wake, -1 if none was pending */
+} mbed_stats_sleep_t;
+
+/** Fill the passed structure with the wake and sleep-residency statistics.
+ *
+ *  The sleep manager records the pending exception number and timestamp on
+ *  every wake exit, so chatty wake sources show up in a telemetry dump
+ *  instead of needing a logic analyzer.
+ *
+ *  @param stats    A pointer to the mbed_stats_sleep_t structure to fill
+ *
+ *  @note  Requires MBED_SLEEP_STATS_ENABLED, returns zeroed stats otherwise.
+ *  @note  Timestamps and residency durations work only if platform supports
+ *         LP ticker and MBED_CPU_STATS_ENABLED is set; wake counts and
+ *         attribution work regardless.
+ */
+void mbed_stats_sleep_get(mbed_stats_sleep_t *stats);
+
 /** @}*/
 
 /** Resets the processor and most of the sub-system
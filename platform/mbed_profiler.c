@@ -0,0 +1,107 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_profiler.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_assert.h"
+
+#include <string.h>
+
+#if defined(MBED_PROFILER_ENABLED) && defined(DWT_CTRL_CYCCNTENA_Msk)
+
+/* Terminator distinct from NULL, so a registered site always has a
+ * non-NULL next pointer and the hot path in mbed_profiler_exit can test
+ * registration with a single compare. */
+static mbed_profiler_site_t site_list_end;
+static mbed_profiler_site_t *site_list = &site_list_end;
+
+void mbed_profiler_init(void)
+{
+    /* Trace must be enabled before any DWT register takes effect. */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+void mbed_profiler_register_site(mbed_profiler_site_t *site)
+{
+    core_util_critical_section_enter();
+    /* The first hit can race from two contexts; only link the site once. */
+    if (site->next == NULL) {
+        site->next = site_list;
+        site_list = site;
+    }
+    core_util_critical_section_exit();
+}
+
+size_t mbed_profiler_stats_get_each(mbed_profiler_stats_t *stats, size_t count)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, count * sizeof(mbed_profiler_stats_t));
+
+    size_t i = 0;
+
+    core_util_critical_section_enter();
+    for (mbed_profiler_site_t *site = site_list; site != &site_list_end && i < count; site = site->next) {
+        stats[i].name = site->name;
+        stats[i].count = site->count;
+        stats[i].min_cycles = site->min_cycles;
+        stats[i].max_cycles = site->max_cycles;
+        stats[i].total_cycles = site->total_cycles;
+        stats[i].mean_cycles = (site->count != 0) ? (uint32_t)(site->total_cycles / site->count) : 0;
+        i++;
+    }
+    core_util_critical_section_exit();
+
+    return i;
+}
+
+void mbed_profiler_reset(void)
+{
+    core_util_critical_section_enter();
+    for (mbed_profiler_site_t *site = site_list; site != &site_list_end; site = site->next) {
+        site->count = 0;
+        site->min_cycles = 0xFFFFFFFF;
+        site->max_cycles = 0;
+        site->total_cycles = 0;
+    }
+    core_util_critical_section_exit();
+}
+
+#else
+
+void mbed_profiler_init(void)
+{
+}
+
+void mbed_profiler_register_site(mbed_profiler_site_t *site)
+{
+    (void)site;
+}
+
+size_t mbed_profiler_stats_get_each(mbed_profiler_stats_t *stats, size_t count)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, count * sizeof(mbed_profiler_stats_t));
+    return 0;
+}
+
+void mbed_profiler_reset(void)
+{
+}
+
+#endif // defined(MBED_PROFILER_ENABLED) && defined(DWT_CTRL_CYCCNTENA_Msk)
@@ -0,0 +1,195 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_PROFILER_H
+#define MBED_PROFILER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef MBED_PROFILER_ENABLED
+#include "cmsis.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_profiler profiler functions
+ *
+ * A cycle-accurate scoped profiler built on the Cortex-M DWT cycle
+ * counter, for microbenchmarking hot code paths in place. Each measured
+ * location owns a static site record; entering and leaving the scope
+ * costs a couple of cycle counter reads plus a handful of instructions,
+ * cheap enough to leave in production images. Per-site count, min, max
+ * and total cycles are aggregated in the site and retrieved as a table
+ * with mbed_profiler_stats_get_each, in the manner of
+ * mbed_stats_stack_get_each.
+ *
+ * The profiler is compiled out unless MBED_PROFILER_ENABLED is set
+ * (platform.profiler-enabled). On cores without a DWT cycle counter
+ * (Cortex-M0/M0+/M23) the enter/exit calls compile to nothing and no
+ * sites are reported, matching the cpu_cycles convention of
+ * mbed_stats_thread_t.
+ *
+ * From C, declare a site and bracket the code of interest:
+ *
+ * @code
+ * static mbed_profiler_site_t dispatch_site =
+ *     MBED_PROFILER_SITE_INIT("equeue_dispatch");
+ *
+ * uint32_t start = mbed_profiler_enter();
+ * equeue_dispatch(&queue, ms);
+ * mbed_profiler_exit(&dispatch_site, start);
+ * @endcode
+ *
+ * C++ code can use the ScopedProfiler RAII wrapper instead (see
+ * ScopedProfiler.h).
+ *
+ * @note Synchronization level: Interrupt safe for disjoint sites. Hits
+ *       on the same site from concurrent contexts may lose individual
+ *       samples, which is acceptable for profiling; the table retrieval
+ *       functions themselves are protected.
+ * @{
+ */
+
+/**
+ * A measurement site. Define one statically per measured location with
+ * MBED_PROFILER_SITE_INIT; all fields other than name are managed by the
+ * profiler.
+ */
+typedef struct mbed_profiler_site {
+    const char *name;               /**< site name reported in the stats table */
+    uint32_t count;                 /**< number of recorded entries */
+    uint32_t min_cycles;            /**< shortest recorded visit in cycles */
+    uint32_t max_cycles;            /**< longest recorded visit in cycles */
+    uint64_t total_cycles;          /**< sum of all recorded visits in cycles */
+    struct mbed_profiler_site *next;    /**< registration link, leave NULL */
+} mbed_profiler_site_t;
+
+/** Static initializer for an mbed_profiler_site_t. */
+#define MBED_PROFILER_SITE_INIT(name)   { name, 0, 0xFFFFFFFF, 0, 0, NULL }
+
+/**
+ * struct mbed_profiler_stats_t definition
+ */
+typedef struct {
+    const char *name;           /**< Name of the measurement site */
+    uint32_t count;             /**< Number of times the site was executed */
+    uint32_t min_cycles;        /**< Shortest execution of the site in CPU cycles */
+    uint32_t max_cycles;        /**< Longest execution of the site in CPU cycles */
+    uint32_t mean_cycles;       /**< Mean execution time of the site in CPU cycles */
+    uint64_t total_cycles;      /**< CPU cycles spent in the site in total */
+} mbed_profiler_stats_t;
+
+/**
+ * Start the DWT cycle counter the profiler reads its timestamps from.
+ * Call once at startup before the first measured scope runs; safe to
+ * call again. Does nothing when the profiler is disabled or the core
+ * has no cycle counter.
+ */
+void mbed_profiler_init(void);
+
+/**
+ *  Fill the passed array of stat structures with the statistics of each
+ *  measurement site that has been hit since startup (or the last reset).
+ *
+ *  @param stats    A pointer to an array of mbed_profiler_stats_t structures to fill
+ *  @param count    The number of mbed_profiler_stats_t structures in the provided array
+ *  @return         The number of mbed_profiler_stats_t structures that have been filled.
+ *                  If the number of sites is less than or equal to count, it will equal
+ *                  the number of sites; otherwise it will equal count.
+ */
+size_t mbed_profiler_stats_get_each(mbed_profiler_stats_t *stats, size_t count);
+
+/**
+ * Clear the accumulated statistics of every registered site, so the next
+ * retrieval covers a fresh measurement window.
+ */
+void mbed_profiler_reset(void);
+
+/**
+ * Add a site to the table of registered sites. Called automatically by
+ * mbed_profiler_exit on a site's first hit; there is no need to call it
+ * directly.
+ *
+ * @param site the site to register.
+ */
+void mbed_profiler_register_site(mbed_profiler_site_t *site);
+
+#if (defined(MBED_PROFILER_ENABLED) && defined(DWT_CTRL_CYCCNTENA_Msk)) || defined(DOXYGEN_ONLY)
+
+/**
+ * Take the cycle count at entry to a measured scope.
+ *
+ * @return the current DWT cycle count, to pass to mbed_profiler_exit.
+ */
+static inline uint32_t mbed_profiler_enter(void)
+{
+    return DWT->CYCCNT;
+}
+
+/**
+ * Record one visit to a measured scope. The 32-bit cycle counter wraps,
+ * so scopes measured this way must be shorter than 2^32 cycles.
+ *
+ * @param site the site being measured.
+ * @param start the value mbed_profiler_enter returned at scope entry.
+ */
+static inline void mbed_profiler_exit(mbed_profiler_site_t *site, uint32_t start)
+{
+    uint32_t elapsed = DWT->CYCCNT - start;
+    if (site->next == NULL) {
+        mbed_profiler_register_site(site);
+    }
+    site->count += 1;
+    site->total_cycles += elapsed;
+    if (elapsed < site->min_cycles) {
+        site->min_cycles = elapsed;
+    }
+    if (elapsed > site->max_cycles) {
+        site->max_cycles = elapsed;
+    }
+}
+
+#else
+
+static inline uint32_t mbed_profiler_enter(void)
+{
+    return 0;
+}
+
+static inline void mbed_profiler_exit(mbed_profiler_site_t *site, uint32_t start)
+{
+    (void)site;
+    (void)start;
+}
+
+#endif
+
+/** @}*/
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // #ifndef MBED_PROFILER_H
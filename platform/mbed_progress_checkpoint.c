@@ -0,0 +1,49 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed_progress_checkpoint.h"
+#include "mbed_critical.h"
+
+#ifdef MBED_CONF_RTOS_PRESENT
+#include "cmsis_os2.h"
+#endif
+
+static void (*checkpoint_hook)(void);
+
+void mbed_progress_checkpoint_set_hook(void (*hook)(void))
+{
+    checkpoint_hook = hook;
+}
+
+void mbed_progress_checkpoint(void)
+{
+    /* Snapshot so an unregister while we run cannot leave a torn call */
+    void (*hook)(void) = checkpoint_hook;
+    if (hook) {
+        hook();
+    }
+
+#ifdef MBED_CONF_RTOS_PRESENT
+    /* Let same-priority threads run, so a long operation cannot starve
+     * them for its whole duration. Nothing to yield to outside thread
+     * context or before the kernel is up. */
+    if (!core_util_is_isr_active() && !core_util_in_critical_section() &&
+            osKernelGetState() == osKernelRunning) {
+        osThreadYield();
+    }
+#endif
+}
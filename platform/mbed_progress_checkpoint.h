@@ -0,0 +1,67 @@
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_progress_checkpoint Progress checkpoint functions
+ * @{
+ */
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_PROGRESS_CHECKPOINT_H
+#define MBED_PROGRESS_CHECKPOINT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Register a hook to run at every progress checkpoint.
+ *
+ * Long-running operations (flash erase loops, storage garbage collection)
+ * call mbed_progress_checkpoint() between bounded units of work. An
+ * application that runs a watchdog registers a hook here that kicks it, so
+ * the watchdog timeout only needs to cover one unit of work rather than
+ * the whole operation.
+ *
+ * The hook runs in the context of whatever thread hit the checkpoint and
+ * must be short and ISR-safe in spirit: kick the watchdog, update a
+ * progress flag, nothing blocking.
+ *
+ * @param hook Hook to run at each checkpoint, or NULL to unregister
+ */
+void mbed_progress_checkpoint_set_hook(void (*hook)(void));
+
+/** Report forward progress from inside a long-running operation.
+ *
+ * Runs the registered hook (if any), then yields to ready threads of the
+ * same priority when called from thread context with the kernel running.
+ * Called by the long loops in the SDK; loops added in application or
+ * library code are encouraged to call it too, roughly once per bounded
+ * unit of work (one sector erase, one record copy).
+ *
+ * Safe to call from any context; outside a running thread it reduces to
+ * just the hook.
+ */
+void mbed_progress_checkpoint(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
+
+/** @}*/
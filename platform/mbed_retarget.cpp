@@ -103,25 +103,33 @@ uint32_t mbed_heap_size = 0;
 /* newlib has the filehandle field in the FILE struct as a short, so
  * we can't just return a Filehandle* from _open and instead have to
  * put it in a filehandles array and return the index into that array
+ *
+ * Slots are claimed and released with atomic compare-and-swap rather
+ * than a mutex, so fd allocation and per-fd lookup never serialize
+ * concurrent file I/O from multiple threads
  */
-static FileHandle *filehandles[OPEN_MAX] = { FILE_HANDLE_RESERVED, FILE_HANDLE_RESERVED, FILE_HANDLE_RESERVED };
+static FileHandle *volatile filehandles[OPEN_MAX] = { FILE_HANDLE_RESERVED, FILE_HANDLE_RESERVED, FILE_HANDLE_RESERVED };
 static char stdio_in_prev[OPEN_MAX];
 static char stdio_out_prev[OPEN_MAX];
-static SingletonPtr<PlatformMutex> filehandle_mutex;
+
+/* Atomically swing a filehandle slot from expected to desired */
+static bool filehandle_cas(unsigned int fh_i, FileHandle *expected, FileHandle *desired)
+{
+    void *current = expected;
+    return core_util_atomic_cas_ptr(
+               reinterpret_cast<void *volatile *>(&filehandles[fh_i]),
+               &current, desired);
+}
 
 namespace mbed {
 void mbed_set_unbuffered_stream(std::FILE *_file);
 
 void remove_filehandle(FileHandle *file)
 {
-    filehandle_mutex->lock();
     /* Remove all open filehandles for this */
     for (unsigned int fh_i = 0; fh_i < sizeof(filehandles) / sizeof(*filehandles); fh_i++) {
-        if (filehandles[fh_i] == file) {
-            filehandles[fh_i] = NULL;
-        }
+        filehandle_cas(fh_i, file, NULL);
     }
-    filehandle_mutex->unlock();
 }
 }
 
@@ -204,8 +212,94 @@ short DirectSerial::poll(short events) const
     }
     return revents;
 }
+
+#if MBED_CONF_PLATFORM_STDIO_NONBLOCKING_SERIAL
+
+static uint32_t stdio_tx_dropped_count = 0;
+
+/* DirectSerial variant whose write() never blocks: bytes go into a TX ring
+ * drained by the TX interrupt, so a log line costs a memcpy instead of one
+ * blocking serial_putc per character, and logging from critical contexts or
+ * time-sensitive threads does not stall on the UART. When the ring is full
+ * the oldest queued bytes are dropped and counted - under overload losing
+ * stale log data is preferable to deforming real-time behaviour.
+ */
+class NonBlockingDirectSerial : public DirectSerial {
+public:
+    NonBlockingDirectSerial(PinName tx, PinName rx, int baud);
+    virtual ssize_t write(const void *buffer, size_t size);
+    virtual short poll(short events) const;
+private:
+    static void tx_irq(uint32_t id, SerialIrq event);
+    unsigned char _txbuf[MBED_CONF_PLATFORM_STDIO_NONBLOCKING_BUFFER_SIZE];
+    volatile size_t _head;
+    volatile size_t _tail;
+};
+
+NonBlockingDirectSerial::NonBlockingDirectSerial(PinName tx, PinName rx, int baud) :
+    DirectSerial(tx, rx, baud), _head(0), _tail(0)
+{
+    serial_irq_handler(&stdio_uart, &NonBlockingDirectSerial::tx_irq, (uint32_t)this);
+}
+
+ssize_t NonBlockingDirectSerial::write(const void *buffer, size_t size)
+{
+    const unsigned char *buf = static_cast<const unsigned char *>(buffer);
+    core_util_critical_section_enter();
+    for (size_t i = 0; i < size; i++) {
+        size_t next = (_head + 1) % sizeof(_txbuf);
+        if (next == _tail) {
+            // Ring full - drop the oldest byte rather than block
+            _tail = (_tail + 1) % sizeof(_txbuf);
+            stdio_tx_dropped_count++;
+        }
+        _txbuf[_head] = buf[i];
+        _head = next;
+    }
+    serial_irq_set(&stdio_uart, TxIrq, 1);
+    core_util_critical_section_exit();
+    return size;
+}
+
+void NonBlockingDirectSerial::tx_irq(uint32_t id, SerialIrq event)
+{
+    NonBlockingDirectSerial *self = reinterpret_cast<NonBlockingDirectSerial *>(id);
+    if (event != TxIrq) {
+        return;
+    }
+    while (self->_tail != self->_head && serial_writable(&stdio_uart)) {
+        serial_putc(&stdio_uart, self->_txbuf[self->_tail]);
+        self->_tail = (self->_tail + 1) % sizeof(self->_txbuf);
+    }
+    if (self->_tail == self->_head) {
+        serial_irq_set(&stdio_uart, TxIrq, 0);
+    }
+}
+
+short NonBlockingDirectSerial::poll(short events) const
+{
+    short revents = 0;
+    if ((events & POLLIN) && serial_readable(&stdio_uart)) {
+        revents |= POLLIN;
+    }
+    if (events & POLLOUT) {
+        // Writes are always accepted, at worst dropping the oldest bytes
+        revents |= POLLOUT;
+    }
+    return revents;
+}
+#endif // MBED_CONF_PLATFORM_STDIO_NONBLOCKING_SERIAL
 #endif
 
+extern "C" uint32_t mbed_stdio_tx_dropped(void)
+{
+#if DEVICE_SERIAL && MBED_CONF_PLATFORM_STDIO_NONBLOCKING_SERIAL
+    return stdio_tx_dropped_count;
+#else
+    return 0;
+#endif
+}
+
 class Sink : public FileHandle {
 public:
     virtual ssize_t write(const void *buffer, size_t size);
@@ -257,7 +351,9 @@ MBED_WEAK FileHandle *mbed::mbed_override_console(int fd)
 static FileHandle *default_console()
 {
 #if DEVICE_SERIAL
-#  if MBED_CONF_PLATFORM_STDIO_BUFFERED_SERIAL
+#  if MBED_CONF_PLATFORM_STDIO_NONBLOCKING_SERIAL
+    static NonBlockingDirectSerial console(STDIO_UART_TX, STDIO_UART_RX, MBED_CONF_PLATFORM_STDIO_BAUD_RATE);
+#  elif MBED_CONF_PLATFORM_STDIO_BUFFERED_SERIAL
     static UARTSerial console(STDIO_UART_TX, STDIO_UART_RX, MBED_CONF_PLATFORM_STDIO_BAUD_RATE);
 #   if   CONSOLE_FLOWCONTROL == CONSOLE_FLOWCONTROL_RTS
     console.set_flow_control(SerialBase::RTS, STDIO_UART_RTS, NC);
@@ -297,7 +393,13 @@ static FileHandle *get_fhc(int fd)
     }
     FileHandle *fh = filehandles[fd];
     if (fh == FILE_HANDLE_RESERVED && fd < 3) {
-        filehandles[fd] = fh = get_console(fd);
+        /* CAS so racing auto-binds agree on a single console handle */
+        FileHandle *console = get_console(fd);
+        if (filehandle_cas(fd, FILE_HANDLE_RESERVED, console)) {
+            fh = console;
+        } else {
+            fh = filehandles[fd];
+        }
     }
     return fh;
 }
@@ -368,24 +470,17 @@ static inline int openflags_to_posix(int openflags)
 static int reserve_filehandle()
 {
     // find the first empty slot in filehandles, after the slots reserved for stdin/stdout/stderr
-    filehandle_mutex->lock();
-    int fh_i;
-    for (fh_i = 3; fh_i < OPEN_MAX; fh_i++) {
-        /* Take a next free filehandle slot available. */
-        if (filehandles[fh_i] == NULL) {
-            break;
+    for (int fh_i = 3; fh_i < OPEN_MAX; fh_i++) {
+        /* Claim the slot atomically - a failed CAS means another thread
+         * got there first, so move on to the next slot */
+        if (filehandle_cas(fh_i, NULL, FILE_HANDLE_RESERVED)) {
+            return fh_i;
         }
     }
-    if (fh_i >= OPEN_MAX) {
-        /* Too many file handles have been opened */
-        errno = EMFILE;
-        filehandle_mutex->unlock();
-        return -1;
-    }
-    filehandles[fh_i] = FILE_HANDLE_RESERVED;
-    filehandle_mutex->unlock();
 
-    return fh_i;
+    /* Too many file handles have been opened */
+    errno = EMFILE;
+    return -1;
 }
 
 int mbed::bind_to_fd(FileHandle *fh)
@@ -404,8 +499,7 @@ int mbed::bind_to_fd(FileHandle *fh)
 
 static int unbind_from_fd(int fd, FileHandle *fh)
 {
-    if (filehandles[fd] == fh) {
-        filehandles[fd] = NULL;
+    if (filehandle_cas(fd, fh, NULL)) {
         return 0;
     } else {
         errno = EBADF;
@@ -531,6 +531,16 @@ struct pollfd {
 #if __cplusplus
 extern "C" {
 #endif
+    /** Number of bytes dropped from the console TX ring since boot
+     *
+     * Only meaningful with platform.stdio-nonblocking-serial, where console
+     * writes never block and the oldest queued bytes are discarded when the
+     * ring overflows; always 0 with the other console backends.
+     *
+     * @return Total count of dropped console TX bytes
+     */
+    uint32_t mbed_stdio_tx_dropped(void);
+
     int open(const char *path, int oflag, ...);
 #ifndef __IAR_SYSTEMS_ICC__ /* IAR provides fdopen itself */
 #if __cplusplus
@@ -21,6 +21,13 @@
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
 
+#if DEVICE_USTICKER
+#include "hal/ticker_api.h"
+#include "hal/us_ticker_api.h"
+#endif
+
+#define US_PER_SEC 1000000
+
 static SingletonPtr<PlatformMutex> _mutex;
 
 #if DEVICE_RTC
@@ -34,8 +41,6 @@ static void (*_rtc_write)(time_t t) = rtc_write;
 
 #include "drivers/LowPowerTimer.h"
 
-#define US_PER_SEC 1000000
-
 static SingletonPtr<mbed::LowPowerTimer> _rtc_lp_timer;
 static uint64_t _rtc_lp_base;
 static bool _rtc_enabled;
@@ -104,6 +109,49 @@ time_t time(time_t *timer)
     return t;
 }
 
+/* timestamp64_us() rebase state - microseconds since epoch at the last
+ * rebase and the monotonic tick the rebase was taken at. */
+static uint64_t _timestamp_base_us;
+static uint64_t _timestamp_base_tick;
+static bool _timestamp_valid;
+
+uint64_t timestamp64_us(void)
+{
+#if DEVICE_USTICKER
+    const uint64_t now = ticker_read_us(get_us_ticker_data());
+
+    core_util_critical_section_enter();
+    if (!_timestamp_valid || ((now - _timestamp_base_tick) >= US_PER_SEC)) {
+        /* At most once per RTC second, re-read the RTC and rebase. The base
+         * never moves backwards, so the output stays monotonic even when the
+         * RTC and the ticker drift apart. */
+        uint64_t rtc_us = 0;
+        if (_rtc_read != NULL) {
+            rtc_us = (uint64_t)_rtc_read() * US_PER_SEC;
+        }
+        const uint64_t derived_us = _timestamp_valid ? (_timestamp_base_us + (now - _timestamp_base_tick)) : 0;
+        _timestamp_base_us = (rtc_us > derived_us) ? rtc_us : derived_us;
+        _timestamp_base_tick = now;
+        _timestamp_valid = true;
+    }
+    const uint64_t result = _timestamp_base_us + (now - _timestamp_base_tick);
+    core_util_critical_section_exit();
+
+    return result;
+#else
+    /* No high resolution ticker - fall back to whole RTC seconds. */
+    uint64_t result = 0;
+
+    core_util_critical_section_enter();
+    if (_rtc_read != NULL) {
+        result = (uint64_t)_rtc_read() * US_PER_SEC;
+    }
+    core_util_critical_section_exit();
+
+    return result;
+#endif
+}
+
 void set_time(time_t t)
 {
     _mutex->lock();
@@ -113,6 +161,8 @@ void set_time(time_t t)
     if (_rtc_write != NULL) {
         _rtc_write(t);
     }
+    /* Resynchronize timestamp64_us() with the new time on its next call. */
+    _timestamp_valid = false;
     _mutex->unlock();
 }
 
@@ -123,6 +173,8 @@ void attach_rtc(time_t (*read_rtc)(void), void (*write_rtc)(time_t), void (*init
     _rtc_write = write_rtc;
     _rtc_init = init_rtc;
     _rtc_isenabled = isenabled_rtc;
+    /* Resynchronize timestamp64_us() with the new clock on its next call. */
+    _timestamp_valid = false;
     _mutex->unlock();
 }
 
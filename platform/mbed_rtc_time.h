@@ -23,6 +23,7 @@
  */
 
 #include <time.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -79,6 +80,24 @@ extern "C" {
  */
 void set_time(time_t t);
 
+/** Read the current time as a 64-bit microsecond timestamp
+ *
+ * Combines the RTC calendar time with the high resolution monotonic ticker:
+ * the RTC is consulted at most once per second to rebase the mapping, and
+ * every other call is a ticker read plus an addition - much cheaper than
+ * time() for timestamp-heavy users such as log records. The returned value
+ * never moves backwards while the clock runs; set_time() and attach_rtc()
+ * resynchronize the mapping on the next call.
+ *
+ * When no high resolution ticker is available (DEVICE_USTICKER not present)
+ * the timestamp falls back to whole-second resolution.
+ *
+ * @return Microseconds since January 1, 1970 (the UNIX timestamp scaled to microseconds)
+ *
+ * @note Synchronization level: Interrupt safe
+ */
+uint64_t timestamp64_us(void);
+
 /** Attach an external RTC to be used for the C time functions
  *
  * @note Synchronization level: Thread safe
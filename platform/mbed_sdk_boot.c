@@ -16,6 +16,7 @@
  */
 
 #include "mbed_toolchain.h"
+#include "mbed_stats.h"
 #include <stdlib.h>
 #include <stdint.h>
 #include "cmsis.h"
@@ -74,14 +75,18 @@ int $Super$$main(void);
 
 int $Sub$$main(void)
 {
+    mbed_boot_milestone(MBED_BOOT_MILESTONE_TOOLCHAIN_INIT);
     mbed_main();
+    mbed_boot_milestone(MBED_BOOT_MILESTONE_MAIN);
     return $Super$$main();
 }
 
 void _platform_post_stackheap_init(void)
 {
+    mbed_boot_milestone(MBED_BOOT_MILESTONE_BOOT);
     mbed_copy_nvic();
     mbed_sdk_init();
+    mbed_boot_milestone(MBED_BOOT_MILESTONE_SDK_INIT);
 }
 
 #elif defined (__GNUC__)
@@ -90,15 +95,19 @@ extern int __real_main(void);
 
 void software_init_hook(void)
 {
+    mbed_boot_milestone(MBED_BOOT_MILESTONE_BOOT);
     mbed_copy_nvic();
     mbed_sdk_init();
+    mbed_boot_milestone(MBED_BOOT_MILESTONE_SDK_INIT);
     software_init_hook_rtos();
 }
 
 
 int __wrap_main(void)
 {
+    mbed_boot_milestone(MBED_BOOT_MILESTONE_TOOLCHAIN_INIT);
     mbed_main();
+    mbed_boot_milestone(MBED_BOOT_MILESTONE_MAIN);
     return __real_main();
 }
 
@@ -1,7 +1,9 @@
 #include "mbed_assert.h"
 #include "mbed_stats.h"
+#include "mbed_toolchain.h"
 #include "mbed_power_mgmt.h"
 #include "mbed_version.h"
+#include "hal/us_ticker_api.h"
 #include <string.h>
 #include <stdlib.h>
 
@@ -9,6 +11,7 @@
 #ifdef MBED_CONF_RTOS_PRESENT
 #include "cmsis_os2.h"
 #include "rtos_idle.h"
+#include "rtos_handlers.h"
 #elif defined(MBED_STACK_STATS_ENABLED) || defined(MBED_THREAD_STATS_ENABLED) || defined(MBED_CPU_STATS_ENABLED)
 #warning Statistics are currently not supported without the rtos.
 #endif
@@ -29,6 +32,21 @@ void mbed_stats_cpu_get(mbed_stats_cpu_t *stats)
 #endif
 }
 
+#if defined(MBED_CONF_RTOS_PRESENT) && (defined(MBED_STACK_STATS_ENABLED) || defined(MBED_THREAD_STATS_ENABLED))
+static uint32_t thread_stack_usage(osThreadId_t id, uint32_t stack_size)
+{
+#if defined(MBED_THREAD_STATS_ENABLED)
+    // O(1) watermark sampled at context switch; 0 until the thread has been
+    // switched in, in which case fall back to scanning the painted stack
+    uint32_t used = rtos_thread_stack_watermark(id);
+    if (used != 0) {
+        return used;
+    }
+#endif
+    return stack_size - osThreadGetStackSpace(id);
+}
+#endif
+
 // note: mbed_stats_heap_get defined in mbed_alloc_wrappers.cpp
 void mbed_stats_stack_get(mbed_stats_stack_t *stats)
 {
@@ -51,7 +69,7 @@ void mbed_stats_stack_get(mbed_stats_stack_t *stats)
 
     for (i = 0; i < thread_n; i++) {
         uint32_t stack_size = osThreadGetStackSize(threads[i]);
-        stats->max_size += stack_size - osThreadGetStackSpace(threads[i]);
+        stats->max_size += thread_stack_usage(threads[i], stack_size);
         stats->reserved_size += stack_size;
         stats->stack_cnt++;
     }
@@ -82,7 +100,7 @@ size_t mbed_stats_stack_get_each(mbed_stats_stack_t *stats, size_t count)
 
     for (i = 0; i < count; i++) {
         uint32_t stack_size = osThreadGetStackSize(threads[i]);
-        stats[i].max_size = stack_size - osThreadGetStackSpace(threads[i]);
+        stats[i].max_size = thread_stack_usage(threads[i], stack_size);
         stats[i].reserved_size = stack_size;
         stats[i].thread_id = (uint32_t)threads[i];
         stats[i].stack_cnt = 1;
@@ -115,9 +133,11 @@ size_t mbed_stats_thread_get_each(mbed_stats_thread_t *stats, size_t count)
         stats[i].state = (uint32_t)osThreadGetState(threads[i]);
         stats[i].priority = (uint32_t)osThreadGetPriority(threads[i]);
         stats[i].stack_size = osThreadGetStackSize(threads[i]);
-        stats[i].stack_space = osThreadGetStackSpace(threads[i]);
+        stats[i].stack_space = stats[i].stack_size - thread_stack_usage(threads[i], stats[i].stack_size);
         stats[i].name = osThreadGetName(threads[i]);
+        rtos_thread_cpu_stats(threads[i], &stats[i].cpu_cycles, &stats[i].cpu_used);
     }
+    rtos_thread_cpu_stats_reset();
     osKernelUnlock();
     free(threads);
 #endif
@@ -181,3 +201,171 @@ void mbed_stats_sys_get(mbed_stats_sys_t *stats)
 #endif
     return;
 }
+
+MBED_WEAK void mbed_stats_cache_target_update(mbed_stats_cache_t *stats)
+{
+    // Targets with a flash accelerator or cache event counters override this
+    (void)stats;
+}
+
+void mbed_stats_cache_get(mbed_stats_cache_t *stats)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, sizeof(mbed_stats_cache_t));
+
+#if defined(MBED_CACHE_STATS_ENABLED)
+#if defined(__ICACHE_PRESENT) && (__ICACHE_PRESENT == 1U)
+    stats->icache_enabled = (SCB->CCR & SCB_CCR_IC_Msk) ? 1 : 0;
+    {
+        // Geometry from the level 1 instruction cache ID register:
+        // line size in bytes is 4 * 2^(LineSize field + 2)
+        SCB->CSSELR = 1U;
+        __DSB();
+        uint32_t ccsidr = SCB->CCSIDR;
+        stats->icache_size = (CCSIDR_SETS(ccsidr) + 1U) * (CCSIDR_WAYS(ccsidr) + 1U) *
+                             (16U << (ccsidr & 0x7U));
+    }
+#endif
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    stats->dcache_enabled = (SCB->CCR & SCB_CCR_DC_Msk) ? 1 : 0;
+    {
+        SCB->CSSELR = 0U;
+        __DSB();
+        uint32_t ccsidr = SCB->CCSIDR;
+        stats->dcache_line_size = 16U << (ccsidr & 0x7U);
+        stats->dcache_size = (CCSIDR_SETS(ccsidr) + 1U) * (CCSIDR_WAYS(ccsidr) + 1U) *
+                             stats->dcache_line_size;
+    }
+#endif
+    mbed_stats_cache_target_update(stats);
+#endif
+}
+
+void mbed_stats_snapshot(mbed_stats_snapshot_t *snapshot)
+{
+    MBED_ASSERT(snapshot != NULL);
+    memset(snapshot, 0, sizeof(mbed_stats_snapshot_t));
+
+    /* The static families cannot tear - gather them outside the window to
+     * keep it short */
+    mbed_stats_sys_get(&snapshot->sys);
+    mbed_stats_cache_get(&snapshot->cache);
+#if defined(MBED_SYS_STATS_ENABLED)
+    snapshot->captured |= MBED_STATS_SNAPSHOT_SYS;
+#endif
+#if defined(MBED_CACHE_STATS_ENABLED)
+    snapshot->captured |= MBED_STATS_SNAPSHOT_CACHE;
+#endif
+
+#if defined(MBED_STACK_STATS_ENABLED) && defined(MBED_CONF_RTOS_PRESENT)
+    /* The enumeration buffer has to be allocated before the heap lock is
+     * taken. A thread created between here and the walk is left out */
+    uint32_t thread_n = osThreadGetCount();
+    osThreadId_t *threads = malloc(sizeof(osThreadId_t) * thread_n);
+#endif
+
+    /* One bounded window for everything that moves: the heap statistics
+     * lock keeps mid-update allocators out, the kernel lock freezes the
+     * thread picture. No probing and no allocation happens inside */
+    mbed_stats_heap_lock();
+#ifdef MBED_CONF_RTOS_PRESENT
+    osKernelLock();
+#endif
+
+    snapshot->timestamp = ticker_read_us(get_us_ticker_data());
+
+#if defined(MBED_HEAP_STATS_ENABLED)
+    mbed_stats_heap_copy(&snapshot->heap);
+    snapshot->captured |= MBED_STATS_SNAPSHOT_HEAP;
+#endif
+
+#if defined(MBED_STACK_STATS_ENABLED) && defined(MBED_CONF_RTOS_PRESENT)
+    if (threads != NULL) {
+        unsigned i;
+        thread_n = osThreadEnumerate(threads, thread_n);
+        for (i = 0; i < thread_n; i++) {
+            uint32_t stack_size = osThreadGetStackSize(threads[i]);
+            snapshot->stack.max_size += thread_stack_usage(threads[i], stack_size);
+            snapshot->stack.reserved_size += stack_size;
+            snapshot->stack.stack_cnt++;
+        }
+        snapshot->captured |= MBED_STATS_SNAPSHOT_STACK;
+    }
+#endif
+
+#if defined(MBED_CPU_STATS_ENABLED) && DEVICE_LPTICKER && DEVICE_SLEEP
+    snapshot->cpu.uptime = mbed_uptime();
+    snapshot->cpu.idle_time = mbed_time_idle();
+    snapshot->cpu.sleep_time = mbed_time_sleep();
+    snapshot->cpu.deep_sleep_time = mbed_time_deepsleep();
+    snapshot->captured |= MBED_STATS_SNAPSHOT_CPU;
+#endif
+
+#ifdef MBED_CONF_RTOS_PRESENT
+    osKernelUnlock();
+#endif
+    mbed_stats_heap_unlock();
+
+#if defined(MBED_STACK_STATS_ENABLED) && defined(MBED_CONF_RTOS_PRESENT)
+    free(threads);
+#endif
+}
+
+void mbed_stats_snapshot_delta(const mbed_stats_snapshot_t *newer, const mbed_stats_snapshot_t *older, mbed_stats_snapshot_t *delta)
+{
+    unsigned i;
+
+    MBED_ASSERT(newer != NULL);
+    MBED_ASSERT(older != NULL);
+    MBED_ASSERT(delta != NULL);
+
+    delta->timestamp = newer->timestamp - older->timestamp;
+    delta->captured = newer->captured & older->captured;
+
+    delta->heap.current_size = newer->heap.current_size - older->heap.current_size;
+    delta->heap.max_size = newer->heap.max_size - older->heap.max_size;
+    delta->heap.total_size = newer->heap.total_size - older->heap.total_size;
+    delta->heap.reserved_size = newer->heap.reserved_size - older->heap.reserved_size;
+    delta->heap.alloc_cnt = newer->heap.alloc_cnt - older->heap.alloc_cnt;
+    delta->heap.alloc_fail_cnt = newer->heap.alloc_fail_cnt - older->heap.alloc_fail_cnt;
+    delta->heap.overhead_size = newer->heap.overhead_size - older->heap.overhead_size;
+    delta->heap.largest_free_block = newer->heap.largest_free_block - older->heap.largest_free_block;
+    delta->heap.free_block_cnt = newer->heap.free_block_cnt - older->heap.free_block_cnt;
+    for (i = 0; i < MBED_STATS_HEAP_ALLOC_HIST_BUCKETS; i++) {
+        delta->heap.alloc_size_hist[i] = newer->heap.alloc_size_hist[i] - older->heap.alloc_size_hist[i];
+    }
+
+    delta->stack.thread_id = newer->stack.thread_id - older->stack.thread_id;
+    delta->stack.max_size = newer->stack.max_size - older->stack.max_size;
+    delta->stack.reserved_size = newer->stack.reserved_size - older->stack.reserved_size;
+    delta->stack.stack_cnt = newer->stack.stack_cnt - older->stack.stack_cnt;
+
+    delta->cpu.uptime = newer->cpu.uptime - older->cpu.uptime;
+    delta->cpu.idle_time = newer->cpu.idle_time - older->cpu.idle_time;
+    delta->cpu.sleep_time = newer->cpu.sleep_time - older->cpu.sleep_time;
+    delta->cpu.deep_sleep_time = newer->cpu.deep_sleep_time - older->cpu.deep_sleep_time;
+
+    delta->sys.os_version = newer->sys.os_version - older->sys.os_version;
+    delta->sys.cpu_id = newer->sys.cpu_id - older->sys.cpu_id;
+    delta->sys.compiler_id = (mbed_compiler_id_t)(newer->sys.compiler_id - older->sys.compiler_id);
+    delta->sys.compiler_version = newer->sys.compiler_version - older->sys.compiler_version;
+    for (i = 0; i < MBED_MAX_MEM_REGIONS; i++) {
+        delta->sys.ram_start[i] = newer->sys.ram_start[i] - older->sys.ram_start[i];
+        delta->sys.ram_size[i] = newer->sys.ram_size[i] - older->sys.ram_size[i];
+        delta->sys.rom_start[i] = newer->sys.rom_start[i] - older->sys.rom_start[i];
+        delta->sys.rom_size[i] = newer->sys.rom_size[i] - older->sys.rom_size[i];
+    }
+
+    delta->cache.icache_enabled = newer->cache.icache_enabled - older->cache.icache_enabled;
+    delta->cache.dcache_enabled = newer->cache.dcache_enabled - older->cache.dcache_enabled;
+    delta->cache.icache_size = newer->cache.icache_size - older->cache.icache_size;
+    delta->cache.dcache_size = newer->cache.dcache_size - older->cache.dcache_size;
+    delta->cache.dcache_line_size = newer->cache.dcache_line_size - older->cache.dcache_line_size;
+    delta->cache.flash_prefetch_enabled = newer->cache.flash_prefetch_enabled - older->cache.flash_prefetch_enabled;
+    delta->cache.flash_cache_enabled = newer->cache.flash_cache_enabled - older->cache.flash_cache_enabled;
+    delta->cache.flash_latency = newer->cache.flash_latency - older->cache.flash_latency;
+    delta->cache.icache_hits = newer->cache.icache_hits - older->cache.icache_hits;
+    delta->cache.icache_misses = newer->cache.icache_misses - older->cache.icache_misses;
+    delta->cache.dcache_hits = newer->cache.dcache_hits - older->cache.dcache_hits;
+    delta->cache.dcache_misses = newer->cache.dcache_misses - older->cache.dcache_misses;
+}
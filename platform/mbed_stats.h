@@ -42,18 +42,32 @@ extern "C" {
 #ifndef MBED_CPU_STATS_ENABLED
 #define MBED_CPU_STATS_ENABLED      1
 #endif
+#ifndef MBED_SLEEP_STATS_ENABLED
+#define MBED_SLEEP_STATS_ENABLED    1
+#endif
 #ifndef MBED_HEAP_STATS_ENABLED
 #define MBED_HEAP_STATS_ENABLED     1
 #endif
 #ifndef MBED_THREAD_STATS_ENABLED
 #define MBED_THREAD_STATS_ENABLED   1
 #endif
+#ifndef MBED_BOOT_STATS_ENABLED
+#define MBED_BOOT_STATS_ENABLED     1
+#endif
+#ifndef MBED_CACHE_STATS_ENABLED
+#define MBED_CACHE_STATS_ENABLED    1
+#endif
 
 #endif // MBED_ALL_STATS_ENABLED
 
 /** Maximum memory regions reported by mbed-os memory statistics */
 #define MBED_MAX_MEM_REGIONS     4
 
+/** Number of buckets in the allocation-size histogram of mbed_stats_heap_t.
+ *  Bucket i counts allocations of size [2^i, 2^(i+1)) bytes, with the last
+ *  bucket also counting everything larger. */
+#define MBED_STATS_HEAP_ALLOC_HIST_BUCKETS    16
+
 /**
  * struct mbed_stats_heap_t definition
  */
@@ -65,15 +79,44 @@ typedef struct {
     uint32_t alloc_cnt;         /**< Current number of allocations that have not been freed since reset */
     uint32_t alloc_fail_cnt;    /**< Number of failed allocations since reset */
     uint32_t overhead_size;     /**< Number of bytes used to store heap statistics. This overhead takes up space on the heap, reducing the available heap space */
+    uint32_t largest_free_block;    /**< Largest block currently allocatable from the heap in bytes, measured by probing when mbed_stats_heap_get is called. Comparing this with the free total reveals fragmentation */
+    uint32_t free_block_cnt;        /**< Approximate number of sizable free heap blocks, measured by probing when mbed_stats_heap_get is called */
+    uint32_t alloc_size_hist[MBED_STATS_HEAP_ALLOC_HIST_BUCKETS];   /**< Histogram of requested allocation sizes since reset, in power-of-two buckets */
 } mbed_stats_heap_t;
 
 /**
  *  Fill the passed in heap stat structure with the heap statistics.
  *
  *  @param stats    A pointer to the mbed_stats_heap_t structure to fill
+ *
+ *  @note Measuring largest_free_block and free_block_cnt briefly allocates
+ *        and frees probe blocks (their effect is removed from the reported
+ *        counters), so this call is comparatively expensive and must not be
+ *        made from interrupt context.
  */
 void mbed_stats_heap_get(mbed_stats_heap_t *stats);
 
+/**
+ *  Take the heap statistics lock. Called by mbed_stats_snapshot, not by
+ *  application code.
+ */
+void mbed_stats_heap_lock(void);
+
+/**
+ *  Release the heap statistics lock. Called by mbed_stats_snapshot, not by
+ *  application code.
+ */
+void mbed_stats_heap_unlock(void);
+
+/**
+ *  Copy the running heap counters without probing the heap. The caller must
+ *  hold the heap statistics lock. Called by mbed_stats_snapshot, not by
+ *  application code.
+ *
+ *  @param stats    A pointer to the mbed_stats_heap_t structure to fill
+ */
+void mbed_stats_heap_copy(mbed_stats_heap_t *stats);
+
 /**
  * struct mbed_stats_stack_t definition
  */
@@ -130,6 +173,8 @@ typedef struct {
     uint32_t stack_size;        /**< Current number of bytes reserved for the stack */
     uint32_t stack_space;       /**< Current number of free bytes remaining on the stack */
     const char   *name;         /**< Name of the thread */
+    uint64_t cpu_cycles;        /**< CPU cycles consumed by the thread since it was created (0 if the core has no cycle counter) */
+    uint32_t cpu_used;          /**< Percentage of CPU time consumed by the thread since the previous call to mbed_stats_thread_get_each */
 } mbed_stats_thread_t;
 
 /**
@@ -140,6 +185,10 @@ typedef struct {
  *  @return         The number of mbed_stats_thread_t structures that have been filled.
  *                  If the number of threads on the system is less than or equal to count, it will equal the number of threads on the system.
  *                  If the number of threads on the system is greater than count, it will equal count.
+ *
+ *  @note Calling this function resets the CPU usage window, so the cpu_used
+ *        field reflects the share of CPU time each thread consumed between
+ *        two consecutive calls.
  */
 size_t mbed_stats_thread_get_each(mbed_stats_thread_t *stats, size_t count);
 
@@ -173,6 +222,214 @@ typedef struct {
  */
 void mbed_stats_sys_get(mbed_stats_sys_t *stats);
 
+/**
+ * struct mbed_stats_cache_t definition
+ */
+typedef struct {
+    uint8_t icache_enabled;         /**< Non-zero when the core instruction cache is enabled */
+    uint8_t dcache_enabled;         /**< Non-zero when the core data cache is enabled */
+    uint32_t icache_size;           /**< Instruction cache size in bytes (0 when absent or unknown) */
+    uint32_t dcache_size;           /**< Data cache size in bytes (0 when absent or unknown) */
+    uint32_t dcache_line_size;      /**< Data cache line size in bytes (0 when absent) */
+    uint8_t flash_prefetch_enabled; /**< Non-zero when the flash accelerator's prefetch is enabled */
+    uint8_t flash_cache_enabled;    /**< Non-zero when the flash accelerator's cache is enabled */
+    uint32_t flash_latency;         /**< Flash wait states configured for the current core clock */
+    uint32_t icache_hits;           /**< Instruction cache/accelerator hits (0 where hardware has no counters) */
+    uint32_t icache_misses;         /**< Instruction cache/accelerator misses (0 where hardware has no counters) */
+    uint32_t dcache_hits;           /**< Data cache hits (0 where hardware has no counters) */
+    uint32_t dcache_misses;         /**< Data cache misses (0 where hardware has no counters) */
+} mbed_stats_cache_t;
+
+/**
+ *  Fill the passed in cache stat structure with the cache and flash
+ *  accelerator state.
+ *
+ *  The core cache fields are read from the architectural registers
+ *  (Cortex-M7 class cores); the flash accelerator fields and the
+ *  hit/miss counters are filled in by the target through
+ *  mbed_stats_cache_target_update() where the vendor hardware exposes
+ *  them, and read zero elsewhere. Together they distinguish cache
+ *  thrashing from flash wait-state stalls when chasing a slowdown.
+ *
+ *  @param stats    A pointer to the mbed_stats_cache_t structure to fill
+ */
+void mbed_stats_cache_get(mbed_stats_cache_t *stats);
+
+/**
+ *  Add target-specific fields to a cache stat structure.
+ *
+ *  The default implementation is empty; targets with a flash
+ *  accelerator (for example ART on TARGET_STM) or cache event counters
+ *  override this to report their configuration and counts. Called by
+ *  mbed_stats_cache_get() after the architectural fields are filled.
+ *
+ *  @param stats    The structure being filled, architectural fields already set
+ */
+void mbed_stats_cache_target_update(mbed_stats_cache_t *stats);
+
+/** Families of statistics that can appear in a mbed_stats_snapshot_t */
+#define MBED_STATS_SNAPSHOT_HEAP    (1UL << 0)  /**< Heap counters */
+#define MBED_STATS_SNAPSHOT_STACK   (1UL << 1)  /**< Stack statistics accumulated over all threads */
+#define MBED_STATS_SNAPSHOT_CPU     (1UL << 2)  /**< CPU time counters */
+#define MBED_STATS_SNAPSHOT_SYS     (1UL << 3)  /**< System information */
+#define MBED_STATS_SNAPSHOT_CACHE   (1UL << 4)  /**< Cache and flash accelerator state */
+
+/**
+ * struct mbed_stats_snapshot_t definition
+ */
+typedef struct {
+    us_timestamp_t timestamp;   /**< Microsecond ticker time at which the snapshot window was taken */
+    uint32_t captured;          /**< Bitmask of MBED_STATS_SNAPSHOT_* families that are filled in */
+    mbed_stats_heap_t heap;     /**< Heap counters; largest_free_block and free_block_cnt read 0, see mbed_stats_snapshot */
+    mbed_stats_stack_t stack;   /**< Stack statistics accumulated over all threads */
+    mbed_stats_cpu_t cpu;       /**< CPU time counters */
+    mbed_stats_sys_t sys;       /**< System information */
+    mbed_stats_cache_t cache;   /**< Cache and flash accelerator state */
+} mbed_stats_snapshot_t;
+
+/**
+ *  Capture all enabled stat families into one coherent snapshot.
+ *
+ *  Gathering the families with the individual getters takes each family's
+ *  lock at a different instant, so the combined picture never quite adds
+ *  up. This call copies every enabled family inside a single bounded
+ *  window - the heap statistics lock plus one critical section - so the
+ *  fields describe the same instant and the measurement disturbs the
+ *  system once rather than once per family.
+ *
+ *  To keep the window bounded, the heap fragmentation probe is skipped:
+ *  largest_free_block and free_block_cnt read 0 in a snapshot. Use
+ *  mbed_stats_heap_get separately when those are worth their cost.
+ *  Per-thread stack and thread statistics do not fit a fixed-size arena;
+ *  the snapshot carries the accumulated stack family, and
+ *  mbed_stats_stack_get_each remains the per-thread interface.
+ *
+ *  @param snapshot A pointer to the mbed_stats_snapshot_t structure to fill
+ *
+ *  @note You cannot call this function from ISR context.
+ */
+void mbed_stats_snapshot(mbed_stats_snapshot_t *snapshot);
+
+/**
+ *  Compute the field-wise difference between two snapshots.
+ *
+ *  Every numeric field of the delta is newer minus older with wrapping
+ *  arithmetic, so monotonic counters become rates over the interval and
+ *  level fields (current_size and friends) become signed changes when read
+ *  as two's complement. Static families such as sys difference to zero.
+ *  The captured mask of the delta is the intersection of the inputs, and
+ *  timestamp holds the interval length in microseconds - between periodic
+ *  uploads a delta is mostly zeros, which makes it cheap to compress or
+ *  filter before transmission.
+ *
+ *  @param newer    The more recent snapshot
+ *  @param older    The earlier snapshot
+ *  @param delta    Filled with newer minus older; may alias newer or older
+ */
+void mbed_stats_snapshot_delta(const mbed_stats_snapshot_t *newer, const mbed_stats_snapshot_t *older, mbed_stats_snapshot_t *delta);
+
+/**
+ * enum mbed_boot_milestone_t definition
+ */
+typedef enum {
+    MBED_BOOT_MILESTONE_BOOT = 0,       /**< Entry to common boot code, after the vendor reset handler and RAM init */
+    MBED_BOOT_MILESTONE_SDK_INIT,       /**< Board clocks and peripherals initialized (mbed_sdk_init done) */
+    MBED_BOOT_MILESTONE_KERNEL_INIT,    /**< RTOS kernel initialized, scheduler about to start */
+    MBED_BOOT_MILESTONE_TOOLCHAIN_INIT, /**< C library initialized and C++ static constructors run */
+    MBED_BOOT_MILESTONE_MAIN,           /**< First thread running, entering application main() */
+    MBED_BOOT_MILESTONE_COUNT           /**< Number of boot milestones */
+} mbed_boot_milestone_t;
+
+/**
+ * struct mbed_stats_boot_t definition
+ */
+typedef struct {
+    uint32_t captured;                              /**< Bitmask of milestones that have been recorded */
+    uint32_t timestamp[MBED_BOOT_MILESTONE_COUNT];  /**< Cycle-counter value at each milestone */
+} mbed_stats_boot_t;
+
+/**
+ *  Fill the passed in boot stat structure with the boot milestone timestamps.
+ *
+ *  Timestamps are CPU cycle counts (DWT cycle counter, Cortex-M3 and up) and
+ *  read zero on cores without a cycle counter. Counting starts at the first
+ *  recorded milestone; a target that enables the cycle counter in its reset
+ *  handler gets timestamps relative to that earlier point instead.
+ *
+ *  @param stats    A pointer to the mbed_stats_boot_t structure to fill
+ */
+void mbed_stats_boot_get(mbed_stats_boot_t *stats);
+
+/**
+ *  Record a boot milestone at the current cycle count.
+ *
+ *  Called by the startup code; the first timestamp recorded for a milestone
+ *  wins, so targets and bootloaders may also record a milestone earlier in
+ *  their own init (for example MBED_BOOT_MILESTONE_BOOT from SystemInit) to
+ *  extend the measured window toward the reset vector.
+ *
+ *  @param milestone Milestone to record
+ */
+void mbed_boot_milestone(mbed_boot_milestone_t milestone);
+
+/** Maximum number of records kept by the constructor and singleton
+ *  diagnostics */
+#ifndef MBED_STATS_CTOR_TABLE_SIZE
+#define MBED_STATS_CTOR_TABLE_SIZE 32
+#endif
+
+/**
+ * struct mbed_stats_ctor_t definition
+ */
+typedef struct {
+    uint32_t address;           /**< Address of the constructor function */
+    uint32_t cycles;            /**< CPU cycles spent in the constructor */
+} mbed_stats_ctor_t;
+
+/**
+ *  Fill the passed array of stat structures with the cost of each C++
+ *  static constructor run during boot, in execution order.
+ *
+ *  Available with MBED_CTOR_STATS_ENABLED on the GCC_ARM toolchain, where
+ *  the startup code runs the init array itself instead of
+ *  __libc_init_array so each constructor can be timed. Resolve the
+ *  recorded addresses against the map file to name the constructors.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_ctor_t structures to fill
+ *  @param count    The number of mbed_stats_ctor_t structures in the provided array
+ *  @return         The number of mbed_stats_ctor_t structures that have been filled
+ */
+size_t mbed_stats_ctor_get_each(mbed_stats_ctor_t *stats, size_t count);
+
+/**
+ *  Fill the passed array with the addresses of the singleton objects that
+ *  have actually been constructed, in construction order.
+ *
+ *  Available with MBED_SINGLETON_STATS_ENABLED; SingletonPtr records each
+ *  construction. Singletons constructed before main() are still on the
+ *  boot path and are candidates for lazier initialization.
+ *
+ *  @param addresses    A pointer to an array of addresses to fill
+ *  @param count        The number of entries in the provided array
+ *  @return             The number of entries that have been filled
+ */
+size_t mbed_stats_singleton_get_each(uint32_t *addresses, size_t count);
+
+/**
+ *  Record a singleton construction. Called by SingletonPtr, not by
+ *  application code.
+ *
+ *  @param address  Address of the constructed object
+ */
+void mbed_stats_singleton_record(uint32_t address);
+
+/**
+ *  Run the C++ init array with per-constructor timing. Called by the
+ *  startup code in place of __libc_init_array when MBED_CTOR_STATS_ENABLED
+ *  is set; GCC_ARM only.
+ */
+void mbed_init_array_profiled(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -214,6 +214,32 @@
 #endif
 #endif
 
+/** MBED_COMPILER_BARRIER
+ *  Stop the compiler moving memory accesses across this point. No
+ *  processor barrier is emitted, so this only orders accesses as seen
+ *  from the local core - enough to order data against index updates
+ *  between an interrupt handler and a thread on the same core.
+ *
+ *  @code
+ *  #include "mbed_toolchain.h"
+ *
+ *  buffer[head] = data;
+ *  MBED_COMPILER_BARRIER();
+ *  head = next;
+ *  @endcode
+ */
+#ifndef MBED_COMPILER_BARRIER
+#if defined(__GNUC__) || defined(__clang__)
+#define MBED_COMPILER_BARRIER() __asm__ __volatile__("" : : : "memory")
+#elif defined(__CC_ARM)
+#define MBED_COMPILER_BARRIER() __memory_changed()
+#elif defined(__ICCARM__)
+#define MBED_COMPILER_BARRIER() __asm volatile("" : : : "memory")
+#else
+#define MBED_COMPILER_BARRIER()
+#endif
+#endif
+
 /** MBED_NORETURN
  *  Declare a function that will never return.
  *
@@ -333,6 +359,39 @@
 #endif
 #endif
 
+/** MBED_RAM_FUNC
+ *  Place a function in RAM so it executes with zero wait states,
+ *  independent of flash wait states and the flash accelerator.
+ *
+ *  On GCC and ARM toolchains the function is emitted into a `.data`
+ *  subsection, so the existing startup data copy moves it to RAM without
+ *  linker script changes; on IAR the native `__ramfunc` mechanism is
+ *  used. The function is also marked noinline so flash-resident callers
+ *  cannot inline the body back into flash.
+ *
+ *  Use it to pin hot paths - dispatch loops, interrupt handlers, flash
+ *  programming code - and measure the effect with mbed_stats_cache_get()
+ *  and the profiler. Each pinned function permanently occupies RAM, and
+ *  it must not be called before the startup data copy has run.
+ *
+ *  @code
+ *  #include "mbed_toolchain.h"
+ *
+ *  MBED_RAM_FUNC void process_sample_isr(void) {
+ *      ...
+ *  }
+ *  @endcode
+ */
+#ifndef MBED_RAM_FUNC
+#if (defined(__GNUC__) || defined(__clang__)) || defined(__CC_ARM)
+#define MBED_RAM_FUNC MBED_NOINLINE MBED_SECTION(".data.mbed_ram_func")
+#elif defined(__ICCARM__)
+#define MBED_RAM_FUNC __ramfunc
+#else
+#define MBED_RAM_FUNC
+#endif
+#endif
+
 /**
  * Macro expanding to a string literal of the enclosing function name.
  *
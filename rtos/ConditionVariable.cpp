@@ -19,6 +19,8 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
  */
+#ifdef MBED_CONF_RTOS_PRESENT
+
 #include "rtos/ConditionVariable.h"
 #include "rtos/Kernel.h"
 #include "rtos/ThisThread.h"
@@ -28,12 +30,12 @@
 
 namespace rtos {
 
-ConditionVariable::Waiter::Waiter(): sem(0), prev(NULL), next(NULL), in_list(false)
+ConditionVariable::Waiter::Waiter(): sem(0), prev(NULL), next(NULL), in_list(false), morphing(false)
 {
     // No initialization to do
 }
 
-ConditionVariable::ConditionVariable(Mutex &mutex): _mutex(mutex), _wait_list(NULL)
+ConditionVariable::ConditionVariable(Mutex &mutex): _mutex(mutex), _wait_list(NULL), _morph_list(NULL)
 {
     // No initialization to do
 }
@@ -57,7 +59,20 @@ bool ConditionVariable::wait_for(uint32_t millisec)
 
     _mutex.lock();
 
-    if (current_thread.in_list) {
+    if (current_thread.morphing) {
+        // A notify_all moved us from the wait list to the morph list, so
+        // we were notified even if the semaphore wait itself timed out
+        timeout = false;
+        current_thread.morphing = false;
+        _remove_wait_list(&_morph_list, &current_thread);
+
+        // Hand the baton to the next morphed waiter - the waiters wake one
+        // by one as the mutex is passed along rather than all stampeding
+        // the mutex at once
+        if (_morph_list != NULL) {
+            _morph_list->sem.release();
+        }
+    } else if (current_thread.in_list) {
         _remove_wait_list(&_wait_list, &current_thread);
     }
 
@@ -94,9 +109,23 @@ void ConditionVariable::notify_one()
 void ConditionVariable::notify_all()
 {
     MBED_ASSERT(_mutex.get_owner() == ThisThread::get_id());
+
+    // Morph the waiters onto the wakeup list instead of releasing every
+    // semaphore at once. Only the head waiter is woken here - each waiter
+    // wakes its successor once it has reacquired the mutex, so a broadcast
+    // to N waiters costs N sequential handoffs instead of N threads
+    // stampeding the mutex with back-to-back context switches.
+    bool baton = (_morph_list == NULL);
+
     while (_wait_list != NULL) {
-        _wait_list->sem.release();
-        _remove_wait_list(&_wait_list, _wait_list);
+        Waiter *waiter = _wait_list;
+        _remove_wait_list(&_wait_list, waiter);
+        _add_wait_list(&_morph_list, waiter);
+        waiter->morphing = true;
+    }
+
+    if (baton && _morph_list != NULL) {
+        _morph_list->sem.release();
     }
 }
 
@@ -148,6 +177,9 @@ void ConditionVariable::_remove_wait_list(Waiter **wait_list, Waiter *waiter)
 ConditionVariable::~ConditionVariable()
 {
     MBED_ASSERT(NULL == _wait_list);
+    MBED_ASSERT(NULL == _morph_list);
 }
 
 }
+
+#endif /* MBED_CONF_RTOS_PRESENT */
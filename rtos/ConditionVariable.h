@@ -316,12 +316,14 @@ protected:
         Waiter *prev;
         Waiter *next;
         bool in_list;
+        bool morphing;
     };
 
     static void _add_wait_list(Waiter **wait_list, Waiter *waiter);
     static void _remove_wait_list(Waiter **wait_list, Waiter *waiter);
     Mutex &_mutex;
     Waiter *_wait_list;
+    Waiter *_morph_list;
 #endif // !defined(DOXYGEN_ONLY)
 };
 
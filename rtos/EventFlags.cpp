@@ -19,8 +19,12 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
  */
+#ifdef MBED_CONF_RTOS_PRESENT
+
 #include "rtos/EventFlags.h"
 #include <string.h>
+#include "events/mbed_shared_queues.h"
+#include "mbed_critical.h"
 #include "mbed_error.h"
 #include "mbed_assert.h"
 
@@ -38,6 +42,8 @@ EventFlags::EventFlags(const char *name)
 
 void EventFlags::constructor(const char *name)
 {
+    _handler_mask = 0;
+    _handler_queue = NULL;
     memset(&_obj_mem, 0, sizeof(_obj_mem));
     osEventFlagsAttr_t attr;
     attr.name = name ? name : "application_unnamed_event_flags";
@@ -49,7 +55,32 @@ void EventFlags::constructor(const char *name)
 
 uint32_t EventFlags::set(uint32_t flags)
 {
-    return osEventFlagsSet(_id, flags);
+    uint32_t result = osEventFlagsSet(_id, flags);
+
+    if (_handler && !(result & osFlagsError)) {
+        uint32_t triggered = result & _handler_mask;
+        if (triggered) {
+            // Consume the matching flags like a woken waiter would, then
+            // hand them to the handler on its event queue
+            osEventFlagsClear(_id, triggered);
+            _handler_queue->call(_handler, triggered);
+        }
+    }
+
+    return result;
+}
+
+void EventFlags::set_handler(uint32_t mask, mbed::Callback<void(uint32_t)> handler, events::EventQueue *queue)
+{
+    if (handler && queue == NULL) {
+        queue = mbed::mbed_event_queue();
+    }
+
+    core_util_critical_section_enter();
+    _handler = handler;
+    _handler_mask = handler ? mask : 0;
+    _handler_queue = queue;
+    core_util_critical_section_exit();
 }
 
 uint32_t EventFlags::clear(uint32_t flags)
@@ -87,3 +118,5 @@ uint32_t EventFlags::wait(uint32_t flags, uint32_t opt, uint32_t timeout, bool c
 }
 
 }
+
+#endif /* MBED_CONF_RTOS_PRESENT */
@@ -27,8 +27,13 @@
 #include "mbed_rtos1_types.h"
 #include "mbed_rtos_storage.h"
 
+#include "platform/Callback.h"
 #include "platform/NonCopyable.h"
 
+namespace events {
+class EventQueue;
+}
+
 namespace rtos {
 /** \addtogroup rtos */
 /** @{*/
@@ -105,6 +110,25 @@ public:
      */
     uint32_t wait_any(uint32_t flags = 0, uint32_t timeout = osWaitForever, bool clear = true);
 
+    /** Register a handler to be dispatched when any of the specified event flags become signaled.
+
+      This is the asynchronous alternative to a thread blocked in wait_any -
+      flag-driven state machines can share an event queue's dispatch thread
+      instead of each holding a stack of their own. When set signals a flag
+      covered by the mask, the matching flags are cleared and the handler is
+      scheduled onto the event queue with those flags as its argument.
+
+      A subsequent call replaces the previous handler; registering an empty
+      callback deregisters it.
+
+      @param   mask     the flags to subscribe to.
+      @param   handler  callback invoked with the flags that triggered it, or an empty callback to deregister.
+      @param   queue    event queue to dispatch the handler on, or NULL to use the shared event queue.
+
+      @note You cannot call this function from ISR context.
+     */
+    void set_handler(uint32_t mask, mbed::Callback<void(uint32_t)> handler, events::EventQueue *queue = NULL);
+
     /** EventFlags destructor.
 
       @note You cannot call this function from ISR context.
@@ -116,6 +140,9 @@ private:
     uint32_t wait(uint32_t flags, uint32_t opt, uint32_t timeout, bool clear);
     osEventFlagsId_t                _id;
     mbed_rtos_storage_event_flags_t _obj_mem;
+    mbed::Callback<void(uint32_t)>  _handler;
+    uint32_t                        _handler_mask;
+    events::EventQueue             *_handler_queue;
 };
 
 /** @}*/
@@ -20,14 +20,20 @@
  * SOFTWARE.
  */
 
-#include "cmsis_os2.h"
 #include "rtos/Kernel.h"
+#include "platform/mbed_critical.h"
+#ifdef MBED_CONF_RTOS_PRESENT
 #include "rtos/rtos_idle.h"
 #include "rtos/rtos_handlers.h"
-#include "platform/mbed_critical.h"
+#else
+#include "hal/ticker_api.h"
+#include "hal/us_ticker_api.h"
+#endif
 
 namespace rtos {
 
+#ifdef MBED_CONF_RTOS_PRESENT
+
 uint64_t Kernel::get_ms_count()
 {
     // CMSIS-RTOS 2.1.0 and 2.1.1 differ in the time type. We assume
@@ -73,4 +79,29 @@ void Kernel::attach_thread_terminate_hook(void (*fptr)(osThreadId_t id))
     rtos_attach_thread_terminate_hook(fptr);
 }
 
+#else /* MBED_CONF_RTOS_PRESENT */
+
+/* Bare-metal profile: no kernel tick, so the millisecond count comes
+ * straight from the microsecond ticker, which is 64-bit and monotonic
+ * from boot just as the contract asks. */
+
+uint64_t Kernel::get_ms_count()
+{
+    return ticker_read_us(get_us_ticker_data()) / 1000;
+}
+
+void Kernel::attach_idle_hook(void (*fptr)(void))
+{
+    // No idle thread to run it
+    (void)fptr;
+}
+
+void Kernel::attach_thread_terminate_hook(void (*fptr)(osThreadId_t id))
+{
+    // Threads don't exist, let alone terminate
+    (void)fptr;
+}
+
+#endif /* MBED_CONF_RTOS_PRESENT */
+
 }
@@ -28,6 +28,7 @@
 #include "cmsis_os2.h"
 #include "mbed_rtos1_types.h"
 #include "mbed_rtos_storage.h"
+#include "platform/mbed_critical.h"
 #include "platform/NonCopyable.h"
 
 namespace rtos {
@@ -54,7 +55,7 @@ public:
      *
      * @note You cannot call this function from ISR context.
     */
-    MemoryPool()
+    MemoryPool(): _free_list(NULL)
     {
         memset(_pool_mem, 0, sizeof(_pool_mem));
         memset(&_obj_mem, 0, sizeof(_obj_mem));
@@ -83,7 +84,51 @@ public:
     */
     T *alloc(void)
     {
-        return (T *)osMemoryPoolAlloc(_id, 0);
+        T *item = _cache_pop();
+        if (item == NULL) {
+            item = (T *)osMemoryPoolAlloc(_id, 0);
+        }
+        return item;
+    }
+
+    /** Allocate up to n memory blocks of type T from a memory pool.
+
+      The free-list cache is drained under a single critical section, so a
+      burst allocation pays one interrupt-disable window instead of one
+      kernel entry per block.
+
+      @param   out  array to fill with the addresses of the allocated blocks.
+      @param   n    number of blocks to allocate.
+      @return       the number of blocks actually allocated, less than n when
+                    the pool runs out of memory.
+
+      @note You may call this function from ISR context.
+    */
+    size_t alloc_many(T **out, size_t n)
+    {
+        size_t count = 0;
+
+        if (_cacheable) {
+            core_util_critical_section_enter();
+            while ((count < n) && (_free_list != NULL)) {
+                void *block = _free_list;
+                _free_list = *(void **)block;
+                out[count++] = (T *)block;
+            }
+            core_util_critical_section_exit();
+        }
+
+        // Top up from the underlying pool - this must happen outside the
+        // critical section as osMemoryPoolAlloc enters the kernel when
+        // called from thread context
+        while (count < n) {
+            T *item = (T *)osMemoryPoolAlloc(_id, 0);
+            if (item == NULL) {
+                break;
+            }
+            out[count++] = item;
+        }
+        return count;
     }
 
     /** Allocate a memory block of type T from a memory pool and set memory block to zero.
@@ -93,7 +138,7 @@ public:
     */
     T *calloc(void)
     {
-        T *item = (T *)osMemoryPoolAlloc(_id, 0);
+        T *item = alloc();
         if (item != NULL) {
             memset(item, 0, sizeof(T));
         }
@@ -102,19 +147,95 @@ public:
 
     /** Free a memory block.
       @param   block  address of the allocated memory block to be freed.
-      @return         osOK on successful deallocation, osErrorParameter if given memory block id
-                      is NULL or invalid, or osErrorResource if given memory block is in an
-                      invalid memory pool state.
+      @return         osOK on successful deallocation, osErrorParameter if given memory block
+                      is NULL or does not belong to this memory pool.
 
       @note You may call this function from ISR context.
     */
     osStatus free(T *block)
     {
-        return osMemoryPoolFree(_id, (void *)block);
+        if (!_owns(block)) {
+            return osErrorParameter;
+        }
+        if (!_cacheable) {
+            return osMemoryPoolFree(_id, (void *)block);
+        }
+        core_util_critical_section_enter();
+        _cache_push(block);
+        core_util_critical_section_exit();
+        return osOK;
+    }
+
+    /** Free multiple memory blocks under a single critical section.
+      @param   blocks  array of addresses of allocated memory blocks to be freed.
+      @param   n       number of blocks to free.
+      @return          osOK on successful deallocation, osErrorParameter if any given memory
+                       block is NULL or does not belong to this memory pool - blocks before
+                       the offending one have been freed.
+
+      @note You may call this function from ISR context.
+    */
+    osStatus free_many(T *const *blocks, size_t n)
+    {
+        if (!_cacheable) {
+            for (size_t i = 0; i < n; i++) {
+                osStatus status = free(blocks[i]);
+                if (status != osOK) {
+                    return status;
+                }
+            }
+            return osOK;
+        }
+
+        osStatus status = osOK;
+        core_util_critical_section_enter();
+        for (size_t i = 0; i < n; i++) {
+            if (!_owns(blocks[i])) {
+                status = osErrorParameter;
+                break;
+            }
+            _cache_push(blocks[i]);
+        }
+        core_util_critical_section_exit();
+        return status;
     }
 
 private:
+    /* The free-list cache threads a pointer through freed blocks, so it is
+     * only usable when the (4-byte aligned) block size can hold one. */
+    static const bool _cacheable = (((sizeof(T) + 3) & ~3) >= sizeof(void *));
+
+    bool _owns(const T *block) const
+    {
+        const char *p = (const char *)block;
+        return (p >= _pool_mem) && (p < _pool_mem + sizeof(_pool_mem)) &&
+               (((p - _pool_mem) % ((sizeof(T) + 3) & ~3)) == 0);
+    }
+
+    // Push a freed block onto the cache, the caller holds a critical section
+    void _cache_push(T *block)
+    {
+        *(void **)block = _free_list;
+        _free_list = (void *)block;
+    }
+
+    // Pop one cached block, or NULL when the cache is empty
+    T *_cache_pop(void)
+    {
+        if (!_cacheable || (_free_list == NULL)) {
+            return NULL;
+        }
+        core_util_critical_section_enter();
+        void *block = _free_list;
+        if (block != NULL) {
+            _free_list = *(void **)block;
+        }
+        core_util_critical_section_exit();
+        return (T *)block;
+    }
+
     osMemoryPoolId_t             _id;
+    void                        *_free_list;
     /* osMemoryPoolNew requires that pool block size is a multiple of 4 bytes. */
     char                         _pool_mem[((sizeof(T) + 3) & ~3) * pool_sz];
     mbed_rtos_storage_mem_pool_t _obj_mem;
@@ -38,8 +38,35 @@ Mutex::Mutex(const char *name)
     constructor(name);
 }
 
+void Mutex::set_spin_limit(uint32_t spins)
+{
+    _spin_limit = spins;
+}
+
+bool Mutex::trylock()
+{
+    return trylock_for(0);
+}
+
+bool Mutex::trylock_until(uint64_t millisec)
+{
+    uint64_t now = Kernel::get_ms_count();
+
+    if (now >= millisec) {
+        return trylock();
+    } else if (millisec - now >= osWaitForever) {
+        // API permits early return
+        return trylock_for(osWaitForever - 1);
+    } else {
+        return trylock_for(millisec - now);
+    }
+}
+
+#ifdef MBED_CONF_RTOS_PRESENT
+
 void Mutex::constructor(const char *name)
 {
+    _spin_limit = 0;
     memset(&_obj_mem, 0, sizeof(_obj_mem));
     osMutexAttr_t attr =
     { 0 };
@@ -51,9 +78,28 @@ void Mutex::constructor(const char *name)
     MBED_ASSERT(_id);
 }
 
+bool Mutex::try_spin()
+{
+    // Bounded spin before blocking - probe with non-blocking acquires,
+    // yielding between attempts so a same-priority owner inside a short
+    // critical section can run and release the mutex without this thread
+    // paying the full block/unblock round trip through the scheduler.
+    // A recursive relock by the owner succeeds on the first attempt.
+    for (uint32_t spins = _spin_limit; spins > 0; spins--) {
+        if (osMutexAcquire(_id, 0) == osOK) {
+            return true;
+        }
+        osThreadYield();
+    }
+    return false;
+}
+
 osStatus Mutex::lock(void)
 {
-    osStatus status = osMutexAcquire(_id, osWaitForever);
+    osStatus status = osOK;
+    if ((_spin_limit == 0) || !try_spin()) {
+        status = osMutexAcquire(_id, osWaitForever);
+    }
     if (osOK == status) {
         _count++;
     }
@@ -83,11 +129,6 @@ osStatus Mutex::lock(uint32_t millisec)
     return status;
 }
 
-bool Mutex::trylock()
-{
-    return trylock_for(0);
-}
-
 bool Mutex::trylock_for(uint32_t millisec)
 {
     osStatus status = osMutexAcquire(_id, millisec);
@@ -106,20 +147,6 @@ bool Mutex::trylock_for(uint32_t millisec)
     return false;
 }
 
-bool Mutex::trylock_until(uint64_t millisec)
-{
-    uint64_t now = Kernel::get_ms_count();
-
-    if (now >= millisec) {
-        return trylock();
-    } else if (millisec - now >= osWaitForever) {
-        // API permits early return
-        return trylock_for(osWaitForever - 1);
-    } else {
-        return trylock_for(millisec - now);
-    }
-}
-
 osStatus Mutex::unlock()
 {
     _count--;
@@ -143,4 +170,61 @@ Mutex::~Mutex()
     osMutexDelete(_id);
 }
 
+#else /* MBED_CONF_RTOS_PRESENT */
+
+/* Bare-metal profile: a single thread of execution plus interrupts. The
+ * mutex can never be contended (and must not be used from ISR context in
+ * either profile), so locking collapses to recursion counting. */
+
+void Mutex::constructor(const char *name)
+{
+    (void)name;
+    _count = 0;
+    _spin_limit = 0;
+}
+
+bool Mutex::try_spin()
+{
+    // Never contended - the mutex is free or recursively held by the caller
+    return true;
+}
+
+osStatus Mutex::lock(void)
+{
+    _count++;
+    return osOK;
+}
+
+osStatus Mutex::lock(uint32_t millisec)
+{
+    (void)millisec;
+    _count++;
+    return osOK;
+}
+
+bool Mutex::trylock_for(uint32_t millisec)
+{
+    (void)millisec;
+    _count++;
+    return true;
+}
+
+osStatus Mutex::unlock()
+{
+    MBED_ASSERT(_count > 0);
+    _count--;
+    return osOK;
+}
+
+osThreadId Mutex::get_owner()
+{
+    return NULL;
+}
+
+Mutex::~Mutex()
+{
+}
+
+#endif /* MBED_CONF_RTOS_PRESENT */
+
 }
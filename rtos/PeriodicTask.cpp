@@ -0,0 +1,91 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2019 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifdef MBED_CONF_RTOS_PRESENT
+
+#include "rtos/PeriodicTask.h"
+#include "rtos/Kernel.h"
+#include "rtos/ThisThread.h"
+
+namespace rtos {
+
+PeriodicTask::PeriodicTask(uint32_t period_ms):
+    _period(period_ms), _deadline(0), _started(false),
+    _cycles(0), _overruns(0), _max_lateness(0)
+{
+}
+
+bool PeriodicTask::wait()
+{
+    uint64_t now = Kernel::get_ms_count();
+    if (!_started) {
+        _started = true;
+        _deadline = now;
+    }
+    _deadline += _period;
+
+    bool met = true;
+    if (now > _deadline) {
+        // The previous cycle ran past its entire period - realign to the
+        // next deadline on the original grid instead of running the missed
+        // cycles back-to-back
+        uint64_t missed = (now - _deadline) / _period + 1;
+        _deadline += missed * _period;
+        _overruns += missed;
+        met = false;
+    }
+
+    ThisThread::sleep_until(_deadline);
+
+    uint64_t lateness = Kernel::get_ms_count() - _deadline;
+    if (lateness > _max_lateness) {
+        _max_lateness = (uint32_t)lateness;
+    }
+    _cycles++;
+
+    return met;
+}
+
+uint32_t PeriodicTask::cycles() const
+{
+    return _cycles;
+}
+
+uint32_t PeriodicTask::overruns() const
+{
+    return _overruns;
+}
+
+uint32_t PeriodicTask::max_lateness() const
+{
+    return _max_lateness;
+}
+
+void PeriodicTask::reset_stats()
+{
+    _cycles = 0;
+    _overruns = 0;
+    _max_lateness = 0;
+}
+
+}
+
+#endif /* MBED_CONF_RTOS_PRESENT */
@@ -0,0 +1,114 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2019 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef PERIODIC_TASK_H
+#define PERIODIC_TASK_H
+
+#include <stdint.h>
+
+#include "platform/NonCopyable.h"
+
+namespace rtos {
+/** \addtogroup rtos */
+/** @{*/
+/**
+ * \defgroup rtos_PeriodicTask PeriodicTask class
+ * @{
+ */
+
+/** The PeriodicTask class maintains a drift-free absolute schedule for a periodic thread.
+ *
+ * A loop built on ThisThread::sleep_for(period) drifts because the execution
+ * time of each cycle adds to the sleep. PeriodicTask anchors the schedule to
+ * Kernel::get_ms_count and sleeps until absolute deadlines, so cycle N always
+ * starts at start + N * period regardless of how long the work takes -
+ * provided it fits in the period.
+ *
+ * When a cycle overruns its entire period, the schedule realigns to the next
+ * deadline on the original grid instead of running the missed cycles
+ * back-to-back, and the miss is counted. Wakeup lateness is tracked per cycle
+ * so scheduling jitter can be inspected without an external trace.
+ *
+ * The wait is a plain RTX delay, so on tickless targets the MCU can enter
+ * deep sleep between cycles.
+ *
+ * Usage:
+ * @code
+ * void control_loop()
+ * {
+ *     PeriodicTask task(10);
+ *     while (true) {
+ *         task.wait();
+ *         // runs every 10 ms without drift
+ *     }
+ * }
+ * @endcode
+ *
+ * @note You cannot use member functions of this class in ISR context.
+ */
+class PeriodicTask : private mbed::NonCopyable<PeriodicTask> {
+public:
+    /** Create a periodic task schedule.
+
+      The schedule is anchored to the time of the first wait call.
+
+      @param   period_ms  cycle period in milliseconds.
+     */
+    PeriodicTask(uint32_t period_ms);
+
+    /** Sleep until the next deadline on the absolute schedule.
+      @return true if the deadline was met, false if the previous cycle
+              overran its period and missed deadlines were skipped.
+     */
+    bool wait();
+
+    /** Get the number of completed cycles.
+      @return  cycles completed since construction or the last reset_stats call.
+     */
+    uint32_t cycles() const;
+
+    /** Get the number of missed deadlines.
+      @return  deadlines skipped due to cycle overruns since construction or the last reset_stats call.
+     */
+    uint32_t overruns() const;
+
+    /** Get the worst observed wakeup lateness.
+      @return  maximum delay in milliseconds between a deadline and the actual wakeup.
+     */
+    uint32_t max_lateness() const;
+
+    /** Reset the cycle, overrun and lateness statistics. */
+    void reset_stats();
+
+private:
+    uint32_t _period;
+    uint64_t _deadline;
+    bool     _started;
+    uint32_t _cycles;
+    uint32_t _overruns;
+    uint32_t _max_lateness;
+};
+
+/** @}*/
+/** @}*/
+
+}
+#endif
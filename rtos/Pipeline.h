@@ -0,0 +1,386 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2019 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "rtos/Queue.h"
+#include "rtos/Thread.h"
+#include "platform/Callback.h"
+#include "platform/mbed_critical.h"
+#include "platform/NonCopyable.h"
+
+namespace rtos {
+/** \addtogroup rtos */
+/** @{*/
+/**
+ * \defgroup rtos_Pipeline Pipeline classes
+ * @{
+ */
+
+/** Statistics for one pipeline stage.
+ *
+ * Counters accumulate from stage start or the last reset_stats call.
+ */
+typedef struct {
+    uint32_t processed;     /**< items the stage has consumed */
+    uint32_t batches;       /**< number of times the stage callback ran */
+    uint32_t max_batch;     /**< largest batch handed to the callback in one call */
+    uint32_t max_occupancy; /**< high watermark of the input link */
+    uint32_t stalls;        /**< pushes into the input link that had to wait for credit */
+} pipeline_stage_stats_t;
+
+/** A bounded, typed link between two pipeline stages.
+ *
+ * A link carries pointers to messages of type T from exactly one producer
+ * to exactly one consumer. Capacity is fixed, and the free slots act as the
+ * producer's credit: when the consumer falls behind, push() blocks instead
+ * of growing a queue or dropping data, so backpressure propagates upstream
+ * stage by stage.
+ *
+ * This is the abstract interface; PipelineRing is the concrete link.
+ * PipelineStage consumes from a link through this interface so stages do
+ * not need the ring depth in their type.
+ */
+template<typename T>
+class PipelineLink : private mbed::NonCopyable<PipelineLink<T> > {
+public:
+    virtual ~PipelineLink() {}
+
+    /** Push a message into the link.
+     *
+     * If the link is full the producer is out of credit and the call blocks
+     * until the consumer frees a slot or the timeout passes.
+     *
+     * @param  item      Pointer to the message to push.
+     * @param  millisec  Timeout for the operation, 0 for no wait,
+     *                   osWaitForever to wait for credit indefinitely.
+     *                   (default: osWaitForever)
+     *
+     * @return Status code that indicates the execution status of the function:
+     *         @a osOK              The message was pushed.
+     *         @a osErrorResource   The link was full and no timeout was given.
+     *         @a osErrorTimeout    No credit became available in time.
+     *
+     * @note You may call this function from ISR context if the millisec
+     *       parameter is set to 0.
+     */
+    virtual osStatus push(T *item, uint32_t millisec = osWaitForever) = 0;
+
+    /** Pop a batch of messages from the link.
+     *
+     * Waits up to millisec for the first message, then takes whatever else
+     * is already queued without waiting, up to max_items in total.
+     *
+     * @param  items     Array the popped message pointers are written to.
+     * @param  max_items Capacity of the array.
+     * @param  millisec  Timeout for the first message, 0 for no wait.
+     *
+     * @return Number of messages popped, 0 on timeout.
+     *
+     * @note You may call this function from ISR context if the millisec
+     *       parameter is set to 0.
+     */
+    virtual uint32_t pop_batch(T **items, uint32_t max_items, uint32_t millisec) = 0;
+
+    /** Get the number of messages currently in the link. */
+    virtual uint32_t occupancy() const = 0;
+
+    /** Get the capacity of the link. */
+    virtual uint32_t capacity() const = 0;
+
+    /** Get the highest occupancy observed since the last reset_stats. */
+    virtual uint32_t max_occupancy() const = 0;
+
+    /** Get the number of pushes that found the link full and had to wait. */
+    virtual uint32_t stalls() const = 0;
+
+    /** Reset the occupancy watermark and the stall counter. */
+    virtual void reset_stats() = 0;
+};
+
+/** Bounded SPSC ring link between two pipeline stages.
+ *
+ * Built on the wait-free single-producer single-consumer Queue
+ * specialization: pushes and pops that do not need to wait complete without
+ * entering the kernel, so an ISR can feed the first link of a pipeline
+ * directly. On top of the ring the link keeps the occupancy watermark and
+ * stall count that feed the pipeline statistics.
+ *
+ * Exactly one context may push and one may pop at a time - the same
+ * contract as Queue<T, ring_sz, true>.
+ *
+ * @tparam T       Specifies the type of messages carried by the link.
+ * @tparam ring_sz Capacity of the link in messages.
+ */
+template<typename T, uint32_t ring_sz>
+class PipelineRing : public PipelineLink<T> {
+public:
+    /** Create and initialize an empty link.
+     *
+     * @note You may call this function from ISR context.
+     */
+    PipelineRing() : _count(0), _max_count(0), _stalls(0)
+    {
+    }
+
+    virtual osStatus push(T *item, uint32_t millisec = osWaitForever)
+    {
+        osStatus status = _ring.put(item, 0);
+        if (status == osErrorResource && millisec != 0) {
+            // Out of credit - the consumer is behind. Block until it frees
+            // a slot; this is what propagates backpressure upstream.
+            core_util_atomic_incr_u32(&_stalls, 1);
+            status = _ring.put(item, millisec);
+        }
+        if (status == osOK) {
+            uint32_t count = core_util_atomic_incr_u32(&_count, 1);
+            if (count > _max_count) {
+                // stats-grade watermark, a lost race only understates it
+                _max_count = count;
+            }
+        }
+        return status;
+    }
+
+    virtual uint32_t pop_batch(T **items, uint32_t max_items, uint32_t millisec)
+    {
+        uint32_t count = 0;
+        while (count < max_items) {
+            osEvent evt = _ring.get(count == 0 ? millisec : 0);
+            if (evt.status != (osStatus)osEventMessage) {
+                break;
+            }
+            items[count++] = static_cast<T *>(evt.value.p);
+        }
+        if (count > 0) {
+            core_util_atomic_decr_u32(&_count, count);
+        }
+        return count;
+    }
+
+    virtual uint32_t occupancy() const
+    {
+        return _count;
+    }
+
+    virtual uint32_t capacity() const
+    {
+        return ring_sz;
+    }
+
+    virtual uint32_t max_occupancy() const
+    {
+        return _max_count;
+    }
+
+    virtual uint32_t stalls() const
+    {
+        return _stalls;
+    }
+
+    virtual void reset_stats()
+    {
+        _max_count = 0;
+        _stalls = 0;
+    }
+
+private:
+    Queue<T, ring_sz, true> _ring;
+    volatile uint32_t _count;
+    volatile uint32_t _max_count;
+    volatile uint32_t _stalls;
+};
+
+/** A pipeline stage: a thread consuming batches from one link.
+ *
+ * A stage owns a thread that blocks on its input link, pops up to batch_sz
+ * queued messages at a time and hands them to the stage callback in one
+ * call, so per-message wakeup and scheduling costs are amortized across the
+ * batch. The callback forwards its results by pushing into the next stage's
+ * link; a full downstream link blocks the push, which fills this stage's
+ * input link, which in turn blocks the stage above - bounded memory and
+ * flow control fall out of the link capacities with no further bookkeeping.
+ *
+ * Message ownership follows the pointers: whoever pops a message decides
+ * whether to forward or release it, exactly as with Mail or Queue.
+ *
+ * Usage:
+ * @code
+ * PipelineRing<sample_block_t, 8> captured;
+ * PipelineRing<sample_block_t, 4> filtered;
+ *
+ * void filter_batch(sample_block_t *const *blocks, uint32_t count)
+ * {
+ *     for (uint32_t i = 0; i < count; i++) {
+ *         apply_filter(blocks[i]);
+ *         filtered.push(blocks[i]);
+ *     }
+ * }
+ *
+ * PipelineStage<sample_block_t, 4> filter_stage(captured, filter_batch);
+ * filter_stage.start();
+ * // the capture ISR feeds the pipeline with captured.push(block, 0)
+ * @endcode
+ *
+ * @tparam T        Specifies the type of messages consumed by the stage.
+ * @tparam batch_sz Maximum number of messages handed to the callback per
+ *                  invocation.
+ *
+ * @note You cannot use member functions of this class in ISR context.
+ */
+template<typename T, uint32_t batch_sz = 8>
+class PipelineStage : private mbed::NonCopyable<PipelineStage<T, batch_sz> > {
+public:
+    /** Create a pipeline stage.
+     *
+     * The stage thread is not started until start() is called.
+     *
+     * @param   input      Link the stage consumes from.
+     * @param   process    Callback invoked with each batch of messages.
+     * @param   priority   Priority of the stage thread. (default: osPriorityNormal)
+     * @param   stack_size Stack size of the stage thread. (default: OS_STACK_SIZE)
+     * @param   name       Name of the stage thread. (default: NULL)
+     */
+    PipelineStage(PipelineLink<T> &input,
+                  mbed::Callback<void(T *const *, uint32_t)> process,
+                  osPriority priority = osPriorityNormal,
+                  uint32_t stack_size = OS_STACK_SIZE,
+                  const char *name = NULL) :
+        _input(input), _process(process), _running(false),
+        _thread(priority, stack_size, NULL, name)
+    {
+        _stats.processed = 0;
+        _stats.batches = 0;
+        _stats.max_batch = 0;
+        _stats.max_occupancy = 0;
+        _stats.stalls = 0;
+    }
+
+    /** Stage destructor
+     *
+     * Stops the stage thread if it is still running.
+     */
+    ~PipelineStage()
+    {
+        stop();
+    }
+
+    /** Start the stage thread.
+     *
+     * @return Status code that indicates the execution status of the function:
+     *         @a osOK                      The stage thread was started.
+     *         @a osErrorResource           The stage is already running.
+     *         Any error code returned by Thread::start.
+     */
+    osStatus start()
+    {
+        if (_running) {
+            return osErrorResource;
+        }
+        _running = true;
+        osStatus status = _thread.start(mbed::callback(this, &PipelineStage::stage_loop));
+        if (status != osOK) {
+            _running = false;
+        }
+        return status;
+    }
+
+    /** Stop the stage thread and wait for it to exit.
+     *
+     * Messages still queued on the input link remain there. The stage
+     * notices the stop request the next time its input wait expires, so
+     * stopping an idle stage can take up to the internal poll interval.
+     *
+     * @return Status code that indicates the execution status of the function:
+     *         @a osOK              The stage thread has exited.
+     *         @a osErrorResource   The stage was not running.
+     */
+    osStatus stop()
+    {
+        if (!_running) {
+            return osErrorResource;
+        }
+        _running = false;
+        return _thread.join();
+    }
+
+    /** Get the stage statistics.
+     *
+     * The input link watermark and stall count are folded into the snapshot
+     * so one call covers both the stage and its feed.
+     *
+     * @param stats Filled with a snapshot of the counters.
+     */
+    void get_stats(pipeline_stage_stats_t &stats) const
+    {
+        stats.processed = _stats.processed;
+        stats.batches = _stats.batches;
+        stats.max_batch = _stats.max_batch;
+        stats.max_occupancy = _input.max_occupancy();
+        stats.stalls = _input.stalls();
+    }
+
+    /** Reset the stage and input link statistics. */
+    void reset_stats()
+    {
+        _stats.processed = 0;
+        _stats.batches = 0;
+        _stats.max_batch = 0;
+        _input.reset_stats();
+    }
+
+private:
+    // how long the stage thread waits on its input before re-checking the
+    // stop flag; bounds the latency of stop() on an idle pipeline
+    static const uint32_t STAGE_STOP_POLL_MS = 100;
+
+    void stage_loop()
+    {
+        T *items[batch_sz];
+
+        while (_running) {
+            uint32_t count = _input.pop_batch(items, batch_sz, STAGE_STOP_POLL_MS);
+            if (count == 0) {
+                continue;
+            }
+            _process(items, count);
+            _stats.processed += count;
+            _stats.batches++;
+            if (count > _stats.max_batch) {
+                _stats.max_batch = count;
+            }
+        }
+    }
+
+    PipelineLink<T> &_input;
+    mbed::Callback<void(T *const *, uint32_t)> _process;
+    volatile bool _running;
+    pipeline_stage_stats_t _stats;
+    Thread _thread;
+};
+
+/** @}*/
+/** @}*/
+
+} // namespace rtos
+
+#endif // PIPELINE_H
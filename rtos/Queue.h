@@ -25,6 +25,9 @@
 #include "cmsis_os2.h"
 #include "mbed_rtos1_types.h"
 #include "mbed_rtos_storage.h"
+#include "rtos/Semaphore.h"
+#include "rtos/Kernel.h"
+#include "platform/mbed_critical.h"
 #include "platform/mbed_error.h"
 #include "platform/NonCopyable.h"
 
@@ -49,14 +52,16 @@ namespace rtos {
  *
  * @tparam T        Specifies the type of elements stored in the queue.
  * @tparam queue_sz Maximum number of messages that you can store in the queue.
+ * @tparam spsc     Set to true for the wait-free single-producer
+ *                  single-consumer specialization, see Queue<T, queue_sz, true>.
  *
  * @note Memory considerations: The queue control structures are created on the
  *       current thread's stack, both for the Mbed OS and underlying RTOS
  *       objects (static or dynamic RTOS memory pools are not being used).
  *
  */
-template<typename T, uint32_t queue_sz>
-class Queue : private mbed::NonCopyable<Queue<T, queue_sz> > {
+template<typename T, uint32_t queue_sz, bool spsc = false>
+class Queue : private mbed::NonCopyable<Queue<T, queue_sz, spsc> > {
 public:
     /** Create and initialize a message Queue of objects of the parameterized
      * type `T` and maximum capacity specified by `queue_sz`.
@@ -215,6 +220,242 @@ private:
     char                          _queue_mem[queue_sz * (sizeof(T *) + sizeof(mbed_rtos_storage_message_t))];
     mbed_rtos_storage_msg_queue_t _obj_mem;
 };
+
+/** Wait-free single-producer single-consumer specialization of Queue.
+ *
+ * Instantiated as Queue<T, queue_sz, true>. The queue is an index-based
+ * lock-free ring rather than an RTX message queue: put and get with a
+ * timeout of 0 complete with a handful of loads, stores and one atomic
+ * operation on the ring indices instead of a full supervisor call, making
+ * the specialization suitable for high-rate ISR-to-thread handoff.
+ *
+ * When a nonzero timeout is requested, the call falls back to blocking on
+ * a semaphore with the standard Queue semantics; the waiting side is only
+ * woken when the other side actually changes the ring, so the fast path
+ * stays kernel-free.
+ *
+ * Exactly one context may put and one context may get at a time - that is
+ * the contract that makes the ring lock-free. Message priorities are not
+ * supported; messages are always delivered in FIFO order.
+ *
+ * @tparam T        Specifies the type of elements stored in the queue.
+ * @tparam queue_sz Maximum number of messages that you can store in the queue.
+ */
+template<typename T, uint32_t queue_sz>
+class Queue<T, queue_sz, true> : private mbed::NonCopyable<Queue<T, queue_sz, true> > {
+public:
+    /** Create and initialize an empty message Queue.
+     *
+     * @note You may call this function from ISR context.
+    */
+    Queue(): _head(0), _tail(0), _producer_waiting(false), _consumer_waiting(false)
+    {
+    }
+
+    /** Check if the queue is empty.
+     *
+     * @return True if the queue is empty, false if not
+     *
+     * @note You may call this function from ISR context.
+     */
+    bool empty() const
+    {
+        return _head == _tail;
+    }
+
+    /** Check if the queue is full.
+     *
+     * @return True if the queue is full, false if not
+     *
+     * @note You may call this function from ISR context.
+     */
+    bool full() const
+    {
+        return _next(_tail) == _head;
+    }
+
+    /** Inserts the given element to the end of the queue.
+     *
+     * With the default timeout of 0 the operation is wait-free and never
+     * enters the kernel. With a nonzero timeout the calling thread blocks
+     * on a semaphore until the consumer makes space or the timeout passes.
+     *
+     * @param  data      Pointer to the element to insert into the queue.
+     * @param  millisec  Timeout for the operation to be executed, or 0 in case
+     *                   of no timeout. (default: 0)
+     * @param  prio      Not supported by the SPSC specialization, messages
+     *                   are always FIFO. (default: 0)
+     *
+     * @return Status code that indicates the execution status of the function:
+     *         @a osOK              The message has been successfully inserted
+     *                              into the queue.
+     *         @a osErrorTimeout    The message could not be inserted into the
+     *                              queue in the given time.
+     *         @a osErrorResource   The message could not be inserted because
+     *                              the queue is full.
+     *
+     * @note You may call this function from ISR context if the millisec
+     *       parameter is set to 0.
+     */
+    osStatus put(T *data, uint32_t millisec = 0, uint8_t prio = 0)
+    {
+        (void) prio;
+        uint64_t end = _deadline(millisec);
+
+        while (true) {
+            uint32_t tail = _tail;
+            uint32_t next = _next(tail);
+            if (next != _head) {
+                _buffer[tail] = data;
+                // the single producer owns _tail, the compare-and-swap
+                // cannot fail - it both publishes the filled slot and
+                // advances the index in one atomic step
+                core_util_atomic_cas_u32(&_tail, &tail, next);
+                _wake(_consumer_waiting, _full_sema);
+                return osOK;
+            }
+
+            if (millisec == 0) {
+                return osErrorResource;
+            }
+            if (!_park_producer(millisec, end)) {
+                return osErrorTimeout;
+            }
+        }
+    }
+
+    /** Get a message or wait for a message from the queue.
+     *
+     * With a timeout of 0 the operation is wait-free and never enters the
+     * kernel. With a nonzero timeout the calling thread blocks on a
+     * semaphore until the producer inserts a message or the timeout passes.
+     *
+     * @param   millisec  Timeout value or 0 in case of no time-out.
+     *                    (default: osWaitForever).
+     *
+     * @return Event information that includes the message in event. Message
+     *         value and the status code in event.status:
+     *         @a osEventMessage   Message successfully received.
+     *         @a osOK             No message is available in the queue, and no
+     *                             timeout was specified.
+     *         @a osEventTimeout   No message was received before a timeout
+     *                             event occurred.
+     *
+     * @note  You may call this function from ISR context if the millisec
+     *        parameter is set to 0.
+     */
+    osEvent get(uint32_t millisec = osWaitForever)
+    {
+        osEvent event;
+        event.def.message_id = NULL;
+        uint64_t end = _deadline(millisec);
+
+        while (true) {
+            uint32_t head = _head;
+            if (head != _tail) {
+                T *data = _buffer[head];
+                uint32_t next = _next(head);
+                // the single consumer owns _head, the compare-and-swap
+                // cannot fail
+                core_util_atomic_cas_u32(&_head, &head, next);
+                _wake(_producer_waiting, _free_sema);
+                event.status = (osStatus)osEventMessage;
+                event.value.p = data;
+                return event;
+            }
+
+            if (millisec == 0) {
+                event.status = osOK;
+                return event;
+            }
+            if (!_park_consumer(millisec, end)) {
+                event.status = (osStatus)osEventTimeout;
+                return event;
+            }
+        }
+    }
+
+private:
+    static uint32_t _next(uint32_t index)
+    {
+        return (index + 1 == queue_sz + 1) ? 0 : index + 1;
+    }
+
+    static uint64_t _deadline(uint32_t millisec)
+    {
+        if (millisec == 0 || millisec == osWaitForever) {
+            return 0;
+        }
+        return Kernel::get_ms_count() + millisec;
+    }
+
+    // wake the other side if it has declared interest in ring changes
+    static void _wake(volatile bool &waiting, Semaphore &sema)
+    {
+        if (waiting) {
+            core_util_critical_section_enter();
+            bool parked = waiting;
+            waiting = false;
+            core_util_critical_section_exit();
+            if (parked) {
+                sema.release();
+            }
+        }
+    }
+
+    // block until the consumer makes space or the deadline passes, the
+    // ring state is re-checked inside a critical section so a concurrent
+    // wake cannot be lost
+    bool _park_producer(uint32_t millisec, uint64_t end)
+    {
+        core_util_critical_section_enter();
+        if (_next(_tail) != _head) {
+            core_util_critical_section_exit();
+            return true;
+        }
+        _producer_waiting = true;
+        core_util_critical_section_exit();
+
+        return _timed_wait(_free_sema, millisec, end);
+    }
+
+    // block until the producer inserts a message or the deadline passes
+    bool _park_consumer(uint32_t millisec, uint64_t end)
+    {
+        core_util_critical_section_enter();
+        if (_head != _tail) {
+            core_util_critical_section_exit();
+            return true;
+        }
+        _consumer_waiting = true;
+        core_util_critical_section_exit();
+
+        return _timed_wait(_full_sema, millisec, end);
+    }
+
+    static bool _timed_wait(Semaphore &sema, uint32_t millisec, uint64_t end)
+    {
+        if (millisec == osWaitForever) {
+            sema.wait(osWaitForever);
+            return true;
+        }
+
+        uint64_t now = Kernel::get_ms_count();
+        if (now >= end) {
+            return false;
+        }
+        sema.wait(end - now);
+        return Kernel::get_ms_count() < end;
+    }
+
+    T *_buffer[queue_sz + 1];
+    volatile uint32_t _head;
+    volatile uint32_t _tail;
+    volatile bool _producer_waiting;
+    volatile bool _consumer_waiting;
+    Semaphore _free_sema;
+    Semaphore _full_sema;
+};
 /** @}*/
 /** @}*/
 
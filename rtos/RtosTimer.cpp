@@ -19,6 +19,8 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
  */
+#ifdef MBED_CONF_RTOS_PRESENT
+
 #include "rtos/RtosTimer.h"
 #include "platform/Callback.h"
 #include "platform/mbed_error.h"
@@ -55,3 +57,5 @@ RtosTimer::~RtosTimer()
 }
 
 }
+
+#endif /* MBED_CONF_RTOS_PRESENT */
@@ -22,6 +22,11 @@
 #include "rtos/Semaphore.h"
 #include "rtos/Kernel.h"
 #include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+#ifndef MBED_CONF_RTOS_PRESENT
+#include "platform/mbed_power_mgmt.h"
+#include "platform/mbed_wait_api.h"
+#endif
 
 #include <string.h>
 
@@ -37,8 +42,47 @@ Semaphore::Semaphore(int32_t count, uint16_t max_count)
     constructor(count, max_count);
 }
 
+int32_t Semaphore::wait_until(uint64_t millisec)
+{
+    uint64_t now = Kernel::get_ms_count();
+
+    if (now >= millisec) {
+        return wait(0);
+    } else if (millisec - now >= osWaitForever) {
+        // API permits early return
+        return wait(osWaitForever - 1);
+    } else {
+        return wait(millisec - now);
+    }
+}
+
+void Semaphore::enable_coalescing(bool enable)
+{
+    _coalesce = enable;
+}
+
+int32_t Semaphore::wait_batch(uint32_t millisec)
+{
+    int32_t result = wait(millisec);
+    if (result <= 0 || !_coalesce) {
+        return (result > 0) ? 1 : result;
+    }
+
+    // Claim the whole burst that was collapsed into this wakeup
+    uint32_t count;
+    do {
+        count = _pending;
+    } while (!core_util_atomic_cas_u32(&_pending, &count, 0));
+
+    return (int32_t)count;
+}
+
+#ifdef MBED_CONF_RTOS_PRESENT
+
 void Semaphore::constructor(int32_t count, uint16_t max_count)
 {
+    _pending = 0;
+    _coalesce = false;
     memset(&_obj_mem, 0, sizeof(_obj_mem));
     osSemaphoreAttr_t attr = { 0 };
     attr.cb_mem = &_obj_mem;
@@ -62,28 +106,142 @@ int32_t Semaphore::wait(uint32_t millisec)
     }
 }
 
-int32_t Semaphore::wait_until(uint64_t millisec)
+osStatus Semaphore::release(void)
 {
-    uint64_t now = Kernel::get_ms_count();
+    if (_coalesce) {
+        // Only the release that finds the count at zero posts a token -
+        // the rest of the burst rides along on the same wakeup
+        if (core_util_atomic_incr_u32(&_pending, 1) > 1) {
+            return osOK;
+        }
+    }
+    return osSemaphoreRelease(_id);
+}
 
-    if (now >= millisec) {
-        return wait(0);
-    } else if (millisec - now >= osWaitForever) {
-        // API permits early return
-        return wait(osWaitForever - 1);
-    } else {
-        return wait(millisec - now);
+osStatus Semaphore::release(int32_t n)
+{
+    if (n <= 0) {
+        return osErrorParameter;
+    }
+
+    if (_coalesce) {
+        if (core_util_atomic_incr_u32(&_pending, n) > (uint32_t)n) {
+            return osOK;
+        }
+        return osSemaphoreRelease(_id);
+    }
+
+    // CMSIS-RTOS has no bulk release, so post the tokens one by one
+    while (n-- > 0) {
+        osStatus status = osSemaphoreRelease(_id);
+        if (status != osOK) {
+            return status;
+        }
+    }
+    return osOK;
+}
+
+Semaphore::~Semaphore()
+{
+    osSemaphoreDelete(_id);
+}
+
+#else /* MBED_CONF_RTOS_PRESENT */
+
+/* Bare-metal profile: the token count lives behind a critical section, so
+ * releases from interrupt handlers stay safe. A blocked forever-wait parks
+ * the core with sleep() - the release that ends it can only arrive from an
+ * interrupt, and any interrupt ends the sleep. */
+
+void Semaphore::constructor(int32_t count, uint16_t max_count)
+{
+    _count = count;
+    _max_count = max_count;
+    _pending = 0;
+    _coalesce = false;
+}
+
+int32_t Semaphore::wait(uint32_t millisec)
+{
+    uint64_t deadline = 0;
+    if (millisec != 0 && millisec != osWaitForever) {
+        deadline = Kernel::get_ms_count() + millisec;
+    }
+
+    while (true) {
+        core_util_critical_section_enter();
+        if (_count > 0) {
+            int32_t available = _count--;
+            core_util_critical_section_exit();
+            return available;
+        }
+        core_util_critical_section_exit();
+
+        if (millisec == 0) {
+            return 0;
+        } else if (millisec == osWaitForever) {
+            sleep();
+        } else if (Kernel::get_ms_count() >= deadline) {
+            return 0;
+        } else {
+            // No kernel tick to bound a sleep against the deadline, so poll
+            // at millisecond granularity through the non-RTOS wait seam
+            wait_ms(1);
+        }
     }
 }
 
 osStatus Semaphore::release(void)
 {
-    return osSemaphoreRelease(_id);
+    if (_coalesce) {
+        // Only the release that finds the count at zero posts a token -
+        // the rest of the burst rides along on the same wakeup
+        if (core_util_atomic_incr_u32(&_pending, 1) > 1) {
+            return osOK;
+        }
+    }
+
+    osStatus status = osOK;
+    core_util_critical_section_enter();
+    if (_count >= (int32_t)_max_count) {
+        status = osErrorResource;
+    } else {
+        _count++;
+    }
+    core_util_critical_section_exit();
+    return status;
+}
+
+osStatus Semaphore::release(int32_t n)
+{
+    if (n <= 0) {
+        return osErrorParameter;
+    }
+
+    if (_coalesce) {
+        if (core_util_atomic_incr_u32(&_pending, n) > (uint32_t)n) {
+            return osOK;
+        }
+        n = 1;
+    }
+
+    osStatus status = osOK;
+    core_util_critical_section_enter();
+    while (n-- > 0) {
+        if (_count >= (int32_t)_max_count) {
+            status = osErrorResource;
+            break;
+        }
+        _count++;
+    }
+    core_util_critical_section_exit();
+    return status;
 }
 
 Semaphore::~Semaphore()
 {
-    osSemaphoreDelete(_id);
 }
 
+#endif /* MBED_CONF_RTOS_PRESENT */
+
 }
@@ -23,9 +23,7 @@
 #define SEMAPHORE_H
 
 #include <stdint.h>
-#include "cmsis_os2.h"
-#include "mbed_rtos1_types.h"
-#include "mbed_rtos_storage.h"
+#include "rtos/mbed_rtos_types.h"
 #include "platform/NonCopyable.h"
 
 namespace rtos {
@@ -89,6 +87,43 @@ public:
     */
     osStatus release(void);
 
+    /** Release multiple Semaphore resources with one call.
+      @param   n  number of tokens to release.
+      @return status code that indicates the execution status of the function:
+              @a osOK all tokens have been correctly released.
+              @a osErrorResource the maximum token count has been reached before all tokens were released.
+              @a osErrorParameter n is not positive, or internal error.
+
+      @note You may call this function from ISR context.
+    */
+    osStatus release(int32_t n);
+
+    /** Enable or disable wakeup coalescing.
+
+      With coalescing enabled, releases are counted and only the release
+      that finds the count at zero posts a token - a burst of releases from
+      an interrupt storm wakes the draining thread once instead of once per
+      release. The drain thread collects the whole burst with wait_batch.
+
+      Only meaningful for the one-producer one-consumer signalling pattern;
+      plain wait must not be mixed with coalesced releases.
+
+      @param   enable  true to coalesce releases, false for standard semaphore behavior. (default: true).
+
+      @note You cannot call this function from ISR context.
+    */
+    void enable_coalescing(bool enable = true);
+
+    /** Wait for a wakeup and collect the coalesced release count.
+      @param   millisec  timeout value or 0 in case of no time-out. (default: osWaitForever).
+      @return  number of releases collapsed into this wakeup, 0 on timeout,
+               or -1 in case of incorrect parameters. With coalescing
+               disabled, behaves as wait and returns at most 1.
+
+      @note You may call this function from ISR context if the millisec parameter is set to 0.
+    */
+    int32_t wait_batch(uint32_t millisec = osWaitForever);
+
     /** Semaphore destructor
      *
      * @note You cannot call this function from ISR context.
@@ -98,8 +133,15 @@ public:
 private:
     void constructor(int32_t count, uint16_t max_count);
 
+#ifdef MBED_CONF_RTOS_PRESENT
     osSemaphoreId_t               _id;
     mbed_rtos_storage_semaphore_t _obj_mem;
+#else
+    volatile int32_t              _count;
+    uint16_t                      _max_count;
+#endif
+    volatile uint32_t             _pending;
+    bool                          _coalesce;
 };
 /** @}*/
 /** @}*/
@@ -0,0 +1,243 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2019 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef SHARED_MAIL_H
+#define SHARED_MAIL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "Queue.h"
+#include "MemoryPool.h"
+#include "cmsis_os2.h"
+#include "mbed_rtos_storage.h"
+#include "mbed_rtos1_types.h"
+
+#include "platform/mbed_critical.h"
+#include "platform/NonCopyable.h"
+
+#ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
+using namespace rtos;
+#endif
+
+namespace rtos {
+/** \addtogroup rtos */
+/** @{*/
+/**
+ * \defgroup rtos_SharedMail SharedMail class
+ * @{
+ */
+
+/** The SharedMail class is a Mail whose memory blocks have transferable
+ * ownership.
+ *
+ * Each block carries a reference count and a pointer back to the pool it was
+ * allocated from, so a consumer can forward the same block into another
+ * SharedMail or Queue without copying the payload, and whichever thread
+ * drops the last reference returns the block to its origin pool. Additional
+ * references for fan-out are taken with SharedMail::share.
+ *
+ * Unlike Mail::free, SharedMail::free is static and accepts a block obtained
+ * from any SharedMail with the same template parameters - the block finds
+ * its way home on its own.
+ *
+ * @tparam  T         Data type of a single mail message element.
+ * @tparam  queue_sz  Maximum number of mail messages in queue.
+ *
+ * @note
+ * Memory considerations: The mail data store and control structures are part
+ * of this class - they do not (themselves) allocate memory on the heap, both
+ * for the Mbed OS and underlying RTOS objects (static or dynamic RTOS memory
+ * pools are not being used).
+ */
+template<typename T, uint32_t queue_sz>
+class SharedMail : private mbed::NonCopyable<SharedMail<T, queue_sz> > {
+public:
+    /** Create and initialize SharedMail queue.
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    SharedMail() { };
+
+    /** Check if the mail queue is empty.
+     *
+     * @return State of queue.
+     * @retval true  Mail queue is empty.
+     * @retval false Mail queue contains mail.
+     *
+     * @note You may call this function from ISR context.
+     */
+    bool empty() const
+    {
+        return _queue.empty();
+    }
+
+    /** Check if the mail queue is full.
+     *
+     * @return State of queue.
+     * @retval true  Mail queue is full.
+     * @retval false Mail queue is not full.
+     *
+     * @note You may call this function from ISR context.
+     */
+    bool full() const
+    {
+        return _queue.full();
+    }
+
+    /** Allocate a memory block of type T with a single reference.
+     *
+     * @param   millisec  Not used.
+     *
+     * @return  Pointer to memory block that you can fill with mail or NULL in case error.
+     *
+     * @note You may call this function from ISR context.
+     */
+    T *alloc(uint32_t millisec = 0)
+    {
+        envelope *env = _pool.alloc();
+        if (env == NULL) {
+            return NULL;
+        }
+        env->pool = &_pool;
+        env->ref = 1;
+        return &env->data;
+    }
+
+    /** Allocate a memory block of type T with a single reference, and set memory block to zero.
+     *
+     * @param   millisec  Not used.
+     *
+     * @return  Pointer to memory block that you can fill with mail or NULL in case error.
+     *
+     * @note You may call this function from ISR context.
+     */
+    T *calloc(uint32_t millisec = 0)
+    {
+        T *mptr = alloc(millisec);
+        if (mptr != NULL) {
+            memset(mptr, 0, sizeof(T));
+        }
+        return mptr;
+    }
+
+    /** Take an additional reference on a memory block for fan-out.
+     *
+     * Each reference must be released with SharedMail::free before the
+     * block returns to its origin pool.
+     *
+     * @param mptr Pointer to a memory block obtained with SharedMail::alloc,
+     *             SharedMail::calloc or SharedMail::get.
+     *
+     * @return The same memory block.
+     *
+     * @note You may call this function from ISR context.
+     */
+    static T *share(T *mptr)
+    {
+        core_util_atomic_incr_u32(&to_envelope(mptr)->ref, 1);
+        return mptr;
+    }
+
+    /** Put a mail in the queue.
+     *
+     * The reference travels with the block - the consumer that gets the
+     * mail inherits it, so no reference manipulation is needed to forward
+     * a block through a pipeline of queues.
+     *
+     * @param   mptr  Memory block to send, obtained from a SharedMail with
+     *                the same template parameters.
+     *
+     * @return  Status code that indicates the execution status of the function (osOK on success).
+     *
+     * @note You may call this function from ISR context.
+     */
+    osStatus put(T *mptr)
+    {
+        return _queue.put(mptr);
+    }
+
+    /** Get a mail from the queue.
+     *
+     * @param millisec Timeout value or 0 in case of no timeout (default: osWaitForever).
+     *
+     * @return Event that contains mail information or error code.
+     * @retval osEventMail      Mail received.
+     * @retval osOK             No mail is available (and no timeout was specified).
+     * @retval osEventTimeout   No mail has arrived during the given timeout period.
+     * @retval osErrorParameter A parameter is invalid or outside of a permitted range.
+     *
+     * @note You may call this function from ISR context if the millisec parameter is set to 0.
+     */
+    osEvent get(uint32_t millisec = osWaitForever)
+    {
+        osEvent evt = _queue.get(millisec);
+        if (evt.status == osEventMessage) {
+            evt.status = osEventMail;
+        }
+        return evt;
+    }
+
+    /** Release a reference on a memory block.
+     *
+     * When the last reference is released, the block returns to the pool
+     * of the SharedMail it was allocated from, which need not be the mail
+     * it was received on.
+     *
+     * @param mptr Pointer to a memory block obtained with SharedMail::alloc,
+     *             SharedMail::calloc or SharedMail::get.
+     *
+     * @return Status code that indicates the execution status of the function (osOK on success).
+     *
+     * @note You may call this function from ISR context.
+     */
+    static osStatus free(T *mptr)
+    {
+        envelope *env = to_envelope(mptr);
+        if (core_util_atomic_decr_u32(&env->ref, 1) > 0) {
+            return osOK;
+        }
+        return env->pool->free(env);
+    }
+
+private:
+    struct envelope {
+        MemoryPool<envelope, queue_sz> *pool;
+        volatile uint32_t ref;
+        T data;
+    };
+
+    static envelope *to_envelope(T *mptr)
+    {
+        return (envelope *)((char *)mptr - offsetof(envelope, data));
+    }
+
+    Queue<T, queue_sz> _queue;
+    MemoryPool<envelope, queue_sz> _pool;
+};
+
+/** @}*/
+/** @}*/
+
+}
+
+#endif
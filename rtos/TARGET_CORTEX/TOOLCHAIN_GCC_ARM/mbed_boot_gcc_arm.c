@@ -19,6 +19,7 @@
 #include "mbed_toolchain.h"
 #include "mbed_boot.h"
 #include "mbed_rtos_storage.h"
+#include "mbed_stats.h"
 #include "cmsis_os2.h"
 
 static osMutexId_t               malloc_mutex_id;
@@ -83,7 +84,11 @@ void mbed_toolchain_init()
     env_mutex_id = osMutexNew(&env_mutex_attr);
 
     /* Run the C++ global object constructors */
+#if defined(MBED_CTOR_STATS_ENABLED)
+    mbed_init_array_profiled();
+#else
     __libc_init_array();
+#endif
 }
 
 extern int __real_main(void);
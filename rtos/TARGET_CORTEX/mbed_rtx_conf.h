@@ -65,6 +65,12 @@
 #define OS_STACK_WATERMARK          1
 #endif
 
+/* The MPU stack guard raises a precise fault as soon as a stack overflows,
+ * making the per-switch software magic-word check redundant. */
+#if !defined(OS_STACK_CHECK) && defined(MBED_CONF_RTOS_MPU_STACK_GUARD) && MBED_CONF_RTOS_MPU_STACK_GUARD
+#define OS_STACK_CHECK              0
+#endif
+
 
 #define OS_IDLE_THREAD_TZ_MOD_ID     1
 #define OS_TIMER_THREAD_TZ_MOD_ID    1
@@ -142,7 +148,12 @@
 #define EVR_RTX_THREAD_BLOCKED_DISABLE
 #define EVR_RTX_THREAD_UNBLOCKED_DISABLE
 #define EVR_RTX_THREAD_PREEMPTED_DISABLE
+/* The switched event feeds per-thread CPU time accounting and moves the MPU
+ * stack guard when those features are enabled, see mbed_rtx_handlers.c */
+#if !defined(MBED_THREAD_STATS_ENABLED) && !defined(MBED_ALL_STATS_ENABLED) && \
+    !(defined(MBED_CONF_RTOS_MPU_STACK_GUARD) && MBED_CONF_RTOS_MPU_STACK_GUARD)
 #define EVR_RTX_THREAD_SWITCHED_DISABLE
+#endif
 #define EVR_RTX_THREAD_DESTROYED_DISABLE
 #define EVR_RTX_THREAD_GET_COUNT_DISABLE
 #define EVR_RTX_THREAD_ENUMERATE_DISABLE
@@ -15,12 +15,16 @@
  * limitations under the License.
  */
 
+#include "cmsis.h"
 #include "cmsis_compiler.h"
 #include "rtx_os.h"
 #include "rtx_evr.h"
 #include "mbed_rtx.h"
 #include "mbed_error.h"
+#include "hal/mpu_api.h"
 #include "mbed_interface.h"
+#include "mbed_stats.h"
+#include "platform/mbed_itm_trace.h"
 #include "RTX_Config.h"
 #include "rtos/rtos_handlers.h"
 #include "rtos/rtos_idle.h"
@@ -34,8 +38,161 @@
 
 static void (*terminate_hook)(osThreadId_t id);
 
+#if MBED_CONF_RTOS_MPU_STACK_GUARD && !DEVICE_MPU
+#error "rtos.mpu-stack-guard requires an MPU. Add 'MPU' to device_has in targets.json"
+#endif
+
+#if defined(MBED_THREAD_STATS_ENABLED)
+
+/* Per-thread CPU time accounting, fed by the RTX thread-switched event.
+ * The DWT cycle counter is sampled on every context switch and the elapsed
+ * cycles are attributed to the outgoing thread. The table is sized for a
+ * typical thread population; threads beyond it report zero. */
+#define THREAD_CPU_STATS_SLOTS  14
+
+typedef struct {
+    osThreadId_t id;
+    uint64_t cycles;
+    uint64_t window_cycles;
+    uint32_t sp_low;
+} thread_cpu_stats_t;
+
+static thread_cpu_stats_t thread_cpu_stats_table[THREAD_CPU_STATS_SLOTS];
+static uint64_t thread_cpu_stats_window;
+static uint32_t thread_cpu_stats_last;
+static osThreadId_t thread_cpu_stats_running;
+
+static thread_cpu_stats_t *thread_cpu_stats_find(osThreadId_t id, int allocate)
+{
+    thread_cpu_stats_t *free_slot = NULL;
+    for (int i = 0; i < THREAD_CPU_STATS_SLOTS; i++) {
+        if (thread_cpu_stats_table[i].id == id) {
+            return &thread_cpu_stats_table[i];
+        }
+        if ((free_slot == NULL) && (thread_cpu_stats_table[i].id == NULL)) {
+            free_slot = &thread_cpu_stats_table[i];
+        }
+    }
+    if (allocate && (free_slot != NULL)) {
+        free_slot->id = id;
+        free_slot->cycles = 0;
+        free_slot->window_cycles = 0;
+        free_slot->sp_low = 0;
+        return free_slot;
+    }
+    return NULL;
+}
+
+#endif /* MBED_THREAD_STATS_ENABLED */
+
+#if defined(MBED_THREAD_STATS_ENABLED) || MBED_CONF_RTOS_MPU_STACK_GUARD
+
+// RTX hook which gets called on every context switch, from the scheduler
+// with the kernel protected - the bookkeeping needs no further locking
+void EvrRtxThreadSwitched(osThreadId_t thread_id)
+{
+    mbed_itm_trace_word(MBED_ITM_TRACE_PORT_SCHED, (uint32_t)thread_id);
+
+#if MBED_CONF_RTOS_MPU_STACK_GUARD
+    // Move the guard region to the incoming thread's stack before it runs
+    mbed_mpu_set_stack_guard((uint32_t)((osRtxThread_t *)thread_id)->stack_mem);
+#endif
+
+#if defined(MBED_THREAD_STATS_ENABLED)
+    /* The incoming thread's registers were stacked when it was last suspended,
+     * so its saved stack pointer marks how deep it had grown at that point.
+     * Tracking the minimum gives a watermark without scanning the stack. */
+    thread_cpu_stats_t *stack_slot = thread_cpu_stats_find(thread_id, 1);
+    if (stack_slot != NULL) {
+        uint32_t sp = ((osRtxThread_t *)thread_id)->sp;
+        if ((stack_slot->sp_low == 0) || (sp < stack_slot->sp_low)) {
+            stack_slot->sp_low = sp;
+        }
+    }
+
+#if defined(DWT) && defined(DWT_CTRL_CYCCNTENA_Msk)
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    uint32_t now = DWT->CYCCNT;
+    uint32_t elapsed = now - thread_cpu_stats_last;
+    thread_cpu_stats_last = now;
+
+    if (thread_cpu_stats_running != NULL) {
+        thread_cpu_stats_t *slot = thread_cpu_stats_find(thread_cpu_stats_running, 1);
+        if (slot != NULL) {
+            slot->cycles += elapsed;
+            slot->window_cycles += elapsed;
+        }
+        thread_cpu_stats_window += elapsed;
+    }
+    thread_cpu_stats_running = thread_id;
+#endif /* DWT */
+#endif /* MBED_THREAD_STATS_ENABLED */
+}
+
+#endif /* MBED_THREAD_STATS_ENABLED || MBED_CONF_RTOS_MPU_STACK_GUARD */
+
+#if defined(MBED_THREAD_STATS_ENABLED)
+
+void rtos_thread_cpu_stats(osThreadId_t id, uint64_t *cycles, uint32_t *used)
+{
+    *cycles = 0;
+    *used = 0;
+
+    int32_t lock = osKernelLock();
+    thread_cpu_stats_t *slot = thread_cpu_stats_find(id, 0);
+    if (slot != NULL) {
+        *cycles = slot->cycles;
+        if (thread_cpu_stats_window > 0) {
+            *used = (uint32_t)((slot->window_cycles * 100) / thread_cpu_stats_window);
+        }
+    }
+    osKernelRestoreLock(lock);
+}
+
+uint32_t rtos_thread_stack_watermark(osThreadId_t id)
+{
+    uint32_t used = 0;
+
+    int32_t lock = osKernelLock();
+    thread_cpu_stats_t *slot = thread_cpu_stats_find(id, 0);
+    if ((slot != NULL) && (slot->sp_low != 0)) {
+        const osRtxThread_t *thread = id;
+        used = ((uint32_t)thread->stack_mem + thread->stack_size) - slot->sp_low;
+    }
+    osKernelRestoreLock(lock);
+    return used;
+}
+
+void rtos_thread_cpu_stats_reset(void)
+{
+    int32_t lock = osKernelLock();
+    for (int i = 0; i < THREAD_CPU_STATS_SLOTS; i++) {
+        thread_cpu_stats_table[i].window_cycles = 0;
+    }
+    thread_cpu_stats_window = 0;
+    osKernelRestoreLock(lock);
+}
+
+static void thread_cpu_stats_free(osThreadId_t id)
+{
+    thread_cpu_stats_t *slot = thread_cpu_stats_find(id, 0);
+    if (slot != NULL) {
+        slot->id = NULL;
+    }
+}
+
+#endif /* MBED_THREAD_STATS_ENABLED */
+
 static void thread_terminate_hook(osThreadId_t id)
 {
+#if defined(MBED_THREAD_STATS_ENABLED)
+    thread_cpu_stats_free(id);
+#endif
     if (terminate_hook) {
         terminate_hook(id);
     }
@@ -26,9 +26,16 @@
 #include "rtos/Kernel.h"
 #include "rtos/rtos_idle.h"
 #include "platform/mbed_assert.h"
+#ifndef MBED_CONF_RTOS_PRESENT
+#include "platform/mbed_critical.h"
+#include "platform/mbed_power_mgmt.h"
+#include "platform/mbed_wait_api.h"
+#endif
 
 namespace rtos {
 
+#ifdef MBED_CONF_RTOS_PRESENT
+
 uint32_t ThisThread::flags_clear(uint32_t flags)
 {
     flags = osThreadFlagsClear(flags);
@@ -108,6 +115,140 @@ void ThisThread::sleep_for(uint32_t millisec)
     MBED_ASSERT(status == osOK);
 }
 
+void ThisThread::yield()
+{
+    osThreadYield();
+}
+
+osThreadId_t ThisThread::get_id()
+{
+    return osThreadGetId();
+}
+
+#else /* MBED_CONF_RTOS_PRESENT */
+
+/* Bare-metal profile: one thread of execution, whose flags live in a plain
+ * word behind critical sections. Blocked waits park the core with sleep() -
+ * whatever would unblock them can only come from an interrupt handler, and
+ * any interrupt ends the sleep; timed waits poll through the non-RTOS wait
+ * seam, as there is no kernel tick to bound a sleep against the deadline. */
+
+static volatile uint32_t main_thread_flags = 0;
+
+uint32_t ThisThread::flags_clear(uint32_t flags)
+{
+    core_util_critical_section_enter();
+    uint32_t old_flags = main_thread_flags;
+    main_thread_flags &= ~flags;
+    core_util_critical_section_exit();
+    return old_flags;
+}
+
+uint32_t ThisThread::flags_get()
+{
+    return main_thread_flags;
+}
+
+static uint32_t flags_wait_for(uint32_t flags, uint32_t millisec, bool clear, bool wait_all)
+{
+    uint64_t deadline = 0;
+    if (millisec != 0 && millisec != osWaitForever) {
+        deadline = Kernel::get_ms_count() + millisec;
+    }
+
+    while (true) {
+        core_util_critical_section_enter();
+        uint32_t current = main_thread_flags;
+        bool satisfied = wait_all ? ((current & flags) == flags) : ((current & flags) != 0);
+        if (satisfied && clear) {
+            main_thread_flags = current & ~flags;
+        }
+        core_util_critical_section_exit();
+
+        if (satisfied || millisec == 0) {
+            return current;
+        } else if (millisec == osWaitForever) {
+            sleep();
+        } else if (Kernel::get_ms_count() >= deadline) {
+            return current;
+        } else {
+            wait_ms(1);
+        }
+    }
+}
+
+static uint32_t flags_wait_until(uint32_t flags, uint64_t millisec, bool clear, bool wait_all)
+{
+    uint64_t now = Kernel::get_ms_count();
+
+    uint32_t delay;
+    if (now >= millisec) {
+        delay = 0;
+    } else if (millisec - now >= osWaitForever) {
+        // Documentation permits early return for big offsets
+        delay = osWaitForever - 1;
+    } else {
+        delay = millisec - now;
+    }
+    return flags_wait_for(flags, delay, clear, wait_all);
+}
+
+uint32_t ThisThread::flags_wait_all(uint32_t flags, bool clear)
+{
+    return flags_wait_for(flags, osWaitForever, clear, true);
+}
+
+uint32_t ThisThread::flags_wait_all_for(uint32_t flags, uint32_t millisec, bool clear)
+{
+    return flags_wait_for(flags, millisec, clear, true);
+}
+
+uint32_t ThisThread::flags_wait_all_until(uint32_t flags, uint64_t millisec, bool clear)
+{
+    return flags_wait_until(flags, millisec, clear, true);
+}
+
+uint32_t ThisThread::flags_wait_any(uint32_t flags, bool clear)
+{
+    return flags_wait_for(flags, osWaitForever, clear, false);
+}
+
+uint32_t ThisThread::flags_wait_any_for(uint32_t flags, uint32_t millisec, bool clear)
+{
+    return flags_wait_for(flags, millisec, clear, false);
+}
+
+uint32_t ThisThread::flags_wait_any_until(uint32_t flags, uint64_t millisec, bool clear)
+{
+    return flags_wait_until(flags, millisec, clear, false);
+}
+
+void ThisThread::sleep_for(uint32_t millisec)
+{
+    // The non-RTOS wait seam takes an int of milliseconds - walk to the
+    // deadline in steps so any 32-bit duration is honoured
+    uint64_t deadline = Kernel::get_ms_count() + millisec;
+    uint64_t now;
+    while ((now = Kernel::get_ms_count()) < deadline) {
+        uint64_t remaining = deadline - now;
+        wait_ms((remaining > 1000) ? 1000 : (int)remaining);
+    }
+}
+
+void ThisThread::yield()
+{
+    // Nothing to yield to
+}
+
+osThreadId_t ThisThread::get_id()
+{
+    // A stable non-NULL token standing in for the single context
+    static int bare_metal_thread;
+    return &bare_metal_thread;
+}
+
+#endif /* MBED_CONF_RTOS_PRESENT */
+
 void ThisThread::sleep_until(uint64_t millisec)
 {
     // CMSIS-RTOS 2.1.0 had 64-bit time and osDelayUntil, but that's been revoked.
@@ -128,14 +269,4 @@ void ThisThread::sleep_until(uint64_t millisec)
     }
 }
 
-void ThisThread::yield()
-{
-    osThreadYield();
-}
-
-osThreadId_t ThisThread::get_id()
-{
-    return osThreadGetId();
-}
-
 }
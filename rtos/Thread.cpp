@@ -19,6 +19,8 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
  */
+#ifdef MBED_CONF_RTOS_PRESENT
+
 #include "rtos/Thread.h"
 #include "rtos/ThisThread.h"
 #include "rtos/rtos_idle.h"
@@ -436,3 +438,5 @@ void Thread::_thunk(void *thread_ptr)
 }
 
 }
+
+#endif /* MBED_CONF_RTOS_PRESENT */
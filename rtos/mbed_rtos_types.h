@@ -0,0 +1,60 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef MBED_RTOS_TYPES_H
+#define MBED_RTOS_TYPES_H
+
+#ifdef MBED_CONF_RTOS_PRESENT
+
+#include "cmsis_os2.h"
+#include "mbed_rtos1_types.h"
+#include "mbed_rtos_storage.h"
+
+#else
+
+/* Bare-metal builds leave out the kernel (rtos/TARGET_CORTEX), so the CMSIS
+ * headers are not available. Provide the subset of its definitions that the
+ * class interfaces use, with the CMSIS-RTOS 2 values, so code written
+ * against Mutex/Semaphore/ThisThread compiles unchanged in both profiles.
+ */
+
+#define osWaitForever 0xFFFFFFFFU
+
+typedef enum {
+    osOK                =  0,
+    osError             = -1,
+    osErrorTimeout      = -2,
+    osErrorResource     = -3,
+    osErrorParameter    = -4,
+    osErrorNoMemory     = -5,
+    osErrorISR          = -6,
+    osStatusReserved    = 0x7FFFFFFF
+} osStatus_t;
+
+/* CMSIS-RTOS 1 compatibility name, as used by the deprecated APIs */
+typedef osStatus_t osStatus;
+
+typedef void *osThreadId_t;
+typedef osThreadId_t osThreadId;
+
+#endif
+
+#endif
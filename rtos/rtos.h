@@ -25,18 +25,26 @@
 #ifndef RTOS_H
 #define RTOS_H
 
-#include "mbed_rtos_storage.h"
+#include "rtos/mbed_rtos_types.h"
 #include "rtos/Kernel.h"
-#include "rtos/Thread.h"
 #include "rtos/ThisThread.h"
 #include "rtos/Mutex.h"
-#include "rtos/RtosTimer.h"
 #include "rtos/Semaphore.h"
+
+/* The remaining classes need the kernel - with the bare-metal profile only
+ * the single-thread collapses of the classes above are available */
+#ifdef MBED_CONF_RTOS_PRESENT
+#include "rtos/Thread.h"
+#include "rtos/RtosTimer.h"
 #include "rtos/Mail.h"
+#include "rtos/SharedMail.h"
 #include "rtos/MemoryPool.h"
 #include "rtos/Queue.h"
 #include "rtos/EventFlags.h"
 #include "rtos/ConditionVariable.h"
+#include "rtos/PeriodicTask.h"
+#include "rtos/Pipeline.h"
+#endif
 
 #ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
 using namespace rtos;
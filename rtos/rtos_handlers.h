@@ -41,6 +41,36 @@ extern "C" {
  @param fptr Hook function pointer.
  */
 void rtos_attach_thread_terminate_hook(void (*fptr)(osThreadId_t id));
+
+/**
+ @note
+ Retrieves the CPU time accounted to a thread. Both outputs are 0 when
+ thread statistics are disabled, the core has no cycle counter or the
+ thread is not being tracked.
+ @param id     Thread ID.
+ @param cycles Filled with the CPU cycles consumed by the thread since it was created.
+ @param used   Filled with the percentage of CPU time the thread consumed in the current usage window.
+ */
+void rtos_thread_cpu_stats(osThreadId_t id, uint64_t *cycles, uint32_t *used);
+
+/**
+ @note
+ Retrieves the stack watermark of a thread in O(1), from stack pointer
+ samples taken at context switch. Returns the maximum observed stack usage
+ in bytes, or 0 when thread statistics are disabled, the thread is not
+ being tracked or it has not been switched in yet. The samples only see
+ the stack depth at suspension points, so usage between context switches
+ may be under-reported compared to a stack scan.
+ @param id Thread ID.
+ */
+uint32_t rtos_thread_stack_watermark(osThreadId_t id);
+
+/**
+ @note
+ Starts a new CPU usage window - subsequent rtos_thread_cpu_stats calls
+ report percentages relative to this point.
+ */
+void rtos_thread_cpu_stats_reset(void);
 /** @}*/
 
 #ifdef __cplusplus
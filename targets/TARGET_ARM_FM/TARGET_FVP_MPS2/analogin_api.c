@@ -21,7 +21,7 @@
 
 #define ADC_12BIT_RANGE             0xFFF
 
-static const PinMap PinMap_ADC[] = {
+static const PinMap PinMap_ADC[] MBED_PERIPHERAL_TABLE("adc") = {
     {A0_0, ADC0_0,  0},
     {A0_1, ADC0_1,  0},
     {A0_2, ADC0_2,  0},
@@ -37,22 +37,22 @@ static const PinMap PinMap_ADC[] = {
     {NC,    NC,     0}
 };
 
-static const PinMap PinMap_SPI_SCLK[] = {
+static const PinMap PinMap_SPI_SCLK[] MBED_PERIPHERAL_TABLE("adc_spi_sclk") = {
     {ADC_SCLK, SPI_3, 0},
     {NC, NC, 0}
 };
 
-static const PinMap PinMap_SPI_MOSI[] = {
+static const PinMap PinMap_SPI_MOSI[] MBED_PERIPHERAL_TABLE("adc_spi_mosi") = {
     {ADC_MOSI, SPI_3, 0},
     {NC, NC, 0}
 };
 
-static const PinMap PinMap_SPI_MISO[] = {
+static const PinMap PinMap_SPI_MISO[] MBED_PERIPHERAL_TABLE("adc_spi_miso") = {
     {ADC_MISO, SPI_3, 0},
     {NC, NC, 0}
 };
 
-static const PinMap PinMap_SPI_SSEL[] = {
+static const PinMap PinMap_SPI_SSEL[] MBED_PERIPHERAL_TABLE("adc_spi_ssel") = {
     {ADC_SSEL, SPI_3, 0},
     {NC, NC, 0}
 };
@@ -51,7 +51,7 @@
 #define SHIELD_TSU            25           // Setup delay 1000nS min
 
 
-static const PinMap PinMap_I2C_SDA[] = {
+static const PinMap PinMap_I2C_SDA[] MBED_PERIPHERAL_TABLE("i2c_sda") = {
     {TSC_SDA, I2C_0, 0},
     {AUD_SDA, I2C_1, 0},
     {SHIELD_0_SDA, I2C_2, 0},
@@ -59,7 +59,7 @@ static const PinMap PinMap_I2C_SDA[] = {
     {NC, NC, 0}
 };
 
-static const PinMap PinMap_I2C_SCL[] = {
+static const PinMap PinMap_I2C_SCL[] MBED_PERIPHERAL_TABLE("i2c_scl") = {
     {TSC_SCL, I2C_0, 0},
     {AUD_SCL, I2C_1, 0},
     {SHIELD_0_SCL, I2C_2, 0},
@@ -29,7 +29,7 @@
  * INITIALIZATION
  ******************************************************************************/
 
-static const PinMap PinMap_UART_TX[] = {
+static const PinMap PinMap_UART_TX[] MBED_PERIPHERAL_TABLE("uart_tx") = {
     {USBTX, UART_0, 0},
     {XB_TX, UART_1, 0},
     {SH0_TX, UART_2, 0},
@@ -37,7 +37,7 @@ static const PinMap PinMap_UART_TX[] = {
     {NC, NC, 0}
 };
 
-static const PinMap PinMap_UART_RX[] = {
+static const PinMap PinMap_UART_RX[] MBED_PERIPHERAL_TABLE("uart_rx") = {
     {USBRX, UART_0, 0},
     {XB_RX, UART_1, 0},
     {SH0_RX, UART_2, 0},
@@ -22,7 +22,7 @@
 #include "mbed_error.h"
 #include "mbed_wait_api.h"
 
-static const PinMap PinMap_SPI_SCLK[] = {
+static const PinMap PinMap_SPI_SCLK[] MBED_PERIPHERAL_TABLE("spi_sclk") = {
     {SCLK_SPI, SPI_0, 0},
     {CLCD_SCLK, SPI_1, 0},
     {ADC_SCLK, SPI_2, 0},
@@ -31,7 +31,7 @@ static const PinMap PinMap_SPI_SCLK[] = {
     {NC, NC, 0}
 };
 
-static const PinMap PinMap_SPI_MOSI[] = {
+static const PinMap PinMap_SPI_MOSI[] MBED_PERIPHERAL_TABLE("spi_mosi") = {
     {MOSI_SPI, SPI_0, 0},
     {CLCD_MOSI, SPI_1, 0},
     {ADC_MOSI, SPI_2, 0},
@@ -40,7 +40,7 @@ static const PinMap PinMap_SPI_MOSI[] = {
     {NC, NC, 0}
 };
 
-static const PinMap PinMap_SPI_MISO[] = {
+static const PinMap PinMap_SPI_MISO[] MBED_PERIPHERAL_TABLE("spi_miso") = {
     {MISO_SPI, SPI_0, 0},
     {CLCD_MISO, SPI_1, 0},
     {ADC_MISO, SPI_2, 0},
@@ -49,7 +49,7 @@ static const PinMap PinMap_SPI_MISO[] = {
     {NC, NC, 0}
 };
 
-static const PinMap PinMap_SPI_SSEL[] = {
+static const PinMap PinMap_SPI_SSEL[] MBED_PERIPHERAL_TABLE("spi_ssel") = {
     {SSEL_SPI, SPI_0, 0},
     {CLCD_SSEL, SPI_1, 0},
     {ADC_SSEL, SPI_2, 0},
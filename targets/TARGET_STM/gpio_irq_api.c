@@ -45,6 +45,7 @@ typedef struct gpio_channel {
     uint32_t channel_ids[MAX_PIN_LINE];  // mbed "gpio_irq_t gpio_irq" field of instance
     GPIO_TypeDef *channel_gpio[MAX_PIN_LINE]; // base address of gpio port group
     uint32_t channel_pin[MAX_PIN_LINE];  // pin number in port group
+    volatile uint32_t latched_levels;    // pin levels by gpio_idx, latched at the start of each demux pass
 } gpio_channel_t;
 
 static gpio_irq_handler irq_handler;
@@ -76,53 +77,80 @@ static gpio_channel_t channels[CHANNEL_NUM] = {
 static void handle_interrupt_in(uint32_t irq_index, uint32_t max_num_pin_line)
 {
     gpio_channel_t *gpio_channel = &channels[irq_index];
+    uint32_t pending = 0;
+    uint32_t levels = 0;
     uint32_t gpio_idx;
 
+    // First pass: read the pending flags once and latch every configured
+    // pin's input, so all callbacks dispatched from this entry observe the
+    // same multi-pin state (see gpio_irq_get_latched)
     for (gpio_idx = 0; gpio_idx < max_num_pin_line; gpio_idx++) {
         uint32_t current_mask = (1 << gpio_idx);
 
         if (gpio_channel->pin_mask & current_mask) {
-            // Retrieve the gpio and pin that generate the irq
             GPIO_TypeDef *gpio = (GPIO_TypeDef *)(gpio_channel->channel_gpio[gpio_idx]);
             uint32_t pin = (uint32_t)(1 << (gpio_channel->channel_pin[gpio_idx]));
 
-            // Clear interrupt flag
+            if ((gpio->IDR & pin) != 0) {
+                levels |= current_mask;
+            }
             if (__HAL_GPIO_EXTI_GET_FLAG(pin) != RESET) {
                 __HAL_GPIO_EXTI_CLEAR_FLAG(pin);
+                pending |= current_mask;
+            }
+        }
+    }
+
+    if (pending == 0) {
+        error("Unexpected Spurious interrupt, index %d\r\n", irq_index);
+        return;
+    }
+
+    gpio_channel->latched_levels = levels;
+
+    // Second pass: dispatch every asserted pin, instead of one pin per
+    // interrupt entry - simultaneous edges on a shared EXTI vector cost a
+    // single ISR entry
+    for (gpio_idx = 0; gpio_idx < max_num_pin_line; gpio_idx++) {
+        uint32_t current_mask = (1 << gpio_idx);
 
-                if (gpio_channel->channel_ids[gpio_idx] == 0) {
-                    continue;
-                }
-
-                // Trying to discern which edge caused the IRQ
-                gpio_irq_event event = IRQ_NONE;
-                if (LL_EXTI_IsEnabledFallingTrig_0_31(pin) && !LL_EXTI_IsEnabledRisingTrig_0_31(pin)) {
-                    // Only the fall handler is active, so this must be a falling edge
-                    event = IRQ_FALL;
-                } else if (LL_EXTI_IsEnabledRisingTrig_0_31(pin) && !LL_EXTI_IsEnabledFallingTrig_0_31(pin)) {
-                    // Only the rise handler is active, so this must be a rising edge
-                    event = IRQ_RISE;
-                } else {
-                    // Ambiguous as to which edge caused the IRQ
-                    //
-                    // The state of the pin could/should indicate which edge
-                    // has occurred but this can go wrong if the IRQ caused a
-                    // transition from a low power mode. In some circumstances
-                    // only the trailing edge callback will be called.
-                    if ((gpio->IDR & pin) == 0) {
-                        event = IRQ_FALL;
-                    } else {
-                        event = IRQ_RISE;
-                    }
-                }
-
-                irq_handler(gpio_channel->channel_ids[gpio_idx], event);
-
-                return;
+        if ((pending & current_mask) == 0 || gpio_channel->channel_ids[gpio_idx] == 0) {
+            continue;
+        }
+
+        uint32_t pin = (uint32_t)(1 << (gpio_channel->channel_pin[gpio_idx]));
+
+        // Trying to discern which edge caused the IRQ
+        gpio_irq_event event = IRQ_NONE;
+        if (LL_EXTI_IsEnabledFallingTrig_0_31(pin) && !LL_EXTI_IsEnabledRisingTrig_0_31(pin)) {
+            // Only the fall handler is active, so this must be a falling edge
+            event = IRQ_FALL;
+        } else if (LL_EXTI_IsEnabledRisingTrig_0_31(pin) && !LL_EXTI_IsEnabledFallingTrig_0_31(pin)) {
+            // Only the rise handler is active, so this must be a rising edge
+            event = IRQ_RISE;
+        } else {
+            // Ambiguous as to which edge caused the IRQ
+            //
+            // The latched state of the pin could/should indicate which edge
+            // has occurred but this can go wrong if the IRQ caused a
+            // transition from a low power mode. In some circumstances
+            // only the trailing edge callback will be called.
+            if ((levels & current_mask) == 0) {
+                event = IRQ_FALL;
+            } else {
+                event = IRQ_RISE;
             }
         }
+
+        irq_handler(gpio_channel->channel_ids[gpio_idx], event);
     }
-    error("Unexpected Spurious interrupt, index %d\r\n", irq_index);
+}
+
+int gpio_irq_get_latched(gpio_irq_t *obj)
+{
+    const uint32_t gpio_idx = pin_lines_desc[STM_PIN(obj->pin)].gpio_idx;
+
+    return (channels[obj->irq_index].latched_levels >> gpio_idx) & 1;
 }
 
 